@@ -0,0 +1,396 @@
+/**
+ * @file alist_performance_test.c
+ * @brief 数组链表性能测试
+ * @version 0.1
+ * @date 2025-10-10
+ *
+ * @copyright Copyright (c) 2025
+ *
+ * 本文件在1K到10M个int64元素上对比list_t和alist_t：
+ * - 建立链表（push_back）
+ * - 用迭代器遍历全部元素
+ * - list_find / alist_find 查找不存在的元素（完整扫描）
+ * - 按保存的位置随机删除一个元素，再在另一个随机位置之前插入一个新元素
+ * - 随机插入删除之后再次遍历，alist_t另外测试alist_compact整理之后的遍历
+ *
+ * 元素较少时重复遍历，使每种容器遍历的元素总数大致相同。
+ * 使用utils中的高精度时间函数计算耗时，并将结果输出到日志文件中
+ */
+
+#include "cstl.h"
+#include "common/utils.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define LOG_FILE "alist_performance.log"
+#define TRAVERSE_ELEMENTS 20000000
+#define MAX_CHURN_OPS 1000000
+#define MISSING_VALUE (-1)
+
+/**
+ * @brief 测试阶段
+ */
+typedef enum {
+    PHASE_BUILD,            /**< 建立链表 */
+    PHASE_TRAVERSE,         /**< 迭代器遍历 */
+    PHASE_FIND,             /**< 完整扫描查找 */
+    PHASE_CHURN,            /**< 随机删除和插入 */
+    PHASE_TRAVERSE_CHURNED, /**< 随机删除和插入之后遍历 */
+    PHASE_COMPACT,          /**< 整理槽位，仅alist_t */
+    PHASE_TRAVERSE_COMPACT, /**< 整理之后遍历，仅alist_t */
+    PHASE_COUNT
+} phase_t;
+
+/**
+ * @brief 阶段名称
+ */
+static const char* phase_names[PHASE_COUNT] = {
+    "建立链表", "迭代器遍历", "查找（完整扫描）", "随机删除+插入",
+    "删除插入后遍历", "alist_compact", "整理后遍历"
+};
+
+/**
+ * @brief 一次测试的参数
+ */
+typedef struct {
+    size_t size;            /**< 元素数量 */
+    size_t reps;            /**< 遍历和查找的重复次数 */
+    size_t churn_ops;       /**< 随机删除和插入的次数 */
+    const size_t* erase_at; /**< 每次删除的位置编号 */
+    const size_t* insert_at;/**< 每次插入的位置编号 */
+} bench_params_t;
+
+/**
+ * @brief int64比较函数
+ *
+ * @param a 第一个元素指针
+ * @param b 第二个元素指针
+ * @return int 比较结果
+ */
+static int compare_int64(const void* a, const void* b) {
+    int64_t x = *(const int64_t*)a;
+    int64_t y = *(const int64_t*)b;
+    return (x > y) - (x < y);
+}
+
+/**
+ * @brief 用迭代器遍历并累加全部元素
+ *
+ * @param begin 起始迭代器，遍历结束后销毁
+ * @return int64_t 元素之和
+ */
+static int64_t traverse_sum(iterator_t* begin) {
+    int64_t sum = 0;
+    while (begin->valid(begin)) {
+        sum += *(const int64_t*)begin->current;
+        begin->next(begin);
+    }
+    iterator_destroy(begin);
+    return sum;
+}
+
+/**
+ * @brief 测试list_t
+ *
+ * @param params 测试参数
+ * @param elapsed 输出参数，各阶段耗时，不适用的阶段为-1
+ * @param checksums 输出参数，各阶段校验值
+ */
+static void run_list(const bench_params_t* params, long long* elapsed, int64_t* checksums) {
+    list_t* list = list_create(sizeof(int64_t), NULL, NULL);
+    list_node_t** nodes = (list_node_t**)malloc(params->size * sizeof(list_node_t*));
+    if (list == NULL || nodes == NULL) {
+        list_destroy(list);
+        free(nodes);
+        return;
+    }
+
+    long long start_time = get_current_time_ms_high_precision();
+    for (size_t i = 0; i < params->size; i++) {
+        int64_t value = (int64_t)i;
+        list_push_back(list, &value);
+        nodes[i] = list->tail;
+    }
+    elapsed[PHASE_BUILD] = get_current_time_ms_high_precision() - start_time;
+    checksums[PHASE_BUILD] = (int64_t)list_size(list);
+
+    int64_t sum = 0;
+    start_time = get_current_time_ms_high_precision();
+    for (size_t r = 0; r < params->reps; r++) {
+        sum += traverse_sum(list_begin(list));
+    }
+    elapsed[PHASE_TRAVERSE] = get_current_time_ms_high_precision() - start_time;
+    checksums[PHASE_TRAVERSE] = sum;
+
+    int64_t missing = MISSING_VALUE;
+    int64_t found = 0;
+    start_time = get_current_time_ms_high_precision();
+    for (size_t r = 0; r < params->reps; r++) {
+        found += list_find(list, &missing, compare_int64) != NULL;
+    }
+    elapsed[PHASE_FIND] = get_current_time_ms_high_precision() - start_time;
+    checksums[PHASE_FIND] = found;
+
+    start_time = get_current_time_ms_high_precision();
+    for (size_t k = 0; k < params->churn_ops; k++) {
+        size_t victim = params->erase_at[k];
+        size_t target = params->insert_at[k];
+        int64_t value = (int64_t)(params->size + k);
+        list_erase(list, nodes[victim]);
+        list_insert_before(list, nodes[target], &value);
+        nodes[victim] = nodes[target]->prev;
+    }
+    elapsed[PHASE_CHURN] = get_current_time_ms_high_precision() - start_time;
+    checksums[PHASE_CHURN] = (int64_t)list_size(list);
+
+    sum = 0;
+    start_time = get_current_time_ms_high_precision();
+    for (size_t r = 0; r < params->reps; r++) {
+        sum += traverse_sum(list_begin(list));
+    }
+    elapsed[PHASE_TRAVERSE_CHURNED] = get_current_time_ms_high_precision() - start_time;
+    checksums[PHASE_TRAVERSE_CHURNED] = sum;
+
+    list_destroy(list);
+    free(nodes);
+}
+
+/**
+ * @brief 测试alist_t
+ *
+ * @param params 测试参数
+ * @param elapsed 输出参数，各阶段耗时
+ * @param checksums 输出参数，各阶段校验值
+ */
+static void run_alist(const bench_params_t* params, long long* elapsed, int64_t* checksums) {
+    alist_t* list = alist_create(sizeof(int64_t), NULL, NULL);
+    uint32_t* positions = (uint32_t*)malloc(params->size * sizeof(uint32_t));
+    if (list == NULL || positions == NULL) {
+        alist_destroy(list);
+        free(positions);
+        return;
+    }
+
+    long long start_time = get_current_time_ms_high_precision();
+    for (size_t i = 0; i < params->size; i++) {
+        int64_t value = (int64_t)i;
+        alist_push_back(list, &value);
+        positions[i] = alist_tail(list);
+    }
+    elapsed[PHASE_BUILD] = get_current_time_ms_high_precision() - start_time;
+    checksums[PHASE_BUILD] = (int64_t)alist_size(list);
+
+    int64_t sum = 0;
+    start_time = get_current_time_ms_high_precision();
+    for (size_t r = 0; r < params->reps; r++) {
+        sum += traverse_sum(alist_begin(list));
+    }
+    elapsed[PHASE_TRAVERSE] = get_current_time_ms_high_precision() - start_time;
+    checksums[PHASE_TRAVERSE] = sum;
+
+    int64_t missing = MISSING_VALUE;
+    int64_t found = 0;
+    start_time = get_current_time_ms_high_precision();
+    for (size_t r = 0; r < params->reps; r++) {
+        found += alist_find(list, &missing, compare_int64) != ALIST_NIL;
+    }
+    elapsed[PHASE_FIND] = get_current_time_ms_high_precision() - start_time;
+    checksums[PHASE_FIND] = found;
+
+    start_time = get_current_time_ms_high_precision();
+    for (size_t k = 0; k < params->churn_ops; k++) {
+        size_t victim = params->erase_at[k];
+        size_t target = params->insert_at[k];
+        int64_t value = (int64_t)(params->size + k);
+        alist_erase(list, positions[victim]);
+        alist_insert_before(list, positions[target], &value);
+        positions[victim] = alist_prev(list, positions[target]);
+    }
+    elapsed[PHASE_CHURN] = get_current_time_ms_high_precision() - start_time;
+    checksums[PHASE_CHURN] = (int64_t)alist_size(list);
+
+    sum = 0;
+    start_time = get_current_time_ms_high_precision();
+    for (size_t r = 0; r < params->reps; r++) {
+        sum += traverse_sum(alist_begin(list));
+    }
+    elapsed[PHASE_TRAVERSE_CHURNED] = get_current_time_ms_high_precision() - start_time;
+    checksums[PHASE_TRAVERSE_CHURNED] = sum;
+
+    start_time = get_current_time_ms_high_precision();
+    alist_compact(list);
+    elapsed[PHASE_COMPACT] = get_current_time_ms_high_precision() - start_time;
+    checksums[PHASE_COMPACT] = (int64_t)alist_size(list);
+
+    sum = 0;
+    start_time = get_current_time_ms_high_precision();
+    for (size_t r = 0; r < params->reps; r++) {
+        sum += traverse_sum(alist_begin(list));
+    }
+    elapsed[PHASE_TRAVERSE_COMPACT] = get_current_time_ms_high_precision() - start_time;
+    checksums[PHASE_TRAVERSE_COMPACT] = sum;
+
+    alist_destroy(list);
+    free(positions);
+}
+
+/**
+ * @brief 测试指定大小的链表
+ *
+ * @param log_file 日志文件
+ * @param size 元素数量，至少为2
+ */
+static void test_size(FILE* log_file, size_t size) {
+    bench_params_t params;
+    params.size = size;
+    params.reps = size < TRAVERSE_ELEMENTS ? TRAVERSE_ELEMENTS / size : 1;
+    params.churn_ops = size < MAX_CHURN_OPS ? size : MAX_CHURN_OPS;
+
+    size_t* erase_at = (size_t*)malloc(params.churn_ops * sizeof(size_t));
+    size_t* insert_at = (size_t*)malloc(params.churn_ops * sizeof(size_t));
+    if (erase_at == NULL || insert_at == NULL) {
+        printf("错误: 无法创建测试数据\n");
+        free(erase_at);
+        free(insert_at);
+        return;
+    }
+
+    /* 插入位置不能是刚删除的元素 */
+    for (size_t k = 0; k < params.churn_ops; k++) {
+        erase_at[k] = (size_t)random_int64(0, (int64_t)size - 1);
+        insert_at[k] = (size_t)random_int64(0, (int64_t)size - 2);
+        if (insert_at[k] >= erase_at[k]) {
+            insert_at[k]++;
+        }
+    }
+    params.erase_at = erase_at;
+    params.insert_at = insert_at;
+
+    long long list_elapsed[PHASE_COUNT];
+    long long alist_elapsed[PHASE_COUNT];
+    int64_t list_checksums[PHASE_COUNT] = {0};
+    int64_t alist_checksums[PHASE_COUNT] = {0};
+    for (int phase = 0; phase < PHASE_COUNT; phase++) {
+        list_elapsed[phase] = -1;
+        alist_elapsed[phase] = -1;
+    }
+
+    run_list(&params, list_elapsed, list_checksums);
+    run_alist(&params, alist_elapsed, alist_checksums);
+
+    fprintf(log_file, "--- %zu 个元素（遍历重复 %zu 次，删除插入 %zu 次） ---\n",
+            size, params.reps, params.churn_ops);
+    printf("--- %zu 个元素（遍历重复 %zu 次，删除插入 %zu 次） ---\n",
+           size, params.reps, params.churn_ops);
+    fprintf(log_file, "  %-24s %12s %12s  %s\n", "阶段", "list_t", "alist_t", "校验");
+    printf("  %-24s %12s %12s  %s\n", "阶段", "list_t", "alist_t", "校验");
+
+    for (int phase = 0; phase < PHASE_COUNT; phase++) {
+        char list_text[32];
+        int64_t checksum = alist_checksums[phase];
+        if (list_elapsed[phase] >= 0) {
+            snprintf(list_text, sizeof(list_text), "%lld ms", list_elapsed[phase]);
+        } else {
+            snprintf(list_text, sizeof(list_text), "-");
+        }
+        const char* status = list_elapsed[phase] < 0 || list_checksums[phase] == checksum ? "一致" : "不一致";
+        if (phase == PHASE_TRAVERSE_COMPACT && checksum != alist_checksums[PHASE_TRAVERSE_CHURNED]) {
+            status = "不一致";
+        }
+        fprintf(log_file, "  %-24s %12s %9lld ms  %s %lld\n", phase_names[phase], list_text,
+                alist_elapsed[phase], status, (long long)checksum);
+        printf("  %-24s %12s %9lld ms  %s %lld\n", phase_names[phase], list_text,
+               alist_elapsed[phase], status, (long long)checksum);
+    }
+
+    fprintf(log_file, "\n");
+    printf("\n");
+
+    free(erase_at);
+    free(insert_at);
+}
+
+/**
+ * @brief 运行完整的性能测试
+ */
+void run_performance_tests() {
+    FILE* log_file = fopen(LOG_FILE, "a");
+    if (log_file == NULL) {
+        printf("无法打开日志文件 %s\n", LOG_FILE);
+        return;
+    }
+
+    fprintf(log_file, "\n=== 数组链表性能测试报告 ===\n");
+    fprintf(log_file, "测试时间: %s", ctime(&(time_t){time(NULL)}));
+    fprintf(log_file, "元素类型: int64，list_t每个节点一次分配，alist_t每个槽位 %zu 字节\n\n",
+            sizeof(uint32_t) * 2 + sizeof(int64_t));
+
+    printf("开始数组链表性能测试...\n");
+    printf("结果将保存到 %s\n\n", LOG_FILE);
+
+    test_size(log_file, 1000);
+    test_size(log_file, 10000);
+    test_size(log_file, 100000);
+    test_size(log_file, 1000000);
+    test_size(log_file, 10000000);
+
+    fprintf(log_file, "=== 测试完成 ===\n\n");
+    printf("=== 测试完成 ===\n");
+
+    fclose(log_file);
+}
+
+/**
+ * @brief 显示帮助信息
+ */
+void show_help() {
+    printf("数组链表性能测试程序\n");
+    printf("用法: ./alist_performance_test [选项]\n");
+    printf("选项:\n");
+    printf("  -h, --help     显示帮助信息\n");
+    printf("  -r, --run      运行性能测试\n");
+    printf("  -c, --clear    清空日志文件\n");
+    printf("\n");
+    printf("  测试结果将保存到 %s 文件中\n", LOG_FILE);
+}
+
+/**
+ * @brief 主函数
+ *
+ * @param argc 参数个数
+ * @param argv 参数数组
+ * @return int 程序退出码
+ */
+int main(int argc, char* argv[]) {
+    srand((unsigned int)time(NULL));
+
+    if (argc < 2) {
+        show_help();
+        return 0;
+    }
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-h") == 0 || strcmp(argv[i], "--help") == 0) {
+            show_help();
+            return 0;
+        } else if (strcmp(argv[i], "-r") == 0 || strcmp(argv[i], "--run") == 0) {
+            run_performance_tests();
+            return 0;
+        } else if (strcmp(argv[i], "-c") == 0 || strcmp(argv[i], "--clear") == 0) {
+            FILE* log_file = fopen(LOG_FILE, "w");
+            if (log_file) {
+                fclose(log_file);
+                printf("日志文件 %s 已清空\n", LOG_FILE);
+            }
+            return 0;
+        } else {
+            printf("未知选项: %s\n", argv[i]);
+            show_help();
+            return 1;
+        }
+    }
+
+    return 0;
+}
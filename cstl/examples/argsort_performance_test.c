@@ -0,0 +1,261 @@
+/**
+ * @file argsort_performance_test.c
+ * @brief 间接排序性能测试
+ * @version 0.1
+ * @date 2025-10-04
+ *
+ * @copyright Copyright (c) 2025
+ *
+ * 本文件按时间戳排序约2KB大小的no_stl_audio_pcm音频帧，对比以下方式：
+ * - 用algo_swap直接交换元素的快速排序（每次交换移动两个完整的帧）
+ * - 标准库qsort
+ * - algo_argsort + algo_permute（排序指针，每个帧最多移动一次）
+ * - algo_sort（元素超过阈值时自动使用间接排序）
+ *
+ * 使用utils中的高精度时间函数计算耗时，并将结果输出到日志文件中
+ */
+
+#include "cstl.h"
+#include "common/utils.h"
+#include "common/data_type.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define LOG_FILE "argsort_performance.log"
+
+/**
+ * @brief 按时间戳比较音频帧
+ *
+ * @param a 第一个元素指针
+ * @param b 第二个元素指针
+ * @return int 比较结果
+ */
+static int compare_frame_time(const void* a, const void* b) {
+    time_t x = ((const no_stl_audio_pcm*)a)->time;
+    time_t y = ((const no_stl_audio_pcm*)b)->time;
+    return (x > y) - (x < y);
+}
+
+/**
+ * @brief 直接交换元素的快速排序
+ *
+ * @param base 首元素地址
+ * @param count 元素数量
+ * @param size 元素大小
+ * @param compare 比较函数
+ * @param swaps 输入输出参数，累计交换次数
+ */
+static void swap_quick_sort(char* base, size_t count, size_t size, compare_fn_t compare, size_t* swaps) {
+    while (count > 1) {
+        size_t mid = count / 2;
+        algo_swap(base, base + mid * size, size);
+        (*swaps)++;
+
+        size_t last = 0;
+        for (size_t i = 1; i < count; i++) {
+            if (compare(base + i * size, base) < 0) {
+                last++;
+                if (last != i) {
+                    algo_swap(base + last * size, base + i * size, size);
+                    (*swaps)++;
+                }
+            }
+        }
+        algo_swap(base, base + last * size, size);
+        (*swaps)++;
+
+        /* 递归处理较小的一侧 */
+        if (last < count - last - 1) {
+            swap_quick_sort(base, last, size, compare, swaps);
+            base += (last + 1) * size;
+            count -= last + 1;
+        } else {
+            swap_quick_sort(base + (last + 1) * size, count - last - 1, size, compare, swaps);
+            count = last;
+        }
+    }
+}
+
+/**
+ * @brief 检查帧是否按时间戳有序
+ *
+ * @param frames 帧数组
+ * @param count 帧数量
+ * @return int 有序返回1
+ */
+static int frames_sorted(const no_stl_audio_pcm* frames, size_t count) {
+    for (size_t i = 1; i < count; i++) {
+        if (frames[i - 1].time > frames[i].time) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+/**
+ * @brief 输出一行测试结果
+ *
+ * @param log_file 日志文件
+ * @param name 测试名称
+ * @param elapsed 耗时（毫秒）
+ * @param ok 结果是否有序
+ */
+static void report(FILE* log_file, const char* name, long long elapsed, int ok) {
+    fprintf(log_file, "  %-30s %8lld ms  %s\n", name, elapsed, ok ? "有序" : "错误");
+    printf("  %-30s %8lld ms  %s\n", name, elapsed, ok ? "有序" : "错误");
+}
+
+/**
+ * @brief 测试指定数量的音频帧
+ *
+ * @param log_file 日志文件
+ * @param count 帧数量
+ */
+static void test_frames(FILE* log_file, size_t count) {
+    size_t size = sizeof(no_stl_audio_pcm);
+    no_stl_audio_pcm* original = (no_stl_audio_pcm*)malloc(count * size);
+    no_stl_audio_pcm* work = (no_stl_audio_pcm*)malloc(count * size);
+    vector_t* vec = vector_create(size, count, NULL, NULL);
+    vector_t* indices = vector_create(sizeof(size_t), count, NULL, NULL);
+    if (original == NULL || work == NULL || vec == NULL || indices == NULL) {
+        printf("错误: 无法创建测试数据\n");
+        free(original);
+        free(work);
+        vector_destroy(vec);
+        vector_destroy(indices);
+        return;
+    }
+
+    for (size_t i = 0; i < count; i++) {
+        for (int j = 0; j < 1024; j++) {
+            original[i].data[j] = (int16_t)(i + j);
+        }
+        original[i].time = (time_t)random_int64(0, 1000000000);
+        vector_push_back(vec, &original[i]);
+    }
+
+    fprintf(log_file, "--- %zu 个音频帧 (每帧 %zu 字节) ---\n", count, size);
+    printf("--- %zu 个音频帧 (每帧 %zu 字节) ---\n", count, size);
+
+    memcpy(work, original, count * size);
+    size_t swaps = 0;
+    long long start_time = get_current_time_ms_high_precision();
+    swap_quick_sort((char*)work, count, size, compare_frame_time, &swaps);
+    long long elapsed = get_current_time_ms_high_precision() - start_time;
+    report(log_file, "直接交换的快速排序", elapsed, frames_sorted(work, count));
+    fprintf(log_file, "    交换 %zu 次，移动约 %.1f MB\n", swaps, swaps * 2.0 * size / (1024 * 1024));
+    printf("    交换 %zu 次，移动约 %.1f MB\n", swaps, swaps * 2.0 * size / (1024 * 1024));
+
+    memcpy(work, original, count * size);
+    start_time = get_current_time_ms_high_precision();
+    qsort(work, count, size, compare_frame_time);
+    report(log_file, "qsort", get_current_time_ms_high_precision() - start_time, frames_sorted(work, count));
+
+    iterator_t* begin = vector_begin(vec);
+    iterator_t* end = vector_end(vec);
+    start_time = get_current_time_ms_high_precision();
+    algo_argsort(begin, end, compare_frame_time, indices);
+    long long argsort_time = get_current_time_ms_high_precision() - start_time;
+    algo_permute(begin, end, indices);
+    elapsed = get_current_time_ms_high_precision() - start_time;
+    report(log_file, "algo_argsort + algo_permute", elapsed, frames_sorted((no_stl_audio_pcm*)vec->data, count));
+    fprintf(log_file, "    其中argsort %lld ms，每帧最多移动一次\n", argsort_time);
+    printf("    其中argsort %lld ms，每帧最多移动一次\n", argsort_time);
+
+    memcpy(vec->data, original, count * size);
+    start_time = get_current_time_ms_high_precision();
+    algo_sort(begin, end, compare_frame_time, SORT_QUICK);
+    report(log_file, "algo_sort (自动间接排序)", get_current_time_ms_high_precision() - start_time,
+           frames_sorted((no_stl_audio_pcm*)vec->data, count));
+    iterator_destroy(begin);
+    iterator_destroy(end);
+
+    fprintf(log_file, "\n");
+    printf("\n");
+
+    free(original);
+    free(work);
+    vector_destroy(vec);
+    vector_destroy(indices);
+}
+
+/**
+ * @brief 运行完整的性能测试
+ */
+void run_performance_tests() {
+    FILE* log_file = fopen(LOG_FILE, "a");
+    if (log_file == NULL) {
+        printf("无法打开日志文件 %s\n", LOG_FILE);
+        return;
+    }
+
+    fprintf(log_file, "\n=== 间接排序性能测试报告 ===\n");
+    fprintf(log_file, "测试时间: %s\n", ctime(&(time_t){time(NULL)}));
+
+    printf("开始间接排序性能测试...\n");
+    printf("结果将保存到 %s\n\n", LOG_FILE);
+
+    test_frames(log_file, 1000);
+    test_frames(log_file, 10000);
+    test_frames(log_file, 40000);
+
+    fprintf(log_file, "=== 测试完成 ===\n\n");
+    printf("=== 测试完成 ===\n");
+
+    fclose(log_file);
+}
+
+/**
+ * @brief 显示帮助信息
+ */
+void show_help() {
+    printf("间接排序性能测试程序\n");
+    printf("用法: ./argsort_performance_test [选项]\n");
+    printf("选项:\n");
+    printf("  -h, --help     显示帮助信息\n");
+    printf("  -r, --run      运行性能测试\n");
+    printf("  -c, --clear    清空日志文件\n");
+    printf("\n");
+    printf("  测试结果将保存到 %s 文件中\n", LOG_FILE);
+}
+
+/**
+ * @brief 主函数
+ *
+ * @param argc 参数个数
+ * @param argv 参数数组
+ * @return int 程序退出码
+ */
+int main(int argc, char* argv[]) {
+    srand((unsigned int)time(NULL));
+
+    if (argc < 2) {
+        show_help();
+        return 0;
+    }
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-h") == 0 || strcmp(argv[i], "--help") == 0) {
+            show_help();
+            return 0;
+        } else if (strcmp(argv[i], "-r") == 0 || strcmp(argv[i], "--run") == 0) {
+            run_performance_tests();
+            return 0;
+        } else if (strcmp(argv[i], "-c") == 0 || strcmp(argv[i], "--clear") == 0) {
+            FILE* log_file = fopen(LOG_FILE, "w");
+            if (log_file) {
+                fclose(log_file);
+                printf("日志文件 %s 已清空\n", LOG_FILE);
+            }
+            return 0;
+        } else {
+            printf("未知选项: %s\n", argv[i]);
+            show_help();
+            return 1;
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,432 @@
+/**
+ * @file colony_performance_test.c
+ * @brief colony容器性能测试
+ * @version 0.1
+ * @date 2025-10-13
+ *
+ * @copyright Copyright (c) 2025
+ *
+ * 本文件在1K到1M个int64元素上对比vector_t、list_t和colony_t的实体表负载：
+ * - 插入全部元素
+ * - 用迭代器遍历全部元素
+ * - 随机删除一部分元素（list_t和colony_t按保存的节点/元素指针删除，vector_t按随机索引删除）
+ * - 再插入同样数量的新元素（colony_t复用空洞）
+ * - 删除插入之后再次遍历，检查colony_t的跳跃字段在有空洞时的遍历速度
+ *
+ * 元素较少时重复遍历，使每种容器遍历的元素总数大致相同。
+ * 使用utils中的高精度时间函数计算耗时，并将结果输出到日志文件中
+ */
+
+#include "cstl.h"
+#include "common/utils.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define LOG_FILE "colony_performance.log"
+#define TRAVERSE_ELEMENTS 20000000
+#define MAX_VECTOR_ERASE_OPS 20000
+
+/**
+ * @brief 被测容器
+ */
+typedef enum {
+    CONTAINER_VECTOR, /**< vector_t */
+    CONTAINER_LIST,   /**< list_t */
+    CONTAINER_COLONY, /**< colony_t */
+    CONTAINER_COUNT
+} container_t;
+
+/**
+ * @brief 测试阶段
+ */
+typedef enum {
+    PHASE_INSERT,           /**< 插入全部元素 */
+    PHASE_TRAVERSE,         /**< 迭代器遍历 */
+    PHASE_ERASE,            /**< 随机删除 */
+    PHASE_REINSERT,         /**< 再插入 */
+    PHASE_TRAVERSE_CHURNED, /**< 删除插入之后遍历 */
+    PHASE_COUNT
+} phase_t;
+
+/**
+ * @brief 阶段名称
+ */
+static const char* phase_names[PHASE_COUNT] = {
+    "插入", "迭代器遍历", "随机删除", "再插入", "删除插入后遍历"
+};
+
+/**
+ * @brief 一次测试的参数
+ */
+typedef struct {
+    size_t size;               /**< 元素数量 */
+    size_t reps;               /**< 遍历的重复次数 */
+    size_t churn_ops;          /**< 删除和再插入的次数 */
+    size_t vector_ops;         /**< vector_t删除和再插入的次数 */
+    const size_t* erase_ids;   /**< 每次删除的元素编号，互不相同 */
+    const size_t* erase_index; /**< vector_t每次删除的索引 */
+} bench_params_t;
+
+/**
+ * @brief 用迭代器遍历全部元素
+ *
+ * @param begin 起始迭代器，遍历结束后销毁
+ * @param count 输出参数，累加遍历的元素数量
+ * @return int64_t 元素之和
+ */
+static int64_t traverse_sum(iterator_t* begin, int64_t* count) {
+    int64_t sum = 0;
+    while (begin->valid(begin)) {
+        sum += *(const int64_t*)begin->current;
+        (*count)++;
+        begin->next(begin);
+    }
+    iterator_destroy(begin);
+    return sum;
+}
+
+/**
+ * @brief 测试vector_t
+ *
+ * 删除和再插入的次数较少，按每次操作的平均耗时折算到churn_ops次。
+ *
+ * @param params 测试参数
+ * @param elapsed 输出参数，各阶段耗时
+ * @param checksums 输出参数，各阶段校验值
+ */
+static void run_vector(const bench_params_t* params, long long* elapsed, int64_t* checksums) {
+    vector_t* vector = vector_create(sizeof(int64_t), 0, NULL, NULL);
+    if (vector == NULL) {
+        return;
+    }
+
+    long long start_time = get_current_time_ms_high_precision();
+    for (size_t i = 0; i < params->size; i++) {
+        int64_t value = (int64_t)i;
+        vector_push_back(vector, &value);
+    }
+    elapsed[PHASE_INSERT] = get_current_time_ms_high_precision() - start_time;
+    checksums[PHASE_INSERT] = (int64_t)vector_size(vector);
+
+    int64_t sum = 0;
+    int64_t count = 0;
+    start_time = get_current_time_ms_high_precision();
+    for (size_t r = 0; r < params->reps; r++) {
+        sum += traverse_sum(vector_begin(vector), &count);
+    }
+    elapsed[PHASE_TRAVERSE] = get_current_time_ms_high_precision() - start_time;
+    checksums[PHASE_TRAVERSE] = sum;
+
+    start_time = get_current_time_ms_high_precision();
+    for (size_t k = 0; k < params->vector_ops; k++) {
+        vector_erase(vector, params->erase_index[k]);
+    }
+    elapsed[PHASE_ERASE] = (get_current_time_ms_high_precision() - start_time) *
+                           (long long)params->churn_ops / (long long)params->vector_ops;
+    checksums[PHASE_ERASE] = (int64_t)(vector_size(vector) + params->vector_ops - params->churn_ops);
+
+    start_time = get_current_time_ms_high_precision();
+    for (size_t k = 0; k < params->vector_ops; k++) {
+        int64_t value = (int64_t)(params->size + k);
+        vector_insert(vector, params->erase_index[params->vector_ops - 1 - k], &value);
+    }
+    elapsed[PHASE_REINSERT] = (get_current_time_ms_high_precision() - start_time) *
+                              (long long)params->churn_ops / (long long)params->vector_ops;
+    checksums[PHASE_REINSERT] = (int64_t)vector_size(vector);
+
+    count = 0;
+    start_time = get_current_time_ms_high_precision();
+    for (size_t r = 0; r < params->reps; r++) {
+        traverse_sum(vector_begin(vector), &count);
+    }
+    elapsed[PHASE_TRAVERSE_CHURNED] = get_current_time_ms_high_precision() - start_time;
+    checksums[PHASE_TRAVERSE_CHURNED] = count;
+
+    vector_destroy(vector);
+}
+
+/**
+ * @brief 测试list_t
+ *
+ * @param params 测试参数
+ * @param elapsed 输出参数，各阶段耗时
+ * @param checksums 输出参数，各阶段校验值
+ */
+static void run_list(const bench_params_t* params, long long* elapsed, int64_t* checksums) {
+    list_t* list = list_create(sizeof(int64_t), NULL, NULL);
+    list_node_t** nodes = (list_node_t**)malloc(params->size * sizeof(list_node_t*));
+    if (list == NULL || nodes == NULL) {
+        list_destroy(list);
+        free(nodes);
+        return;
+    }
+
+    long long start_time = get_current_time_ms_high_precision();
+    for (size_t i = 0; i < params->size; i++) {
+        int64_t value = (int64_t)i;
+        list_push_back(list, &value);
+        nodes[i] = list->tail;
+    }
+    elapsed[PHASE_INSERT] = get_current_time_ms_high_precision() - start_time;
+    checksums[PHASE_INSERT] = (int64_t)list_size(list);
+
+    int64_t sum = 0;
+    int64_t count = 0;
+    start_time = get_current_time_ms_high_precision();
+    for (size_t r = 0; r < params->reps; r++) {
+        sum += traverse_sum(list_begin(list), &count);
+    }
+    elapsed[PHASE_TRAVERSE] = get_current_time_ms_high_precision() - start_time;
+    checksums[PHASE_TRAVERSE] = sum;
+
+    start_time = get_current_time_ms_high_precision();
+    for (size_t k = 0; k < params->churn_ops; k++) {
+        list_erase(list, nodes[params->erase_ids[k]]);
+    }
+    elapsed[PHASE_ERASE] = get_current_time_ms_high_precision() - start_time;
+    checksums[PHASE_ERASE] = (int64_t)list_size(list);
+
+    start_time = get_current_time_ms_high_precision();
+    for (size_t k = 0; k < params->churn_ops; k++) {
+        int64_t value = (int64_t)(params->size + k);
+        list_push_back(list, &value);
+    }
+    elapsed[PHASE_REINSERT] = get_current_time_ms_high_precision() - start_time;
+    checksums[PHASE_REINSERT] = (int64_t)list_size(list);
+
+    count = 0;
+    start_time = get_current_time_ms_high_precision();
+    for (size_t r = 0; r < params->reps; r++) {
+        traverse_sum(list_begin(list), &count);
+    }
+    elapsed[PHASE_TRAVERSE_CHURNED] = get_current_time_ms_high_precision() - start_time;
+    checksums[PHASE_TRAVERSE_CHURNED] = count;
+
+    list_destroy(list);
+    free(nodes);
+}
+
+/**
+ * @brief 测试colony_t
+ *
+ * @param params 测试参数
+ * @param elapsed 输出参数，各阶段耗时
+ * @param checksums 输出参数，各阶段校验值
+ */
+static void run_colony(const bench_params_t* params, long long* elapsed, int64_t* checksums) {
+    colony_t* colony = colony_create(sizeof(int64_t), NULL, NULL);
+    void** elements = (void**)malloc(params->size * sizeof(void*));
+    if (colony == NULL || elements == NULL) {
+        colony_destroy(colony);
+        free(elements);
+        return;
+    }
+
+    long long start_time = get_current_time_ms_high_precision();
+    for (size_t i = 0; i < params->size; i++) {
+        int64_t value = (int64_t)i;
+        colony_insert(colony, &value, &elements[i]);
+    }
+    elapsed[PHASE_INSERT] = get_current_time_ms_high_precision() - start_time;
+    checksums[PHASE_INSERT] = (int64_t)colony_size(colony);
+
+    int64_t sum = 0;
+    int64_t count = 0;
+    start_time = get_current_time_ms_high_precision();
+    for (size_t r = 0; r < params->reps; r++) {
+        sum += traverse_sum(colony_begin(colony), &count);
+    }
+    elapsed[PHASE_TRAVERSE] = get_current_time_ms_high_precision() - start_time;
+    checksums[PHASE_TRAVERSE] = sum;
+
+    start_time = get_current_time_ms_high_precision();
+    for (size_t k = 0; k < params->churn_ops; k++) {
+        colony_erase(colony, elements[params->erase_ids[k]]);
+    }
+    elapsed[PHASE_ERASE] = get_current_time_ms_high_precision() - start_time;
+    checksums[PHASE_ERASE] = (int64_t)colony_size(colony);
+
+    start_time = get_current_time_ms_high_precision();
+    for (size_t k = 0; k < params->churn_ops; k++) {
+        int64_t value = (int64_t)(params->size + k);
+        colony_insert(colony, &value, NULL);
+    }
+    elapsed[PHASE_REINSERT] = get_current_time_ms_high_precision() - start_time;
+    checksums[PHASE_REINSERT] = (int64_t)colony_size(colony);
+
+    count = 0;
+    start_time = get_current_time_ms_high_precision();
+    for (size_t r = 0; r < params->reps; r++) {
+        traverse_sum(colony_begin(colony), &count);
+    }
+    elapsed[PHASE_TRAVERSE_CHURNED] = get_current_time_ms_high_precision() - start_time;
+    checksums[PHASE_TRAVERSE_CHURNED] = count;
+
+    colony_destroy(colony);
+    free(elements);
+}
+
+/**
+ * @brief 测试指定大小的容器
+ *
+ * @param log_file 日志文件
+ * @param size 元素数量，至少为2
+ */
+static void test_size(FILE* log_file, size_t size) {
+    bench_params_t params;
+    params.size = size;
+    params.reps = size < TRAVERSE_ELEMENTS ? TRAVERSE_ELEMENTS / size : 1;
+    params.churn_ops = size / 2;
+    params.vector_ops = params.churn_ops < MAX_VECTOR_ERASE_OPS ? params.churn_ops : MAX_VECTOR_ERASE_OPS;
+
+    size_t* ids = (size_t*)malloc(size * sizeof(size_t));
+    size_t* erase_index = (size_t*)malloc(params.vector_ops * sizeof(size_t));
+    if (ids == NULL || erase_index == NULL) {
+        printf("错误: 无法创建测试数据\n");
+        free(ids);
+        free(erase_index);
+        return;
+    }
+
+    /* 打乱编号，前churn_ops个作为删除目标 */
+    for (size_t i = 0; i < size; i++) {
+        ids[i] = i;
+    }
+    for (size_t i = size - 1; i > 0; i--) {
+        size_t j = (size_t)random_int64(0, (int64_t)i);
+        size_t temp = ids[i];
+        ids[i] = ids[j];
+        ids[j] = temp;
+    }
+    for (size_t k = 0; k < params.vector_ops; k++) {
+        erase_index[k] = (size_t)random_int64(0, (int64_t)(size - k - 1));
+    }
+    params.erase_ids = ids;
+    params.erase_index = erase_index;
+
+    long long elapsed[CONTAINER_COUNT][PHASE_COUNT];
+    int64_t checksums[CONTAINER_COUNT][PHASE_COUNT];
+    for (int c = 0; c < CONTAINER_COUNT; c++) {
+        for (int phase = 0; phase < PHASE_COUNT; phase++) {
+            elapsed[c][phase] = -1;
+            checksums[c][phase] = 0;
+        }
+    }
+
+    run_vector(&params, elapsed[CONTAINER_VECTOR], checksums[CONTAINER_VECTOR]);
+    run_list(&params, elapsed[CONTAINER_LIST], checksums[CONTAINER_LIST]);
+    run_colony(&params, elapsed[CONTAINER_COLONY], checksums[CONTAINER_COLONY]);
+
+    fprintf(log_file, "--- %zu 个元素（遍历重复 %zu 次，删除再插入 %zu 次，vector_t实测 %zu 次后折算） ---\n",
+            size, params.reps, params.churn_ops, params.vector_ops);
+    printf("--- %zu 个元素（遍历重复 %zu 次，删除再插入 %zu 次，vector_t实测 %zu 次后折算） ---\n",
+           size, params.reps, params.churn_ops, params.vector_ops);
+    fprintf(log_file, "  %-24s %12s %12s %12s  %s\n", "阶段", "vector_t", "list_t", "colony_t", "校验");
+    printf("  %-24s %12s %12s %12s  %s\n", "阶段", "vector_t", "list_t", "colony_t", "校验");
+
+    for (int phase = 0; phase < PHASE_COUNT; phase++) {
+        int64_t checksum = checksums[CONTAINER_COLONY][phase];
+        const char* status = "一致";
+        for (int c = 0; c < CONTAINER_COUNT; c++) {
+            if (checksums[c][phase] != checksum) {
+                status = "不一致";
+            }
+        }
+        fprintf(log_file, "  %-24s %9lld ms %9lld ms %9lld ms  %s %lld\n", phase_names[phase],
+                elapsed[CONTAINER_VECTOR][phase], elapsed[CONTAINER_LIST][phase],
+                elapsed[CONTAINER_COLONY][phase], status, (long long)checksum);
+        printf("  %-24s %9lld ms %9lld ms %9lld ms  %s %lld\n", phase_names[phase],
+               elapsed[CONTAINER_VECTOR][phase], elapsed[CONTAINER_LIST][phase],
+               elapsed[CONTAINER_COLONY][phase], status, (long long)checksum);
+    }
+
+    fprintf(log_file, "\n");
+    printf("\n");
+
+    free(ids);
+    free(erase_index);
+}
+
+/**
+ * @brief 运行完整的性能测试
+ */
+void run_performance_tests() {
+    FILE* log_file = fopen(LOG_FILE, "a");
+    if (log_file == NULL) {
+        printf("无法打开日志文件 %s\n", LOG_FILE);
+        return;
+    }
+
+    fprintf(log_file, "\n=== colony容器性能测试报告 ===\n");
+    fprintf(log_file, "测试时间: %s", ctime(&(time_t){time(NULL)}));
+    fprintf(log_file, "元素类型: int64，colony_t块容量 %d 到 %d\n\n",
+            COLONY_DEFAULT_MIN_BLOCK_CAPACITY, COLONY_DEFAULT_MAX_BLOCK_CAPACITY);
+
+    printf("开始colony容器性能测试...\n");
+    printf("结果将保存到 %s\n\n", LOG_FILE);
+
+    test_size(log_file, 1000);
+    test_size(log_file, 10000);
+    test_size(log_file, 100000);
+    test_size(log_file, 1000000);
+
+    fprintf(log_file, "=== 测试完成 ===\n\n");
+    printf("=== 测试完成 ===\n");
+
+    fclose(log_file);
+}
+
+/**
+ * @brief 显示帮助信息
+ */
+void show_help() {
+    printf("colony容器性能测试程序\n");
+    printf("用法: ./colony_performance_test [选项]\n");
+    printf("选项:\n");
+    printf("  -h, --help     显示帮助信息\n");
+    printf("  -r, --run      运行性能测试\n");
+    printf("  -c, --clear    清空日志文件\n");
+    printf("\n");
+    printf("  测试结果将保存到 %s 文件中\n", LOG_FILE);
+}
+
+/**
+ * @brief 主函数
+ *
+ * @param argc 参数个数
+ * @param argv 参数数组
+ * @return int 程序退出码
+ */
+int main(int argc, char* argv[]) {
+    srand((unsigned int)time(NULL));
+
+    if (argc < 2) {
+        show_help();
+        return 0;
+    }
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-h") == 0 || strcmp(argv[i], "--help") == 0) {
+            show_help();
+            return 0;
+        } else if (strcmp(argv[i], "-r") == 0 || strcmp(argv[i], "--run") == 0) {
+            run_performance_tests();
+            return 0;
+        } else if (strcmp(argv[i], "-c") == 0 || strcmp(argv[i], "--clear") == 0) {
+            FILE* log_file = fopen(LOG_FILE, "w");
+            if (log_file) {
+                fclose(log_file);
+                printf("日志文件 %s 已清空\n", LOG_FILE);
+            }
+            return 0;
+        } else {
+            printf("未知选项: %s\n", argv[i]);
+            show_help();
+            return 1;
+        }
+    }
+
+    return 0;
+}
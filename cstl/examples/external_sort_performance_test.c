@@ -0,0 +1,295 @@
+/**
+ * @file external_sort_performance_test.c
+ * @brief 外部排序性能测试
+ * @version 0.1
+ * @date 2025-10-01
+ *
+ * @copyright Copyright (c) 2025
+ *
+ * 本文件生成数据量为内存预算10倍的定长记录文件（模拟抓包日志：8字节时间戳 + 24字节负载），
+ * 测试以下方式的耗时：
+ * - 全部读入内存后qsort再写回（不受内存预算限制，作为对照）
+ * - external_sort_file 顺序排序有序段
+ * - external_sort_file 在默认线程池上并行排序有序段
+ *
+ * 每次排序后检查输出文件有序且记录数量不变。最后用几条记录的内存预算检查最小预算的边界。
+ * 使用utils中的高精度时间函数计算耗时，并将结果输出到日志文件中
+ */
+
+#include "cstl.h"
+#include "common/utils.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define LOG_FILE "external_sort_performance.log"
+#define INPUT_FILE "external_sort_input.bin"
+#define OUTPUT_FILE "external_sort_output.bin"
+#define MEMORY_BUDGET (32u * 1024 * 1024)
+#define DATA_FACTOR 10
+
+/**
+ * @brief 抓包日志记录
+ */
+typedef struct {
+    uint64_t timestamp;     /**< 时间戳，排序键 */
+    uint32_t payload[6];    /**< 负载 */
+} capture_record_t;
+
+/**
+ * @brief 按时间戳比较记录
+ *
+ * @param a 第一条记录指针
+ * @param b 第二条记录指针
+ * @return int 比较结果
+ */
+static int compare_record(const void* a, const void* b) {
+    uint64_t x = ((const capture_record_t*)a)->timestamp;
+    uint64_t y = ((const capture_record_t*)b)->timestamp;
+    return (x > y) - (x < y);
+}
+
+/**
+ * @brief 生成输入文件
+ *
+ * @param count 记录数量
+ * @return int 成功返回1
+ */
+static int generate_input(size_t count) {
+    FILE* file = fopen(INPUT_FILE, "wb");
+    if (file == NULL) {
+        return 0;
+    }
+
+    rng_t rng;
+    rng_seed(&rng, (uint64_t)time(NULL));
+    capture_record_t block[4096];
+    size_t written = 0;
+    while (written < count) {
+        size_t n = count - written < 4096 ? count - written : 4096;
+        for (size_t i = 0; i < n; i++) {
+            block[i].timestamp = rng_next(&rng) >> 16;
+            for (int j = 0; j < 6; j++) {
+                block[i].payload[j] = rng_next_u32(&rng);
+            }
+        }
+        if (fwrite(block, sizeof(capture_record_t), n, file) != n) {
+            fclose(file);
+            return 0;
+        }
+        written += n;
+    }
+    fclose(file);
+    return 1;
+}
+
+/**
+ * @brief 检查输出文件有序且记录数量正确
+ *
+ * @param count 期望的记录数量
+ * @return int 正确返回1
+ */
+static int verify_output(size_t count) {
+    FILE* file = fopen(OUTPUT_FILE, "rb");
+    if (file == NULL) {
+        return 0;
+    }
+
+    capture_record_t block[4096];
+    uint64_t previous = 0;
+    size_t total = 0;
+    int sorted = 1;
+    size_t n;
+    while ((n = fread(block, sizeof(capture_record_t), 4096, file)) > 0) {
+        for (size_t i = 0; i < n; i++) {
+            if (block[i].timestamp < previous) {
+                sorted = 0;
+            }
+            previous = block[i].timestamp;
+        }
+        total += n;
+    }
+    fclose(file);
+    return sorted && total == count;
+}
+
+/**
+ * @brief 全部读入内存排序，作为对照
+ *
+ * @param count 记录数量
+ * @return int 成功返回1
+ */
+static int sort_in_memory(size_t count) {
+    capture_record_t* records = (capture_record_t*)malloc(count * sizeof(capture_record_t));
+    if (records == NULL) {
+        return 0;
+    }
+    FILE* input = fopen(INPUT_FILE, "rb");
+    FILE* output = fopen(OUTPUT_FILE, "wb");
+    int ok = input != NULL && output != NULL &&
+             fread(records, sizeof(capture_record_t), count, input) == count;
+    if (ok) {
+        qsort(records, count, sizeof(capture_record_t), compare_record);
+        ok = fwrite(records, sizeof(capture_record_t), count, output) == count;
+    }
+    if (input != NULL) {
+        fclose(input);
+    }
+    if (output != NULL) {
+        fclose(output);
+    }
+    free(records);
+    return ok;
+}
+
+/**
+ * @brief 检查最小内存预算的边界：两条记录应被拒绝，三条与四条记录应能正确排序
+ *
+ * @param log_file 日志文件
+ */
+static void run_budget_boundary_tests(FILE* log_file) {
+    const size_t count = 100;
+    const size_t budgets[3] = {2, 3, 4};
+
+    if (!generate_input(count)) {
+        printf("错误: 无法生成输入文件\n");
+        return;
+    }
+
+    for (int i = 0; i < 3; i++) {
+        external_sort_config_t config;
+        external_sort_config_init(&config);
+        config.memory_budget = budgets[i] * sizeof(capture_record_t);
+
+        external_sort_stats_t stats = {0};
+        error_code_t err = external_sort_file(INPUT_FILE, OUTPUT_FILE, sizeof(capture_record_t),
+                                              compare_record, &config, &stats);
+        int ok = budgets[i] < 3 ? err == CSTL_ERROR_INVALID_ARGUMENT : err == CSTL_OK && verify_output(count);
+
+        fprintf(log_file, "  内存预算 %zu 条记录, %zu 条输入: 返回 %d, 有序段 %zu, 归并 %zu 趟  %s\n",
+                budgets[i], count, (int)err, stats.runs, stats.merge_passes, ok ? "正确" : "错误");
+        printf("  内存预算 %zu 条记录, %zu 条输入: 返回 %d, 有序段 %zu, 归并 %zu 趟  %s\n",
+               budgets[i], count, (int)err, stats.runs, stats.merge_passes, ok ? "正确" : "错误");
+    }
+}
+
+/**
+ * @brief 运行完整的性能测试
+ */
+void run_performance_tests() {
+    FILE* log_file = fopen(LOG_FILE, "a");
+    if (log_file == NULL) {
+        printf("无法打开日志文件 %s\n", LOG_FILE);
+        return;
+    }
+
+    size_t count = (size_t)MEMORY_BUDGET * DATA_FACTOR / sizeof(capture_record_t);
+
+    fprintf(log_file, "\n=== 外部排序性能测试报告 ===\n");
+    fprintf(log_file, "测试时间: %s", ctime(&(time_t){time(NULL)}));
+    fprintf(log_file, "内存预算: %u MB, 数据量: %u MB (%zu 条 %zu 字节的记录)\n\n",
+            MEMORY_BUDGET >> 20, (MEMORY_BUDGET * DATA_FACTOR) >> 20, count, sizeof(capture_record_t));
+
+    printf("开始外部排序性能测试...\n");
+    printf("结果将保存到 %s\n\n", LOG_FILE);
+    printf("生成 %u MB 输入文件...\n", (MEMORY_BUDGET * DATA_FACTOR) >> 20);
+
+    if (!generate_input(count)) {
+        printf("错误: 无法生成输入文件\n");
+        fclose(log_file);
+        return;
+    }
+
+    long long start_time = get_current_time_ms_high_precision();
+    int ok = sort_in_memory(count);
+    long long elapsed = get_current_time_ms_high_precision() - start_time;
+    ok = ok && verify_output(count);
+    fprintf(log_file, "  %-36s %8lld ms  %s\n", "全部读入内存 qsort (不限内存)", elapsed, ok ? "正确" : "错误");
+    printf("  %-36s %8lld ms  %s\n", "全部读入内存 qsort (不限内存)", elapsed, ok ? "正确" : "错误");
+
+    const char* names[2] = {"external_sort_file (顺序)", "external_sort_file (并行)"};
+    for (int parallel = 0; parallel < 2; parallel++) {
+        external_sort_config_t config;
+        external_sort_config_init(&config);
+        config.memory_budget = MEMORY_BUDGET;
+        config.parallel = parallel;
+
+        external_sort_stats_t stats;
+        start_time = get_current_time_ms_high_precision();
+        error_code_t err = external_sort_file(INPUT_FILE, OUTPUT_FILE, sizeof(capture_record_t),
+                                              compare_record, &config, &stats);
+        elapsed = get_current_time_ms_high_precision() - start_time;
+        ok = err == CSTL_OK && verify_output(count);
+
+        fprintf(log_file, "  %-36s %8lld ms  有序段 %zu, 归并 %zu 趟  %s\n",
+                names[parallel], elapsed, stats.runs, stats.merge_passes, ok ? "正确" : "错误");
+        printf("  %-36s %8lld ms  有序段 %zu, 归并 %zu 趟  %s\n",
+               names[parallel], elapsed, stats.runs, stats.merge_passes, ok ? "正确" : "错误");
+    }
+
+    fprintf(log_file, "\n最小内存预算边界:\n");
+    printf("\n最小内存预算边界:\n");
+    run_budget_boundary_tests(log_file);
+
+    remove(INPUT_FILE);
+    remove(OUTPUT_FILE);
+
+    fprintf(log_file, "\n=== 测试完成 ===\n\n");
+    printf("\n=== 测试完成 ===\n");
+
+    fclose(log_file);
+}
+
+/**
+ * @brief 显示帮助信息
+ */
+void show_help() {
+    printf("外部排序性能测试程序\n");
+    printf("用法: ./external_sort_performance_test [选项]\n");
+    printf("选项:\n");
+    printf("  -h, --help     显示帮助信息\n");
+    printf("  -r, --run      运行性能测试\n");
+    printf("  -c, --clear    清空日志文件\n");
+    printf("\n");
+    printf("  测试结果将保存到 %s 文件中\n", LOG_FILE);
+}
+
+/**
+ * @brief 主函数
+ *
+ * @param argc 参数个数
+ * @param argv 参数数组
+ * @return int 程序退出码
+ */
+int main(int argc, char* argv[]) {
+    srand((unsigned int)time(NULL));
+
+    if (argc < 2) {
+        show_help();
+        return 0;
+    }
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-h") == 0 || strcmp(argv[i], "--help") == 0) {
+            show_help();
+            return 0;
+        } else if (strcmp(argv[i], "-r") == 0 || strcmp(argv[i], "--run") == 0) {
+            run_performance_tests();
+            return 0;
+        } else if (strcmp(argv[i], "-c") == 0 || strcmp(argv[i], "--clear") == 0) {
+            FILE* log_file = fopen(LOG_FILE, "w");
+            if (log_file) {
+                fclose(log_file);
+                printf("日志文件 %s 已清空\n", LOG_FILE);
+            }
+            return 0;
+        } else {
+            printf("未知选项: %s\n", argv[i]);
+            show_help();
+            return 1;
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,623 @@
+/**
+ * @file flat_map_performance_test.c
+ * @brief 有序扁平映射性能测试
+ * @version 0.1
+ * @date 2025-10-16
+ *
+ * @copyright Copyright (c) 2025
+ *
+ * 本文件在8到100K个uint64键、int64值上对比以下三种字典：
+ * - 链式哈希表：每个键值对一个节点，桶数是不小于元素数量的2的幂，
+ *   与通用的C哈希表一样通过函数指针计算哈希和比较键（本文件内实现，作为基准）；
+ *   查找与flat_map_find一样经过一次不能内联的函数调用
+ * - flat_map_t分离布局：键和值分别存放在两个有序向量中
+ * - flat_map_t交错布局：键值对存放在一个有序向量中
+ * - flat_map_t整数键：分离布局，比较函数为NULL，键按无符号整数比较，查找不调用比较函数
+ *
+ * 测试阶段：
+ * - 逐个插入：哈希表逐个插入，flat_map_t逐个flat_map_insert（O(n^2)，只在较小规模上测试）
+ * - 批量建立：哈希表逐个插入，flat_map_t用flat_map_build一次排序去重
+ * - 查找命中、查找未命中：共LOOKUP_COUNT次随机查找
+ * - 成批插入：再插入元素数量十分之一的新键，flat_map_t用flat_map_insert_batch合并
+ *
+ * 使用utils中的高精度时间函数计算耗时，并将结果输出到日志文件中
+ */
+
+#include "cstl.h"
+#include "common/utils.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define LOG_FILE "flat_map_performance.log"
+#define LOOKUP_COUNT 10000000
+#define LOOKUP_KEYS 1000000
+#define SINGLE_INSERT_LIMIT 20000
+
+/**
+ * @brief 测试阶段
+ */
+typedef enum {
+    PHASE_INSERT,       /**< 逐个插入 */
+    PHASE_BUILD,        /**< 批量建立 */
+    PHASE_LOOKUP_HIT,   /**< 查找命中 */
+    PHASE_LOOKUP_MISS,  /**< 查找未命中 */
+    PHASE_BATCH,        /**< 成批插入 */
+    PHASE_COUNT
+} phase_t;
+
+/**
+ * @brief 阶段名称
+ */
+static const char* phase_names[PHASE_COUNT] = {
+    "逐个插入", "批量建立", "查找命中", "查找未命中", "成批插入"
+};
+
+/**
+ * @brief 字典种类
+ */
+typedef enum {
+    KIND_HASH,          /**< 链式哈希表 */
+    KIND_SEPARATE,      /**< flat_map_t分离布局 */
+    KIND_INTERLEAVED,   /**< flat_map_t交错布局 */
+    KIND_INTEGER,       /**< flat_map_t整数键 */
+    KIND_COUNT
+} kind_t;
+
+/**
+ * @brief 字典名称
+ */
+static const char* kind_names[KIND_COUNT] = {
+    "哈希表", "flat_map分离", "flat_map交错", "flat_map整数键"
+};
+
+/**
+ * @brief 一次测试的参数
+ */
+typedef struct {
+    size_t size;                /**< 元素数量 */
+    const uint64_t* keys;       /**< 无序的键，共size个，互不相同 */
+    const int64_t* values;      /**< 与keys对应的值 */
+    const uint64_t* hits;       /**< 查找命中的键，共LOOKUP_KEYS个 */
+    const uint64_t* misses;     /**< 查找未命中的键，共LOOKUP_KEYS个 */
+    const uint64_t* batch_keys; /**< 成批插入的新键，共size / 10个 */
+    const int64_t* batch_values;/**< 与batch_keys对应的值 */
+} bench_params_t;
+
+/**
+ * @brief 链式哈希表节点
+ */
+typedef struct hash_node_t {
+    struct hash_node_t* next;   /**< 同一个桶中的下一个节点 */
+    uint64_t key;               /**< 键 */
+    int64_t value;              /**< 值 */
+} hash_node_t;
+
+/**
+ * @brief 链式哈希表
+ */
+typedef struct {
+    hash_node_t** buckets;      /**< 桶数组 */
+    size_t mask;                /**< 桶数减1 */
+    size_t size;                /**< 元素数量 */
+    uint64_t (*hash)(const void* key);              /**< 哈希函数 */
+    int (*compare)(const void* a, const void* b);   /**< 比较函数 */
+} hash_table_t;
+
+/**
+ * @brief uint64_t比较函数
+ */
+static int compare_u64(const void* a, const void* b) {
+    uint64_t x = *(const uint64_t*)a;
+    uint64_t y = *(const uint64_t*)b;
+    return (x > y) - (x < y);
+}
+
+/**
+ * @brief uint64_t哈希函数（MurmurHash3的最终混合）
+ */
+static uint64_t hash_u64(const void* key) {
+    uint64_t x = *(const uint64_t*)key;
+    x ^= x >> 33;
+    x *= 0xff51afd7ed558ccdULL;
+    x ^= x >> 33;
+    x *= 0xc4ceb9fe1a85ec53ULL;
+    x ^= x >> 33;
+    return x;
+}
+
+/**
+ * @brief 创建链式哈希表
+ *
+ * @param capacity 预计的元素数量
+ * @return hash_table_t* 哈希表指针，失败返回NULL
+ */
+static hash_table_t* hash_table_create(size_t capacity) {
+    hash_table_t* table = (hash_table_t*)malloc(sizeof(hash_table_t));
+    if (table == NULL) {
+        return NULL;
+    }
+
+    size_t bucket_count = 16;
+    while (bucket_count < capacity) {
+        bucket_count *= 2;
+    }
+
+    table->buckets = (hash_node_t**)calloc(bucket_count, sizeof(hash_node_t*));
+    if (table->buckets == NULL) {
+        free(table);
+        return NULL;
+    }
+    table->mask = bucket_count - 1;
+    table->size = 0;
+    table->hash = hash_u64;
+    table->compare = compare_u64;
+
+    return table;
+}
+
+/**
+ * @brief 销毁链式哈希表
+ *
+ * @param table 哈希表指针
+ */
+static void hash_table_destroy(hash_table_t* table) {
+    if (table == NULL) {
+        return;
+    }
+
+    for (size_t i = 0; i <= table->mask; i++) {
+        hash_node_t* node = table->buckets[i];
+        while (node != NULL) {
+            hash_node_t* next = node->next;
+            free(node);
+            node = next;
+        }
+    }
+    free(table->buckets);
+    free(table);
+}
+
+/**
+ * @brief 查找键对应的值
+ *
+ * @param table 哈希表指针
+ * @param key 键指针
+ * @return int64_t* 值指针，键不存在时返回NULL
+ */
+static int64_t* hash_table_find(const hash_table_t* table, const uint64_t* key) {
+    hash_node_t* node = table->buckets[table->hash(key) & table->mask];
+    while (node != NULL) {
+        if (table->compare(&node->key, key) == 0) {
+            return &node->value;
+        }
+        node = node->next;
+    }
+    return NULL;
+}
+
+/**
+ * @brief 查找键对应的值，接口与flat_map_find相同
+ *
+ * @param table 哈希表指针
+ * @param key 键指针
+ * @param value 输出参数，存储值指针
+ * @return error_code_t 错误码，键不存在时返回CSTL_ERROR_NOT_FOUND
+ */
+static error_code_t hash_table_lookup(const hash_table_t* table, const void* key, void** value) {
+    if (table == NULL || key == NULL || value == NULL) {
+        return CSTL_ERROR_NULL_POINTER;
+    }
+
+    int64_t* found = hash_table_find(table, (const uint64_t*)key);
+    if (found == NULL) {
+        return CSTL_ERROR_NOT_FOUND;
+    }
+    *value = found;
+    return CSTL_OK;
+}
+
+/**
+ * @brief 查找阶段通过这个函数指针调用hash_table_lookup
+ *
+ * 指针是volatile的，编译器不能把查找内联进测试循环，哈希表和flat_map_find一样付出一次函数调用的代价
+ */
+static error_code_t (*volatile hash_table_lookup_call)(const hash_table_t* table, const void* key,
+                                                       void** value) = hash_table_lookup;
+
+/**
+ * @brief 插入键值对，键已经存在时不插入；元素数量超过桶数时桶数加倍
+ *
+ * @param table 哈希表指针
+ * @param key 键
+ * @param value 值
+ * @return int 插入成功返回非零，否则返回零
+ */
+static int hash_table_insert(hash_table_t* table, uint64_t key, int64_t value) {
+    if (hash_table_find(table, &key) != NULL) {
+        return 0;
+    }
+
+    if (table->size > table->mask) {
+        size_t bucket_count = (table->mask + 1) * 2;
+        hash_node_t** buckets = (hash_node_t**)calloc(bucket_count, sizeof(hash_node_t*));
+        if (buckets == NULL) {
+            return 0;
+        }
+        for (size_t i = 0; i <= table->mask; i++) {
+            hash_node_t* node = table->buckets[i];
+            while (node != NULL) {
+                hash_node_t* next = node->next;
+                size_t index = table->hash(&node->key) & (bucket_count - 1);
+                node->next = buckets[index];
+                buckets[index] = node;
+                node = next;
+            }
+        }
+        free(table->buckets);
+        table->buckets = buckets;
+        table->mask = bucket_count - 1;
+    }
+
+    hash_node_t* node = (hash_node_t*)malloc(sizeof(hash_node_t));
+    if (node == NULL) {
+        return 0;
+    }
+    size_t index = table->hash(&key) & table->mask;
+    node->key = key;
+    node->value = value;
+    node->next = table->buckets[index];
+    table->buckets[index] = node;
+    table->size++;
+
+    return 1;
+}
+
+/**
+ * @brief 测试链式哈希表
+ *
+ * @param params 测试参数
+ * @param elapsed 输出参数，各阶段耗时
+ * @param checksums 输出参数，各阶段校验值
+ */
+static void run_hash(const bench_params_t* params, long long* elapsed, int64_t* checksums) {
+    size_t batch_count = params->size / 10;
+    long long start_time;
+
+    /* 从最小的桶数组开始插入，与flat_map_t逐个插入时的扩容对应 */
+    if (params->size <= SINGLE_INSERT_LIMIT) {
+        hash_table_t* table = hash_table_create(0);
+        if (table == NULL) {
+            return;
+        }
+        start_time = get_current_time_ms_high_precision();
+        for (size_t i = 0; i < params->size; i++) {
+            hash_table_insert(table, params->keys[i], params->values[i]);
+        }
+        elapsed[PHASE_INSERT] = get_current_time_ms_high_precision() - start_time;
+        checksums[PHASE_INSERT] = (int64_t)table->size;
+        hash_table_destroy(table);
+    }
+
+    start_time = get_current_time_ms_high_precision();
+    hash_table_t* table = hash_table_create(params->size);
+    if (table == NULL) {
+        return;
+    }
+    for (size_t i = 0; i < params->size; i++) {
+        hash_table_insert(table, params->keys[i], params->values[i]);
+    }
+    elapsed[PHASE_BUILD] = get_current_time_ms_high_precision() - start_time;
+    checksums[PHASE_BUILD] = (int64_t)table->size;
+
+    int64_t sum = 0;
+    start_time = get_current_time_ms_high_precision();
+    for (size_t i = 0; i < LOOKUP_COUNT; i++) {
+        void* value;
+        if (hash_table_lookup_call(table, &params->hits[i % LOOKUP_KEYS], &value) == CSTL_OK) {
+            sum += *(const int64_t*)value;
+        }
+    }
+    elapsed[PHASE_LOOKUP_HIT] = get_current_time_ms_high_precision() - start_time;
+    checksums[PHASE_LOOKUP_HIT] = sum;
+
+    int64_t found = 0;
+    start_time = get_current_time_ms_high_precision();
+    for (size_t i = 0; i < LOOKUP_COUNT; i++) {
+        void* value;
+        found += hash_table_lookup_call(table, &params->misses[i % LOOKUP_KEYS], &value) == CSTL_OK;
+    }
+    elapsed[PHASE_LOOKUP_MISS] = get_current_time_ms_high_precision() - start_time;
+    checksums[PHASE_LOOKUP_MISS] = found;
+
+    start_time = get_current_time_ms_high_precision();
+    for (size_t i = 0; i < batch_count; i++) {
+        hash_table_insert(table, params->batch_keys[i], params->batch_values[i]);
+    }
+    elapsed[PHASE_BATCH] = get_current_time_ms_high_precision() - start_time;
+    checksums[PHASE_BATCH] = (int64_t)table->size;
+
+    hash_table_destroy(table);
+}
+
+/**
+ * @brief 测试flat_map_t
+ *
+ * @param params 测试参数
+ * @param layout 存储布局
+ * @param compare 比较函数指针，为NULL时键按无符号整数比较
+ * @param elapsed 输出参数，各阶段耗时
+ * @param checksums 输出参数，各阶段校验值
+ */
+static void run_flat_map(const bench_params_t* params, flat_map_layout_t layout, comparator_fn_t compare,
+                         long long* elapsed, int64_t* checksums) {
+    size_t batch_count = params->size / 10;
+    long long start_time;
+
+    flat_map_t* map = flat_map_create(sizeof(uint64_t), sizeof(int64_t), compare, layout, NULL, NULL, NULL);
+    if (map == NULL) {
+        return;
+    }
+
+    if (params->size <= SINGLE_INSERT_LIMIT) {
+        start_time = get_current_time_ms_high_precision();
+        for (size_t i = 0; i < params->size; i++) {
+            flat_map_insert(map, &params->keys[i], &params->values[i]);
+        }
+        elapsed[PHASE_INSERT] = get_current_time_ms_high_precision() - start_time;
+        checksums[PHASE_INSERT] = (int64_t)flat_map_size(map);
+        flat_map_destroy(map);
+
+        map = flat_map_create(sizeof(uint64_t), sizeof(int64_t), compare, layout, NULL, NULL, NULL);
+        if (map == NULL) {
+            return;
+        }
+    }
+
+    start_time = get_current_time_ms_high_precision();
+    flat_map_build(map, params->keys, params->values, params->size);
+    elapsed[PHASE_BUILD] = get_current_time_ms_high_precision() - start_time;
+    checksums[PHASE_BUILD] = (int64_t)flat_map_size(map);
+
+    int64_t sum = 0;
+    start_time = get_current_time_ms_high_precision();
+    for (size_t i = 0; i < LOOKUP_COUNT; i++) {
+        void* value;
+        if (flat_map_find(map, &params->hits[i % LOOKUP_KEYS], &value) == CSTL_OK) {
+            sum += *(const int64_t*)value;
+        }
+    }
+    elapsed[PHASE_LOOKUP_HIT] = get_current_time_ms_high_precision() - start_time;
+    checksums[PHASE_LOOKUP_HIT] = sum;
+
+    int64_t found = 0;
+    start_time = get_current_time_ms_high_precision();
+    for (size_t i = 0; i < LOOKUP_COUNT; i++) {
+        found += flat_map_contains(map, &params->misses[i % LOOKUP_KEYS]);
+    }
+    elapsed[PHASE_LOOKUP_MISS] = get_current_time_ms_high_precision() - start_time;
+    checksums[PHASE_LOOKUP_MISS] = found;
+
+    start_time = get_current_time_ms_high_precision();
+    flat_map_insert_batch(map, params->batch_keys, params->batch_values, batch_count, NULL);
+    elapsed[PHASE_BATCH] = get_current_time_ms_high_precision() - start_time;
+    checksums[PHASE_BATCH] = (int64_t)flat_map_size(map);
+
+    /* 成批插入后应该仍然有序 */
+    for (size_t i = 1; i < flat_map_size(map); i++) {
+        if (compare_u64(flat_map_key_at(map, i - 1), flat_map_key_at(map, i)) >= 0) {
+            checksums[PHASE_BATCH] = -1;
+            break;
+        }
+    }
+
+    flat_map_destroy(map);
+}
+
+/**
+ * @brief 格式化耗时，不适用的阶段显示为"-"
+ *
+ * @param buffer 输出缓冲区
+ * @param size 缓冲区大小
+ * @param elapsed 耗时，小于0表示不适用
+ */
+static void format_elapsed(char* buffer, size_t size, long long elapsed) {
+    if (elapsed >= 0) {
+        snprintf(buffer, size, "%lld ms", elapsed);
+    } else {
+        snprintf(buffer, size, "-");
+    }
+}
+
+/**
+ * @brief 生成随机uint64键，最高位为0，未命中的键把最高位置1
+ *
+ * @return uint64_t 键
+ */
+static uint64_t random_key(void) {
+    return (uint64_t)random_int64(0, INT64_MAX - 1);
+}
+
+/**
+ * @brief 测试指定大小的字典
+ *
+ * @param log_file 日志文件
+ * @param size 元素数量
+ */
+static void test_size(FILE* log_file, size_t size) {
+    size_t batch_count = size / 10;
+    uint64_t* keys = (uint64_t*)malloc((size + batch_count) * sizeof(uint64_t));
+    int64_t* values = (int64_t*)malloc((size + batch_count) * sizeof(int64_t));
+    uint64_t* hits = (uint64_t*)malloc(LOOKUP_KEYS * sizeof(uint64_t));
+    uint64_t* misses = (uint64_t*)malloc(LOOKUP_KEYS * sizeof(uint64_t));
+    if (keys == NULL || values == NULL || hits == NULL || misses == NULL) {
+        printf("错误: 无法创建测试数据\n");
+        free(keys);
+        free(values);
+        free(hits);
+        free(misses);
+        return;
+    }
+
+    /* 键互不相同：用flat_set_t去掉偶然重复的随机数 */
+    flat_set_t* seen = flat_set_create(sizeof(uint64_t), compare_u64, NULL, NULL);
+    size_t count = 0;
+    while (count < size + batch_count) {
+        uint64_t key = random_key();
+        if (flat_set_insert(seen, &key) == CSTL_OK) {
+            keys[count] = key;
+            values[count] = (int64_t)(key % 1000);
+            count++;
+        }
+    }
+    flat_set_destroy(seen);
+
+    for (size_t i = 0; i < LOOKUP_KEYS; i++) {
+        hits[i] = keys[(size_t)random_int64(0, (int64_t)size - 1)];
+        misses[i] = random_key() | ((uint64_t)1 << 63);
+    }
+
+    bench_params_t params;
+    params.size = size;
+    params.keys = keys;
+    params.values = values;
+    params.hits = hits;
+    params.misses = misses;
+    params.batch_keys = keys + size;
+    params.batch_values = values + size;
+
+    long long elapsed[KIND_COUNT][PHASE_COUNT];
+    int64_t checksums[KIND_COUNT][PHASE_COUNT];
+    for (int kind = 0; kind < KIND_COUNT; kind++) {
+        for (int phase = 0; phase < PHASE_COUNT; phase++) {
+            elapsed[kind][phase] = -1;
+            checksums[kind][phase] = 0;
+        }
+    }
+
+    run_hash(&params, elapsed[KIND_HASH], checksums[KIND_HASH]);
+    run_flat_map(&params, FLAT_MAP_SEPARATE, compare_u64, elapsed[KIND_SEPARATE], checksums[KIND_SEPARATE]);
+    run_flat_map(&params, FLAT_MAP_INTERLEAVED, compare_u64,
+                 elapsed[KIND_INTERLEAVED], checksums[KIND_INTERLEAVED]);
+    run_flat_map(&params, FLAT_MAP_SEPARATE, NULL, elapsed[KIND_INTEGER], checksums[KIND_INTEGER]);
+
+    fprintf(log_file, "--- %zu 个元素（查找 %d 次，成批插入 %zu 个） ---\n", size, LOOKUP_COUNT, batch_count);
+    printf("--- %zu 个元素（查找 %d 次，成批插入 %zu 个） ---\n", size, LOOKUP_COUNT, batch_count);
+    fprintf(log_file, "  %-16s %12s %14s %14s %16s  %s\n", "阶段", kind_names[KIND_HASH],
+            kind_names[KIND_SEPARATE], kind_names[KIND_INTERLEAVED], kind_names[KIND_INTEGER], "校验");
+    printf("  %-16s %12s %14s %14s %16s  %s\n", "阶段", kind_names[KIND_HASH],
+           kind_names[KIND_SEPARATE], kind_names[KIND_INTERLEAVED], kind_names[KIND_INTEGER], "校验");
+
+    for (int phase = 0; phase < PHASE_COUNT; phase++) {
+        char texts[KIND_COUNT][32];
+        int consistent = 1;
+        for (int kind = 0; kind < KIND_COUNT; kind++) {
+            format_elapsed(texts[kind], sizeof(texts[kind]), elapsed[kind][phase]);
+            if (checksums[kind][phase] != checksums[KIND_HASH][phase]) {
+                consistent = 0;
+            }
+        }
+        if (phase == PHASE_LOOKUP_MISS && checksums[KIND_HASH][phase] != 0) {
+            consistent = 0;
+        }
+
+        fprintf(log_file, "  %-16s %12s %14s %14s %16s  %s %lld\n", phase_names[phase],
+                texts[KIND_HASH], texts[KIND_SEPARATE], texts[KIND_INTERLEAVED], texts[KIND_INTEGER],
+                consistent ? "一致" : "不一致", (long long)checksums[KIND_HASH][phase]);
+        printf("  %-16s %12s %14s %14s %16s  %s %lld\n", phase_names[phase],
+               texts[KIND_HASH], texts[KIND_SEPARATE], texts[KIND_INTERLEAVED], texts[KIND_INTEGER],
+               consistent ? "一致" : "不一致", (long long)checksums[KIND_HASH][phase]);
+    }
+
+    fprintf(log_file, "\n");
+    printf("\n");
+
+    free(keys);
+    free(values);
+    free(hits);
+    free(misses);
+}
+
+/**
+ * @brief 运行完整的性能测试
+ */
+void run_performance_tests() {
+    FILE* log_file = fopen(LOG_FILE, "a");
+    if (log_file == NULL) {
+        printf("无法打开日志文件 %s\n", LOG_FILE);
+        return;
+    }
+
+    fprintf(log_file, "\n=== 有序扁平映射性能测试报告 ===\n");
+    fprintf(log_file, "测试时间: %s", ctime(&(time_t){time(NULL)}));
+    fprintf(log_file, "键类型: uint64，值类型: int64\n\n");
+
+    printf("开始有序扁平映射性能测试...\n");
+    printf("结果将保存到 %s\n\n", LOG_FILE);
+
+    test_size(log_file, 8);
+    test_size(log_file, 32);
+    test_size(log_file, 128);
+    test_size(log_file, 1000);
+    test_size(log_file, 10000);
+    test_size(log_file, 100000);
+
+    fprintf(log_file, "=== 测试完成 ===\n\n");
+    printf("=== 测试完成 ===\n");
+
+    fclose(log_file);
+}
+
+/**
+ * @brief 显示帮助信息
+ */
+void show_help() {
+    printf("有序扁平映射性能测试程序\n");
+    printf("用法: ./flat_map_performance_test [选项]\n");
+    printf("选项:\n");
+    printf("  -h, --help     显示帮助信息\n");
+    printf("  -r, --run      运行性能测试\n");
+    printf("  -c, --clear    清空日志文件\n");
+    printf("\n");
+    printf("  测试结果将保存到 %s 文件中\n", LOG_FILE);
+}
+
+/**
+ * @brief 主函数
+ *
+ * @param argc 参数个数
+ * @param argv 参数数组
+ * @return int 程序退出码
+ */
+int main(int argc, char* argv[]) {
+    srand((unsigned int)time(NULL));
+
+    if (argc < 2) {
+        show_help();
+        return 0;
+    }
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-h") == 0 || strcmp(argv[i], "--help") == 0) {
+            show_help();
+            return 0;
+        } else if (strcmp(argv[i], "-r") == 0 || strcmp(argv[i], "--run") == 0) {
+            run_performance_tests();
+            return 0;
+        } else if (strcmp(argv[i], "-c") == 0 || strcmp(argv[i], "--clear") == 0) {
+            FILE* log_file = fopen(LOG_FILE, "w");
+            if (log_file) {
+                fclose(log_file);
+                printf("日志文件 %s 已清空\n", LOG_FILE);
+            }
+            return 0;
+        } else {
+            printf("未知选项: %s\n", argv[i]);
+            show_help();
+            return 1;
+        }
+    }
+
+    return 0;
+}
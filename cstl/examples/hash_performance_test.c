@@ -0,0 +1,327 @@
+/**
+ * @file hash_performance_test.c
+ * @brief 哈希去重与频次统计性能测试
+ * @version 0.1
+ * @date 2025-09-28
+ *
+ * @copyright Copyright (c) 2025
+ *
+ * 本文件以随机64位ID为数据，对比以下方式的性能：
+ * - 去重：先 algo_sort 再线性去除相邻重复（原有做法） 与 algo_distinct
+ * - 排列判断：比较函数版本的 algo_is_permutation（O(n^2)，只在较小规模上测试）
+ *   与 algo_is_permutation_hash
+ * - 频次统计：algo_frequencies
+ *
+ * 使用utils中的高精度时间函数计算耗时，并将结果输出到日志文件中
+ */
+
+#include "cstl.h"
+#include "common/utils.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define LOG_FILE "hash_performance.log"
+#define NUM_ELEMENTS 5000000
+#define PERMUTATION_SMALL 20000
+#define NUM_RATIOS 3
+
+// 不同值数量占元素数量的比例（百分比）
+const int distinct_ratios[NUM_RATIOS] = {1, 50, 100};
+
+/**
+ * @brief uint64_t比较函数
+ */
+static int compare_u64(const void* a, const void* b) {
+    uint64_t x = *(const uint64_t*)a;
+    uint64_t y = *(const uint64_t*)b;
+    return (x > y) - (x < y);
+}
+
+/**
+ * @brief uint64_t哈希函数，直接返回ID，由算法内部再混合
+ */
+static uint64_t hash_u64(const void* element) {
+    return *(const uint64_t*)element;
+}
+
+/**
+ * @brief 生成指定不同值数量的随机ID向量
+ *
+ * @param count 元素数量
+ * @param distinct 不同值数量
+ * @return vector_t* 向量指针
+ */
+static vector_t* create_ids(size_t count, size_t distinct) {
+    vector_t* vec = vector_create(sizeof(uint64_t), count, NULL, NULL);
+    if (vec == NULL) {
+        return NULL;
+    }
+    vector_resize(vec, count);
+    uint64_t* data = (uint64_t*)vec->data;
+    for (size_t i = 0; i < count; i++) {
+        // 不同值是分散的大整数，而不是连续的小整数
+        data[i] = (uint64_t)random_int64(0, (int64_t)distinct - 1) * 0x9E3779B97F4A7C15ULL;
+    }
+    return vec;
+}
+
+/**
+ * @brief 复制向量
+ */
+static vector_t* copy_vector(const vector_t* source) {
+    vector_t* vec = vector_create(source->element_size, source->size, NULL, NULL);
+    if (vec != NULL) {
+        vector_resize(vec, source->size);
+        memcpy(vec->data, source->data, source->size * source->element_size);
+    }
+    return vec;
+}
+
+/**
+ * @brief 洗牌向量，用于构造排列
+ */
+static void shuffle_vector(vector_t* vec) {
+    uint64_t* data = (uint64_t*)vec->data;
+    for (size_t i = vec->size; i > 1; i--) {
+        size_t j = (size_t)random_int64(0, (int64_t)i - 1);
+        uint64_t temp = data[i - 1];
+        data[i - 1] = data[j];
+        data[j] = temp;
+    }
+}
+
+/**
+ * @brief 测试去重和频次统计
+ *
+ * @param log_file 日志文件
+ * @param ratio 不同值比例（百分比）
+ */
+static void test_distinct(FILE* log_file, int ratio) {
+    size_t distinct = (size_t)NUM_ELEMENTS * ratio / 100;
+    vector_t* source = create_ids(NUM_ELEMENTS, distinct);
+    vector_t* sorted = source != NULL ? copy_vector(source) : NULL;
+    if (source == NULL || sorted == NULL) {
+        printf("错误: 无法创建测试数据\n");
+        vector_destroy(source);
+        vector_destroy(sorted);
+        return;
+    }
+
+    fprintf(log_file, "--- %d 个ID，不同值约占 %d%% ---\n", NUM_ELEMENTS, ratio);
+    printf("--- %d 个ID，不同值约占 %d%% ---\n", NUM_ELEMENTS, ratio);
+
+    // 排序后去除相邻重复
+    iterator_t* begin = vector_begin(sorted);
+    iterator_t* end = vector_end(sorted);
+    long long start_time = get_current_time_ms_high_precision();
+    algo_sort(begin, end, compare_u64, SORT_QUICK);
+    uint64_t* data = (uint64_t*)sorted->data;
+    size_t kept = sorted->size > 0 ? 1 : 0;
+    for (size_t i = 1; i < sorted->size; i++) {
+        if (data[i] != data[kept - 1]) {
+            data[kept++] = data[i];
+        }
+    }
+    long long sort_time = get_current_time_ms_high_precision() - start_time;
+    iterator_destroy(begin);
+    iterator_destroy(end);
+
+    // 哈希去重，使用自定义哈希和比较函数
+    vector_t* work = copy_vector(source);
+    begin = vector_begin(work);
+    end = vector_end(work);
+    size_t removed = 0;
+    start_time = get_current_time_ms_high_precision();
+    algo_distinct(begin, end, hash_u64, compare_u64, &removed);
+    long long distinct_time = get_current_time_ms_high_precision() - start_time;
+    iterator_destroy(begin);
+    iterator_destroy(end);
+    vector_destroy(work);
+
+    // 哈希去重，按位比较
+    work = copy_vector(source);
+    begin = vector_begin(work);
+    end = vector_end(work);
+    size_t removed_bitwise = 0;
+    start_time = get_current_time_ms_high_precision();
+    algo_distinct(begin, end, NULL, NULL, &removed_bitwise);
+    long long bitwise_time = get_current_time_ms_high_precision() - start_time;
+    iterator_destroy(begin);
+    iterator_destroy(end);
+    vector_destroy(work);
+
+    // 频次统计
+    begin = vector_begin(source);
+    end = vector_end(source);
+    algo_frequency_t* frequencies = NULL;
+    size_t frequency_count = 0;
+    start_time = get_current_time_ms_high_precision();
+    algo_frequencies(begin, end, NULL, NULL, &frequencies, &frequency_count);
+    long long frequency_time = get_current_time_ms_high_precision() - start_time;
+    free(frequencies);
+    iterator_destroy(begin);
+    iterator_destroy(end);
+
+    fprintf(log_file, "  排序+去重相邻: %6lld ms   algo_distinct: %6lld ms   按位比较: %6lld ms   algo_frequencies: %6lld ms\n",
+            sort_time, distinct_time, bitwise_time, frequency_time);
+    printf("  排序+去重相邻: %6lld ms   algo_distinct: %6lld ms   按位比较: %6lld ms   algo_frequencies: %6lld ms\n",
+           sort_time, distinct_time, bitwise_time, frequency_time);
+
+    size_t unique = NUM_ELEMENTS - removed;
+    if (unique != kept || NUM_ELEMENTS - removed_bitwise != kept || frequency_count != kept) {
+        fprintf(log_file, "  错误: 结果不正确!\n");
+        printf("  错误: 结果不正确!\n");
+    }
+    fprintf(log_file, "  不同值数量: %zu\n\n", kept);
+    printf("  不同值数量: %zu\n\n", kept);
+
+    vector_destroy(source);
+    vector_destroy(sorted);
+}
+
+/**
+ * @brief 测试排列判断
+ *
+ * @param log_file 日志文件
+ * @param count 元素数量
+ * @param with_compare 是否同时测试比较函数版本
+ */
+static void test_permutation(FILE* log_file, size_t count, int with_compare) {
+    vector_t* first = create_ids(count, count / 2);
+    vector_t* second = first != NULL ? copy_vector(first) : NULL;
+    if (first == NULL || second == NULL) {
+        printf("错误: 无法创建测试数据\n");
+        vector_destroy(first);
+        vector_destroy(second);
+        return;
+    }
+    shuffle_vector(second);
+
+    iterator_t* begin1 = vector_begin(first);
+    iterator_t* end1 = vector_end(first);
+    iterator_t* begin2 = vector_begin(second);
+    iterator_t* end2 = vector_end(second);
+    int result_compare = 1;
+    int result_hash = 0;
+    long long compare_time = 0;
+
+    if (with_compare) {
+        long long start_time = get_current_time_ms_high_precision();
+        algo_is_permutation(begin1, end1, begin2, end2, compare_u64, &result_compare);
+        compare_time = get_current_time_ms_high_precision() - start_time;
+    }
+
+    long long start_time = get_current_time_ms_high_precision();
+    algo_is_permutation_hash(begin1, end1, begin2, end2, NULL, NULL, &result_hash);
+    long long hash_time = get_current_time_ms_high_precision() - start_time;
+
+    if (with_compare) {
+        fprintf(log_file, "  %8zu 个元素: algo_is_permutation %6lld ms   algo_is_permutation_hash %6lld ms\n",
+                count, compare_time, hash_time);
+        printf("  %8zu 个元素: algo_is_permutation %6lld ms   algo_is_permutation_hash %6lld ms\n",
+               count, compare_time, hash_time);
+    } else {
+        fprintf(log_file, "  %8zu 个元素: algo_is_permutation_hash %6lld ms\n", count, hash_time);
+        printf("  %8zu 个元素: algo_is_permutation_hash %6lld ms\n", count, hash_time);
+    }
+
+    if (!result_compare || !result_hash) {
+        fprintf(log_file, "  错误: 结果不正确!\n");
+        printf("  错误: 结果不正确!\n");
+    }
+
+    iterator_destroy(begin1);
+    iterator_destroy(end1);
+    iterator_destroy(begin2);
+    iterator_destroy(end2);
+    vector_destroy(first);
+    vector_destroy(second);
+}
+
+/**
+ * @brief 运行完整的性能测试
+ */
+void run_performance_tests() {
+    FILE* log_file = fopen(LOG_FILE, "a");
+    if (log_file == NULL) {
+        printf("无法打开日志文件 %s\n", LOG_FILE);
+        return;
+    }
+
+    fprintf(log_file, "\n=== 哈希去重与频次统计性能测试报告 ===\n");
+    fprintf(log_file, "测试时间: %s\n", ctime(&(time_t){time(NULL)}));
+
+    printf("开始哈希去重与频次统计性能测试...\n");
+    printf("结果将保存到 %s\n\n", LOG_FILE);
+
+    for (int i = 0; i < NUM_RATIOS; i++) {
+        test_distinct(log_file, distinct_ratios[i]);
+    }
+
+    fprintf(log_file, "--- 排列判断 ---\n");
+    printf("--- 排列判断 ---\n");
+    test_permutation(log_file, PERMUTATION_SMALL, 1);
+    test_permutation(log_file, NUM_ELEMENTS, 0);
+    fprintf(log_file, "\n");
+    printf("\n");
+
+    fprintf(log_file, "=== 测试完成 ===\n\n");
+    printf("=== 测试完成 ===\n");
+
+    fclose(log_file);
+}
+
+/**
+ * @brief 显示帮助信息
+ */
+void show_help() {
+    printf("哈希去重与频次统计性能测试程序\n");
+    printf("用法: ./hash_performance_test [选项]\n");
+    printf("选项:\n");
+    printf("  -h, --help     显示帮助信息\n");
+    printf("  -r, --run      运行性能测试\n");
+    printf("  -c, --clear    清空日志文件\n");
+    printf("\n");
+    printf("  测试结果将保存到 %s 文件中\n", LOG_FILE);
+}
+
+/**
+ * @brief 主函数
+ *
+ * @param argc 参数个数
+ * @param argv 参数数组
+ * @return int 程序退出码
+ */
+int main(int argc, char* argv[]) {
+    srand((unsigned int)time(NULL));
+
+    if (argc < 2) {
+        show_help();
+        return 0;
+    }
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-h") == 0 || strcmp(argv[i], "--help") == 0) {
+            show_help();
+            return 0;
+        } else if (strcmp(argv[i], "-r") == 0 || strcmp(argv[i], "--run") == 0) {
+            run_performance_tests();
+            return 0;
+        } else if (strcmp(argv[i], "-c") == 0 || strcmp(argv[i], "--clear") == 0) {
+            FILE* log_file = fopen(LOG_FILE, "w");
+            if (log_file) {
+                fclose(log_file);
+                printf("日志文件 %s 已清空\n", LOG_FILE);
+            }
+            return 0;
+        } else {
+            printf("未知选项: %s\n", argv[i]);
+            show_help();
+            return 1;
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,347 @@
+/**
+ * @file ilist_performance_test.c
+ * @brief 侵入式双向链表性能测试
+ * @version 0.1
+ * @date 2025-10-08
+ *
+ * @copyright Copyright (c) 2025
+ *
+ * 本文件模拟管理大量长期存在的会话对象，对象预先分配在一个数组（对象池）中，
+ * 对比用以下三种方式把它们组织成LRU链表：
+ * - list_t保存会话副本（每次插入分配节点并复制整个会话）
+ * - list_t保存会话指针（每次插入分配节点，访问会话需要多一次跳转）
+ * - ilist_t（钩子嵌入在会话中，不分配内存）
+ *
+ * 依次测试建立链表、随机访问时移到前端、遍历全部会话和清空链表的耗时。
+ * 使用utils中的高精度时间函数计算耗时，并将结果输出到日志文件中
+ */
+
+#include "cstl.h"
+#include "common/utils.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define LOG_FILE "ilist_performance.log"
+#define NUM_SESSIONS 2000000
+#define NUM_ACCESSES 10000000
+
+/**
+ * @brief 会话对象
+ */
+typedef struct {
+    uint64_t id;            /**< 会话编号 */
+    int64_t last_active;    /**< 最近访问时间 */
+    ilist_hook_t lru;       /**< LRU链表钩子 */
+    char payload[32];       /**< 负载 */
+} session_t;
+
+/**
+ * @brief 输出一行测试结果
+ *
+ * @param log_file 日志文件
+ * @param name 测试名称
+ * @param elapsed 耗时（毫秒）
+ * @param checksum 校验值，三种方式应当一致
+ */
+static void report(FILE* log_file, const char* name, long long elapsed, uint64_t checksum) {
+    fprintf(log_file, "  %-28s %8lld ms  校验 %llu\n", name, elapsed, (unsigned long long)checksum);
+    printf("  %-28s %8lld ms  校验 %llu\n", name, elapsed, (unsigned long long)checksum);
+}
+
+/**
+ * @brief 输出阶段标题
+ *
+ * @param log_file 日志文件
+ * @param title 标题
+ */
+static void section(FILE* log_file, const char* title) {
+    fprintf(log_file, "--- %s ---\n", title);
+    printf("--- %s ---\n", title);
+}
+
+/**
+ * @brief 用list_t保存会话副本
+ *
+ * @param sessions 会话数组
+ * @param accesses 访问序列
+ * @param elapsed 输出参数，四个阶段的耗时
+ * @param checksums 输出参数，四个阶段的校验值
+ */
+static void run_list_copy(const session_t* sessions, const size_t* accesses,
+                          long long* elapsed, uint64_t* checksums) {
+    list_t* list = list_create(sizeof(session_t), NULL, NULL);
+    list_node_t** nodes = (list_node_t**)malloc(NUM_SESSIONS * sizeof(list_node_t*));
+    if (list == NULL || nodes == NULL) {
+        list_destroy(list);
+        free(nodes);
+        return;
+    }
+
+    long long start_time = get_current_time_ms_high_precision();
+    for (size_t i = 0; i < NUM_SESSIONS; i++) {
+        list_push_front(list, &sessions[i]);
+        nodes[i] = list->head;
+    }
+    elapsed[0] = get_current_time_ms_high_precision() - start_time;
+    checksums[0] = list->size;
+
+    start_time = get_current_time_ms_high_precision();
+    for (size_t i = 0; i < NUM_ACCESSES; i++) {
+        size_t index = accesses[i];
+        session_t session = *(const session_t*)nodes[index]->data;
+        session.last_active = (int64_t)i;
+        list_erase(list, nodes[index]);
+        list_push_front(list, &session);
+        nodes[index] = list->head;
+    }
+    elapsed[1] = get_current_time_ms_high_precision() - start_time;
+    checksums[1] = ((const session_t*)list->head->data)->id;
+
+    start_time = get_current_time_ms_high_precision();
+    uint64_t sum = 0;
+    for (list_node_t* node = list->head; node != NULL; node = node->next) {
+        const session_t* session = (const session_t*)node->data;
+        sum += session->id ^ (uint64_t)session->last_active;
+    }
+    elapsed[2] = get_current_time_ms_high_precision() - start_time;
+    checksums[2] = sum;
+
+    start_time = get_current_time_ms_high_precision();
+    list_clear(list);
+    elapsed[3] = get_current_time_ms_high_precision() - start_time;
+    checksums[3] = list->size;
+
+    list_destroy(list);
+    free(nodes);
+}
+
+/**
+ * @brief 用list_t保存会话指针
+ *
+ * @param sessions 会话数组
+ * @param accesses 访问序列
+ * @param elapsed 输出参数，四个阶段的耗时
+ * @param checksums 输出参数，四个阶段的校验值
+ */
+static void run_list_pointer(session_t* sessions, const size_t* accesses,
+                             long long* elapsed, uint64_t* checksums) {
+    list_t* list = list_create(sizeof(session_t*), NULL, NULL);
+    list_node_t** nodes = (list_node_t**)malloc(NUM_SESSIONS * sizeof(list_node_t*));
+    if (list == NULL || nodes == NULL) {
+        list_destroy(list);
+        free(nodes);
+        return;
+    }
+
+    long long start_time = get_current_time_ms_high_precision();
+    for (size_t i = 0; i < NUM_SESSIONS; i++) {
+        session_t* session = &sessions[i];
+        list_push_front(list, &session);
+        nodes[i] = list->head;
+    }
+    elapsed[0] = get_current_time_ms_high_precision() - start_time;
+    checksums[0] = list->size;
+
+    start_time = get_current_time_ms_high_precision();
+    for (size_t i = 0; i < NUM_ACCESSES; i++) {
+        size_t index = accesses[i];
+        session_t* session = &sessions[index];
+        session->last_active = (int64_t)i;
+        list_erase(list, nodes[index]);
+        list_push_front(list, &session);
+        nodes[index] = list->head;
+    }
+    elapsed[1] = get_current_time_ms_high_precision() - start_time;
+    checksums[1] = (*(session_t* const*)list->head->data)->id;
+
+    start_time = get_current_time_ms_high_precision();
+    uint64_t sum = 0;
+    for (list_node_t* node = list->head; node != NULL; node = node->next) {
+        const session_t* session = *(session_t* const*)node->data;
+        sum += session->id ^ (uint64_t)session->last_active;
+    }
+    elapsed[2] = get_current_time_ms_high_precision() - start_time;
+    checksums[2] = sum;
+
+    start_time = get_current_time_ms_high_precision();
+    list_clear(list);
+    elapsed[3] = get_current_time_ms_high_precision() - start_time;
+    checksums[3] = list->size;
+
+    list_destroy(list);
+    free(nodes);
+}
+
+/**
+ * @brief 用ilist_t组织会话
+ *
+ * @param sessions 会话数组
+ * @param accesses 访问序列
+ * @param elapsed 输出参数，四个阶段的耗时
+ * @param checksums 输出参数，四个阶段的校验值
+ */
+static void run_ilist(session_t* sessions, const size_t* accesses,
+                      long long* elapsed, uint64_t* checksums) {
+    ilist_t lru;
+    ilist_init(&lru, offsetof(session_t, lru), sizeof(session_t));
+
+    long long start_time = get_current_time_ms_high_precision();
+    for (size_t i = 0; i < NUM_SESSIONS; i++) {
+        ilist_push_front(&lru, &sessions[i]);
+    }
+    elapsed[0] = get_current_time_ms_high_precision() - start_time;
+    checksums[0] = lru.size;
+
+    start_time = get_current_time_ms_high_precision();
+    for (size_t i = 0; i < NUM_ACCESSES; i++) {
+        session_t* session = &sessions[accesses[i]];
+        session->last_active = (int64_t)i;
+        ilist_erase(&lru, session);
+        ilist_push_front(&lru, session);
+    }
+    elapsed[1] = get_current_time_ms_high_precision() - start_time;
+    checksums[1] = ILIST_CONTAINER_OF(lru.head, session_t, lru)->id;
+
+    start_time = get_current_time_ms_high_precision();
+    uint64_t sum = 0;
+    for (ilist_hook_t* hook = lru.head; hook != NULL; hook = hook->next) {
+        const session_t* session = ILIST_CONTAINER_OF(hook, session_t, lru);
+        sum += session->id ^ (uint64_t)session->last_active;
+    }
+    elapsed[2] = get_current_time_ms_high_precision() - start_time;
+    checksums[2] = sum;
+
+    start_time = get_current_time_ms_high_precision();
+    ilist_clear(&lru);
+    elapsed[3] = get_current_time_ms_high_precision() - start_time;
+    checksums[3] = lru.size;
+}
+
+/**
+ * @brief 运行完整的性能测试
+ */
+void run_performance_tests() {
+    FILE* log_file = fopen(LOG_FILE, "a");
+    if (log_file == NULL) {
+        printf("无法打开日志文件 %s\n", LOG_FILE);
+        return;
+    }
+
+    session_t* sessions = (session_t*)malloc(NUM_SESSIONS * sizeof(session_t));
+    size_t* accesses = (size_t*)malloc(NUM_ACCESSES * sizeof(size_t));
+    if (sessions == NULL || accesses == NULL) {
+        printf("错误: 无法创建测试数据\n");
+        free(sessions);
+        free(accesses);
+        fclose(log_file);
+        return;
+    }
+    for (size_t i = 0; i < NUM_ACCESSES; i++) {
+        /* 约80%的访问落在20%的活跃会话上 */
+        int64_t hot = random_int64(0, 9);
+        accesses[i] = hot < 8 ? (size_t)random_int64(0, NUM_SESSIONS / 5 - 1)
+                              : (size_t)random_int64(0, NUM_SESSIONS - 1);
+    }
+
+    fprintf(log_file, "\n=== 侵入式双向链表性能测试报告 ===\n");
+    fprintf(log_file, "测试时间: %s", ctime(&(time_t){time(NULL)}));
+    fprintf(log_file, "会话数量: %d（每个 %zu 字节），访问次数: %d\n\n", NUM_SESSIONS, sizeof(session_t),
+            NUM_ACCESSES);
+
+    printf("开始侵入式双向链表性能测试...\n");
+    printf("结果将保存到 %s\n\n", LOG_FILE);
+
+    const char* names[3] = {"list_t (会话副本)", "list_t (会话指针)", "ilist_t"};
+    long long elapsed[3][4] = {{0}};
+    uint64_t checksums[3][4] = {{0}};
+    for (int mode = 0; mode < 3; mode++) {
+        for (size_t i = 0; i < NUM_SESSIONS; i++) {
+            memset(&sessions[i], 0, sizeof(session_t));
+            sessions[i].id = i;
+        }
+        if (mode == 0) {
+            run_list_copy(sessions, accesses, elapsed[mode], checksums[mode]);
+        } else if (mode == 1) {
+            run_list_pointer(sessions, accesses, elapsed[mode], checksums[mode]);
+        } else {
+            run_ilist(sessions, accesses, elapsed[mode], checksums[mode]);
+        }
+    }
+
+    const char* phases[4] = {"建立链表", "访问时移到前端", "遍历全部会话", "清空链表"};
+    for (int phase = 0; phase < 4; phase++) {
+        section(log_file, phases[phase]);
+        for (int mode = 0; mode < 3; mode++) {
+            report(log_file, names[mode], elapsed[mode][phase], checksums[mode][phase]);
+        }
+        fprintf(log_file, "\n");
+        printf("\n");
+    }
+
+    fprintf(log_file, "每个会话的额外内存: list_t 节点 %zu + %zu 字节（另有分配器开销），ilist_t 钩子 %zu 字节\n",
+            sizeof(list_node_t), sizeof(session_t*), sizeof(ilist_hook_t));
+    printf("每个会话的额外内存: list_t 节点 %zu + %zu 字节（另有分配器开销），ilist_t 钩子 %zu 字节\n",
+           sizeof(list_node_t), sizeof(session_t*), sizeof(ilist_hook_t));
+
+    fprintf(log_file, "=== 测试完成 ===\n\n");
+    printf("=== 测试完成 ===\n");
+
+    free(sessions);
+    free(accesses);
+    fclose(log_file);
+}
+
+/**
+ * @brief 显示帮助信息
+ */
+void show_help() {
+    printf("侵入式双向链表性能测试程序\n");
+    printf("用法: ./ilist_performance_test [选项]\n");
+    printf("选项:\n");
+    printf("  -h, --help     显示帮助信息\n");
+    printf("  -r, --run      运行性能测试\n");
+    printf("  -c, --clear    清空日志文件\n");
+    printf("\n");
+    printf("  测试结果将保存到 %s 文件中\n", LOG_FILE);
+}
+
+/**
+ * @brief 主函数
+ *
+ * @param argc 参数个数
+ * @param argv 参数数组
+ * @return int 程序退出码
+ */
+int main(int argc, char* argv[]) {
+    srand((unsigned int)time(NULL));
+
+    if (argc < 2) {
+        show_help();
+        return 0;
+    }
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-h") == 0 || strcmp(argv[i], "--help") == 0) {
+            show_help();
+            return 0;
+        } else if (strcmp(argv[i], "-r") == 0 || strcmp(argv[i], "--run") == 0) {
+            run_performance_tests();
+            return 0;
+        } else if (strcmp(argv[i], "-c") == 0 || strcmp(argv[i], "--clear") == 0) {
+            FILE* log_file = fopen(LOG_FILE, "w");
+            if (log_file) {
+                fclose(log_file);
+                printf("日志文件 %s 已清空\n", LOG_FILE);
+            }
+            return 0;
+        } else {
+            printf("未知选项: %s\n", argv[i]);
+            show_help();
+            return 1;
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,259 @@
+/**
+ * @file list_index_performance_test.c
+ * @brief 链表按索引访问性能测试
+ * @version 0.1
+ * @date 2025-10-09
+ *
+ * @copyright Copyright (c) 2025
+ *
+ * 本文件在int64链表上对比以下按索引访问方式：
+ * - 每次从头节点出发（原list_at的实现）
+ * - list_at（从头、尾和游标中最近的位置出发）
+ * - list_at + 跳跃索引（list_enable_skip_index）
+ *
+ * 访问模式包括顺序遍历、逆序遍历、顺序list_set和随机访问。
+ * 从头出发的方式总步数为O(n^2)，没有跳跃索引时随机访问的平均步数也与n成正比，
+ * 预计步数过多的组合跳过。
+ * 使用utils中的高精度时间函数计算耗时，并将结果输出到日志文件中
+ */
+
+#include "cstl.h"
+#include "common/utils.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define LOG_FILE "list_index_performance.log"
+#define RANDOM_ACCESSES 100000
+#define WALK_STEP_LIMIT 4000000000.0
+
+/**
+ * @brief 访问模式
+ */
+typedef enum {
+    ACCESS_FORWARD,     /**< 顺序读取 */
+    ACCESS_BACKWARD,    /**< 逆序读取 */
+    ACCESS_SET,         /**< 顺序写入 */
+    ACCESS_RANDOM       /**< 随机读取 */
+} access_mode_t;
+
+/**
+ * @brief 原list_at的实现，每次从头节点出发
+ *
+ * @param list 链表
+ * @param index 元素索引
+ * @return void* 元素指针
+ */
+static void* head_walk_at(const list_t* list, size_t index) {
+    list_node_t* node = list->head;
+    for (size_t i = 0; i < index; i++) {
+        node = node->next;
+    }
+    return node->data;
+}
+
+/**
+ * @brief 输出一行测试结果
+ *
+ * @param log_file 日志文件
+ * @param name 测试名称
+ * @param elapsed 耗时（毫秒），为负数时表示跳过
+ * @param checksum 校验值，各方式应当一致
+ */
+static void report(FILE* log_file, const char* name, long long elapsed, int64_t checksum) {
+    if (elapsed < 0) {
+        fprintf(log_file, "  %-28s %8s\n", name, "跳过");
+        printf("  %-28s %8s\n", name, "跳过");
+        return;
+    }
+    fprintf(log_file, "  %-28s %8lld ms  校验 %lld\n", name, elapsed, (long long)checksum);
+    printf("  %-28s %8lld ms  校验 %lld\n", name, elapsed, (long long)checksum);
+}
+
+/**
+ * @brief 按给定模式访问链表
+ *
+ * @param list 链表
+ * @param mode 访问模式
+ * @param head_walk 为非零时使用从头出发的实现
+ * @param indices 随机访问的索引序列
+ * @param checksum 输出参数，校验值
+ * @return long long 耗时（毫秒）
+ */
+static long long run_access(list_t* list, access_mode_t mode, int head_walk, const size_t* indices,
+                            int64_t* checksum) {
+    size_t n = list->size;
+    size_t accesses = mode == ACCESS_RANDOM ? RANDOM_ACCESSES : n;
+    int64_t sum = 0;
+
+    long long start_time = get_current_time_ms_high_precision();
+    for (size_t k = 0; k < accesses; k++) {
+        size_t index = mode == ACCESS_BACKWARD ? n - 1 - k : mode == ACCESS_RANDOM ? indices[k] : k;
+        if (mode == ACCESS_SET) {
+            int64_t value = (int64_t)k * 3;
+            if (head_walk) {
+                memcpy(head_walk_at(list, index), &value, sizeof(value));
+            } else {
+                list_set(list, index, &value);
+            }
+            sum += value;
+        } else {
+            void* element = NULL;
+            if (head_walk) {
+                element = head_walk_at(list, index);
+            } else {
+                list_at(list, index, &element);
+            }
+            sum += *(const int64_t*)element * (int64_t)(k & 7);
+        }
+    }
+    long long elapsed = get_current_time_ms_high_precision() - start_time;
+
+    *checksum = sum;
+    return elapsed;
+}
+
+/**
+ * @brief 测试指定大小的链表
+ *
+ * @param log_file 日志文件
+ * @param size 元素数量
+ */
+static void test_size(FILE* log_file, size_t size) {
+    list_t* list = list_create(sizeof(int64_t), NULL, NULL);
+    size_t* indices = (size_t*)malloc(RANDOM_ACCESSES * sizeof(size_t));
+    if (list == NULL || indices == NULL) {
+        printf("错误: 无法创建测试数据\n");
+        list_destroy(list);
+        free(indices);
+        return;
+    }
+    for (size_t i = 0; i < size; i++) {
+        int64_t value = random_int64(-1000000, 1000000);
+        list_push_back(list, &value);
+    }
+    for (size_t i = 0; i < RANDOM_ACCESSES; i++) {
+        indices[i] = (size_t)random_int64(0, (int64_t)size - 1);
+    }
+
+    fprintf(log_file, "--- %zu 个元素 ---\n", size);
+    printf("--- %zu 个元素 ---\n", size);
+
+    const char* modes[4] = {"顺序读取", "逆序读取", "顺序写入", "随机读取"};
+    for (int mode = 0; mode < 4; mode++) {
+        size_t accesses = mode == ACCESS_RANDOM ? RANDOM_ACCESSES : size;
+        /* 从头出发平均每次走n/2步；list_at随机访问时从最近的端点或游标出发，平均不超过n/4步 */
+        double head_steps = (double)accesses * size / 2.0;
+        double nearest_steps = mode == ACCESS_RANDOM ? head_steps / 2.0 : (double)accesses;
+        char name[64];
+        int64_t checksum = 0;
+
+        snprintf(name, sizeof(name), "%s: 从头出发", modes[mode]);
+        long long elapsed = -1;
+        if (head_steps <= WALK_STEP_LIMIT) {
+            elapsed = run_access(list, (access_mode_t)mode, 1, indices, &checksum);
+        }
+        report(log_file, name, elapsed, checksum);
+
+        list_disable_skip_index(list);
+        snprintf(name, sizeof(name), "%s: list_at", modes[mode]);
+        elapsed = -1;
+        if (nearest_steps <= WALK_STEP_LIMIT) {
+            elapsed = run_access(list, (access_mode_t)mode, 0, indices, &checksum);
+        }
+        report(log_file, name, elapsed, checksum);
+
+        list_enable_skip_index(list, 0);
+        snprintf(name, sizeof(name), "%s: list_at + 跳跃索引", modes[mode]);
+        elapsed = run_access(list, (access_mode_t)mode, 0, indices, &checksum);
+        report(log_file, name, elapsed, checksum);
+    }
+
+    fprintf(log_file, "\n");
+    printf("\n");
+
+    list_destroy(list);
+    free(indices);
+}
+
+/**
+ * @brief 运行完整的性能测试
+ */
+void run_performance_tests() {
+    FILE* log_file = fopen(LOG_FILE, "a");
+    if (log_file == NULL) {
+        printf("无法打开日志文件 %s\n", LOG_FILE);
+        return;
+    }
+
+    fprintf(log_file, "\n=== 链表按索引访问性能测试报告 ===\n");
+    fprintf(log_file, "测试时间: %s", ctime(&(time_t){time(NULL)}));
+    fprintf(log_file, "随机访问次数: %d，跳跃索引步长: %d\n\n", RANDOM_ACCESSES, LIST_SKIP_INDEX_STRIDE);
+
+    printf("开始链表按索引访问性能测试...\n");
+    printf("结果将保存到 %s\n\n", LOG_FILE);
+
+    test_size(log_file, 1000);
+    test_size(log_file, 10000);
+    test_size(log_file, 100000);
+    test_size(log_file, 1000000);
+
+    fprintf(log_file, "=== 测试完成 ===\n\n");
+    printf("=== 测试完成 ===\n");
+
+    fclose(log_file);
+}
+
+/**
+ * @brief 显示帮助信息
+ */
+void show_help() {
+    printf("链表按索引访问性能测试程序\n");
+    printf("用法: ./list_index_performance_test [选项]\n");
+    printf("选项:\n");
+    printf("  -h, --help     显示帮助信息\n");
+    printf("  -r, --run      运行性能测试\n");
+    printf("  -c, --clear    清空日志文件\n");
+    printf("\n");
+    printf("  测试结果将保存到 %s 文件中\n", LOG_FILE);
+}
+
+/**
+ * @brief 主函数
+ *
+ * @param argc 参数个数
+ * @param argv 参数数组
+ * @return int 程序退出码
+ */
+int main(int argc, char* argv[]) {
+    srand((unsigned int)time(NULL));
+
+    if (argc < 2) {
+        show_help();
+        return 0;
+    }
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-h") == 0 || strcmp(argv[i], "--help") == 0) {
+            show_help();
+            return 0;
+        } else if (strcmp(argv[i], "-r") == 0 || strcmp(argv[i], "--run") == 0) {
+            run_performance_tests();
+            return 0;
+        } else if (strcmp(argv[i], "-c") == 0 || strcmp(argv[i], "--clear") == 0) {
+            FILE* log_file = fopen(LOG_FILE, "w");
+            if (log_file) {
+                fclose(log_file);
+                printf("日志文件 %s 已清空\n", LOG_FILE);
+            }
+            return 0;
+        } else {
+            printf("未知选项: %s\n", argv[i]);
+            show_help();
+            return 1;
+        }
+    }
+
+    return 0;
+}
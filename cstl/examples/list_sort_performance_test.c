@@ -0,0 +1,307 @@
+/**
+ * @file list_sort_performance_test.c
+ * @brief 链表排序性能测试
+ * @version 0.1
+ * @date 2025-10-06
+ *
+ * @copyright Copyright (c) 2025
+ *
+ * 本文件在使用对象池分配节点的int64链表上对比以下排序方式：
+ * - 递归的自顶向下归并（原list_sort的实现：快慢指针找中点，排序后再遍历一次找尾节点）
+ * - list_sort（非递归的自底向上归并，最后一次合并时恢复prev和尾节点）
+ * - list_sort_ex(LIST_SORT_ARRAY)（收集到数组中排序后一次性重新链接）
+ *
+ * 节点按两种顺序链接：与分配顺序一致（内存中基本连续），以及随机打乱（每一步都是随机访问）。
+ * 使用utils中的高精度时间函数计算耗时，并将结果输出到日志文件中
+ */
+
+#include "cstl.h"
+#include "common/utils.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define LOG_FILE "list_sort_performance.log"
+#define NUM_NODES 10000000
+
+/**
+ * @brief int64比较函数
+ *
+ * @param a 第一个元素指针
+ * @param b 第二个元素指针
+ * @return int 比较结果
+ */
+static int compare_int64(const void* a, const void* b) {
+    int64_t x = *(const int64_t*)a;
+    int64_t y = *(const int64_t*)b;
+    return (x > y) - (x < y);
+}
+
+/**
+ * @brief 原list_sort的递归归并实现，作为对比基准
+ *
+ * @param head 链表头节点
+ * @return list_node_t* 排序后的头节点
+ */
+static list_node_t* recursive_merge_sort(list_node_t* head) {
+    if (head == NULL || head->next == NULL) {
+        return head;
+    }
+
+    list_node_t* slow = head;
+    list_node_t* fast = head->next;
+    while (fast != NULL && fast->next != NULL) {
+        slow = slow->next;
+        fast = fast->next->next;
+    }
+
+    list_node_t* right = slow->next;
+    slow->next = NULL;
+    right->prev = NULL;
+
+    list_node_t* left = recursive_merge_sort(head);
+    right = recursive_merge_sort(right);
+
+    list_node_t dummy = {0};
+    list_node_t* tail = &dummy;
+    while (left != NULL && right != NULL) {
+        if (compare_int64(left->data, right->data) <= 0) {
+            tail->next = left;
+            left->prev = tail;
+            left = left->next;
+        } else {
+            tail->next = right;
+            right->prev = tail;
+            right = right->next;
+        }
+        tail = tail->next;
+    }
+    if (left != NULL) {
+        tail->next = left;
+        left->prev = tail;
+    } else {
+        tail->next = right;
+        right->prev = tail;
+    }
+
+    list_node_t* result = dummy.next;
+    result->prev = NULL;
+    return result;
+}
+
+/**
+ * @brief 用原实现排序链表
+ *
+ * @param list 链表
+ */
+static void recursive_list_sort(list_t* list) {
+    list->head = recursive_merge_sort(list->head);
+    list_node_t* node = list->head;
+    while (node->next != NULL) {
+        node = node->next;
+    }
+    list->tail = node;
+}
+
+/**
+ * @brief 按给定顺序重新链接节点并写入原始数据
+ *
+ * @param list 链表
+ * @param nodes 节点数组
+ * @param values 按链接顺序排列的原始数据
+ * @param count 节点数量
+ */
+static void relink(list_t* list, list_node_t** nodes, const int64_t* values, size_t count) {
+    for (size_t i = 0; i < count; i++) {
+        nodes[i]->prev = i > 0 ? nodes[i - 1] : NULL;
+        nodes[i]->next = i + 1 < count ? nodes[i + 1] : NULL;
+        *(int64_t*)nodes[i]->data = values[i];
+    }
+    list->head = nodes[0];
+    list->tail = nodes[count - 1];
+}
+
+/**
+ * @brief 检查链表是否有序且prev指针和尾节点正确
+ *
+ * @param list 链表
+ * @return int 正确返回1
+ */
+static int list_sorted(const list_t* list) {
+    size_t count = 0;
+    list_node_t* prev = NULL;
+    for (list_node_t* node = list->head; node != NULL; node = node->next) {
+        if (node->prev != prev || (prev != NULL && compare_int64(prev->data, node->data) > 0)) {
+            return 0;
+        }
+        prev = node;
+        count++;
+    }
+    return count == list->size && list->tail == prev;
+}
+
+/**
+ * @brief 输出一行测试结果
+ *
+ * @param log_file 日志文件
+ * @param name 测试名称
+ * @param elapsed 耗时（毫秒）
+ * @param ok 结果是否正确
+ */
+static void report(FILE* log_file, const char* name, long long elapsed, int ok) {
+    fprintf(log_file, "  %-36s %8lld ms  %s\n", name, elapsed, ok ? "有序" : "错误");
+    printf("  %-36s %8lld ms  %s\n", name, elapsed, ok ? "有序" : "错误");
+}
+
+/**
+ * @brief 按给定节点顺序测试三种排序方式
+ *
+ * @param log_file 日志文件
+ * @param list 链表
+ * @param nodes 节点数组，决定链接顺序
+ * @param values 原始数据
+ */
+static void test_order(FILE* log_file, list_t* list, list_node_t** nodes, const int64_t* values) {
+    relink(list, nodes, values, NUM_NODES);
+    long long start_time = get_current_time_ms_high_precision();
+    recursive_list_sort(list);
+    report(log_file, "递归自顶向下归并 (原实现)", get_current_time_ms_high_precision() - start_time,
+           list_sorted(list));
+
+    relink(list, nodes, values, NUM_NODES);
+    start_time = get_current_time_ms_high_precision();
+    list_sort(list, compare_int64);
+    report(log_file, "list_sort (自底向上归并)", get_current_time_ms_high_precision() - start_time,
+           list_sorted(list));
+
+    relink(list, nodes, values, NUM_NODES);
+    start_time = get_current_time_ms_high_precision();
+    list_sort_ex(list, compare_int64, LIST_SORT_ARRAY);
+    report(log_file, "list_sort_ex (LIST_SORT_ARRAY)", get_current_time_ms_high_precision() - start_time,
+           list_sorted(list));
+
+    fprintf(log_file, "\n");
+    printf("\n");
+}
+
+/**
+ * @brief 运行完整的性能测试
+ */
+void run_performance_tests() {
+    FILE* log_file = fopen(LOG_FILE, "a");
+    if (log_file == NULL) {
+        printf("无法打开日志文件 %s\n", LOG_FILE);
+        return;
+    }
+
+    obj_pool_t* pool = obj_pool_create(sizeof(list_node_t), NUM_NODES, NUM_NODES / 4, NULL, NULL);
+    list_t* list = list_create(sizeof(int64_t), NULL, NULL);
+    list_node_t** nodes = (list_node_t**)malloc(NUM_NODES * sizeof(list_node_t*));
+    int64_t* values = (int64_t*)malloc(NUM_NODES * sizeof(int64_t));
+    if (pool == NULL || list == NULL || nodes == NULL || values == NULL) {
+        printf("错误: 无法创建测试数据\n");
+        list_destroy(list);
+        if (pool != NULL) {
+            obj_pool_destroy(pool);
+        }
+        free(nodes);
+        free(values);
+        fclose(log_file);
+        return;
+    }
+    list_set_node_pool(list, pool);
+
+    for (int i = 0; i < NUM_NODES; i++) {
+        values[i] = random_int64(-1000000000000LL, 1000000000000LL);
+        list_push_back(list, &values[i]);
+    }
+    size_t n = 0;
+    for (list_node_t* node = list->head; node != NULL; node = node->next) {
+        nodes[n++] = node;
+    }
+
+    fprintf(log_file, "\n=== 链表排序性能测试报告 ===\n");
+    fprintf(log_file, "测试时间: %s", ctime(&(time_t){time(NULL)}));
+    fprintf(log_file, "节点数量: %d（对象池分配），工作线程: %zu\n\n", NUM_NODES,
+            thread_pool_size(thread_pool_default()));
+
+    printf("开始链表排序性能测试...\n");
+    printf("结果将保存到 %s\n\n", LOG_FILE);
+
+    fprintf(log_file, "--- 节点按分配顺序链接 ---\n");
+    printf("--- 节点按分配顺序链接 ---\n");
+    test_order(log_file, list, nodes, values);
+
+    for (size_t i = NUM_NODES - 1; i > 0; i--) {
+        size_t j = (size_t)random_int64(0, (int64_t)i);
+        list_node_t* temp = nodes[i];
+        nodes[i] = nodes[j];
+        nodes[j] = temp;
+    }
+    fprintf(log_file, "--- 节点随机打乱后链接 ---\n");
+    printf("--- 节点随机打乱后链接 ---\n");
+    test_order(log_file, list, nodes, values);
+
+    fprintf(log_file, "=== 测试完成 ===\n\n");
+    printf("=== 测试完成 ===\n");
+
+    list_destroy(list);
+    obj_pool_destroy(pool);
+    free(nodes);
+    free(values);
+    fclose(log_file);
+}
+
+/**
+ * @brief 显示帮助信息
+ */
+void show_help() {
+    printf("链表排序性能测试程序\n");
+    printf("用法: ./list_sort_performance_test [选项]\n");
+    printf("选项:\n");
+    printf("  -h, --help     显示帮助信息\n");
+    printf("  -r, --run      运行性能测试\n");
+    printf("  -c, --clear    清空日志文件\n");
+    printf("\n");
+    printf("  测试结果将保存到 %s 文件中\n", LOG_FILE);
+}
+
+/**
+ * @brief 主函数
+ *
+ * @param argc 参数个数
+ * @param argv 参数数组
+ * @return int 程序退出码
+ */
+int main(int argc, char* argv[]) {
+    srand((unsigned int)time(NULL));
+
+    if (argc < 2) {
+        show_help();
+        return 0;
+    }
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-h") == 0 || strcmp(argv[i], "--help") == 0) {
+            show_help();
+            return 0;
+        } else if (strcmp(argv[i], "-r") == 0 || strcmp(argv[i], "--run") == 0) {
+            run_performance_tests();
+            return 0;
+        } else if (strcmp(argv[i], "-c") == 0 || strcmp(argv[i], "--clear") == 0) {
+            FILE* log_file = fopen(LOG_FILE, "w");
+            if (log_file) {
+                fclose(log_file);
+                printf("日志文件 %s 已清空\n", LOG_FILE);
+            }
+            return 0;
+        } else {
+            printf("未知选项: %s\n", argv[i]);
+            show_help();
+            return 1;
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,283 @@
+/**
+ * @file list_splice_performance_test.c
+ * @brief 链表节点转移性能测试
+ * @version 0.1
+ * @date 2025-10-07
+ *
+ * @copyright Copyright (c) 2025
+ *
+ * 本文件模拟两种常见的节点移动场景，对比"删除后重新插入"与直接转移节点：
+ * - LRU缓存：命中的条目移动到链表前端（list_erase + list_push_front 与 list_splice_node）
+ * - 调度队列：每轮把就绪队列前端的一批任务移到运行队列末尾
+ *   （逐个 list_pop_front + list_push_back 与 list_splice_range）
+ *
+ * 使用utils中的高精度时间函数计算耗时，并将结果输出到日志文件中
+ */
+
+#include "cstl.h"
+#include "common/utils.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define LOG_FILE "list_splice_performance.log"
+#define LRU_ENTRIES 100000
+#define LRU_ACCESSES 10000000
+#define QUEUE_TASKS 100000
+#define QUEUE_ROUNDS 200000
+#define QUEUE_BATCH 64
+
+/**
+ * @brief 缓存条目
+ */
+typedef struct {
+    int64_t key;            /**< 键 */
+    char payload[48];       /**< 负载 */
+} cache_entry_t;
+
+/**
+ * @brief 输出一行测试结果
+ *
+ * @param log_file 日志文件
+ * @param name 测试名称
+ * @param elapsed 耗时（毫秒）
+ * @param checksum 校验值，两种方式应当一致
+ */
+static void report(FILE* log_file, const char* name, long long elapsed, int64_t checksum) {
+    fprintf(log_file, "  %-36s %8lld ms  校验 %lld\n", name, elapsed, (long long)checksum);
+    printf("  %-36s %8lld ms  校验 %lld\n", name, elapsed, (long long)checksum);
+}
+
+/**
+ * @brief 计算链表前若干个条目的键的校验值
+ *
+ * @param list 链表
+ * @return int64_t 校验值
+ */
+static int64_t list_checksum(const list_t* list) {
+    int64_t sum = 0;
+    int64_t weight = 1;
+    for (list_node_t* node = list->head; node != NULL && weight <= 1000; node = node->next) {
+        sum += ((const cache_entry_t*)node->data)->key * weight;
+        weight++;
+    }
+    return sum;
+}
+
+/**
+ * @brief 创建有count个条目的链表，并记录每个键对应的节点
+ *
+ * @param count 条目数量
+ * @param nodes 输出参数，按键索引的节点数组
+ * @return list_t* 链表
+ */
+static list_t* build_cache(size_t count, list_node_t** nodes) {
+    list_t* list = list_create(sizeof(cache_entry_t), NULL, NULL);
+    if (list == NULL) {
+        return NULL;
+    }
+    for (size_t i = 0; i < count; i++) {
+        cache_entry_t entry;
+        memset(&entry, 0, sizeof(entry));
+        entry.key = (int64_t)i;
+        list_push_back(list, &entry);
+        nodes[i] = list->tail;
+    }
+    return list;
+}
+
+/**
+ * @brief LRU缓存测试
+ *
+ * @param log_file 日志文件
+ */
+static void test_lru(FILE* log_file) {
+    list_node_t** nodes = (list_node_t**)malloc(LRU_ENTRIES * sizeof(list_node_t*));
+    size_t* accesses = (size_t*)malloc(LRU_ACCESSES * sizeof(size_t));
+    if (nodes == NULL || accesses == NULL) {
+        printf("错误: 无法创建测试数据\n");
+        free(nodes);
+        free(accesses);
+        return;
+    }
+    for (size_t i = 0; i < LRU_ACCESSES; i++) {
+        /* 约80%的访问落在20%的热点条目上 */
+        int64_t hot = random_int64(0, 9);
+        accesses[i] = hot < 8 ? (size_t)random_int64(0, LRU_ENTRIES / 5 - 1)
+                              : (size_t)random_int64(0, LRU_ENTRIES - 1);
+    }
+
+    fprintf(log_file, "--- LRU缓存：%d 个条目，%d 次访问 ---\n", LRU_ENTRIES, LRU_ACCESSES);
+    printf("--- LRU缓存：%d 个条目，%d 次访问 ---\n", LRU_ENTRIES, LRU_ACCESSES);
+
+    list_t* list = build_cache(LRU_ENTRIES, nodes);
+    if (list != NULL) {
+        long long start_time = get_current_time_ms_high_precision();
+        for (size_t i = 0; i < LRU_ACCESSES; i++) {
+            list_node_t* node = nodes[accesses[i]];
+            if (node == list->head) {
+                continue;
+            }
+            cache_entry_t entry = *(const cache_entry_t*)node->data;
+            list_erase(list, node);
+            list_push_front(list, &entry);
+            nodes[accesses[i]] = list->head;
+        }
+        report(log_file, "list_erase + list_push_front", get_current_time_ms_high_precision() - start_time,
+               list_checksum(list));
+        list_destroy(list);
+    }
+
+    list = build_cache(LRU_ENTRIES, nodes);
+    if (list != NULL) {
+        long long start_time = get_current_time_ms_high_precision();
+        for (size_t i = 0; i < LRU_ACCESSES; i++) {
+            list_splice_node(list, list->head, list, nodes[accesses[i]]);
+        }
+        report(log_file, "list_splice_node", get_current_time_ms_high_precision() - start_time,
+               list_checksum(list));
+        list_destroy(list);
+    }
+
+    fprintf(log_file, "\n");
+    printf("\n");
+    free(nodes);
+    free(accesses);
+}
+
+/**
+ * @brief 调度队列测试
+ *
+ * @param log_file 日志文件
+ */
+static void test_queues(FILE* log_file) {
+    list_node_t** nodes = (list_node_t**)malloc(QUEUE_TASKS * sizeof(list_node_t*));
+    if (nodes == NULL) {
+        printf("错误: 无法创建测试数据\n");
+        return;
+    }
+
+    fprintf(log_file, "--- 调度队列：%d 个任务，%d 轮，每轮移动 %d 个 ---\n", QUEUE_TASKS, QUEUE_ROUNDS, QUEUE_BATCH);
+    printf("--- 调度队列：%d 个任务，%d 轮，每轮移动 %d 个 ---\n", QUEUE_TASKS, QUEUE_ROUNDS, QUEUE_BATCH);
+
+    for (int mode = 0; mode < 2; mode++) {
+        list_t* ready = build_cache(QUEUE_TASKS, nodes);
+        list_t* running = list_create(sizeof(cache_entry_t), NULL, NULL);
+        if (ready == NULL || running == NULL) {
+            list_destroy(ready);
+            list_destroy(running);
+            break;
+        }
+
+        long long start_time = get_current_time_ms_high_precision();
+        for (int round = 0; round < QUEUE_ROUNDS; round++) {
+            /* 就绪队列移空后两个队列交换角色 */
+            if (ready->size < QUEUE_BATCH) {
+                list_t* temp = ready;
+                ready = running;
+                running = temp;
+            }
+            if (mode == 0) {
+                for (int i = 0; i < QUEUE_BATCH; i++) {
+                    cache_entry_t entry = *(const cache_entry_t*)ready->head->data;
+                    list_pop_front(ready);
+                    list_push_back(running, &entry);
+                }
+            } else {
+                list_node_t* last = ready->head;
+                for (int i = 0; i < QUEUE_BATCH; i++) {
+                    last = last->next;
+                }
+                list_splice_range(running, NULL, ready, ready->head, last, QUEUE_BATCH);
+            }
+        }
+        report(log_file, mode == 0 ? "list_pop_front + list_push_back" : "list_splice_range",
+               get_current_time_ms_high_precision() - start_time, list_checksum(running));
+
+        list_destroy(ready);
+        list_destroy(running);
+    }
+
+    fprintf(log_file, "\n");
+    printf("\n");
+    free(nodes);
+}
+
+/**
+ * @brief 运行完整的性能测试
+ */
+void run_performance_tests() {
+    FILE* log_file = fopen(LOG_FILE, "a");
+    if (log_file == NULL) {
+        printf("无法打开日志文件 %s\n", LOG_FILE);
+        return;
+    }
+
+    fprintf(log_file, "\n=== 链表节点转移性能测试报告 ===\n");
+    fprintf(log_file, "测试时间: %s\n", ctime(&(time_t){time(NULL)}));
+
+    printf("开始链表节点转移性能测试...\n");
+    printf("结果将保存到 %s\n\n", LOG_FILE);
+
+    test_lru(log_file);
+    test_queues(log_file);
+
+    fprintf(log_file, "=== 测试完成 ===\n\n");
+    printf("=== 测试完成 ===\n");
+
+    fclose(log_file);
+}
+
+/**
+ * @brief 显示帮助信息
+ */
+void show_help() {
+    printf("链表节点转移性能测试程序\n");
+    printf("用法: ./list_splice_performance_test [选项]\n");
+    printf("选项:\n");
+    printf("  -h, --help     显示帮助信息\n");
+    printf("  -r, --run      运行性能测试\n");
+    printf("  -c, --clear    清空日志文件\n");
+    printf("\n");
+    printf("  测试结果将保存到 %s 文件中\n", LOG_FILE);
+}
+
+/**
+ * @brief 主函数
+ *
+ * @param argc 参数个数
+ * @param argv 参数数组
+ * @return int 程序退出码
+ */
+int main(int argc, char* argv[]) {
+    srand((unsigned int)time(NULL));
+
+    if (argc < 2) {
+        show_help();
+        return 0;
+    }
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-h") == 0 || strcmp(argv[i], "--help") == 0) {
+            show_help();
+            return 0;
+        } else if (strcmp(argv[i], "-r") == 0 || strcmp(argv[i], "--run") == 0) {
+            run_performance_tests();
+            return 0;
+        } else if (strcmp(argv[i], "-c") == 0 || strcmp(argv[i], "--clear") == 0) {
+            FILE* log_file = fopen(LOG_FILE, "w");
+            if (log_file) {
+                fclose(log_file);
+                printf("日志文件 %s 已清空\n", LOG_FILE);
+            }
+            return 0;
+        } else {
+            printf("未知选项: %s\n", argv[i]);
+            show_help();
+            return 1;
+        }
+    }
+
+    return 0;
+}
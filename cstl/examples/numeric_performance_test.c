@@ -0,0 +1,327 @@
+/**
+ * @file numeric_performance_test.c
+ * @brief 数值内核性能测试
+ * @version 0.1
+ * @date 2025-09-25
+ *
+ * @copyright Copyright (c) 2025
+ *
+ * 本文件以1024个采样为一帧，测试峰值（最小/最大值）和均方根的单帧耗时，
+ * 对比以下方式：
+ * - 逐元素调用比较函数的 algo_minmax_element
+ * - simd_minmax_index / simd_rms 的标量实现
+ * - simd_minmax_index / simd_rms 的AVX2实现
+ *
+ * 另外测试大数组上求和与点积的吞吐量。
+ * 使用utils中的高精度时间函数计算耗时，并将结果输出到日志文件中
+ */
+
+#include "cstl.h"
+#include "common/utils.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define LOG_FILE "numeric_performance.log"
+#define FRAME_SIZE 1024
+#define NUM_FRAMES 200000
+#define COMPARE_FRAMES 2000
+#define ARRAY_SIZE 4000000
+#define ARRAY_REPEAT 20
+
+/**
+ * @brief int16_t比较函数
+ *
+ * @param a 第一个元素指针
+ * @param b 第二个元素指针
+ * @return int 比较结果
+ */
+static int compare_int16(const void* a, const void* b) {
+    return (int)*(const int16_t*)a - (int)*(const int16_t*)b;
+}
+
+/**
+ * @brief float比较函数
+ *
+ * @param a 第一个元素指针
+ * @param b 第二个元素指针
+ * @return int 比较结果
+ */
+static int compare_float(const void* a, const void* b) {
+    float x = *(const float*)a;
+    float y = *(const float*)b;
+    return (x > y) - (x < y);
+}
+
+/**
+ * @brief 输出一行单帧耗时
+ *
+ * @param log_file 日志文件
+ * @param name 测试名称
+ * @param elapsed 总耗时（毫秒）
+ * @param frames 帧数
+ */
+static void report_frame(FILE* log_file, const char* name, long long elapsed, int frames) {
+    double ns = elapsed * 1e6 / frames;
+    fprintf(log_file, "  %-34s %10.1f ns/帧\n", name, ns);
+    printf("  %-34s %10.1f ns/帧\n", name, ns);
+}
+
+/**
+ * @brief 测试int16和float音频帧的峰值与均方根
+ *
+ * @param log_file 日志文件
+ */
+static void test_frames(FILE* log_file) {
+    int16_t* samples = (int16_t*)malloc(FRAME_SIZE * sizeof(int16_t));
+    float* floats = (float*)malloc(FRAME_SIZE * sizeof(float));
+    vector_t* vec = vector_create(sizeof(int16_t), FRAME_SIZE, NULL, NULL);
+    vector_t* fvec = vector_create(sizeof(float), FRAME_SIZE, NULL, NULL);
+    if (samples == NULL || floats == NULL || vec == NULL || fvec == NULL) {
+        printf("错误: 无法创建测试数据\n");
+        free(samples);
+        free(floats);
+        vector_destroy(vec);
+        vector_destroy(fvec);
+        return;
+    }
+
+    for (int i = 0; i < FRAME_SIZE; i++) {
+        samples[i] = (int16_t)random_int64(-32768, 32767);
+        floats[i] = samples[i] / 32768.0f;
+        vector_push_back(vec, &samples[i]);
+        vector_push_back(fvec, &floats[i]);
+    }
+
+    fprintf(log_file, "--- 单帧峰值与均方根 (%d 个采样) ---\n", FRAME_SIZE);
+    printf("--- 单帧峰值与均方根 (%d 个采样) ---\n", FRAME_SIZE);
+
+    // 比较函数版本
+    iterator_t* begin = vector_begin(vec);
+    iterator_t* end = vector_end(vec);
+    void* min_element = NULL;
+    void* max_element = NULL;
+    long long start_time = get_current_time_ms_high_precision();
+    for (int f = 0; f < COMPARE_FRAMES; f++) {
+        algo_minmax_element(begin, end, compare_int16, &min_element, &max_element);
+    }
+    report_frame(log_file, "int16 algo_minmax_element", get_current_time_ms_high_precision() - start_time,
+                 COMPARE_FRAMES);
+    iterator_destroy(begin);
+    iterator_destroy(end);
+
+    begin = vector_begin(fvec);
+    end = vector_end(fvec);
+    start_time = get_current_time_ms_high_precision();
+    for (int f = 0; f < COMPARE_FRAMES; f++) {
+        algo_minmax_element(begin, end, compare_float, &min_element, &max_element);
+    }
+    report_frame(log_file, "float algo_minmax_element", get_current_time_ms_high_precision() - start_time,
+                 COMPARE_FRAMES);
+    iterator_destroy(begin);
+    iterator_destroy(end);
+
+    // 标量与AVX2内核
+    const char* levels[2] = {"标量", "AVX2"};
+    const unsigned int masks[2] = {0, ~0u};
+    for (int level = 0; level < 2; level++) {
+        if (level == 1 && !(simd_cpu_features() & SIMD_FEATURE_AVX2)) {
+            fprintf(log_file, "  CPU不支持AVX2，跳过\n");
+            printf("  CPU不支持AVX2，跳过\n");
+            break;
+        }
+        simd_set_feature_mask(masks[level]);
+        char name[64];
+        size_t min_index = 0;
+        size_t max_index = 0;
+        volatile double sink = 0.0;
+
+        start_time = get_current_time_ms_high_precision();
+        for (int f = 0; f < NUM_FRAMES; f++) {
+            simd_minmax_index_i16(samples, FRAME_SIZE, &min_index, &max_index);
+            sink += min_index + max_index;
+        }
+        snprintf(name, sizeof(name), "int16 峰值 (%s)", levels[level]);
+        report_frame(log_file, name, get_current_time_ms_high_precision() - start_time, NUM_FRAMES);
+
+        start_time = get_current_time_ms_high_precision();
+        for (int f = 0; f < NUM_FRAMES; f++) {
+            sink += simd_rms_i16(samples, FRAME_SIZE);
+        }
+        snprintf(name, sizeof(name), "int16 均方根 (%s)", levels[level]);
+        report_frame(log_file, name, get_current_time_ms_high_precision() - start_time, NUM_FRAMES);
+
+        start_time = get_current_time_ms_high_precision();
+        for (int f = 0; f < NUM_FRAMES; f++) {
+            simd_minmax_index_f32(floats, FRAME_SIZE, &min_index, &max_index);
+            sink += min_index + max_index;
+        }
+        snprintf(name, sizeof(name), "float 峰值 (%s)", levels[level]);
+        report_frame(log_file, name, get_current_time_ms_high_precision() - start_time, NUM_FRAMES);
+
+        start_time = get_current_time_ms_high_precision();
+        for (int f = 0; f < NUM_FRAMES; f++) {
+            sink += simd_rms_f32(floats, FRAME_SIZE);
+        }
+        snprintf(name, sizeof(name), "float 均方根 (%s)", levels[level]);
+        report_frame(log_file, name, get_current_time_ms_high_precision() - start_time, NUM_FRAMES);
+        (void)sink;
+    }
+    simd_set_feature_mask(~0u);
+
+    fprintf(log_file, "\n");
+    printf("\n");
+
+    free(samples);
+    free(floats);
+    vector_destroy(vec);
+    vector_destroy(fvec);
+}
+
+/**
+ * @brief 测试大数组的求和与点积吞吐量
+ *
+ * @param log_file 日志文件
+ */
+static void test_arrays(FILE* log_file) {
+    double* a = (double*)malloc(ARRAY_SIZE * sizeof(double));
+    double* b = (double*)malloc(ARRAY_SIZE * sizeof(double));
+    int32_t* c = (int32_t*)malloc(ARRAY_SIZE * sizeof(int32_t));
+    if (a == NULL || b == NULL || c == NULL) {
+        printf("错误: 无法创建测试数据\n");
+        free(a);
+        free(b);
+        free(c);
+        return;
+    }
+    for (size_t i = 0; i < ARRAY_SIZE; i++) {
+        a[i] = random_int64(-1000000, 1000000) / 1e6;
+        b[i] = random_int64(-1000000, 1000000) / 1e6;
+        c[i] = (int32_t)random_int64(-1000000, 1000000);
+    }
+
+    fprintf(log_file, "--- 大数组吞吐量 (%d 个元素, 重复 %d 次) ---\n", ARRAY_SIZE, ARRAY_REPEAT);
+    printf("--- 大数组吞吐量 (%d 个元素, 重复 %d 次) ---\n", ARRAY_SIZE, ARRAY_REPEAT);
+
+    const char* levels[2] = {"标量", "AVX2"};
+    const unsigned int masks[2] = {0, ~0u};
+    for (int level = 0; level < 2; level++) {
+        if (level == 1 && !(simd_cpu_features() & SIMD_FEATURE_AVX2)) {
+            break;
+        }
+        simd_set_feature_mask(masks[level]);
+        volatile double sink = 0.0;
+
+        long long start_time = get_current_time_ms_high_precision();
+        for (int r = 0; r < ARRAY_REPEAT; r++) {
+            sink += simd_sum_f64(a, ARRAY_SIZE);
+        }
+        long long sum_time = get_current_time_ms_high_precision() - start_time;
+
+        start_time = get_current_time_ms_high_precision();
+        for (int r = 0; r < ARRAY_REPEAT; r++) {
+            sink += simd_dot_f64(a, b, ARRAY_SIZE);
+        }
+        long long dot_time = get_current_time_ms_high_precision() - start_time;
+
+        start_time = get_current_time_ms_high_precision();
+        for (int r = 0; r < ARRAY_REPEAT; r++) {
+            sink += (double)simd_sum_i32(c, ARRAY_SIZE);
+        }
+        long long isum_time = get_current_time_ms_high_precision() - start_time;
+
+        fprintf(log_file, "  %-6s double Kahan求和 %5lld ms  double点积 %5lld ms  int32求和 %5lld ms\n",
+                levels[level], sum_time, dot_time, isum_time);
+        printf("  %-6s double Kahan求和 %5lld ms  double点积 %5lld ms  int32求和 %5lld ms\n",
+               levels[level], sum_time, dot_time, isum_time);
+        (void)sink;
+    }
+    simd_set_feature_mask(~0u);
+
+    fprintf(log_file, "\n");
+    printf("\n");
+
+    free(a);
+    free(b);
+    free(c);
+}
+
+/**
+ * @brief 运行完整的性能测试
+ */
+void run_performance_tests() {
+    FILE* log_file = fopen(LOG_FILE, "a");
+    if (log_file == NULL) {
+        printf("无法打开日志文件 %s\n", LOG_FILE);
+        return;
+    }
+
+    fprintf(log_file, "\n=== 数值内核性能测试报告 ===\n");
+    fprintf(log_file, "测试时间: %s", ctime(&(time_t){time(NULL)}));
+    fprintf(log_file, "CPU特性: AVX2 %s\n\n", (simd_cpu_features() & SIMD_FEATURE_AVX2) ? "支持" : "不支持");
+
+    printf("开始数值内核性能测试...\n");
+    printf("结果将保存到 %s\n\n", LOG_FILE);
+
+    test_frames(log_file);
+    test_arrays(log_file);
+
+    fprintf(log_file, "=== 测试完成 ===\n\n");
+    printf("=== 测试完成 ===\n");
+
+    fclose(log_file);
+}
+
+/**
+ * @brief 显示帮助信息
+ */
+void show_help() {
+    printf("数值内核性能测试程序\n");
+    printf("用法: ./numeric_performance_test [选项]\n");
+    printf("选项:\n");
+    printf("  -h, --help     显示帮助信息\n");
+    printf("  -r, --run      运行性能测试\n");
+    printf("  -c, --clear    清空日志文件\n");
+    printf("\n");
+    printf("  测试结果将保存到 %s 文件中\n", LOG_FILE);
+}
+
+/**
+ * @brief 主函数
+ *
+ * @param argc 参数个数
+ * @param argv 参数数组
+ * @return int 程序退出码
+ */
+int main(int argc, char* argv[]) {
+    srand((unsigned int)time(NULL));
+
+    if (argc < 2) {
+        show_help();
+        return 0;
+    }
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-h") == 0 || strcmp(argv[i], "--help") == 0) {
+            show_help();
+            return 0;
+        } else if (strcmp(argv[i], "-r") == 0 || strcmp(argv[i], "--run") == 0) {
+            run_performance_tests();
+            return 0;
+        } else if (strcmp(argv[i], "-c") == 0 || strcmp(argv[i], "--clear") == 0) {
+            FILE* log_file = fopen(LOG_FILE, "w");
+            if (log_file) {
+                fclose(log_file);
+                printf("日志文件 %s 已清空\n", LOG_FILE);
+            }
+            return 0;
+        } else {
+            printf("未知选项: %s\n", argv[i]);
+            show_help();
+            return 1;
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,271 @@
+/**
+ * @file parallel_performance_test.c
+ * @brief 并行算法性能测试
+ * @version 0.1
+ * @date 2025-09-22
+ *
+ * @copyright Copyright (c) 2025
+ *
+ * 本文件测试并行算法相对顺序算法的加速比以及调度开销，包括：
+ * - algo_par_for_each / algo_par_transform / algo_par_reduce / algo_par_count_if
+ *   与对应顺序算法的对比
+ * - 不同分块大小 (grain_size) 对 algo_par_for_each 的影响
+ * - 单次 thread_pool_parallel_for 调用的固定开销
+ *
+ * 使用utils中的高精度时间函数计算耗时，并将结果输出到日志文件中
+ */
+
+#include "cstl.h"
+#include "common/utils.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define LOG_FILE "parallel_performance.log"
+#define NUM_ELEMENTS 10000000
+#define NUM_GRAINS 6
+#define OVERHEAD_CALLS 10000
+
+// 分块大小，0表示自动选择
+const size_t test_grains[NUM_GRAINS] = {0, 256, 1024, 16384, 262144, 1048576};
+
+/**
+ * @brief 元素加一
+ *
+ * @param element 元素指针
+ */
+static void increment(void* element) {
+    (*(int64_t*)element)++;
+}
+
+/**
+ * @brief 元素平方
+ *
+ * @param element 元素指针
+ */
+static void square(void* element) {
+    int64_t value = *(int64_t*)element;
+    *(int64_t*)element = value * value;
+}
+
+/**
+ * @brief 求和合并
+ *
+ * @param a 累加目标
+ * @param b 待合并元素
+ */
+static void add(void* a, const void* b) {
+    *(int64_t*)a += *(const int64_t*)b;
+}
+
+/**
+ * @brief 判断是否为偶数
+ *
+ * @param element 元素指针
+ * @return int 是偶数返回非零
+ */
+static int is_even(const void* element) {
+    return (*(const int64_t*)element & 1) == 0;
+}
+
+/**
+ * @brief 空区间任务，用于测量调度开销
+ *
+ * @param context 未使用
+ * @param begin 未使用
+ * @param end 未使用
+ */
+static void empty_range(void* context, size_t begin, size_t end) {
+    (void)context;
+    (void)begin;
+    (void)end;
+}
+
+/**
+ * @brief 输出一行对比结果
+ *
+ * @param log_file 日志文件
+ * @param name 测试名称
+ * @param sequential 顺序耗时
+ * @param parallel 并行耗时
+ */
+static void report(FILE* log_file, const char* name, long long sequential, long long parallel) {
+    double speedup = parallel > 0 ? (double)sequential / parallel : 0.0;
+    fprintf(log_file, "  %-14s 顺序 %5lld ms  并行 %5lld ms  加速比 %.2f\n", name, sequential, parallel, speedup);
+    printf("  %-14s 顺序 %5lld ms  并行 %5lld ms  加速比 %.2f\n", name, sequential, parallel, speedup);
+}
+
+/**
+ * @brief 运行完整的性能测试
+ */
+void run_performance_tests() {
+    FILE* log_file = fopen(LOG_FILE, "a");
+    if (log_file == NULL) {
+        printf("无法打开日志文件 %s\n", LOG_FILE);
+        return;
+    }
+
+    size_t workers = thread_pool_size(thread_pool_default());
+    fprintf(log_file, "\n=== 并行算法性能测试报告 ===\n");
+    fprintf(log_file, "测试时间: %s", ctime(&(time_t){time(NULL)}));
+    fprintf(log_file, "测试数据: %d 个 int64_t, 工作线程 %zu 个\n\n", NUM_ELEMENTS, workers);
+    printf("开始并行算法性能测试 (%d 个元素, %zu 个工作线程)...\n", NUM_ELEMENTS, workers);
+    printf("结果将保存到 %s\n\n", LOG_FILE);
+
+    vector_t* vec = vector_create(sizeof(int64_t), NUM_ELEMENTS, NULL, NULL);
+    vector_t* out = vector_create(sizeof(int64_t), NUM_ELEMENTS, NULL, NULL);
+    if (vec == NULL || out == NULL) {
+        printf("错误: 无法创建测试数据\n");
+        vector_destroy(vec);
+        vector_destroy(out);
+        fclose(log_file);
+        return;
+    }
+    vector_resize(vec, NUM_ELEMENTS);
+    vector_resize(out, NUM_ELEMENTS);
+    for (size_t i = 0; i < NUM_ELEMENTS; i++) {
+        ((int64_t*)vec->data)[i] = random_int64(0, 1000);
+    }
+
+    iterator_t* begin = vector_begin(vec);
+    iterator_t* end = vector_end(vec);
+    iterator_t* dest = vector_begin(out);
+    size_t count = 0;
+
+    fprintf(log_file, "--- 顺序 vs 并行（自动分块） ---\n");
+    printf("--- 顺序 vs 并行（自动分块） ---\n");
+
+    long long start_time = get_current_time_ms_high_precision();
+    algo_for_each(begin, end, increment);
+    long long sequential = get_current_time_ms_high_precision() - start_time;
+    start_time = get_current_time_ms_high_precision();
+    algo_par_for_each(begin, end, increment, 0);
+    report(log_file, "for_each", sequential, get_current_time_ms_high_precision() - start_time);
+
+    start_time = get_current_time_ms_high_precision();
+    algo_transform(begin, end, dest, square, &count);
+    sequential = get_current_time_ms_high_precision() - start_time;
+    start_time = get_current_time_ms_high_precision();
+    algo_par_transform(begin, end, dest, square, 0, &count);
+    report(log_file, "transform", sequential, get_current_time_ms_high_precision() - start_time);
+
+    int64_t sum_sequential = 0;
+    int64_t sum_parallel = 0;
+    start_time = get_current_time_ms_high_precision();
+    for (size_t i = 0; i < NUM_ELEMENTS; i++) {
+        add(&sum_sequential, (int64_t*)vec->data + i);
+    }
+    sequential = get_current_time_ms_high_precision() - start_time;
+    start_time = get_current_time_ms_high_precision();
+    algo_par_reduce(begin, end, add, 0, &sum_parallel);
+    report(log_file, "reduce", sequential, get_current_time_ms_high_precision() - start_time);
+    if (sum_sequential != sum_parallel) {
+        fprintf(log_file, "  错误: 归约结果不一致!\n");
+        printf("  错误: 归约结果不一致!\n");
+    }
+
+    size_t count_parallel = 0;
+    start_time = get_current_time_ms_high_precision();
+    algo_count_if(begin, end, is_even, &count);
+    sequential = get_current_time_ms_high_precision() - start_time;
+    start_time = get_current_time_ms_high_precision();
+    algo_par_count_if(begin, end, is_even, 0, &count_parallel);
+    report(log_file, "count_if", sequential, get_current_time_ms_high_precision() - start_time);
+    if (count != count_parallel) {
+        fprintf(log_file, "  错误: 计数结果不一致!\n");
+        printf("  错误: 计数结果不一致!\n");
+    }
+
+    // 分块大小的影响
+    fprintf(log_file, "\n--- algo_par_for_each 分块大小 ---\n");
+    printf("\n--- algo_par_for_each 分块大小 ---\n");
+    for (int i = 0; i < NUM_GRAINS; i++) {
+        start_time = get_current_time_ms_high_precision();
+        algo_par_for_each(begin, end, increment, test_grains[i]);
+        long long elapsed = get_current_time_ms_high_precision() - start_time;
+        double ns_per_element = elapsed * 1e6 / NUM_ELEMENTS;
+        if (test_grains[i] == 0) {
+            fprintf(log_file, "  grain = 自动     %5lld ms  (%.2f ns/元素)\n", elapsed, ns_per_element);
+            printf("  grain = 自动     %5lld ms  (%.2f ns/元素)\n", elapsed, ns_per_element);
+        } else {
+            fprintf(log_file, "  grain = %-8zu %5lld ms  (%.2f ns/元素)\n", test_grains[i], elapsed, ns_per_element);
+            printf("  grain = %-8zu %5lld ms  (%.2f ns/元素)\n", test_grains[i], elapsed, ns_per_element);
+        }
+    }
+
+    // 单次调用的固定开销：每次只有workers+1个空分块
+    start_time = get_current_time_ms_high_precision();
+    for (int i = 0; i < OVERHEAD_CALLS; i++) {
+        thread_pool_parallel_for(NULL, workers + 1, 1, empty_range, NULL);
+    }
+    long long elapsed = get_current_time_ms_high_precision() - start_time;
+    fprintf(log_file, "\n--- 调度开销 ---\n  每次 thread_pool_parallel_for 调用: %.2f us\n",
+            elapsed * 1000.0 / OVERHEAD_CALLS);
+    printf("\n--- 调度开销 ---\n  每次 thread_pool_parallel_for 调用: %.2f us\n",
+           elapsed * 1000.0 / OVERHEAD_CALLS);
+
+    iterator_destroy(begin);
+    iterator_destroy(end);
+    iterator_destroy(dest);
+    vector_destroy(vec);
+    vector_destroy(out);
+
+    fprintf(log_file, "\n=== 测试完成 ===\n\n");
+    printf("\n=== 测试完成 ===\n");
+
+    fclose(log_file);
+}
+
+/**
+ * @brief 显示帮助信息
+ */
+void show_help() {
+    printf("并行算法性能测试程序\n");
+    printf("用法: ./parallel_performance_test [选项]\n");
+    printf("选项:\n");
+    printf("  -h, --help     显示帮助信息\n");
+    printf("  -r, --run      运行性能测试\n");
+    printf("  -c, --clear    清空日志文件\n");
+    printf("\n");
+    printf("  测试结果将保存到 %s 文件中\n", LOG_FILE);
+}
+
+/**
+ * @brief 主函数
+ *
+ * @param argc 参数个数
+ * @param argv 参数数组
+ * @return int 程序退出码
+ */
+int main(int argc, char* argv[]) {
+    srand((unsigned int)time(NULL));
+
+    if (argc < 2) {
+        show_help();
+        return 0;
+    }
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-h") == 0 || strcmp(argv[i], "--help") == 0) {
+            show_help();
+            return 0;
+        } else if (strcmp(argv[i], "-r") == 0 || strcmp(argv[i], "--run") == 0) {
+            run_performance_tests();
+            return 0;
+        } else if (strcmp(argv[i], "-c") == 0 || strcmp(argv[i], "--clear") == 0) {
+            FILE* log_file = fopen(LOG_FILE, "w");
+            if (log_file) {
+                fclose(log_file);
+                printf("日志文件 %s 已清空\n", LOG_FILE);
+            }
+            return 0;
+        } else {
+            printf("未知选项: %s\n", argv[i]);
+            show_help();
+            return 1;
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,284 @@
+/**
+ * @file pattern_search_performance_test.c
+ * @brief 子序列搜索性能测试
+ * @version 0.1
+ * @date 2025-09-26
+ *
+ * @copyright Copyright (c) 2025
+ *
+ * 本文件在随机字节数据中搜索不存在的模式，保证每次都扫描完整范围，
+ * 按模式长度对比以下方式的 algo_search / algo_find_end 性能：
+ * - 逐元素调用比较函数的通用实现
+ * - 比较函数为NULL的按位比较模式，分别限制为标量（Horspool）、SSE2和AVX2内核
+ *
+ * 短模式（不超过256字节）在SSE2/AVX2下使用首尾元素过滤，长模式始终使用Horspool。
+ * 另外测试int16音频采样中的同步字搜索。
+ * 使用utils中的高精度时间函数计算耗时，并将结果输出到日志文件中
+ */
+
+#include "cstl.h"
+#include "common/utils.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define LOG_FILE "pattern_search_performance.log"
+#define NUM_ELEMENTS 4000000
+#define REPEAT 5
+#define NUM_LENGTHS 6
+#define NUM_MODES 4
+
+// 模式长度（元素个数）
+const size_t pattern_lengths[NUM_LENGTHS] = {4, 16, 64, 256, 1024, 4096};
+
+// 测试模式名称，第一个是比较函数模式
+const char* mode_names[NUM_MODES] = {"比较函数", "按位-标量", "按位-SSE2", "按位-AVX2"};
+
+// 各模式对应的SIMD特性掩码
+const unsigned int mode_masks[NUM_MODES] = {~0u, 0, SIMD_FEATURE_SSE2, SIMD_FEATURE_SSE2 | SIMD_FEATURE_AVX2};
+
+/**
+ * @brief uint8_t比较函数
+ */
+static int compare_u8(const void* a, const void* b) {
+    return (int)*(const uint8_t*)a - (int)*(const uint8_t*)b;
+}
+
+/**
+ * @brief int16_t比较函数
+ */
+static int compare_i16(const void* a, const void* b) {
+    return (int)*(const int16_t*)a - (int)*(const int16_t*)b;
+}
+
+/**
+ * @brief 生成一个不在数据中出现的模式
+ *
+ * 模式以数据中不存在的0开头，保证搜索扫描完整范围，其余元素随机。
+ *
+ * @param pattern 模式向量
+ * @param length 模式长度
+ */
+static void fill_pattern(vector_t* pattern, size_t length) {
+    vector_clear(pattern);
+    for (size_t i = 0; i < length; i++) {
+        unsigned char value = i == 0 ? 0 : (unsigned char)random_int64(1, 255);
+        vector_push_back(pattern, &value);
+    }
+}
+
+/**
+ * @brief 测试一组数据与模式
+ *
+ * @param log_file 日志文件
+ * @param label 行标签
+ * @param data 数据向量
+ * @param pattern 模式向量
+ * @param compare 比较函数模式下使用的比较函数
+ */
+static void test_pattern(FILE* log_file, const char* label, vector_t* data, vector_t* pattern, compare_fn_t compare) {
+    iterator_t* begin = vector_begin(data);
+    iterator_t* end = vector_end(data);
+    iterator_t* pattern_begin = vector_begin(pattern);
+    iterator_t* pattern_end = vector_end(pattern);
+
+    fprintf(log_file, "  %s\n", label);
+    printf("  %s\n", label);
+
+    for (int mode = 0; mode < NUM_MODES; mode++) {
+        if ((mode_masks[mode] & ~simd_cpu_features() & (SIMD_FEATURE_SSE2 | SIMD_FEATURE_AVX2)) != 0) {
+            fprintf(log_file, "    %-12s CPU不支持，跳过\n", mode_names[mode]);
+            printf("    %-12s CPU不支持，跳过\n", mode_names[mode]);
+            continue;
+        }
+
+        compare_fn_t mode_compare = mode == 0 ? compare : NULL;
+        simd_set_feature_mask(mode_masks[mode]);
+        void* result = NULL;
+        int wrong = 0;
+
+        long long start_time = get_current_time_ms_high_precision();
+        for (int r = 0; r < REPEAT; r++) {
+            wrong |= algo_search(begin, end, pattern_begin, pattern_end, mode_compare, &result) != CSTL_ERROR_NOT_FOUND;
+        }
+        long long search_time = get_current_time_ms_high_precision() - start_time;
+
+        start_time = get_current_time_ms_high_precision();
+        for (int r = 0; r < REPEAT; r++) {
+            wrong |= algo_find_end(begin, end, pattern_begin, pattern_end, mode_compare, &result) != CSTL_ERROR_NOT_FOUND;
+        }
+        long long find_end_time = get_current_time_ms_high_precision() - start_time;
+
+        fprintf(log_file, "    %-12s search %7lld ms   find_end %7lld ms\n", mode_names[mode], search_time, find_end_time);
+        printf("    %-12s search %7lld ms   find_end %7lld ms\n", mode_names[mode], search_time, find_end_time);
+
+        if (wrong) {
+            fprintf(log_file, "    错误: 结果不正确!\n");
+            printf("    错误: 结果不正确!\n");
+        }
+    }
+
+    simd_set_feature_mask(~0u);
+    iterator_destroy(begin);
+    iterator_destroy(end);
+    iterator_destroy(pattern_begin);
+    iterator_destroy(pattern_end);
+}
+
+/**
+ * @brief 测试字节数据中不同长度的模式
+ *
+ * @param log_file 日志文件
+ */
+static void test_bytes(FILE* log_file) {
+    vector_t* data = vector_create(sizeof(unsigned char), NUM_ELEMENTS, NULL, NULL);
+    vector_t* pattern = vector_create(sizeof(unsigned char), 0, NULL, NULL);
+    if (data == NULL || pattern == NULL) {
+        printf("错误: 无法创建测试数据\n");
+        vector_destroy(data);
+        vector_destroy(pattern);
+        return;
+    }
+
+    // 数据取1..255，不包含0
+    vector_resize(data, NUM_ELEMENTS);
+    unsigned char* bytes = (unsigned char*)data->data;
+    for (size_t i = 0; i < NUM_ELEMENTS; i++) {
+        bytes[i] = (unsigned char)random_int64(1, 255);
+    }
+
+    fprintf(log_file, "--- 字节数据: %d 个元素, 重复 %d 次 ---\n", NUM_ELEMENTS, REPEAT);
+    printf("--- 字节数据: %d 个元素, 重复 %d 次 ---\n", NUM_ELEMENTS, REPEAT);
+
+    for (int i = 0; i < NUM_LENGTHS; i++) {
+        char label[64];
+        fill_pattern(pattern, pattern_lengths[i]);
+        snprintf(label, sizeof(label), "模式长度: %zu 字节", pattern_lengths[i]);
+        test_pattern(log_file, label, data, pattern, compare_u8);
+    }
+
+    fprintf(log_file, "\n");
+    printf("\n");
+
+    vector_destroy(data);
+    vector_destroy(pattern);
+}
+
+/**
+ * @brief 测试int16音频采样中的同步字搜索
+ *
+ * @param log_file 日志文件
+ */
+static void test_samples(FILE* log_file) {
+    vector_t* data = vector_create(sizeof(int16_t), NUM_ELEMENTS, NULL, NULL);
+    vector_t* pattern = vector_create(sizeof(int16_t), 0, NULL, NULL);
+    if (data == NULL || pattern == NULL) {
+        printf("错误: 无法创建测试数据\n");
+        vector_destroy(data);
+        vector_destroy(pattern);
+        return;
+    }
+
+    // 采样取-16000..16000，同步字使用范围外的值
+    vector_resize(data, NUM_ELEMENTS);
+    int16_t* samples = (int16_t*)data->data;
+    for (size_t i = 0; i < NUM_ELEMENTS; i++) {
+        samples[i] = (int16_t)random_int64(-16000, 16000);
+    }
+    const int16_t sync_word[4] = {0x7FFF, -32768, 0x7FFF, -32768};
+    for (int i = 0; i < 4; i++) {
+        vector_push_back(pattern, &sync_word[i]);
+    }
+
+    fprintf(log_file, "--- int16采样: %d 个元素, 重复 %d 次 ---\n", NUM_ELEMENTS, REPEAT);
+    printf("--- int16采样: %d 个元素, 重复 %d 次 ---\n", NUM_ELEMENTS, REPEAT);
+    test_pattern(log_file, "同步字: 4 个采样", data, pattern, compare_i16);
+    fprintf(log_file, "\n");
+    printf("\n");
+
+    vector_destroy(data);
+    vector_destroy(pattern);
+}
+
+/**
+ * @brief 运行完整的性能测试
+ */
+void run_performance_tests() {
+    FILE* log_file = fopen(LOG_FILE, "a");
+    if (log_file == NULL) {
+        printf("无法打开日志文件 %s\n", LOG_FILE);
+        return;
+    }
+
+    unsigned int features = simd_cpu_features();
+    fprintf(log_file, "\n=== 子序列搜索性能测试报告 ===\n");
+    fprintf(log_file, "测试时间: %s", ctime(&(time_t){time(NULL)}));
+    fprintf(log_file, "CPU特性: SSE2 %s, AVX2 %s\n\n",
+            (features & SIMD_FEATURE_SSE2) ? "支持" : "不支持",
+            (features & SIMD_FEATURE_AVX2) ? "支持" : "不支持");
+
+    printf("开始子序列搜索性能测试...\n");
+    printf("结果将保存到 %s\n\n", LOG_FILE);
+
+    test_bytes(log_file);
+    test_samples(log_file);
+
+    fprintf(log_file, "=== 测试完成 ===\n\n");
+    printf("=== 测试完成 ===\n");
+
+    fclose(log_file);
+}
+
+/**
+ * @brief 显示帮助信息
+ */
+void show_help() {
+    printf("子序列搜索性能测试程序\n");
+    printf("用法: ./pattern_search_performance_test [选项]\n");
+    printf("选项:\n");
+    printf("  -h, --help     显示帮助信息\n");
+    printf("  -r, --run      运行性能测试\n");
+    printf("  -c, --clear    清空日志文件\n");
+    printf("\n");
+    printf("  测试结果将保存到 %s 文件中\n", LOG_FILE);
+}
+
+/**
+ * @brief 主函数
+ *
+ * @param argc 参数个数
+ * @param argv 参数数组
+ * @return int 程序退出码
+ */
+int main(int argc, char* argv[]) {
+    srand((unsigned int)time(NULL));
+
+    if (argc < 2) {
+        show_help();
+        return 0;
+    }
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-h") == 0 || strcmp(argv[i], "--help") == 0) {
+            show_help();
+            return 0;
+        } else if (strcmp(argv[i], "-r") == 0 || strcmp(argv[i], "--run") == 0) {
+            run_performance_tests();
+            return 0;
+        } else if (strcmp(argv[i], "-c") == 0 || strcmp(argv[i], "--clear") == 0) {
+            FILE* log_file = fopen(LOG_FILE, "w");
+            if (log_file) {
+                fclose(log_file);
+                printf("日志文件 %s 已清空\n", LOG_FILE);
+            }
+            return 0;
+        } else {
+            printf("未知选项: %s\n", argv[i]);
+            show_help();
+            return 1;
+        }
+    }
+
+    return 0;
+}
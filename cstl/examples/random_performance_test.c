@@ -0,0 +1,280 @@
+/**
+ * @file random_performance_test.c
+ * @brief 伪随机数与洗牌性能测试
+ * @version 0.1
+ * @date 2025-09-29
+ *
+ * @copyright Copyright (c) 2025
+ *
+ * 本文件测试以下内容：
+ * - 标准库rand()与xoshiro256**（rng_next / rng_bounded / rng_fill / rng_fill_double）的吞吐量
+ * - 打乱1000万个int64：rand()取模的Fisher-Yates、algo_shuffle_rng、algo_par_shuffle
+ * - 链表上的algo_shuffle（收集元素指针后O(n)交换）
+ *
+ * 每次洗牌后检查结果仍是原序列的排列。
+ * 使用utils中的高精度时间函数计算耗时，并将结果输出到日志文件中
+ */
+
+#include "cstl.h"
+#include "common/utils.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define LOG_FILE "random_performance.log"
+#define NUM_NUMBERS 100000000
+#define FILL_BYTES (256 * 1024 * 1024)
+#define NUM_ELEMENTS 10000000
+#define LIST_ELEMENTS 1000000
+
+/**
+ * @brief 输出一行测试结果
+ *
+ * @param log_file 日志文件
+ * @param name 测试名称
+ * @param elapsed 耗时（毫秒）
+ */
+static void report(FILE* log_file, const char* name, long long elapsed) {
+    fprintf(log_file, "  %-40s %8lld ms\n", name, elapsed);
+    printf("  %-40s %8lld ms\n", name, elapsed);
+}
+
+/**
+ * @brief 检查数组是否是0..count-1的排列
+ *
+ * @param data 数组
+ * @param count 元素数量
+ * @return int 是返回1，否则返回0
+ */
+static int is_identity_permutation(const int64_t* data, size_t count) {
+    unsigned char* seen = (unsigned char*)calloc(count, 1);
+    if (seen == NULL) {
+        return 0;
+    }
+    int valid = 1;
+    for (size_t i = 0; i < count && valid; i++) {
+        if (data[i] < 0 || (size_t)data[i] >= count || seen[data[i]]) {
+            valid = 0;
+        } else {
+            seen[data[i]] = 1;
+        }
+    }
+    free(seen);
+    return valid;
+}
+
+/**
+ * @brief 测试随机数生成吞吐量
+ *
+ * @param log_file 日志文件
+ */
+static void test_generators(FILE* log_file) {
+    fprintf(log_file, "--- 随机数生成 (%d 个) ---\n", NUM_NUMBERS);
+    printf("--- 随机数生成 (%d 个) ---\n", NUM_NUMBERS);
+
+    volatile uint64_t sink = 0;
+    rng_t rng;
+    rng_seed(&rng, (uint64_t)time(NULL));
+
+    long long start_time = get_current_time_ms_high_precision();
+    for (int i = 0; i < NUM_NUMBERS; i++) {
+        sink += (uint64_t)rand();
+    }
+    report(log_file, "rand()", get_current_time_ms_high_precision() - start_time);
+
+    start_time = get_current_time_ms_high_precision();
+    for (int i = 0; i < NUM_NUMBERS; i++) {
+        sink += rng_next(&rng);
+    }
+    report(log_file, "rng_next", get_current_time_ms_high_precision() - start_time);
+
+    start_time = get_current_time_ms_high_precision();
+    for (int i = 0; i < NUM_NUMBERS; i++) {
+        sink += rng_bounded(&rng, 1000003);
+    }
+    report(log_file, "rng_bounded(1000003)", get_current_time_ms_high_precision() - start_time);
+
+    unsigned char* bytes = (unsigned char*)malloc(FILL_BYTES);
+    if (bytes != NULL) {
+        start_time = get_current_time_ms_high_precision();
+        rng_fill(&rng, bytes, FILL_BYTES);
+        long long elapsed = get_current_time_ms_high_precision() - start_time;
+        sink += bytes[FILL_BYTES - 1];
+        report(log_file, "rng_fill (256 MB)", elapsed);
+        free(bytes);
+    }
+
+    double* doubles = (double*)malloc(NUM_ELEMENTS * sizeof(double));
+    if (doubles != NULL) {
+        start_time = get_current_time_ms_high_precision();
+        rng_fill_double(&rng, doubles, NUM_ELEMENTS);
+        long long elapsed = get_current_time_ms_high_precision() - start_time;
+        sink += (uint64_t)(doubles[NUM_ELEMENTS - 1] * 1000.0);
+        report(log_file, "rng_fill_double (1000万个)", elapsed);
+        free(doubles);
+    }
+    (void)sink;
+
+    fprintf(log_file, "\n");
+    printf("\n");
+}
+
+/**
+ * @brief 测试向量与链表上的洗牌
+ *
+ * @param log_file 日志文件
+ */
+static void test_shuffle(FILE* log_file) {
+    fprintf(log_file, "--- 洗牌 (%d 个int64) ---\n", NUM_ELEMENTS);
+    printf("--- 洗牌 (%d 个int64) ---\n", NUM_ELEMENTS);
+
+    int64_t* array = (int64_t*)malloc(NUM_ELEMENTS * sizeof(int64_t));
+    vector_t* vec = vector_create(sizeof(int64_t), NUM_ELEMENTS, NULL, NULL);
+    if (array == NULL || vec == NULL) {
+        printf("错误: 无法创建测试数据\n");
+        free(array);
+        vector_destroy(vec);
+        return;
+    }
+    for (int64_t i = 0; i < NUM_ELEMENTS; i++) {
+        array[i] = i;
+        vector_push_back(vec, &i);
+    }
+
+    // rand()取模的Fisher-Yates，有取模偏差且RAND_MAX可能很小
+    long long start_time = get_current_time_ms_high_precision();
+    for (size_t i = NUM_ELEMENTS - 1; i > 0; i--) {
+        size_t r = ((size_t)rand() << 31) ^ (size_t)rand();
+        size_t j = r % (i + 1);
+        int64_t temp = array[i];
+        array[i] = array[j];
+        array[j] = temp;
+    }
+    report(log_file, "rand()取模 Fisher-Yates", get_current_time_ms_high_precision() - start_time);
+
+    rng_t rng;
+    rng_seed(&rng, (uint64_t)time(NULL));
+    iterator_t* begin = vector_begin(vec);
+    iterator_t* end = vector_end(vec);
+    void* data = NULL;
+    vector_at(vec, 0, &data);
+
+    start_time = get_current_time_ms_high_precision();
+    algo_shuffle_rng(begin, end, &rng);
+    report(log_file, "algo_shuffle_rng", get_current_time_ms_high_precision() - start_time);
+    if (!is_identity_permutation((const int64_t*)data, NUM_ELEMENTS)) {
+        printf("错误: algo_shuffle_rng 的结果不是排列\n");
+    }
+
+    start_time = get_current_time_ms_high_precision();
+    algo_par_shuffle(begin, end, &rng, 0);
+    report(log_file, "algo_par_shuffle", get_current_time_ms_high_precision() - start_time);
+    if (!is_identity_permutation((const int64_t*)data, NUM_ELEMENTS)) {
+        printf("错误: algo_par_shuffle 的结果不是排列\n");
+    }
+
+    iterator_destroy(begin);
+    iterator_destroy(end);
+    free(array);
+    vector_destroy(vec);
+
+    list_t* list = list_create(sizeof(int64_t), NULL, NULL);
+    if (list != NULL) {
+        for (int64_t i = 0; i < LIST_ELEMENTS; i++) {
+            list_push_back(list, &i);
+        }
+        begin = list_begin(list);
+        end = list_end(list);
+        start_time = get_current_time_ms_high_precision();
+        algo_shuffle(begin, end);
+        char name[64];
+        snprintf(name, sizeof(name), "algo_shuffle 链表 (%d 个)", LIST_ELEMENTS);
+        report(log_file, name, get_current_time_ms_high_precision() - start_time);
+        iterator_destroy(begin);
+        iterator_destroy(end);
+        list_destroy(list);
+    }
+
+    fprintf(log_file, "\n");
+    printf("\n");
+}
+
+/**
+ * @brief 运行完整的性能测试
+ */
+void run_performance_tests() {
+    FILE* log_file = fopen(LOG_FILE, "a");
+    if (log_file == NULL) {
+        printf("无法打开日志文件 %s\n", LOG_FILE);
+        return;
+    }
+
+    fprintf(log_file, "\n=== 随机数与洗牌性能测试报告 ===\n");
+    fprintf(log_file, "测试时间: %s", ctime(&(time_t){time(NULL)}));
+    fprintf(log_file, "线程池工作线程数: %zu\n\n", thread_pool_size(thread_pool_default()));
+
+    printf("开始随机数与洗牌性能测试...\n");
+    printf("结果将保存到 %s\n\n", LOG_FILE);
+
+    test_generators(log_file);
+    test_shuffle(log_file);
+
+    fprintf(log_file, "=== 测试完成 ===\n\n");
+    printf("=== 测试完成 ===\n");
+
+    fclose(log_file);
+}
+
+/**
+ * @brief 显示帮助信息
+ */
+void show_help() {
+    printf("随机数与洗牌性能测试程序\n");
+    printf("用法: ./random_performance_test [选项]\n");
+    printf("选项:\n");
+    printf("  -h, --help     显示帮助信息\n");
+    printf("  -r, --run      运行性能测试\n");
+    printf("  -c, --clear    清空日志文件\n");
+    printf("\n");
+    printf("  测试结果将保存到 %s 文件中\n", LOG_FILE);
+}
+
+/**
+ * @brief 主函数
+ *
+ * @param argc 参数个数
+ * @param argv 参数数组
+ * @return int 程序退出码
+ */
+int main(int argc, char* argv[]) {
+    srand((unsigned int)time(NULL));
+
+    if (argc < 2) {
+        show_help();
+        return 0;
+    }
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-h") == 0 || strcmp(argv[i], "--help") == 0) {
+            show_help();
+            return 0;
+        } else if (strcmp(argv[i], "-r") == 0 || strcmp(argv[i], "--run") == 0) {
+            run_performance_tests();
+            return 0;
+        } else if (strcmp(argv[i], "-c") == 0 || strcmp(argv[i], "--clear") == 0) {
+            FILE* log_file = fopen(LOG_FILE, "w");
+            if (log_file) {
+                fclose(log_file);
+                printf("日志文件 %s 已清空\n", LOG_FILE);
+            }
+            return 0;
+        } else {
+            printf("未知选项: %s\n", argv[i]);
+            show_help();
+            return 1;
+        }
+    }
+
+    return 0;
+}
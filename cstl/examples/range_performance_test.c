@@ -0,0 +1,337 @@
+/**
+ * @file range_performance_test.c
+ * @brief 惰性范围管道性能测试
+ * @version 0.1
+ * @date 2025-10-02
+ *
+ * @copyright Copyright (c) 2025
+ *
+ * 本文件在int64向量上执行"过滤 -> 映射 -> 过滤 -> 求和"，对比以下方式：
+ * - 每一步用algo_copy_if / algo_transform生成中间向量，最后algo_for_each求和
+ * - range管道一趟完成，不产生中间向量
+ * - 手写循环（下限参考）
+ *
+ * 另外测试截取前若干个结果时管道提前停止的效果。
+ * 使用utils中的高精度时间函数计算耗时，并将结果输出到日志文件中
+ */
+
+#include "cstl.h"
+#include "common/utils.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define LOG_FILE "range_performance.log"
+#define NUM_ELEMENTS 10000000
+#define TAKE_COUNT 1000
+
+/**
+ * @brief for_each求和用的累加值
+ */
+static int64_t g_sum = 0;
+
+/**
+ * @brief 不能被3整除
+ *
+ * @param element 元素指针
+ * @return int 条件是否成立
+ */
+static int not_multiple_of_3(const void* element) {
+    return *(const int64_t*)element % 3 != 0;
+}
+
+/**
+ * @brief 偶数
+ *
+ * @param element 元素指针
+ * @return int 条件是否成立
+ */
+static int is_even(const void* element) {
+    return (*(const int64_t*)element & 1) == 0;
+}
+
+/**
+ * @brief 原地映射：x -> x * 7 + 1
+ *
+ * @param element 元素指针
+ */
+static void scale_in_place(void* element) {
+    int64_t* x = (int64_t*)element;
+    *x = *x * 7 + 1;
+}
+
+/**
+ * @brief 管道映射：x -> x * 7 + 1
+ *
+ * @param input 输入元素指针
+ * @param output 输出元素指针
+ */
+static void scale_map(const void* input, void* output) {
+    *(int64_t*)output = *(const int64_t*)input * 7 + 1;
+}
+
+/**
+ * @brief 累加到g_sum
+ *
+ * @param element 元素指针
+ */
+static void accumulate_global(void* element) {
+    g_sum += *(const int64_t*)element;
+}
+
+/**
+ * @brief 归约：a += b
+ *
+ * @param a 累加值指针
+ * @param b 元素指针
+ */
+static void add_int64(void* a, const void* b) {
+    *(int64_t*)a += *(const int64_t*)b;
+}
+
+/**
+ * @brief 输出一行测试结果
+ *
+ * @param log_file 日志文件
+ * @param name 测试名称
+ * @param elapsed 耗时（毫秒）
+ * @param sum 计算结果
+ */
+static void report(FILE* log_file, const char* name, long long elapsed, int64_t sum) {
+    fprintf(log_file, "  %-32s %8lld ms  结果 %lld\n", name, elapsed, (long long)sum);
+    printf("  %-32s %8lld ms  结果 %lld\n", name, elapsed, (long long)sum);
+}
+
+/**
+ * @brief 每一步生成中间向量
+ *
+ * @param source 源向量
+ * @param take 最多保留的结果数量，0表示不限
+ * @return int64_t 结果之和
+ */
+static int64_t run_materialized(vector_t* source, size_t take) {
+    vector_t* filtered = vector_create(sizeof(int64_t), 0, NULL, NULL);
+    vector_t* mapped = vector_create(sizeof(int64_t), 0, NULL, NULL);
+    vector_t* result = vector_create(sizeof(int64_t), 0, NULL, NULL);
+    int64_t sum = 0;
+    if (filtered == NULL || mapped == NULL || result == NULL) {
+        vector_destroy(filtered);
+        vector_destroy(mapped);
+        vector_destroy(result);
+        return 0;
+    }
+
+    size_t count = 0;
+    vector_resize(filtered, source->size);
+    iterator_t* begin = vector_begin(source);
+    iterator_t* end = vector_end(source);
+    iterator_t* dest = vector_begin(filtered);
+    algo_copy_if(begin, end, dest, not_multiple_of_3, &count);
+    vector_resize(filtered, count);
+    iterator_destroy(begin);
+    iterator_destroy(end);
+    iterator_destroy(dest);
+
+    vector_resize(mapped, filtered->size);
+    begin = vector_begin(filtered);
+    end = vector_end(filtered);
+    dest = vector_begin(mapped);
+    algo_transform(begin, end, dest, scale_in_place, &count);
+    iterator_destroy(begin);
+    iterator_destroy(end);
+    iterator_destroy(dest);
+
+    vector_resize(result, mapped->size);
+    begin = vector_begin(mapped);
+    end = vector_end(mapped);
+    dest = vector_begin(result);
+    algo_copy_if(begin, end, dest, is_even, &count);
+    vector_resize(result, take != 0 && take < count ? take : count);
+    iterator_destroy(begin);
+    iterator_destroy(end);
+    iterator_destroy(dest);
+
+    g_sum = 0;
+    begin = vector_begin(result);
+    end = vector_end(result);
+    algo_for_each(begin, end, accumulate_global);
+    sum = g_sum;
+    iterator_destroy(begin);
+    iterator_destroy(end);
+
+    vector_destroy(filtered);
+    vector_destroy(mapped);
+    vector_destroy(result);
+    return sum;
+}
+
+/**
+ * @brief 用range管道一趟完成
+ *
+ * @param source 源向量
+ * @param take 最多保留的结果数量，0表示不限
+ * @return int64_t 结果之和
+ */
+static int64_t run_pipeline(vector_t* source, size_t take) {
+    iterator_t* begin = vector_begin(source);
+    iterator_t* end = vector_end(source);
+    range_t range;
+    int64_t sum = 0;
+
+    range_init(&range, begin, end);
+    range_filter(&range, not_multiple_of_3);
+    range_map(&range, scale_map, sizeof(int64_t));
+    range_filter(&range, is_even);
+    if (take != 0) {
+        range_take(&range, take);
+    }
+    if (range_reduce(&range, add_int64, &sum) != CSTL_OK) {
+        printf("错误: 管道执行失败\n");
+    }
+
+    iterator_destroy(begin);
+    iterator_destroy(end);
+    return sum;
+}
+
+/**
+ * @brief 手写循环
+ *
+ * @param source 源向量
+ * @param take 最多保留的结果数量，0表示不限
+ * @return int64_t 结果之和
+ */
+static int64_t run_loop(vector_t* source, size_t take) {
+    const int64_t* data = (const int64_t*)source->data;
+    size_t taken = 0;
+    int64_t sum = 0;
+    for (size_t i = 0; i < source->size; i++) {
+        if (data[i] % 3 == 0) {
+            continue;
+        }
+        int64_t x = data[i] * 7 + 1;
+        if (x & 1) {
+            continue;
+        }
+        sum += x;
+        if (++taken == take) {
+            break;
+        }
+    }
+    return sum;
+}
+
+/**
+ * @brief 运行完整的性能测试
+ */
+void run_performance_tests() {
+    FILE* log_file = fopen(LOG_FILE, "a");
+    if (log_file == NULL) {
+        printf("无法打开日志文件 %s\n", LOG_FILE);
+        return;
+    }
+
+    vector_t* source = vector_create(sizeof(int64_t), NUM_ELEMENTS, NULL, NULL);
+    if (source == NULL) {
+        printf("错误: 无法创建测试数据\n");
+        fclose(log_file);
+        return;
+    }
+    for (int i = 0; i < NUM_ELEMENTS; i++) {
+        int64_t value = random_int64(-1000000, 1000000);
+        vector_push_back(source, &value);
+    }
+
+    fprintf(log_file, "\n=== 惰性范围管道性能测试报告 ===\n");
+    fprintf(log_file, "测试时间: %s", ctime(&(time_t){time(NULL)}));
+    fprintf(log_file, "元素数量: %d\n\n", NUM_ELEMENTS);
+
+    printf("开始惰性范围管道性能测试...\n");
+    printf("结果将保存到 %s\n\n", LOG_FILE);
+
+    const size_t takes[2] = {0, TAKE_COUNT};
+    for (int t = 0; t < 2; t++) {
+        if (takes[t] == 0) {
+            fprintf(log_file, "--- 过滤 -> 映射 -> 过滤 -> 求和 ---\n");
+            printf("--- 过滤 -> 映射 -> 过滤 -> 求和 ---\n");
+        } else {
+            fprintf(log_file, "--- 只取前 %zu 个结果 ---\n", takes[t]);
+            printf("--- 只取前 %zu 个结果 ---\n", takes[t]);
+        }
+
+        long long start_time = get_current_time_ms_high_precision();
+        int64_t sum = run_materialized(source, takes[t]);
+        report(log_file, "中间向量 (copy_if/transform)", get_current_time_ms_high_precision() - start_time, sum);
+
+        start_time = get_current_time_ms_high_precision();
+        sum = run_pipeline(source, takes[t]);
+        report(log_file, "range管道", get_current_time_ms_high_precision() - start_time, sum);
+
+        start_time = get_current_time_ms_high_precision();
+        sum = run_loop(source, takes[t]);
+        report(log_file, "手写循环", get_current_time_ms_high_precision() - start_time, sum);
+
+        fprintf(log_file, "\n");
+        printf("\n");
+    }
+
+    fprintf(log_file, "=== 测试完成 ===\n\n");
+    printf("=== 测试完成 ===\n");
+
+    vector_destroy(source);
+    fclose(log_file);
+}
+
+/**
+ * @brief 显示帮助信息
+ */
+void show_help() {
+    printf("惰性范围管道性能测试程序\n");
+    printf("用法: ./range_performance_test [选项]\n");
+    printf("选项:\n");
+    printf("  -h, --help     显示帮助信息\n");
+    printf("  -r, --run      运行性能测试\n");
+    printf("  -c, --clear    清空日志文件\n");
+    printf("\n");
+    printf("  测试结果将保存到 %s 文件中\n", LOG_FILE);
+}
+
+/**
+ * @brief 主函数
+ *
+ * @param argc 参数个数
+ * @param argv 参数数组
+ * @return int 程序退出码
+ */
+int main(int argc, char* argv[]) {
+    srand((unsigned int)time(NULL));
+
+    if (argc < 2) {
+        show_help();
+        return 0;
+    }
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-h") == 0 || strcmp(argv[i], "--help") == 0) {
+            show_help();
+            return 0;
+        } else if (strcmp(argv[i], "-r") == 0 || strcmp(argv[i], "--run") == 0) {
+            run_performance_tests();
+            return 0;
+        } else if (strcmp(argv[i], "-c") == 0 || strcmp(argv[i], "--clear") == 0) {
+            FILE* log_file = fopen(LOG_FILE, "w");
+            if (log_file) {
+                fclose(log_file);
+                printf("日志文件 %s 已清空\n", LOG_FILE);
+            }
+            return 0;
+        } else {
+            printf("未知选项: %s\n", argv[i]);
+            show_help();
+            return 1;
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,365 @@
+/**
+ * @file remove_performance_test.c
+ * @brief 批量移除性能测试
+ * @version 0.1
+ * @date 2025-09-27
+ *
+ * @copyright Copyright (c) 2025
+ *
+ * 本文件测试从容器中移除一半元素的耗时，对比以下方式：
+ * - 逐个调用 vector_erase（每次memmove剩余元素，O(n^2)，只在较小规模上测试）
+ * - algo_remove_copy_if 复制到另一个向量
+ * - vector_remove_if / vector_remove 原地单次遍历压缩
+ * - list_remove_if
+ *
+ * 另外统计移除过程中析构函数的调用次数，确认每个被移除的元素都被析构；
+ * vector_remove的value指向向量中拥有资源的元素时，比较过程不能访问已经释放的资源。
+ * 使用utils中的高精度时间函数计算耗时，并将结果输出到日志文件中
+ */
+
+#include "cstl.h"
+#include "common/utils.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define LOG_FILE "remove_performance.log"
+#define NUM_ELEMENTS 10000000
+#define ERASE_ELEMENTS 100000
+#define LIST_ELEMENTS 1000000
+
+// 析构函数调用次数
+static size_t destroyed_count = 0;
+
+/**
+ * @brief 统计调用次数的析构函数
+ *
+ * @param data 元素指针
+ */
+static void count_destructor(void* data) {
+    (void)data;
+    destroyed_count++;
+}
+
+/**
+ * @brief 释放字符串元素并统计调用次数的析构函数
+ *
+ * @param data 元素指针，元素是char*
+ */
+static void free_string_destructor(void* data) {
+    free(*(char**)data);
+    destroyed_count++;
+}
+
+/**
+ * @brief 比较两个字符串元素
+ *
+ * @param a 元素指针，元素是char*
+ * @param b 元素指针，元素是char*
+ * @return int 比较结果
+ */
+static int compare_string(const void* a, const void* b) {
+    return strcmp(*(char* const*)a, *(char* const*)b);
+}
+
+/**
+ * @brief 判断元素是否为偶数
+ *
+ * @param element 元素指针
+ * @return int 偶数返回1
+ */
+static int is_even(const void* element) {
+    return (*(const int*)element & 1) == 0;
+}
+
+/**
+ * @brief 判断元素是否为奇数
+ *
+ * @param element 元素指针
+ * @return int 奇数返回1
+ */
+static int is_odd(const void* element) {
+    return (*(const int*)element & 1) != 0;
+}
+
+/**
+ * @brief 创建随机整数向量
+ *
+ * @param count 元素数量
+ * @param destructor 析构函数
+ * @return vector_t* 向量指针
+ */
+static vector_t* create_random_vector(size_t count, destructor_fn_t destructor) {
+    vector_t* vec = vector_create(sizeof(int), count, NULL, destructor);
+    if (vec == NULL) {
+        return NULL;
+    }
+    vector_resize(vec, count);
+    int* data = (int*)vec->data;
+    for (size_t i = 0; i < count; i++) {
+        data[i] = (int)random_int64(0, 1000000);
+    }
+    return vec;
+}
+
+/**
+ * @brief 检查向量中不再包含偶数
+ *
+ * @param vec 向量指针
+ * @return int 正确返回1
+ */
+static int check_no_even(const vector_t* vec) {
+    const int* data = (const int*)vec->data;
+    for (size_t i = 0; i < vec->size; i++) {
+        if (is_even(&data[i])) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+/**
+ * @brief 输出一行测试结果
+ *
+ * @param log_file 日志文件
+ * @param name 测试名称
+ * @param count 元素数量
+ * @param elapsed 耗时（毫秒）
+ * @param ok 结果是否正确
+ */
+static void report(FILE* log_file, const char* name, size_t count, long long elapsed, int ok) {
+    fprintf(log_file, "  %-28s %9zu 个元素 %7lld ms %s\n", name, count, elapsed, ok ? "" : "错误: 结果不正确!");
+    printf("  %-28s %9zu 个元素 %7lld ms %s\n", name, count, elapsed, ok ? "" : "错误: 结果不正确!");
+}
+
+/**
+ * @brief 测试向量的各种移除方式
+ *
+ * @param log_file 日志文件
+ */
+static void test_vector(FILE* log_file) {
+    fprintf(log_file, "--- 向量：移除约50%%的元素 ---\n");
+    printf("--- 向量：移除约50%%的元素 ---\n");
+
+    // 逐个erase
+    vector_t* vec = create_random_vector(ERASE_ELEMENTS, NULL);
+    if (vec == NULL) {
+        printf("错误: 无法创建测试数据\n");
+        return;
+    }
+    long long start_time = get_current_time_ms_high_precision();
+    size_t i = 0;
+    while (i < vec->size) {
+        if (is_even((int*)vec->data + i)) {
+            vector_erase(vec, i);
+        } else {
+            i++;
+        }
+    }
+    report(log_file, "逐个vector_erase", ERASE_ELEMENTS, get_current_time_ms_high_precision() - start_time,
+           check_no_even(vec));
+    vector_destroy(vec);
+
+    // 复制到另一个向量
+    vec = create_random_vector(NUM_ELEMENTS, NULL);
+    vector_t* dest = vector_create(sizeof(int), NUM_ELEMENTS, NULL, NULL);
+    if (vec == NULL || dest == NULL) {
+        printf("错误: 无法创建测试数据\n");
+        vector_destroy(vec);
+        vector_destroy(dest);
+        return;
+    }
+    vector_resize(dest, NUM_ELEMENTS);
+    iterator_t* begin = vector_begin(vec);
+    iterator_t* end = vector_end(vec);
+    iterator_t* dest_begin = vector_begin(dest);
+    size_t kept = 0;
+    start_time = get_current_time_ms_high_precision();
+    // algo_remove_copy_if复制满足谓词的元素，这里保留奇数
+    algo_remove_copy_if(begin, end, dest_begin, is_odd, &kept);
+    vector_resize(dest, kept);
+    report(log_file, "algo_remove_copy_if", NUM_ELEMENTS, get_current_time_ms_high_precision() - start_time,
+           check_no_even(dest));
+    iterator_destroy(begin);
+    iterator_destroy(end);
+    iterator_destroy(dest_begin);
+    vector_destroy(vec);
+    vector_destroy(dest);
+
+    // 原地压缩
+    vec = create_random_vector(NUM_ELEMENTS, count_destructor);
+    if (vec == NULL) {
+        printf("错误: 无法创建测试数据\n");
+        return;
+    }
+    size_t expected = 0;
+    for (i = 0; i < NUM_ELEMENTS; i++) {
+        expected += is_even((int*)vec->data + i);
+    }
+    destroyed_count = 0;
+    start_time = get_current_time_ms_high_precision();
+    vector_remove_if(vec, is_even);
+    report(log_file, "vector_remove_if", NUM_ELEMENTS, get_current_time_ms_high_precision() - start_time,
+           check_no_even(vec) && destroyed_count == expected && vec->size == NUM_ELEMENTS - expected);
+    vector_destroy(vec);
+
+    // 按值移除，数据一半为0
+    vec = create_random_vector(NUM_ELEMENTS, NULL);
+    if (vec == NULL) {
+        printf("错误: 无法创建测试数据\n");
+        return;
+    }
+    int* data = (int*)vec->data;
+    expected = 0;
+    for (i = 0; i < NUM_ELEMENTS; i++) {
+        if (data[i] & 1) {
+            data[i] = 0;
+        }
+        expected += data[i] == 0;
+    }
+    int zero = 0;
+    start_time = get_current_time_ms_high_precision();
+    vector_remove(vec, &zero, NULL);
+    report(log_file, "vector_remove（按位比较）", NUM_ELEMENTS, get_current_time_ms_high_precision() - start_time,
+           vec->size == NUM_ELEMENTS - expected);
+    vector_destroy(vec);
+
+    // 按值移除，value指向向量中的元素，元素拥有的字符串由析构函数释放
+    vec = vector_create(sizeof(char*), ERASE_ELEMENTS, NULL, free_string_destructor);
+    if (vec == NULL) {
+        printf("错误: 无法创建测试数据\n");
+        return;
+    }
+    expected = 0;
+    for (i = 0; i < ERASE_ELEMENTS; i++) {
+        char* text = (char*)malloc(8);
+        snprintf(text, 8, "%d", (int)random_int64(0, 1));
+        expected += strcmp(text, "0") == 0;
+        vector_push_back(vec, &text);
+    }
+    char* first = *(char**)vector_get_by_index(vec, 0);
+    if (strcmp(first, "0") != 0) {
+        expected = ERASE_ELEMENTS - expected;
+    }
+    destroyed_count = 0;
+    start_time = get_current_time_ms_high_precision();
+    vector_remove(vec, vector_get_by_index(vec, 0), compare_string);
+    report(log_file, "vector_remove（value在向量中）", ERASE_ELEMENTS,
+           get_current_time_ms_high_precision() - start_time,
+           destroyed_count == expected && vec->size == ERASE_ELEMENTS - expected);
+    vector_destroy(vec);
+
+    fprintf(log_file, "\n");
+    printf("\n");
+}
+
+/**
+ * @brief 测试链表的移除
+ *
+ * @param log_file 日志文件
+ */
+static void test_list(FILE* log_file) {
+    fprintf(log_file, "--- 链表：移除约50%%的元素 ---\n");
+    printf("--- 链表：移除约50%%的元素 ---\n");
+
+    list_t* list = list_create(sizeof(int), NULL, count_destructor);
+    if (list == NULL) {
+        printf("错误: 无法创建测试数据\n");
+        return;
+    }
+    size_t expected = 0;
+    for (size_t i = 0; i < LIST_ELEMENTS; i++) {
+        int value = (int)random_int64(0, 1000000);
+        expected += is_odd(&value);
+        list_push_back(list, &value);
+    }
+
+    destroyed_count = 0;
+    long long start_time = get_current_time_ms_high_precision();
+    list_remove_if(list, is_odd);
+    report(log_file, "list_remove_if", LIST_ELEMENTS, get_current_time_ms_high_precision() - start_time,
+           destroyed_count == expected && list_size(list) == LIST_ELEMENTS - expected);
+    list_destroy(list);
+
+    fprintf(log_file, "\n");
+    printf("\n");
+}
+
+/**
+ * @brief 运行完整的性能测试
+ */
+void run_performance_tests() {
+    FILE* log_file = fopen(LOG_FILE, "a");
+    if (log_file == NULL) {
+        printf("无法打开日志文件 %s\n", LOG_FILE);
+        return;
+    }
+
+    fprintf(log_file, "\n=== 批量移除性能测试报告 ===\n");
+    fprintf(log_file, "测试时间: %s\n", ctime(&(time_t){time(NULL)}));
+
+    printf("开始批量移除性能测试...\n");
+    printf("结果将保存到 %s\n\n", LOG_FILE);
+
+    test_vector(log_file);
+    test_list(log_file);
+
+    fprintf(log_file, "=== 测试完成 ===\n\n");
+    printf("=== 测试完成 ===\n");
+
+    fclose(log_file);
+}
+
+/**
+ * @brief 显示帮助信息
+ */
+void show_help() {
+    printf("批量移除性能测试程序\n");
+    printf("用法: ./remove_performance_test [选项]\n");
+    printf("选项:\n");
+    printf("  -h, --help     显示帮助信息\n");
+    printf("  -r, --run      运行性能测试\n");
+    printf("  -c, --clear    清空日志文件\n");
+    printf("\n");
+    printf("  测试结果将保存到 %s 文件中\n", LOG_FILE);
+}
+
+/**
+ * @brief 主函数
+ *
+ * @param argc 参数个数
+ * @param argv 参数数组
+ * @return int 程序退出码
+ */
+int main(int argc, char* argv[]) {
+    srand((unsigned int)time(NULL));
+
+    if (argc < 2) {
+        show_help();
+        return 0;
+    }
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-h") == 0 || strcmp(argv[i], "--help") == 0) {
+            show_help();
+            return 0;
+        } else if (strcmp(argv[i], "-r") == 0 || strcmp(argv[i], "--run") == 0) {
+            run_performance_tests();
+            return 0;
+        } else if (strcmp(argv[i], "-c") == 0 || strcmp(argv[i], "--clear") == 0) {
+            FILE* log_file = fopen(LOG_FILE, "w");
+            if (log_file) {
+                fclose(log_file);
+                printf("日志文件 %s 已清空\n", LOG_FILE);
+            }
+            return 0;
+        } else {
+            printf("未知选项: %s\n", argv[i]);
+            show_help();
+            return 1;
+        }
+    }
+
+    return 0;
+}
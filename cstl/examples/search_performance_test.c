@@ -0,0 +1,239 @@
+/**
+ * @file search_performance_test.c
+ * @brief 有序查找算法性能测试
+ * @version 0.1
+ * @date 2025-09-20
+ *
+ * @copyright Copyright (c) 2025
+ *
+ * 本文件对比以下三种有序查找方式的性能：
+ * - 按迭代器步进的经典二分查找（链表范围）
+ * - 连续内存上的无分支二分查找 (algo_lower_bound)
+ * - Eytzinger布局加预取的查找 (algo_eytzinger_lower_bound)
+ *
+ * 使用utils中的高精度时间函数计算耗时，并将结果输出到日志文件中
+ */
+
+#include "cstl.h"
+#include "common/utils.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define LOG_FILE "search_performance.log"
+#define TEST_SIZES 4
+#define NUM_QUERIES 1000000
+#define LIST_QUERIES 1000
+
+// 测试数据大小
+const size_t test_sizes[TEST_SIZES] = {1000, 100000, 1000000, 4000000};
+
+/**
+ * @brief int32_t比较函数
+ *
+ * @param a 第一个元素指针
+ * @param b 第二个元素指针
+ * @return int 比较结果
+ */
+static int compare_int32(const void* a, const void* b) {
+    int32_t x = *(const int32_t*)a;
+    int32_t y = *(const int32_t*)b;
+    return (x > y) - (x < y);
+}
+
+/**
+ * @brief 生成查询键
+ *
+ * @param count 查询数量
+ * @param max 键的最大值
+ * @return int32_t* 查询键数组
+ */
+static int32_t* generate_queries(size_t count, int32_t max) {
+    int32_t* queries = (int32_t*)malloc(count * sizeof(int32_t));
+    if (queries == NULL) {
+        return NULL;
+    }
+
+    for (size_t i = 0; i < count; i++) {
+        queries[i] = (int32_t)random_int64(0, max);
+    }
+
+    return queries;
+}
+
+/**
+ * @brief 测试一个数据规模
+ *
+ * @param log_file 日志文件
+ * @param size 元素数量
+ */
+static void test_size(FILE* log_file, size_t size) {
+    vector_t* vec = vector_create(sizeof(int32_t), size, NULL, NULL);
+    list_t* list = list_create(sizeof(int32_t), NULL, NULL);
+    int32_t* queries = generate_queries(NUM_QUERIES, (int32_t)(size * 2));
+    if (vec == NULL || list == NULL || queries == NULL) {
+        printf("错误: 无法创建测试数据\n");
+        vector_destroy(vec);
+        list_destroy(list);
+        free(queries);
+        return;
+    }
+
+    // 偶数键，查询中约一半命中
+    for (size_t i = 0; i < size; i++) {
+        int32_t value = (int32_t)(i * 2);
+        vector_push_back(vec, &value);
+        if (size <= 100000) {
+            list_push_back(list, &value);
+        }
+    }
+
+    iterator_t* begin = vector_begin(vec);
+    iterator_t* end = vector_end(vec);
+    size_t checksum_branchless = 0;
+    size_t checksum_eytzinger = 0;
+
+    // 无分支二分查找
+    long long start_time = get_current_time_ms_high_precision();
+    for (size_t i = 0; i < NUM_QUERIES; i++) {
+        size_t position = 0;
+        algo_lower_bound(begin, end, &queries[i], compare_int32, &position);
+        checksum_branchless += position;
+    }
+    long long branchless_time = get_current_time_ms_high_precision() - start_time;
+
+    // Eytzinger布局
+    start_time = get_current_time_ms_high_precision();
+    algo_eytzinger_t* layout = algo_eytzinger_create(begin, end, compare_int32);
+    long long build_time = get_current_time_ms_high_precision() - start_time;
+
+    start_time = get_current_time_ms_high_precision();
+    for (size_t i = 0; i < NUM_QUERIES && layout != NULL; i++) {
+        void* element = NULL;
+        algo_eytzinger_lower_bound(layout, &queries[i], &element, NULL);
+        checksum_eytzinger += element != NULL ? (size_t)(*(int32_t*)element / 2) : size;
+    }
+    long long eytzinger_time = get_current_time_ms_high_precision() - start_time;
+
+    fprintf(log_file, "--- 测试大小: %zu 元素, 查询 %d 次 ---\n", size, NUM_QUERIES);
+    fprintf(log_file, "  无分支二分查找: %lld ms\n", branchless_time);
+    fprintf(log_file, "  Eytzinger查找: %lld ms (构建 %lld ms)\n", eytzinger_time, build_time);
+    printf("--- 测试大小: %zu 元素, 查询 %d 次 ---\n", size, NUM_QUERIES);
+    printf("  无分支二分查找: %lld ms\n", branchless_time);
+    printf("  Eytzinger查找: %lld ms (构建 %lld ms)\n", eytzinger_time, build_time);
+
+    if (checksum_branchless != checksum_eytzinger) {
+        fprintf(log_file, "  错误: 两种查找结果不一致!\n");
+        printf("  错误: 两种查找结果不一致!\n");
+    }
+
+    // 链表上的经典二分查找，迭代器移动为O(n)，只运行少量查询
+    if (size <= 100000) {
+        iterator_t* lbegin = list_begin(list);
+        iterator_t* lend = list_end(list);
+
+        start_time = get_current_time_ms_high_precision();
+        for (size_t i = 0; i < LIST_QUERIES; i++) {
+            size_t position = 0;
+            algo_lower_bound(lbegin, lend, &queries[i], compare_int32, &position);
+        }
+        long long list_time = get_current_time_ms_high_precision() - start_time;
+
+        fprintf(log_file, "  链表步进二分查找: %lld ms (%d 次查询)\n", list_time, LIST_QUERIES);
+        printf("  链表步进二分查找: %lld ms (%d 次查询)\n", list_time, LIST_QUERIES);
+
+        iterator_destroy(lbegin);
+        iterator_destroy(lend);
+    }
+
+    fprintf(log_file, "\n");
+    printf("\n");
+
+    algo_eytzinger_destroy(layout);
+    iterator_destroy(begin);
+    iterator_destroy(end);
+    vector_destroy(vec);
+    list_destroy(list);
+    free(queries);
+}
+
+/**
+ * @brief 运行完整的性能测试
+ */
+void run_performance_tests() {
+    FILE* log_file = fopen(LOG_FILE, "a");
+    if (log_file == NULL) {
+        printf("无法打开日志文件 %s\n", LOG_FILE);
+        return;
+    }
+
+    fprintf(log_file, "\n=== 有序查找性能测试报告 ===\n");
+    fprintf(log_file, "测试时间: %s", ctime(&(time_t){time(NULL)}));
+    fprintf(log_file, "测试数据类型: int32_t\n\n");
+
+    printf("开始有序查找性能测试...\n");
+    printf("结果将保存到 %s\n\n", LOG_FILE);
+
+    for (int size_idx = 0; size_idx < TEST_SIZES; size_idx++) {
+        test_size(log_file, test_sizes[size_idx]);
+    }
+
+    fprintf(log_file, "=== 测试完成 ===\n\n");
+    printf("=== 测试完成 ===\n");
+
+    fclose(log_file);
+}
+
+/**
+ * @brief 显示帮助信息
+ */
+void show_help() {
+    printf("有序查找性能测试程序\n");
+    printf("用法: ./search_performance_test [选项]\n");
+    printf("选项:\n");
+    printf("  -h, --help     显示帮助信息\n");
+    printf("  -r, --run      运行性能测试\n");
+    printf("  -c, --clear    清空日志文件\n");
+    printf("\n");
+    printf("  测试结果将保存到 %s 文件中\n", LOG_FILE);
+}
+
+/**
+ * @brief 主函数
+ *
+ * @param argc 参数个数
+ * @param argv 参数数组
+ * @return int 程序退出码
+ */
+int main(int argc, char* argv[]) {
+    srand((unsigned int)time(NULL));
+
+    if (argc < 2) {
+        show_help();
+        return 0;
+    }
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-h") == 0 || strcmp(argv[i], "--help") == 0) {
+            show_help();
+            return 0;
+        } else if (strcmp(argv[i], "-r") == 0 || strcmp(argv[i], "--run") == 0) {
+            run_performance_tests();
+            return 0;
+        } else if (strcmp(argv[i], "-c") == 0 || strcmp(argv[i], "--clear") == 0) {
+            FILE* log_file = fopen(LOG_FILE, "w");
+            if (log_file) {
+                fclose(log_file);
+                printf("日志文件 %s 已清空\n", LOG_FILE);
+            }
+            return 0;
+        } else {
+            printf("未知选项: %s\n", argv[i]);
+            show_help();
+            return 1;
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,286 @@
+/**
+ * @file selection_performance_test.c
+ * @brief 选择算法性能测试
+ * @version 0.1
+ * @date 2025-09-21
+ *
+ * @copyright Copyright (c) 2025
+ *
+ * 本文件对比从大量数据中取前K个元素和取分位数时，以下方式的性能：
+ * - 完整排序 (algo_sort)
+ * - 部分排序 (algo_partial_sort)
+ * - 部分排序复制 (algo_partial_sort_copy)
+ * - 内省选择 (algo_nth_element)
+ * - 流式Top-K累加器 (algo_topk_t)
+ *
+ * 使用utils中的高精度时间函数计算耗时，并将结果输出到日志文件中
+ */
+
+#include "cstl.h"
+#include "common/utils.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define LOG_FILE "selection_performance.log"
+#define TEST_SIZES 3
+#define TOP_K 100
+
+// 测试数据大小
+const size_t test_sizes[TEST_SIZES] = {100000, 1000000, 10000000};
+
+/**
+ * @brief int32_t比较函数
+ *
+ * @param a 第一个元素指针
+ * @param b 第二个元素指针
+ * @return int 比较结果
+ */
+static int compare_int32(const void* a, const void* b) {
+    int32_t x = *(const int32_t*)a;
+    int32_t y = *(const int32_t*)b;
+    return (x > y) - (x < y);
+}
+
+/**
+ * @brief int32_t降序比较函数
+ *
+ * @param a 第一个元素指针
+ * @param b 第二个元素指针
+ * @return int 比较结果
+ */
+static int compare_int32_desc(const void* a, const void* b) {
+    return compare_int32(b, a);
+}
+
+/**
+ * @brief 用原始数据填充向量
+ *
+ * @param array 原始数据
+ * @param size 元素数量
+ * @return vector_t* 向量指针
+ */
+static vector_t* make_vector(const int32_t* array, size_t size) {
+    vector_t* vec = vector_create(sizeof(int32_t), size, NULL, NULL);
+    if (vec == NULL) {
+        return NULL;
+    }
+    vector_resize(vec, size);
+    memcpy(vec->data, array, size * sizeof(int32_t));
+    return vec;
+}
+
+/**
+ * @brief 获取向量中指定位置的迭代器
+ *
+ * @param vec 向量指针
+ * @param index 下标
+ * @return iterator_t* 迭代器指针
+ */
+static iterator_t* vector_iterator_at(vector_t* vec, size_t index) {
+    iterator_t* iter = vector_begin(vec);
+    for (size_t i = 0; i < index; i++) {
+        iterator_next(iter);
+    }
+    return iter;
+}
+
+/**
+ * @brief 输出一行测试结果
+ *
+ * @param log_file 日志文件
+ * @param name 测试名称
+ * @param elapsed 耗时
+ * @param value 结果值，用于校验
+ */
+static void report(FILE* log_file, const char* name, long long elapsed, int32_t value) {
+    fprintf(log_file, "  %-36s %6lld ms  (结果 %d)\n", name, elapsed, value);
+    printf("  %-36s %6lld ms  (结果 %d)\n", name, elapsed, value);
+}
+
+/**
+ * @brief 测试一个数据规模
+ *
+ * @param log_file 日志文件
+ * @param size 元素数量
+ */
+static void test_size(FILE* log_file, size_t size) {
+    int32_t* original = (int32_t*)malloc(size * sizeof(int32_t));
+    if (original == NULL) {
+        printf("错误: 无法生成测试数据\n");
+        return;
+    }
+    for (size_t i = 0; i < size; i++) {
+        original[i] = (int32_t)random_int64(0, INT32_MAX);
+    }
+
+    size_t percentile = size * 99 / 100;
+    fprintf(log_file, "--- 测试大小: %zu 元素, K = %d ---\n", size, TOP_K);
+    printf("--- 测试大小: %zu 元素, K = %d ---\n", size, TOP_K);
+
+    // 完整排序后取前K和P99
+    vector_t* vec = make_vector(original, size);
+    iterator_t* begin = vector_begin(vec);
+    iterator_t* end = vector_end(vec);
+    long long start_time = get_current_time_ms_high_precision();
+    algo_sort(begin, end, compare_int32_desc, SORT_QUICK);
+    long long elapsed = get_current_time_ms_high_precision() - start_time;
+    report(log_file, "完整排序 (algo_sort)", elapsed, ((int32_t*)vec->data)[TOP_K - 1]);
+    iterator_destroy(begin);
+    iterator_destroy(end);
+    vector_destroy(vec);
+
+    // 部分排序
+    vec = make_vector(original, size);
+    begin = vector_begin(vec);
+    end = vector_end(vec);
+    iterator_t* middle = vector_iterator_at(vec, TOP_K);
+    start_time = get_current_time_ms_high_precision();
+    algo_partial_sort(begin, middle, end, compare_int32_desc);
+    elapsed = get_current_time_ms_high_precision() - start_time;
+    report(log_file, "部分排序 (algo_partial_sort)", elapsed, ((int32_t*)vec->data)[TOP_K - 1]);
+    iterator_destroy(middle);
+    iterator_destroy(begin);
+    iterator_destroy(end);
+    vector_destroy(vec);
+
+    // 部分排序复制，输入保持不变
+    vec = make_vector(original, size);
+    vector_t* top = vector_create(sizeof(int32_t), TOP_K, NULL, NULL);
+    vector_resize(top, TOP_K);
+    begin = vector_begin(vec);
+    end = vector_end(vec);
+    iterator_t* top_begin = vector_begin(top);
+    iterator_t* top_end = vector_end(top);
+    start_time = get_current_time_ms_high_precision();
+    algo_partial_sort_copy(begin, end, top_begin, top_end, compare_int32_desc, NULL);
+    elapsed = get_current_time_ms_high_precision() - start_time;
+    report(log_file, "部分排序复制 (algo_partial_sort_copy)", elapsed, ((int32_t*)top->data)[TOP_K - 1]);
+
+    // 流式Top-K
+    algo_topk_t* topk = algo_topk_create(TOP_K, sizeof(int32_t), compare_int32);
+    start_time = get_current_time_ms_high_precision();
+    for (size_t i = 0; i < size; i++) {
+        algo_topk_push(topk, &original[i]);
+    }
+    algo_topk_result(topk, top_begin, NULL);
+    elapsed = get_current_time_ms_high_precision() - start_time;
+    report(log_file, "流式Top-K (algo_topk_push)", elapsed, ((int32_t*)top->data)[TOP_K - 1]);
+    algo_topk_destroy(topk);
+    iterator_destroy(top_begin);
+    iterator_destroy(top_end);
+    vector_destroy(top);
+    iterator_destroy(begin);
+    iterator_destroy(end);
+    vector_destroy(vec);
+
+    // 分位数：完整排序 vs nth_element
+    vec = make_vector(original, size);
+    begin = vector_begin(vec);
+    end = vector_end(vec);
+    start_time = get_current_time_ms_high_precision();
+    algo_sort(begin, end, compare_int32, SORT_QUICK);
+    elapsed = get_current_time_ms_high_precision() - start_time;
+    report(log_file, "P99 完整排序 (algo_sort)", elapsed, ((int32_t*)vec->data)[percentile]);
+    iterator_destroy(begin);
+    iterator_destroy(end);
+    vector_destroy(vec);
+
+    vec = make_vector(original, size);
+    begin = vector_begin(vec);
+    end = vector_end(vec);
+    iterator_t* nth = vector_iterator_at(vec, percentile);
+    start_time = get_current_time_ms_high_precision();
+    algo_nth_element(begin, nth, end, compare_int32);
+    elapsed = get_current_time_ms_high_precision() - start_time;
+    report(log_file, "P99 内省选择 (algo_nth_element)", elapsed, ((int32_t*)vec->data)[percentile]);
+    iterator_destroy(nth);
+    iterator_destroy(begin);
+    iterator_destroy(end);
+    vector_destroy(vec);
+
+    fprintf(log_file, "\n");
+    printf("\n");
+    free(original);
+}
+
+/**
+ * @brief 运行完整的性能测试
+ */
+void run_performance_tests() {
+    FILE* log_file = fopen(LOG_FILE, "a");
+    if (log_file == NULL) {
+        printf("无法打开日志文件 %s\n", LOG_FILE);
+        return;
+    }
+
+    fprintf(log_file, "\n=== 选择算法性能测试报告 ===\n");
+    fprintf(log_file, "测试时间: %s", ctime(&(time_t){time(NULL)}));
+    fprintf(log_file, "测试数据类型: int32_t\n\n");
+
+    printf("开始选择算法性能测试...\n");
+    printf("结果将保存到 %s\n\n", LOG_FILE);
+
+    for (int size_idx = 0; size_idx < TEST_SIZES; size_idx++) {
+        test_size(log_file, test_sizes[size_idx]);
+    }
+
+    fprintf(log_file, "=== 测试完成 ===\n\n");
+    printf("=== 测试完成 ===\n");
+
+    fclose(log_file);
+}
+
+/**
+ * @brief 显示帮助信息
+ */
+void show_help() {
+    printf("选择算法性能测试程序\n");
+    printf("用法: ./selection_performance_test [选项]\n");
+    printf("选项:\n");
+    printf("  -h, --help     显示帮助信息\n");
+    printf("  -r, --run      运行性能测试\n");
+    printf("  -c, --clear    清空日志文件\n");
+    printf("\n");
+    printf("  测试结果将保存到 %s 文件中\n", LOG_FILE);
+}
+
+/**
+ * @brief 主函数
+ *
+ * @param argc 参数个数
+ * @param argv 参数数组
+ * @return int 程序退出码
+ */
+int main(int argc, char* argv[]) {
+    srand((unsigned int)time(NULL));
+
+    if (argc < 2) {
+        show_help();
+        return 0;
+    }
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-h") == 0 || strcmp(argv[i], "--help") == 0) {
+            show_help();
+            return 0;
+        } else if (strcmp(argv[i], "-r") == 0 || strcmp(argv[i], "--run") == 0) {
+            run_performance_tests();
+            return 0;
+        } else if (strcmp(argv[i], "-c") == 0 || strcmp(argv[i], "--clear") == 0) {
+            FILE* log_file = fopen(LOG_FILE, "w");
+            if (log_file) {
+                fclose(log_file);
+                printf("日志文件 %s 已清空\n", LOG_FILE);
+            }
+            return 0;
+        } else {
+            printf("未知选项: %s\n", argv[i]);
+            show_help();
+            return 1;
+        }
+    }
+
+    return 0;
+}
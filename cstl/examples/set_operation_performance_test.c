@@ -0,0 +1,309 @@
+/**
+ * @file set_operation_performance_test.c
+ * @brief 有序范围集合运算性能测试
+ * @version 0.1
+ * @date 2025-09-30
+ *
+ * @copyright Copyright (c) 2025
+ *
+ * 本文件测试有序int64 ID列表上的集合运算，分为两种输入：
+ * - 平衡：两个列表各500万个元素
+ * - 倾斜：1000万个元素与1万个元素（1:1000）
+ *
+ * 对比逐元素比较的线性归并与 algo_set_intersection / algo_includes /
+ * algo_set_difference / algo_set_union / algo_merge（连续存储时使用指数搜索）。
+ * 另外对比64路有序向量的 algo_merge_k（败者树）与拼接后 qsort。
+ * 使用utils中的高精度时间函数计算耗时，并将结果输出到日志文件中
+ */
+
+#include "cstl.h"
+#include "common/utils.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define LOG_FILE "set_operation_performance.log"
+#define BALANCED_SIZE 5000000
+#define SKEWED_LARGE 10000000
+#define SKEWED_SMALL 10000
+#define MERGE_WAYS 64
+#define MERGE_WAY_SIZE 100000
+
+/**
+ * @brief int64比较函数
+ *
+ * @param a 第一个元素指针
+ * @param b 第二个元素指针
+ * @return int 比较结果
+ */
+static int compare_int64(const void* a, const void* b) {
+    int64_t x = *(const int64_t*)a;
+    int64_t y = *(const int64_t*)b;
+    return (x > y) - (x < y);
+}
+
+/**
+ * @brief 创建有序的随机ID向量
+ *
+ * @param count 元素数量
+ * @param max_id ID的最大值
+ * @return vector_t* 向量指针
+ */
+static vector_t* create_sorted_ids(size_t count, int64_t max_id) {
+    vector_t* vec = vector_create(sizeof(int64_t), count, NULL, NULL);
+    if (vec == NULL) {
+        return NULL;
+    }
+    for (size_t i = 0; i < count; i++) {
+        int64_t id = random_int64(0, max_id);
+        vector_push_back(vec, &id);
+    }
+    qsort(vec->data, count, sizeof(int64_t), compare_int64);
+    return vec;
+}
+
+/**
+ * @brief 逐元素比较的线性交集，作为对照
+ *
+ * @param a 第一个数组
+ * @param n1 第一个数组元素数量
+ * @param b 第二个数组
+ * @param n2 第二个数组元素数量
+ * @param out 输出数组
+ * @return size_t 输出的元素数量
+ */
+static size_t linear_intersection(const int64_t* a, size_t n1, const int64_t* b, size_t n2, int64_t* out) {
+    size_t i = 0, j = 0, k = 0;
+    while (i < n1 && j < n2) {
+        int c = compare_int64(&a[i], &b[j]);
+        if (c < 0) {
+            i++;
+        } else if (c > 0) {
+            j++;
+        } else {
+            out[k++] = a[i];
+            i++;
+            j++;
+        }
+    }
+    return k;
+}
+
+/**
+ * @brief 输出一行测试结果
+ *
+ * @param log_file 日志文件
+ * @param name 测试名称
+ * @param elapsed 耗时（毫秒）
+ * @param count 输出的元素数量
+ */
+static void report(FILE* log_file, const char* name, long long elapsed, size_t count) {
+    fprintf(log_file, "  %-32s %8lld ms  输出 %zu 个\n", name, elapsed, count);
+    printf("  %-32s %8lld ms  输出 %zu 个\n", name, elapsed, count);
+}
+
+/**
+ * @brief 测试一组输入上的各种集合运算
+ *
+ * @param log_file 日志文件
+ * @param title 输入描述
+ * @param n1 第一个列表元素数量
+ * @param n2 第二个列表元素数量
+ */
+static void test_pair(FILE* log_file, const char* title, size_t n1, size_t n2) {
+    fprintf(log_file, "--- %s (%zu 与 %zu 个) ---\n", title, n1, n2);
+    printf("--- %s (%zu 与 %zu 个) ---\n", title, n1, n2);
+
+    int64_t max_id = (int64_t)(n1 > n2 ? n1 : n2) * 4;
+    vector_t* a = create_sorted_ids(n1, max_id);
+    vector_t* b = create_sorted_ids(n2, max_id);
+    vector_t* out = vector_create(sizeof(int64_t), n1 + n2, NULL, NULL);
+    if (a == NULL || b == NULL || out == NULL) {
+        printf("错误: 无法创建测试数据\n");
+        vector_destroy(a);
+        vector_destroy(b);
+        vector_destroy(out);
+        return;
+    }
+    vector_resize(out, n1 + n2);
+
+    iterator_t* begin1 = vector_begin(a);
+    iterator_t* end1 = vector_end(a);
+    iterator_t* begin2 = vector_begin(b);
+    iterator_t* end2 = vector_end(b);
+    iterator_t* dest = vector_begin(out);
+    size_t count = 0;
+
+    long long start_time = get_current_time_ms_high_precision();
+    count = linear_intersection((const int64_t*)a->data, n1, (const int64_t*)b->data, n2, (int64_t*)out->data);
+    report(log_file, "线性归并交集", get_current_time_ms_high_precision() - start_time, count);
+    size_t expected = count;
+
+    start_time = get_current_time_ms_high_precision();
+    algo_set_intersection(begin1, end1, begin2, end2, dest, compare_int64, &count);
+    report(log_file, "algo_set_intersection", get_current_time_ms_high_precision() - start_time, count);
+    if (count != expected) {
+        printf("错误: 交集元素数量不一致\n");
+    }
+
+    int included = 0;
+    start_time = get_current_time_ms_high_precision();
+    algo_includes(begin1, end1, begin2, end2, compare_int64, &included);
+    report(log_file, "algo_includes", get_current_time_ms_high_precision() - start_time, (size_t)included);
+
+    start_time = get_current_time_ms_high_precision();
+    algo_set_difference(begin1, end1, begin2, end2, dest, compare_int64, &count);
+    report(log_file, "algo_set_difference", get_current_time_ms_high_precision() - start_time, count);
+
+    start_time = get_current_time_ms_high_precision();
+    algo_set_union(begin1, end1, begin2, end2, dest, compare_int64, &count);
+    report(log_file, "algo_set_union", get_current_time_ms_high_precision() - start_time, count);
+
+    start_time = get_current_time_ms_high_precision();
+    algo_merge(begin1, end1, begin2, end2, dest, compare_int64, &count);
+    report(log_file, "algo_merge", get_current_time_ms_high_precision() - start_time, count);
+
+    iterator_destroy(begin1);
+    iterator_destroy(end1);
+    iterator_destroy(begin2);
+    iterator_destroy(end2);
+    iterator_destroy(dest);
+    vector_destroy(a);
+    vector_destroy(b);
+    vector_destroy(out);
+
+    fprintf(log_file, "\n");
+    printf("\n");
+}
+
+/**
+ * @brief 测试多路归并
+ *
+ * @param log_file 日志文件
+ */
+static void test_merge_k(FILE* log_file) {
+    fprintf(log_file, "--- %d 路归并 (每路 %d 个) ---\n", MERGE_WAYS, MERGE_WAY_SIZE);
+    printf("--- %d 路归并 (每路 %d 个) ---\n", MERGE_WAYS, MERGE_WAY_SIZE);
+
+    vector_t* sources[MERGE_WAYS];
+    for (int s = 0; s < MERGE_WAYS; s++) {
+        sources[s] = create_sorted_ids(MERGE_WAY_SIZE, (int64_t)MERGE_WAYS * MERGE_WAY_SIZE);
+        if (sources[s] == NULL) {
+            printf("错误: 无法创建测试数据\n");
+            for (int i = 0; i < s; i++) {
+                vector_destroy(sources[i]);
+            }
+            return;
+        }
+    }
+
+    size_t total = (size_t)MERGE_WAYS * MERGE_WAY_SIZE;
+    vector_t* merged = vector_create(sizeof(int64_t), total, NULL, NULL);
+    vector_t* concatenated = vector_create(sizeof(int64_t), total, NULL, NULL);
+
+    long long start_time = get_current_time_ms_high_precision();
+    algo_merge_k(sources, MERGE_WAYS, merged, compare_int64);
+    report(log_file, "algo_merge_k (败者树)", get_current_time_ms_high_precision() - start_time, vector_size(merged));
+
+    start_time = get_current_time_ms_high_precision();
+    for (int s = 0; s < MERGE_WAYS; s++) {
+        size_t old_size = vector_size(concatenated);
+        vector_resize(concatenated, old_size + MERGE_WAY_SIZE);
+        memcpy((int64_t*)concatenated->data + old_size, sources[s]->data, MERGE_WAY_SIZE * sizeof(int64_t));
+    }
+    qsort(concatenated->data, total, sizeof(int64_t), compare_int64);
+    report(log_file, "拼接后 qsort", get_current_time_ms_high_precision() - start_time, vector_size(concatenated));
+
+    if (memcmp(merged->data, concatenated->data, total * sizeof(int64_t)) != 0) {
+        printf("错误: 多路归并结果与排序结果不一致\n");
+    }
+
+    for (int s = 0; s < MERGE_WAYS; s++) {
+        vector_destroy(sources[s]);
+    }
+    vector_destroy(merged);
+    vector_destroy(concatenated);
+
+    fprintf(log_file, "\n");
+    printf("\n");
+}
+
+/**
+ * @brief 运行完整的性能测试
+ */
+void run_performance_tests() {
+    FILE* log_file = fopen(LOG_FILE, "a");
+    if (log_file == NULL) {
+        printf("无法打开日志文件 %s\n", LOG_FILE);
+        return;
+    }
+
+    fprintf(log_file, "\n=== 有序范围集合运算性能测试报告 ===\n");
+    fprintf(log_file, "测试时间: %s\n", ctime(&(time_t){time(NULL)}));
+
+    printf("开始有序范围集合运算性能测试...\n");
+    printf("结果将保存到 %s\n\n", LOG_FILE);
+
+    test_pair(log_file, "平衡输入", BALANCED_SIZE, BALANCED_SIZE);
+    test_pair(log_file, "倾斜输入 1:1000", SKEWED_LARGE, SKEWED_SMALL);
+    test_merge_k(log_file);
+
+    fprintf(log_file, "=== 测试完成 ===\n\n");
+    printf("=== 测试完成 ===\n");
+
+    fclose(log_file);
+}
+
+/**
+ * @brief 显示帮助信息
+ */
+void show_help() {
+    printf("有序范围集合运算性能测试程序\n");
+    printf("用法: ./set_operation_performance_test [选项]\n");
+    printf("选项:\n");
+    printf("  -h, --help     显示帮助信息\n");
+    printf("  -r, --run      运行性能测试\n");
+    printf("  -c, --clear    清空日志文件\n");
+    printf("\n");
+    printf("  测试结果将保存到 %s 文件中\n", LOG_FILE);
+}
+
+/**
+ * @brief 主函数
+ *
+ * @param argc 参数个数
+ * @param argv 参数数组
+ * @return int 程序退出码
+ */
+int main(int argc, char* argv[]) {
+    srand((unsigned int)time(NULL));
+
+    if (argc < 2) {
+        show_help();
+        return 0;
+    }
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-h") == 0 || strcmp(argv[i], "--help") == 0) {
+            show_help();
+            return 0;
+        } else if (strcmp(argv[i], "-r") == 0 || strcmp(argv[i], "--run") == 0) {
+            run_performance_tests();
+            return 0;
+        } else if (strcmp(argv[i], "-c") == 0 || strcmp(argv[i], "--clear") == 0) {
+            FILE* log_file = fopen(LOG_FILE, "w");
+            if (log_file) {
+                fclose(log_file);
+                printf("日志文件 %s 已清空\n", LOG_FILE);
+            }
+            return 0;
+        } else {
+            printf("未知选项: %s\n", argv[i]);
+            show_help();
+            return 1;
+        }
+    }
+
+    return 0;
+}
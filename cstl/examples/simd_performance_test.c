@@ -0,0 +1,269 @@
+/**
+ * @file simd_performance_test.c
+ * @brief 按位比较查找算法性能测试
+ * @version 0.1
+ * @date 2025-09-24
+ *
+ * @copyright Copyright (c) 2025
+ *
+ * 本文件按元素宽度（1/2/4/8字节）对比以下方式的性能：
+ * - 逐元素调用比较函数的 algo_find / algo_count / algo_equal / algo_adjacent_find
+ * - 比较函数为NULL的按位比较模式，分别限制为标量、SSE2和AVX2内核
+ *
+ * 查找的值不在数据中，保证每次都扫描完整范围。
+ * 使用utils中的高精度时间函数计算耗时，并将结果输出到日志文件中
+ */
+
+#include "cstl.h"
+#include "common/utils.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define LOG_FILE "simd_performance.log"
+#define NUM_ELEMENTS 4000000
+#define REPEAT 10
+#define NUM_WIDTHS 4
+#define NUM_MODES 4
+
+// 元素宽度
+const size_t test_widths[NUM_WIDTHS] = {1, 2, 4, 8};
+
+// 测试模式名称，第一个是比较函数模式
+const char* mode_names[NUM_MODES] = {"比较函数", "按位-标量", "按位-SSE2", "按位-AVX2"};
+
+// 各模式对应的SIMD特性掩码
+const unsigned int mode_masks[NUM_MODES] = {~0u, 0, SIMD_FEATURE_SSE2, SIMD_FEATURE_SSE2 | SIMD_FEATURE_AVX2};
+
+/**
+ * @brief uint8_t比较函数
+ */
+static int compare_u8(const void* a, const void* b) {
+    return (int)*(const uint8_t*)a - (int)*(const uint8_t*)b;
+}
+
+/**
+ * @brief uint16_t比较函数
+ */
+static int compare_u16(const void* a, const void* b) {
+    return (int)*(const uint16_t*)a - (int)*(const uint16_t*)b;
+}
+
+/**
+ * @brief uint32_t比较函数
+ */
+static int compare_u32(const void* a, const void* b) {
+    uint32_t x = *(const uint32_t*)a;
+    uint32_t y = *(const uint32_t*)b;
+    return (x > y) - (x < y);
+}
+
+/**
+ * @brief uint64_t比较函数
+ */
+static int compare_u64(const void* a, const void* b) {
+    uint64_t x = *(const uint64_t*)a;
+    uint64_t y = *(const uint64_t*)b;
+    return (x > y) - (x < y);
+}
+
+/**
+ * @brief 获取指定宽度的比较函数
+ *
+ * @param width 元素宽度
+ * @return compare_fn_t 比较函数
+ */
+static compare_fn_t compare_for_width(size_t width) {
+    switch (width) {
+    case 1: return compare_u8;
+    case 2: return compare_u16;
+    case 4: return compare_u32;
+    default: return compare_u64;
+    }
+}
+
+/**
+ * @brief 测试一个元素宽度
+ *
+ * @param log_file 日志文件
+ * @param width 元素宽度
+ */
+static void test_width(FILE* log_file, size_t width) {
+    vector_t* vec = vector_create(width, NUM_ELEMENTS, NULL, NULL);
+    vector_t* copy = vector_create(width, NUM_ELEMENTS, NULL, NULL);
+    if (vec == NULL || copy == NULL) {
+        printf("错误: 无法创建测试数据\n");
+        vector_destroy(vec);
+        vector_destroy(copy);
+        return;
+    }
+    vector_resize(vec, NUM_ELEMENTS);
+    vector_resize(copy, NUM_ELEMENTS);
+
+    // 数据取1..100且相邻元素不相等，查找值0不存在
+    unsigned char* data = (unsigned char*)vec->data;
+    uint8_t previous = 0;
+    for (size_t i = 0; i < NUM_ELEMENTS; i++) {
+        uint8_t value = (uint8_t)random_int64(1, 100);
+        if (value == previous) {
+            value = (uint8_t)(value % 100 + 1);
+        }
+        previous = value;
+        memset(data + i * width, 0, width);
+        data[i * width] = value;
+    }
+    memcpy(copy->data, vec->data, NUM_ELEMENTS * width);
+
+    uint64_t missing = 0;
+    iterator_t* begin = vector_begin(vec);
+    iterator_t* end = vector_end(vec);
+    iterator_t* copy_begin = vector_begin(copy);
+    compare_fn_t compare = compare_for_width(width);
+
+    fprintf(log_file, "--- 元素宽度: %zu 字节, %d 个元素, 重复 %d 次 ---\n", width, NUM_ELEMENTS, REPEAT);
+    printf("--- 元素宽度: %zu 字节, %d 个元素, 重复 %d 次 ---\n", width, NUM_ELEMENTS, REPEAT);
+    fprintf(log_file, "  %-12s %10s %10s %10s %14s\n", "模式", "find", "count", "equal", "adjacent_find");
+    printf("  %-12s %10s %10s %10s %14s\n", "模式", "find", "count", "equal", "adjacent_find");
+
+    for (int mode = 0; mode < NUM_MODES; mode++) {
+        if ((mode_masks[mode] & ~simd_cpu_features() & (SIMD_FEATURE_SSE2 | SIMD_FEATURE_AVX2)) != 0) {
+            fprintf(log_file, "  %-12s CPU不支持，跳过\n", mode_names[mode]);
+            printf("  %-12s CPU不支持，跳过\n", mode_names[mode]);
+            continue;
+        }
+
+        compare_fn_t mode_compare = mode == 0 ? compare : NULL;
+        simd_set_feature_mask(mode_masks[mode]);
+        void* result = NULL;
+        size_t count = 0;
+        int equal = 0;
+
+        long long start_time = get_current_time_ms_high_precision();
+        for (int r = 0; r < REPEAT; r++) {
+            algo_find(begin, end, &missing, mode_compare, &result);
+        }
+        long long find_time = get_current_time_ms_high_precision() - start_time;
+
+        start_time = get_current_time_ms_high_precision();
+        for (int r = 0; r < REPEAT; r++) {
+            algo_count(begin, end, &missing, mode_compare, &count);
+        }
+        long long count_time = get_current_time_ms_high_precision() - start_time;
+
+        start_time = get_current_time_ms_high_precision();
+        for (int r = 0; r < REPEAT; r++) {
+            algo_equal(begin, end, copy_begin, mode_compare, &equal);
+        }
+        long long equal_time = get_current_time_ms_high_precision() - start_time;
+
+        start_time = get_current_time_ms_high_precision();
+        for (int r = 0; r < REPEAT; r++) {
+            algo_adjacent_find(begin, end, mode_compare, &result);
+        }
+        long long adjacent_time = get_current_time_ms_high_precision() - start_time;
+
+        fprintf(log_file, "  %-12s %7lld ms %7lld ms %7lld ms %11lld ms\n", mode_names[mode],
+                find_time, count_time, equal_time, adjacent_time);
+        printf("  %-12s %7lld ms %7lld ms %7lld ms %11lld ms\n", mode_names[mode],
+               find_time, count_time, equal_time, adjacent_time);
+
+        if (result != NULL || count != 0 || !equal) {
+            fprintf(log_file, "  错误: 结果不正确!\n");
+            printf("  错误: 结果不正确!\n");
+        }
+    }
+
+    simd_set_feature_mask(~0u);
+    fprintf(log_file, "\n");
+    printf("\n");
+
+    iterator_destroy(begin);
+    iterator_destroy(end);
+    iterator_destroy(copy_begin);
+    vector_destroy(vec);
+    vector_destroy(copy);
+}
+
+/**
+ * @brief 运行完整的性能测试
+ */
+void run_performance_tests() {
+    FILE* log_file = fopen(LOG_FILE, "a");
+    if (log_file == NULL) {
+        printf("无法打开日志文件 %s\n", LOG_FILE);
+        return;
+    }
+
+    unsigned int features = simd_cpu_features();
+    fprintf(log_file, "\n=== 按位比较查找性能测试报告 ===\n");
+    fprintf(log_file, "测试时间: %s", ctime(&(time_t){time(NULL)}));
+    fprintf(log_file, "CPU特性: SSE2 %s, AVX2 %s\n\n",
+            (features & SIMD_FEATURE_SSE2) ? "支持" : "不支持",
+            (features & SIMD_FEATURE_AVX2) ? "支持" : "不支持");
+
+    printf("开始按位比较查找性能测试...\n");
+    printf("结果将保存到 %s\n\n", LOG_FILE);
+
+    for (int i = 0; i < NUM_WIDTHS; i++) {
+        test_width(log_file, test_widths[i]);
+    }
+
+    fprintf(log_file, "=== 测试完成 ===\n\n");
+    printf("=== 测试完成 ===\n");
+
+    fclose(log_file);
+}
+
+/**
+ * @brief 显示帮助信息
+ */
+void show_help() {
+    printf("按位比较查找性能测试程序\n");
+    printf("用法: ./simd_performance_test [选项]\n");
+    printf("选项:\n");
+    printf("  -h, --help     显示帮助信息\n");
+    printf("  -r, --run      运行性能测试\n");
+    printf("  -c, --clear    清空日志文件\n");
+    printf("\n");
+    printf("  测试结果将保存到 %s 文件中\n", LOG_FILE);
+}
+
+/**
+ * @brief 主函数
+ *
+ * @param argc 参数个数
+ * @param argv 参数数组
+ * @return int 程序退出码
+ */
+int main(int argc, char* argv[]) {
+    srand((unsigned int)time(NULL));
+
+    if (argc < 2) {
+        show_help();
+        return 0;
+    }
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-h") == 0 || strcmp(argv[i], "--help") == 0) {
+            show_help();
+            return 0;
+        } else if (strcmp(argv[i], "-r") == 0 || strcmp(argv[i], "--run") == 0) {
+            run_performance_tests();
+            return 0;
+        } else if (strcmp(argv[i], "-c") == 0 || strcmp(argv[i], "--clear") == 0) {
+            FILE* log_file = fopen(LOG_FILE, "w");
+            if (log_file) {
+                fclose(log_file);
+                printf("日志文件 %s 已清空\n", LOG_FILE);
+            }
+            return 0;
+        } else {
+            printf("未知选项: %s\n", argv[i]);
+            show_help();
+            return 1;
+        }
+    }
+
+    return 0;
+}
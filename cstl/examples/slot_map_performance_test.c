@@ -0,0 +1,420 @@
+/**
+ * @file slot_map_performance_test.c
+ * @brief 槽位映射性能测试
+ * @version 0.1
+ * @date 2025-10-14
+ *
+ * @copyright Copyright (c) 2025
+ *
+ * 本文件在1K到10M个int64元素上对比vector_t和slot_map_t：
+ * - 插入全部元素
+ * - 用迭代器遍历全部元素，以及直接遍历slot_map_data返回的紧凑数组
+ * - 按随机编号查找元素（vector_t用vector_at按下标，slot_map_t用slot_map_get按句柄）
+ * - 按句柄随机删除一半元素，再用失效的句柄查找（应该全部失败），然后插入同样数量的新元素
+ * - 删除插入之后再次遍历
+ *
+ * vector_t的下标在删除后会指向别的元素，没有对应的删除阶段。
+ * 元素较少时重复遍历和查找，使两种容器处理的元素总数大致相同。
+ * 使用utils中的高精度时间函数计算耗时，并将结果输出到日志文件中
+ */
+
+#include "cstl.h"
+#include "common/utils.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define LOG_FILE "slot_map_performance.log"
+#define TRAVERSE_ELEMENTS 20000000
+
+/**
+ * @brief 测试阶段
+ */
+typedef enum {
+    PHASE_INSERT,           /**< 插入全部元素 */
+    PHASE_TRAVERSE,         /**< 迭代器遍历 */
+    PHASE_TRAVERSE_DATA,    /**< 直接遍历紧凑数组 */
+    PHASE_LOOKUP,           /**< 随机查找 */
+    PHASE_ERASE,            /**< 按句柄随机删除，仅slot_map_t */
+    PHASE_STALE_LOOKUP,     /**< 失效句柄查找，仅slot_map_t */
+    PHASE_REINSERT,         /**< 再插入，仅slot_map_t */
+    PHASE_TRAVERSE_CHURNED, /**< 删除插入之后遍历，仅slot_map_t */
+    PHASE_COUNT
+} phase_t;
+
+/**
+ * @brief 阶段名称
+ */
+static const char* phase_names[PHASE_COUNT] = {
+    "插入", "迭代器遍历", "紧凑数组遍历", "随机查找",
+    "按句柄删除一半", "失效句柄查找", "再插入", "删除插入后遍历"
+};
+
+/**
+ * @brief 一次测试的参数
+ */
+typedef struct {
+    size_t size;            /**< 元素数量 */
+    size_t reps;            /**< 遍历和查找的重复次数 */
+    const size_t* lookups;  /**< 随机查找的编号，共size个 */
+    const size_t* erase_ids;/**< 删除的编号，前size / 2个互不相同 */
+} bench_params_t;
+
+/**
+ * @brief 用迭代器遍历并累加全部元素
+ *
+ * @param begin 起始迭代器，遍历结束后销毁
+ * @return int64_t 元素之和
+ */
+static int64_t traverse_sum(iterator_t* begin) {
+    int64_t sum = 0;
+    while (begin->valid(begin)) {
+        sum += *(const int64_t*)begin->current;
+        begin->next(begin);
+    }
+    iterator_destroy(begin);
+    return sum;
+}
+
+/**
+ * @brief 累加连续数组中的元素
+ *
+ * @param data 数组
+ * @param count 元素数量
+ * @return int64_t 元素之和
+ */
+static int64_t array_sum(const int64_t* data, size_t count) {
+    int64_t sum = 0;
+    for (size_t i = 0; i < count; i++) {
+        sum += data[i];
+    }
+    return sum;
+}
+
+/**
+ * @brief 测试vector_t
+ *
+ * @param params 测试参数
+ * @param elapsed 输出参数，各阶段耗时，不适用的阶段为-1
+ * @param checksums 输出参数，各阶段校验值
+ */
+static void run_vector(const bench_params_t* params, long long* elapsed, int64_t* checksums) {
+    vector_t* vector = vector_create(sizeof(int64_t), 0, NULL, NULL);
+    if (vector == NULL) {
+        return;
+    }
+
+    long long start_time = get_current_time_ms_high_precision();
+    for (size_t i = 0; i < params->size; i++) {
+        int64_t value = (int64_t)i;
+        vector_push_back(vector, &value);
+    }
+    elapsed[PHASE_INSERT] = get_current_time_ms_high_precision() - start_time;
+    checksums[PHASE_INSERT] = (int64_t)vector_size(vector);
+
+    int64_t sum = 0;
+    start_time = get_current_time_ms_high_precision();
+    for (size_t r = 0; r < params->reps; r++) {
+        sum += traverse_sum(vector_begin(vector));
+    }
+    elapsed[PHASE_TRAVERSE] = get_current_time_ms_high_precision() - start_time;
+    checksums[PHASE_TRAVERSE] = sum;
+
+    sum = 0;
+    start_time = get_current_time_ms_high_precision();
+    for (size_t r = 0; r < params->reps; r++) {
+        sum += array_sum((const int64_t*)vector->data, vector_size(vector));
+    }
+    elapsed[PHASE_TRAVERSE_DATA] = get_current_time_ms_high_precision() - start_time;
+    checksums[PHASE_TRAVERSE_DATA] = sum;
+
+    sum = 0;
+    start_time = get_current_time_ms_high_precision();
+    for (size_t r = 0; r < params->reps; r++) {
+        for (size_t i = 0; i < params->size; i++) {
+            void* element;
+            if (vector_at(vector, params->lookups[i], &element) == CSTL_OK) {
+                sum += *(const int64_t*)element;
+            }
+        }
+    }
+    elapsed[PHASE_LOOKUP] = get_current_time_ms_high_precision() - start_time;
+    checksums[PHASE_LOOKUP] = sum;
+
+    vector_destroy(vector);
+}
+
+/**
+ * @brief 测试slot_map_t
+ *
+ * @param params 测试参数
+ * @param elapsed 输出参数，各阶段耗时
+ * @param checksums 输出参数，各阶段校验值
+ */
+static void run_slot_map(const bench_params_t* params, long long* elapsed, int64_t* checksums) {
+    slot_map_t* map = slot_map_create(sizeof(int64_t), NULL, NULL);
+    slot_handle_t* handles = (slot_handle_t*)malloc(params->size * sizeof(slot_handle_t));
+    if (map == NULL || handles == NULL) {
+        slot_map_destroy(map);
+        free(handles);
+        return;
+    }
+
+    long long start_time = get_current_time_ms_high_precision();
+    for (size_t i = 0; i < params->size; i++) {
+        int64_t value = (int64_t)i;
+        slot_map_insert(map, &value, &handles[i]);
+    }
+    elapsed[PHASE_INSERT] = get_current_time_ms_high_precision() - start_time;
+    checksums[PHASE_INSERT] = (int64_t)slot_map_size(map);
+
+    int64_t sum = 0;
+    start_time = get_current_time_ms_high_precision();
+    for (size_t r = 0; r < params->reps; r++) {
+        sum += traverse_sum(slot_map_begin(map));
+    }
+    elapsed[PHASE_TRAVERSE] = get_current_time_ms_high_precision() - start_time;
+    checksums[PHASE_TRAVERSE] = sum;
+
+    sum = 0;
+    start_time = get_current_time_ms_high_precision();
+    for (size_t r = 0; r < params->reps; r++) {
+        sum += array_sum((const int64_t*)slot_map_data(map), slot_map_size(map));
+    }
+    elapsed[PHASE_TRAVERSE_DATA] = get_current_time_ms_high_precision() - start_time;
+    checksums[PHASE_TRAVERSE_DATA] = sum;
+
+    /* 与vector_t按下标查找相同，查找用的句柄事先按顺序排好 */
+    slot_handle_t* lookup_handles = (slot_handle_t*)malloc(params->size * sizeof(slot_handle_t));
+    if (lookup_handles == NULL) {
+        slot_map_destroy(map);
+        free(handles);
+        return;
+    }
+    for (size_t i = 0; i < params->size; i++) {
+        lookup_handles[i] = handles[params->lookups[i]];
+    }
+
+    sum = 0;
+    start_time = get_current_time_ms_high_precision();
+    for (size_t r = 0; r < params->reps; r++) {
+        for (size_t i = 0; i < params->size; i++) {
+            void* element;
+            if (slot_map_get(map, lookup_handles[i], &element) == CSTL_OK) {
+                sum += *(const int64_t*)element;
+            }
+        }
+    }
+    elapsed[PHASE_LOOKUP] = get_current_time_ms_high_precision() - start_time;
+    checksums[PHASE_LOOKUP] = sum;
+    free(lookup_handles);
+
+    size_t erase_count = params->size / 2;
+    start_time = get_current_time_ms_high_precision();
+    for (size_t k = 0; k < erase_count; k++) {
+        slot_map_erase(map, handles[params->erase_ids[k]]);
+    }
+    elapsed[PHASE_ERASE] = get_current_time_ms_high_precision() - start_time;
+    checksums[PHASE_ERASE] = (int64_t)slot_map_size(map);
+
+    int64_t found = 0;
+    start_time = get_current_time_ms_high_precision();
+    for (size_t k = 0; k < erase_count; k++) {
+        void* element;
+        found += slot_map_get(map, handles[params->erase_ids[k]], &element) == CSTL_OK;
+    }
+    elapsed[PHASE_STALE_LOOKUP] = get_current_time_ms_high_precision() - start_time;
+    checksums[PHASE_STALE_LOOKUP] = found;
+
+    start_time = get_current_time_ms_high_precision();
+    for (size_t k = 0; k < erase_count; k++) {
+        int64_t value = (int64_t)(params->size + k);
+        slot_map_insert(map, &value, &handles[params->erase_ids[k]]);
+    }
+    elapsed[PHASE_REINSERT] = get_current_time_ms_high_precision() - start_time;
+    checksums[PHASE_REINSERT] = (int64_t)slot_map_size(map);
+
+    sum = 0;
+    start_time = get_current_time_ms_high_precision();
+    for (size_t r = 0; r < params->reps; r++) {
+        sum += traverse_sum(slot_map_begin(map));
+    }
+    elapsed[PHASE_TRAVERSE_CHURNED] = get_current_time_ms_high_precision() - start_time;
+    checksums[PHASE_TRAVERSE_CHURNED] = sum;
+
+    slot_map_destroy(map);
+    free(handles);
+}
+
+/**
+ * @brief 格式化耗时，不适用的阶段显示为"-"
+ *
+ * @param buffer 输出缓冲区
+ * @param size 缓冲区大小
+ * @param elapsed 耗时，小于0表示不适用
+ */
+static void format_elapsed(char* buffer, size_t size, long long elapsed) {
+    if (elapsed >= 0) {
+        snprintf(buffer, size, "%lld ms", elapsed);
+    } else {
+        snprintf(buffer, size, "-");
+    }
+}
+
+/**
+ * @brief 测试指定大小的容器
+ *
+ * @param log_file 日志文件
+ * @param size 元素数量，至少为2
+ */
+static void test_size(FILE* log_file, size_t size) {
+    bench_params_t params;
+    params.size = size;
+    params.reps = size < TRAVERSE_ELEMENTS ? TRAVERSE_ELEMENTS / size : 1;
+
+    size_t* lookups = (size_t*)malloc(size * sizeof(size_t));
+    size_t* ids = (size_t*)malloc(size * sizeof(size_t));
+    if (lookups == NULL || ids == NULL) {
+        printf("错误: 无法创建测试数据\n");
+        free(lookups);
+        free(ids);
+        return;
+    }
+
+    /* 打乱编号，前一半作为删除目标 */
+    for (size_t i = 0; i < size; i++) {
+        lookups[i] = (size_t)random_int64(0, (int64_t)size - 1);
+        ids[i] = i;
+    }
+    for (size_t i = size - 1; i > 0; i--) {
+        size_t j = (size_t)random_int64(0, (int64_t)i);
+        size_t temp = ids[i];
+        ids[i] = ids[j];
+        ids[j] = temp;
+    }
+    params.lookups = lookups;
+    params.erase_ids = ids;
+
+    long long vector_elapsed[PHASE_COUNT];
+    long long map_elapsed[PHASE_COUNT];
+    int64_t vector_checksums[PHASE_COUNT] = {0};
+    int64_t map_checksums[PHASE_COUNT] = {0};
+    for (int phase = 0; phase < PHASE_COUNT; phase++) {
+        vector_elapsed[phase] = -1;
+        map_elapsed[phase] = -1;
+    }
+
+    run_vector(&params, vector_elapsed, vector_checksums);
+    run_slot_map(&params, map_elapsed, map_checksums);
+
+    fprintf(log_file, "--- %zu 个元素（遍历和查找重复 %zu 次） ---\n", size, params.reps);
+    printf("--- %zu 个元素（遍历和查找重复 %zu 次） ---\n", size, params.reps);
+    fprintf(log_file, "  %-24s %12s %12s  %s\n", "阶段", "vector_t", "slot_map_t", "校验");
+    printf("  %-24s %12s %12s  %s\n", "阶段", "vector_t", "slot_map_t", "校验");
+
+    for (int phase = 0; phase < PHASE_COUNT; phase++) {
+        char vector_text[32];
+        char map_text[32];
+        int64_t checksum = map_checksums[phase];
+        format_elapsed(vector_text, sizeof(vector_text), vector_elapsed[phase]);
+        format_elapsed(map_text, sizeof(map_text), map_elapsed[phase]);
+
+        const char* status = vector_elapsed[phase] < 0 || vector_checksums[phase] == checksum ? "一致" : "不一致";
+        if (phase == PHASE_STALE_LOOKUP && checksum != 0) {
+            status = "不一致";
+        }
+        fprintf(log_file, "  %-24s %12s %12s  %s %lld\n", phase_names[phase], vector_text, map_text,
+                status, (long long)checksum);
+        printf("  %-24s %12s %12s  %s %lld\n", phase_names[phase], vector_text, map_text,
+               status, (long long)checksum);
+    }
+
+    fprintf(log_file, "\n");
+    printf("\n");
+
+    free(lookups);
+    free(ids);
+}
+
+/**
+ * @brief 运行完整的性能测试
+ */
+void run_performance_tests() {
+    FILE* log_file = fopen(LOG_FILE, "a");
+    if (log_file == NULL) {
+        printf("无法打开日志文件 %s\n", LOG_FILE);
+        return;
+    }
+
+    fprintf(log_file, "\n=== 槽位映射性能测试报告 ===\n");
+    fprintf(log_file, "测试时间: %s", ctime(&(time_t){time(NULL)}));
+    fprintf(log_file, "元素类型: int64，句柄 %zu 字节\n\n", sizeof(slot_handle_t));
+
+    printf("开始槽位映射性能测试...\n");
+    printf("结果将保存到 %s\n\n", LOG_FILE);
+
+    test_size(log_file, 1000);
+    test_size(log_file, 10000);
+    test_size(log_file, 100000);
+    test_size(log_file, 1000000);
+    test_size(log_file, 10000000);
+
+    fprintf(log_file, "=== 测试完成 ===\n\n");
+    printf("=== 测试完成 ===\n");
+
+    fclose(log_file);
+}
+
+/**
+ * @brief 显示帮助信息
+ */
+void show_help() {
+    printf("槽位映射性能测试程序\n");
+    printf("用法: ./slot_map_performance_test [选项]\n");
+    printf("选项:\n");
+    printf("  -h, --help     显示帮助信息\n");
+    printf("  -r, --run      运行性能测试\n");
+    printf("  -c, --clear    清空日志文件\n");
+    printf("\n");
+    printf("  测试结果将保存到 %s 文件中\n", LOG_FILE);
+}
+
+/**
+ * @brief 主函数
+ *
+ * @param argc 参数个数
+ * @param argv 参数数组
+ * @return int 程序退出码
+ */
+int main(int argc, char* argv[]) {
+    srand((unsigned int)time(NULL));
+
+    if (argc < 2) {
+        show_help();
+        return 0;
+    }
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-h") == 0 || strcmp(argv[i], "--help") == 0) {
+            show_help();
+            return 0;
+        } else if (strcmp(argv[i], "-r") == 0 || strcmp(argv[i], "--run") == 0) {
+            run_performance_tests();
+            return 0;
+        } else if (strcmp(argv[i], "-c") == 0 || strcmp(argv[i], "--clear") == 0) {
+            FILE* log_file = fopen(LOG_FILE, "w");
+            if (log_file) {
+                fclose(log_file);
+                printf("日志文件 %s 已清空\n", LOG_FILE);
+            }
+            return 0;
+        } else {
+            printf("未知选项: %s\n", argv[i]);
+            show_help();
+            return 1;
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,341 @@
+/**
+ * @file sort_by_key_performance_test.c
+ * @brief 按键排序性能测试
+ * @version 0.1
+ * @date 2025-10-03
+ *
+ * @copyright Copyright (c) 2025
+ *
+ * 本文件对比通过比较函数的qsort与algo_sort_by_key / algo_sort_by_computed_key：
+ * - int64数组（直接对元素做基数排序）
+ * - 32字节记录按int32字段排序（排序键值对后重排记录）
+ * - 32字节记录按16字节的字节串字段排序（前8字节基数排序，其余memcmp）
+ * - 键需要计算时，比较函数每次重新计算键与每个元素只计算一次键
+ *
+ * 使用utils中的高精度时间函数计算耗时，并将结果输出到日志文件中
+ */
+
+#include "cstl.h"
+#include "common/utils.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define LOG_FILE "sort_by_key_performance.log"
+#define NUM_ELEMENTS 4000000
+
+/**
+ * @brief 测试用记录
+ */
+typedef struct {
+    uint32_t id;            /**< 编号 */
+    int32_t score;          /**< int32键 */
+    char name[16];          /**< 字节串键 */
+    double weight;          /**< 负载 */
+} record_t;
+
+/**
+ * @brief int64比较函数
+ *
+ * @param a 第一个元素指针
+ * @param b 第二个元素指针
+ * @return int 比较结果
+ */
+static int compare_int64(const void* a, const void* b) {
+    int64_t x = *(const int64_t*)a;
+    int64_t y = *(const int64_t*)b;
+    return (x > y) - (x < y);
+}
+
+/**
+ * @brief 按score比较记录
+ *
+ * @param a 第一个元素指针
+ * @param b 第二个元素指针
+ * @return int 比较结果
+ */
+static int compare_score(const void* a, const void* b) {
+    int32_t x = ((const record_t*)a)->score;
+    int32_t y = ((const record_t*)b)->score;
+    return (x > y) - (x < y);
+}
+
+/**
+ * @brief 按name比较记录
+ *
+ * @param a 第一个元素指针
+ * @param b 第二个元素指针
+ * @return int 比较结果
+ */
+static int compare_name(const void* a, const void* b) {
+    return memcmp(((const record_t*)a)->name, ((const record_t*)b)->name, sizeof(((const record_t*)a)->name));
+}
+
+/**
+ * @brief 计算代价较高的键：对name做多轮混合
+ *
+ * @param record 记录
+ * @return uint64_t 键
+ */
+static uint64_t expensive_key(const record_t* record) {
+    uint64_t h = 1469598103934665603ULL;
+    for (int round = 0; round < 4; round++) {
+        for (size_t i = 0; i < sizeof(record->name); i++) {
+            h = (h ^ (unsigned char)record->name[i]) * 1099511628211ULL;
+        }
+    }
+    return h;
+}
+
+/**
+ * @brief 每次比较都重新计算键
+ *
+ * @param a 第一个元素指针
+ * @param b 第二个元素指针
+ * @return int 比较结果
+ */
+static int compare_expensive(const void* a, const void* b) {
+    uint64_t x = expensive_key((const record_t*)a);
+    uint64_t y = expensive_key((const record_t*)b);
+    return (x > y) - (x < y);
+}
+
+/**
+ * @brief 键提取函数
+ *
+ * @param element 元素指针
+ * @param key 输出参数，写入8字节的键
+ */
+static void extract_expensive(const void* element, void* key) {
+    uint64_t h = expensive_key((const record_t*)element);
+    memcpy(key, &h, sizeof(h));
+}
+
+/**
+ * @brief 输出一行测试结果
+ *
+ * @param log_file 日志文件
+ * @param name 测试名称
+ * @param qsort_time qsort耗时（毫秒）
+ * @param key_time 按键排序耗时（毫秒）
+ * @param ok 两者结果是否一致
+ */
+static void report(FILE* log_file, const char* name, long long qsort_time, long long key_time, int ok) {
+    double speedup = key_time > 0 ? (double)qsort_time / key_time : 0.0;
+    fprintf(log_file, "  %-28s qsort %6lld ms  按键 %6lld ms  %5.1fx  %s\n",
+            name, qsort_time, key_time, speedup, ok ? "结果一致" : "结果不一致");
+    printf("  %-28s qsort %6lld ms  按键 %6lld ms  %5.1fx  %s\n",
+           name, qsort_time, key_time, speedup, ok ? "结果一致" : "结果不一致");
+}
+
+/**
+ * @brief 测试int64数组
+ *
+ * @param log_file 日志文件
+ */
+static void test_int64(FILE* log_file) {
+    vector_t* vec = vector_create(sizeof(int64_t), NUM_ELEMENTS, NULL, NULL);
+    int64_t* copy = (int64_t*)malloc(NUM_ELEMENTS * sizeof(int64_t));
+    if (vec == NULL || copy == NULL) {
+        printf("错误: 无法创建测试数据\n");
+        vector_destroy(vec);
+        free(copy);
+        return;
+    }
+    for (int i = 0; i < NUM_ELEMENTS; i++) {
+        int64_t value = random_int64(-1000000000000LL, 1000000000000LL);
+        vector_push_back(vec, &value);
+        copy[i] = value;
+    }
+
+    long long start_time = get_current_time_ms_high_precision();
+    qsort(copy, NUM_ELEMENTS, sizeof(int64_t), compare_int64);
+    long long qsort_time = get_current_time_ms_high_precision() - start_time;
+
+    iterator_t* begin = vector_begin(vec);
+    iterator_t* end = vector_end(vec);
+    start_time = get_current_time_ms_high_precision();
+    algo_sort_by_key(begin, end, 0, sizeof(int64_t), SORT_KEY_INT, SORT_ASCENDING);
+    long long key_time = get_current_time_ms_high_precision() - start_time;
+    iterator_destroy(begin);
+    iterator_destroy(end);
+
+    report(log_file, "int64数组", qsort_time, key_time,
+           memcmp(vec->data, copy, NUM_ELEMENTS * sizeof(int64_t)) == 0);
+
+    vector_destroy(vec);
+    free(copy);
+}
+
+/**
+ * @brief 测试记录按字段排序
+ *
+ * @param log_file 日志文件
+ */
+static void test_records(FILE* log_file) {
+    vector_t* vec = vector_create(sizeof(record_t), NUM_ELEMENTS, NULL, NULL);
+    record_t* copy = (record_t*)malloc(NUM_ELEMENTS * sizeof(record_t));
+    record_t* original = (record_t*)malloc(NUM_ELEMENTS * sizeof(record_t));
+    if (vec == NULL || copy == NULL || original == NULL) {
+        printf("错误: 无法创建测试数据\n");
+        vector_destroy(vec);
+        free(copy);
+        free(original);
+        return;
+    }
+    for (int i = 0; i < NUM_ELEMENTS; i++) {
+        record_t record;
+        memset(&record, 0, sizeof(record));
+        record.id = (uint32_t)i;
+        record.score = (int32_t)random_int64(-2000000000LL, 2000000000LL);
+        for (size_t j = 0; j < sizeof(record.name); j++) {
+            record.name[j] = (char)('a' + random_int64(0, j < 4 ? 1 : 25));
+        }
+        record.weight = i * 0.5;
+        original[i] = record;
+        vector_push_back(vec, &record);
+    }
+
+    struct {
+        const char* name;
+        compare_fn_t compare;
+        size_t offset;
+        size_t width;
+        sort_key_type_t type;
+    } cases[2] = {
+        {"记录按int32字段", compare_score, offsetof(record_t, score), sizeof(int32_t), SORT_KEY_INT},
+        {"记录按16字节字节串字段", compare_name, offsetof(record_t, name), 16, SORT_KEY_BYTES}
+    };
+
+    for (int c = 0; c < 2; c++) {
+        memcpy(copy, original, NUM_ELEMENTS * sizeof(record_t));
+        memcpy(vec->data, original, NUM_ELEMENTS * sizeof(record_t));
+
+        long long start_time = get_current_time_ms_high_precision();
+        qsort(copy, NUM_ELEMENTS, sizeof(record_t), cases[c].compare);
+        long long qsort_time = get_current_time_ms_high_precision() - start_time;
+
+        iterator_t* begin = vector_begin(vec);
+        iterator_t* end = vector_end(vec);
+        start_time = get_current_time_ms_high_precision();
+        algo_sort_by_key(begin, end, cases[c].offset, cases[c].width, cases[c].type, SORT_ASCENDING);
+        long long key_time = get_current_time_ms_high_precision() - start_time;
+        iterator_destroy(begin);
+        iterator_destroy(end);
+
+        /* qsort不稳定，只比较键的顺序 */
+        int ok = 1;
+        const record_t* sorted = (const record_t*)vec->data;
+        for (int i = 0; i < NUM_ELEMENTS && ok; i++) {
+            ok = cases[c].compare(&sorted[i], &copy[i]) == 0;
+        }
+        report(log_file, cases[c].name, qsort_time, key_time, ok);
+    }
+
+    /* 键需要计算 */
+    memcpy(copy, original, NUM_ELEMENTS * sizeof(record_t));
+    memcpy(vec->data, original, NUM_ELEMENTS * sizeof(record_t));
+
+    long long start_time = get_current_time_ms_high_precision();
+    qsort(copy, NUM_ELEMENTS, sizeof(record_t), compare_expensive);
+    long long qsort_time = get_current_time_ms_high_precision() - start_time;
+
+    iterator_t* begin = vector_begin(vec);
+    iterator_t* end = vector_end(vec);
+    start_time = get_current_time_ms_high_precision();
+    algo_sort_by_computed_key(begin, end, extract_expensive, sizeof(uint64_t), SORT_KEY_UINT, SORT_ASCENDING);
+    long long key_time = get_current_time_ms_high_precision() - start_time;
+    iterator_destroy(begin);
+    iterator_destroy(end);
+
+    int ok = 1;
+    const record_t* sorted = (const record_t*)vec->data;
+    for (int i = 0; i < NUM_ELEMENTS && ok; i++) {
+        ok = compare_expensive(&sorted[i], &copy[i]) == 0;
+    }
+    report(log_file, "计算键（Schwartzian）", qsort_time, key_time, ok);
+
+    vector_destroy(vec);
+    free(copy);
+    free(original);
+}
+
+/**
+ * @brief 运行完整的性能测试
+ */
+void run_performance_tests() {
+    FILE* log_file = fopen(LOG_FILE, "a");
+    if (log_file == NULL) {
+        printf("无法打开日志文件 %s\n", LOG_FILE);
+        return;
+    }
+
+    fprintf(log_file, "\n=== 按键排序性能测试报告 ===\n");
+    fprintf(log_file, "测试时间: %s", ctime(&(time_t){time(NULL)}));
+    fprintf(log_file, "元素数量: %d\n\n", NUM_ELEMENTS);
+
+    printf("开始按键排序性能测试...\n");
+    printf("结果将保存到 %s\n\n", LOG_FILE);
+
+    test_int64(log_file);
+    test_records(log_file);
+
+    fprintf(log_file, "\n=== 测试完成 ===\n\n");
+    printf("\n=== 测试完成 ===\n");
+
+    fclose(log_file);
+}
+
+/**
+ * @brief 显示帮助信息
+ */
+void show_help() {
+    printf("按键排序性能测试程序\n");
+    printf("用法: ./sort_by_key_performance_test [选项]\n");
+    printf("选项:\n");
+    printf("  -h, --help     显示帮助信息\n");
+    printf("  -r, --run      运行性能测试\n");
+    printf("  -c, --clear    清空日志文件\n");
+    printf("\n");
+    printf("  测试结果将保存到 %s 文件中\n", LOG_FILE);
+}
+
+/**
+ * @brief 主函数
+ *
+ * @param argc 参数个数
+ * @param argv 参数数组
+ * @return int 程序退出码
+ */
+int main(int argc, char* argv[]) {
+    srand((unsigned int)time(NULL));
+
+    if (argc < 2) {
+        show_help();
+        return 0;
+    }
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-h") == 0 || strcmp(argv[i], "--help") == 0) {
+            show_help();
+            return 0;
+        } else if (strcmp(argv[i], "-r") == 0 || strcmp(argv[i], "--run") == 0) {
+            run_performance_tests();
+            return 0;
+        } else if (strcmp(argv[i], "-c") == 0 || strcmp(argv[i], "--clear") == 0) {
+            FILE* log_file = fopen(LOG_FILE, "w");
+            if (log_file) {
+                fclose(log_file);
+                printf("日志文件 %s 已清空\n", LOG_FILE);
+            }
+            return 0;
+        } else {
+            printf("未知选项: %s\n", argv[i]);
+            show_help();
+            return 1;
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,352 @@
+/**
+ * @file sorting_network_performance_test.c
+ * @brief 小数组排序网络性能测试
+ * @version 0.1
+ * @date 2025-10-05
+ *
+ * @copyright Copyright (c) 2025
+ *
+ * 本文件对大量2~32个元素的小数组排序，对比以下方式：
+ * - 按类型展开的插入排序（排序引擎原来的小数组处理方式）
+ * - 通过比较函数的插入排序（algo_sort对小范围的处理方式）
+ * - simd_sort_small_* 关闭AVX2（退回插入排序）
+ * - simd_sort_small_* 开启AVX2（不少于SIMD_SORT_NETWORK_MIN个元素时使用排序网络）
+ *
+ * 数据为随机数，插入排序的分支难以预测，排序网络没有依赖数据的分支。
+ * 结果用于确定SIMD_SORT_NETWORK_MIN。
+ * 使用utils中的高精度时间函数计算耗时，并将结果输出到日志文件中
+ */
+
+#include "cstl.h"
+#include "common/utils.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define LOG_FILE "sorting_network_performance.log"
+#define TOTAL_ELEMENTS 16000000
+
+/**
+ * @brief int32比较函数
+ *
+ * @param a 第一个元素指针
+ * @param b 第二个元素指针
+ * @return int 比较结果
+ */
+static int compare_int32(const void* a, const void* b) {
+    int32_t x = *(const int32_t*)a;
+    int32_t y = *(const int32_t*)b;
+    return (x > y) - (x < y);
+}
+
+/**
+ * @brief double比较函数
+ *
+ * @param a 第一个元素指针
+ * @param b 第二个元素指针
+ * @return int 比较结果
+ */
+static int compare_double(const void* a, const void* b) {
+    double x = *(const double*)a;
+    double y = *(const double*)b;
+    return (x > y) - (x < y);
+}
+
+/**
+ * @brief int32插入排序
+ *
+ * @param data 数组
+ * @param count 元素数量
+ */
+static void insertion_sort_int32(int32_t* data, size_t count) {
+    for (size_t i = 1; i < count; i++) {
+        int32_t key = data[i];
+        size_t j = i;
+        while (j > 0 && data[j - 1] > key) {
+            data[j] = data[j - 1];
+            j--;
+        }
+        data[j] = key;
+    }
+}
+
+/**
+ * @brief double插入排序
+ *
+ * @param data 数组
+ * @param count 元素数量
+ */
+static void insertion_sort_double(double* data, size_t count) {
+    for (size_t i = 1; i < count; i++) {
+        double key = data[i];
+        size_t j = i;
+        while (j > 0 && data[j - 1] > key) {
+            data[j] = data[j - 1];
+            j--;
+        }
+        data[j] = key;
+    }
+}
+
+/**
+ * @brief 通过比较函数的插入排序
+ *
+ * @param base 首元素地址
+ * @param count 元素数量
+ * @param size 元素大小
+ * @param compare 比较函数
+ */
+static void insertion_sort_compare(char* base, size_t count, size_t size, compare_fn_t compare) {
+    char key[16];
+    for (size_t i = 1; i < count; i++) {
+        memcpy(key, base + i * size, size);
+        size_t j = i;
+        while (j > 0 && compare(base + (j - 1) * size, key) > 0) {
+            memcpy(base + j * size, base + (j - 1) * size, size);
+            j--;
+        }
+        memcpy(base + j * size, key, size);
+    }
+}
+
+/**
+ * @brief 检查每个小数组是否有序
+ *
+ * @param data 数据
+ * @param arrays 小数组数量
+ * @param n 每个小数组的元素数量
+ * @param size 元素大小
+ * @param compare 比较函数
+ * @return int 全部有序返回1
+ */
+static int arrays_sorted(const char* data, size_t arrays, size_t n, size_t size, compare_fn_t compare) {
+    for (size_t a = 0; a < arrays; a++) {
+        const char* base = data + a * n * size;
+        for (size_t i = 1; i < n; i++) {
+            if (compare(base + (i - 1) * size, base + i * size) > 0) {
+                return 0;
+            }
+        }
+    }
+    return 1;
+}
+
+/**
+ * @brief 输出一行测试结果
+ *
+ * @param log_file 日志文件
+ * @param name 测试名称
+ * @param elapsed 耗时（毫秒）
+ * @param arrays 小数组数量
+ * @param ok 结果是否有序
+ */
+static void report(FILE* log_file, const char* name, long long elapsed, size_t arrays, int ok) {
+    double per_array = arrays > 0 ? elapsed * 1000000.0 / arrays : 0.0;
+    fprintf(log_file, "  %-24s %6lld ms  %7.1f ns/数组  %s\n", name, elapsed, per_array, ok ? "有序" : "错误");
+    printf("  %-24s %6lld ms  %7.1f ns/数组  %s\n", name, elapsed, per_array, ok ? "有序" : "错误");
+}
+
+/**
+ * @brief 测试int32小数组
+ *
+ * @param log_file 日志文件
+ * @param original 原始数据
+ * @param work 工作区
+ * @param n 每个小数组的元素数量
+ */
+static void test_int32(FILE* log_file, const int32_t* original, int32_t* work, size_t n) {
+    size_t arrays = TOTAL_ELEMENTS / n;
+    size_t bytes = arrays * n * sizeof(int32_t);
+
+    fprintf(log_file, "--- int32，每个数组 %zu 个元素，共 %zu 个数组 ---\n", n, arrays);
+    printf("--- int32，每个数组 %zu 个元素，共 %zu 个数组 ---\n", n, arrays);
+
+    memcpy(work, original, bytes);
+    long long start_time = get_current_time_ms_high_precision();
+    for (size_t a = 0; a < arrays; a++) {
+        insertion_sort_int32(work + a * n, n);
+    }
+    report(log_file, "类型化插入排序", get_current_time_ms_high_precision() - start_time, arrays,
+           arrays_sorted((const char*)work, arrays, n, sizeof(int32_t), compare_int32));
+
+    memcpy(work, original, bytes);
+    start_time = get_current_time_ms_high_precision();
+    for (size_t a = 0; a < arrays; a++) {
+        insertion_sort_compare((char*)(work + a * n), n, sizeof(int32_t), compare_int32);
+    }
+    report(log_file, "比较函数插入排序", get_current_time_ms_high_precision() - start_time, arrays,
+           arrays_sorted((const char*)work, arrays, n, sizeof(int32_t), compare_int32));
+
+    const unsigned int masks[2] = {0, ~0u};
+    const char* names[2] = {"simd_sort_small (无AVX2)", "simd_sort_small (AVX2)"};
+    for (int level = 0; level < 2; level++) {
+        simd_set_feature_mask(masks[level]);
+        memcpy(work, original, bytes);
+        start_time = get_current_time_ms_high_precision();
+        for (size_t a = 0; a < arrays; a++) {
+            simd_sort_small_i32(work + a * n, n);
+        }
+        report(log_file, names[level], get_current_time_ms_high_precision() - start_time, arrays,
+               arrays_sorted((const char*)work, arrays, n, sizeof(int32_t), compare_int32));
+    }
+    simd_set_feature_mask(~0u);
+
+    fprintf(log_file, "\n");
+    printf("\n");
+}
+
+/**
+ * @brief 测试double小数组
+ *
+ * @param log_file 日志文件
+ * @param original 原始数据
+ * @param work 工作区
+ * @param n 每个小数组的元素数量
+ */
+static void test_double(FILE* log_file, const double* original, double* work, size_t n) {
+    size_t arrays = TOTAL_ELEMENTS / n;
+    size_t bytes = arrays * n * sizeof(double);
+
+    fprintf(log_file, "--- double，每个数组 %zu 个元素，共 %zu 个数组 ---\n", n, arrays);
+    printf("--- double，每个数组 %zu 个元素，共 %zu 个数组 ---\n", n, arrays);
+
+    memcpy(work, original, bytes);
+    long long start_time = get_current_time_ms_high_precision();
+    for (size_t a = 0; a < arrays; a++) {
+        insertion_sort_double(work + a * n, n);
+    }
+    report(log_file, "类型化插入排序", get_current_time_ms_high_precision() - start_time, arrays,
+           arrays_sorted((const char*)work, arrays, n, sizeof(double), compare_double));
+
+    memcpy(work, original, bytes);
+    start_time = get_current_time_ms_high_precision();
+    for (size_t a = 0; a < arrays; a++) {
+        insertion_sort_compare((char*)(work + a * n), n, sizeof(double), compare_double);
+    }
+    report(log_file, "比较函数插入排序", get_current_time_ms_high_precision() - start_time, arrays,
+           arrays_sorted((const char*)work, arrays, n, sizeof(double), compare_double));
+
+    const unsigned int masks[2] = {0, ~0u};
+    const char* names[2] = {"simd_sort_small (无AVX2)", "simd_sort_small (AVX2)"};
+    for (int level = 0; level < 2; level++) {
+        simd_set_feature_mask(masks[level]);
+        memcpy(work, original, bytes);
+        start_time = get_current_time_ms_high_precision();
+        for (size_t a = 0; a < arrays; a++) {
+            simd_sort_small_f64(work + a * n, n);
+        }
+        report(log_file, names[level], get_current_time_ms_high_precision() - start_time, arrays,
+               arrays_sorted((const char*)work, arrays, n, sizeof(double), compare_double));
+    }
+    simd_set_feature_mask(~0u);
+
+    fprintf(log_file, "\n");
+    printf("\n");
+}
+
+/**
+ * @brief 运行完整的性能测试
+ */
+void run_performance_tests() {
+    FILE* log_file = fopen(LOG_FILE, "a");
+    if (log_file == NULL) {
+        printf("无法打开日志文件 %s\n", LOG_FILE);
+        return;
+    }
+
+    int32_t* ints = (int32_t*)malloc(TOTAL_ELEMENTS * sizeof(int32_t));
+    int32_t* int_work = (int32_t*)malloc(TOTAL_ELEMENTS * sizeof(int32_t));
+    double* doubles = (double*)malloc(TOTAL_ELEMENTS * sizeof(double));
+    double* double_work = (double*)malloc(TOTAL_ELEMENTS * sizeof(double));
+    if (ints == NULL || int_work == NULL || doubles == NULL || double_work == NULL) {
+        printf("错误: 无法创建测试数据\n");
+        free(ints);
+        free(int_work);
+        free(doubles);
+        free(double_work);
+        fclose(log_file);
+        return;
+    }
+    for (int i = 0; i < TOTAL_ELEMENTS; i++) {
+        ints[i] = (int32_t)random_int64(-1000000000LL, 1000000000LL);
+        doubles[i] = (double)random_int64(-1000000000LL, 1000000000LL) / 1000.0;
+    }
+
+    fprintf(log_file, "\n=== 小数组排序网络性能测试报告 ===\n");
+    fprintf(log_file, "测试时间: %s", ctime(&(time_t){time(NULL)}));
+    fprintf(log_file, "元素总数: %d\n\n", TOTAL_ELEMENTS);
+
+    printf("开始小数组排序网络性能测试...\n");
+    printf("结果将保存到 %s\n\n", LOG_FILE);
+
+    const size_t sizes[6] = {2, 4, 8, 16, 24, 32};
+    for (int s = 0; s < 6; s++) {
+        test_int32(log_file, ints, int_work, sizes[s]);
+    }
+    for (int s = 0; s < 6; s++) {
+        test_double(log_file, doubles, double_work, sizes[s]);
+    }
+
+    fprintf(log_file, "=== 测试完成 ===\n\n");
+    printf("=== 测试完成 ===\n");
+
+    free(ints);
+    free(int_work);
+    free(doubles);
+    free(double_work);
+    fclose(log_file);
+}
+
+/**
+ * @brief 显示帮助信息
+ */
+void show_help() {
+    printf("小数组排序网络性能测试程序\n");
+    printf("用法: ./sorting_network_performance_test [选项]\n");
+    printf("选项:\n");
+    printf("  -h, --help     显示帮助信息\n");
+    printf("  -r, --run      运行性能测试\n");
+    printf("  -c, --clear    清空日志文件\n");
+    printf("\n");
+    printf("  测试结果将保存到 %s 文件中\n", LOG_FILE);
+}
+
+/**
+ * @brief 主函数
+ *
+ * @param argc 参数个数
+ * @param argv 参数数组
+ * @return int 程序退出码
+ */
+int main(int argc, char* argv[]) {
+    srand((unsigned int)time(NULL));
+
+    if (argc < 2) {
+        show_help();
+        return 0;
+    }
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-h") == 0 || strcmp(argv[i], "--help") == 0) {
+            show_help();
+            return 0;
+        } else if (strcmp(argv[i], "-r") == 0 || strcmp(argv[i], "--run") == 0) {
+            run_performance_tests();
+            return 0;
+        } else if (strcmp(argv[i], "-c") == 0 || strcmp(argv[i], "--clear") == 0) {
+            FILE* log_file = fopen(LOG_FILE, "w");
+            if (log_file) {
+                fclose(log_file);
+                printf("日志文件 %s 已清空\n", LOG_FILE);
+            }
+            return 0;
+        } else {
+            printf("未知选项: %s\n", argv[i]);
+            show_help();
+            return 1;
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,296 @@
+/**
+ * @file thread_pool_performance_test.c
+ * @brief 线程池性能测试
+ * @version 0.1
+ * @date 2025-09-23
+ *
+ * @copyright Copyright (c) 2025
+ *
+ * 本文件测试工作窃取线程池在细粒度任务下的调度性能，包括：
+ * - fork/join递归斐波那契（大量极小任务，考察派生与窃取开销）
+ * - 递归分治求和（任务大小不均衡时的负载均衡）
+ * - 外部线程批量提交独立任务的吞吐量
+ * - 绑定CPU与不绑定CPU的对比
+ *
+ * 使用utils中的高精度时间函数计算耗时，并将结果输出到日志文件中
+ */
+
+#include "cstl.h"
+#include "common/utils.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define LOG_FILE "thread_pool_performance.log"
+#define FIB_N 36
+#define FIB_CUTOFF 16
+#define SUM_ELEMENTS 20000000
+#define SUM_CUTOFF 4096
+#define SUBMIT_TASKS 1000000
+
+/**
+ * @brief 斐波那契任务参数
+ */
+typedef struct fib_task_t {
+    thread_pool_t* pool;
+    int n;
+    long long result;
+} fib_task_t;
+
+/**
+ * @brief 分治求和任务参数
+ */
+typedef struct sum_task_t {
+    thread_pool_t* pool;
+    const int64_t* data;
+    size_t count;
+    int64_t result;
+} sum_task_t;
+
+/**
+ * @brief 顺序计算斐波那契数
+ *
+ * @param n 序号
+ * @return long long 斐波那契数
+ */
+static long long fib_sequential(int n) {
+    return n < 2 ? n : fib_sequential(n - 1) + fib_sequential(n - 2);
+}
+
+/**
+ * @brief fork/join斐波那契任务
+ *
+ * @param arg fib_task_t指针
+ */
+static void fib_parallel(void* arg) {
+    fib_task_t* task = (fib_task_t*)arg;
+    if (task->n < FIB_CUTOFF) {
+        task->result = fib_sequential(task->n);
+        return;
+    }
+
+    fib_task_t left = {task->pool, task->n - 1, 0};
+    fib_task_t right = {task->pool, task->n - 2, 0};
+    thread_task_group_t group;
+    thread_task_group_init(&group, task->pool);
+    thread_task_group_run(&group, fib_parallel, &left);
+    fib_parallel(&right);
+    thread_task_group_wait(&group);
+    task->result = left.result + right.result;
+}
+
+/**
+ * @brief 分治求和任务，左半部分派生，右半部分在当前线程执行
+ *
+ * @param arg sum_task_t指针
+ */
+static void sum_parallel(void* arg) {
+    sum_task_t* task = (sum_task_t*)arg;
+    if (task->count <= SUM_CUTOFF) {
+        int64_t sum = 0;
+        for (size_t i = 0; i < task->count; i++) {
+            sum += task->data[i];
+        }
+        task->result = sum;
+        return;
+    }
+
+    size_t half = task->count / 2;
+    sum_task_t left = {task->pool, task->data, half, 0};
+    sum_task_t right = {task->pool, task->data + half, task->count - half, 0};
+    thread_task_group_t group;
+    thread_task_group_init(&group, task->pool);
+    thread_task_group_run(&group, sum_parallel, &left);
+    sum_parallel(&right);
+    thread_task_group_wait(&group);
+    task->result = left.result + right.result;
+}
+
+/**
+ * @brief 空任务，用于测量提交开销
+ *
+ * @param arg 未使用
+ */
+static void empty_task(void* arg) {
+    (void)arg;
+}
+
+/**
+ * @brief 在一个线程池上运行全部测试
+ *
+ * @param log_file 日志文件
+ * @param pool 线程池
+ * @param data 求和数据
+ * @param fib_expected 期望的斐波那契结果
+ * @param fib_baseline 顺序斐波那契耗时
+ * @param sum_baseline 顺序求和耗时
+ * @param expected_sum 期望的求和结果
+ */
+static void test_pool(FILE* log_file, thread_pool_t* pool, const int64_t* data, long long fib_expected,
+                      long long fib_baseline, long long sum_baseline, int64_t expected_sum) {
+    // fork/join斐波那契
+    fib_task_t fib = {pool, FIB_N, 0};
+    long long start_time = get_current_time_ms_high_precision();
+    fib_parallel(&fib);
+    long long elapsed = get_current_time_ms_high_precision() - start_time;
+    fprintf(log_file, "  fib(%d) 任务组      %5lld ms  加速比 %.2f\n", FIB_N, elapsed,
+            elapsed > 0 ? (double)fib_baseline / elapsed : 0.0);
+    printf("  fib(%d) 任务组      %5lld ms  加速比 %.2f\n", FIB_N, elapsed,
+           elapsed > 0 ? (double)fib_baseline / elapsed : 0.0);
+    if (fib.result != fib_expected) {
+        fprintf(log_file, "  错误: 斐波那契结果不一致!\n");
+        printf("  错误: 斐波那契结果不一致!\n");
+    }
+
+    // 分治求和
+    sum_task_t sum = {pool, data, SUM_ELEMENTS, 0};
+    start_time = get_current_time_ms_high_precision();
+    sum_parallel(&sum);
+    elapsed = get_current_time_ms_high_precision() - start_time;
+    fprintf(log_file, "  分治求和 任务组      %5lld ms  加速比 %.2f\n", elapsed,
+            elapsed > 0 ? (double)sum_baseline / elapsed : 0.0);
+    printf("  分治求和 任务组      %5lld ms  加速比 %.2f\n", elapsed,
+           elapsed > 0 ? (double)sum_baseline / elapsed : 0.0);
+    if (sum.result != expected_sum) {
+        fprintf(log_file, "  错误: 求和结果不一致!\n");
+        printf("  错误: 求和结果不一致!\n");
+    }
+
+    // 外部线程批量提交，经由注入队列分发
+    thread_task_group_t group;
+    thread_task_group_init(&group, pool);
+    start_time = get_current_time_ms_high_precision();
+    for (size_t i = 0; i < SUBMIT_TASKS; i++) {
+        thread_task_group_run(&group, empty_task, NULL);
+    }
+    thread_task_group_wait(&group);
+    elapsed = get_current_time_ms_high_precision() - start_time;
+    fprintf(log_file, "  外部提交 %d 个任务  %5lld ms  (%.2f us/任务)\n", SUBMIT_TASKS, elapsed,
+            elapsed * 1000.0 / SUBMIT_TASKS);
+    printf("  外部提交 %d 个任务  %5lld ms  (%.2f us/任务)\n", SUBMIT_TASKS, elapsed,
+           elapsed * 1000.0 / SUBMIT_TASKS);
+}
+
+/**
+ * @brief 运行完整的性能测试
+ */
+void run_performance_tests() {
+    FILE* log_file = fopen(LOG_FILE, "a");
+    if (log_file == NULL) {
+        printf("无法打开日志文件 %s\n", LOG_FILE);
+        return;
+    }
+
+    size_t workers = thread_hardware_concurrency();
+    fprintf(log_file, "\n=== 线程池性能测试报告 ===\n");
+    fprintf(log_file, "测试时间: %s", ctime(&(time_t){time(NULL)}));
+    fprintf(log_file, "硬件线程: %zu 个\n\n", workers);
+    printf("开始线程池性能测试 (%zu 个硬件线程)...\n", workers);
+    printf("结果将保存到 %s\n\n", LOG_FILE);
+
+    int64_t* data = (int64_t*)malloc(SUM_ELEMENTS * sizeof(int64_t));
+    if (data == NULL) {
+        printf("错误: 无法创建测试数据\n");
+        fclose(log_file);
+        return;
+    }
+    for (size_t i = 0; i < SUM_ELEMENTS; i++) {
+        data[i] = random_int64(0, 1000);
+    }
+
+    // 顺序基准
+    long long start_time = get_current_time_ms_high_precision();
+    long long fib_result = fib_sequential(FIB_N);
+    long long fib_baseline = get_current_time_ms_high_precision() - start_time;
+
+    start_time = get_current_time_ms_high_precision();
+    int64_t expected_sum = 0;
+    for (size_t i = 0; i < SUM_ELEMENTS; i++) {
+        expected_sum += data[i];
+    }
+    long long sum_baseline = get_current_time_ms_high_precision() - start_time;
+
+    fprintf(log_file, "--- 顺序基准 ---\n  fib(%d) = %lld  %5lld ms\n  求和 %d 个元素  %5lld ms\n",
+            FIB_N, fib_result, fib_baseline, SUM_ELEMENTS, sum_baseline);
+    printf("--- 顺序基准 ---\n  fib(%d) = %lld  %5lld ms\n  求和 %d 个元素  %5lld ms\n",
+           FIB_N, fib_result, fib_baseline, SUM_ELEMENTS, sum_baseline);
+
+    for (int pin = 0; pin <= 1; pin++) {
+        thread_pool_options_t options;
+        memset(&options, 0, sizeof(options));
+        options.pin_threads = pin;
+        thread_pool_t* pool = thread_pool_create_ex(&options);
+        if (pool == NULL) {
+            printf("错误: 无法创建线程池\n");
+            continue;
+        }
+
+        fprintf(log_file, "\n--- 工作窃取线程池 (%zu 个线程, %s) ---\n", thread_pool_size(pool),
+                pin ? "绑定CPU" : "不绑定CPU");
+        printf("\n--- 工作窃取线程池 (%zu 个线程, %s) ---\n", thread_pool_size(pool),
+               pin ? "绑定CPU" : "不绑定CPU");
+        test_pool(log_file, pool, data, fib_result, fib_baseline, sum_baseline, expected_sum);
+        thread_pool_destroy(pool);
+    }
+
+    free(data);
+
+    fprintf(log_file, "\n=== 测试完成 ===\n\n");
+    printf("\n=== 测试完成 ===\n");
+
+    fclose(log_file);
+}
+
+/**
+ * @brief 显示帮助信息
+ */
+void show_help() {
+    printf("线程池性能测试程序\n");
+    printf("用法: ./thread_pool_performance_test [选项]\n");
+    printf("选项:\n");
+    printf("  -h, --help     显示帮助信息\n");
+    printf("  -r, --run      运行性能测试\n");
+    printf("  -c, --clear    清空日志文件\n");
+    printf("\n");
+    printf("  测试结果将保存到 %s 文件中\n", LOG_FILE);
+}
+
+/**
+ * @brief 主函数
+ *
+ * @param argc 参数个数
+ * @param argv 参数数组
+ * @return int 程序退出码
+ */
+int main(int argc, char* argv[]) {
+    srand((unsigned int)time(NULL));
+
+    if (argc < 2) {
+        show_help();
+        return 0;
+    }
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-h") == 0 || strcmp(argv[i], "--help") == 0) {
+            show_help();
+            return 0;
+        } else if (strcmp(argv[i], "-r") == 0 || strcmp(argv[i], "--run") == 0) {
+            run_performance_tests();
+            return 0;
+        } else if (strcmp(argv[i], "-c") == 0 || strcmp(argv[i], "--clear") == 0) {
+            FILE* log_file = fopen(LOG_FILE, "w");
+            if (log_file) {
+                fclose(log_file);
+                printf("日志文件 %s 已清空\n", LOG_FILE);
+            }
+            return 0;
+        } else {
+            printf("未知选项: %s\n", argv[i]);
+            show_help();
+            return 1;
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,471 @@
+/**
+ * @file ulist_performance_test.c
+ * @brief 展开链表性能测试
+ * @version 0.1
+ * @date 2025-10-12
+ *
+ * @copyright Copyright (c) 2025
+ *
+ * 本文件在1K到1M个int64元素上对比vector_t、list_t和ulist_t：
+ * - 逐个push_back建立容器，ulist_t另外测试ulist_append批量追加
+ * - 用迭代器遍历全部元素，以及algo_count在迭代器范围上的完整扫描
+ * - 按随机索引插入和删除元素（list_t按索引定位是O(n)，不参与）
+ * - 随机插入删除之后再次遍历
+ *
+ * 元素较少时重复遍历，使每种容器遍历的元素总数大致相同。
+ * 使用utils中的高精度时间函数计算耗时，并将结果输出到日志文件中
+ */
+
+#include "cstl.h"
+#include "common/utils.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define LOG_FILE "ulist_performance.log"
+#define TRAVERSE_ELEMENTS 20000000
+#define MAX_EDIT_OPS 20000
+#define MISSING_VALUE (-1)
+
+/**
+ * @brief 被测容器
+ */
+typedef enum {
+    CONTAINER_VECTOR, /**< vector_t */
+    CONTAINER_LIST,   /**< list_t */
+    CONTAINER_ULIST,  /**< ulist_t */
+    CONTAINER_COUNT
+} container_t;
+
+/**
+ * @brief 测试阶段
+ */
+typedef enum {
+    PHASE_BUILD,            /**< 逐个push_back */
+    PHASE_APPEND,           /**< 批量追加，仅ulist_t */
+    PHASE_TRAVERSE,         /**< 迭代器遍历 */
+    PHASE_ALGO_COUNT,       /**< algo_count完整扫描 */
+    PHASE_INSERT,           /**< 随机索引插入 */
+    PHASE_ERASE,            /**< 随机索引删除 */
+    PHASE_TRAVERSE_EDITED,  /**< 插入删除之后遍历 */
+    PHASE_COUNT
+} phase_t;
+
+/**
+ * @brief 阶段名称
+ */
+static const char* phase_names[PHASE_COUNT] = {
+    "逐个push_back", "ulist_append", "迭代器遍历", "algo_count扫描",
+    "随机索引插入", "随机索引删除", "插入删除后遍历"
+};
+
+/**
+ * @brief 一次测试的参数
+ */
+typedef struct {
+    size_t size;             /**< 元素数量 */
+    size_t reps;             /**< 遍历和扫描的重复次数 */
+    size_t edit_ops;         /**< 随机插入和删除的次数 */
+    const int64_t* values;   /**< 初始元素 */
+    const size_t* insert_at; /**< 每次插入的索引 */
+    const size_t* erase_at;  /**< 每次删除的索引 */
+} bench_params_t;
+
+/**
+ * @brief int64比较函数
+ *
+ * @param a 第一个元素指针
+ * @param b 第二个元素指针
+ * @return int 比较结果
+ */
+static int compare_int64(const void* a, const void* b) {
+    int64_t x = *(const int64_t*)a;
+    int64_t y = *(const int64_t*)b;
+    return (x > y) - (x < y);
+}
+
+/**
+ * @brief 用迭代器遍历并累加全部元素
+ *
+ * @param begin 起始迭代器，遍历结束后销毁
+ * @return int64_t 元素之和
+ */
+static int64_t traverse_sum(iterator_t* begin) {
+    int64_t sum = 0;
+    while (begin->valid(begin)) {
+        sum += *(const int64_t*)begin->current;
+        begin->next(begin);
+    }
+    iterator_destroy(begin);
+    return sum;
+}
+
+/**
+ * @brief 用algo_count统计不存在的元素，扫描整个范围
+ *
+ * @param begin 起始迭代器，统计结束后销毁
+ * @param end 结束迭代器，统计结束后销毁
+ * @return int64_t 匹配数量
+ */
+static int64_t count_missing(iterator_t* begin, iterator_t* end) {
+    int64_t missing = MISSING_VALUE;
+    size_t count = 0;
+    algo_count(begin, end, &missing, compare_int64, &count);
+    iterator_destroy(begin);
+    iterator_destroy(end);
+    return (int64_t)count;
+}
+
+/**
+ * @brief 测试vector_t
+ *
+ * @param params 测试参数
+ * @param elapsed 输出参数，各阶段耗时，不适用的阶段为-1
+ * @param checksums 输出参数，各阶段校验值
+ */
+static void run_vector(const bench_params_t* params, long long* elapsed, int64_t* checksums) {
+    vector_t* vector = vector_create(sizeof(int64_t), 0, NULL, NULL);
+    if (vector == NULL) {
+        return;
+    }
+
+    long long start_time = get_current_time_ms_high_precision();
+    for (size_t i = 0; i < params->size; i++) {
+        vector_push_back(vector, &params->values[i]);
+    }
+    elapsed[PHASE_BUILD] = get_current_time_ms_high_precision() - start_time;
+    checksums[PHASE_BUILD] = (int64_t)vector_size(vector);
+
+    int64_t sum = 0;
+    start_time = get_current_time_ms_high_precision();
+    for (size_t r = 0; r < params->reps; r++) {
+        sum += traverse_sum(vector_begin(vector));
+    }
+    elapsed[PHASE_TRAVERSE] = get_current_time_ms_high_precision() - start_time;
+    checksums[PHASE_TRAVERSE] = sum;
+
+    int64_t found = 0;
+    start_time = get_current_time_ms_high_precision();
+    for (size_t r = 0; r < params->reps; r++) {
+        found += count_missing(vector_begin(vector), vector_end(vector));
+    }
+    elapsed[PHASE_ALGO_COUNT] = get_current_time_ms_high_precision() - start_time;
+    checksums[PHASE_ALGO_COUNT] = found;
+
+    start_time = get_current_time_ms_high_precision();
+    for (size_t k = 0; k < params->edit_ops; k++) {
+        int64_t value = (int64_t)(params->size + k);
+        vector_insert(vector, params->insert_at[k], &value);
+    }
+    elapsed[PHASE_INSERT] = get_current_time_ms_high_precision() - start_time;
+    checksums[PHASE_INSERT] = (int64_t)vector_size(vector);
+
+    start_time = get_current_time_ms_high_precision();
+    for (size_t k = 0; k < params->edit_ops; k++) {
+        vector_erase(vector, params->erase_at[k]);
+    }
+    elapsed[PHASE_ERASE] = get_current_time_ms_high_precision() - start_time;
+    checksums[PHASE_ERASE] = (int64_t)vector_size(vector);
+
+    sum = 0;
+    start_time = get_current_time_ms_high_precision();
+    for (size_t r = 0; r < params->reps; r++) {
+        sum += traverse_sum(vector_begin(vector));
+    }
+    elapsed[PHASE_TRAVERSE_EDITED] = get_current_time_ms_high_precision() - start_time;
+    checksums[PHASE_TRAVERSE_EDITED] = sum;
+
+    vector_destroy(vector);
+}
+
+/**
+ * @brief 测试list_t
+ *
+ * @param params 测试参数
+ * @param elapsed 输出参数，各阶段耗时，不适用的阶段为-1
+ * @param checksums 输出参数，各阶段校验值
+ */
+static void run_list(const bench_params_t* params, long long* elapsed, int64_t* checksums) {
+    list_t* list = list_create(sizeof(int64_t), NULL, NULL);
+    if (list == NULL) {
+        return;
+    }
+
+    long long start_time = get_current_time_ms_high_precision();
+    for (size_t i = 0; i < params->size; i++) {
+        list_push_back(list, &params->values[i]);
+    }
+    elapsed[PHASE_BUILD] = get_current_time_ms_high_precision() - start_time;
+    checksums[PHASE_BUILD] = (int64_t)list_size(list);
+
+    int64_t sum = 0;
+    start_time = get_current_time_ms_high_precision();
+    for (size_t r = 0; r < params->reps; r++) {
+        sum += traverse_sum(list_begin(list));
+    }
+    elapsed[PHASE_TRAVERSE] = get_current_time_ms_high_precision() - start_time;
+    checksums[PHASE_TRAVERSE] = sum;
+
+    int64_t found = 0;
+    start_time = get_current_time_ms_high_precision();
+    for (size_t r = 0; r < params->reps; r++) {
+        found += count_missing(list_begin(list), list_end(list));
+    }
+    elapsed[PHASE_ALGO_COUNT] = get_current_time_ms_high_precision() - start_time;
+    checksums[PHASE_ALGO_COUNT] = found;
+
+    list_destroy(list);
+}
+
+/**
+ * @brief 测试ulist_t
+ *
+ * @param params 测试参数
+ * @param elapsed 输出参数，各阶段耗时
+ * @param checksums 输出参数，各阶段校验值
+ */
+static void run_ulist(const bench_params_t* params, long long* elapsed, int64_t* checksums) {
+    ulist_t* list = ulist_create(sizeof(int64_t), 0, NULL, NULL);
+    if (list == NULL) {
+        return;
+    }
+
+    long long start_time = get_current_time_ms_high_precision();
+    for (size_t i = 0; i < params->size; i++) {
+        ulist_push_back(list, &params->values[i]);
+    }
+    elapsed[PHASE_BUILD] = get_current_time_ms_high_precision() - start_time;
+    checksums[PHASE_BUILD] = (int64_t)ulist_size(list);
+
+    /* 用批量追加重新建立，后续阶段在它上面进行 */
+    ulist_clear(list);
+    start_time = get_current_time_ms_high_precision();
+    ulist_append(list, params->values, params->size);
+    elapsed[PHASE_APPEND] = get_current_time_ms_high_precision() - start_time;
+    checksums[PHASE_APPEND] = (int64_t)ulist_size(list);
+
+    int64_t sum = 0;
+    start_time = get_current_time_ms_high_precision();
+    for (size_t r = 0; r < params->reps; r++) {
+        sum += traverse_sum(ulist_begin(list));
+    }
+    elapsed[PHASE_TRAVERSE] = get_current_time_ms_high_precision() - start_time;
+    checksums[PHASE_TRAVERSE] = sum;
+
+    int64_t found = 0;
+    start_time = get_current_time_ms_high_precision();
+    for (size_t r = 0; r < params->reps; r++) {
+        found += count_missing(ulist_begin(list), ulist_end(list));
+    }
+    elapsed[PHASE_ALGO_COUNT] = get_current_time_ms_high_precision() - start_time;
+    checksums[PHASE_ALGO_COUNT] = found;
+
+    start_time = get_current_time_ms_high_precision();
+    for (size_t k = 0; k < params->edit_ops; k++) {
+        int64_t value = (int64_t)(params->size + k);
+        ulist_insert(list, params->insert_at[k], &value);
+    }
+    elapsed[PHASE_INSERT] = get_current_time_ms_high_precision() - start_time;
+    checksums[PHASE_INSERT] = (int64_t)ulist_size(list);
+
+    start_time = get_current_time_ms_high_precision();
+    for (size_t k = 0; k < params->edit_ops; k++) {
+        ulist_erase(list, params->erase_at[k]);
+    }
+    elapsed[PHASE_ERASE] = get_current_time_ms_high_precision() - start_time;
+    checksums[PHASE_ERASE] = (int64_t)ulist_size(list);
+
+    sum = 0;
+    start_time = get_current_time_ms_high_precision();
+    for (size_t r = 0; r < params->reps; r++) {
+        sum += traverse_sum(ulist_begin(list));
+    }
+    elapsed[PHASE_TRAVERSE_EDITED] = get_current_time_ms_high_precision() - start_time;
+    checksums[PHASE_TRAVERSE_EDITED] = sum;
+
+    ulist_destroy(list);
+}
+
+/**
+ * @brief 格式化耗时，不适用的阶段显示为"-"
+ *
+ * @param buffer 输出缓冲区
+ * @param size 缓冲区大小
+ * @param elapsed 耗时，小于0表示不适用
+ */
+static void format_elapsed(char* buffer, size_t size, long long elapsed) {
+    if (elapsed >= 0) {
+        snprintf(buffer, size, "%lld ms", elapsed);
+    } else {
+        snprintf(buffer, size, "-");
+    }
+}
+
+/**
+ * @brief 测试指定大小的容器
+ *
+ * @param log_file 日志文件
+ * @param size 元素数量
+ */
+static void test_size(FILE* log_file, size_t size) {
+    bench_params_t params;
+    params.size = size;
+    params.reps = size < TRAVERSE_ELEMENTS ? TRAVERSE_ELEMENTS / size : 1;
+    params.edit_ops = size < MAX_EDIT_OPS ? size : MAX_EDIT_OPS;
+
+    int64_t* values = (int64_t*)malloc(size * sizeof(int64_t));
+    size_t* insert_at = (size_t*)malloc(params.edit_ops * sizeof(size_t));
+    size_t* erase_at = (size_t*)malloc(params.edit_ops * sizeof(size_t));
+    if (values == NULL || insert_at == NULL || erase_at == NULL) {
+        printf("错误: 无法创建测试数据\n");
+        free(values);
+        free(insert_at);
+        free(erase_at);
+        return;
+    }
+
+    for (size_t i = 0; i < size; i++) {
+        values[i] = (int64_t)i;
+    }
+
+    /* 第k次插入时有size + k个元素，第k次删除时有size + edit_ops - k个元素 */
+    for (size_t k = 0; k < params.edit_ops; k++) {
+        insert_at[k] = (size_t)random_int64(0, (int64_t)(size + k));
+        erase_at[k] = (size_t)random_int64(0, (int64_t)(size + params.edit_ops - k - 1));
+    }
+    params.values = values;
+    params.insert_at = insert_at;
+    params.erase_at = erase_at;
+
+    long long elapsed[CONTAINER_COUNT][PHASE_COUNT];
+    int64_t checksums[CONTAINER_COUNT][PHASE_COUNT];
+    for (int c = 0; c < CONTAINER_COUNT; c++) {
+        for (int phase = 0; phase < PHASE_COUNT; phase++) {
+            elapsed[c][phase] = -1;
+            checksums[c][phase] = 0;
+        }
+    }
+
+    run_vector(&params, elapsed[CONTAINER_VECTOR], checksums[CONTAINER_VECTOR]);
+    run_list(&params, elapsed[CONTAINER_LIST], checksums[CONTAINER_LIST]);
+    run_ulist(&params, elapsed[CONTAINER_ULIST], checksums[CONTAINER_ULIST]);
+
+    fprintf(log_file, "--- %zu 个元素（遍历重复 %zu 次，插入删除各 %zu 次） ---\n",
+            size, params.reps, params.edit_ops);
+    printf("--- %zu 个元素（遍历重复 %zu 次，插入删除各 %zu 次） ---\n",
+           size, params.reps, params.edit_ops);
+    fprintf(log_file, "  %-24s %12s %12s %12s  %s\n", "阶段", "vector_t", "list_t", "ulist_t", "校验");
+    printf("  %-24s %12s %12s %12s  %s\n", "阶段", "vector_t", "list_t", "ulist_t", "校验");
+
+    for (int phase = 0; phase < PHASE_COUNT; phase++) {
+        char text[CONTAINER_COUNT][32];
+        int64_t checksum = checksums[CONTAINER_ULIST][phase];
+        const char* status = "一致";
+        for (int c = 0; c < CONTAINER_COUNT; c++) {
+            format_elapsed(text[c], sizeof(text[c]), elapsed[c][phase]);
+            if (elapsed[c][phase] >= 0 && checksums[c][phase] != checksum) {
+                status = "不一致";
+            }
+        }
+        if (phase == PHASE_APPEND && checksum != checksums[CONTAINER_ULIST][PHASE_BUILD]) {
+            status = "不一致";
+        }
+        fprintf(log_file, "  %-24s %12s %12s %12s  %s %lld\n", phase_names[phase],
+                text[CONTAINER_VECTOR], text[CONTAINER_LIST], text[CONTAINER_ULIST], status, (long long)checksum);
+        printf("  %-24s %12s %12s %12s  %s %lld\n", phase_names[phase],
+               text[CONTAINER_VECTOR], text[CONTAINER_LIST], text[CONTAINER_ULIST], status, (long long)checksum);
+    }
+
+    fprintf(log_file, "\n");
+    printf("\n");
+
+    free(values);
+    free(insert_at);
+    free(erase_at);
+}
+
+/**
+ * @brief 运行完整的性能测试
+ */
+void run_performance_tests() {
+    FILE* log_file = fopen(LOG_FILE, "a");
+    if (log_file == NULL) {
+        printf("无法打开日志文件 %s\n", LOG_FILE);
+        return;
+    }
+
+    ulist_t* probe = ulist_create(sizeof(int64_t), 0, NULL, NULL);
+    size_t node_capacity = probe != NULL ? probe->node_capacity : 0;
+    ulist_destroy(probe);
+
+    fprintf(log_file, "\n=== 展开链表性能测试报告 ===\n");
+    fprintf(log_file, "测试时间: %s", ctime(&(time_t){time(NULL)}));
+    fprintf(log_file, "元素类型: int64，ulist_t每个节点 %zu 个元素\n\n", node_capacity);
+
+    printf("开始展开链表性能测试...\n");
+    printf("结果将保存到 %s\n\n", LOG_FILE);
+
+    test_size(log_file, 1000);
+    test_size(log_file, 10000);
+    test_size(log_file, 100000);
+    test_size(log_file, 1000000);
+
+    fprintf(log_file, "=== 测试完成 ===\n\n");
+    printf("=== 测试完成 ===\n");
+
+    fclose(log_file);
+}
+
+/**
+ * @brief 显示帮助信息
+ */
+void show_help() {
+    printf("展开链表性能测试程序\n");
+    printf("用法: ./ulist_performance_test [选项]\n");
+    printf("选项:\n");
+    printf("  -h, --help     显示帮助信息\n");
+    printf("  -r, --run      运行性能测试\n");
+    printf("  -c, --clear    清空日志文件\n");
+    printf("\n");
+    printf("  测试结果将保存到 %s 文件中\n", LOG_FILE);
+}
+
+/**
+ * @brief 主函数
+ *
+ * @param argc 参数个数
+ * @param argv 参数数组
+ * @return int 程序退出码
+ */
+int main(int argc, char* argv[]) {
+    srand((unsigned int)time(NULL));
+
+    if (argc < 2) {
+        show_help();
+        return 0;
+    }
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-h") == 0 || strcmp(argv[i], "--help") == 0) {
+            show_help();
+            return 0;
+        } else if (strcmp(argv[i], "-r") == 0 || strcmp(argv[i], "--run") == 0) {
+            run_performance_tests();
+            return 0;
+        } else if (strcmp(argv[i], "-c") == 0 || strcmp(argv[i], "--clear") == 0) {
+            FILE* log_file = fopen(LOG_FILE, "w");
+            if (log_file) {
+                fclose(log_file);
+                printf("日志文件 %s 已清空\n", LOG_FILE);
+            }
+            return 0;
+        } else {
+            printf("未知选项: %s\n", argv[i]);
+            show_help();
+            return 1;
+        }
+    }
+
+    return 0;
+}
@@ -37,6 +37,19 @@
 
 /* 包含算法模块 */
 #include "cstl/algo.h"
+#include "cstl/simd.h"
+#include "cstl/random.h"
+#include "cstl/external_sort.h"
+#include "cstl/range.h"
+#include "cstl/ilist.h"
+#include "cstl/alist.h"
+#include "cstl/ulist.h"
+#include "cstl/colony.h"
+#include "cstl/slot_map.h"
+#include "cstl/flat_map.h"
+
+/* 包含并发模块 */
+#include "cstl/thread_pool.h"
 
 #ifdef __cplusplus
 extern "C" {
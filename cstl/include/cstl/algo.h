@@ -11,6 +11,8 @@
 
 #include "cstl/common.h"
 #include "cstl/iterator.h"
+#include "cstl/vector.h"
+#include "cstl/random.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -25,14 +27,6 @@ extern "C" {
  */
 typedef int (*compare_fn_t)(const void* a, const void* b);
 
-/**
- * @brief 谓词函数指针类型
- * 
- * @param element 元素指针
- * @return int 如果满足条件返回非零，否则返回零
- */
-typedef int (*predicate_fn_t)(const void* element);
-
 /**
  * @brief 一元操作函数指针类型
  * 
@@ -48,6 +42,25 @@ typedef void (*unary_op_fn_t)(void* element);
  */
 typedef void (*binary_op_fn_t)(void* a, const void* b);
 
+/**
+ * @brief 哈希函数指针类型
+ * 
+ * 相等的元素必须得到相同的哈希值。结果会再经过一次混合，
+ * 因此直接返回整数ID等分布不均匀的值也可以。
+ * 
+ * @param element 元素指针
+ * @return uint64_t 哈希值
+ */
+typedef uint64_t (*hash_fn_t)(const void* element);
+
+/**
+ * @brief 键提取函数指针类型
+ * 
+ * @param element 元素指针
+ * @param key 输出参数，写入key_width字节的键
+ */
+typedef void (*key_fn_t)(const void* element, void* key);
+
 /**
  * @brief 排序算法枚举
  */
@@ -58,9 +71,30 @@ typedef enum {
     SORT_INSERT = 3    /**< 插入排序 */
 } sort_algorithm_t;
 
+/**
+ * @brief 排序键的类型
+ */
+typedef enum {
+    SORT_KEY_INT = 0,   /**< 有符号整数，按本机字节序存放，宽度为1/2/4/8 */
+    SORT_KEY_UINT = 1,  /**< 无符号整数，按本机字节序存放，宽度为1/2/4/8 */
+    SORT_KEY_FLOAT = 2, /**< IEEE浮点数，宽度为4/8，-0排在+0之前，NaN按符号排在两端 */
+    SORT_KEY_BYTES = 3  /**< 字节串，按memcmp的字典序比较，宽度任意 */
+} sort_key_type_t;
+
+/**
+ * @brief 排序方向
+ */
+typedef enum {
+    SORT_ASCENDING = 0, /**< 升序 */
+    SORT_DESCENDING = 1 /**< 降序 */
+} sort_order_t;
+
 /**
  * @brief 对容器进行排序
  * 
+ * 元素大于128字节时不再逐次交换元素，而是先用algo_argsort求出排列，
+ * 再用algo_permute把每个元素最多移动一次；这种方式是稳定的。
+ * 
  * @param begin 起始迭代器
  * @param end 结束迭代器
  * @param compare 比较函数指针
@@ -79,6 +113,69 @@ error_code_t algo_sort(iterator_t* begin, iterator_t* end, compare_fn_t compare,
  */
 error_code_t algo_stable_sort(iterator_t* begin, iterator_t* end, compare_fn_t compare);
 
+/**
+ * @brief 间接排序，求出使范围有序的下标排列
+ * 
+ * 只排序元素指针，不移动元素。排序稳定，排序后第i个元素是原范围中下标为
+ * indices[i]的元素。
+ * 
+ * @param begin 起始迭代器
+ * @param end 结束迭代器
+ * @param compare 比较函数指针
+ * @param indices 输出参数，元素大小为sizeof(size_t)的向量，调整为元素数量后写入下标
+ * @return error_code_t 错误码
+ */
+error_code_t algo_argsort(iterator_t* begin, iterator_t* end, compare_fn_t compare, vector_t* indices);
+
+/**
+ * @brief 按下标排列原地重排范围
+ * 
+ * 重排后第i个位置是原来下标为indices[i]的元素。按置换的环移动元素，
+ * 每个元素最多移动一次，每个环额外使用一个元素大小的临时缓冲区。
+ * 
+ * @param begin 起始迭代器
+ * @param end 结束迭代器
+ * @param indices 元素大小为sizeof(size_t)的下标向量
+ * @return error_code_t 错误码，indices的数量与范围不同或不是排列时返回CSTL_ERROR_INVALID_ARGUMENT
+ */
+error_code_t algo_permute(iterator_t* begin, iterator_t* end, const vector_t* indices);
+
+/**
+ * @brief 按元素中固定偏移处的键进行稳定排序
+ * 
+ * 不经过比较函数：键先转换为保序的无符号整数，元素数量较多时使用LSD基数排序，
+ * 并跳过所有元素该字节都相同的趟。元素不超过16字节时直接移动元素，
+ * 否则排序(键, 下标)对后再重排元素。超过8字节的字节串键先按前8字节基数排序，
+ * 再对前缀相同的元素按剩余字节memcmp归并排序。
+ * 
+ * @param begin 起始迭代器
+ * @param end 结束迭代器
+ * @param key_offset 键在元素中的字节偏移
+ * @param key_width 键的字节数
+ * @param key_type 键的类型
+ * @param order 排序方向
+ * @return error_code_t 错误码，键超出元素或宽度与类型不匹配时返回CSTL_ERROR_INVALID_ARGUMENT
+ */
+error_code_t algo_sort_by_key(iterator_t* begin, iterator_t* end, size_t key_offset, size_t key_width,
+                              sort_key_type_t key_type, sort_order_t order);
+
+/**
+ * @brief 按计算得到的键进行稳定排序（Schwartzian变换）
+ * 
+ * 每个元素只调用一次key_fn，键缓存后参与排序，适合键的计算代价较高的情况。
+ * 排序方式与algo_sort_by_key相同。
+ * 
+ * @param begin 起始迭代器
+ * @param end 结束迭代器
+ * @param key_fn 键提取函数
+ * @param key_width 键的字节数
+ * @param key_type 键的类型
+ * @param order 排序方向
+ * @return error_code_t 错误码
+ */
+error_code_t algo_sort_by_computed_key(iterator_t* begin, iterator_t* end, key_fn_t key_fn, size_t key_width,
+                                       sort_key_type_t key_type, sort_order_t order);
+
 /**
  * @brief 检查容器是否已排序
  * 
@@ -96,7 +193,7 @@ error_code_t algo_is_sorted(iterator_t* begin, iterator_t* end, compare_fn_t com
  * @param begin 起始迭代器
  * @param end 结束迭代器
  * @param value 要查找的值指针
- * @param compare 比较函数指针
+ * @param compare 比较函数指针，为NULL时按位比较，向量上1/2/4/8字节的元素使用SIMD扫描
  * @param result 输出参数，存储找到的元素指针
  * @return error_code_t 错误码
  */
@@ -130,7 +227,7 @@ error_code_t algo_find_if_not(iterator_t* begin, iterator_t* end, predicate_fn_t
  * @param begin 起始迭代器
  * @param end 结束迭代器
  * @param value 要查找的值指针
- * @param compare 比较函数指针
+ * @param compare 比较函数指针，为NULL时按位比较，向量上1/2/4/8字节的元素使用SIMD扫描
  * @param count 输出参数，存储元素数量
  * @return error_code_t 错误码
  */
@@ -195,7 +292,7 @@ error_code_t algo_for_each(iterator_t* begin, iterator_t* end, unary_op_fn_t op)
  * 
  * @param begin 起始迭代器
  * @param end 结束迭代器
- * @param compare 比较函数指针
+ * @param compare 比较函数指针，为NULL时按位比较，向量上1/2/4/8字节的元素使用SIMD扫描
  * @param result 输出参数，存储找到的第一个元素指针
  * @return error_code_t 错误码
  */
@@ -237,7 +334,7 @@ error_code_t algo_find_first_not_of(iterator_t* begin1, iterator_t* end1,
  * @param begin1 第一个范围的起始迭代器
  * @param end1 第一个范围的结束迭代器
  * @param begin2 第二个范围的起始迭代器
- * @param compare 比较函数指针
+ * @param compare 比较函数指针，为NULL时按位比较，两个范围都在向量中时使用SIMD比较
  * @param equal 输出参数，存储是否相等
  * @return error_code_t 错误码
  */
@@ -281,7 +378,7 @@ error_code_t algo_ends_with(iterator_t* begin1, iterator_t* end1,
  * @param end1 第一个范围的结束迭代器
  * @param begin2 子范围的起始迭代器
  * @param end2 子范围的结束迭代器
- * @param compare 比较函数指针
+ * @param compare 比较函数指针，为NULL时按位比较，两个范围都是向量时使用首尾元素过滤或Horspool搜索
  * @param result 输出参数，存储找到的子范围起始位置
  * @return error_code_t 错误码
  */
@@ -296,7 +393,7 @@ error_code_t algo_search(iterator_t* begin1, iterator_t* end1,
  * @param end1 第一个范围的结束迭代器
  * @param begin2 子范围的起始迭代器
  * @param end2 子范围的结束迭代器
- * @param compare 比较函数指针
+ * @param compare 比较函数指针，为NULL时按位比较，两个范围都是向量时从末尾向前搜索
  * @param result 输出参数，存储找到的子范围起始位置
  * @return error_code_t 错误码
  */
@@ -508,12 +605,28 @@ error_code_t algo_rotate(iterator_t* begin, iterator_t* middle, iterator_t* end)
 /**
  * @brief 随机打乱范围
  * 
+ * 使用当前线程的生成器（rng_thread_local），O(n)。
+ * 
  * @param begin 起始迭代器
  * @param end 结束迭代器
  * @return error_code_t 错误码
  */
 error_code_t algo_shuffle(iterator_t* begin, iterator_t* end);
 
+/**
+ * @brief 使用指定的生成器随机打乱范围
+ *
+ * Fisher-Yates洗牌。连续存储的范围直接在内存上交换，
+ * 其他范围先收集元素指针，再按指针交换元素内容，两者都是O(n)。
+ * 相同的生成器状态得到相同的排列。
+ *
+ * @param begin 起始迭代器
+ * @param end 结束迭代器
+ * @param rng 生成器状态，为NULL时使用当前线程的生成器
+ * @return error_code_t 错误码
+ */
+error_code_t algo_shuffle_rng(iterator_t* begin, iterator_t* end, rng_t* rng);
+
 /**
  * @brief 对范围进行分区
  * 
@@ -629,6 +742,501 @@ error_code_t algo_next_permutation(iterator_t* begin, iterator_t* end,
 error_code_t algo_prev_permutation(iterator_t* begin, iterator_t* end, 
                                   compare_fn_t compare, int* result);
 
+/**
+ * @brief 在有序范围中查找第一个不小于给定值的位置
+ *
+ * 对向量等连续存储的范围使用无分支二分查找，其他范围按迭代器步进查找。
+ *
+ * @param begin 起始迭代器
+ * @param end 结束迭代器
+ * @param value 要查找的值指针
+ * @param compare 比较函数指针
+ * @param position 输出参数，存储相对begin的位置，所有元素都小于value时等于范围大小
+ * @return error_code_t 错误码
+ */
+error_code_t algo_lower_bound(iterator_t* begin, iterator_t* end, const void* value,
+                              compare_fn_t compare, size_t* position);
+
+/**
+ * @brief 在有序范围中查找第一个大于给定值的位置
+ *
+ * @param begin 起始迭代器
+ * @param end 结束迭代器
+ * @param value 要查找的值指针
+ * @param compare 比较函数指针
+ * @param position 输出参数，存储相对begin的位置，没有元素大于value时等于范围大小
+ * @return error_code_t 错误码
+ */
+error_code_t algo_upper_bound(iterator_t* begin, iterator_t* end, const void* value,
+                              compare_fn_t compare, size_t* position);
+
+/**
+ * @brief 在有序范围中查找等于给定值的子范围
+ *
+ * @param begin 起始迭代器
+ * @param end 结束迭代器
+ * @param value 要查找的值指针
+ * @param compare 比较函数指针
+ * @param first 输出参数，存储子范围起始位置（即lower_bound）
+ * @param last 输出参数，存储子范围结束位置（即upper_bound）
+ * @return error_code_t 错误码
+ */
+error_code_t algo_equal_range(iterator_t* begin, iterator_t* end, const void* value,
+                              compare_fn_t compare, size_t* first, size_t* last);
+
+/**
+ * @brief 检查有序范围中是否存在给定值
+ *
+ * @param begin 起始迭代器
+ * @param end 结束迭代器
+ * @param value 要查找的值指针
+ * @param compare 比较函数指针
+ * @param found 输出参数，存储是否找到
+ * @return error_code_t 错误码
+ */
+error_code_t algo_binary_search(iterator_t* begin, iterator_t* end, const void* value,
+                                compare_fn_t compare, int* found);
+
+/**
+ * @brief Eytzinger（BFS顺序）布局的只读查找表
+ *
+ * 将有序数据按完全二叉树的广度优先顺序重新排列，查找路径上的前几层
+ * 集中在少数缓存行内，并可提前预取后续层级，适合百万级以上的热点查找表。
+ */
+typedef struct algo_eytzinger_t {
+    void* data;              /**< 按BFS顺序排列的元素，下标从1开始 */
+    size_t* ranks;           /**< 每个槽位对应的原有序下标 */
+    size_t size;             /**< 元素数量 */
+    size_t element_size;     /**< 元素大小 */
+    compare_fn_t compare;    /**< 比较函数指针 */
+    void* raw;               /**< 未对齐的原始内存指针 */
+} algo_eytzinger_t;
+
+/**
+ * @brief 由有序范围构建Eytzinger布局查找表
+ *
+ * 查找表保存数据副本，构建后与源容器无关。
+ *
+ * @param begin 有序范围的起始迭代器
+ * @param end 有序范围的结束迭代器
+ * @param compare 比较函数指针
+ * @return algo_eytzinger_t* 查找表指针，失败返回NULL
+ */
+algo_eytzinger_t* algo_eytzinger_create(iterator_t* begin, iterator_t* end, compare_fn_t compare);
+
+/**
+ * @brief 销毁Eytzinger布局查找表
+ *
+ * @param layout 查找表指针
+ */
+void algo_eytzinger_destroy(algo_eytzinger_t* layout);
+
+/**
+ * @brief 在Eytzinger布局查找表中查找第一个不小于给定值的元素
+ *
+ * 请求index时需要额外访问一次下标数组，只需要元素时传NULL查找更快。
+ *
+ * @param layout 查找表指针
+ * @param value 要查找的值指针
+ * @param result 输出参数，存储找到的元素指针（指向查找表内部）
+ * @param index 输出参数，存储元素在原有序范围中的下标，可以为NULL
+ * @return error_code_t 错误码，所有元素都小于value时返回CSTL_ERROR_NOT_FOUND
+ */
+error_code_t algo_eytzinger_lower_bound(const algo_eytzinger_t* layout, const void* value,
+                                        void** result, size_t* index);
+
+/**
+ * @brief 在Eytzinger布局查找表中查找等于给定值的元素
+ *
+ * @param layout 查找表指针
+ * @param value 要查找的值指针
+ * @param result 输出参数，存储找到的元素指针（指向查找表内部）
+ * @param index 输出参数，存储元素在原有序范围中的下标，可以为NULL
+ * @return error_code_t 错误码
+ */
+error_code_t algo_eytzinger_find(const algo_eytzinger_t* layout, const void* value,
+                                 void** result, size_t* index);
+
+/**
+ * @brief 重排范围使第n个位置上的元素就是完整排序后该位置的元素
+ *
+ * 使用内省选择（快速选择，递归过深时退化为堆选择），平均O(n)。
+ * 执行后nth之前的元素都不大于它，之后的元素都不小于它。
+ * 非连续范围会先复制到临时缓冲区处理再写回。
+ *
+ * @param begin 起始迭代器
+ * @param nth 目标位置迭代器
+ * @param end 结束迭代器
+ * @param compare 比较函数指针
+ * @return error_code_t 错误码
+ */
+error_code_t algo_nth_element(iterator_t* begin, iterator_t* nth, iterator_t* end,
+                              compare_fn_t compare);
+
+/**
+ * @brief 部分排序，使[begin, middle)按顺序包含整个范围中最小的若干元素
+ *
+ * 使用堆选择，时间复杂度O(n log k)，k为middle之前的元素数量；
+ * [middle, end)中剩余元素的顺序不确定。
+ *
+ * @param begin 起始迭代器
+ * @param middle 部分排序的结束位置迭代器
+ * @param end 结束迭代器
+ * @param compare 比较函数指针
+ * @return error_code_t 错误码
+ */
+error_code_t algo_partial_sort(iterator_t* begin, iterator_t* middle, iterator_t* end,
+                               compare_fn_t compare);
+
+/**
+ * @brief 将输入范围中最小的若干元素按顺序复制到目标范围
+ *
+ * 复制的元素数量为输入和目标范围大小中的较小者，输入范围保持不变。
+ *
+ * @param begin 输入范围起始迭代器
+ * @param end 输入范围结束迭代器
+ * @param dest_begin 目标范围起始迭代器
+ * @param dest_end 目标范围结束迭代器
+ * @param compare 比较函数指针
+ * @param count 输出参数，存储复制的元素数量，可以为NULL
+ * @return error_code_t 错误码
+ */
+error_code_t algo_partial_sort_copy(iterator_t* begin, iterator_t* end,
+                                    iterator_t* dest_begin, iterator_t* dest_end,
+                                    compare_fn_t compare, size_t* count);
+
+/**
+ * @brief 归并两个有序范围到目标范围
+ *
+ * 相等的元素中第一个范围的排在前面（稳定）。两个输入都是向量时，
+ * 一侧连续胜出时用指数搜索成段复制，大小相差悬殊时比较次数为O(m log(n / m))。
+ * 目标范围不能与输入重叠，向量目标可写入的元素为dest到向量末尾。
+ *
+ * @param begin1 第一个范围的起始迭代器
+ * @param end1 第一个范围的结束迭代器
+ * @param begin2 第二个范围的起始迭代器
+ * @param end2 第二个范围的结束迭代器
+ * @param dest 目标范围的起始迭代器
+ * @param compare 比较函数指针
+ * @param count 输出参数，存储写入的元素数量，可以为NULL
+ * @return error_code_t 错误码，目标范围容量不足时返回CSTL_ERROR_INVALID_ARGUMENT
+ */
+error_code_t algo_merge(iterator_t* begin1, iterator_t* end1,
+                        iterator_t* begin2, iterator_t* end2,
+                        iterator_t* dest, compare_fn_t compare, size_t* count);
+
+/**
+ * @brief 求两个有序范围的并集
+ *
+ * 按多重集合语义，某个值在两个范围中分别出现m和n次时输出max(m, n)次。
+ * 快速路径与目标范围的要求同algo_merge。
+ *
+ * @param begin1 第一个范围的起始迭代器
+ * @param end1 第一个范围的结束迭代器
+ * @param begin2 第二个范围的起始迭代器
+ * @param end2 第二个范围的结束迭代器
+ * @param dest 目标范围的起始迭代器
+ * @param compare 比较函数指针
+ * @param count 输出参数，存储写入的元素数量，可以为NULL
+ * @return error_code_t 错误码，目标范围容量不足时返回CSTL_ERROR_INVALID_ARGUMENT
+ */
+error_code_t algo_set_union(iterator_t* begin1, iterator_t* end1,
+                            iterator_t* begin2, iterator_t* end2,
+                            iterator_t* dest, compare_fn_t compare, size_t* count);
+
+/**
+ * @brief 求两个有序范围的交集
+ *
+ * 某个值在两个范围中分别出现m和n次时输出min(m, n)次，元素取自第一个范围。
+ * 快速路径与目标范围的要求同algo_merge。
+ *
+ * @param begin1 第一个范围的起始迭代器
+ * @param end1 第一个范围的结束迭代器
+ * @param begin2 第二个范围的起始迭代器
+ * @param end2 第二个范围的结束迭代器
+ * @param dest 目标范围的起始迭代器
+ * @param compare 比较函数指针
+ * @param count 输出参数，存储写入的元素数量，可以为NULL
+ * @return error_code_t 错误码，目标范围容量不足时返回CSTL_ERROR_INVALID_ARGUMENT
+ */
+error_code_t algo_set_intersection(iterator_t* begin1, iterator_t* end1,
+                                   iterator_t* begin2, iterator_t* end2,
+                                   iterator_t* dest, compare_fn_t compare, size_t* count);
+
+/**
+ * @brief 求两个有序范围的差集（在第一个范围中但不在第二个范围中的元素）
+ *
+ * 某个值在两个范围中分别出现m和n次时输出max(m - n, 0)次。
+ * 快速路径与目标范围的要求同algo_merge。
+ *
+ * @param begin1 第一个范围的起始迭代器
+ * @param end1 第一个范围的结束迭代器
+ * @param begin2 第二个范围的起始迭代器
+ * @param end2 第二个范围的结束迭代器
+ * @param dest 目标范围的起始迭代器
+ * @param compare 比较函数指针
+ * @param count 输出参数，存储写入的元素数量，可以为NULL
+ * @return error_code_t 错误码，目标范围容量不足时返回CSTL_ERROR_INVALID_ARGUMENT
+ */
+error_code_t algo_set_difference(iterator_t* begin1, iterator_t* end1,
+                                 iterator_t* begin2, iterator_t* end2,
+                                 iterator_t* dest, compare_fn_t compare, size_t* count);
+
+/**
+ * @brief 检查有序范围是否包含另一个有序范围的所有元素
+ *
+ * 按多重集合语义比较。两个输入都是向量时使用指数搜索跳过第一个范围中的元素。
+ *
+ * @param begin1 第一个范围的起始迭代器
+ * @param end1 第一个范围的结束迭代器
+ * @param begin2 第二个范围的起始迭代器
+ * @param end2 第二个范围的结束迭代器
+ * @param compare 比较函数指针
+ * @param result 输出参数，第二个范围是第一个范围的子集时为1，否则为0
+ * @return error_code_t 错误码
+ */
+error_code_t algo_includes(iterator_t* begin1, iterator_t* end1,
+                           iterator_t* begin2, iterator_t* end2,
+                           compare_fn_t compare, int* result);
+
+/**
+ * @brief 用败者树归并多个有序向量
+ *
+ * 每输出一个元素只需沿叶子到根比较log k次。相等的元素按输入的顺序输出（稳定）。
+ * 所有向量的元素大小必须与目标相同，目标不能是输入之一。
+ *
+ * @param sources 有序向量数组
+ * @param source_count 向量数量
+ * @param dest 目标向量，归并结果追加到末尾
+ * @param compare 比较函数指针
+ * @return error_code_t 错误码
+ */
+error_code_t algo_merge_k(vector_t* const* sources, size_t source_count,
+                          vector_t* dest, compare_fn_t compare);
+
+/**
+ * @brief 流式Top-K累加器
+ *
+ * 以容量为k的有界最小堆保留目前为止最大的k个元素，逐个接收元素，
+ * 每次插入O(log k)，内存占用与输入总量无关。
+ */
+typedef struct algo_topk_t {
+    void* heap;              /**< 堆数组，堆顶为当前保留元素中的最小者 */
+    size_t size;             /**< 当前保留的元素数量 */
+    size_t capacity;         /**< 最多保留的元素数量k */
+    size_t element_size;     /**< 元素大小 */
+    compare_fn_t compare;    /**< 比较函数指针 */
+} algo_topk_t;
+
+/**
+ * @brief 创建Top-K累加器
+ *
+ * @param k 保留的元素数量
+ * @param element_size 元素大小
+ * @param compare 比较函数指针，保留比较结果最大的k个元素
+ * @return algo_topk_t* 累加器指针，失败返回NULL
+ */
+algo_topk_t* algo_topk_create(size_t k, size_t element_size, compare_fn_t compare);
+
+/**
+ * @brief 销毁Top-K累加器
+ *
+ * @param topk 累加器指针
+ */
+void algo_topk_destroy(algo_topk_t* topk);
+
+/**
+ * @brief 清空Top-K累加器
+ *
+ * @param topk 累加器指针
+ */
+void algo_topk_clear(algo_topk_t* topk);
+
+/**
+ * @brief 向Top-K累加器提交一个元素
+ *
+ * @param topk 累加器指针
+ * @param element 元素指针
+ * @return error_code_t 错误码
+ */
+error_code_t algo_topk_push(algo_topk_t* topk, const void* element);
+
+/**
+ * @brief 向Top-K累加器批量提交范围内的元素
+ *
+ * @param topk 累加器指针
+ * @param begin 起始迭代器
+ * @param end 结束迭代器
+ * @return error_code_t 错误码
+ */
+error_code_t algo_topk_push_range(algo_topk_t* topk, iterator_t* begin, iterator_t* end);
+
+/**
+ * @brief 获取当前保留元素中最小的一个，即进入Top-K的门槛
+ *
+ * @param topk 累加器指针
+ * @param element 输出参数，存储门槛元素指针（指向累加器内部）
+ * @return error_code_t 错误码，累加器为空时返回CSTL_ERROR_CONTAINER_EMPTY
+ */
+error_code_t algo_topk_threshold(const algo_topk_t* topk, void** element);
+
+/**
+ * @brief 获取Top-K累加器当前保留的元素数量
+ *
+ * @param topk 累加器指针
+ * @return size_t 元素数量
+ */
+size_t algo_topk_size(const algo_topk_t* topk);
+
+/**
+ * @brief 按从大到小的顺序输出保留的元素
+ *
+ * 累加器本身不受影响，可以继续提交元素。
+ *
+ * @param topk 累加器指针
+ * @param dest 目标迭代器，目标范围至少需要容纳algo_topk_size()个元素
+ * @param count 输出参数，存储写入的元素数量，可以为NULL
+ * @return error_code_t 错误码
+ */
+error_code_t algo_topk_result(const algo_topk_t* topk, iterator_t* dest, size_t* count);
+
+/**
+ * @brief 并行地对范围内每个元素执行操作
+ *
+ * 连续存储的范围按grain_size分块，在默认线程池上并行执行；
+ * 其他范围退化为顺序执行的algo_for_each。op必须可以被多个线程同时调用。
+ *
+ * @param begin 起始迭代器
+ * @param end 结束迭代器
+ * @param op 一元操作函数指针
+ * @param grain_size 每个分块的元素数量，为0时自动选择
+ * @return error_code_t 错误码
+ */
+error_code_t algo_par_for_each(iterator_t* begin, iterator_t* end, unary_op_fn_t op,
+                               size_t grain_size);
+
+/**
+ * @brief 并行地将元素转换到目标范围
+ *
+ * 语义与algo_transform相同：先复制源元素再对目标元素应用op。
+ * 源和目标都连续存储时并行执行，两者可以完全相同但不能部分重叠。
+ *
+ * @param begin 源范围的起始迭代器
+ * @param end 源范围的结束迭代器
+ * @param dest 目标范围的起始迭代器
+ * @param op 一元操作函数指针
+ * @param grain_size 每个分块的元素数量，为0时自动选择
+ * @param count 输出参数，存储转换的元素数量
+ * @return error_code_t 错误码，目标范围容量不足时返回CSTL_ERROR_INVALID_ARGUMENT
+ */
+error_code_t algo_par_transform(iterator_t* begin, iterator_t* end, iterator_t* dest,
+                                unary_op_fn_t op, size_t grain_size, size_t* count);
+
+/**
+ * @brief 并行归约
+ *
+ * 每个分块以首元素为初值顺序合并得到部分结果，再按分块顺序合并进result，
+ * 因此combine只需满足结合律，不要求交换律。
+ *
+ * @param begin 起始迭代器
+ * @param end 结束迭代器
+ * @param combine 合并函数指针，执行 a = a 合并 b
+ * @param grain_size 每个分块的元素数量，为0时自动选择
+ * @param result 输入输出参数，输入为初值，输出为归约结果，大小与元素相同
+ * @return error_code_t 错误码
+ */
+error_code_t algo_par_reduce(iterator_t* begin, iterator_t* end, binary_op_fn_t combine,
+                             size_t grain_size, void* result);
+
+/**
+ * @brief 并行统计满足谓词条件的元素数量
+ *
+ * @param begin 起始迭代器
+ * @param end 结束迭代器
+ * @param predicate 谓词函数指针
+ * @param grain_size 每个分块的元素数量，为0时自动选择
+ * @param count 输出参数，存储满足条件的元素数量
+ * @return error_code_t 错误码
+ */
+error_code_t algo_par_count_if(iterator_t* begin, iterator_t* end, predicate_fn_t predicate,
+                               size_t grain_size, size_t* count);
+
+/**
+ * @brief 并行随机打乱范围
+ *
+ * 把范围分成k个分块（k不超过256），每个分块使用独立的随机流把元素均匀地
+ * 分配到k个桶中，按桶顺序散列到临时缓冲区后，再并行地对每个桶做Fisher-Yates洗牌。
+ * 结果是均匀的随机排列。rng只被拆分一次，各分块的流由rng_jump派生，
+ * 因此指定grain_size时相同的生成器状态得到相同的排列，与线程数无关。
+ * 不连续的范围退化为顺序执行的algo_shuffle_rng。
+ *
+ * @param begin 起始迭代器
+ * @param end 结束迭代器
+ * @param rng 生成器状态，为NULL时使用当前线程的生成器
+ * @param grain_size 每个分块的元素数量，为0时自动选择
+ * @return error_code_t 错误码
+ */
+error_code_t algo_par_shuffle(iterator_t* begin, iterator_t* end, rng_t* rng, size_t grain_size);
+
+/**
+ * @brief 频次统计结果项
+ */
+typedef struct algo_frequency_t {
+    void* element;          /**< 该值第一次出现的元素指针，指向源容器 */
+    size_t count;           /**< 出现次数 */
+} algo_frequency_t;
+
+/**
+ * @brief 基于哈希表检查一个范围是否是另一个范围的排列
+ *
+ * 期望O(n)，只对第一个范围中的不同值建表。
+ *
+ * @param begin1 第一个范围的起始迭代器
+ * @param end1 第一个范围的结束迭代器
+ * @param begin2 第二个范围的起始迭代器
+ * @param end2 第二个范围的结束迭代器
+ * @param hash 哈希函数指针，为NULL时对元素的字节求哈希
+ * @param compare 比较函数指针，为NULL时按位比较
+ * @param is_permutation 输出参数，存储是否是排列
+ * @return error_code_t 错误码
+ */
+error_code_t algo_is_permutation_hash(iterator_t* begin1, iterator_t* end1,
+                                      iterator_t* begin2, iterator_t* end2,
+                                      hash_fn_t hash, compare_fn_t compare, int* is_permutation);
+
+/**
+ * @brief 移除无序范围中的重复元素，保留每个值第一次出现的元素
+ *
+ * 期望O(n)。保留的元素按原有顺序压缩到范围前部，
+ * 范围尾部的count个元素内容未定义，向量可随后用vector_resize截断。
+ * 与algo_unique相同，元素按字节移动，不调用析构函数。
+ *
+ * @param begin 起始迭代器
+ * @param end 结束迭代器
+ * @param hash 哈希函数指针，为NULL时对元素的字节求哈希
+ * @param compare 比较函数指针，为NULL时按位比较
+ * @param count 输出参数，存储移除的元素数量
+ * @return error_code_t 错误码
+ */
+error_code_t algo_distinct(iterator_t* begin, iterator_t* end, hash_fn_t hash,
+                           compare_fn_t compare, size_t* count);
+
+/**
+ * @brief 统计范围中每个不同值的出现次数
+ *
+ * 期望O(n)，结果按每个值第一次出现的顺序排列。
+ *
+ * @param begin 起始迭代器
+ * @param end 结束迭代器
+ * @param hash 哈希函数指针，为NULL时对元素的字节求哈希
+ * @param compare 比较函数指针，为NULL时按位比较
+ * @param frequencies 输出参数，存储结果数组，使用free释放，范围为空时为NULL
+ * @param count 输出参数，存储不同值的数量
+ * @return error_code_t 错误码
+ */
+error_code_t algo_frequencies(iterator_t* begin, iterator_t* end, hash_fn_t hash,
+                              compare_fn_t compare, algo_frequency_t** frequencies, size_t* count);
+
 #ifdef __cplusplus
 }
 #endif
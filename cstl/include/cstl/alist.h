@@ -0,0 +1,415 @@
+/**
+ * @file alist.h
+ * @brief CSTL库的数组链表容器头文件
+ *
+ * 该文件定义了CSTL库的数组链表容器。节点存放在一块连续、可增长的数组中，
+ * 前后链接是32位的槽位下标而不是指针，空闲槽位串成内部的空闲链表重复使用。
+ * 每个节点的额外开销是8字节（list_t是3个指针再加上每个节点一次分配的开销），
+ * 节点集中在同一块内存中，遍历时缓存和硬件预取的效果更好。
+ *
+ * 接口与list_*保持一致，区别在于位置用uint32_t槽位下标表示（ALIST_NIL表示无效位置）：
+ * - 槽位下标在元素被移除之前一直有效，不受其他元素插入、删除和数组增长的影响；
+ * - 数组增长时元素地址会变化，alist_get等返回的元素指针只在下一次插入之前有效，
+ *   需要长期保存时保存槽位下标，或者预先用alist_reserve预留容量；
+ * - alist_compact按链表顺序重新排列槽位，之后所有槽位下标都会改变。
+ *
+ * 元素按8字节对齐存放。
+ */
+
+#ifndef CSTL_ALIST_H
+#define CSTL_ALIST_H
+
+#include "cstl/common.h"
+#include "cstl/iterator.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief 无效的槽位下标，表示链表的两端或查找失败
+ */
+#define ALIST_NIL ((uint32_t)0xFFFFFFFFu)
+
+/**
+ * @brief 数组链表容器结构体
+ */
+typedef struct alist_t {
+    /**
+     * @brief 槽位数组，每个槽位依次存放前驱下标、后继下标和元素
+     */
+    unsigned char* slots;
+
+    /**
+     * @brief 每个槽位的字节数
+     */
+    size_t slot_size;
+
+    /**
+     * @brief 槽位数组的容量
+     */
+    size_t capacity;
+
+    /**
+     * @brief 已经使用过的槽位数量，之后的槽位从未分配过
+     */
+    size_t used;
+
+    /**
+     * @brief 元素数量
+     */
+    size_t size;
+
+    /**
+     * @brief 头槽位下标
+     */
+    uint32_t head;
+
+    /**
+     * @brief 尾槽位下标
+     */
+    uint32_t tail;
+
+    /**
+     * @brief 空闲链表的第一个槽位下标
+     */
+    uint32_t free_head;
+
+    /**
+     * @brief 元素大小
+     */
+    size_t element_size;
+
+    /**
+     * @brief 分配器指针
+     */
+    allocator_t* allocator;
+
+    /**
+     * @brief 互斥锁（线程安全选项）
+     */
+    mutex_t lock;
+
+    /**
+     * @brief 是否启用线程安全
+     */
+    int thread_safe;
+
+    /**
+     * @brief 析构函数指针
+     */
+    destructor_fn_t destructor;
+} alist_t;
+
+/**
+ * @brief 创建数组链表容器
+ *
+ * @param element_size 元素大小
+ * @param allocator 分配器指针，如果为NULL则使用默认分配器
+ * @param destructor 析构函数指针，移除元素时对元素调用，为NULL时不调用
+ * @return alist_t* 数组链表容器指针，失败返回NULL
+ */
+alist_t* alist_create(size_t element_size, allocator_t* allocator, destructor_fn_t destructor);
+
+/**
+ * @brief 销毁数组链表容器
+ *
+ * @param list 数组链表容器指针
+ */
+void alist_destroy(alist_t* list);
+
+/**
+ * @brief 初始化数组链表容器
+ *
+ * @param list 数组链表容器指针
+ * @param element_size 元素大小
+ * @param allocator 分配器指针，如果为NULL则使用默认分配器
+ * @return error_code_t 错误码
+ */
+error_code_t alist_init(alist_t* list, size_t element_size, allocator_t* allocator);
+
+/**
+ * @brief 清空数组链表容器，保留已分配的槽位数组
+ *
+ * @param list 数组链表容器指针
+ */
+void alist_clear(alist_t* list);
+
+/**
+ * @brief 预留槽位，之后元素数量不超过capacity时插入不会移动元素
+ *
+ * @param list 数组链表容器指针
+ * @param capacity 槽位数量
+ * @return error_code_t 错误码
+ */
+error_code_t alist_reserve(alist_t* list, size_t capacity);
+
+/**
+ * @brief 按链表顺序重新排列槽位，并释放多余的容量
+ *
+ * 大量随机插入和删除之后，相邻元素可能分散在数组各处，整理后遍历重新变为顺序访问。
+ * 完成后第i个元素位于槽位i，之前的所有槽位下标失效。
+ *
+ * @param list 数组链表容器指针
+ * @return error_code_t 错误码
+ */
+error_code_t alist_compact(alist_t* list);
+
+/**
+ * @brief 获取数组链表容器大小
+ *
+ * @param list 数组链表容器指针
+ * @return size_t 元素数量
+ */
+size_t alist_size(const alist_t* list);
+
+/**
+ * @brief 检查数组链表容器是否为空
+ *
+ * @param list 数组链表容器指针
+ * @return int 如果为空返回非零，否则返回零
+ */
+int alist_empty(const alist_t* list);
+
+/**
+ * @brief 在数组链表容器前端添加元素
+ *
+ * @param list 数组链表容器指针
+ * @param element 要添加的元素指针
+ * @return error_code_t 错误码
+ */
+error_code_t alist_push_front(alist_t* list, const void* element);
+
+/**
+ * @brief 在数组链表容器后端添加元素
+ *
+ * @param list 数组链表容器指针
+ * @param element 要添加的元素指针
+ * @return error_code_t 错误码
+ */
+error_code_t alist_push_back(alist_t* list, const void* element);
+
+/**
+ * @brief 移除数组链表容器前端元素
+ *
+ * @param list 数组链表容器指针
+ * @return error_code_t 错误码
+ */
+error_code_t alist_pop_front(alist_t* list);
+
+/**
+ * @brief 移除数组链表容器后端元素
+ *
+ * @param list 数组链表容器指针
+ * @return error_code_t 错误码
+ */
+error_code_t alist_pop_back(alist_t* list);
+
+/**
+ * @brief 获取数组链表容器前端元素
+ *
+ * @param list 数组链表容器指针
+ * @param element 输出参数，存储元素指针
+ * @return error_code_t 错误码
+ */
+error_code_t alist_front(const alist_t* list, void** element);
+
+/**
+ * @brief 获取数组链表容器后端元素
+ *
+ * @param list 数组链表容器指针
+ * @param element 输出参数，存储元素指针
+ * @return error_code_t 错误码
+ */
+error_code_t alist_back(const alist_t* list, void** element);
+
+/**
+ * @brief 在指定位置前插入元素
+ *
+ * @param list 数组链表容器指针
+ * @param position 插入位置的槽位下标，为ALIST_NIL时插入到后端
+ * @param element 要插入的元素指针
+ * @return error_code_t 错误码
+ */
+error_code_t alist_insert_before(alist_t* list, uint32_t position, const void* element);
+
+/**
+ * @brief 在指定位置后插入元素
+ *
+ * @param list 数组链表容器指针
+ * @param position 插入位置的槽位下标，为ALIST_NIL时插入到前端
+ * @param element 要插入的元素指针
+ * @return error_code_t 错误码
+ */
+error_code_t alist_insert_after(alist_t* list, uint32_t position, const void* element);
+
+/**
+ * @brief 移除指定位置元素，O(1)
+ *
+ * @param list 数组链表容器指针
+ * @param position 要移除的槽位下标
+ * @return error_code_t 错误码，position不是链表中的元素时返回CSTL_ERROR_INVALID_INDEX
+ */
+error_code_t alist_erase(alist_t* list, uint32_t position);
+
+/**
+ * @brief 移除指定元素
+ *
+ * @param list 数组链表容器指针
+ * @param element 要移除的元素指针
+ * @param comparator 比较函数指针
+ * @return error_code_t 错误码
+ */
+error_code_t alist_remove(alist_t* list, const void* element, comparator_fn_t comparator);
+
+/**
+ * @brief 移除所有满足谓词的元素
+ *
+ * @param list 数组链表容器指针
+ * @param predicate 谓词函数指针，返回非零的元素被移除
+ * @return error_code_t 错误码
+ */
+error_code_t alist_remove_if(alist_t* list, predicate_fn_t predicate);
+
+/**
+ * @brief 查找指定元素
+ *
+ * @param list 数组链表容器指针
+ * @param element 要查找的元素指针
+ * @param comparator 比较函数指针
+ * @return uint32_t 找到的槽位下标，未找到返回ALIST_NIL
+ */
+uint32_t alist_find(const alist_t* list, const void* element, comparator_fn_t comparator);
+
+/**
+ * @brief 获取槽位中的元素
+ *
+ * @param list 数组链表容器指针
+ * @param position 槽位下标
+ * @return void* 元素指针，position不是链表中的元素时返回NULL
+ */
+void* alist_get(const alist_t* list, uint32_t position);
+
+/**
+ * @brief 获取头槽位下标
+ *
+ * @param list 数组链表容器指针
+ * @return uint32_t 头槽位下标，链表为空时返回ALIST_NIL
+ */
+uint32_t alist_head(const alist_t* list);
+
+/**
+ * @brief 获取尾槽位下标
+ *
+ * @param list 数组链表容器指针
+ * @return uint32_t 尾槽位下标，链表为空时返回ALIST_NIL
+ */
+uint32_t alist_tail(const alist_t* list);
+
+/**
+ * @brief 获取下一个元素的槽位下标
+ *
+ * @param list 数组链表容器指针
+ * @param position 链表中的槽位下标
+ * @return uint32_t 下一个槽位下标，position是尾元素时返回ALIST_NIL
+ */
+uint32_t alist_next(const alist_t* list, uint32_t position);
+
+/**
+ * @brief 获取上一个元素的槽位下标
+ *
+ * @param list 数组链表容器指针
+ * @param position 链表中的槽位下标
+ * @return uint32_t 上一个槽位下标，position是头元素时返回ALIST_NIL
+ */
+uint32_t alist_prev(const alist_t* list, uint32_t position);
+
+/**
+ * @brief 获取指定索引的元素，从较近的一端出发，O(n)
+ *
+ * @param list 数组链表容器指针
+ * @param index 元素索引
+ * @param element 输出参数，存储元素指针
+ * @return error_code_t 错误码
+ */
+error_code_t alist_at(const alist_t* list, size_t index, void** element);
+
+/**
+ * @brief 设置指定索引的元素，从较近的一端出发，O(n)，旧元素先交给析构函数
+ *
+ * @param list 数组链表容器指针
+ * @param index 元素索引
+ * @param element 要设置的元素指针
+ * @return error_code_t 错误码
+ */
+error_code_t alist_set(alist_t* list, size_t index, const void* element);
+
+/**
+ * @brief 反转数组链表容器
+ *
+ * @param list 数组链表容器指针
+ * @return error_code_t 错误码
+ */
+error_code_t alist_reverse(alist_t* list);
+
+/**
+ * @brief 排序数组链表容器
+ *
+ * 稳定排序，与list_sort相同的非递归自底向上归并，只修改槽位下标，不移动元素。
+ *
+ * @param list 数组链表容器指针
+ * @param comparator 比较函数指针
+ * @return error_code_t 错误码
+ */
+error_code_t alist_sort(alist_t* list, comparator_fn_t comparator);
+
+/**
+ * @brief 启用线程安全
+ *
+ * @param list 数组链表容器指针
+ * @return error_code_t 错误码
+ */
+error_code_t alist_enable_thread_safety(alist_t* list);
+
+/**
+ * @brief 禁用线程安全
+ *
+ * @param list 数组链表容器指针
+ * @return error_code_t 错误码
+ */
+error_code_t alist_disable_thread_safety(alist_t* list);
+
+/**
+ * @brief 创建数组链表容器迭代器
+ *
+ * 迭代器的current是元素指针，迭代期间不能插入元素（数组增长会使元素指针失效）。
+ *
+ * @param list 数组链表容器指针
+ * @param direction 迭代方向
+ * @return iterator_t* 迭代器指针，失败返回NULL
+ */
+iterator_t* alist_iterator_create(alist_t* list, iter_direction_t direction);
+
+/**
+ * @brief 获取数组链表容器起始迭代器
+ *
+ * @param list 数组链表容器指针
+ * @return iterator_t* 起始迭代器指针，失败返回NULL
+ */
+iterator_t* alist_begin(alist_t* list);
+
+/**
+ * @brief 获取数组链表容器结束迭代器
+ *
+ * 结束迭代器执行prev后指向尾元素。
+ *
+ * @param list 数组链表容器指针
+ * @return iterator_t* 结束迭代器指针，失败返回NULL
+ */
+iterator_t* alist_end(alist_t* list);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CSTL_ALIST_H */
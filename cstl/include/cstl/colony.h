@@ -0,0 +1,326 @@
+/**
+ * @file colony.h
+ * @brief CSTL库的colony容器头文件
+ *
+ * 该文件定义了CSTL库的colony容器（也称为hive），适用于元素频繁增删、
+ * 并且需要保持元素地址不变的场景（例如实体表）：
+ * - 元素存放在一组容量逐渐增长的块中，插入和删除都不会移动其他元素，元素指针在元素被删除前一直有效；
+ * - 删除的槽位不移动其他元素，而是形成空洞，相邻的空洞合并成一段，
+ *   每个块把空洞段串成空闲链表，插入时优先复用空洞，插入和删除都是O(1)；
+ * - 每个槽位有一个16位的跳跃字段（skip field），空洞段的首尾槽位记录段的长度，
+ *   迭代时一步跳过整段空洞，遍历的代价与空洞数量无关；
+ * - 块中的元素全部删除后释放该块（保留一个空块备用，避免在边界上反复分配）。
+ *
+ * 元素的遍历顺序不是插入顺序。元素按8字节对齐存放。
+ */
+
+#ifndef CSTL_COLONY_H
+#define CSTL_COLONY_H
+
+#include "cstl/common.h"
+#include "cstl/iterator.h"
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief 默认的块最小容量
+ */
+#define COLONY_DEFAULT_MIN_BLOCK_CAPACITY 8
+
+/**
+ * @brief 默认的块最大容量
+ */
+#define COLONY_DEFAULT_MAX_BLOCK_CAPACITY 8192
+
+/**
+ * @brief 块容量的上限，受16位跳跃字段限制
+ */
+#define COLONY_BLOCK_CAPACITY_LIMIT 65535
+
+/**
+ * @brief 无效的槽位，表示块内没有空洞
+ */
+#define COLONY_NO_SLOT ((uint16_t)0xFFFFu)
+
+/**
+ * @brief colony块结构体
+ */
+typedef struct colony_block_t {
+    struct colony_block_t* prev;         /**< 遍历顺序上的前一个块 */
+    struct colony_block_t* next;         /**< 遍历顺序上的后一个块 */
+    struct colony_block_t* prev_erased;  /**< 有空洞的块链表中的前一个块 */
+    struct colony_block_t* next_erased;  /**< 有空洞的块链表中的后一个块 */
+    unsigned char* elements;             /**< 槽位数组 */
+    uint16_t* skip;                      /**< 跳跃字段，0表示槽位中有元素 */
+    size_t capacity;                     /**< 槽位数量 */
+    size_t used;                         /**< 已经使用过的槽位数量，最后一个使用过的槽位总是有元素 */
+    size_t size;                         /**< 元素数量 */
+    uint16_t free_head;                  /**< 第一个空洞段的起始槽位，COLONY_NO_SLOT表示没有空洞 */
+} colony_block_t;
+
+/**
+ * @brief colony容器结构体
+ */
+typedef struct colony_t {
+    /**
+     * @brief 遍历顺序上的第一个块
+     */
+    colony_block_t* head;
+
+    /**
+     * @brief 遍历顺序上的最后一个块，新的槽位从这里分配
+     */
+    colony_block_t* tail;
+
+    /**
+     * @brief 有空洞的块组成的链表
+     */
+    colony_block_t* erased_head;
+
+    /**
+     * @brief 备用的空块，可以为NULL
+     */
+    colony_block_t* spare;
+
+    /**
+     * @brief 按槽位数组地址排序的块表，用于由元素指针找到所在的块
+     */
+    colony_block_t** blocks;
+
+    /**
+     * @brief 块表中的块数量（包括备用块）
+     */
+    size_t block_count;
+
+    /**
+     * @brief 块表的容量
+     */
+    size_t block_table_capacity;
+
+    /**
+     * @brief 元素数量
+     */
+    size_t size;
+
+    /**
+     * @brief 所有块的槽位总数
+     */
+    size_t capacity;
+
+    /**
+     * @brief 元素大小
+     */
+    size_t element_size;
+
+    /**
+     * @brief 每个槽位的字节数
+     */
+    size_t slot_size;
+
+    /**
+     * @brief 块的最小容量
+     */
+    size_t min_block_capacity;
+
+    /**
+     * @brief 块的最大容量
+     */
+    size_t max_block_capacity;
+
+    /**
+     * @brief 分配器指针
+     */
+    allocator_t* allocator;
+
+    /**
+     * @brief 互斥锁（线程安全选项）
+     */
+    mutex_t lock;
+
+    /**
+     * @brief 是否启用线程安全
+     */
+    int thread_safe;
+
+    /**
+     * @brief 析构函数指针
+     */
+    destructor_fn_t destructor;
+} colony_t;
+
+/**
+ * @brief 创建colony容器
+ *
+ * @param element_size 元素大小
+ * @param allocator 分配器指针，如果为NULL则使用默认分配器
+ * @param destructor 析构函数指针，删除元素时对元素调用，为NULL时不调用
+ * @return colony_t* colony容器指针，失败返回NULL
+ */
+colony_t* colony_create(size_t element_size, allocator_t* allocator, destructor_fn_t destructor);
+
+/**
+ * @brief 销毁colony容器
+ *
+ * @param colony colony容器指针
+ */
+void colony_destroy(colony_t* colony);
+
+/**
+ * @brief 初始化colony容器
+ *
+ * @param colony colony容器指针
+ * @param element_size 元素大小
+ * @param allocator 分配器指针，如果为NULL则使用默认分配器
+ * @return error_code_t 错误码
+ */
+error_code_t colony_init(colony_t* colony, size_t element_size, allocator_t* allocator);
+
+/**
+ * @brief 设置块容量的范围
+ *
+ * 新块的容量等于当前槽位总数，限制在[min_capacity, max_capacity]之内，
+ * 只影响之后分配的块。
+ *
+ * @param colony colony容器指针
+ * @param min_capacity 块的最小容量，不小于2
+ * @param max_capacity 块的最大容量，不小于min_capacity，不大于COLONY_BLOCK_CAPACITY_LIMIT
+ * @return error_code_t 错误码
+ */
+error_code_t colony_set_block_capacity(colony_t* colony, size_t min_capacity, size_t max_capacity);
+
+/**
+ * @brief 清空colony容器，释放所有块
+ *
+ * @param colony colony容器指针
+ */
+void colony_clear(colony_t* colony);
+
+/**
+ * @brief 获取colony容器大小
+ *
+ * @param colony colony容器指针
+ * @return size_t 元素数量
+ */
+size_t colony_size(const colony_t* colony);
+
+/**
+ * @brief 检查colony容器是否为空
+ *
+ * @param colony colony容器指针
+ * @return int 如果为空返回非零，否则返回零
+ */
+int colony_empty(const colony_t* colony);
+
+/**
+ * @brief 获取colony容器的槽位总数
+ *
+ * @param colony colony容器指针
+ * @return size_t 槽位总数
+ */
+size_t colony_capacity(const colony_t* colony);
+
+/**
+ * @brief 插入元素
+ *
+ * 优先复用空洞，没有空洞时使用最后一个块的剩余槽位，都没有时分配新块。
+ *
+ * @param colony colony容器指针
+ * @param element 要插入的元素指针
+ * @param inserted 输出参数，存储新元素的指针，可以为NULL；该指针在元素被删除前一直有效
+ * @return error_code_t 错误码
+ */
+error_code_t colony_insert(colony_t* colony, const void* element, void** inserted);
+
+/**
+ * @brief 删除元素
+ *
+ * 由元素指针在块表中二分查找所在的块，O(log 块数)；在块内的删除是O(1)。
+ *
+ * @param colony colony容器指针
+ * @param element 元素指针，必须是colony_insert或迭代器得到的仍然有效的元素指针
+ * @return error_code_t 错误码，element不是容器中的元素时返回CSTL_ERROR_INVALID_ARGUMENT
+ */
+error_code_t colony_erase(colony_t* colony, void* element);
+
+/**
+ * @brief 删除迭代器指向的元素，并把迭代器移到下一个元素
+ *
+ * 迭代器已经知道所在的块，删除是O(1)。可以在遍历中边走边删。
+ *
+ * @param colony colony容器指针
+ * @param iterator colony迭代器指针
+ * @return error_code_t 错误码
+ */
+error_code_t colony_erase_at(colony_t* colony, iterator_t* iterator);
+
+/**
+ * @brief 删除所有满足谓词的元素
+ *
+ * @param colony colony容器指针
+ * @param predicate 谓词函数指针，返回非零的元素被删除
+ * @return size_t 删除的元素数量
+ */
+size_t colony_remove_if(colony_t* colony, predicate_fn_t predicate);
+
+/**
+ * @brief 检查指针是否指向容器中的元素
+ *
+ * @param colony colony容器指针
+ * @param element 元素指针
+ * @return int 如果是容器中的元素返回非零，否则返回零
+ */
+int colony_contains(const colony_t* colony, const void* element);
+
+/**
+ * @brief 启用线程安全
+ *
+ * @param colony colony容器指针
+ * @return error_code_t 错误码
+ */
+error_code_t colony_enable_thread_safety(colony_t* colony);
+
+/**
+ * @brief 禁用线程安全
+ *
+ * @param colony colony容器指针
+ * @return error_code_t 错误码
+ */
+error_code_t colony_disable_thread_safety(colony_t* colony);
+
+/**
+ * @brief 创建colony容器迭代器
+ *
+ * 迭代器的current是元素指针，按跳跃字段跳过空洞。
+ *
+ * @param colony colony容器指针
+ * @param direction 迭代方向
+ * @return iterator_t* 迭代器指针，失败返回NULL
+ */
+iterator_t* colony_iterator_create(colony_t* colony, iter_direction_t direction);
+
+/**
+ * @brief 获取colony容器起始迭代器
+ *
+ * @param colony colony容器指针
+ * @return iterator_t* 起始迭代器指针，失败返回NULL
+ */
+iterator_t* colony_begin(colony_t* colony);
+
+/**
+ * @brief 获取colony容器结束迭代器
+ *
+ * 结束迭代器执行prev后指向最后一个元素。
+ *
+ * @param colony colony容器指针
+ * @return iterator_t* 结束迭代器指针，失败返回NULL
+ */
+iterator_t* colony_end(colony_t* colony);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CSTL_COLONY_H */
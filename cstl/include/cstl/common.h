@@ -45,6 +45,7 @@ typedef enum {
     CSTL_ERROR_NOT_FOUND,       /**< 元素未找到 */
     CSTL_ERROR_ALREADY_EXISTS,  /**< 元素已存在 */
     CSTL_ERROR_INVALID_ARGUMENT,/**< 无效参数 */
+    CSTL_ERROR_IO,              /**< 文件读写失败 */
     CSTL_ERROR_UNKNOWN          /**< 未知错误 */
 } error_code_t;
 
@@ -53,6 +54,34 @@ typedef enum {
  */
 typedef void* any_t;
 
+/**
+ * @brief 缓存行大小（字节）
+ */
+#define CSTL_CACHE_LINE_SIZE 64
+
+/**
+ * @brief 软件预取宏
+ *
+ * 提示CPU将addr所在的缓存行提前载入缓存，不支持的编译器上为空操作。
+ */
+#if defined(__GNUC__) || defined(__clang__)
+#define CSTL_PREFETCH(addr) __builtin_prefetch((const void*)(addr))
+#elif defined(_MSC_VER) && (defined(_M_IX86) || defined(_M_X64))
+#include <xmmintrin.h>
+#define CSTL_PREFETCH(addr) _mm_prefetch((const char*)(addr), _MM_HINT_T0)
+#else
+#define CSTL_PREFETCH(addr) ((void)(addr))
+#endif
+
+/**
+ * @brief 线程局部存储说明符
+ */
+#if defined(_MSC_VER)
+#define CSTL_THREAD_LOCAL __declspec(thread)
+#else
+#define CSTL_THREAD_LOCAL __thread
+#endif
+
 /**
  * @brief 比较函数指针类型
  * 
@@ -62,6 +91,14 @@ typedef void* any_t;
  */
 typedef int (*comparator_fn_t)(const void* a, const void* b);
 
+/**
+ * @brief 谓词函数指针类型
+ * 
+ * @param element 元素指针
+ * @return int 如果满足条件返回非零，否则返回零
+ */
+typedef int (*predicate_fn_t)(const void* element);
+
 /**
  * @brief 析构函数指针类型
  * 
@@ -0,0 +1,87 @@
+/**
+ * @file external_sort.h
+ * @brief CSTL库的外部排序头文件
+ *
+ * 该文件定义了对超出内存的定长记录文件进行排序的接口。
+ * 排序分两个阶段：按内存预算读入记录、（可选并行地）排序后写入临时文件形成有序段；
+ * 再用败者树多路归并有序段，每一路使用大块顺序读写的缓冲区。
+ * 有序段太多、每路缓冲区小于下限时先做中间归并，减少路数。
+ * 整个过程使用的缓冲区总量不超过内存预算。
+ */
+
+#ifndef CSTL_EXTERNAL_SORT_H
+#define CSTL_EXTERNAL_SORT_H
+
+#include "cstl/common.h"
+#include <stdio.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief 外部排序配置
+ */
+typedef struct external_sort_config_t {
+    size_t memory_budget;       /**< 缓冲区总字节数，默认64MB */
+    size_t min_buffer_size;     /**< 归并时每一路缓冲区的最小字节数，决定一趟最多归并几路，默认1MB */
+    const char* temp_dir;       /**< 临时文件目录，为NULL时使用tmpfile() */
+    int parallel;               /**< 非零时在默认线程池上并行排序有序段，默认开启 */
+} external_sort_config_t;
+
+/**
+ * @brief 外部排序统计信息
+ */
+typedef struct external_sort_stats_t {
+    uint64_t records;           /**< 记录数量 */
+    size_t runs;                /**< 初始有序段数量 */
+    size_t merge_passes;        /**< 归并趟数，全部记录能一次装入内存时为0 */
+} external_sort_stats_t;
+
+/**
+ * @brief 用默认值初始化外部排序配置
+ *
+ * @param config 配置
+ */
+void external_sort_config_init(external_sort_config_t* config);
+
+/**
+ * @brief 对流中的定长记录排序并写入输出流
+ *
+ * 排序不稳定。输入从当前位置读到文件末尾，字节数必须是record_size的整数倍。
+ * 输入读完之后才开始写输出。
+ *
+ * @param input 输入流，以二进制模式打开
+ * @param output 输出流，以二进制模式打开
+ * @param record_size 记录字节数
+ * @param compare 记录比较函数
+ * @param config 配置，为NULL时使用默认配置
+ * @param stats 输出参数，存储统计信息，可以为NULL
+ * @return error_code_t 错误码，读写临时文件或输出失败时返回CSTL_ERROR_IO，
+ *         输入末尾有不完整的记录或内存预算装不下三条记录（两路归并的两个读者和写出器各一条）时返回CSTL_ERROR_INVALID_ARGUMENT
+ */
+error_code_t external_sort_stream(FILE* input, FILE* output, size_t record_size, comparator_fn_t compare,
+                                  const external_sort_config_t* config, external_sort_stats_t* stats);
+
+/**
+ * @brief 对文件中的定长记录排序并写入输出文件
+ *
+ * 输出文件在输入读完之后才打开，因此两者可以是同一个文件。
+ *
+ * @param input_path 输入文件路径
+ * @param output_path 输出文件路径
+ * @param record_size 记录字节数
+ * @param compare 记录比较函数
+ * @param config 配置，为NULL时使用默认配置
+ * @param stats 输出参数，存储统计信息，可以为NULL
+ * @return error_code_t 错误码
+ */
+error_code_t external_sort_file(const char* input_path, const char* output_path, size_t record_size,
+                                comparator_fn_t compare, const external_sort_config_t* config,
+                                external_sort_stats_t* stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CSTL_EXTERNAL_SORT_H */
@@ -0,0 +1,461 @@
+/**
+ * @file flat_map.h
+ * @brief CSTL库的有序扁平映射和有序扁平集合头文件
+ *
+ * 该文件定义了CSTL库的有序扁平映射（flat_map_t）和有序扁平集合（flat_set_t）。
+ * 键按比较函数的顺序存放在向量中，查找用二分查找，没有节点和指针：
+ * - 分离布局（FLAT_MAP_SEPARATE）把键和值分别存放在两个向量中，查找只访问键数组，缓存利用率最高；
+ * - 交错布局（FLAT_MAP_INTERLEAVED）把键值对存放在一个向量中，查找到键后值就在同一缓存行中。
+ *
+ * 比较函数为NULL时键按无符号整数比较，二分查找直接比较整数，不调用比较函数。
+ *
+ * 查找O(log n)，单个插入和删除需要移动插入位置之后的元素，是O(n)。
+ * 适合以读为主、元素数量在十万以内的字典：成批的数据用flat_map_build一次排序去重建立，
+ * 或用flat_map_insert_batch合并到已有内容中，避免逐个插入。
+ * 通过flat_map_find、flat_map_key_at等取得的指针只在下一次修改容器之前有效。
+ */
+
+#ifndef CSTL_FLAT_MAP_H
+#define CSTL_FLAT_MAP_H
+
+#include "cstl/common.h"
+#include "cstl/iterator.h"
+#include "cstl/vector.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief 有序扁平映射的存储布局
+ */
+typedef enum {
+    FLAT_MAP_SEPARATE = 0,  /**< 键和值分别存放在两个向量中 */
+    FLAT_MAP_INTERLEAVED    /**< 键值对交错存放在一个向量中 */
+} flat_map_layout_t;
+
+/**
+ * @brief 有序扁平映射结构体
+ */
+typedef struct flat_map_t {
+    /**
+     * @brief 按键排序的存储：分离布局中是键，交错布局中是键值对（键在开头）
+     */
+    vector_t* keys;
+
+    /**
+     * @brief 分离布局中与keys一一对应的值；交错布局和集合中为NULL
+     */
+    vector_t* values;
+
+    /**
+     * @brief 键大小
+     */
+    size_t key_size;
+
+    /**
+     * @brief 值大小，集合中为0
+     */
+    size_t value_size;
+
+    /**
+     * @brief 交错布局中值在键值对中的偏移
+     */
+    size_t value_offset;
+
+    /**
+     * @brief 键的比较函数
+     */
+    comparator_fn_t compare;
+
+    /**
+     * @brief 创建时没有给出比较函数，键按无符号整数比较，查找不经过比较函数
+     */
+    int integer_keys;
+
+    /**
+     * @brief 存储布局
+     */
+    flat_map_layout_t layout;
+
+    /**
+     * @brief 互斥锁（线程安全选项）
+     */
+    mutex_t lock;
+
+    /**
+     * @brief 是否启用线程安全
+     */
+    int thread_safe;
+
+    /**
+     * @brief 键的析构函数指针
+     */
+    destructor_fn_t key_destructor;
+
+    /**
+     * @brief 值的析构函数指针
+     */
+    destructor_fn_t value_destructor;
+} flat_map_t;
+
+/**
+ * @brief 有序扁平集合结构体，键连续有序地存放在一个向量中
+ */
+typedef struct flat_set_t {
+    /**
+     * @brief 没有值的有序扁平映射
+     */
+    flat_map_t map;
+} flat_set_t;
+
+/**
+ * @brief 创建有序扁平映射
+ *
+ * @param key_size 键大小
+ * @param value_size 值大小
+ * @param compare 键的比较函数指针，为NULL时键按key_size字节的无符号整数比较，key_size必须是1、2、4或8
+ * @param layout 存储布局
+ * @param allocator 分配器指针，如果为NULL则使用默认分配器
+ * @param key_destructor 键的析构函数指针，为NULL时不调用
+ * @param value_destructor 值的析构函数指针，为NULL时不调用
+ * @return flat_map_t* 有序扁平映射指针，失败返回NULL
+ */
+flat_map_t* flat_map_create(size_t key_size, size_t value_size, comparator_fn_t compare,
+                            flat_map_layout_t layout, allocator_t* allocator,
+                            destructor_fn_t key_destructor, destructor_fn_t value_destructor);
+
+/**
+ * @brief 销毁有序扁平映射
+ *
+ * @param map 有序扁平映射指针
+ */
+void flat_map_destroy(flat_map_t* map);
+
+/**
+ * @brief 清空有序扁平映射，保留容量
+ *
+ * @param map 有序扁平映射指针
+ */
+void flat_map_clear(flat_map_t* map);
+
+/**
+ * @brief 获取有序扁平映射大小
+ *
+ * @param map 有序扁平映射指针
+ * @return size_t 键值对数量
+ */
+size_t flat_map_size(const flat_map_t* map);
+
+/**
+ * @brief 检查有序扁平映射是否为空
+ *
+ * @param map 有序扁平映射指针
+ * @return int 如果为空返回非零，否则返回零
+ */
+int flat_map_empty(const flat_map_t* map);
+
+/**
+ * @brief 预留容量
+ *
+ * @param map 有序扁平映射指针
+ * @param capacity 键值对容量
+ * @return error_code_t 错误码
+ */
+error_code_t flat_map_reserve(flat_map_t* map, size_t capacity);
+
+/**
+ * @brief 插入键值对
+ *
+ * @param map 有序扁平映射指针
+ * @param key 键指针
+ * @param value 值指针
+ * @return error_code_t 错误码，键已经存在时不修改容器，返回CSTL_ERROR_ALREADY_EXISTS
+ */
+error_code_t flat_map_insert(flat_map_t* map, const void* key, const void* value);
+
+/**
+ * @brief 插入键值对，键已经存在时替换它的值
+ *
+ * 被替换的值会调用值的析构函数，键保持不变。
+ *
+ * @param map 有序扁平映射指针
+ * @param key 键指针
+ * @param value 值指针
+ * @return error_code_t 错误码
+ */
+error_code_t flat_map_insert_or_assign(flat_map_t* map, const void* key, const void* value);
+
+/**
+ * @brief 删除键对应的键值对
+ *
+ * @param map 有序扁平映射指针
+ * @param key 键指针
+ * @return error_code_t 错误码，键不存在时返回CSTL_ERROR_NOT_FOUND
+ */
+error_code_t flat_map_erase(flat_map_t* map, const void* key);
+
+/**
+ * @brief 查找键对应的值
+ *
+ * @param map 有序扁平映射指针
+ * @param key 键指针
+ * @param value 输出参数，存储值指针
+ * @return error_code_t 错误码，键不存在时返回CSTL_ERROR_NOT_FOUND
+ */
+error_code_t flat_map_find(const flat_map_t* map, const void* key, void** value);
+
+/**
+ * @brief 检查键是否存在
+ *
+ * @param map 有序扁平映射指针
+ * @param key 键指针
+ * @return int 如果键存在返回非零，否则返回零
+ */
+int flat_map_contains(const flat_map_t* map, const void* key);
+
+/**
+ * @brief 查找第一个不小于key的键的位置
+ *
+ * @param map 有序扁平映射指针
+ * @param key 键指针
+ * @param index 输出参数，存储位置，所有键都小于key时为flat_map_size
+ * @return error_code_t 错误码
+ */
+error_code_t flat_map_lower_bound(const flat_map_t* map, const void* key, size_t* index);
+
+/**
+ * @brief 获取按键排序后第index个键
+ *
+ * @param map 有序扁平映射指针
+ * @param index 位置
+ * @return void* 键指针，index越界时返回NULL
+ */
+void* flat_map_key_at(const flat_map_t* map, size_t index);
+
+/**
+ * @brief 获取按键排序后第index个值
+ *
+ * @param map 有序扁平映射指针
+ * @param index 位置
+ * @return void* 值指针，index越界时返回NULL
+ */
+void* flat_map_value_at(const flat_map_t* map, size_t index);
+
+/**
+ * @brief 用无序的键值对数组重建有序扁平映射
+ *
+ * 原有内容被清空，输入只排序一次（输入已经有序时不排序），重复的键保留第一次出现的键值对，
+ * 其余的不复制到容器中，也不调用析构函数。O(n log n)。
+ *
+ * @param map 有序扁平映射指针
+ * @param keys 键数组
+ * @param values 值数组，与keys一一对应
+ * @param count 键值对数量
+ * @return error_code_t 错误码，失败时容器内容不变
+ */
+error_code_t flat_map_build(flat_map_t* map, const void* keys, const void* values, size_t count);
+
+/**
+ * @brief 成批插入无序的键值对
+ *
+ * 先对这一批键值对排序去重，再对每个键二分查找插入位置，最后从后向前一次合并到已有内容中，
+ * 已有的元素每个最多移动一次。已经存在的键保持原有的值，批内重复的键保留第一次出现的键值对；
+ * 没有插入的键值对不复制到容器中，也不调用析构函数。O(m log m + m log n + n)。
+ *
+ * @param map 有序扁平映射指针
+ * @param keys 键数组
+ * @param values 值数组，与keys一一对应
+ * @param count 键值对数量
+ * @param inserted 输出参数，存储实际插入的数量，可以为NULL
+ * @return error_code_t 错误码，失败时容器内容不变
+ */
+error_code_t flat_map_insert_batch(flat_map_t* map, const void* keys, const void* values,
+                                   size_t count, size_t* inserted);
+
+/**
+ * @brief 启用线程安全
+ *
+ * @param map 有序扁平映射指针
+ * @return error_code_t 错误码
+ */
+error_code_t flat_map_enable_thread_safety(flat_map_t* map);
+
+/**
+ * @brief 禁用线程安全
+ *
+ * @param map 有序扁平映射指针
+ * @return error_code_t 错误码
+ */
+error_code_t flat_map_disable_thread_safety(flat_map_t* map);
+
+/**
+ * @brief 创建有序扁平集合
+ *
+ * @param key_size 键大小
+ * @param compare 键的比较函数指针，为NULL时与flat_map_create相同，键按无符号整数比较
+ * @param allocator 分配器指针，如果为NULL则使用默认分配器
+ * @param destructor 键的析构函数指针，为NULL时不调用
+ * @return flat_set_t* 有序扁平集合指针，失败返回NULL
+ */
+flat_set_t* flat_set_create(size_t key_size, comparator_fn_t compare, allocator_t* allocator,
+                            destructor_fn_t destructor);
+
+/**
+ * @brief 销毁有序扁平集合
+ *
+ * @param set 有序扁平集合指针
+ */
+void flat_set_destroy(flat_set_t* set);
+
+/**
+ * @brief 清空有序扁平集合，保留容量
+ *
+ * @param set 有序扁平集合指针
+ */
+void flat_set_clear(flat_set_t* set);
+
+/**
+ * @brief 获取有序扁平集合大小
+ *
+ * @param set 有序扁平集合指针
+ * @return size_t 键数量
+ */
+size_t flat_set_size(const flat_set_t* set);
+
+/**
+ * @brief 检查有序扁平集合是否为空
+ *
+ * @param set 有序扁平集合指针
+ * @return int 如果为空返回非零，否则返回零
+ */
+int flat_set_empty(const flat_set_t* set);
+
+/**
+ * @brief 预留容量
+ *
+ * @param set 有序扁平集合指针
+ * @param capacity 键容量
+ * @return error_code_t 错误码
+ */
+error_code_t flat_set_reserve(flat_set_t* set, size_t capacity);
+
+/**
+ * @brief 插入键
+ *
+ * @param set 有序扁平集合指针
+ * @param key 键指针
+ * @return error_code_t 错误码，键已经存在时返回CSTL_ERROR_ALREADY_EXISTS
+ */
+error_code_t flat_set_insert(flat_set_t* set, const void* key);
+
+/**
+ * @brief 删除键
+ *
+ * @param set 有序扁平集合指针
+ * @param key 键指针
+ * @return error_code_t 错误码，键不存在时返回CSTL_ERROR_NOT_FOUND
+ */
+error_code_t flat_set_erase(flat_set_t* set, const void* key);
+
+/**
+ * @brief 检查键是否存在
+ *
+ * @param set 有序扁平集合指针
+ * @param key 键指针
+ * @return int 如果键存在返回非零，否则返回零
+ */
+int flat_set_contains(const flat_set_t* set, const void* key);
+
+/**
+ * @brief 查找第一个不小于key的键的位置
+ *
+ * @param set 有序扁平集合指针
+ * @param key 键指针
+ * @param index 输出参数，存储位置，所有键都小于key时为flat_set_size
+ * @return error_code_t 错误码
+ */
+error_code_t flat_set_lower_bound(const flat_set_t* set, const void* key, size_t* index);
+
+/**
+ * @brief 获取第index小的键
+ *
+ * @param set 有序扁平集合指针
+ * @param index 位置
+ * @return void* 键指针，index越界时返回NULL
+ */
+void* flat_set_at(const flat_set_t* set, size_t index);
+
+/**
+ * @brief 获取有序的键数组
+ *
+ * @param set 有序扁平集合指针
+ * @return void* 键数组，集合为空时可能为NULL
+ */
+void* flat_set_data(const flat_set_t* set);
+
+/**
+ * @brief 用无序的键数组重建有序扁平集合
+ *
+ * 与flat_map_build相同，重复的键只保留第一个。
+ *
+ * @param set 有序扁平集合指针
+ * @param keys 键数组
+ * @param count 键数量
+ * @return error_code_t 错误码，失败时集合内容不变
+ */
+error_code_t flat_set_build(flat_set_t* set, const void* keys, size_t count);
+
+/**
+ * @brief 成批插入无序的键
+ *
+ * 与flat_map_insert_batch相同。
+ *
+ * @param set 有序扁平集合指针
+ * @param keys 键数组
+ * @param count 键数量
+ * @param inserted 输出参数，存储实际插入的数量，可以为NULL
+ * @return error_code_t 错误码，失败时集合内容不变
+ */
+error_code_t flat_set_insert_batch(flat_set_t* set, const void* keys, size_t count, size_t* inserted);
+
+/**
+ * @brief 启用线程安全
+ *
+ * @param set 有序扁平集合指针
+ * @return error_code_t 错误码
+ */
+error_code_t flat_set_enable_thread_safety(flat_set_t* set);
+
+/**
+ * @brief 禁用线程安全
+ *
+ * @param set 有序扁平集合指针
+ * @return error_code_t 错误码
+ */
+error_code_t flat_set_disable_thread_safety(flat_set_t* set);
+
+/**
+ * @brief 获取有序扁平集合起始迭代器
+ *
+ * 返回键数组上的向量迭代器，可以用于algo_*中只读取元素的算法（如algo_set_intersection）；
+ * 不能用于修改键的算法，否则集合不再有序。
+ *
+ * @param set 有序扁平集合指针
+ * @return iterator_t* 起始迭代器指针，失败返回NULL
+ */
+iterator_t* flat_set_begin(flat_set_t* set);
+
+/**
+ * @brief 获取有序扁平集合结束迭代器
+ *
+ * @param set 有序扁平集合指针
+ * @return iterator_t* 结束迭代器指针，失败返回NULL
+ */
+iterator_t* flat_set_end(flat_set_t* set);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CSTL_FLAT_MAP_H */
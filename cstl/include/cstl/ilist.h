@@ -0,0 +1,358 @@
+/**
+ * @file ilist.h
+ * @brief CSTL库的侵入式双向链表容器头文件
+ *
+ * 该文件定义了CSTL库的侵入式双向链表容器。链接指针（钩子）嵌入在用户的结构体中，
+ * 链表只把已有的对象串起来，插入和删除都不分配内存，也不复制元素。
+ * 适合对象已经在对象池或数组中、需要在若干链表之间频繁移动的场景（如会话、连接、定时器）。
+ *
+ * 接口与list_*保持一致，区别在于位置和元素都用对象指针表示，并且链表不拥有对象：
+ * ilist_erase和ilist_pop_*只断开链接，对象的生命周期由调用者管理；
+ * 只有设置了释放函数时，ilist_clear、ilist_remove_if和ilist_destroy才会对移除的对象调用它。
+ *
+ * 一个钩子同一时刻只能位于一个链表中，对象需要同时位于多个链表时嵌入多个钩子。
+ */
+
+#ifndef CSTL_ILIST_H
+#define CSTL_ILIST_H
+
+#include "cstl/common.h"
+#include "cstl/iterator.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief 侵入式链表钩子，嵌入在用户结构体中
+ */
+typedef struct ilist_hook_t {
+    struct ilist_hook_t* prev;  /**< 前一个钩子指针 */
+    struct ilist_hook_t* next;  /**< 下一个钩子指针 */
+} ilist_hook_t;
+
+/**
+ * @brief 由成员指针得到包含它的结构体指针
+ *
+ * @param ptr 成员指针
+ * @param type 结构体类型
+ * @param member 成员名
+ */
+#define ILIST_CONTAINER_OF(ptr, type, member) \
+    ((type*)((char*)(ptr) - offsetof(type, member)))
+
+/**
+ * @brief 侵入式双向链表容器结构体
+ */
+typedef struct ilist_t {
+    /**
+     * @brief 头钩子指针
+     */
+    ilist_hook_t* head;
+
+    /**
+     * @brief 尾钩子指针
+     */
+    ilist_hook_t* tail;
+
+    /**
+     * @brief 对象数量
+     */
+    size_t size;
+
+    /**
+     * @brief 钩子在对象中的偏移，由offsetof得到
+     */
+    size_t hook_offset;
+
+    /**
+     * @brief 对象大小，用于迭代器
+     */
+    size_t element_size;
+
+    /**
+     * @brief 互斥锁（线程安全选项）
+     */
+    mutex_t lock;
+
+    /**
+     * @brief 是否启用线程安全
+     */
+    int thread_safe;
+
+    /**
+     * @brief 释放函数指针，为NULL时链表从不释放对象
+     */
+    destructor_fn_t destructor;
+} ilist_t;
+
+/**
+ * @brief 创建侵入式双向链表容器
+ *
+ * 只分配链表结构体本身，之后的所有操作都不再分配内存。
+ *
+ * @param hook_offset 钩子在对象中的偏移
+ * @param element_size 对象大小
+ * @param destructor 释放函数指针，ilist_clear等移除对象时调用，为NULL时不释放对象
+ * @return ilist_t* 侵入式双向链表容器指针，失败返回NULL
+ */
+ilist_t* ilist_create(size_t hook_offset, size_t element_size, destructor_fn_t destructor);
+
+/**
+ * @brief 销毁侵入式双向链表容器，先执行ilist_clear
+ *
+ * @param list 侵入式双向链表容器指针
+ */
+void ilist_destroy(ilist_t* list);
+
+/**
+ * @brief 初始化侵入式双向链表容器，用于嵌入在其他结构体中或放在栈上的链表
+ *
+ * @param list 侵入式双向链表容器指针
+ * @param hook_offset 钩子在对象中的偏移
+ * @param element_size 对象大小
+ * @return error_code_t 错误码
+ */
+error_code_t ilist_init(ilist_t* list, size_t hook_offset, size_t element_size);
+
+/**
+ * @brief 清空侵入式双向链表容器
+ *
+ * 断开所有对象的链接，设置了释放函数时对每个对象调用它。
+ *
+ * @param list 侵入式双向链表容器指针
+ */
+void ilist_clear(ilist_t* list);
+
+/**
+ * @brief 获取侵入式双向链表容器大小
+ *
+ * @param list 侵入式双向链表容器指针
+ * @return size_t 对象数量
+ */
+size_t ilist_size(const ilist_t* list);
+
+/**
+ * @brief 检查侵入式双向链表容器是否为空
+ *
+ * @param list 侵入式双向链表容器指针
+ * @return int 如果为空返回非零，否则返回零
+ */
+int ilist_empty(const ilist_t* list);
+
+/**
+ * @brief 把对象链接到前端
+ *
+ * @param list 侵入式双向链表容器指针
+ * @param object 对象指针，其钩子不能位于任何链表中
+ * @return error_code_t 错误码
+ */
+error_code_t ilist_push_front(ilist_t* list, void* object);
+
+/**
+ * @brief 把对象链接到后端
+ *
+ * @param list 侵入式双向链表容器指针
+ * @param object 对象指针，其钩子不能位于任何链表中
+ * @return error_code_t 错误码
+ */
+error_code_t ilist_push_back(ilist_t* list, void* object);
+
+/**
+ * @brief 断开前端对象的链接
+ *
+ * @param list 侵入式双向链表容器指针
+ * @param object 输出参数，存储被断开的对象指针，可以为NULL
+ * @return error_code_t 错误码
+ */
+error_code_t ilist_pop_front(ilist_t* list, void** object);
+
+/**
+ * @brief 断开后端对象的链接
+ *
+ * @param list 侵入式双向链表容器指针
+ * @param object 输出参数，存储被断开的对象指针，可以为NULL
+ * @return error_code_t 错误码
+ */
+error_code_t ilist_pop_back(ilist_t* list, void** object);
+
+/**
+ * @brief 获取前端对象
+ *
+ * @param list 侵入式双向链表容器指针
+ * @param object 输出参数，存储对象指针
+ * @return error_code_t 错误码
+ */
+error_code_t ilist_front(const ilist_t* list, void** object);
+
+/**
+ * @brief 获取后端对象
+ *
+ * @param list 侵入式双向链表容器指针
+ * @param object 输出参数，存储对象指针
+ * @return error_code_t 错误码
+ */
+error_code_t ilist_back(const ilist_t* list, void** object);
+
+/**
+ * @brief 在指定对象前链接对象
+ *
+ * @param list 侵入式双向链表容器指针
+ * @param position 链表中的对象指针，为NULL时链接到后端
+ * @param object 要链接的对象指针
+ * @return error_code_t 错误码
+ */
+error_code_t ilist_insert_before(ilist_t* list, void* position, void* object);
+
+/**
+ * @brief 在指定对象后链接对象
+ *
+ * @param list 侵入式双向链表容器指针
+ * @param position 链表中的对象指针，为NULL时链接到前端
+ * @param object 要链接的对象指针
+ * @return error_code_t 错误码
+ */
+error_code_t ilist_insert_after(ilist_t* list, void* position, void* object);
+
+/**
+ * @brief 断开指定对象的链接，O(1)，不调用释放函数
+ *
+ * @param list 侵入式双向链表容器指针
+ * @param object 链表中的对象指针
+ * @return error_code_t 错误码
+ */
+error_code_t ilist_erase(ilist_t* list, void* object);
+
+/**
+ * @brief 移除所有满足谓词的对象，设置了释放函数时对移除的对象调用它
+ *
+ * @param list 侵入式双向链表容器指针
+ * @param predicate 谓词函数指针，返回非零的对象被移除
+ * @return error_code_t 错误码
+ */
+error_code_t ilist_remove_if(ilist_t* list, predicate_fn_t predicate);
+
+/**
+ * @brief 查找指定元素
+ *
+ * @param list 侵入式双向链表容器指针
+ * @param element 要查找的元素指针
+ * @param comparator 比较函数指针
+ * @return void* 找到的对象指针，未找到返回NULL
+ */
+void* ilist_find(const ilist_t* list, const void* element, comparator_fn_t comparator);
+
+/**
+ * @brief 获取链表中下一个对象
+ *
+ * @param list 侵入式双向链表容器指针
+ * @param object 链表中的对象指针
+ * @return void* 下一个对象指针，object是尾对象时返回NULL
+ */
+void* ilist_next(const ilist_t* list, const void* object);
+
+/**
+ * @brief 获取链表中上一个对象
+ *
+ * @param list 侵入式双向链表容器指针
+ * @param object 链表中的对象指针
+ * @return void* 上一个对象指针，object是头对象时返回NULL
+ */
+void* ilist_prev(const ilist_t* list, const void* object);
+
+/**
+ * @brief 反转侵入式双向链表容器
+ *
+ * @param list 侵入式双向链表容器指针
+ * @return error_code_t 错误码
+ */
+error_code_t ilist_reverse(ilist_t* list);
+
+/**
+ * @brief 把src的所有对象移动到dst中position之前，O(1)
+ *
+ * 两个链表的钩子偏移必须相同，否则返回CSTL_ERROR_INVALID_ARGUMENT。
+ *
+ * @param dst 目标链表
+ * @param position dst中的对象指针，为NULL时移动到末尾
+ * @param src 源链表，不能与dst相同，完成后为空
+ * @return error_code_t 错误码
+ */
+error_code_t ilist_splice(ilist_t* dst, void* position, ilist_t* src);
+
+/**
+ * @brief 把src中的一个对象移动到dst中position之前，O(1)
+ *
+ * dst和src可以是同一个链表，用于在链表内移动对象（如把最近访问的会话移到前端）。
+ *
+ * @param dst 目标链表
+ * @param position dst中的对象指针，为NULL时移动到末尾
+ * @param src 源链表
+ * @param object 要移动的src中的对象指针
+ * @return error_code_t 错误码
+ */
+error_code_t ilist_splice_node(ilist_t* dst, void* position, ilist_t* src, void* object);
+
+/**
+ * @brief 排序侵入式双向链表容器
+ *
+ * 稳定排序，与list_sort相同的非递归自底向上归并，只修改钩子指针，不分配内存。
+ *
+ * @param list 侵入式双向链表容器指针
+ * @param comparator 比较函数指针，参数为对象指针
+ * @return error_code_t 错误码
+ */
+error_code_t ilist_sort(ilist_t* list, comparator_fn_t comparator);
+
+/**
+ * @brief 启用线程安全
+ *
+ * @param list 侵入式双向链表容器指针
+ * @return error_code_t 错误码
+ */
+error_code_t ilist_enable_thread_safety(ilist_t* list);
+
+/**
+ * @brief 禁用线程安全
+ *
+ * @param list 侵入式双向链表容器指针
+ * @return error_code_t 错误码
+ */
+error_code_t ilist_disable_thread_safety(ilist_t* list);
+
+/**
+ * @brief 创建侵入式双向链表容器迭代器
+ *
+ * 迭代器的current是对象指针，可以用于只读取元素的算法（查找、计数、遍历等）。
+ * 不能用于会复制或交换元素的算法（algo_sort、algo_reverse等），
+ * 整体复制对象会覆盖其中的钩子；需要排序时使用ilist_sort。
+ *
+ * @param list 侵入式双向链表容器指针
+ * @param direction 迭代方向
+ * @return iterator_t* 迭代器指针，失败返回NULL
+ */
+iterator_t* ilist_iterator_create(ilist_t* list, iter_direction_t direction);
+
+/**
+ * @brief 获取侵入式双向链表容器起始迭代器
+ *
+ * @param list 侵入式双向链表容器指针
+ * @return iterator_t* 起始迭代器指针，失败返回NULL
+ */
+iterator_t* ilist_begin(ilist_t* list);
+
+/**
+ * @brief 获取侵入式双向链表容器结束迭代器
+ *
+ * 结束迭代器执行prev后指向尾对象。
+ *
+ * @param list 侵入式双向链表容器指针
+ * @return iterator_t* 结束迭代器指针，失败返回NULL
+ */
+iterator_t* ilist_end(ilist_t* list);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CSTL_ILIST_H */
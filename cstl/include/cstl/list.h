@@ -73,8 +73,43 @@ typedef struct list_t {
      * @brief 析构函数指针，用于释放元素内存
      */
     destructor_fn_t destructor;
+    
+    /**
+     * @brief 最近一次按索引访问的节点（游标），节点位置可能改变时置为NULL
+     */
+    list_node_t* cursor_node;
+    
+    /**
+     * @brief 游标节点的索引
+     */
+    size_t cursor_index;
+    
+    /**
+     * @brief 跳跃索引，第i项是索引为i * index_stride的节点
+     */
+    list_node_t** index_nodes;
+    
+    /**
+     * @brief 跳跃索引中有效的项数，为0时在下次需要时重建
+     */
+    size_t index_count;
+    
+    /**
+     * @brief 跳跃索引数组的容量
+     */
+    size_t index_capacity;
+    
+    /**
+     * @brief 跳跃索引的步长，为0表示未启用
+     */
+    size_t index_stride;
 } list_t;
 
+/**
+ * @brief 跳跃索引的默认步长，按索引随机访问时最多沿链表走一半步长
+ */
+#define LIST_SKIP_INDEX_STRIDE 32
+
 /**
  * @brief 创建双向链表容器
  * 
@@ -226,6 +261,15 @@ error_code_t list_erase(list_t* list, list_node_t* position);
  */
 error_code_t list_remove(list_t* list, const void* element, comparator_fn_t comparator);
 
+/**
+ * @brief 移除所有满足谓词的元素
+ * 
+ * @param list 双向链表容器指针
+ * @param predicate 谓词函数指针，返回非零的元素被移除
+ * @return error_code_t 错误码
+ */
+error_code_t list_remove_if(list_t* list, predicate_fn_t predicate);
+
 /**
  * @brief 查找指定元素
  * 
@@ -253,15 +297,100 @@ error_code_t list_reverse(list_t* list);
  */
 error_code_t list_merge(list_t* list1, list_t* list2);
 
+/**
+ * @brief list_splice_range的count参数，表示调用者不知道范围内的节点数量
+ */
+#define LIST_COUNT_UNKNOWN ((size_t)-1)
+
+/**
+ * @brief 把src的所有节点移动到dst中position之前，O(1)
+ * 
+ * 转移节点的函数只修改指针，不复制元素也不分配或释放节点。两个链表的元素大小、
+ * 分配器和节点对象池必须相同，否则返回CSTL_ERROR_INVALID_ARGUMENT；
+ * 移动后的节点在销毁时使用dst的析构函数。
+ * 
+ * @param dst 目标链表
+ * @param position dst中的节点，为NULL时移动到末尾
+ * @param src 源链表，不能与dst相同，完成后为空
+ * @return error_code_t 错误码
+ */
+error_code_t list_splice(list_t* dst, list_node_t* position, list_t* src);
+
+/**
+ * @brief 把src中的一个节点移动到dst中position之前，O(1)
+ * 
+ * dst和src可以是同一个链表，用于在链表内移动节点（如LRU把节点移到前端）。
+ * 
+ * @param dst 目标链表
+ * @param position dst中的节点，为NULL时移动到末尾
+ * @param src 源链表
+ * @param node 要移动的src中的节点
+ * @return error_code_t 错误码
+ */
+error_code_t list_splice_node(list_t* dst, list_node_t* position, list_t* src, list_node_t* node);
+
+/**
+ * @brief 把src中[first, last)范围内的节点移动到dst中position之前
+ * 
+ * count给出范围内的节点数量时为O(1)；为LIST_COUNT_UNKNOWN时需要遍历范围计数。
+ * dst和src相同时链表大小不变，不需要count，但position不能位于范围内。
+ * 
+ * @param dst 目标链表
+ * @param position dst中的节点，为NULL时移动到末尾
+ * @param src 源链表
+ * @param first 范围的第一个节点，为NULL或等于last时范围为空
+ * @param last 范围之后的第一个节点，为NULL时范围延伸到src末尾
+ * @param count 范围内的节点数量，或LIST_COUNT_UNKNOWN
+ * @return error_code_t 错误码
+ */
+error_code_t list_splice_range(list_t* dst, list_node_t* position, list_t* src,
+                               list_node_t* first, list_node_t* last, size_t count);
+
+/**
+ * @brief 把有序的src合并到有序的dst中，O(n + m)次比较，不分配内存
+ * 
+ * 合并是稳定的：相等的元素中dst原有的在前。完成后src为空。
+ * 
+ * @param dst 目标链表，按comparator有序
+ * @param src 源链表，按comparator有序，不能与dst相同
+ * @param comparator 比较函数指针
+ * @return error_code_t 错误码
+ */
+error_code_t list_merge_sorted(list_t* dst, list_t* src, comparator_fn_t comparator);
+
+/**
+ * @brief 链表排序方式
+ */
+typedef enum {
+    LIST_SORT_MERGE,    /**< 非递归的自底向上归并，只修改节点指针，不分配内存 */
+    LIST_SORT_ARRAY     /**< 把节点和数据指针收集到数组中排序后一次性重新链接，元素很多时并行排序 */
+} list_sort_mode_t;
+
 /**
  * @brief 排序双向链表容器
  * 
+ * 稳定排序，等价于list_sort_ex(list, comparator, LIST_SORT_MERGE)。
+ * 
  * @param list 双向链表容器指针
  * @param comparator 比较函数指针
  * @return error_code_t 错误码
  */
 error_code_t list_sort(list_t* list, comparator_fn_t comparator);
 
+/**
+ * @brief 按指定方式排序双向链表容器
+ * 
+ * 两种方式都是稳定排序。LIST_SORT_ARRAY需要每个节点16字节的两份临时数组，
+ * 比较时只访问连续的数组和元素数据，不沿链表跳转，节点在内存中分散时明显更快；
+ * 临时数组分配失败时退回LIST_SORT_MERGE。
+ * 
+ * @param list 双向链表容器指针
+ * @param comparator 比较函数指针
+ * @param mode 排序方式
+ * @return error_code_t 错误码
+ */
+error_code_t list_sort_ex(list_t* list, comparator_fn_t comparator, list_sort_mode_t mode);
+
 /**
  * @brief 启用线程安全
  * 
@@ -323,6 +452,11 @@ iterator_t* list_end(list_t* list);
 /**
  * @brief 获取双向链表容器指定位置的元素
  *
+ * 从头节点、尾节点、游标（上一次按索引访问的节点）和跳跃索引中离目标最近的位置出发，
+ * 顺序或就近的索引访问为O(1)。
+ * 虽然参数是const，每次调用都会写入链表中共享的游标和跳跃索引，并不是只读操作：
+ * 多个线程同时调用list_at（即使都只读取、没有线程修改链表）也必须先调用list_enable_thread_safety。
+ *
  * @param list 双向链表容器指针
  * @param index 元素索引
  * @param element 输出参数，存储元素指针
@@ -333,6 +467,8 @@ error_code_t list_at(const list_t* list, size_t index, void** element);
 /**
  * @brief 设置双向链表容器指定位置的元素
  *
+ * 与list_at相同地定位节点。
+ *
  * @param list 双向链表容器指针
  * @param index 元素索引
  * @param element 要设置的元素指针
@@ -340,6 +476,41 @@ error_code_t list_at(const list_t* list, size_t index, void** element);
  */
 error_code_t list_set(list_t* list, size_t index, const void* element);
 
+/**
+ * @brief 启用跳跃索引
+ * 
+ * 跳跃索引每stride个节点记录一个节点指针，按索引随机访问最多沿链表走stride / 2步，
+ * 额外内存为每stride个节点一个指针。索引在第一次需要时建立；插入、删除等改变节点位置的
+ * 操作使它失效（push_back和pop_back除外），下次随机访问时重建，代价为O(n)。
+ * 适合按索引读取远多于修改结构的大链表。
+ * 
+ * @param list 双向链表容器指针
+ * @param stride 步长，为0时使用LIST_SKIP_INDEX_STRIDE
+ * @return error_code_t 错误码
+ */
+error_code_t list_enable_skip_index(list_t* list, size_t stride);
+
+/**
+ * @brief 禁用跳跃索引并释放其内存
+ * 
+ * @param list 双向链表容器指针
+ * @return error_code_t 错误码
+ */
+error_code_t list_disable_skip_index(list_t* list);
+
+/**
+ * @brief 通过链表迭代器获取其后第offset个元素
+ * 
+ * 迭代器指向头节点或游标节点时按索引定位（使用游标和跳跃索引），否则从迭代器所在节点向后走。
+ * 算法模块通过该函数加速链表上的按位置访问。
+ *
+ * @param iterator 迭代器指针
+ * @param offset 相对迭代器的偏移
+ * @param element 输出参数，存储元素指针
+ * @return int 如果iterator是链表迭代器且目标元素存在返回非零，否则返回零
+ */
+int list_iterator_at(const iterator_t* iterator, size_t offset, void** element);
+
 #ifdef __cplusplus
 }
 #endif
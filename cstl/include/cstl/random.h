@@ -0,0 +1,146 @@
+/**
+ * @file random.h
+ * @brief CSTL库的伪随机数生成器头文件
+ *
+ * 该文件定义了基于xoshiro256**的伪随机数生成器，包括播种、
+ * 无偏的区间随机数、跳跃与拆分（用于并行的独立随机流）以及批量填充。
+ *
+ * 生成器状态由调用者持有，不加锁；需要共享时每个线程使用
+ * rng_thread_local返回的线程局部状态，或用rng_split拆分出独立的流。
+ * 该生成器不适用于密码学用途。
+ */
+
+#ifndef CSTL_RANDOM_H
+#define CSTL_RANDOM_H
+
+#include "cstl/common.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief xoshiro256**生成器状态
+ */
+typedef struct rng_t {
+    uint64_t s[4];          /**< 256位内部状态，不能全为0 */
+} rng_t;
+
+/**
+ * @brief 用64位种子初始化生成器
+ *
+ * 种子经过SplitMix64扩展为256位状态，相同种子产生相同序列。
+ *
+ * @param rng 生成器状态
+ * @param seed 种子
+ */
+void rng_seed(rng_t* rng, uint64_t seed);
+
+/**
+ * @brief 获取当前线程的生成器
+ *
+ * 第一次调用时用时间和线程局部变量的地址播种，
+ * 不同线程得到不同的序列。返回的状态可以用rng_seed重新播种以便复现。
+ *
+ * @return rng_t* 线程局部的生成器状态
+ */
+rng_t* rng_thread_local(void);
+
+/**
+ * @brief 生成一个64位随机数
+ *
+ * @param rng 生成器状态
+ * @return uint64_t 随机数
+ */
+uint64_t rng_next(rng_t* rng);
+
+/**
+ * @brief 生成一个32位随机数
+ *
+ * @param rng 生成器状态
+ * @return uint32_t 随机数，取64位结果的高32位
+ */
+uint32_t rng_next_u32(rng_t* rng);
+
+/**
+ * @brief 生成[0, bound)内均匀分布的随机数
+ *
+ * 使用Lemire的乘法取高位方法，只在极少数情况下拒绝重抽，没有取模偏差。
+ *
+ * @param rng 生成器状态
+ * @param bound 上界（不含），为0时返回0
+ * @return uint64_t 随机数
+ */
+uint64_t rng_bounded(rng_t* rng, uint64_t bound);
+
+/**
+ * @brief 生成[0, 1)内均匀分布的双精度浮点数
+ *
+ * @param rng 生成器状态
+ * @return double 随机数，53位精度
+ */
+double rng_next_double(rng_t* rng);
+
+/**
+ * @brief 向前跳过2^128个随机数
+ *
+ * 从同一状态出发依次跳跃，可以得到2^128个互不重叠的流。
+ *
+ * @param rng 生成器状态
+ */
+void rng_jump(rng_t* rng);
+
+/**
+ * @brief 向前跳过2^192个随机数
+ *
+ * @param rng 生成器状态
+ */
+void rng_long_jump(rng_t* rng);
+
+/**
+ * @brief 拆分出一个独立的随机流
+ *
+ * child取得rng当前的状态，rng向前跳过2^192个随机数。
+ * 在child上再用rng_jump派生的流都不会与rng之后的序列重叠。
+ *
+ * @param rng 生成器状态
+ * @param child 输出参数，存储拆分出的生成器状态
+ */
+void rng_split(rng_t* rng, rng_t* child);
+
+/**
+ * @brief 用随机字节填充缓冲区
+ *
+ * @param rng 生成器状态
+ * @param buffer 缓冲区
+ * @param size 字节数
+ * @return error_code_t 错误码
+ */
+error_code_t rng_fill(rng_t* rng, void* buffer, size_t size);
+
+/**
+ * @brief 批量生成[0, bound)内均匀分布的随机数
+ *
+ * @param rng 生成器状态
+ * @param values 输出数组
+ * @param count 元素数量
+ * @param bound 上界（不含）
+ * @return error_code_t 错误码
+ */
+error_code_t rng_fill_bounded(rng_t* rng, uint64_t* values, size_t count, uint64_t bound);
+
+/**
+ * @brief 批量生成[0, 1)内均匀分布的双精度浮点数
+ *
+ * @param rng 生成器状态
+ * @param values 输出数组
+ * @param count 元素数量
+ * @return error_code_t 错误码
+ */
+error_code_t rng_fill_double(rng_t* rng, double* values, size_t count);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CSTL_RANDOM_H */
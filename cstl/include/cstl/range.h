@@ -0,0 +1,236 @@
+/**
+ * @file range.h
+ * @brief CSTL库的惰性范围管道头文件
+ *
+ * 该文件定义了建立在迭代器之上的惰性范围管道。管道由一个源范围和若干
+ * 适配器（过滤、映射、截取、跳过、拉链、分块）组成，适配器只记录参数，
+ * 不产生中间容器；终结操作（收集到向量、归约、逐个处理、计数）在一趟遍历中
+ * 把每个元素依次推过所有适配器。
+ *
+ * 管道结构体由调用者持有（通常放在栈上），映射和拉链的输出缓冲区取自管道内的
+ * 固定大小暂存区，搭建和执行管道都不分配堆内存。源范围或拉链的第二个范围
+ * 不是连续存储时，每次执行克隆一次迭代器。
+ *
+ * 管道可以重复执行，截取、跳过和分块的计数在每次执行开始时重置。
+ */
+
+#ifndef CSTL_RANGE_H
+#define CSTL_RANGE_H
+
+#include "cstl/common.h"
+#include "cstl/iterator.h"
+#include "cstl/vector.h"
+#include "cstl/algo.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief 管道中适配器的最大数量
+ */
+#define RANGE_MAX_STAGES 16
+
+/**
+ * @brief 管道暂存区字节数，映射和拉链的输出元素从这里分配
+ */
+#define RANGE_SCRATCH_SIZE 512
+
+/**
+ * @brief 映射函数指针类型
+ *
+ * @param input 输入元素指针
+ * @param output 输出元素指针
+ */
+typedef void (*range_map_fn_t)(const void* input, void* output);
+
+/**
+ * @brief 拉链合并函数指针类型
+ *
+ * @param a 第一个范围的元素指针
+ * @param b 第二个范围的元素指针
+ * @param output 输出元素指针
+ */
+typedef void (*range_zip_fn_t)(const void* a, const void* b, void* output);
+
+/**
+ * @brief 分块适配器输出的元素
+ */
+typedef struct range_chunk_t {
+    void* data;                 /**< 块内元素首地址，元素连续存放 */
+    size_t count;               /**< 块内元素数量，只有最后一块可能不满 */
+} range_chunk_t;
+
+/**
+ * @brief 适配器类型
+ */
+typedef enum {
+    RANGE_STAGE_FILTER,         /**< 过滤 */
+    RANGE_STAGE_MAP,            /**< 映射 */
+    RANGE_STAGE_TAKE,           /**< 截取前n个 */
+    RANGE_STAGE_DROP,           /**< 跳过前n个 */
+    RANGE_STAGE_ZIP,            /**< 与第二个范围逐对合并 */
+    RANGE_STAGE_CHUNK           /**< 分块 */
+} range_stage_type_t;
+
+/**
+ * @brief 适配器
+ */
+typedef struct range_stage_t {
+    range_stage_type_t type;    /**< 适配器类型 */
+    size_t input_size;          /**< 输入元素字节数 */
+    size_t output_size;         /**< 输出元素字节数 */
+    predicate_fn_t predicate;   /**< 过滤条件 */
+    range_map_fn_t map;         /**< 映射函数 */
+    range_zip_fn_t zip;         /**< 拉链合并函数 */
+    size_t count;               /**< 截取/跳过的数量或块大小 */
+    void* buffer;               /**< 输出缓冲区，映射和拉链指向暂存区，分块指向调用者的缓冲区 */
+    iterator_t* begin;          /**< 拉链第二个范围的起始迭代器 */
+    iterator_t* end;            /**< 拉链第二个范围的结束迭代器 */
+} range_stage_t;
+
+/**
+ * @brief 惰性范围管道
+ *
+ * 字段只应通过本文件中的函数修改。
+ */
+typedef struct range_t {
+    iterator_t* begin;          /**< 源范围起始迭代器，不归管道所有 */
+    iterator_t* end;            /**< 源范围结束迭代器，不归管道所有 */
+    size_t element_size;        /**< 管道当前输出元素的字节数 */
+    size_t stage_count;         /**< 适配器数量 */
+    range_stage_t stages[RANGE_MAX_STAGES]; /**< 适配器 */
+    size_t scratch_used;        /**< 暂存区已用字节数 */
+    error_code_t error;         /**< 搭建管道时遇到的第一个错误，终结操作直接返回它 */
+    union {
+        long double align_float;
+        uint64_t align_int;
+        void* align_pointer;
+        unsigned char bytes[RANGE_SCRATCH_SIZE];
+    } scratch;                  /**< 暂存区 */
+} range_t;
+
+/**
+ * @brief 用源范围初始化管道
+ *
+ * @param range 管道
+ * @param begin 源范围起始迭代器
+ * @param end 源范围结束迭代器
+ * @return error_code_t 错误码
+ */
+error_code_t range_init(range_t* range, iterator_t* begin, iterator_t* end);
+
+/**
+ * @brief 追加过滤适配器，只保留满足条件的元素
+ *
+ * 搭建管道的函数在出错时把错误记录在管道中，后续的搭建和终结操作都返回该错误，
+ * 因此可以连续调用后只检查终结操作的返回值。
+ *
+ * @param range 管道
+ * @param predicate 条件函数
+ * @return error_code_t 错误码，适配器超过RANGE_MAX_STAGES个时返回CSTL_ERROR_CONTAINER_FULL
+ */
+error_code_t range_filter(range_t* range, predicate_fn_t predicate);
+
+/**
+ * @brief 追加映射适配器，把每个元素变换为output_size字节的新元素
+ *
+ * @param range 管道
+ * @param map 映射函数
+ * @param output_size 输出元素字节数
+ * @return error_code_t 错误码，暂存区不足时返回CSTL_ERROR_CONTAINER_FULL
+ */
+error_code_t range_map(range_t* range, range_map_fn_t map, size_t output_size);
+
+/**
+ * @brief 追加截取适配器，只保留前count个元素
+ *
+ * 截取满count个元素后立即停止遍历源范围。
+ *
+ * @param range 管道
+ * @param count 保留的元素数量
+ * @return error_code_t 错误码
+ */
+error_code_t range_take(range_t* range, size_t count);
+
+/**
+ * @brief 追加跳过适配器，丢弃前count个元素
+ *
+ * @param range 管道
+ * @param count 丢弃的元素数量
+ * @return error_code_t 错误码
+ */
+error_code_t range_drop(range_t* range, size_t count);
+
+/**
+ * @brief 追加拉链适配器，把元素与第二个范围的对应元素合并为output_size字节的新元素
+ *
+ * 任一范围结束时停止。第二个范围的迭代器不归管道所有，执行时不会被修改。
+ *
+ * @param range 管道
+ * @param begin 第二个范围起始迭代器
+ * @param end 第二个范围结束迭代器
+ * @param zip 合并函数
+ * @param output_size 输出元素字节数
+ * @return error_code_t 错误码
+ */
+error_code_t range_zip(range_t* range, iterator_t* begin, iterator_t* end, range_zip_fn_t zip,
+                       size_t output_size);
+
+/**
+ * @brief 追加分块适配器，每size个元素组成一个range_chunk_t
+ *
+ * 元素复制到调用者提供的缓冲区中，之后管道的元素类型变为range_chunk_t。
+ * 源范围结束时不满size个的剩余元素组成最后一块。
+ *
+ * @param range 管道
+ * @param size 块大小
+ * @param buffer 缓冲区，至少能容纳size个当前元素
+ * @return error_code_t 错误码
+ */
+error_code_t range_chunk(range_t* range, size_t size, void* buffer);
+
+/**
+ * @brief 执行管道，把输出元素追加到向量末尾
+ *
+ * @param range 管道
+ * @param dest 目标向量，元素大小必须等于管道输出元素大小
+ * @return error_code_t 错误码
+ */
+error_code_t range_collect(range_t* range, vector_t* dest);
+
+/**
+ * @brief 执行管道，对每个输出元素执行op(result, element)
+ *
+ * @param range 管道
+ * @param op 二元操作，把元素合并到累加值中
+ * @param result 输入输出参数，调用前存放初始值，调用后存放归约结果
+ * @return error_code_t 错误码
+ */
+error_code_t range_reduce(range_t* range, binary_op_fn_t op, void* result);
+
+/**
+ * @brief 执行管道，对每个输出元素执行操作
+ *
+ * 没有映射、拉链或分块时元素指针直接指向源范围，op可以原地修改源元素。
+ *
+ * @param range 管道
+ * @param op 一元操作
+ * @return error_code_t 错误码
+ */
+error_code_t range_for_each(range_t* range, unary_op_fn_t op);
+
+/**
+ * @brief 执行管道，统计输出元素的数量
+ *
+ * @param range 管道
+ * @param count 输出参数，存储元素数量
+ * @return error_code_t 错误码
+ */
+error_code_t range_count(range_t* range, size_t* count);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CSTL_RANGE_H */
@@ -0,0 +1,231 @@
+/**
+ * @file simd.h
+ * @brief CSTL库的SIMD内核头文件
+ *
+ * 该文件定义了CSTL库的SIMD内核，包括运行时CPU特性检测、
+ * 连续内存上按位比较的查找、计数、比较、相邻查找与子序列搜索，
+ * int16/int32/float/double数组的数值内核，以及小数组的排序网络。
+ *
+ * 在x86/x64上按CPU支持情况依次选择AVX2、SSE2和标量实现，
+ * 其他平台只使用标量实现。所有内核都接受任意对齐的地址。
+ *
+ * 数值内核中整数求和在int64中精确累加，浮点结果统一在double中计算，
+ * 求和使用Kahan补偿。
+ */
+
+#ifndef CSTL_SIMD_H
+#define CSTL_SIMD_H
+
+#include "cstl/common.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief SIMD特性标志
+ */
+typedef enum {
+    SIMD_FEATURE_SSE2 = 1u << 0,    /**< SSE2 */
+    SIMD_FEATURE_AVX2 = 1u << 1     /**< AVX2（需要操作系统保存YMM状态） */
+} simd_feature_t;
+
+/**
+ * @brief 获取当前CPU支持的SIMD特性
+ *
+ * @return unsigned int simd_feature_t标志的按位或
+ */
+unsigned int simd_cpu_features(void);
+
+/**
+ * @brief 获取内核实际使用的SIMD特性
+ *
+ * @return unsigned int CPU支持的特性与特性掩码的交集
+ */
+unsigned int simd_active_features(void);
+
+/**
+ * @brief 设置允许使用的SIMD特性掩码
+ *
+ * 主要用于性能测试和对拍，例如传入0强制使用标量实现。
+ * 默认允许所有特性。
+ *
+ * @param mask simd_feature_t标志的按位或
+ */
+void simd_set_feature_mask(unsigned int mask);
+
+/**
+ * @brief 按位查找第一个等于给定值的元素
+ *
+ * @param data 数据首地址
+ * @param count 元素数量
+ * @param width 元素字节数，1/2/4/8时使用SIMD，其他宽度逐元素memcmp
+ * @param value 要查找的值指针
+ * @return size_t 第一个相等元素的下标，未找到返回count
+ */
+size_t simd_find(const void* data, size_t count, size_t width, const void* value);
+
+/**
+ * @brief 按位统计等于给定值的元素数量
+ *
+ * @param data 数据首地址
+ * @param count 元素数量
+ * @param width 元素字节数，1/2/4/8时使用SIMD，其他宽度逐元素memcmp
+ * @param value 要统计的值指针
+ * @return size_t 相等元素的数量
+ */
+size_t simd_count(const void* data, size_t count, size_t width, const void* value);
+
+/**
+ * @brief 按位查找两个数组中第一个不相等的元素
+ *
+ * @param a 第一个数组首地址
+ * @param b 第二个数组首地址
+ * @param count 元素数量
+ * @param width 元素字节数，可以是任意宽度
+ * @return size_t 第一个不相等元素的下标，全部相等返回count
+ */
+size_t simd_mismatch(const void* a, const void* b, size_t count, size_t width);
+
+/**
+ * @brief 按位查找第一对相邻的相等元素
+ *
+ * @param data 数据首地址
+ * @param count 元素数量
+ * @param width 元素字节数，1/2/4/8时使用SIMD，其他宽度逐元素memcmp
+ * @return size_t 满足data[i] == data[i + 1]的最小下标i，未找到返回count
+ */
+size_t simd_adjacent_find(const void* data, size_t count, size_t width);
+
+/**
+ * @brief 按位查找子序列第一次出现的位置
+ *
+ * 模式不超过256字节且宽度为1/2/4/8时使用SIMD首尾元素过滤，
+ * 否则使用Boyer-Moore-Horspool。
+ *
+ * @param data 数据首地址
+ * @param count 元素数量
+ * @param needle 子序列首地址
+ * @param needle_count 子序列元素数量
+ * @param width 元素字节数
+ * @return size_t 第一次出现的起始下标，未找到或needle_count为0时返回count
+ */
+size_t simd_search(const void* data, size_t count, const void* needle, size_t needle_count, size_t width);
+
+/**
+ * @brief 按位查找子序列最后一次出现的位置
+ *
+ * 从数组末尾向前搜索，策略与simd_search相同。
+ *
+ * @param data 数据首地址
+ * @param count 元素数量
+ * @param needle 子序列首地址
+ * @param needle_count 子序列元素数量
+ * @param width 元素字节数
+ * @return size_t 最后一次出现的起始下标，未找到或needle_count为0时返回count
+ */
+size_t simd_search_last(const void* data, size_t count, const void* needle, size_t needle_count, size_t width);
+
+/**
+ * @brief 查找数组中最小值和最大值第一次出现的下标
+ *
+ * 浮点版本跳过NaN，全部为NaN时两个下标都为0。
+ *
+ * @param data 数据首地址
+ * @param count 元素数量
+ * @param min_index 输出参数，最小值下标，可以为NULL
+ * @param max_index 输出参数，最大值下标，可以为NULL
+ * @return error_code_t 错误码，count为0时返回CSTL_ERROR_CONTAINER_EMPTY
+ */
+error_code_t simd_minmax_index_i16(const int16_t* data, size_t count, size_t* min_index, size_t* max_index);
+error_code_t simd_minmax_index_i32(const int32_t* data, size_t count, size_t* min_index, size_t* max_index);
+error_code_t simd_minmax_index_f32(const float* data, size_t count, size_t* min_index, size_t* max_index);
+error_code_t simd_minmax_index_f64(const double* data, size_t count, size_t* min_index, size_t* max_index);
+
+/**
+ * @brief 数组求和
+ *
+ * 整数版本返回int64（int32超出范围时按补码回绕），
+ * 浮点版本在double中做Kahan补偿求和。
+ *
+ * @param data 数据首地址
+ * @param count 元素数量
+ * @return 和，data为NULL时返回0
+ */
+int64_t simd_sum_i16(const int16_t* data, size_t count);
+int64_t simd_sum_i32(const int32_t* data, size_t count);
+double simd_sum_f32(const float* data, size_t count);
+double simd_sum_f64(const double* data, size_t count);
+
+/**
+ * @brief 数组平方和
+ *
+ * @param data 数据首地址
+ * @param count 元素数量
+ * @return double 平方和，int16版本在转换为double前是精确的
+ */
+double simd_sum_squares_i16(const int16_t* data, size_t count);
+double simd_sum_squares_i32(const int32_t* data, size_t count);
+double simd_sum_squares_f32(const float* data, size_t count);
+double simd_sum_squares_f64(const double* data, size_t count);
+
+/**
+ * @brief 数组均方根 sqrt(平方和 / count)
+ *
+ * @param data 数据首地址
+ * @param count 元素数量
+ * @return double 均方根，count为0时返回0
+ */
+double simd_rms_i16(const int16_t* data, size_t count);
+double simd_rms_i32(const int32_t* data, size_t count);
+double simd_rms_f32(const float* data, size_t count);
+double simd_rms_f64(const double* data, size_t count);
+
+/**
+ * @brief 两个数组的点积
+ *
+ * @param a 第一个数组首地址
+ * @param b 第二个数组首地址
+ * @param count 元素数量
+ * @return 点积，整数版本返回int64（int32超出范围时按补码回绕），浮点版本在double中累加
+ */
+int64_t simd_dot_i16(const int16_t* a, const int16_t* b, size_t count);
+int64_t simd_dot_i32(const int32_t* a, const int32_t* b, size_t count);
+double simd_dot_f32(const float* a, const float* b, size_t count);
+double simd_dot_f64(const double* a, const double* b, size_t count);
+
+/**
+ * @brief 排序网络支持的最大元素数量
+ */
+#define SIMD_SORT_SMALL_MAX 32
+
+/**
+ * @brief 元素少于该数量或没有AVX2时改用插入排序
+ *
+ * 排序网络的比较次数固定，元素很少时不如插入排序；标量的min/max网络
+ * 在各种规模上都没有优于插入排序（见sorting_network_performance_test）。
+ */
+#define SIMD_SORT_NETWORK_MIN 8
+
+/**
+ * @brief 对不超过SIMD_SORT_SMALL_MAX个元素的小数组升序排序
+ *
+ * 有AVX2时数组补齐到2的幂后在寄存器中执行双调排序网络，比较交换只用min/max，
+ * 没有依赖数据的分支；int16扩展为int32后排序。
+ * 浮点数按全序排序：-NaN < -inf < ... < -0 < +0 < ... < +inf < +NaN。
+ *
+ * @param data 数据首地址
+ * @param count 元素数量
+ * @return error_code_t 错误码，count超过SIMD_SORT_SMALL_MAX时返回CSTL_ERROR_INVALID_ARGUMENT
+ */
+error_code_t simd_sort_small_i16(int16_t* data, size_t count);
+error_code_t simd_sort_small_i32(int32_t* data, size_t count);
+error_code_t simd_sort_small_i64(int64_t* data, size_t count);
+error_code_t simd_sort_small_f32(float* data, size_t count);
+error_code_t simd_sort_small_f64(double* data, size_t count);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CSTL_SIMD_H */
@@ -0,0 +1,250 @@
+/**
+ * @file slot_map.h
+ * @brief CSTL库的槽位映射容器头文件
+ *
+ * 该文件定义了CSTL库的槽位映射（slot map）容器。插入元素时返回64位句柄，
+ * 低32位是槽位下标，高32位是槽位的代数（generation）：
+ * - 元素紧凑地存放在一个向量中，删除时把最后一个元素移到空出的位置，遍历与遍历vector_t相同；
+ * - 槽位数组记录每个槽位对应的元素位置，空闲槽位串成空闲链表重复使用；
+ * - 删除元素时槽位的代数加1，之前发出的句柄失效，用失效的句柄查找会返回CSTL_ERROR_NOT_FOUND，
+ *   不会访问到复用该槽位的新元素。
+ *
+ * 插入、删除和查找都是O(1)。句柄在元素被删除前一直有效，不受其他元素插入、删除和向量扩容的影响；
+ * slot_map_get返回的元素指针只在下一次插入或删除之前有效，需要长期保存时保存句柄。
+ */
+
+#ifndef CSTL_SLOT_MAP_H
+#define CSTL_SLOT_MAP_H
+
+#include "cstl/common.h"
+#include "cstl/iterator.h"
+#include "cstl/vector.h"
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief 槽位映射句柄类型
+ */
+typedef uint64_t slot_handle_t;
+
+/**
+ * @brief 空句柄，不会由slot_map_insert返回
+ */
+#define SLOT_MAP_NULL_HANDLE ((slot_handle_t)0)
+
+/**
+ * @brief 无效的槽位下标，表示空闲链表的末尾
+ */
+#define SLOT_MAP_NIL ((uint32_t)0xFFFFFFFFu)
+
+/**
+ * @brief 槽位结构体
+ */
+typedef struct slot_map_slot_t {
+    uint32_t index;      /**< 使用中时是元素在紧凑数组中的位置，空闲时是下一个空闲槽位 */
+    uint32_t generation; /**< 槽位的代数，从1开始，为0表示槽位已经用尽不再复用 */
+} slot_map_slot_t;
+
+/**
+ * @brief 槽位映射容器结构体
+ */
+typedef struct slot_map_t {
+    /**
+     * @brief 紧凑存放的元素
+     */
+    vector_t* values;
+
+    /**
+     * @brief 每个元素对应的槽位下标（uint32_t），与values一一对应
+     */
+    vector_t* dense_slots;
+
+    /**
+     * @brief 槽位数组（slot_map_slot_t）
+     */
+    vector_t* slots;
+
+    /**
+     * @brief 第一个空闲槽位，SLOT_MAP_NIL表示没有空闲槽位
+     */
+    uint32_t free_head;
+
+    /**
+     * @brief 最后一个空闲槽位，释放的槽位加到末尾，使同一槽位尽量晚地被复用
+     */
+    uint32_t free_tail;
+
+    /**
+     * @brief 元素大小
+     */
+    size_t element_size;
+
+    /**
+     * @brief 互斥锁（线程安全选项）
+     */
+    mutex_t lock;
+
+    /**
+     * @brief 是否启用线程安全
+     */
+    int thread_safe;
+
+    /**
+     * @brief 析构函数指针
+     */
+    destructor_fn_t destructor;
+} slot_map_t;
+
+/**
+ * @brief 创建槽位映射容器
+ *
+ * @param element_size 元素大小
+ * @param allocator 分配器指针，如果为NULL则使用默认分配器
+ * @param destructor 析构函数指针，删除元素时对元素调用，为NULL时不调用
+ * @return slot_map_t* 槽位映射容器指针，失败返回NULL
+ */
+slot_map_t* slot_map_create(size_t element_size, allocator_t* allocator, destructor_fn_t destructor);
+
+/**
+ * @brief 销毁槽位映射容器
+ *
+ * @param map 槽位映射容器指针
+ */
+void slot_map_destroy(slot_map_t* map);
+
+/**
+ * @brief 清空槽位映射容器
+ *
+ * 所有槽位的代数加1后放回空闲链表，之前发出的句柄全部失效。
+ *
+ * @param map 槽位映射容器指针
+ */
+void slot_map_clear(slot_map_t* map);
+
+/**
+ * @brief 获取槽位映射容器大小
+ *
+ * @param map 槽位映射容器指针
+ * @return size_t 元素数量
+ */
+size_t slot_map_size(const slot_map_t* map);
+
+/**
+ * @brief 检查槽位映射容器是否为空
+ *
+ * @param map 槽位映射容器指针
+ * @return int 如果为空返回非零，否则返回零
+ */
+int slot_map_empty(const slot_map_t* map);
+
+/**
+ * @brief 预留容量，之后插入不超过capacity个元素时不再重新分配
+ *
+ * @param map 槽位映射容器指针
+ * @param capacity 元素容量
+ * @return error_code_t 错误码
+ */
+error_code_t slot_map_reserve(slot_map_t* map, size_t capacity);
+
+/**
+ * @brief 插入元素
+ *
+ * @param map 槽位映射容器指针
+ * @param element 要插入的元素指针
+ * @param handle 输出参数，存储新元素的句柄
+ * @return error_code_t 错误码，槽位数量超过32位时返回CSTL_ERROR_CONTAINER_FULL
+ */
+error_code_t slot_map_insert(slot_map_t* map, const void* element, slot_handle_t* handle);
+
+/**
+ * @brief 删除句柄对应的元素
+ *
+ * 最后一个元素移到被删除元素的位置，之前取得的元素指针失效。
+ *
+ * @param map 槽位映射容器指针
+ * @param handle 元素句柄
+ * @return error_code_t 错误码，句柄已经失效时返回CSTL_ERROR_NOT_FOUND
+ */
+error_code_t slot_map_erase(slot_map_t* map, slot_handle_t handle);
+
+/**
+ * @brief 获取句柄对应的元素
+ *
+ * @param map 槽位映射容器指针
+ * @param handle 元素句柄
+ * @param element 输出参数，存储元素指针，只在下一次插入或删除之前有效
+ * @return error_code_t 错误码，句柄已经失效时返回CSTL_ERROR_NOT_FOUND
+ */
+error_code_t slot_map_get(const slot_map_t* map, slot_handle_t handle, void** element);
+
+/**
+ * @brief 检查句柄是否有效
+ *
+ * @param map 槽位映射容器指针
+ * @param handle 元素句柄
+ * @return int 如果句柄对应的元素存在返回非零，否则返回零
+ */
+int slot_map_contains(const slot_map_t* map, slot_handle_t handle);
+
+/**
+ * @brief 获取紧凑存放的元素数组
+ *
+ * 数组中有slot_map_size个元素，顺序不是插入顺序。只在下一次插入或删除之前有效。
+ *
+ * @param map 槽位映射容器指针
+ * @return void* 元素数组，容器为空时可能为NULL
+ */
+void* slot_map_data(const slot_map_t* map);
+
+/**
+ * @brief 获取紧凑数组中第index个元素的句柄
+ *
+ * @param map 槽位映射容器指针
+ * @param index 元素在紧凑数组中的位置
+ * @return slot_handle_t 元素句柄，index越界时返回SLOT_MAP_NULL_HANDLE
+ */
+slot_handle_t slot_map_handle_at(const slot_map_t* map, size_t index);
+
+/**
+ * @brief 启用线程安全
+ *
+ * @param map 槽位映射容器指针
+ * @return error_code_t 错误码
+ */
+error_code_t slot_map_enable_thread_safety(slot_map_t* map);
+
+/**
+ * @brief 禁用线程安全
+ *
+ * @param map 槽位映射容器指针
+ * @return error_code_t 错误码
+ */
+error_code_t slot_map_disable_thread_safety(slot_map_t* map);
+
+/**
+ * @brief 获取槽位映射容器起始迭代器
+ *
+ * 返回紧凑数组上的向量迭代器，可以用于algo_*中只读取或原地修改元素的算法；
+ * 不能用于排序等移动元素的算法，否则句柄会指向错误的元素。
+ *
+ * @param map 槽位映射容器指针
+ * @return iterator_t* 起始迭代器指针，失败返回NULL
+ */
+iterator_t* slot_map_begin(slot_map_t* map);
+
+/**
+ * @brief 获取槽位映射容器结束迭代器
+ *
+ * @param map 槽位映射容器指针
+ * @return iterator_t* 结束迭代器指针，失败返回NULL
+ */
+iterator_t* slot_map_end(slot_map_t* map);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CSTL_SLOT_MAP_H */
@@ -0,0 +1,186 @@
+/**
+ * @file thread_pool.h
+ * @brief CSTL库的线程池头文件
+ *
+ * 该文件定义了CSTL库的线程池，包括任务提交、fork/join任务组、
+ * 分块并行循环和进程内共享的默认线程池，供并行算法复用同一组工作线程。
+ *
+ * 每个工作线程持有一个Chase-Lev双端队列：工作线程内部提交的任务压入
+ * 自己队列的底部并按后进先出执行，空闲线程从其他队列顶部窃取任务；
+ * 外部线程提交的任务进入共享的注入队列。
+ */
+
+#ifndef CSTL_THREAD_POOL_H
+#define CSTL_THREAD_POOL_H
+
+#include "cstl/common.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief 任务函数指针类型
+ *
+ * @param arg 任务参数
+ */
+typedef void (*thread_task_fn_t)(void* arg);
+
+/**
+ * @brief 区间任务函数指针类型
+ *
+ * @param context 用户上下文
+ * @param begin 区间起始下标
+ * @param end 区间结束下标（不包含）
+ */
+typedef void (*thread_range_fn_t)(void* context, size_t begin, size_t end);
+
+/**
+ * @brief 线程池结构体（不透明类型）
+ */
+typedef struct thread_pool_t thread_pool_t;
+
+/**
+ * @brief 线程池创建选项
+ */
+typedef struct thread_pool_options_t {
+    size_t num_threads;     /**< 工作线程数量，为0时使用硬件线程数量 */
+    int pin_threads;        /**< 非零时将第i个工作线程绑定到第i个CPU（不支持的平台上忽略） */
+} thread_pool_options_t;
+
+/**
+ * @brief fork/join任务组
+ *
+ * 记录通过thread_task_group_run提交且尚未完成的任务数量，
+ * 可以直接在栈上定义，不需要销毁。
+ */
+typedef struct thread_task_group_t {
+    thread_pool_t* pool;        /**< 所属线程池 */
+    volatile size_t pending;    /**< 未完成的任务数量（原子访问） */
+} thread_task_group_t;
+
+/**
+ * @brief 获取硬件线程数量
+ *
+ * @return size_t 在线的逻辑CPU数量，无法获取时返回1
+ */
+size_t thread_hardware_concurrency(void);
+
+/**
+ * @brief 创建线程池
+ *
+ * @param num_threads 工作线程数量，为0时使用硬件线程数量
+ * @return thread_pool_t* 线程池指针，失败返回NULL
+ */
+thread_pool_t* thread_pool_create(size_t num_threads);
+
+/**
+ * @brief 按选项创建线程池
+ *
+ * @param options 创建选项，为NULL时等同于thread_pool_create(0)
+ * @return thread_pool_t* 线程池指针，失败返回NULL
+ */
+thread_pool_t* thread_pool_create_ex(const thread_pool_options_t* options);
+
+/**
+ * @brief 销毁线程池
+ *
+ * 等待已提交的任务全部执行完毕后回收工作线程，不能在该线程池的任务中调用。
+ *
+ * @param pool 线程池指针
+ */
+void thread_pool_destroy(thread_pool_t* pool);
+
+/**
+ * @brief 获取线程池的工作线程数量
+ *
+ * @param pool 线程池指针
+ * @return size_t 工作线程数量
+ */
+size_t thread_pool_size(const thread_pool_t* pool);
+
+/**
+ * @brief 获取当前线程在线程池中的工作线程编号
+ *
+ * 可用于按工作线程分配的暂存区。
+ *
+ * @param pool 线程池指针
+ * @return size_t 工作线程编号，当前线程不是该线程池的工作线程时返回(size_t)-1
+ */
+size_t thread_pool_worker_index(const thread_pool_t* pool);
+
+/**
+ * @brief 向线程池提交任务
+ *
+ * 在工作线程内调用时任务压入本线程的队列，否则进入共享注入队列。
+ *
+ * @param pool 线程池指针
+ * @param task 任务函数指针
+ * @param arg 任务参数
+ * @return error_code_t 错误码
+ */
+error_code_t thread_pool_submit(thread_pool_t* pool, thread_task_fn_t task, void* arg);
+
+/**
+ * @brief 将[0, count)按grain_size分块并行执行，返回时所有分块均已完成
+ *
+ * 调用线程本身也会领取分块执行，因此即使在工作线程内部调用、
+ * 或者所有工作线程都在忙，也不会死锁。分块边界总是grain_size的整数倍。
+ *
+ * @param pool 线程池指针，为NULL时使用默认线程池
+ * @param count 元素总数
+ * @param grain_size 每个分块的元素数量，必须大于0
+ * @param range_fn 区间任务函数指针
+ * @param context 传给range_fn的用户上下文
+ * @return error_code_t 错误码
+ */
+error_code_t thread_pool_parallel_for(thread_pool_t* pool, size_t count, size_t grain_size,
+                                      thread_range_fn_t range_fn, void* context);
+
+/**
+ * @brief 初始化任务组
+ *
+ * @param group 任务组指针
+ * @param pool 线程池指针，为NULL时使用默认线程池
+ * @return error_code_t 错误码
+ */
+error_code_t thread_task_group_init(thread_task_group_t* group, thread_pool_t* pool);
+
+/**
+ * @brief 在任务组中派生（fork）一个任务
+ *
+ * 内存不足无法入队时任务会在当前线程上同步执行，保证join语义不变。
+ *
+ * @param group 任务组指针
+ * @param task 任务函数指针
+ * @param arg 任务参数
+ * @return error_code_t 错误码
+ */
+error_code_t thread_task_group_run(thread_task_group_t* group, thread_task_fn_t task, void* arg);
+
+/**
+ * @brief 等待（join）任务组中所有任务完成
+ *
+ * 等待期间当前线程不会休眠，而是从本线程队列、注入队列和其他工作线程
+ * 窃取任务来执行，因此可以在任务内部嵌套使用而不会耗尽工作线程。
+ *
+ * @param group 任务组指针
+ * @return error_code_t 错误码
+ */
+error_code_t thread_task_group_wait(thread_task_group_t* group);
+
+/**
+ * @brief 获取进程内共享的默认线程池
+ *
+ * 首次调用时按硬件线程数量创建，之后返回同一实例，
+ * 库内的并行算法都运行在这个线程池上，避免各自创建线程导致超额订阅。
+ *
+ * @return thread_pool_t* 默认线程池指针，创建失败返回NULL
+ */
+thread_pool_t* thread_pool_default(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CSTL_THREAD_POOL_H */
@@ -0,0 +1,340 @@
+/**
+ * @file ulist.h
+ * @brief CSTL库的展开链表容器头文件
+ *
+ * 该文件定义了CSTL库的展开链表容器。每个节点连续存放最多node_capacity个元素，
+ * 节点之间用双向链表连接：
+ * - 顺序扫描时绝大部分访问落在节点内的连续内存中，速度接近向量；
+ * - 中间插入和删除只移动一个节点内的元素，代价与节点容量有关而与元素总数无关。
+ *
+ * 节点满时分裂为两半；删除后节点内元素少于容量的1/4时，与相邻节点合并，
+ * 合并放不下时从相邻节点借一部分元素，保证除了首尾以外的节点至少是1/4满。
+ * 在末尾追加（包括ulist_append批量追加）时新建节点而不分裂，顺序建立的链表节点都是满的。
+ *
+ * 按索引访问从头、尾和上一次访问的节点（游标）中最近的一处出发，逐节点跳过，
+ * 在同一位置附近连续编辑时定位为O(1)。插入和删除会移动元素，之前取得的元素指针和迭代器失效。
+ */
+
+#ifndef CSTL_ULIST_H
+#define CSTL_ULIST_H
+
+#include "cstl/common.h"
+#include "cstl/iterator.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief 默认节点大小（字节），node_capacity为0时按它计算每个节点的元素数量
+ */
+#define ULIST_DEFAULT_NODE_BYTES 1024
+
+/**
+ * @brief 每个节点的最小元素数量
+ */
+#define ULIST_MIN_NODE_CAPACITY 4
+
+/**
+ * @brief 展开链表节点结构体，元素紧跟在结构体之后存放
+ */
+typedef struct ulist_node_t {
+    struct ulist_node_t* prev;  /**< 前一个节点指针 */
+    struct ulist_node_t* next;  /**< 下一个节点指针 */
+    size_t count;               /**< 节点内的元素数量 */
+} ulist_node_t;
+
+/**
+ * @brief 展开链表容器结构体
+ */
+typedef struct ulist_t {
+    /**
+     * @brief 头节点指针
+     */
+    ulist_node_t* head;
+
+    /**
+     * @brief 尾节点指针
+     */
+    ulist_node_t* tail;
+
+    /**
+     * @brief 元素数量
+     */
+    size_t size;
+
+    /**
+     * @brief 节点数量
+     */
+    size_t node_count;
+
+    /**
+     * @brief 元素大小
+     */
+    size_t element_size;
+
+    /**
+     * @brief 每个节点的元素容量
+     */
+    size_t node_capacity;
+
+    /**
+     * @brief 游标节点，最近一次按索引访问到的节点，可以为NULL
+     */
+    ulist_node_t* cursor_node;
+
+    /**
+     * @brief 游标节点第一个元素的索引
+     */
+    size_t cursor_index;
+
+    /**
+     * @brief 分配器指针
+     */
+    allocator_t* allocator;
+
+    /**
+     * @brief 互斥锁（线程安全选项）
+     */
+    mutex_t lock;
+
+    /**
+     * @brief 是否启用线程安全
+     */
+    int thread_safe;
+
+    /**
+     * @brief 析构函数指针
+     */
+    destructor_fn_t destructor;
+} ulist_t;
+
+/**
+ * @brief 创建展开链表容器
+ *
+ * @param element_size 元素大小
+ * @param node_capacity 每个节点的元素容量，为0时按ULIST_DEFAULT_NODE_BYTES计算
+ * @param allocator 分配器指针，如果为NULL则使用默认分配器
+ * @param destructor 析构函数指针，移除元素时对元素调用，为NULL时不调用
+ * @return ulist_t* 展开链表容器指针，失败返回NULL
+ */
+ulist_t* ulist_create(size_t element_size, size_t node_capacity, allocator_t* allocator, destructor_fn_t destructor);
+
+/**
+ * @brief 销毁展开链表容器
+ *
+ * @param list 展开链表容器指针
+ */
+void ulist_destroy(ulist_t* list);
+
+/**
+ * @brief 初始化展开链表容器
+ *
+ * @param list 展开链表容器指针
+ * @param element_size 元素大小
+ * @param node_capacity 每个节点的元素容量，为0时按ULIST_DEFAULT_NODE_BYTES计算，
+ *                      否则不能小于ULIST_MIN_NODE_CAPACITY
+ * @param allocator 分配器指针，如果为NULL则使用默认分配器
+ * @return error_code_t 错误码
+ */
+error_code_t ulist_init(ulist_t* list, size_t element_size, size_t node_capacity, allocator_t* allocator);
+
+/**
+ * @brief 清空展开链表容器，释放所有节点
+ *
+ * @param list 展开链表容器指针
+ */
+void ulist_clear(ulist_t* list);
+
+/**
+ * @brief 获取展开链表容器大小
+ *
+ * @param list 展开链表容器指针
+ * @return size_t 元素数量
+ */
+size_t ulist_size(const ulist_t* list);
+
+/**
+ * @brief 检查展开链表容器是否为空
+ *
+ * @param list 展开链表容器指针
+ * @return int 如果为空返回非零，否则返回零
+ */
+int ulist_empty(const ulist_t* list);
+
+/**
+ * @brief 在展开链表容器前端添加元素
+ *
+ * @param list 展开链表容器指针
+ * @param element 要添加的元素指针
+ * @return error_code_t 错误码
+ */
+error_code_t ulist_push_front(ulist_t* list, const void* element);
+
+/**
+ * @brief 在展开链表容器后端添加元素
+ *
+ * @param list 展开链表容器指针
+ * @param element 要添加的元素指针
+ * @return error_code_t 错误码
+ */
+error_code_t ulist_push_back(ulist_t* list, const void* element);
+
+/**
+ * @brief 在展开链表容器后端批量追加元素
+ *
+ * 先填满尾节点，剩余元素整块复制到新建的满节点中。
+ *
+ * @param list 展开链表容器指针
+ * @param elements 连续存放的元素数组
+ * @param count 元素数量
+ * @return error_code_t 错误码，失败时已经追加的元素保留在链表中
+ */
+error_code_t ulist_append(ulist_t* list, const void* elements, size_t count);
+
+/**
+ * @brief 移除展开链表容器前端元素
+ *
+ * @param list 展开链表容器指针
+ * @return error_code_t 错误码
+ */
+error_code_t ulist_pop_front(ulist_t* list);
+
+/**
+ * @brief 移除展开链表容器后端元素
+ *
+ * @param list 展开链表容器指针
+ * @return error_code_t 错误码
+ */
+error_code_t ulist_pop_back(ulist_t* list);
+
+/**
+ * @brief 获取展开链表容器前端元素
+ *
+ * @param list 展开链表容器指针
+ * @param element 输出参数，存储元素指针
+ * @return error_code_t 错误码
+ */
+error_code_t ulist_front(const ulist_t* list, void** element);
+
+/**
+ * @brief 获取展开链表容器后端元素
+ *
+ * @param list 展开链表容器指针
+ * @param element 输出参数，存储元素指针
+ * @return error_code_t 错误码
+ */
+error_code_t ulist_back(const ulist_t* list, void** element);
+
+/**
+ * @brief 在指定索引处插入元素
+ *
+ * @param list 展开链表容器指针
+ * @param index 插入位置，等于元素数量时追加到末尾
+ * @param element 要插入的元素指针
+ * @return error_code_t 错误码
+ */
+error_code_t ulist_insert(ulist_t* list, size_t index, const void* element);
+
+/**
+ * @brief 移除指定索引的元素
+ *
+ * @param list 展开链表容器指针
+ * @param index 元素索引
+ * @return error_code_t 错误码
+ */
+error_code_t ulist_erase(ulist_t* list, size_t index);
+
+/**
+ * @brief 移除所有满足谓词的元素
+ *
+ * 单次遍历，把保留的元素依次紧凑到前面的节点中，并释放多余的节点。
+ *
+ * @param list 展开链表容器指针
+ * @param predicate 谓词函数指针，返回非零的元素被移除
+ * @return error_code_t 错误码
+ */
+error_code_t ulist_remove_if(ulist_t* list, predicate_fn_t predicate);
+
+/**
+ * @brief 获取指定索引的元素
+ *
+ * @param list 展开链表容器指针
+ * @param index 元素索引
+ * @param element 输出参数，存储元素指针
+ * @return error_code_t 错误码
+ */
+error_code_t ulist_at(const ulist_t* list, size_t index, void** element);
+
+/**
+ * @brief 设置指定索引的元素，旧元素先交给析构函数
+ *
+ * @param list 展开链表容器指针
+ * @param index 元素索引
+ * @param element 要设置的元素指针
+ * @return error_code_t 错误码
+ */
+error_code_t ulist_set(ulist_t* list, size_t index, const void* element);
+
+/**
+ * @brief 启用线程安全
+ *
+ * @param list 展开链表容器指针
+ * @return error_code_t 错误码
+ */
+error_code_t ulist_enable_thread_safety(ulist_t* list);
+
+/**
+ * @brief 禁用线程安全
+ *
+ * @param list 展开链表容器指针
+ * @return error_code_t 错误码
+ */
+error_code_t ulist_disable_thread_safety(ulist_t* list);
+
+/**
+ * @brief 创建展开链表容器迭代器
+ *
+ * 迭代器的current是元素指针，可以用于algo_*中的各种算法（包括排序等交换元素的算法）。
+ *
+ * @param list 展开链表容器指针
+ * @param direction 迭代方向
+ * @return iterator_t* 迭代器指针，失败返回NULL
+ */
+iterator_t* ulist_iterator_create(ulist_t* list, iter_direction_t direction);
+
+/**
+ * @brief 获取展开链表容器起始迭代器
+ *
+ * @param list 展开链表容器指针
+ * @return iterator_t* 起始迭代器指针，失败返回NULL
+ */
+iterator_t* ulist_begin(ulist_t* list);
+
+/**
+ * @brief 获取展开链表容器结束迭代器
+ *
+ * 结束迭代器执行prev后指向尾元素。
+ *
+ * @param list 展开链表容器指针
+ * @return iterator_t* 结束迭代器指针，失败返回NULL
+ */
+iterator_t* ulist_end(ulist_t* list);
+
+/**
+ * @brief 通过展开链表迭代器获取其后第offset个元素
+ *
+ * 逐节点跳过，O(offset / node_capacity)。算法模块通过该函数加速展开链表上的按位置访问。
+ *
+ * @param iterator 迭代器指针
+ * @param offset 相对迭代器的偏移
+ * @param element 输出参数，存储元素指针
+ * @return int 如果iterator是展开链表迭代器且目标元素存在返回非零，否则返回零
+ */
+int ulist_iterator_at(const iterator_t* iterator, size_t offset, void** element);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CSTL_ULIST_H */
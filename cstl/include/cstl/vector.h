@@ -200,6 +200,31 @@ error_code_t vector_insert(vector_t* vector, size_t index, const void* element);
  */
 error_code_t vector_erase(vector_t* vector, size_t index);
 
+/**
+ * @brief 移除所有满足谓词的元素
+ * 
+ * 单次遍历原地压缩：被移除的元素调用析构函数，保留的元素按连续段整体移动，
+ * 保持原有相对顺序，时间复杂度O(n)。
+ * 
+ * @param vector 向量容器指针
+ * @param predicate 谓词函数指针，返回非零的元素被移除
+ * @return error_code_t 错误码
+ */
+error_code_t vector_remove_if(vector_t* vector, predicate_fn_t predicate);
+
+/**
+ * @brief 移除所有等于给定值的元素
+ * 
+ * 与vector_remove_if相同的单次遍历压缩。value可以指向向量中的元素，
+ * 遍历前先按字节复制一份，该元素的析构推迟到遍历结束后。
+ * 
+ * @param vector 向量容器指针
+ * @param value 要移除的值指针
+ * @param compare 比较函数指针，为NULL时按位比较
+ * @return error_code_t 错误码
+ */
+error_code_t vector_remove(vector_t* vector, const void* value, comparator_fn_t compare);
+
 /**
  * @brief 获取指定位置元素
  * 
@@ -307,6 +332,19 @@ iterator_t* vector_begin(vector_t* vector);
  */
 iterator_t* vector_end(vector_t* vector);
 
+/**
+ * @brief 获取两个向量迭代器之间的连续内存区间
+ *
+ * 算法模块通过该函数识别连续存储的范围，从而使用指针运算的快速路径。
+ *
+ * @param begin 起始迭代器
+ * @param end 结束迭代器，为NULL时表示到向量末尾
+ * @param data 输出参数，存储区间首元素指针
+ * @param count 输出参数，存储区间元素数量
+ * @return int 如果begin和end是同一向量的迭代器返回非零，否则返回零
+ */
+int vector_iterator_span(const iterator_t* begin, const iterator_t* end, void** data, size_t* count);
+
 #ifdef __cplusplus
 }
 #endif
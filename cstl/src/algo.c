@@ -7,6 +7,11 @@
  */
 
 #include "cstl/algo.h"
+#include "cstl/vector.h"
+#include "cstl/list.h"
+#include "cstl/ulist.h"
+#include "cstl/thread_pool.h"
+#include "cstl/simd.h"
 #include <stdlib.h>
 #include <string.h>
 #include <assert.h>
@@ -15,6 +20,20 @@
 /* 前向声明 */
 static error_code_t insert_sort_impl(iterator_t* begin, iterator_t* end, 
                                     compare_fn_t compare, size_t element_size);
+static void span_swap(void* a, void* b, size_t size);
+static void span_shuffle(char* base, size_t count, size_t element_size, rng_t* rng);
+static error_code_t indirect_sort_impl(iterator_t* begin, iterator_t* end, compare_fn_t compare);
+static void span_insertion_sort(char* base, size_t count, size_t element_size, compare_fn_t compare);
+
+/**
+ * @brief 元素大于该字节数时algo_sort改用间接排序
+ */
+#define ALGO_INDIRECT_SORT_THRESHOLD 128
+
+/**
+ * @brief 快速排序、归并排序和堆排序在不超过该数量的范围上改用插入排序
+ */
+#define ALGO_SORT_BASE_CASE 16
 
 /**
  * @brief 临时缓冲区结构体
@@ -67,12 +86,27 @@ static void temp_buffer_destroy(temp_buffer_t* buffer)
 /**
  * @brief 获取指定索引的元素
  * 
+ * 向量迭代器直接计算地址；链表迭代器通过链表的游标定位，就近的连续访问为O(1)；
+ * 展开链表迭代器逐节点跳过。
+ * 
  * @param begin 起始迭代器
  * @param index 元素索引
  * @return void* 元素指针
  */
 static void* get_element_at_index(iterator_t* begin, size_t index)
 {
+    void* data = NULL;
+    size_t count = 0;
+    if (vector_iterator_span(begin, NULL, &data, &count) && index < count) {
+        return (char*)data + index * begin->element_size;
+    }
+    if (list_iterator_at(begin, index, &data)) {
+        return data;
+    }
+    if (ulist_iterator_at(begin, index, &data)) {
+        return data;
+    }
+    
     iterator_t* iter = iterator_clone(begin);
     for (size_t i = 0; i < index; i++) {
         iterator_next(iter);
@@ -290,7 +324,7 @@ static error_code_t quick_sort_impl(iterator_t* begin, iterator_t* end,
     iterator_destroy(temp);
     
     /* 小数组使用插入排序优化 */
-    if (size <= 16) {
+    if (size <= ALGO_SORT_BASE_CASE) {
         return insert_sort_impl(begin, end, compare, element_size);
     }
     
@@ -492,6 +526,11 @@ static error_code_t merge_sort_impl(iterator_t* begin, iterator_t* end,
         return CSTL_OK;
     }
     
+    /* 小范围使用插入排序，它同样是稳定的 */
+    if (size <= ALGO_SORT_BASE_CASE) {
+        return insert_sort_impl(begin, end, compare, element_size);
+    }
+    
     /* 找到中间位置 */
     size_t mid_size = size / 2;
     iterator_t* mid = iterator_clone(begin);
@@ -554,6 +593,9 @@ static error_code_t heap_sort_impl(iterator_t* begin, iterator_t* end,
     if (size <= 1) {
         return CSTL_OK;
     }
+    if (size <= ALGO_SORT_BASE_CASE) {
+        return insert_sort_impl(begin, end, compare, element_size);
+    }
     
     /* 创建数组缓存所有元素的指针，避免重复迭代 */
     void** element_ptrs = malloc(size * sizeof(void*));
@@ -666,6 +708,14 @@ static error_code_t insert_sort_impl(iterator_t* begin, iterator_t* end,
         return CSTL_ERROR_NULL_POINTER;
     }
     
+    /* 连续存储时直接在数组上排序，不为每个元素分配临时空间 */
+    void* span = NULL;
+    size_t span_count = 0;
+    if (vector_iterator_span(begin, end, &span, &span_count)) {
+        span_insertion_sort((char*)span, span_count, element_size, compare);
+        return CSTL_OK;
+    }
+    
     /* 计算范围大小 */
     size_t size = 0;
     iterator_t* temp = iterator_clone(begin);
@@ -726,7 +776,14 @@ static error_code_t insert_sort_impl(iterator_t* begin, iterator_t* end,
             iterator_get(j, &j_element);
             
             if (compare(j_element, key) > 0) {
-                /* 将key放到第一个位置 */
+                /* 第一个元素后移一位，再将key放到第一个位置 */
+                iterator_t* j_next = iterator_clone(j);
+                iterator_next(j_next);
+                void* j_next_element = NULL;
+                iterator_get(j_next, &j_next_element);
+                memcpy(j_next_element, j_element, element_size);
+                iterator_destroy(j_next);
+
                 void* first_element = NULL;
                 iterator_get(begin, &first_element);
                 memcpy(first_element, key, element_size);
@@ -775,6 +832,13 @@ error_code_t algo_sort(iterator_t* begin, iterator_t* end, compare_fn_t compare,
     
     size_t element_size = begin->element_size;
     
+    /* 大元素排序指针后按环重排，失败时退回直接排序 */
+    if (element_size > ALGO_INDIRECT_SORT_THRESHOLD && algorithm >= SORT_QUICK && algorithm <= SORT_INSERT) {
+        if (indirect_sort_impl(begin, end, compare) == CSTL_OK) {
+            return CSTL_OK;
+        }
+    }
+    
     switch (algorithm) {
         case SORT_QUICK:
             return quick_sort_impl(begin, end, compare, element_size);
@@ -864,31 +928,59 @@ error_code_t algo_is_sorted(iterator_t* begin, iterator_t* end, compare_fn_t com
     return CSTL_OK;
 }
 
+/**
+ * @brief 判断两个元素是否相等
+ *
+ * compare为NULL时按位比较。
+ *
+ * @param a 第一个元素指针
+ * @param b 第二个元素指针
+ * @param compare 比较函数指针，可以为NULL
+ * @param element_size 元素大小
+ * @return int 相等返回非零
+ */
+static inline int elements_equal(const void* a, const void* b, compare_fn_t compare, size_t element_size)
+{
+    return compare != NULL ? compare(a, b) == 0 : memcmp(a, b, element_size) == 0;
+}
+
 /**
  * @brief 查找第一个等于给定值的元素
  * 
  * @param begin 起始迭代器
  * @param end 结束迭代器
  * @param value 要查找的值指针
- * @param compare 比较函数指针
+ * @param compare 比较函数指针，为NULL时按位比较，向量上1/2/4/8字节的元素使用SIMD扫描
  * @param result 输出参数，存储找到的元素指针
  * @return error_code_t 错误码
  */
 error_code_t algo_find(iterator_t* begin, iterator_t* end, const void* value, compare_fn_t compare, void** result)
 {
-    if (begin == NULL || end == NULL || value == NULL || compare == NULL || result == NULL) {
+    if (begin == NULL || end == NULL || value == NULL || result == NULL) {
         return CSTL_ERROR_NULL_POINTER;
     }
     
     *result = NULL;
     
+    /* 按位比较的连续范围使用SIMD扫描 */
+    void* data = NULL;
+    size_t count = 0;
+    if (compare == NULL && vector_iterator_span(begin, end, &data, &count)) {
+        size_t index = simd_find(data, count, begin->element_size, value);
+        if (index == count) {
+            return CSTL_ERROR_NOT_FOUND;
+        }
+        *result = (char*)data + index * begin->element_size;
+        return CSTL_OK;
+    }
+    
     iterator_t* iter = iterator_clone(begin);
     
     while (iterator_valid(iter) && !iterator_equal(iter, end)) {
         void* element = NULL;
         iterator_get(iter, &element);
         
-        if (compare(element, value) == 0) {
+        if (elements_equal(element, value, compare, begin->element_size)) {
             *result = element;
             iterator_destroy(iter);
             return CSTL_OK;
@@ -979,25 +1071,33 @@ error_code_t algo_find_if_not(iterator_t* begin, iterator_t* end, predicate_fn_t
  * @param begin 起始迭代器
  * @param end 结束迭代器
  * @param value 要查找的值指针
- * @param compare 比较函数指针
+ * @param compare 比较函数指针，为NULL时按位比较，向量上1/2/4/8字节的元素使用SIMD扫描
  * @param count 输出参数，存储元素数量
  * @return error_code_t 错误码
  */
 error_code_t algo_count(iterator_t* begin, iterator_t* end, const void* value, compare_fn_t compare, size_t* count)
 {
-    if (begin == NULL || end == NULL || value == NULL || compare == NULL || count == NULL) {
+    if (begin == NULL || end == NULL || value == NULL || count == NULL) {
         return CSTL_ERROR_NULL_POINTER;
     }
     
     *count = 0;
     
+    /* 按位比较的连续范围使用SIMD计数 */
+    void* data = NULL;
+    size_t size = 0;
+    if (compare == NULL && vector_iterator_span(begin, end, &data, &size)) {
+        *count = simd_count(data, size, begin->element_size, value);
+        return CSTL_OK;
+    }
+    
     iterator_t* iter = iterator_clone(begin);
     
     while (iterator_valid(iter) && !iterator_equal(iter, end)) {
         void* element = NULL;
         iterator_get(iter, &element);
         
-        if (compare(element, value) == 0) {
+        if (elements_equal(element, value, compare, begin->element_size)) {
             (*count)++;
         }
         
@@ -1184,18 +1284,30 @@ error_code_t algo_for_each(iterator_t* begin, iterator_t* end, unary_op_fn_t op)
  * 
  * @param begin 起始迭代器
  * @param end 结束迭代器
- * @param compare 比较函数指针
+ * @param compare 比较函数指针，为NULL时按位比较，向量上1/2/4/8字节的元素使用SIMD扫描
  * @param result 输出参数，存储找到的第一个元素指针
  * @return error_code_t 错误码
  */
 error_code_t algo_adjacent_find(iterator_t* begin, iterator_t* end, compare_fn_t compare, void** result)
 {
-    if (begin == NULL || end == NULL || compare == NULL || result == NULL) {
+    if (begin == NULL || end == NULL || result == NULL) {
         return CSTL_ERROR_NULL_POINTER;
     }
     
     *result = NULL;
     
+    /* 按位比较的连续范围使用SIMD扫描 */
+    void* data = NULL;
+    size_t count = 0;
+    if (compare == NULL && vector_iterator_span(begin, end, &data, &count)) {
+        size_t index = simd_adjacent_find(data, count, begin->element_size);
+        if (index == count) {
+            return CSTL_ERROR_NOT_FOUND;
+        }
+        *result = (char*)data + index * begin->element_size;
+        return CSTL_OK;
+    }
+    
     iterator_t* prev = iterator_clone(begin);
     iterator_t* current = iterator_clone(begin);
     iterator_next(current);
@@ -1207,7 +1319,7 @@ error_code_t algo_adjacent_find(iterator_t* begin, iterator_t* end, compare_fn_t
         iterator_get(prev, &prev_element);
         iterator_get(current, &current_element);
         
-        if (compare(prev_element, current_element) == 0) {
+        if (elements_equal(prev_element, current_element, compare, begin->element_size)) {
             *result = prev_element;
             iterator_destroy(prev);
             iterator_destroy(current);
@@ -1339,19 +1451,31 @@ error_code_t algo_find_first_not_of(iterator_t* begin1, iterator_t* end1,
  * @param begin1 第一个范围的起始迭代器
  * @param end1 第一个范围的结束迭代器
  * @param begin2 第二个范围的起始迭代器
- * @param compare 比较函数指针
+ * @param compare 比较函数指针，为NULL时按位比较，两个范围都在向量中时使用SIMD比较
  * @param equal 输出参数，存储是否相等
  * @return error_code_t 错误码
  */
 error_code_t algo_equal(iterator_t* begin1, iterator_t* end1, 
                        iterator_t* begin2, compare_fn_t compare, int* equal)
 {
-    if (begin1 == NULL || end1 == NULL || begin2 == NULL || compare == NULL || equal == NULL) {
+    if (begin1 == NULL || end1 == NULL || begin2 == NULL || equal == NULL) {
         return CSTL_ERROR_NULL_POINTER;
     }
     
     *equal = 1;
     
+    /* 按位比较的连续范围：第二个范围到向量末尾的长度必须相同 */
+    void* data1 = NULL;
+    void* data2 = NULL;
+    size_t count1 = 0;
+    size_t count2 = 0;
+    if (compare == NULL && begin1->element_size == begin2->element_size &&
+        vector_iterator_span(begin1, end1, &data1, &count1) &&
+        vector_iterator_span(begin2, NULL, &data2, &count2)) {
+        *equal = count1 == count2 && simd_mismatch(data1, data2, count1, begin1->element_size) == count1;
+        return CSTL_OK;
+    }
+    
     iterator_t* iter1 = iterator_clone(begin1);
     iterator_t* iter2 = iterator_clone(begin2);
     
@@ -1367,7 +1491,7 @@ error_code_t algo_equal(iterator_t* begin1, iterator_t* end1,
         iterator_get(iter1, &element1);
         iterator_get(iter2, &element2);
         
-        if (compare(element1, element2) != 0) {
+        if (!elements_equal(element1, element2, compare, begin1->element_size)) {
             *equal = 0;
             break;
         }
@@ -1539,25 +1663,60 @@ error_code_t algo_ends_with(iterator_t* begin1, iterator_t* end1,
 }
 
 /**
- * @brief 查找第一个子范围
- * 
+ * @brief 判断从iter开始的元素是否与子范围逐个相等
+ *
+ * @param iter 第一个范围中的候选起点
+ * @param begin2 子范围的起始迭代器
+ * @param end2 子范围的结束迭代器
+ * @param compare 比较函数指针，可以为NULL
+ * @return int 匹配返回非零
+ */
+static int range_matches(iterator_t* iter, iterator_t* begin2, iterator_t* end2, compare_fn_t compare)
+{
+    iterator_t* sub_iter = iterator_clone(begin2);
+    iterator_t* match_iter = iterator_clone(iter);
+    int match = 1;
+    
+    while (iterator_valid(sub_iter) && !iterator_equal(sub_iter, end2)) {
+        void* element1 = NULL;
+        void* element2 = NULL;
+        
+        iterator_get(match_iter, &element1);
+        iterator_get(sub_iter, &element2);
+        
+        if (!elements_equal(element1, element2, compare, begin2->element_size)) {
+            match = 0;
+            break;
+        }
+        
+        iterator_next(match_iter);
+        iterator_next(sub_iter);
+    }
+    
+    iterator_destroy(sub_iter);
+    iterator_destroy(match_iter);
+    return match;
+}
+
+/**
+ * @brief 在第一个范围中查找子范围的第一次或最后一次出现
+ *
+ * 两个范围都是向量且按位比较时使用simd_search/simd_search_last，
+ * 否则逐个候选起点比较，剩余元素数量只在开始时计算一次。
+ *
  * @param begin1 第一个范围的起始迭代器
  * @param end1 第一个范围的结束迭代器
  * @param begin2 子范围的起始迭代器
  * @param end2 子范围的结束迭代器
- * @param compare 比较函数指针
+ * @param compare 比较函数指针，可以为NULL
+ * @param find_last 非零时查找最后一次出现
  * @param result 输出参数，存储找到的子范围起始位置
  * @return error_code_t 错误码
  */
-error_code_t algo_search(iterator_t* begin1, iterator_t* end1, 
-                        iterator_t* begin2, iterator_t* end2, 
-                        compare_fn_t compare, void** result)
+static error_code_t range_search(iterator_t* begin1, iterator_t* end1,
+                                 iterator_t* begin2, iterator_t* end2,
+                                 compare_fn_t compare, int find_last, void** result)
 {
-    if (begin1 == NULL || end1 == NULL || begin2 == NULL || end2 == NULL || 
-        compare == NULL || result == NULL) {
-        return CSTL_ERROR_NULL_POINTER;
-    }
-    
     *result = NULL;
     
     /* 检查子范围是否为空 */
@@ -1568,8 +1727,25 @@ error_code_t algo_search(iterator_t* begin1, iterator_t* end1,
     }
     iterator_destroy(temp);
     
-    /* 计算子范围大小 */
+    /* 按位比较的连续范围使用子序列搜索内核 */
+    void* data = NULL;
+    void* needle = NULL;
+    size_t count = 0;
     size_t sub_size = 0;
+    if (compare == NULL && begin1->element_size == begin2->element_size &&
+        vector_iterator_span(begin1, end1, &data, &count) &&
+        vector_iterator_span(begin2, end2, &needle, &sub_size)) {
+        size_t index = find_last ? simd_search_last(data, count, needle, sub_size, begin1->element_size)
+                                 : simd_search(data, count, needle, sub_size, begin1->element_size);
+        if (index == count) {
+            return CSTL_ERROR_NOT_FOUND;
+        }
+        *result = (char*)data + index * begin1->element_size;
+        return CSTL_OK;
+    }
+    
+    /* 计算两个范围的大小 */
+    sub_size = 0;
     temp = iterator_clone(begin2);
     while (iterator_valid(temp) && !iterator_equal(temp, end2)) {
         sub_size++;
@@ -1577,60 +1753,53 @@ error_code_t algo_search(iterator_t* begin1, iterator_t* end1,
     }
     iterator_destroy(temp);
     
-    /* 在第一个范围中搜索子范围 */
+    size_t remaining = 0;
+    temp = iterator_clone(begin1);
+    while (iterator_valid(temp) && !iterator_equal(temp, end1)) {
+        remaining++;
+        iterator_next(temp);
+    }
+    iterator_destroy(temp);
+    
+    /* 逐个候选起点比较，剩余元素不足子范围大小时停止 */
     iterator_t* iter1 = iterator_clone(begin1);
     
-    while (iterator_valid(iter1) && !iterator_equal(iter1, end1)) {
-        /* 检查是否有足够的剩余元素 */
-        size_t remaining = 0;
-        iterator_t* temp = iterator_clone(iter1);
-        while (iterator_valid(temp) && !iterator_equal(temp, end1)) {
-            remaining++;
-            iterator_next(temp);
-        }
-        iterator_destroy(temp);
-        
-        if (remaining < sub_size) {
-            break;
-        }
-        
-        /* 检查是否匹配子范围 */
-        iterator_t* sub_iter = iterator_clone(begin2);
-        iterator_t* match_iter = iterator_clone(iter1);
-        int match = 1;
-        
-        while (iterator_valid(sub_iter) && !iterator_equal(sub_iter, end2)) {
-            void* element1 = NULL;
-            void* element2 = NULL;
-            
-            iterator_get(match_iter, &element1);
-            iterator_get(sub_iter, &element2);
-            
-            if (compare(element1, element2) != 0) {
-                match = 0;
+    while (remaining >= sub_size) {
+        if (range_matches(iter1, begin2, end2, compare)) {
+            iterator_get(iter1, result);
+            if (!find_last) {
                 break;
             }
-            
-            iterator_next(match_iter);
-            iterator_next(sub_iter);
-        }
-        
-        iterator_destroy(sub_iter);
-        iterator_destroy(match_iter);
-        
-        if (match) {
-            void* element = NULL;
-            iterator_get(iter1, &element);
-            *result = element;
-            iterator_destroy(iter1);
-            return CSTL_OK;
         }
         
         iterator_next(iter1);
+        remaining--;
     }
     
     iterator_destroy(iter1);
-    return CSTL_ERROR_NOT_FOUND;
+    return *result != NULL ? CSTL_OK : CSTL_ERROR_NOT_FOUND;
+}
+
+/**
+ * @brief 查找第一个子范围
+ * 
+ * @param begin1 第一个范围的起始迭代器
+ * @param end1 第一个范围的结束迭代器
+ * @param begin2 子范围的起始迭代器
+ * @param end2 子范围的结束迭代器
+ * @param compare 比较函数指针，为NULL时按位比较，两个范围都是向量时使用首尾元素过滤或Horspool搜索
+ * @param result 输出参数，存储找到的子范围起始位置
+ * @return error_code_t 错误码
+ */
+error_code_t algo_search(iterator_t* begin1, iterator_t* end1, 
+                        iterator_t* begin2, iterator_t* end2, 
+                        compare_fn_t compare, void** result)
+{
+    if (begin1 == NULL || end1 == NULL || begin2 == NULL || end2 == NULL || result == NULL) {
+        return CSTL_ERROR_NULL_POINTER;
+    }
+    
+    return range_search(begin1, end1, begin2, end2, compare, 0, result);
 }
 
 /**
@@ -1640,7 +1809,7 @@ error_code_t algo_search(iterator_t* begin1, iterator_t* end1,
  * @param end1 第一个范围的结束迭代器
  * @param begin2 子范围的起始迭代器
  * @param end2 子范围的结束迭代器
- * @param compare 比较函数指针
+ * @param compare 比较函数指针，为NULL时按位比较，两个范围都是向量时从末尾向前搜索
  * @param result 输出参数，存储找到的子范围起始位置
  * @return error_code_t 错误码
  */
@@ -1648,90 +1817,11 @@ error_code_t algo_find_end(iterator_t* begin1, iterator_t* end1,
                            iterator_t* begin2, iterator_t* end2, 
                            compare_fn_t compare, void** result)
 {
-    if (begin1 == NULL || end1 == NULL || begin2 == NULL || end2 == NULL || 
-        compare == NULL || result == NULL) {
+    if (begin1 == NULL || end1 == NULL || begin2 == NULL || end2 == NULL || result == NULL) {
         return CSTL_ERROR_NULL_POINTER;
     }
     
-    *result = NULL;
-    
-    /* 检查子范围是否为空 */
-    iterator_t* temp = iterator_clone(begin2);
-    if (!iterator_valid(temp) || iterator_equal(temp, end2)) {
-        iterator_destroy(temp);
-        return CSTL_ERROR_INVALID_ARGUMENT;
-    }
-    iterator_destroy(temp);
-    
-    /* 计算子范围大小 */
-    size_t sub_size = 0;
-    temp = iterator_clone(begin2);
-    while (iterator_valid(temp) && !iterator_equal(temp, end2)) {
-        sub_size++;
-        iterator_next(temp);
-    }
-    iterator_destroy(temp);
-    
-    /* 在第一个范围中反向搜索子范围 */
-    void* last_match = NULL;
-    
-    iterator_t* iter1 = iterator_clone(begin1);
-    
-    while (iterator_valid(iter1) && !iterator_equal(iter1, end1)) {
-        /* 检查是否有足够的剩余元素 */
-        size_t remaining = 0;
-        iterator_t* temp = iterator_clone(iter1);
-        while (iterator_valid(temp) && !iterator_equal(temp, end1)) {
-            remaining++;
-            iterator_next(temp);
-        }
-        iterator_destroy(temp);
-        
-        if (remaining < sub_size) {
-            break;
-        }
-        
-        /* 检查是否匹配子范围 */
-        iterator_t* sub_iter = iterator_clone(begin2);
-        iterator_t* match_iter = iterator_clone(iter1);
-        int match = 1;
-        
-        while (iterator_valid(sub_iter) && !iterator_equal(sub_iter, end2)) {
-            void* element1 = NULL;
-            void* element2 = NULL;
-            
-            iterator_get(match_iter, &element1);
-            iterator_get(sub_iter, &element2);
-            
-            if (compare(element1, element2) != 0) {
-                match = 0;
-                break;
-            }
-            
-            iterator_next(match_iter);
-            iterator_next(sub_iter);
-        }
-        
-        iterator_destroy(sub_iter);
-        iterator_destroy(match_iter);
-        
-        if (match) {
-            void* element = NULL;
-            iterator_get(iter1, &element);
-            last_match = element;
-        }
-        
-        iterator_next(iter1);
-    }
-    
-    iterator_destroy(iter1);
-    
-    if (last_match != NULL) {
-        *result = last_match;
-        return CSTL_OK;
-    }
-    
-    return CSTL_ERROR_NOT_FOUND;
+    return range_search(begin1, end1, begin2, end2, compare, 1, result);
 }
 
 /**
@@ -2491,39 +2581,45 @@ error_code_t algo_rotate(iterator_t* begin, iterator_t* middle, iterator_t* end)
 }
 
 /**
- * @brief 随机数生成器
+ * @brief 随机打乱范围
  * 
- * @return unsigned int 随机数
+ * @param begin 起始迭代器
+ * @param end 结束迭代器
+ * @return error_code_t 错误码
  */
-static unsigned int random_number(void)
+error_code_t algo_shuffle(iterator_t* begin, iterator_t* end)
 {
-    static unsigned int seed = 0;
-    
-    if (seed == 0) {
-        seed = (unsigned int)time(NULL);
-    }
-    
-    /* 线性同余生成器 */
-    seed = (seed * 1103515245 + 12345) & 0x7fffffff;
-    
-    return seed;
+    return algo_shuffle_rng(begin, end, NULL);
 }
 
 /**
- * @brief 随机打乱范围
+ * @brief 使用指定的生成器随机打乱范围
  * 
  * @param begin 起始迭代器
  * @param end 结束迭代器
+ * @param rng 生成器状态，为NULL时使用当前线程的生成器
  * @return error_code_t 错误码
  */
-error_code_t algo_shuffle(iterator_t* begin, iterator_t* end)
+error_code_t algo_shuffle_rng(iterator_t* begin, iterator_t* end, rng_t* rng)
 {
     if (begin == NULL || end == NULL) {
         return CSTL_ERROR_NULL_POINTER;
     }
     
-    /* 计算范围大小 */
+    if (rng == NULL) {
+        rng = rng_thread_local();
+    }
+    
+    void* data = NULL;
     size_t size = 0;
+    
+    /* 连续存储直接在内存上洗牌 */
+    if (vector_iterator_span(begin, end, &data, &size)) {
+        span_shuffle((char*)data, size, begin->element_size, rng);
+        return CSTL_OK;
+    }
+    
+    /* 计算范围大小 */
     iterator_t* temp = iterator_clone(begin);
     
     while (iterator_valid(temp) && !iterator_equal(temp, end)) {
@@ -2537,36 +2633,28 @@ error_code_t algo_shuffle(iterator_t* begin, iterator_t* end)
         return CSTL_OK;
     }
     
+    /* 收集元素指针，避免每次交换都从头遍历 */
+    void** elements = (void**)malloc(size * sizeof(void*));
+    if (elements == NULL) {
+        return CSTL_ERROR_OUT_OF_MEMORY;
+    }
+    
+    temp = iterator_clone(begin);
+    for (size_t i = 0; i < size; i++) {
+        iterator_get(temp, &elements[i]);
+        iterator_next(temp);
+    }
+    iterator_destroy(temp);
+    
     /* Fisher-Yates 洗牌算法 */
     for (size_t i = size - 1; i > 0; i--) {
-        /* 生成随机索引 */
-        size_t j = random_number() % (i + 1);
-        
-        /* 获取第i个元素 */
-        iterator_t* iter_i = iterator_clone(begin);
-        for (size_t k = 0; k < i; k++) {
-            iterator_next(iter_i);
+        size_t j = (size_t)rng_bounded(rng, (uint64_t)i + 1);
+        if (j != i) {
+            span_swap(elements[i], elements[j], begin->element_size);
         }
-        
-        /* 获取第j个元素 */
-        iterator_t* iter_j = iterator_clone(begin);
-        for (size_t k = 0; k < j; k++) {
-            iterator_next(iter_j);
-        }
-        
-        /* 交换元素 */
-        void* element_i = NULL;
-        void* element_j = NULL;
-        
-        iterator_get(iter_i, &element_i);
-        iterator_get(iter_j, &element_j);
-        
-        algo_swap(element_i, element_j, begin->element_size);
-        
-        iterator_destroy(iter_i);
-        iterator_destroy(iter_j);
     }
     
+    free(elements);
     return CSTL_OK;
 }
 
@@ -3250,3 +3338,3780 @@ error_code_t algo_prev_permutation(iterator_t* begin, iterator_t* end,
     
     return CSTL_OK;
 }
+
+/**
+ * @brief 计算两个迭代器之间的元素数量
+ * 
+ * @param begin 起始迭代器
+ * @param end 结束迭代器
+ * @return size_t 元素数量
+ */
+static size_t range_distance(iterator_t* begin, iterator_t* end)
+{
+    size_t count = 0;
+    iterator_t* iter = iterator_clone(begin);
+    
+    while (iterator_valid(iter) && !iterator_equal(iter, end)) {
+        count++;
+        iterator_next(iter);
+    }
+    
+    iterator_destroy(iter);
+    return count;
+}
+
+/**
+ * @brief 连续内存上的无分支二分查找
+ * 
+ * 每轮只根据比较结果选择下一段的基址，循环次数仅取决于元素数量，
+ * 编译器可以将选择编译为条件传送；同时预取下一轮可能访问的两个中点。
+ * 
+ * @param data 首元素指针
+ * @param count 元素数量
+ * @param element_size 元素大小
+ * @param value 要查找的值指针
+ * @param compare 比较函数指针
+ * @param upper 为非零时查找upper_bound，否则查找lower_bound
+ * @return size_t 查找到的位置
+ */
+static size_t bound_contiguous(const char* data, size_t count, size_t element_size,
+                               const void* value, compare_fn_t compare, int upper)
+{
+    if (count == 0) {
+        return 0;
+    }
+    
+    const char* base = data;
+    size_t n = count;
+    
+    while (n > 1) {
+        size_t half = n / 2;
+        CSTL_PREFETCH(base + (half / 2) * element_size);
+        CSTL_PREFETCH(base + (half + half / 2) * element_size);
+        
+        int cmp = compare(base + half * element_size, value);
+        base = (upper ? cmp <= 0 : cmp < 0) ? base + half * element_size : base;
+        n -= half;
+    }
+    
+    int cmp = compare(base, value);
+    return (size_t)(base - data) / element_size + (size_t)(upper ? cmp <= 0 : cmp < 0);
+}
+
+/**
+ * @brief 按迭代器步进的通用二分查找
+ * 
+ * 比较次数为O(log n)，迭代器移动次数为O(n)，适用于链表等非连续容器。
+ * 
+ * @param begin 起始迭代器
+ * @param count 元素数量
+ * @param value 要查找的值指针
+ * @param compare 比较函数指针
+ * @param upper 为非零时查找upper_bound，否则查找lower_bound
+ * @return size_t 查找到的位置
+ */
+static size_t bound_generic(iterator_t* begin, size_t count, const void* value,
+                            compare_fn_t compare, int upper)
+{
+    iterator_t* first = iterator_clone(begin);
+    size_t position = 0;
+    size_t n = count;
+    
+    while (n > 0) {
+        size_t half = n / 2;
+        iterator_t* mid = iterator_clone(first);
+        for (size_t i = 0; i < half; i++) {
+            iterator_next(mid);
+        }
+        
+        void* element = NULL;
+        iterator_get(mid, &element);
+        int cmp = compare(element, value);
+        
+        if (upper ? cmp <= 0 : cmp < 0) {
+            iterator_next(mid);
+            iterator_destroy(first);
+            first = mid;
+            position += half + 1;
+            n -= half + 1;
+        } else {
+            iterator_destroy(mid);
+            n = half;
+        }
+    }
+    
+    iterator_destroy(first);
+    return position;
+}
+
+/**
+ * @brief 查找lower_bound或upper_bound
+ * 
+ * @param begin 起始迭代器
+ * @param end 结束迭代器
+ * @param value 要查找的值指针
+ * @param compare 比较函数指针
+ * @param upper 为非零时查找upper_bound，否则查找lower_bound
+ * @return size_t 查找到的位置
+ */
+static size_t bound_impl(iterator_t* begin, iterator_t* end, const void* value,
+                         compare_fn_t compare, int upper)
+{
+    void* data = NULL;
+    size_t count = 0;
+    
+    if (vector_iterator_span(begin, end, &data, &count)) {
+        return bound_contiguous((const char*)data, count, begin->element_size, value, compare, upper);
+    }
+    
+    return bound_generic(begin, range_distance(begin, end), value, compare, upper);
+}
+
+/**
+ * @brief 在有序范围中查找第一个不小于给定值的位置
+ * 
+ * @param begin 起始迭代器
+ * @param end 结束迭代器
+ * @param value 要查找的值指针
+ * @param compare 比较函数指针
+ * @param position 输出参数，存储相对begin的位置
+ * @return error_code_t 错误码
+ */
+error_code_t algo_lower_bound(iterator_t* begin, iterator_t* end, const void* value,
+                              compare_fn_t compare, size_t* position)
+{
+    if (begin == NULL || end == NULL || value == NULL || compare == NULL || position == NULL) {
+        return CSTL_ERROR_NULL_POINTER;
+    }
+    
+    *position = bound_impl(begin, end, value, compare, 0);
+    return CSTL_OK;
+}
+
+/**
+ * @brief 在有序范围中查找第一个大于给定值的位置
+ * 
+ * @param begin 起始迭代器
+ * @param end 结束迭代器
+ * @param value 要查找的值指针
+ * @param compare 比较函数指针
+ * @param position 输出参数，存储相对begin的位置
+ * @return error_code_t 错误码
+ */
+error_code_t algo_upper_bound(iterator_t* begin, iterator_t* end, const void* value,
+                              compare_fn_t compare, size_t* position)
+{
+    if (begin == NULL || end == NULL || value == NULL || compare == NULL || position == NULL) {
+        return CSTL_ERROR_NULL_POINTER;
+    }
+    
+    *position = bound_impl(begin, end, value, compare, 1);
+    return CSTL_OK;
+}
+
+/**
+ * @brief 在有序范围中查找等于给定值的子范围
+ * 
+ * @param begin 起始迭代器
+ * @param end 结束迭代器
+ * @param value 要查找的值指针
+ * @param compare 比较函数指针
+ * @param first 输出参数，存储子范围起始位置
+ * @param last 输出参数，存储子范围结束位置
+ * @return error_code_t 错误码
+ */
+error_code_t algo_equal_range(iterator_t* begin, iterator_t* end, const void* value,
+                              compare_fn_t compare, size_t* first, size_t* last)
+{
+    if (begin == NULL || end == NULL || value == NULL || compare == NULL ||
+        first == NULL || last == NULL) {
+        return CSTL_ERROR_NULL_POINTER;
+    }
+    
+    void* data = NULL;
+    size_t count = 0;
+    
+    if (vector_iterator_span(begin, end, &data, &count)) {
+        size_t lower = bound_contiguous((const char*)data, count, begin->element_size, value, compare, 0);
+        const char* rest = (const char*)data + lower * begin->element_size;
+        *first = lower;
+        *last = lower + bound_contiguous(rest, count - lower, begin->element_size, value, compare, 1);
+        return CSTL_OK;
+    }
+    
+    count = range_distance(begin, end);
+    *first = bound_generic(begin, count, value, compare, 0);
+    *last = bound_generic(begin, count, value, compare, 1);
+    return CSTL_OK;
+}
+
+/**
+ * @brief 检查有序范围中是否存在给定值
+ * 
+ * @param begin 起始迭代器
+ * @param end 结束迭代器
+ * @param value 要查找的值指针
+ * @param compare 比较函数指针
+ * @param found 输出参数，存储是否找到
+ * @return error_code_t 错误码
+ */
+error_code_t algo_binary_search(iterator_t* begin, iterator_t* end, const void* value,
+                                compare_fn_t compare, int* found)
+{
+    if (begin == NULL || end == NULL || value == NULL || compare == NULL || found == NULL) {
+        return CSTL_ERROR_NULL_POINTER;
+    }
+    
+    void* data = NULL;
+    size_t count = 0;
+    
+    if (vector_iterator_span(begin, end, &data, &count)) {
+        size_t position = bound_contiguous((const char*)data, count, begin->element_size, value, compare, 0);
+        *found = position < count &&
+                 compare((const char*)data + position * begin->element_size, value) == 0;
+        return CSTL_OK;
+    }
+    
+    count = range_distance(begin, end);
+    size_t position = bound_generic(begin, count, value, compare, 0);
+    *found = 0;
+    if (position < count) {
+        *found = compare(get_element_at_index(begin, position), value) == 0;
+    }
+    return CSTL_OK;
+}
+
+/**
+ * @brief 按中序遍历把有序数据填入Eytzinger布局
+ * 
+ * @param layout 查找表指针
+ * @param sorted 有序数据
+ * @param next 下一个待填入的有序下标
+ * @param k 当前槽位（从1开始）
+ */
+static void eytzinger_build(algo_eytzinger_t* layout, const char* sorted, size_t* next, size_t k)
+{
+    if (k > layout->size) {
+        return;
+    }
+    
+    eytzinger_build(layout, sorted, next, 2 * k);
+    memcpy((char*)layout->data + k * layout->element_size,
+           sorted + (*next) * layout->element_size, layout->element_size);
+    layout->ranks[k] = *next;
+    (*next)++;
+    eytzinger_build(layout, sorted, next, 2 * k + 1);
+}
+
+/**
+ * @brief 统计末尾连续的1位数量
+ * 
+ * @param k 输入值
+ * @return unsigned 末尾连续1的个数
+ */
+static unsigned eytzinger_trailing_ones(size_t k)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    size_t inverted = ~k;
+    return inverted == 0 ? (unsigned)(sizeof(size_t) * 8) : (unsigned)__builtin_ctzll((unsigned long long)inverted);
+#else
+    unsigned count = 0;
+    while (k & 1) {
+        k >>= 1;
+        count++;
+    }
+    return count;
+#endif
+}
+
+/**
+ * @brief 由有序范围构建Eytzinger布局查找表
+ * 
+ * @param begin 有序范围的起始迭代器
+ * @param end 有序范围的结束迭代器
+ * @param compare 比较函数指针
+ * @return algo_eytzinger_t* 查找表指针，失败返回NULL
+ */
+algo_eytzinger_t* algo_eytzinger_create(iterator_t* begin, iterator_t* end, compare_fn_t compare)
+{
+    if (begin == NULL || end == NULL || compare == NULL || begin->element_size == 0) {
+        return NULL;
+    }
+    
+    size_t element_size = begin->element_size;
+    void* span = NULL;
+    size_t count = 0;
+    char* sorted = NULL;
+    int owns_sorted = 0;
+    
+    if (vector_iterator_span(begin, end, &span, &count)) {
+        sorted = (char*)span;
+    } else {
+        count = range_distance(begin, end);
+        sorted = (char*)malloc((count > 0 ? count : 1) * element_size);
+        if (sorted == NULL) {
+            return NULL;
+        }
+        owns_sorted = 1;
+        
+        iterator_t* iter = iterator_clone(begin);
+        for (size_t i = 0; i < count; i++) {
+            void* element = NULL;
+            iterator_get(iter, &element);
+            memcpy(sorted + i * element_size, element, element_size);
+            iterator_next(iter);
+        }
+        iterator_destroy(iter);
+    }
+    
+    algo_eytzinger_t* layout = (algo_eytzinger_t*)malloc(sizeof(algo_eytzinger_t));
+    if (layout == NULL) {
+        if (owns_sorted) {
+            free(sorted);
+        }
+        return NULL;
+    }
+    
+    /* 槽位0不使用，按64字节缓存行对齐使树的前几层落在同一缓存行 */
+    layout->raw = malloc((count + 1) * element_size + CSTL_CACHE_LINE_SIZE);
+    layout->ranks = (size_t*)malloc((count + 1) * sizeof(size_t));
+    if (layout->raw == NULL || layout->ranks == NULL) {
+        free(layout->raw);
+        free(layout->ranks);
+        free(layout);
+        if (owns_sorted) {
+            free(sorted);
+        }
+        return NULL;
+    }
+    
+    uintptr_t aligned = ((uintptr_t)layout->raw + CSTL_CACHE_LINE_SIZE - 1) &
+                        ~(uintptr_t)(CSTL_CACHE_LINE_SIZE - 1);
+    layout->data = (void*)aligned;
+    layout->size = count;
+    layout->element_size = element_size;
+    layout->compare = compare;
+    layout->ranks[0] = count;
+    
+    size_t next = 0;
+    eytzinger_build(layout, sorted, &next, 1);
+    
+    if (owns_sorted) {
+        free(sorted);
+    }
+    
+    return layout;
+}
+
+/**
+ * @brief 销毁Eytzinger布局查找表
+ * 
+ * @param layout 查找表指针
+ */
+void algo_eytzinger_destroy(algo_eytzinger_t* layout)
+{
+    if (layout == NULL) {
+        return;
+    }
+    
+    free(layout->raw);
+    free(layout->ranks);
+    free(layout);
+}
+
+/**
+ * @brief 在Eytzinger布局查找表中查找第一个不小于给定值的元素
+ * 
+ * @param layout 查找表指针
+ * @param value 要查找的值指针
+ * @param result 输出参数，存储找到的元素指针
+ * @param index 输出参数，存储元素在原有序范围中的下标，可以为NULL
+ * @return error_code_t 错误码
+ */
+error_code_t algo_eytzinger_lower_bound(const algo_eytzinger_t* layout, const void* value,
+                                        void** result, size_t* index)
+{
+    if (layout == NULL || value == NULL || result == NULL) {
+        return CSTL_ERROR_NULL_POINTER;
+    }
+    
+    const char* data = (const char*)layout->data;
+    size_t element_size = layout->element_size;
+    size_t n = layout->size;
+    /* 预取k往下第4层的子树起点，即一个缓存行所含元素数对应的层级跨度 */
+    size_t stride = CSTL_CACHE_LINE_SIZE / element_size;
+    size_t k = 1;
+    
+    if (stride == 0) {
+        stride = 1;
+    }
+    
+    while (k <= n) {
+        CSTL_PREFETCH(data + k * stride * element_size);
+        k = 2 * k + (size_t)(layout->compare(data + k * element_size, value) < 0);
+    }
+    
+    /* 去掉最后一段"向右"的路径，得到最后一次"向左"的槽位 */
+    k >>= eytzinger_trailing_ones(k) + 1;
+    
+    *result = NULL;
+    if (k == 0) {
+        if (index != NULL) {
+            *index = n;
+        }
+        return CSTL_ERROR_NOT_FOUND;
+    }
+    
+    *result = (void*)(data + k * element_size);
+    if (index != NULL) {
+        *index = layout->ranks[k];
+    }
+    return CSTL_OK;
+}
+
+/**
+ * @brief 在Eytzinger布局查找表中查找等于给定值的元素
+ * 
+ * @param layout 查找表指针
+ * @param value 要查找的值指针
+ * @param result 输出参数，存储找到的元素指针
+ * @param index 输出参数，存储元素在原有序范围中的下标，可以为NULL
+ * @return error_code_t 错误码
+ */
+error_code_t algo_eytzinger_find(const algo_eytzinger_t* layout, const void* value,
+                                 void** result, size_t* index)
+{
+    void* element = NULL;
+    size_t position = 0;
+    
+    error_code_t err = algo_eytzinger_lower_bound(layout, value, &element, &position);
+    if (err != CSTL_OK) {
+        return err;
+    }
+    
+    if (layout->compare(element, value) != 0) {
+        *result = NULL;
+        return CSTL_ERROR_NOT_FOUND;
+    }
+    
+    *result = element;
+    if (index != NULL) {
+        *index = position;
+    }
+    return CSTL_OK;
+}
+
+/**
+ * @brief 交换两块内存的内容
+ * 
+ * 与algo_swap不同，大元素按固定大小的栈缓冲区分段交换，不分配堆内存。
+ * 
+ * @param a 第一个元素指针
+ * @param b 第二个元素指针
+ * @param size 元素大小
+ */
+static void span_swap(void* a, void* b, size_t size)
+{
+    unsigned char buffer[64];
+    unsigned char* pa = (unsigned char*)a;
+    unsigned char* pb = (unsigned char*)b;
+    
+    while (size > 0) {
+        size_t chunk = size < sizeof(buffer) ? size : sizeof(buffer);
+        memcpy(buffer, pa, chunk);
+        memcpy(pa, pb, chunk);
+        memcpy(pb, buffer, chunk);
+        pa += chunk;
+        pb += chunk;
+        size -= chunk;
+    }
+}
+
+/**
+ * @brief 连续区间上的Fisher-Yates洗牌
+ * 
+ * 4字节和8字节元素按整数交换，其他大小使用span_swap。
+ * 
+ * @param base 首元素指针
+ * @param count 元素数量
+ * @param element_size 元素大小
+ * @param rng 生成器状态
+ */
+static void span_shuffle(char* base, size_t count, size_t element_size, rng_t* rng)
+{
+    if (count <= 1) {
+        return;
+    }
+    
+    if (element_size == sizeof(uint64_t)) {
+        for (size_t i = count - 1; i > 0; i--) {
+            size_t j = (size_t)rng_bounded(rng, (uint64_t)i + 1);
+            uint64_t a, b;
+            memcpy(&a, base + i * sizeof(a), sizeof(a));
+            memcpy(&b, base + j * sizeof(b), sizeof(b));
+            memcpy(base + i * sizeof(a), &b, sizeof(b));
+            memcpy(base + j * sizeof(b), &a, sizeof(a));
+        }
+    } else if (element_size == sizeof(uint32_t)) {
+        for (size_t i = count - 1; i > 0; i--) {
+            size_t j = (size_t)rng_bounded(rng, (uint64_t)i + 1);
+            uint32_t a, b;
+            memcpy(&a, base + i * sizeof(a), sizeof(a));
+            memcpy(&b, base + j * sizeof(b), sizeof(b));
+            memcpy(base + i * sizeof(a), &b, sizeof(b));
+            memcpy(base + j * sizeof(b), &a, sizeof(a));
+        }
+    } else {
+        for (size_t i = count - 1; i > 0; i--) {
+            size_t j = (size_t)rng_bounded(rng, (uint64_t)i + 1);
+            if (j != i) {
+                span_swap(base + i * element_size, base + j * element_size, element_size);
+            }
+        }
+    }
+}
+
+/**
+ * @brief 连续区间上的插入排序
+ * 
+ * @param base 首元素指针
+ * @param count 元素数量
+ * @param element_size 元素大小
+ * @param compare 比较函数指针
+ */
+static void span_insertion_sort(char* base, size_t count, size_t element_size, compare_fn_t compare)
+{
+    for (size_t i = 1; i < count; i++) {
+        for (size_t j = i; j > 0; j--) {
+            char* current = base + j * element_size;
+            char* previous = current - element_size;
+            if (compare(previous, current) <= 0) {
+                break;
+            }
+            span_swap(previous, current, element_size);
+        }
+    }
+}
+
+/**
+ * @brief 堆的下沉操作
+ * 
+ * 维护最大堆；order为-1时比较结果取反，即维护最小堆。
+ * 
+ * @param base 堆数组首元素指针
+ * @param root 下沉的起始下标
+ * @param count 堆中元素数量
+ * @param element_size 元素大小
+ * @param compare 比较函数指针
+ * @param order 1表示最大堆，-1表示最小堆
+ */
+static void span_sift_down(char* base, size_t root, size_t count, size_t element_size,
+                           compare_fn_t compare, int order)
+{
+    while (1) {
+        size_t child = 2 * root + 1;
+        if (child >= count) {
+            break;
+        }
+        
+        if (child + 1 < count &&
+            order * compare(base + child * element_size, base + (child + 1) * element_size) < 0) {
+            child++;
+        }
+        
+        if (order * compare(base + root * element_size, base + child * element_size) >= 0) {
+            break;
+        }
+        
+        span_swap(base + root * element_size, base + child * element_size, element_size);
+        root = child;
+    }
+}
+
+/**
+ * @brief 建堆
+ * 
+ * @param base 首元素指针
+ * @param count 元素数量
+ * @param element_size 元素大小
+ * @param compare 比较函数指针
+ * @param order 1表示最大堆，-1表示最小堆
+ */
+static void span_make_heap(char* base, size_t count, size_t element_size,
+                           compare_fn_t compare, int order)
+{
+    for (size_t i = count / 2; i > 0; i--) {
+        span_sift_down(base, i - 1, count, element_size, compare, order);
+    }
+}
+
+/**
+ * @brief 将堆排序为有序序列
+ * 
+ * 最大堆排序后为升序，最小堆排序后为降序。
+ * 
+ * @param base 堆数组首元素指针
+ * @param count 元素数量
+ * @param element_size 元素大小
+ * @param compare 比较函数指针
+ * @param order 1表示最大堆，-1表示最小堆
+ */
+static void span_sort_heap(char* base, size_t count, size_t element_size,
+                           compare_fn_t compare, int order)
+{
+    while (count > 1) {
+        count--;
+        span_swap(base, base + count * element_size, element_size);
+        span_sift_down(base, 0, count, element_size, compare, order);
+    }
+}
+
+/**
+ * @brief 连续区间上的部分排序（堆选择）
+ * 
+ * @param base 首元素指针
+ * @param middle 需要排好序的元素数量
+ * @param count 元素总数
+ * @param element_size 元素大小
+ * @param compare 比较函数指针
+ */
+static void span_partial_sort(char* base, size_t middle, size_t count, size_t element_size,
+                              compare_fn_t compare)
+{
+    if (middle == 0) {
+        return;
+    }
+    
+    span_make_heap(base, middle, element_size, compare, 1);
+    
+    for (size_t i = middle; i < count; i++) {
+        char* element = base + i * element_size;
+        if (compare(element, base) < 0) {
+            span_swap(element, base, element_size);
+            span_sift_down(base, 0, middle, element_size, compare, 1);
+        }
+    }
+    
+    span_sort_heap(base, middle, element_size, compare, 1);
+}
+
+/**
+ * @brief 三数取中，把中位数交换到区间首位作为基准
+ * 
+ * @param base 首元素指针
+ * @param count 元素数量
+ * @param element_size 元素大小
+ * @param compare 比较函数指针
+ */
+static void span_move_median_to_first(char* base, size_t count, size_t element_size,
+                                      compare_fn_t compare)
+{
+    char* a = base + element_size;
+    char* b = base + (count / 2) * element_size;
+    char* c = base + (count - 1) * element_size;
+    char* median;
+    
+    if (compare(a, b) < 0) {
+        if (compare(b, c) < 0) {
+            median = b;
+        } else {
+            median = compare(a, c) < 0 ? c : a;
+        }
+    } else {
+        if (compare(a, c) < 0) {
+            median = a;
+        } else {
+            median = compare(b, c) < 0 ? c : b;
+        }
+    }
+    
+    span_swap(base, median, element_size);
+}
+
+/**
+ * @brief 以首元素为基准的Hoare划分
+ * 
+ * 与基准相等的元素会被分散到两侧，重复元素较多时依然保持平衡。
+ * 
+ * @param base 首元素指针（基准）
+ * @param count 元素数量，至少为2
+ * @param element_size 元素大小
+ * @param compare 比较函数指针
+ * @return size_t 基准最终所在的下标
+ */
+static size_t span_partition(char* base, size_t count, size_t element_size, compare_fn_t compare)
+{
+    size_t i = 1;
+    size_t j = count - 1;
+    
+    while (1) {
+        while (i <= j && compare(base + i * element_size, base) < 0) {
+            i++;
+        }
+        while (j >= i && compare(base + j * element_size, base) > 0) {
+            j--;
+        }
+        if (i >= j) {
+            break;
+        }
+        span_swap(base + i * element_size, base + j * element_size, element_size);
+        i++;
+        j--;
+    }
+    
+    span_swap(base, base + j * element_size, element_size);
+    return j;
+}
+
+/**
+ * @brief 连续区间上的内省选择
+ * 
+ * @param base 首元素指针
+ * @param count 元素数量
+ * @param nth 目标下标
+ * @param element_size 元素大小
+ * @param compare 比较函数指针
+ */
+static void span_nth_element(char* base, size_t count, size_t nth, size_t element_size,
+                             compare_fn_t compare)
+{
+    size_t depth_limit = 0;
+    for (size_t n = count; n > 1; n >>= 1) {
+        depth_limit += 2;
+    }
+    
+    while (count > 16) {
+        if (depth_limit == 0) {
+            /* 划分效果太差，退化为O(n log k)的堆选择 */
+            span_partial_sort(base, nth + 1, count, element_size, compare);
+            return;
+        }
+        depth_limit--;
+        
+        span_move_median_to_first(base, count, element_size, compare);
+        size_t pivot = span_partition(base, count, element_size, compare);
+        
+        if (pivot == nth) {
+            return;
+        }
+        if (nth < pivot) {
+            count = pivot;
+        } else {
+            base += (pivot + 1) * element_size;
+            count -= pivot + 1;
+            nth -= pivot + 1;
+        }
+    }
+    
+    span_insertion_sort(base, count, element_size, compare);
+}
+
+/**
+ * @brief 将范围内的元素复制到新分配的连续缓冲区
+ * 
+ * @param begin 起始迭代器
+ * @param count 元素数量
+ * @param element_size 元素大小
+ * @return char* 缓冲区指针，失败返回NULL，需要调用者释放
+ */
+static char* range_gather(iterator_t* begin, size_t count, size_t element_size)
+{
+    char* buffer = (char*)malloc((count > 0 ? count : 1) * element_size);
+    if (buffer == NULL) {
+        return NULL;
+    }
+    
+    iterator_t* iter = iterator_clone(begin);
+    for (size_t i = 0; i < count; i++) {
+        void* element = NULL;
+        iterator_get(iter, &element);
+        memcpy(buffer + i * element_size, element, element_size);
+        iterator_next(iter);
+    }
+    iterator_destroy(iter);
+    
+    return buffer;
+}
+
+/**
+ * @brief 将连续缓冲区中的元素按顺序写回范围
+ * 
+ * @param begin 起始迭代器
+ * @param buffer 缓冲区指针
+ * @param count 元素数量
+ * @param element_size 元素大小
+ */
+static void range_scatter(iterator_t* begin, const char* buffer, size_t count, size_t element_size)
+{
+    iterator_t* iter = iterator_clone(begin);
+    for (size_t i = 0; i < count; i++) {
+        void* element = NULL;
+        if (iterator_get(iter, &element) != CSTL_OK) {
+            break;
+        }
+        memcpy(element, buffer + i * element_size, element_size);
+        iterator_next(iter);
+    }
+    iterator_destroy(iter);
+}
+
+/**
+ * @brief 重排范围使第n个位置上的元素就是完整排序后该位置的元素
+ * 
+ * @param begin 起始迭代器
+ * @param nth 目标位置迭代器
+ * @param end 结束迭代器
+ * @param compare 比较函数指针
+ * @return error_code_t 错误码
+ */
+error_code_t algo_nth_element(iterator_t* begin, iterator_t* nth, iterator_t* end,
+                              compare_fn_t compare)
+{
+    if (begin == NULL || nth == NULL || end == NULL || compare == NULL) {
+        return CSTL_ERROR_NULL_POINTER;
+    }
+    
+    size_t element_size = begin->element_size;
+    void* data = NULL;
+    size_t count = 0;
+    size_t position = 0;
+    
+    if (vector_iterator_span(begin, end, &data, &count)) {
+        void* nth_data = NULL;
+        if (!vector_iterator_span(begin, nth, &nth_data, &position) || position > count) {
+            return CSTL_ERROR_INVALID_ARGUMENT;
+        }
+        if (position < count) {
+            span_nth_element((char*)data, count, position, element_size, compare);
+        }
+        return CSTL_OK;
+    }
+    
+    count = range_distance(begin, end);
+    position = range_distance(begin, nth);
+    if (position >= count) {
+        return position == count ? CSTL_OK : CSTL_ERROR_INVALID_ARGUMENT;
+    }
+    
+    char* buffer = range_gather(begin, count, element_size);
+    if (buffer == NULL) {
+        return CSTL_ERROR_OUT_OF_MEMORY;
+    }
+    
+    span_nth_element(buffer, count, position, element_size, compare);
+    range_scatter(begin, buffer, count, element_size);
+    free(buffer);
+    
+    return CSTL_OK;
+}
+
+/**
+ * @brief 部分排序，使[begin, middle)按顺序包含整个范围中最小的若干元素
+ * 
+ * @param begin 起始迭代器
+ * @param middle 部分排序的结束位置迭代器
+ * @param end 结束迭代器
+ * @param compare 比较函数指针
+ * @return error_code_t 错误码
+ */
+error_code_t algo_partial_sort(iterator_t* begin, iterator_t* middle, iterator_t* end,
+                               compare_fn_t compare)
+{
+    if (begin == NULL || middle == NULL || end == NULL || compare == NULL) {
+        return CSTL_ERROR_NULL_POINTER;
+    }
+    
+    size_t element_size = begin->element_size;
+    void* data = NULL;
+    size_t count = 0;
+    size_t position = 0;
+    
+    if (vector_iterator_span(begin, end, &data, &count)) {
+        void* middle_data = NULL;
+        if (!vector_iterator_span(begin, middle, &middle_data, &position) || position > count) {
+            return CSTL_ERROR_INVALID_ARGUMENT;
+        }
+        span_partial_sort((char*)data, position, count, element_size, compare);
+        return CSTL_OK;
+    }
+    
+    count = range_distance(begin, end);
+    position = range_distance(begin, middle);
+    if (position > count) {
+        return CSTL_ERROR_INVALID_ARGUMENT;
+    }
+    
+    char* buffer = range_gather(begin, count, element_size);
+    if (buffer == NULL) {
+        return CSTL_ERROR_OUT_OF_MEMORY;
+    }
+    
+    span_partial_sort(buffer, position, count, element_size, compare);
+    range_scatter(begin, buffer, count, element_size);
+    free(buffer);
+    
+    return CSTL_OK;
+}
+
+/**
+ * @brief 将输入范围中最小的若干元素按顺序复制到目标范围
+ * 
+ * @param begin 输入范围起始迭代器
+ * @param end 输入范围结束迭代器
+ * @param dest_begin 目标范围起始迭代器
+ * @param dest_end 目标范围结束迭代器
+ * @param compare 比较函数指针
+ * @param count 输出参数，存储复制的元素数量，可以为NULL
+ * @return error_code_t 错误码
+ */
+error_code_t algo_partial_sort_copy(iterator_t* begin, iterator_t* end,
+                                    iterator_t* dest_begin, iterator_t* dest_end,
+                                    compare_fn_t compare, size_t* count)
+{
+    if (begin == NULL || end == NULL || dest_begin == NULL || dest_end == NULL || compare == NULL) {
+        return CSTL_ERROR_NULL_POINTER;
+    }
+    
+    size_t element_size = begin->element_size;
+    if (dest_begin->element_size != element_size) {
+        return CSTL_ERROR_INVALID_ARGUMENT;
+    }
+    
+    void* dest_data = NULL;
+    size_t capacity = 0;
+    int dest_contiguous = vector_iterator_span(dest_begin, dest_end, &dest_data, &capacity);
+    if (!dest_contiguous) {
+        capacity = range_distance(dest_begin, dest_end);
+    }
+    
+    char* heap = (char*)dest_data;
+    if (!dest_contiguous) {
+        heap = (char*)malloc((capacity > 0 ? capacity : 1) * element_size);
+        if (heap == NULL) {
+            return CSTL_ERROR_OUT_OF_MEMORY;
+        }
+    }
+    
+    /* 先填满目标区并建最大堆，之后只有比堆顶小的元素才替换堆顶 */
+    size_t filled = 0;
+    iterator_t* iter = iterator_clone(begin);
+    while (iterator_valid(iter) && !iterator_equal(iter, end)) {
+        void* element = NULL;
+        iterator_get(iter, &element);
+        
+        if (filled < capacity) {
+            memcpy(heap + filled * element_size, element, element_size);
+            filled++;
+            if (filled == capacity) {
+                span_make_heap(heap, filled, element_size, compare, 1);
+            }
+        } else if (capacity > 0 && compare(element, heap) < 0) {
+            memcpy(heap, element, element_size);
+            span_sift_down(heap, 0, filled, element_size, compare, 1);
+        }
+        
+        iterator_next(iter);
+    }
+    iterator_destroy(iter);
+    
+    if (filled < capacity) {
+        span_make_heap(heap, filled, element_size, compare, 1);
+    }
+    span_sort_heap(heap, filled, element_size, compare, 1);
+    
+    if (!dest_contiguous) {
+        range_scatter(dest_begin, heap, filled, element_size);
+        free(heap);
+    }
+    
+    if (count != NULL) {
+        *count = filled;
+    }
+    return CSTL_OK;
+}
+
+/**
+ * @brief 创建Top-K累加器
+ * 
+ * @param k 保留的元素数量
+ * @param element_size 元素大小
+ * @param compare 比较函数指针
+ * @return algo_topk_t* 累加器指针，失败返回NULL
+ */
+algo_topk_t* algo_topk_create(size_t k, size_t element_size, compare_fn_t compare)
+{
+    if (k == 0 || element_size == 0 || compare == NULL) {
+        return NULL;
+    }
+    
+    algo_topk_t* topk = (algo_topk_t*)malloc(sizeof(algo_topk_t));
+    if (topk == NULL) {
+        return NULL;
+    }
+    
+    topk->heap = malloc(k * element_size);
+    if (topk->heap == NULL) {
+        free(topk);
+        return NULL;
+    }
+    
+    topk->size = 0;
+    topk->capacity = k;
+    topk->element_size = element_size;
+    topk->compare = compare;
+    
+    return topk;
+}
+
+/**
+ * @brief 销毁Top-K累加器
+ * 
+ * @param topk 累加器指针
+ */
+void algo_topk_destroy(algo_topk_t* topk)
+{
+    if (topk == NULL) {
+        return;
+    }
+    
+    free(topk->heap);
+    free(topk);
+}
+
+/**
+ * @brief 清空Top-K累加器
+ * 
+ * @param topk 累加器指针
+ */
+void algo_topk_clear(algo_topk_t* topk)
+{
+    if (topk != NULL) {
+        topk->size = 0;
+    }
+}
+
+/**
+ * @brief 向Top-K累加器提交一个元素
+ * 
+ * @param topk 累加器指针
+ * @param element 元素指针
+ * @return error_code_t 错误码
+ */
+error_code_t algo_topk_push(algo_topk_t* topk, const void* element)
+{
+    if (topk == NULL || element == NULL) {
+        return CSTL_ERROR_NULL_POINTER;
+    }
+    
+    char* heap = (char*)topk->heap;
+    size_t element_size = topk->element_size;
+    
+    if (topk->size < topk->capacity) {
+        /* 未满时追加并上浮 */
+        size_t child = topk->size++;
+        memcpy(heap + child * element_size, element, element_size);
+        while (child > 0) {
+            size_t parent = (child - 1) / 2;
+            if (topk->compare(heap + child * element_size, heap + parent * element_size) >= 0) {
+                break;
+            }
+            span_swap(heap + child * element_size, heap + parent * element_size, element_size);
+            child = parent;
+        }
+        return CSTL_OK;
+    }
+    
+    /* 已满时只有大于门槛的元素才能替换堆顶 */
+    if (topk->compare(element, heap) > 0) {
+        memcpy(heap, element, element_size);
+        span_sift_down(heap, 0, topk->size, element_size, topk->compare, -1);
+    }
+    
+    return CSTL_OK;
+}
+
+/**
+ * @brief 向Top-K累加器批量提交范围内的元素
+ * 
+ * @param topk 累加器指针
+ * @param begin 起始迭代器
+ * @param end 结束迭代器
+ * @return error_code_t 错误码
+ */
+error_code_t algo_topk_push_range(algo_topk_t* topk, iterator_t* begin, iterator_t* end)
+{
+    if (topk == NULL || begin == NULL || end == NULL) {
+        return CSTL_ERROR_NULL_POINTER;
+    }
+    
+    void* data = NULL;
+    size_t count = 0;
+    
+    if (vector_iterator_span(begin, end, &data, &count)) {
+        for (size_t i = 0; i < count; i++) {
+            algo_topk_push(topk, (const char*)data + i * begin->element_size);
+        }
+        return CSTL_OK;
+    }
+    
+    iterator_t* iter = iterator_clone(begin);
+    while (iterator_valid(iter) && !iterator_equal(iter, end)) {
+        void* element = NULL;
+        iterator_get(iter, &element);
+        algo_topk_push(topk, element);
+        iterator_next(iter);
+    }
+    iterator_destroy(iter);
+    
+    return CSTL_OK;
+}
+
+/**
+ * @brief 获取当前保留元素中最小的一个
+ * 
+ * @param topk 累加器指针
+ * @param element 输出参数，存储门槛元素指针
+ * @return error_code_t 错误码
+ */
+error_code_t algo_topk_threshold(const algo_topk_t* topk, void** element)
+{
+    if (topk == NULL || element == NULL) {
+        return CSTL_ERROR_NULL_POINTER;
+    }
+    
+    if (topk->size == 0) {
+        *element = NULL;
+        return CSTL_ERROR_CONTAINER_EMPTY;
+    }
+    
+    *element = topk->heap;
+    return CSTL_OK;
+}
+
+/**
+ * @brief 获取Top-K累加器当前保留的元素数量
+ * 
+ * @param topk 累加器指针
+ * @return size_t 元素数量
+ */
+size_t algo_topk_size(const algo_topk_t* topk)
+{
+    return topk != NULL ? topk->size : 0;
+}
+
+/**
+ * @brief 按从大到小的顺序输出保留的元素
+ * 
+ * @param topk 累加器指针
+ * @param dest 目标迭代器
+ * @param count 输出参数，存储写入的元素数量，可以为NULL
+ * @return error_code_t 错误码
+ */
+error_code_t algo_topk_result(const algo_topk_t* topk, iterator_t* dest, size_t* count)
+{
+    if (topk == NULL || dest == NULL) {
+        return CSTL_ERROR_NULL_POINTER;
+    }
+    
+    if (dest->element_size != topk->element_size) {
+        return CSTL_ERROR_INVALID_ARGUMENT;
+    }
+    
+    size_t element_size = topk->element_size;
+    void* dest_data = NULL;
+    size_t capacity = 0;
+    
+    /* 在副本上做最小堆排序得到降序结果，累加器保持可用 */
+    if (vector_iterator_span(dest, NULL, &dest_data, &capacity)) {
+        if (capacity < topk->size) {
+            return CSTL_ERROR_INVALID_ARGUMENT;
+        }
+        memcpy(dest_data, topk->heap, topk->size * element_size);
+        span_sort_heap((char*)dest_data, topk->size, element_size, topk->compare, -1);
+    } else {
+        char* buffer = (char*)malloc((topk->size > 0 ? topk->size : 1) * element_size);
+        if (buffer == NULL) {
+            return CSTL_ERROR_OUT_OF_MEMORY;
+        }
+        memcpy(buffer, topk->heap, topk->size * element_size);
+        span_sort_heap(buffer, topk->size, element_size, topk->compare, -1);
+        range_scatter(dest, buffer, topk->size, element_size);
+        free(buffer);
+    }
+    
+    if (count != NULL) {
+        *count = topk->size;
+    }
+    return CSTL_OK;
+}
+
+/**
+ * @brief 自动选择分块大小时每个分块的最少元素数量
+ * 
+ * 分块太小时调度开销会超过并行收益。
+ */
+#define ALGO_PAR_MIN_GRAIN 1024
+
+/**
+ * @brief 并行算法的公共上下文
+ */
+typedef struct {
+    char* data;                 /**< 源数据首元素指针 */
+    char* dest;                 /**< 目标数据首元素指针 */
+    size_t element_size;        /**< 元素大小 */
+    size_t grain_size;          /**< 分块大小 */
+    unary_op_fn_t op;           /**< 一元操作 */
+    binary_op_fn_t combine;     /**< 合并操作 */
+    predicate_fn_t predicate;   /**< 谓词 */
+    void* partials;             /**< 每个分块的部分结果 */
+} par_context_t;
+
+/**
+ * @brief 计算实际使用的分块大小
+ * 
+ * @param count 元素数量
+ * @param grain_size 用户指定的分块大小，为0时自动选择
+ * @return size_t 分块大小
+ */
+static size_t par_grain_size(size_t count, size_t grain_size)
+{
+    if (grain_size > 0) {
+        return grain_size;
+    }
+    
+    /* 每个工作线程约分到8个分块，便于负载均衡 */
+    size_t workers = thread_pool_size(thread_pool_default()) + 1;
+    size_t grain = count / (workers * 8);
+    return grain < ALGO_PAR_MIN_GRAIN ? ALGO_PAR_MIN_GRAIN : grain;
+}
+
+/**
+ * @brief algo_par_for_each的分块任务
+ * 
+ * @param context 并行算法上下文
+ * @param begin 分块起始下标
+ * @param end 分块结束下标
+ */
+static void par_for_each_chunk(void* context, size_t begin, size_t end)
+{
+    par_context_t* ctx = (par_context_t*)context;
+    for (size_t i = begin; i < end; i++) {
+        ctx->op(ctx->data + i * ctx->element_size);
+    }
+}
+
+/**
+ * @brief algo_par_transform的分块任务
+ * 
+ * @param context 并行算法上下文
+ * @param begin 分块起始下标
+ * @param end 分块结束下标
+ */
+static void par_transform_chunk(void* context, size_t begin, size_t end)
+{
+    par_context_t* ctx = (par_context_t*)context;
+    size_t element_size = ctx->element_size;
+    
+    if (ctx->dest != ctx->data) {
+        memcpy(ctx->dest + begin * element_size, ctx->data + begin * element_size,
+               (end - begin) * element_size);
+    }
+    for (size_t i = begin; i < end; i++) {
+        ctx->op(ctx->dest + i * element_size);
+    }
+}
+
+/**
+ * @brief algo_par_reduce的分块任务
+ * 
+ * @param context 并行算法上下文
+ * @param begin 分块起始下标
+ * @param end 分块结束下标
+ */
+static void par_reduce_chunk(void* context, size_t begin, size_t end)
+{
+    par_context_t* ctx = (par_context_t*)context;
+    size_t element_size = ctx->element_size;
+    char* partial = (char*)ctx->partials + (begin / ctx->grain_size) * element_size;
+    
+    memcpy(partial, ctx->data + begin * element_size, element_size);
+    for (size_t i = begin + 1; i < end; i++) {
+        ctx->combine(partial, ctx->data + i * element_size);
+    }
+}
+
+/**
+ * @brief algo_par_count_if的分块任务
+ * 
+ * @param context 并行算法上下文
+ * @param begin 分块起始下标
+ * @param end 分块结束下标
+ */
+static void par_count_if_chunk(void* context, size_t begin, size_t end)
+{
+    par_context_t* ctx = (par_context_t*)context;
+    size_t matched = 0;
+    
+    for (size_t i = begin; i < end; i++) {
+        if (ctx->predicate(ctx->data + i * ctx->element_size)) {
+            matched++;
+        }
+    }
+    ((size_t*)ctx->partials)[begin / ctx->grain_size] = matched;
+}
+
+/**
+ * @brief 并行地对范围内每个元素执行操作
+ * 
+ * @param begin 起始迭代器
+ * @param end 结束迭代器
+ * @param op 一元操作函数指针
+ * @param grain_size 每个分块的元素数量，为0时自动选择
+ * @return error_code_t 错误码
+ */
+error_code_t algo_par_for_each(iterator_t* begin, iterator_t* end, unary_op_fn_t op,
+                               size_t grain_size)
+{
+    if (begin == NULL || end == NULL || op == NULL) {
+        return CSTL_ERROR_NULL_POINTER;
+    }
+    
+    void* data = NULL;
+    size_t count = 0;
+    
+    if (!vector_iterator_span(begin, end, &data, &count)) {
+        return algo_for_each(begin, end, op);
+    }
+    
+    par_context_t ctx;
+    memset(&ctx, 0, sizeof(ctx));
+    ctx.data = (char*)data;
+    ctx.element_size = begin->element_size;
+    ctx.grain_size = par_grain_size(count, grain_size);
+    ctx.op = op;
+    
+    return thread_pool_parallel_for(NULL, count, ctx.grain_size, par_for_each_chunk, &ctx);
+}
+
+/**
+ * @brief 并行地将元素转换到目标范围
+ * 
+ * @param begin 源范围的起始迭代器
+ * @param end 源范围的结束迭代器
+ * @param dest 目标范围的起始迭代器
+ * @param op 一元操作函数指针
+ * @param grain_size 每个分块的元素数量，为0时自动选择
+ * @param count 输出参数，存储转换的元素数量
+ * @return error_code_t 错误码
+ */
+error_code_t algo_par_transform(iterator_t* begin, iterator_t* end, iterator_t* dest,
+                                unary_op_fn_t op, size_t grain_size, size_t* count)
+{
+    if (begin == NULL || end == NULL || dest == NULL || op == NULL || count == NULL) {
+        return CSTL_ERROR_NULL_POINTER;
+    }
+    
+    void* data = NULL;
+    void* dest_data = NULL;
+    size_t source_count = 0;
+    size_t dest_capacity = 0;
+    
+    if (!vector_iterator_span(begin, end, &data, &source_count) ||
+        !vector_iterator_span(dest, NULL, &dest_data, &dest_capacity) ||
+        dest->element_size != begin->element_size) {
+        return algo_transform(begin, end, dest, op, count);
+    }
+    
+    if (dest_capacity < source_count) {
+        *count = 0;
+        return CSTL_ERROR_INVALID_ARGUMENT;
+    }
+    
+    par_context_t ctx;
+    memset(&ctx, 0, sizeof(ctx));
+    ctx.data = (char*)data;
+    ctx.dest = (char*)dest_data;
+    ctx.element_size = begin->element_size;
+    ctx.grain_size = par_grain_size(source_count, grain_size);
+    ctx.op = op;
+    
+    error_code_t err = thread_pool_parallel_for(NULL, source_count, ctx.grain_size,
+                                                par_transform_chunk, &ctx);
+    *count = err == CSTL_OK ? source_count : 0;
+    return err;
+}
+
+/**
+ * @brief 并行归约
+ * 
+ * @param begin 起始迭代器
+ * @param end 结束迭代器
+ * @param combine 合并函数指针
+ * @param grain_size 每个分块的元素数量，为0时自动选择
+ * @param result 输入输出参数，输入为初值，输出为归约结果
+ * @return error_code_t 错误码
+ */
+error_code_t algo_par_reduce(iterator_t* begin, iterator_t* end, binary_op_fn_t combine,
+                             size_t grain_size, void* result)
+{
+    if (begin == NULL || end == NULL || combine == NULL || result == NULL) {
+        return CSTL_ERROR_NULL_POINTER;
+    }
+    
+    void* data = NULL;
+    size_t count = 0;
+    
+    if (!vector_iterator_span(begin, end, &data, &count)) {
+        iterator_t* iter = iterator_clone(begin);
+        while (iterator_valid(iter) && !iterator_equal(iter, end)) {
+            void* element = NULL;
+            iterator_get(iter, &element);
+            combine(result, element);
+            iterator_next(iter);
+        }
+        iterator_destroy(iter);
+        return CSTL_OK;
+    }
+    
+    if (count == 0) {
+        return CSTL_OK;
+    }
+    
+    par_context_t ctx;
+    memset(&ctx, 0, sizeof(ctx));
+    ctx.data = (char*)data;
+    ctx.element_size = begin->element_size;
+    ctx.grain_size = par_grain_size(count, grain_size);
+    ctx.combine = combine;
+    
+    size_t num_chunks = (count + ctx.grain_size - 1) / ctx.grain_size;
+    ctx.partials = malloc(num_chunks * ctx.element_size);
+    if (ctx.partials == NULL) {
+        return CSTL_ERROR_OUT_OF_MEMORY;
+    }
+    
+    error_code_t err = thread_pool_parallel_for(NULL, count, ctx.grain_size, par_reduce_chunk, &ctx);
+    if (err == CSTL_OK) {
+        /* 按分块顺序合并，保证只依赖结合律 */
+        for (size_t i = 0; i < num_chunks; i++) {
+            combine(result, (char*)ctx.partials + i * ctx.element_size);
+        }
+    }
+    
+    free(ctx.partials);
+    return err;
+}
+
+/**
+ * @brief 并行统计满足谓词条件的元素数量
+ * 
+ * @param begin 起始迭代器
+ * @param end 结束迭代器
+ * @param predicate 谓词函数指针
+ * @param grain_size 每个分块的元素数量，为0时自动选择
+ * @param count 输出参数，存储满足条件的元素数量
+ * @return error_code_t 错误码
+ */
+error_code_t algo_par_count_if(iterator_t* begin, iterator_t* end, predicate_fn_t predicate,
+                               size_t grain_size, size_t* count)
+{
+    if (begin == NULL || end == NULL || predicate == NULL || count == NULL) {
+        return CSTL_ERROR_NULL_POINTER;
+    }
+    
+    void* data = NULL;
+    size_t total = 0;
+    
+    if (!vector_iterator_span(begin, end, &data, &total)) {
+        return algo_count_if(begin, end, predicate, count);
+    }
+    
+    *count = 0;
+    if (total == 0) {
+        return CSTL_OK;
+    }
+    
+    par_context_t ctx;
+    memset(&ctx, 0, sizeof(ctx));
+    ctx.data = (char*)data;
+    ctx.element_size = begin->element_size;
+    ctx.grain_size = par_grain_size(total, grain_size);
+    ctx.predicate = predicate;
+    
+    size_t num_chunks = (total + ctx.grain_size - 1) / ctx.grain_size;
+    size_t* partials = (size_t*)malloc(num_chunks * sizeof(size_t));
+    if (partials == NULL) {
+        return CSTL_ERROR_OUT_OF_MEMORY;
+    }
+    ctx.partials = partials;
+    
+    error_code_t err = thread_pool_parallel_for(NULL, total, ctx.grain_size, par_count_if_chunk, &ctx);
+    if (err == CSTL_OK) {
+        for (size_t i = 0; i < num_chunks; i++) {
+            *count += partials[i];
+        }
+    }
+    
+    free(partials);
+    return err;
+}
+
+/**
+ * @brief 并行洗牌的最大分块（桶）数量，桶编号用一个字节保存
+ */
+#define ALGO_PAR_SHUFFLE_MAX_BUCKETS 256
+
+/**
+ * @brief 并行洗牌的上下文
+ */
+typedef struct {
+    char* data;                 /**< 数据首元素指针 */
+    char* buffer;               /**< 按桶排列的临时缓冲区 */
+    unsigned char* labels;      /**< 每个元素被分配到的桶 */
+    size_t element_size;        /**< 元素大小 */
+    size_t grain_size;          /**< 分块大小 */
+    size_t buckets;             /**< 分块数量，也是桶的数量 */
+    size_t* offsets;            /**< buckets x buckets，每个分块在每个桶中的计数或写入位置 */
+    size_t* bucket_begin;       /**< 每个桶在缓冲区中的起始下标，共buckets + 1项 */
+    rng_t* streams;             /**< 每个分块（桶）独立的随机流 */
+} par_shuffle_context_t;
+
+/**
+ * @brief 并行洗牌第一步：为分块内的元素随机选择桶并计数
+ * 
+ * @param context 并行洗牌上下文
+ * @param begin 分块起始下标
+ * @param end 分块结束下标
+ */
+static void par_shuffle_label_chunk(void* context, size_t begin, size_t end)
+{
+    par_shuffle_context_t* ctx = (par_shuffle_context_t*)context;
+    size_t chunk = begin / ctx->grain_size;
+    rng_t* stream = &ctx->streams[chunk];
+    size_t* counts = ctx->offsets + chunk * ctx->buckets;
+    
+    for (size_t i = begin; i < end; i++) {
+        unsigned char label = (unsigned char)rng_bounded(stream, ctx->buckets);
+        ctx->labels[i] = label;
+        counts[label]++;
+    }
+}
+
+/**
+ * @brief 并行洗牌第二步：把分块内的元素复制到各自桶中的位置
+ * 
+ * @param context 并行洗牌上下文
+ * @param begin 分块起始下标
+ * @param end 分块结束下标
+ */
+static void par_shuffle_scatter_chunk(void* context, size_t begin, size_t end)
+{
+    par_shuffle_context_t* ctx = (par_shuffle_context_t*)context;
+    size_t element_size = ctx->element_size;
+    size_t* positions = ctx->offsets + (begin / ctx->grain_size) * ctx->buckets;
+    
+    for (size_t i = begin; i < end; i++) {
+        memcpy(ctx->buffer + positions[ctx->labels[i]]++ * element_size,
+               ctx->data + i * element_size, element_size);
+    }
+}
+
+/**
+ * @brief 并行洗牌第三步：把桶复制回原位置并在桶内洗牌
+ * 
+ * @param context 并行洗牌上下文
+ * @param begin 起始桶编号
+ * @param end 结束桶编号
+ */
+static void par_shuffle_bucket(void* context, size_t begin, size_t end)
+{
+    par_shuffle_context_t* ctx = (par_shuffle_context_t*)context;
+    size_t element_size = ctx->element_size;
+    
+    for (size_t b = begin; b < end; b++) {
+        size_t first = ctx->bucket_begin[b];
+        size_t count = ctx->bucket_begin[b + 1] - first;
+        memcpy(ctx->data + first * element_size, ctx->buffer + first * element_size,
+               count * element_size);
+        span_shuffle(ctx->data + first * element_size, count, element_size, &ctx->streams[b]);
+    }
+}
+
+/**
+ * @brief 并行随机打乱范围
+ * 
+ * @param begin 起始迭代器
+ * @param end 结束迭代器
+ * @param rng 生成器状态，为NULL时使用当前线程的生成器
+ * @param grain_size 每个分块的元素数量，为0时自动选择
+ * @return error_code_t 错误码
+ */
+error_code_t algo_par_shuffle(iterator_t* begin, iterator_t* end, rng_t* rng, size_t grain_size)
+{
+    if (begin == NULL || end == NULL) {
+        return CSTL_ERROR_NULL_POINTER;
+    }
+    
+    if (rng == NULL) {
+        rng = rng_thread_local();
+    }
+    
+    void* data = NULL;
+    size_t total = 0;
+    
+    if (!vector_iterator_span(begin, end, &data, &total)) {
+        return algo_shuffle_rng(begin, end, rng);
+    }
+    
+    /* 桶数量受标签宽度限制，必要时增大分块 */
+    size_t grain = par_grain_size(total, grain_size);
+    size_t min_grain = (total + ALGO_PAR_SHUFFLE_MAX_BUCKETS - 1) / ALGO_PAR_SHUFFLE_MAX_BUCKETS;
+    if (grain < min_grain) {
+        grain = min_grain;
+    }
+    
+    if (grain >= total) {
+        span_shuffle((char*)data, total, begin->element_size, rng);
+        return CSTL_OK;
+    }
+    
+    par_shuffle_context_t ctx;
+    memset(&ctx, 0, sizeof(ctx));
+    ctx.data = (char*)data;
+    ctx.element_size = begin->element_size;
+    ctx.grain_size = grain;
+    ctx.buckets = (total + grain - 1) / grain;
+    ctx.buffer = (char*)malloc(total * ctx.element_size);
+    ctx.labels = (unsigned char*)malloc(total);
+    ctx.offsets = (size_t*)calloc(ctx.buckets * ctx.buckets, sizeof(size_t));
+    ctx.bucket_begin = (size_t*)malloc((ctx.buckets + 1) * sizeof(size_t));
+    ctx.streams = (rng_t*)malloc(ctx.buckets * sizeof(rng_t));
+    
+    if (ctx.buffer == NULL || ctx.labels == NULL || ctx.offsets == NULL ||
+        ctx.bucket_begin == NULL || ctx.streams == NULL) {
+        free(ctx.buffer);
+        free(ctx.labels);
+        free(ctx.offsets);
+        free(ctx.bucket_begin);
+        free(ctx.streams);
+        return CSTL_ERROR_OUT_OF_MEMORY;
+    }
+    
+    /* 每个分块一个互不重叠的随机流 */
+    rng_split(rng, &ctx.streams[0]);
+    for (size_t c = 1; c < ctx.buckets; c++) {
+        ctx.streams[c] = ctx.streams[c - 1];
+        rng_jump(&ctx.streams[c]);
+    }
+    
+    error_code_t err = thread_pool_parallel_for(NULL, total, grain, par_shuffle_label_chunk, &ctx);
+    
+    if (err == CSTL_OK) {
+        /* 按桶优先的顺序把计数转换为每个分块的写入位置 */
+        size_t position = 0;
+        for (size_t b = 0; b < ctx.buckets; b++) {
+            ctx.bucket_begin[b] = position;
+            for (size_t c = 0; c < ctx.buckets; c++) {
+                size_t* slot = &ctx.offsets[c * ctx.buckets + b];
+                size_t count = *slot;
+                *slot = position;
+                position += count;
+            }
+        }
+        ctx.bucket_begin[ctx.buckets] = position;
+        
+        err = thread_pool_parallel_for(NULL, total, grain, par_shuffle_scatter_chunk, &ctx);
+    }
+    if (err == CSTL_OK) {
+        err = thread_pool_parallel_for(NULL, ctx.buckets, 1, par_shuffle_bucket, &ctx);
+    }
+    
+    free(ctx.buffer);
+    free(ctx.labels);
+    free(ctx.offsets);
+    free(ctx.bucket_begin);
+    free(ctx.streams);
+    return err;
+}
+
+/*
+ * 哈希算法
+ *
+ * 开放寻址的线性探测哈希表，容量为2的幂，负载超过3/4时翻倍。
+ * 槽位只保存元素指针和完整哈希值，探测时先比较哈希值，
+ * 相同才调用比较函数，因此比较函数的调用次数接近元素数量。
+ */
+
+/**
+ * @brief 哈希表初始容量上限，更多的不同值通过翻倍扩容容纳
+ */
+#define HASH_TABLE_INITIAL_MAX 4096
+
+/**
+ * @brief 哈希表槽位
+ */
+typedef struct {
+    uint64_t hash;          /**< 元素的哈希值 */
+    void* element;          /**< 元素指针，空槽位为NULL */
+    size_t value;           /**< 附加数据：计数或结果下标 */
+} hash_slot_t;
+
+/**
+ * @brief 哈希表
+ */
+typedef struct {
+    hash_slot_t* slots;     /**< 槽位数组 */
+    size_t mask;            /**< 容量减一 */
+    size_t size;            /**< 已占用的槽位数量 */
+    hash_fn_t hash;         /**< 哈希函数，为NULL时对字节求哈希 */
+    compare_fn_t compare;   /**< 比较函数，为NULL时按位比较 */
+    size_t element_size;    /**< 元素大小 */
+} hash_table_t;
+
+/**
+ * @brief 64位混合函数（MurmurHash3的fmix64）
+ *
+ * @param x 输入值
+ * @return uint64_t 混合后的值
+ */
+static inline uint64_t hash_mix(uint64_t x)
+{
+    x ^= x >> 33;
+    x *= 0xFF51AFD7ED558CCDULL;
+    x ^= x >> 33;
+    x *= 0xC4CEB9FE1A85EC53ULL;
+    x ^= x >> 33;
+    return x;
+}
+
+/**
+ * @brief 对元素的字节求哈希
+ *
+ * 1/2/4/8字节的元素直接按整数读取，其他宽度使用FNV-1a。
+ *
+ * @param element 元素指针
+ * @param element_size 元素大小
+ * @return uint64_t 哈希值
+ */
+static uint64_t hash_bytes(const void* element, size_t element_size)
+{
+    switch (element_size) {
+    case 1: { uint8_t v; memcpy(&v, element, 1); return v; }
+    case 2: { uint16_t v; memcpy(&v, element, 2); return v; }
+    case 4: { uint32_t v; memcpy(&v, element, 4); return v; }
+    case 8: { uint64_t v; memcpy(&v, element, 8); return v; }
+    default: break;
+    }
+    
+    const unsigned char* p = (const unsigned char*)element;
+    uint64_t h = 0xCBF29CE484222325ULL;
+    for (size_t i = 0; i < element_size; i++) {
+        h = (h ^ p[i]) * 0x100000001B3ULL;
+    }
+    return h;
+}
+
+/**
+ * @brief 计算元素在哈希表中使用的哈希值
+ */
+static inline uint64_t hash_table_hash(const hash_table_t* table, const void* element)
+{
+    return hash_mix(table->hash != NULL ? table->hash(element) : hash_bytes(element, table->element_size));
+}
+
+/**
+ * @brief 初始化哈希表
+ *
+ * @param table 哈希表
+ * @param expected 预计插入的元素数量上限
+ * @param hash 哈希函数指针
+ * @param compare 比较函数指针
+ * @param element_size 元素大小
+ * @return error_code_t 错误码
+ */
+static error_code_t hash_table_init(hash_table_t* table, size_t expected, hash_fn_t hash,
+                                    compare_fn_t compare, size_t element_size)
+{
+    size_t initial = expected < HASH_TABLE_INITIAL_MAX ? expected : HASH_TABLE_INITIAL_MAX;
+    size_t capacity = 16;
+    while (capacity * 3 < initial * 4) {
+        capacity <<= 1;
+    }
+    
+    table->slots = (hash_slot_t*)calloc(capacity, sizeof(hash_slot_t));
+    if (table->slots == NULL) {
+        return CSTL_ERROR_OUT_OF_MEMORY;
+    }
+    table->mask = capacity - 1;
+    table->size = 0;
+    table->hash = hash;
+    table->compare = compare;
+    table->element_size = element_size;
+    return CSTL_OK;
+}
+
+/**
+ * @brief 释放哈希表，初始化失败后调用也是安全的
+ */
+static void hash_table_destroy(hash_table_t* table)
+{
+    free(table->slots);
+    table->slots = NULL;
+}
+
+/**
+ * @brief 查找元素所在的槽位
+ *
+ * @param table 哈希表
+ * @param element 元素指针
+ * @param hash 元素的哈希值
+ * @return hash_slot_t* 相等元素的槽位，不存在时返回可插入的空槽位
+ */
+static hash_slot_t* hash_table_probe(const hash_table_t* table, const void* element, uint64_t hash)
+{
+    size_t index = (size_t)hash & table->mask;
+    
+    for (;;) {
+        hash_slot_t* slot = &table->slots[index];
+        if (slot->element == NULL ||
+            (slot->hash == hash && elements_equal(slot->element, element, table->compare, table->element_size))) {
+            return slot;
+        }
+        index = (index + 1) & table->mask;
+    }
+}
+
+/**
+ * @brief 保证还能再插入一个元素而不超过负载上限
+ *
+ * 扩容后重新插入只使用保存的哈希值，不再调用哈希函数和比较函数。
+ *
+ * @param table 哈希表
+ * @return error_code_t 错误码
+ */
+static error_code_t hash_table_reserve_one(hash_table_t* table)
+{
+    size_t capacity = table->mask + 1;
+    if ((table->size + 1) * 4 <= capacity * 3) {
+        return CSTL_OK;
+    }
+    
+    size_t new_capacity = capacity * 2;
+    hash_slot_t* slots = (hash_slot_t*)calloc(new_capacity, sizeof(hash_slot_t));
+    if (slots == NULL) {
+        return CSTL_ERROR_OUT_OF_MEMORY;
+    }
+    
+    for (size_t i = 0; i < capacity; i++) {
+        if (table->slots[i].element != NULL) {
+            size_t index = (size_t)table->slots[i].hash & (new_capacity - 1);
+            while (slots[index].element != NULL) {
+                index = (index + 1) & (new_capacity - 1);
+            }
+            slots[index] = table->slots[i];
+        }
+    }
+    
+    free(table->slots);
+    table->slots = slots;
+    table->mask = new_capacity - 1;
+    return CSTL_OK;
+}
+
+/**
+ * @brief 查找元素，不存在时插入
+ *
+ * @param table 哈希表
+ * @param element 元素指针，插入时保存该指针
+ * @param hash 元素的哈希值
+ * @param slot 输出参数，存储元素所在的槽位
+ * @return error_code_t 错误码
+ */
+static error_code_t hash_table_insert(hash_table_t* table, void* element, uint64_t hash, hash_slot_t** slot)
+{
+    error_code_t err = hash_table_reserve_one(table);
+    if (err != CSTL_OK) {
+        return err;
+    }
+    
+    *slot = hash_table_probe(table, element, hash);
+    if ((*slot)->element == NULL) {
+        (*slot)->element = element;
+        (*slot)->hash = hash;
+        (*slot)->value = 0;
+        table->size++;
+    }
+    return CSTL_OK;
+}
+
+/**
+ * @brief 范围游标，连续范围直接移动指针，其他范围使用迭代器
+ */
+typedef struct {
+    char* data;             /**< 连续范围的当前位置，非连续时为NULL */
+    char* data_end;         /**< 连续范围的结束位置 */
+    iterator_t* iter;       /**< 非连续范围的迭代器 */
+    iterator_t* end;        /**< 非连续范围的结束迭代器 */
+    size_t element_size;    /**< 元素大小 */
+} range_cursor_t;
+
+/**
+ * @brief 初始化范围游标
+ *
+ * @param cursor 范围游标
+ * @param begin 起始迭代器
+ * @param end 结束迭代器
+ * @param count 输出参数，存储范围中的元素数量，为NULL时不计算
+ * @return error_code_t 错误码，复制迭代器失败时返回CSTL_ERROR_OUT_OF_MEMORY
+ */
+static error_code_t range_cursor_init(range_cursor_t* cursor, iterator_t* begin, iterator_t* end, size_t* count)
+{
+    void* data = NULL;
+    size_t size = 0;
+    
+    memset(cursor, 0, sizeof(*cursor));
+    cursor->element_size = begin->element_size;
+    if (vector_iterator_span(begin, end, &data, &size)) {
+        cursor->data = (char*)data;
+        cursor->data_end = (char*)data + size * begin->element_size;
+        if (count != NULL) {
+            *count = size;
+        }
+        return CSTL_OK;
+    }
+    
+    cursor->iter = iterator_clone(begin);
+    if (cursor->iter == NULL) {
+        return CSTL_ERROR_OUT_OF_MEMORY;
+    }
+    cursor->end = end;
+    if (count != NULL) {
+        *count = range_distance(begin, end);
+    }
+    return CSTL_OK;
+}
+
+/**
+ * @brief 取出当前元素并前进一步
+ *
+ * @param cursor 范围游标
+ * @return void* 元素指针，到达结尾返回NULL
+ */
+static void* range_cursor_next(range_cursor_t* cursor)
+{
+    if (cursor->iter == NULL) {
+        if (cursor->data == cursor->data_end) {
+            return NULL;
+        }
+        void* element = cursor->data;
+        cursor->data += cursor->element_size;
+        return element;
+    }
+    
+    if (!iterator_valid(cursor->iter) || iterator_equal(cursor->iter, cursor->end)) {
+        return NULL;
+    }
+    void* element = NULL;
+    iterator_get(cursor->iter, &element);
+    iterator_next(cursor->iter);
+    return element;
+}
+
+/**
+ * @brief 释放范围游标
+ */
+static void range_cursor_destroy(range_cursor_t* cursor)
+{
+    if (cursor->iter != NULL) {
+        iterator_destroy(cursor->iter);
+        cursor->iter = NULL;
+    }
+}
+
+/**
+ * @brief 基于哈希表检查一个范围是否是另一个范围的排列
+ *
+ * 先比较两个范围的大小，再用第一个范围建立值到次数的表，
+ * 第二个范围逐个扣减，遇到不存在或已扣完的值立即返回。
+ *
+ * @param begin1 第一个范围的起始迭代器
+ * @param end1 第一个范围的结束迭代器
+ * @param begin2 第二个范围的起始迭代器
+ * @param end2 第二个范围的结束迭代器
+ * @param hash 哈希函数指针，为NULL时对元素的字节求哈希
+ * @param compare 比较函数指针，为NULL时按位比较
+ * @param is_permutation 输出参数，存储是否是排列
+ * @return error_code_t 错误码
+ */
+error_code_t algo_is_permutation_hash(iterator_t* begin1, iterator_t* end1,
+                                      iterator_t* begin2, iterator_t* end2,
+                                      hash_fn_t hash, compare_fn_t compare, int* is_permutation)
+{
+    if (begin1 == NULL || end1 == NULL || begin2 == NULL || end2 == NULL || is_permutation == NULL) {
+        return CSTL_ERROR_NULL_POINTER;
+    }
+    
+    *is_permutation = 0;
+    
+    range_cursor_t cursor1;
+    range_cursor_t cursor2;
+    size_t count1 = 0;
+    size_t count2 = 0;
+    error_code_t err = range_cursor_init(&cursor1, begin1, end1, &count1);
+    if (err != CSTL_OK) {
+        return err;
+    }
+    err = range_cursor_init(&cursor2, begin2, end2, &count2);
+    if (err != CSTL_OK) {
+        range_cursor_destroy(&cursor1);
+        return err;
+    }
+    if (count1 != count2) {
+        range_cursor_destroy(&cursor1);
+        range_cursor_destroy(&cursor2);
+        return CSTL_OK;
+    }
+    
+    hash_table_t table;
+    err = hash_table_init(&table, count1, hash, compare, begin1->element_size);
+    
+    void* element = NULL;
+    while (err == CSTL_OK && (element = range_cursor_next(&cursor1)) != NULL) {
+        hash_slot_t* slot = NULL;
+        err = hash_table_insert(&table, element, hash_table_hash(&table, element), &slot);
+        if (err == CSTL_OK) {
+            slot->value++;
+        }
+    }
+    
+    if (err == CSTL_OK) {
+        int matched = 1;
+        while (matched && (element = range_cursor_next(&cursor2)) != NULL) {
+            hash_slot_t* slot = hash_table_probe(&table, element, hash_table_hash(&table, element));
+            if (slot->element == NULL || slot->value == 0) {
+                matched = 0;
+            } else {
+                slot->value--;
+            }
+        }
+        *is_permutation = matched;
+    }
+    
+    hash_table_destroy(&table);
+    range_cursor_destroy(&cursor1);
+    range_cursor_destroy(&cursor2);
+    return err;
+}
+
+/**
+ * @brief 移除无序范围中的重复元素，保留每个值第一次出现的元素
+ *
+ * 读写两个游标同向前进，写位置不会超过读位置。
+ * 哈希表保存的是元素移动后的位置，之后的写入只发生在更靠后的位置，
+ * 因此表中的指针始终有效。
+ *
+ * @param begin 起始迭代器
+ * @param end 结束迭代器
+ * @param hash 哈希函数指针，为NULL时对元素的字节求哈希
+ * @param compare 比较函数指针，为NULL时按位比较
+ * @param count 输出参数，存储移除的元素数量
+ * @return error_code_t 错误码
+ */
+error_code_t algo_distinct(iterator_t* begin, iterator_t* end, hash_fn_t hash,
+                           compare_fn_t compare, size_t* count)
+{
+    if (begin == NULL || end == NULL || count == NULL) {
+        return CSTL_ERROR_NULL_POINTER;
+    }
+    
+    *count = 0;
+    
+    range_cursor_t reader;
+    range_cursor_t writer;
+    size_t total = 0;
+    error_code_t err = range_cursor_init(&reader, begin, end, &total);
+    if (err != CSTL_OK) {
+        return err;
+    }
+    err = range_cursor_init(&writer, begin, end, NULL);
+    if (err != CSTL_OK) {
+        range_cursor_destroy(&reader);
+        return err;
+    }
+    
+    hash_table_t table;
+    err = hash_table_init(&table, total, hash, compare, begin->element_size);
+    
+    void* element = NULL;
+    while (err == CSTL_OK && (element = range_cursor_next(&reader)) != NULL) {
+        uint64_t h = hash_table_hash(&table, element);
+        err = hash_table_reserve_one(&table);
+        if (err != CSTL_OK) {
+            break;
+        }
+        
+        hash_slot_t* slot = hash_table_probe(&table, element, h);
+        if (slot->element != NULL) {
+            (*count)++;
+            continue;
+        }
+        
+        void* dest = range_cursor_next(&writer);
+        if (dest != element) {
+            memcpy(dest, element, begin->element_size);
+        }
+        slot->element = dest;
+        slot->hash = h;
+        table.size++;
+    }
+    
+    hash_table_destroy(&table);
+    range_cursor_destroy(&reader);
+    range_cursor_destroy(&writer);
+    return err;
+}
+
+/**
+ * @brief 统计范围中每个不同值的出现次数
+ *
+ * 槽位的附加数据保存该值在结果数组中的下标，结果数组按需翻倍增长。
+ *
+ * @param begin 起始迭代器
+ * @param end 结束迭代器
+ * @param hash 哈希函数指针，为NULL时对元素的字节求哈希
+ * @param compare 比较函数指针，为NULL时按位比较
+ * @param frequencies 输出参数，存储结果数组，使用free释放，范围为空时为NULL
+ * @param count 输出参数，存储不同值的数量
+ * @return error_code_t 错误码
+ */
+error_code_t algo_frequencies(iterator_t* begin, iterator_t* end, hash_fn_t hash,
+                              compare_fn_t compare, algo_frequency_t** frequencies, size_t* count)
+{
+    if (begin == NULL || end == NULL || frequencies == NULL || count == NULL) {
+        return CSTL_ERROR_NULL_POINTER;
+    }
+    
+    *frequencies = NULL;
+    *count = 0;
+    
+    range_cursor_t cursor;
+    size_t total = 0;
+    error_code_t err = range_cursor_init(&cursor, begin, end, &total);
+    if (err != CSTL_OK) {
+        return err;
+    }
+    
+    hash_table_t table;
+    err = hash_table_init(&table, total, hash, compare, begin->element_size);
+    
+    algo_frequency_t* result = NULL;
+    size_t capacity = 0;
+    void* element = NULL;
+    while (err == CSTL_OK && (element = range_cursor_next(&cursor)) != NULL) {
+        hash_slot_t* slot = NULL;
+        size_t size = table.size;
+        err = hash_table_insert(&table, element, hash_table_hash(&table, element), &slot);
+        if (err != CSTL_OK) {
+            break;
+        }
+        
+        if (table.size == size) {
+            result[slot->value].count++;
+            continue;
+        }
+        
+        /* 新出现的值追加到结果末尾 */
+        if (size == capacity) {
+            size_t new_capacity = capacity == 0 ? 64 : capacity * 2;
+            algo_frequency_t* grown = (algo_frequency_t*)realloc(result, new_capacity * sizeof(algo_frequency_t));
+            if (grown == NULL) {
+                err = CSTL_ERROR_OUT_OF_MEMORY;
+                break;
+            }
+            result = grown;
+            capacity = new_capacity;
+        }
+        result[size].element = element;
+        result[size].count = 1;
+        slot->value = size;
+    }
+    
+    if (err == CSTL_OK) {
+        *frequencies = result;
+        *count = table.size;
+    } else {
+        free(result);
+    }
+    hash_table_destroy(&table);
+    
+    range_cursor_destroy(&cursor);
+    return err;
+}
+
+/*
+ * 有序范围集合运算
+ *
+ * 两个输入都是向量区间时，一侧连续胜出ALGO_GALLOP_THRESHOLD次后改用
+ * 指数搜索（galloping）找出整段连续胜出的元素，成段复制或跳过；
+ * 两侧大小相差悬殊时从一开始就使用指数搜索，比较次数为O(m log(n / m))。
+ * 其他范围逐元素归并。
+ */
+
+/**
+ * @brief 连续胜出多少次后切换到指数搜索
+ */
+#define ALGO_GALLOP_THRESHOLD 7
+
+/**
+ * @brief 两侧大小相差多少倍时从一开始就使用指数搜索
+ */
+#define ALGO_GALLOP_SKEW 16
+
+/**
+ * @brief 有序范围集合运算的类型
+ */
+typedef enum {
+    SET_OP_MERGE,           /**< 归并 */
+    SET_OP_UNION,           /**< 并集 */
+    SET_OP_INTERSECTION,    /**< 交集 */
+    SET_OP_DIFFERENCE,      /**< 差集 */
+    SET_OP_INCLUDES         /**< 包含判断 */
+} set_op_t;
+
+/**
+ * @brief 集合运算的输出目标
+ */
+typedef struct {
+    char* data;             /**< 目标为向量区间时的首元素指针 */
+    size_t capacity;        /**< 目标为向量区间时可写入的元素数量 */
+    iterator_t* iter;       /**< 目标不连续时的写入迭代器 */
+    size_t element_size;    /**< 元素大小 */
+    size_t count;           /**< 已写入的元素数量 */
+    int overflow;           /**< 目标范围容量不足 */
+} set_output_t;
+
+/**
+ * @brief 初始化输出目标
+ * 
+ * @param out 输出目标
+ * @param dest 目标范围的起始迭代器，为NULL时不输出
+ * @param element_size 元素大小
+ */
+static void set_output_init(set_output_t* out, iterator_t* dest, size_t element_size)
+{
+    memset(out, 0, sizeof(*out));
+    out->element_size = element_size;
+    
+    if (dest == NULL) {
+        return;
+    }
+    
+    void* data = NULL;
+    if (vector_iterator_span(dest, NULL, &data, &out->capacity)) {
+        out->data = (char*)data;
+    } else {
+        out->iter = iterator_clone(dest);
+    }
+}
+
+/**
+ * @brief 向输出目标追加连续的若干元素
+ * 
+ * @param out 输出目标
+ * @param src 首元素指针
+ * @param n 元素数量
+ */
+static void set_output_append(set_output_t* out, const char* src, size_t n)
+{
+    if (out->overflow || n == 0) {
+        return;
+    }
+    
+    if (out->data != NULL || out->iter == NULL) {
+        if (out->capacity - out->count < n) {
+            out->overflow = 1;
+            return;
+        }
+        memcpy(out->data + out->count * out->element_size, src, n * out->element_size);
+        out->count += n;
+        return;
+    }
+    
+    for (size_t i = 0; i < n; i++) {
+        void* element = NULL;
+        if (!iterator_valid(out->iter) || iterator_get(out->iter, &element) != CSTL_OK) {
+            out->overflow = 1;
+            return;
+        }
+        memcpy(element, src + i * out->element_size, out->element_size);
+        iterator_next(out->iter);
+        out->count++;
+    }
+}
+
+/**
+ * @brief 指数搜索：从base开始找出第一个不满足条件的位置
+ * 
+ * 条件为 element < key（strict为真）或 element <= key（strict为假），
+ * 调用者已知base[0]满足条件。
+ * 
+ * @param base 首元素指针
+ * @param count 元素数量
+ * @param element_size 元素大小
+ * @param key 比较的键
+ * @param compare 比较函数指针
+ * @param strict 是否严格小于
+ * @return size_t 满足条件的前缀长度
+ */
+static size_t span_gallop(const char* base, size_t count, size_t element_size,
+                          const void* key, compare_fn_t compare, int strict)
+{
+    size_t low = 1;
+    size_t high = 1;
+    
+    /* 以1, 2, 4, ...的步长前进，直到越过第一个不满足条件的位置 */
+    while (high < count) {
+        int c = compare(base + high * element_size, key);
+        if (strict ? c >= 0 : c > 0) {
+            break;
+        }
+        low = high + 1;
+        high = high * 2 + 1;
+    }
+    if (high > count) {
+        high = count;
+    }
+    
+    /* 在[low, high)中二分 */
+    while (low < high) {
+        size_t mid = low + (high - low) / 2;
+        int c = compare(base + mid * element_size, key);
+        if (strict ? c < 0 : c <= 0) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+    return low;
+}
+
+/**
+ * @brief 连续区间上的集合运算
+ * 
+ * @param op 运算类型
+ * @param a 第一个区间首元素指针
+ * @param n1 第一个区间元素数量
+ * @param b 第二个区间首元素指针
+ * @param n2 第二个区间元素数量
+ * @param element_size 元素大小
+ * @param compare 比较函数指针
+ * @param out 输出目标
+ * @return int SET_OP_INCLUDES时表示是否包含，其他运算总是返回1
+ */
+static int set_op_span(set_op_t op, const char* a, size_t n1, const char* b, size_t n2,
+                       size_t element_size, compare_fn_t compare, set_output_t* out)
+{
+    size_t i = 0;
+    size_t j = 0;
+    size_t wins_a = 0;
+    size_t wins_b = 0;
+    size_t threshold = ALGO_GALLOP_THRESHOLD;
+    
+    if (n1 / ALGO_GALLOP_SKEW >= n2 + 1 || n2 / ALGO_GALLOP_SKEW >= n1 + 1) {
+        threshold = 0;
+    }
+    
+    /* 第一个区间中小于第二个区间当前元素的部分是否输出 */
+    int emit_a = op == SET_OP_MERGE || op == SET_OP_UNION || op == SET_OP_DIFFERENCE;
+    int emit_b = op == SET_OP_MERGE || op == SET_OP_UNION;
+    
+    while (i < n1 && j < n2) {
+        const char* x = a + i * element_size;
+        const char* y = b + j * element_size;
+        int c = compare(x, y);
+        
+        /* 归并时相等的元素先取第一个区间的，保证稳定 */
+        if (c < 0 || (c == 0 && op == SET_OP_MERGE)) {
+            size_t run = 1;
+            if (++wins_a > threshold) {
+                run = span_gallop(x, n1 - i, element_size, y, compare, op != SET_OP_MERGE);
+            }
+            wins_b = 0;
+            if (emit_a) {
+                set_output_append(out, x, run);
+            }
+            i += run;
+        } else if (c > 0) {
+            if (op == SET_OP_INCLUDES) {
+                return 0;
+            }
+            size_t run = 1;
+            if (++wins_b > threshold) {
+                run = span_gallop(y, n2 - j, element_size, x, compare, 1);
+            }
+            wins_a = 0;
+            if (emit_b) {
+                set_output_append(out, y, run);
+            }
+            j += run;
+        } else {
+            if (op == SET_OP_UNION || op == SET_OP_INTERSECTION) {
+                set_output_append(out, x, 1);
+            }
+            wins_a = 0;
+            wins_b = 0;
+            i++;
+            j++;
+        }
+    }
+    
+    if (op == SET_OP_INCLUDES) {
+        return j == n2;
+    }
+    if (emit_a) {
+        set_output_append(out, a + i * element_size, n1 - i);
+    }
+    if (emit_b) {
+        set_output_append(out, b + j * element_size, n2 - j);
+    }
+    return 1;
+}
+
+/**
+ * @brief 通过迭代器逐元素执行集合运算
+ * 
+ * @param op 运算类型
+ * @param begin1 第一个范围的起始迭代器
+ * @param end1 第一个范围的结束迭代器
+ * @param begin2 第二个范围的起始迭代器
+ * @param end2 第二个范围的结束迭代器
+ * @param compare 比较函数指针
+ * @param out 输出目标
+ * @return int SET_OP_INCLUDES时表示是否包含，其他运算总是返回1
+ */
+static int set_op_generic(set_op_t op, iterator_t* begin1, iterator_t* end1,
+                          iterator_t* begin2, iterator_t* end2,
+                          compare_fn_t compare, set_output_t* out)
+{
+    iterator_t* iter1 = iterator_clone(begin1);
+    iterator_t* iter2 = iterator_clone(begin2);
+    int emit_a = op == SET_OP_MERGE || op == SET_OP_UNION || op == SET_OP_DIFFERENCE;
+    int emit_b = op == SET_OP_MERGE || op == SET_OP_UNION;
+    int result = 1;
+    
+    while (iterator_valid(iter1) && !iterator_equal(iter1, end1) &&
+           iterator_valid(iter2) && !iterator_equal(iter2, end2) && !out->overflow) {
+        void* x = NULL;
+        void* y = NULL;
+        iterator_get(iter1, &x);
+        iterator_get(iter2, &y);
+        int c = compare(x, y);
+        
+        if (c < 0 || (c == 0 && op == SET_OP_MERGE)) {
+            if (emit_a) {
+                set_output_append(out, (const char*)x, 1);
+            }
+            iterator_next(iter1);
+        } else if (c > 0) {
+            if (op == SET_OP_INCLUDES) {
+                result = 0;
+                break;
+            }
+            if (emit_b) {
+                set_output_append(out, (const char*)y, 1);
+            }
+            iterator_next(iter2);
+        } else {
+            if (op == SET_OP_UNION || op == SET_OP_INTERSECTION) {
+                set_output_append(out, (const char*)x, 1);
+            }
+            iterator_next(iter1);
+            iterator_next(iter2);
+        }
+    }
+    
+    if (op == SET_OP_INCLUDES) {
+        if (result && iterator_valid(iter2) && !iterator_equal(iter2, end2)) {
+            result = 0;
+        }
+    } else {
+        /* 复制剩余部分 */
+        iterator_t* rest[2] = {iter1, iter2};
+        iterator_t* rest_end[2] = {end1, end2};
+        int emit[2] = {emit_a, emit_b};
+        for (int k = 0; k < 2; k++) {
+            while (emit[k] && !out->overflow && iterator_valid(rest[k]) &&
+                   !iterator_equal(rest[k], rest_end[k])) {
+                void* element = NULL;
+                iterator_get(rest[k], &element);
+                set_output_append(out, (const char*)element, 1);
+                iterator_next(rest[k]);
+            }
+        }
+    }
+    
+    iterator_destroy(iter1);
+    iterator_destroy(iter2);
+    return result;
+}
+
+/**
+ * @brief 集合运算的公共入口
+ * 
+ * @param op 运算类型
+ * @param begin1 第一个范围的起始迭代器
+ * @param end1 第一个范围的结束迭代器
+ * @param begin2 第二个范围的起始迭代器
+ * @param end2 第二个范围的结束迭代器
+ * @param dest 目标范围的起始迭代器，SET_OP_INCLUDES时为NULL
+ * @param compare 比较函数指针
+ * @param count 输出参数，存储写入的元素数量，可以为NULL
+ * @param included 输出参数，SET_OP_INCLUDES时存储结果
+ * @return error_code_t 错误码
+ */
+static error_code_t set_op_impl(set_op_t op, iterator_t* begin1, iterator_t* end1,
+                                iterator_t* begin2, iterator_t* end2, iterator_t* dest,
+                                compare_fn_t compare, size_t* count, int* included)
+{
+    set_output_t out;
+    set_output_init(&out, dest, begin1->element_size);
+    
+    void* data1 = NULL;
+    void* data2 = NULL;
+    size_t n1 = 0;
+    size_t n2 = 0;
+    int result;
+    
+    if (vector_iterator_span(begin1, end1, &data1, &n1) &&
+        vector_iterator_span(begin2, end2, &data2, &n2)) {
+        result = set_op_span(op, (const char*)data1, n1, (const char*)data2, n2,
+                             begin1->element_size, compare, &out);
+    } else {
+        result = set_op_generic(op, begin1, end1, begin2, end2, compare, &out);
+    }
+    
+    if (out.iter != NULL) {
+        iterator_destroy(out.iter);
+    }
+    if (count != NULL) {
+        *count = out.count;
+    }
+    if (included != NULL) {
+        *included = result;
+    }
+    
+    return out.overflow ? CSTL_ERROR_INVALID_ARGUMENT : CSTL_OK;
+}
+
+/**
+ * @brief 归并两个有序范围
+ * 
+ * @param begin1 第一个范围的起始迭代器
+ * @param end1 第一个范围的结束迭代器
+ * @param begin2 第二个范围的起始迭代器
+ * @param end2 第二个范围的结束迭代器
+ * @param dest 目标范围的起始迭代器
+ * @param compare 比较函数指针
+ * @param count 输出参数，存储写入的元素数量，可以为NULL
+ * @return error_code_t 错误码
+ */
+error_code_t algo_merge(iterator_t* begin1, iterator_t* end1,
+                        iterator_t* begin2, iterator_t* end2,
+                        iterator_t* dest, compare_fn_t compare, size_t* count)
+{
+    if (begin1 == NULL || end1 == NULL || begin2 == NULL || end2 == NULL ||
+        dest == NULL || compare == NULL) {
+        return CSTL_ERROR_NULL_POINTER;
+    }
+    
+    return set_op_impl(SET_OP_MERGE, begin1, end1, begin2, end2, dest, compare, count, NULL);
+}
+
+/**
+ * @brief 求两个有序范围的并集
+ * 
+ * @param begin1 第一个范围的起始迭代器
+ * @param end1 第一个范围的结束迭代器
+ * @param begin2 第二个范围的起始迭代器
+ * @param end2 第二个范围的结束迭代器
+ * @param dest 目标范围的起始迭代器
+ * @param compare 比较函数指针
+ * @param count 输出参数，存储写入的元素数量，可以为NULL
+ * @return error_code_t 错误码
+ */
+error_code_t algo_set_union(iterator_t* begin1, iterator_t* end1,
+                            iterator_t* begin2, iterator_t* end2,
+                            iterator_t* dest, compare_fn_t compare, size_t* count)
+{
+    if (begin1 == NULL || end1 == NULL || begin2 == NULL || end2 == NULL ||
+        dest == NULL || compare == NULL) {
+        return CSTL_ERROR_NULL_POINTER;
+    }
+    
+    return set_op_impl(SET_OP_UNION, begin1, end1, begin2, end2, dest, compare, count, NULL);
+}
+
+/**
+ * @brief 求两个有序范围的交集
+ * 
+ * @param begin1 第一个范围的起始迭代器
+ * @param end1 第一个范围的结束迭代器
+ * @param begin2 第二个范围的起始迭代器
+ * @param end2 第二个范围的结束迭代器
+ * @param dest 目标范围的起始迭代器
+ * @param compare 比较函数指针
+ * @param count 输出参数，存储写入的元素数量，可以为NULL
+ * @return error_code_t 错误码
+ */
+error_code_t algo_set_intersection(iterator_t* begin1, iterator_t* end1,
+                                   iterator_t* begin2, iterator_t* end2,
+                                   iterator_t* dest, compare_fn_t compare, size_t* count)
+{
+    if (begin1 == NULL || end1 == NULL || begin2 == NULL || end2 == NULL ||
+        dest == NULL || compare == NULL) {
+        return CSTL_ERROR_NULL_POINTER;
+    }
+    
+    return set_op_impl(SET_OP_INTERSECTION, begin1, end1, begin2, end2, dest, compare, count, NULL);
+}
+
+/**
+ * @brief 求两个有序范围的差集
+ * 
+ * @param begin1 第一个范围的起始迭代器
+ * @param end1 第一个范围的结束迭代器
+ * @param begin2 第二个范围的起始迭代器
+ * @param end2 第二个范围的结束迭代器
+ * @param dest 目标范围的起始迭代器
+ * @param compare 比较函数指针
+ * @param count 输出参数，存储写入的元素数量，可以为NULL
+ * @return error_code_t 错误码
+ */
+error_code_t algo_set_difference(iterator_t* begin1, iterator_t* end1,
+                                 iterator_t* begin2, iterator_t* end2,
+                                 iterator_t* dest, compare_fn_t compare, size_t* count)
+{
+    if (begin1 == NULL || end1 == NULL || begin2 == NULL || end2 == NULL ||
+        dest == NULL || compare == NULL) {
+        return CSTL_ERROR_NULL_POINTER;
+    }
+    
+    return set_op_impl(SET_OP_DIFFERENCE, begin1, end1, begin2, end2, dest, compare, count, NULL);
+}
+
+/**
+ * @brief 检查一个有序范围是否包含另一个有序范围
+ * 
+ * @param begin1 第一个范围的起始迭代器
+ * @param end1 第一个范围的结束迭代器
+ * @param begin2 第二个范围的起始迭代器
+ * @param end2 第二个范围的结束迭代器
+ * @param compare 比较函数指针
+ * @param result 输出参数，第二个范围是第一个范围的子集时为1，否则为0
+ * @return error_code_t 错误码
+ */
+error_code_t algo_includes(iterator_t* begin1, iterator_t* end1,
+                           iterator_t* begin2, iterator_t* end2,
+                           compare_fn_t compare, int* result)
+{
+    if (begin1 == NULL || end1 == NULL || begin2 == NULL || end2 == NULL ||
+        compare == NULL || result == NULL) {
+        return CSTL_ERROR_NULL_POINTER;
+    }
+    
+    return set_op_impl(SET_OP_INCLUDES, begin1, end1, begin2, end2, NULL, compare, NULL, result);
+}
+
+/**
+ * @brief 败者树中source是否应排在other之前
+ * 
+ * 已取完的输入排在最后，相等时按输入编号，保证稳定。
+ * 
+ * @param heads 每个输入当前元素的指针，取完为NULL
+ * @param source 输入编号
+ * @param other 输入编号
+ * @param compare 比较函数指针
+ * @return int 排在之前返回1，否则返回0
+ */
+static int loser_tree_before(char* const* heads, size_t source, size_t other, compare_fn_t compare)
+{
+    if (heads[source] == NULL) {
+        return 0;
+    }
+    if (heads[other] == NULL) {
+        return 1;
+    }
+    
+    int c = compare(heads[source], heads[other]);
+    return c < 0 || (c == 0 && source < other);
+}
+
+/**
+ * @brief 用败者树归并多个有序向量
+ * 
+ * @param sources 有序向量数组
+ * @param source_count 向量数量
+ * @param dest 目标向量，归并结果追加到末尾
+ * @param compare 比较函数指针
+ * @return error_code_t 错误码
+ */
+error_code_t algo_merge_k(vector_t* const* sources, size_t source_count,
+                          vector_t* dest, compare_fn_t compare)
+{
+    if ((sources == NULL && source_count > 0) || dest == NULL || compare == NULL) {
+        return CSTL_ERROR_NULL_POINTER;
+    }
+    
+    size_t element_size = dest->element_size;
+    size_t total = 0;
+    for (size_t s = 0; s < source_count; s++) {
+        if (sources[s] == NULL) {
+            return CSTL_ERROR_NULL_POINTER;
+        }
+        if (sources[s]->element_size != element_size || sources[s] == dest) {
+            return CSTL_ERROR_INVALID_ARGUMENT;
+        }
+        total += vector_size(sources[s]);
+    }
+    
+    if (total == 0) {
+        return CSTL_OK;
+    }
+    
+    size_t old_size = vector_size(dest);
+    error_code_t err = vector_resize(dest, old_size + total);
+    if (err != CSTL_OK) {
+        return err;
+    }
+    char* out = (char*)dest->data + old_size * element_size;
+    
+    if (source_count == 1) {
+        memcpy(out, sources[0]->data, total * element_size);
+        return CSTL_OK;
+    }
+    
+    /* heads/ends为每个输入的当前和结束位置，tree[0]为胜者，tree[1..k)为各节点的败者 */
+    size_t k = source_count;
+    char** heads = (char**)malloc(k * sizeof(char*));
+    char** ends = (char**)malloc(k * sizeof(char*));
+    size_t* tree = (size_t*)malloc(k * sizeof(size_t));
+    size_t* winners = (size_t*)malloc(2 * k * sizeof(size_t));
+    if (heads == NULL || ends == NULL || tree == NULL || winners == NULL) {
+        free(heads);
+        free(ends);
+        free(tree);
+        free(winners);
+        vector_resize(dest, old_size);
+        return CSTL_ERROR_OUT_OF_MEMORY;
+    }
+    
+    for (size_t s = 0; s < k; s++) {
+        size_t n = vector_size(sources[s]);
+        heads[s] = n > 0 ? (char*)sources[s]->data : NULL;
+        ends[s] = (char*)sources[s]->data + n * element_size;
+    }
+    
+    /* 叶子k + s对应输入s，自底向上建树 */
+    for (size_t s = 0; s < k; s++) {
+        winners[k + s] = s;
+    }
+    for (size_t node = k - 1; node >= 1; node--) {
+        size_t left = winners[2 * node];
+        size_t right = winners[2 * node + 1];
+        if (loser_tree_before(heads, left, right, compare)) {
+            winners[node] = left;
+            tree[node] = right;
+        } else {
+            winners[node] = right;
+            tree[node] = left;
+        }
+    }
+    tree[0] = winners[1];
+    free(winners);
+    
+    for (size_t t = 0; t < total; t++) {
+        size_t winner = tree[0];
+        memcpy(out, heads[winner], element_size);
+        out += element_size;
+        heads[winner] += element_size;
+        if (heads[winner] == ends[winner]) {
+            heads[winner] = NULL;
+        }
+        
+        /* 沿叶子到根的路径与败者比较，只需log k次比较 */
+        for (size_t node = (winner + k) / 2; node >= 1; node /= 2) {
+            if (loser_tree_before(heads, tree[node], winner, compare)) {
+                size_t loser = winner;
+                winner = tree[node];
+                tree[node] = loser;
+            }
+        }
+        tree[0] = winner;
+    }
+    
+    free(heads);
+    free(ends);
+    free(tree);
+    return CSTL_OK;
+}
+
+/*
+ * 按键排序
+ *
+ * 键先转换为保序的无符号整数：有符号整数翻转符号位，浮点数负数按位取反、
+ * 非负数置符号位，字节串按大端拼接，降序时再整体取反。之后只比较整数。
+ * 元素不超过ALGO_SORT_KEY_DIRECT_MAX字节且键取自元素本身时直接对元素做
+ * LSD基数排序，否则对(键, 下标)对排序后再按下标重排元素。
+ * 基数排序前一次统计所有字节的直方图，跳过所有元素该字节都相同的趟。
+ */
+
+/**
+ * @brief 元素数量达到该值时使用基数排序，否则对键值对做归并排序
+ */
+#define ALGO_SORT_KEY_RADIX_MIN 64
+
+/**
+ * @brief 直接移动元素做基数排序的最大元素大小
+ */
+#define ALGO_SORT_KEY_DIRECT_MAX 16
+
+/**
+ * @brief 键值对归并排序中使用插入排序的段长度
+ */
+#define ALGO_SORT_KEY_INSERTION 16
+
+/**
+ * @brief 排序键的描述
+ */
+typedef struct sort_key_desc_t {
+    size_t offset;              /**< 键在元素中的偏移 */
+    size_t width;               /**< 键的字节数 */
+    size_t radix_width;         /**< 参与基数排序的字节数，最多8 */
+    sort_key_type_t type;       /**< 键的类型 */
+    sort_order_t order;         /**< 排序方向 */
+    key_fn_t key_fn;            /**< 键提取函数，为NULL时键取自元素 */
+} sort_key_desc_t;
+
+/**
+ * @brief (键, 下标)对
+ */
+typedef struct sort_key_pair_t {
+    uint64_t key;               /**< 保序整数键，字节串键时为前8字节 */
+    size_t index;               /**< 元素原来的下标 */
+} sort_key_pair_t;
+
+/**
+ * @brief 键值对排序的上下文，用于比较超过8字节的字节串键的剩余部分
+ */
+typedef struct sort_key_context_t {
+    const sort_key_desc_t* desc; /**< 键的描述 */
+    const char* data;           /**< 元素首地址 */
+    size_t element_size;        /**< 元素大小 */
+    const unsigned char* keys;  /**< 缓存的键，键取自元素时为NULL */
+} sort_key_context_t;
+
+/**
+ * @brief 检查键的描述是否合法
+ * 
+ * @param desc 键的描述
+ * @param element_size 元素大小
+ * @return error_code_t 错误码
+ */
+static error_code_t sort_key_validate(const sort_key_desc_t* desc, size_t element_size)
+{
+    size_t width = desc->width;
+    
+    switch (desc->type) {
+    case SORT_KEY_INT:
+    case SORT_KEY_UINT:
+        if (width != 1 && width != 2 && width != 4 && width != 8) {
+            return CSTL_ERROR_INVALID_ARGUMENT;
+        }
+        break;
+    case SORT_KEY_FLOAT:
+        if (width != 4 && width != 8) {
+            return CSTL_ERROR_INVALID_ARGUMENT;
+        }
+        break;
+    case SORT_KEY_BYTES:
+        if (width == 0) {
+            return CSTL_ERROR_INVALID_ARGUMENT;
+        }
+        break;
+    default:
+        return CSTL_ERROR_INVALID_ARGUMENT;
+    }
+    
+    if (desc->order != SORT_ASCENDING && desc->order != SORT_DESCENDING) {
+        return CSTL_ERROR_INVALID_ARGUMENT;
+    }
+    if (desc->key_fn == NULL && (desc->offset > element_size || width > element_size - desc->offset)) {
+        return CSTL_ERROR_INVALID_ARGUMENT;
+    }
+    return CSTL_OK;
+}
+
+/**
+ * @brief 把键转换为保序的无符号整数
+ * 
+ * 结果只占低radix_width * 8位，按无符号整数比较的顺序就是键的顺序。
+ * 
+ * @param desc 键的描述
+ * @param key 键的首地址
+ * @return uint64_t 保序整数
+ */
+static inline uint64_t sort_key_normalize(const sort_key_desc_t* desc, const unsigned char* key)
+{
+    size_t width = desc->radix_width;
+    uint64_t value = 0;
+    
+    switch (desc->type) {
+    case SORT_KEY_INT:
+    case SORT_KEY_UINT:
+        switch (width) {
+        case 1: value = key[0]; break;
+        case 2: { uint16_t v; memcpy(&v, key, 2); value = v; break; }
+        case 4: { uint32_t v; memcpy(&v, key, 4); value = v; break; }
+        default: memcpy(&value, key, 8); break;
+        }
+        if (desc->type == SORT_KEY_INT) {
+            value ^= (uint64_t)1 << (width * 8 - 1);
+        }
+        break;
+    case SORT_KEY_FLOAT:
+        if (width == 4) {
+            uint32_t bits;
+            memcpy(&bits, key, 4);
+            bits = (bits & 0x80000000u) ? ~bits : (bits | 0x80000000u);
+            value = bits;
+        } else {
+            memcpy(&value, key, 8);
+            value = (value >> 63) ? ~value : (value | ((uint64_t)1 << 63));
+        }
+        break;
+    case SORT_KEY_BYTES:
+        for (size_t i = 0; i < width; i++) {
+            value = (value << 8) | key[i];
+        }
+        break;
+    }
+    
+    if (desc->order == SORT_DESCENDING) {
+        value = ~value;
+        if (width < 8) {
+            value &= ((uint64_t)1 << (width * 8)) - 1;
+        }
+    }
+    return value;
+}
+
+/**
+ * @brief 按位置复制元素，常见大小使用定长复制
+ * 
+ * @param dst 目标地址
+ * @param src 源地址
+ * @param size 元素大小
+ */
+static inline void sort_key_copy(char* dst, const char* src, size_t size)
+{
+    switch (size) {
+    case 4: memcpy(dst, src, 4); break;
+    case 8: memcpy(dst, src, 8); break;
+    case 16: memcpy(dst, src, 16); break;
+    default: memcpy(dst, src, size); break;
+    }
+}
+
+/**
+ * @brief 把直方图转换为各桶的起始位置
+ * 
+ * @param histogram 直方图，转换后存放起始位置
+ * @param first_digit 第一个元素在该字节上的值
+ * @param count 元素数量
+ * @return int 所有元素在该字节上相同时返回0，表示可以跳过这一趟
+ */
+static int sort_key_prefix_sum(size_t* histogram, unsigned first_digit, size_t count)
+{
+    if (histogram[first_digit] == count) {
+        return 0;
+    }
+    
+    size_t sum = 0;
+    for (size_t b = 0; b < 256; b++) {
+        size_t n = histogram[b];
+        histogram[b] = sum;
+        sum += n;
+    }
+    return 1;
+}
+
+/**
+ * @brief 直接对元素做LSD基数排序
+ * 
+ * @param data 元素首地址
+ * @param temp 与data同样大小的临时缓冲区
+ * @param count 元素数量
+ * @param element_size 元素大小
+ * @param desc 键的描述
+ */
+static void sort_key_radix_elements(char* data, char* temp, size_t count, size_t element_size,
+                                    const sort_key_desc_t* desc)
+{
+    size_t histogram[8][256];
+    size_t digits = desc->radix_width;
+    memset(histogram, 0, sizeof(histogram));
+    
+    for (size_t i = 0; i < count; i++) {
+        uint64_t key = sort_key_normalize(desc, (const unsigned char*)data + i * element_size + desc->offset);
+        for (size_t d = 0; d < digits; d++) {
+            histogram[d][(key >> (d * 8)) & 0xFF]++;
+        }
+    }
+    
+    uint64_t first = sort_key_normalize(desc, (const unsigned char*)data + desc->offset);
+    char* src = data;
+    char* dst = temp;
+    for (size_t d = 0; d < digits; d++) {
+        size_t* offsets = histogram[d];
+        if (!sort_key_prefix_sum(offsets, (unsigned)((first >> (d * 8)) & 0xFF), count)) {
+            continue;
+        }
+        
+        const char* element = src;
+        for (size_t i = 0; i < count; i++, element += element_size) {
+            uint64_t key = sort_key_normalize(desc, (const unsigned char*)element + desc->offset);
+            size_t pos = offsets[(key >> (d * 8)) & 0xFF]++;
+            sort_key_copy(dst + pos * element_size, element, element_size);
+        }
+        
+        char* swap = src;
+        src = dst;
+        dst = swap;
+    }
+    
+    if (src != data) {
+        memcpy(data, src, count * element_size);
+    }
+}
+
+/**
+ * @brief 对键值对做LSD基数排序
+ * 
+ * @param pairs 键值对
+ * @param temp 同样大小的临时缓冲区
+ * @param count 键值对数量
+ * @param digits 参与排序的字节数
+ * @return sort_key_pair_t* 排好序的数组，可能是pairs或temp
+ */
+static sort_key_pair_t* sort_key_radix_pairs(sort_key_pair_t* pairs, sort_key_pair_t* temp, size_t count,
+                                             size_t digits)
+{
+    size_t histogram[8][256];
+    memset(histogram, 0, sizeof(histogram));
+    
+    for (size_t i = 0; i < count; i++) {
+        uint64_t key = pairs[i].key;
+        for (size_t d = 0; d < digits; d++) {
+            histogram[d][(key >> (d * 8)) & 0xFF]++;
+        }
+    }
+    
+    uint64_t first = pairs[0].key;
+    sort_key_pair_t* src = pairs;
+    sort_key_pair_t* dst = temp;
+    for (size_t d = 0; d < digits; d++) {
+        size_t* offsets = histogram[d];
+        if (!sort_key_prefix_sum(offsets, (unsigned)((first >> (d * 8)) & 0xFF), count)) {
+            continue;
+        }
+        
+        for (size_t i = 0; i < count; i++) {
+            dst[offsets[(src[i].key >> (d * 8)) & 0xFF]++] = src[i];
+        }
+        
+        sort_key_pair_t* swap = src;
+        src = dst;
+        dst = swap;
+    }
+    return src;
+}
+
+/**
+ * @brief 比较两个键值对
+ * 
+ * 先比较保序整数，超过8字节的字节串键再比较剩余字节。
+ * 
+ * @param context 排序上下文
+ * @param a 第一个键值对
+ * @param b 第二个键值对
+ * @return int 比较结果
+ */
+static int sort_key_pair_compare(const sort_key_context_t* context, const sort_key_pair_t* a,
+                                 const sort_key_pair_t* b)
+{
+    if (a->key != b->key) {
+        return a->key < b->key ? -1 : 1;
+    }
+    
+    const sort_key_desc_t* desc = context->desc;
+    if (desc->width <= 8) {
+        return 0;
+    }
+    
+    const unsigned char* ka;
+    const unsigned char* kb;
+    if (context->keys != NULL) {
+        ka = context->keys + a->index * desc->width;
+        kb = context->keys + b->index * desc->width;
+    } else {
+        ka = (const unsigned char*)context->data + a->index * context->element_size + desc->offset;
+        kb = (const unsigned char*)context->data + b->index * context->element_size + desc->offset;
+    }
+    
+    int result = memcmp(ka + 8, kb + 8, desc->width - 8);
+    return desc->order == SORT_DESCENDING ? -result : result;
+}
+
+/**
+ * @brief 对键值对做稳定的归并排序
+ * 
+ * @param context 排序上下文
+ * @param pairs 键值对
+ * @param temp 至少能容纳count个键值对的临时缓冲区
+ * @param count 键值对数量
+ */
+static void sort_key_merge_sort(const sort_key_context_t* context, sort_key_pair_t* pairs,
+                                sort_key_pair_t* temp, size_t count)
+{
+    if (count <= ALGO_SORT_KEY_INSERTION) {
+        for (size_t i = 1; i < count; i++) {
+            sort_key_pair_t current = pairs[i];
+            size_t j = i;
+            while (j > 0 && sort_key_pair_compare(context, &current, &pairs[j - 1]) < 0) {
+                pairs[j] = pairs[j - 1];
+                j--;
+            }
+            pairs[j] = current;
+        }
+        return;
+    }
+    
+    size_t half = count / 2;
+    sort_key_merge_sort(context, pairs, temp, half);
+    sort_key_merge_sort(context, pairs + half, temp, count - half);
+    if (sort_key_pair_compare(context, &pairs[half], &pairs[half - 1]) >= 0) {
+        return;
+    }
+    
+    memcpy(temp, pairs, half * sizeof(sort_key_pair_t));
+    size_t i = 0;
+    size_t j = half;
+    size_t k = 0;
+    while (i < half && j < count) {
+        if (sort_key_pair_compare(context, &pairs[j], &temp[i]) < 0) {
+            pairs[k++] = pairs[j++];
+        } else {
+            pairs[k++] = temp[i++];
+        }
+    }
+    while (i < half) {
+        pairs[k++] = temp[i++];
+    }
+}
+
+/**
+ * @brief 通过键值对排序连续存储的元素
+ * 
+ * @param data 元素首地址
+ * @param count 元素数量
+ * @param element_size 元素大小
+ * @param desc 键的描述
+ * @return error_code_t 错误码
+ */
+static error_code_t sort_key_span_pairs(char* data, size_t count, size_t element_size,
+                                        const sort_key_desc_t* desc)
+{
+    sort_key_pair_t* pairs = (sort_key_pair_t*)malloc(count * sizeof(sort_key_pair_t));
+    sort_key_pair_t* temp = (sort_key_pair_t*)malloc(count * sizeof(sort_key_pair_t));
+    int cache_keys = desc->key_fn != NULL && desc->width > 8;
+    unsigned char* keys = cache_keys ? (unsigned char*)malloc(count * desc->width) : NULL;
+    if (pairs == NULL || temp == NULL || (cache_keys && keys == NULL)) {
+        free(pairs);
+        free(temp);
+        free(keys);
+        return CSTL_ERROR_OUT_OF_MEMORY;
+    }
+    
+    /* 每个元素只计算一次键，超过8字节的计算键缓存下来供比较剩余字节 */
+    for (size_t i = 0; i < count; i++) {
+        const char* element = data + i * element_size;
+        unsigned char buffer[8];
+        const unsigned char* key;
+        if (keys != NULL) {
+            desc->key_fn(element, keys + i * desc->width);
+            key = keys + i * desc->width;
+        } else if (desc->key_fn != NULL) {
+            desc->key_fn(element, buffer);
+            key = buffer;
+        } else {
+            key = (const unsigned char*)element + desc->offset;
+        }
+        pairs[i].key = sort_key_normalize(desc, key);
+        pairs[i].index = i;
+    }
+    
+    sort_key_context_t context;
+    context.desc = desc;
+    context.data = data;
+    context.element_size = element_size;
+    context.keys = keys;
+    
+    sort_key_pair_t* sorted = pairs;
+    if (count < ALGO_SORT_KEY_RADIX_MIN) {
+        sort_key_merge_sort(&context, pairs, temp, count);
+    } else {
+        sorted = sort_key_radix_pairs(pairs, temp, count, desc->radix_width);
+        sort_key_pair_t* spare = sorted == pairs ? temp : pairs;
+        
+        /* 前8字节相同的段按剩余字节排序 */
+        if (desc->width > 8) {
+            size_t start = 0;
+            while (start < count) {
+                size_t stop = start + 1;
+                while (stop < count && sorted[stop].key == sorted[start].key) {
+                    stop++;
+                }
+                if (stop - start > 1) {
+                    sort_key_merge_sort(&context, sorted + start, spare, stop - start);
+                }
+                start = stop;
+            }
+        }
+    }
+    
+    /* 按排好的下标重排元素 */
+    char* out = (char*)malloc(count * element_size);
+    if (out == NULL) {
+        free(pairs);
+        free(temp);
+        free(keys);
+        return CSTL_ERROR_OUT_OF_MEMORY;
+    }
+    for (size_t i = 0; i < count; i++) {
+        sort_key_copy(out + i * element_size, data + sorted[i].index * element_size, element_size);
+    }
+    memcpy(data, out, count * element_size);
+    
+    free(out);
+    free(pairs);
+    free(temp);
+    free(keys);
+    return CSTL_OK;
+}
+
+/**
+ * @brief 用排序网络排序整个元素就是键的小数组
+ * 
+ * 键等于整个元素时相等的键意味着相同的元素，排序网络不稳定也不影响结果；
+ * 降序时先升序排序再反转。
+ * 
+ * @param data 首元素指针
+ * @param count 元素数量
+ * @param element_size 元素大小
+ * @param desc 键的描述
+ * @return int 已排序返回1，不适用返回0
+ */
+static int sort_key_network(char* data, size_t count, size_t element_size, const sort_key_desc_t* desc)
+{
+    if (desc->key_fn != NULL || desc->offset != 0 || desc->width != element_size ||
+        count > SIMD_SORT_SMALL_MAX) {
+        return 0;
+    }
+    
+    error_code_t err = CSTL_ERROR_INVALID_ARGUMENT;
+    if (desc->type == SORT_KEY_INT) {
+        switch (element_size) {
+            case 2:
+                err = simd_sort_small_i16((int16_t*)(void*)data, count);
+                break;
+            case 4:
+                err = simd_sort_small_i32((int32_t*)(void*)data, count);
+                break;
+            case 8:
+                err = simd_sort_small_i64((int64_t*)(void*)data, count);
+                break;
+            default:
+                break;
+        }
+    } else if (desc->type == SORT_KEY_FLOAT) {
+        if (element_size == sizeof(float)) {
+            err = simd_sort_small_f32((float*)(void*)data, count);
+        } else if (element_size == sizeof(double)) {
+            err = simd_sort_small_f64((double*)(void*)data, count);
+        }
+    }
+    if (err != CSTL_OK) {
+        return 0;
+    }
+    
+    if (desc->order == SORT_DESCENDING) {
+        for (size_t i = 0, j = count - 1; i < j; i++, j--) {
+            span_swap(data + i * element_size, data + j * element_size, element_size);
+        }
+    }
+    return 1;
+}
+
+/**
+ * @brief 按键排序的公共实现
+ * 
+ * @param begin 起始迭代器
+ * @param end 结束迭代器
+ * @param desc 键的描述
+ * @return error_code_t 错误码
+ */
+static error_code_t sort_by_key_impl(iterator_t* begin, iterator_t* end, sort_key_desc_t* desc)
+{
+    size_t element_size = begin->element_size;
+    error_code_t err = sort_key_validate(desc, element_size);
+    if (err != CSTL_OK) {
+        return err;
+    }
+    desc->radix_width = desc->width < 8 ? desc->width : 8;
+    
+    void* span = NULL;
+    size_t count = 0;
+    char* data = NULL;
+    int gathered = 0;
+    if (vector_iterator_span(begin, end, &span, &count)) {
+        data = (char*)span;
+    } else {
+        count = range_distance(begin, end);
+        if (count < 2) {
+            return CSTL_OK;
+        }
+        data = range_gather(begin, count, element_size);
+        if (data == NULL) {
+            return CSTL_ERROR_OUT_OF_MEMORY;
+        }
+        gathered = 1;
+    }
+    if (count < 2) {
+        return CSTL_OK;
+    }
+    
+    if (sort_key_network(data, count, element_size, desc)) {
+        err = CSTL_OK;
+    } else if (desc->key_fn == NULL && desc->width <= 8 && element_size <= ALGO_SORT_KEY_DIRECT_MAX &&
+               count >= ALGO_SORT_KEY_RADIX_MIN) {
+        char* temp = (char*)malloc(count * element_size);
+        if (temp == NULL) {
+            err = CSTL_ERROR_OUT_OF_MEMORY;
+        } else {
+            sort_key_radix_elements(data, temp, count, element_size, desc);
+            free(temp);
+        }
+    } else {
+        err = sort_key_span_pairs(data, count, element_size, desc);
+    }
+    
+    if (gathered) {
+        if (err == CSTL_OK) {
+            range_scatter(begin, data, count, element_size);
+        }
+        free(data);
+    }
+    return err;
+}
+
+/**
+ * @brief 按元素中固定偏移处的键进行稳定排序
+ * 
+ * @param begin 起始迭代器
+ * @param end 结束迭代器
+ * @param key_offset 键在元素中的字节偏移
+ * @param key_width 键的字节数
+ * @param key_type 键的类型
+ * @param order 排序方向
+ * @return error_code_t 错误码
+ */
+error_code_t algo_sort_by_key(iterator_t* begin, iterator_t* end, size_t key_offset, size_t key_width,
+                              sort_key_type_t key_type, sort_order_t order)
+{
+    if (begin == NULL || end == NULL) {
+        return CSTL_ERROR_NULL_POINTER;
+    }
+    
+    sort_key_desc_t desc;
+    desc.offset = key_offset;
+    desc.width = key_width;
+    desc.radix_width = 0;
+    desc.type = key_type;
+    desc.order = order;
+    desc.key_fn = NULL;
+    return sort_by_key_impl(begin, end, &desc);
+}
+
+/**
+ * @brief 按计算得到的键进行稳定排序
+ * 
+ * @param begin 起始迭代器
+ * @param end 结束迭代器
+ * @param key_fn 键提取函数
+ * @param key_width 键的字节数
+ * @param key_type 键的类型
+ * @param order 排序方向
+ * @return error_code_t 错误码
+ */
+error_code_t algo_sort_by_computed_key(iterator_t* begin, iterator_t* end, key_fn_t key_fn, size_t key_width,
+                                       sort_key_type_t key_type, sort_order_t order)
+{
+    if (begin == NULL || end == NULL || key_fn == NULL) {
+        return CSTL_ERROR_NULL_POINTER;
+    }
+    
+    sort_key_desc_t desc;
+    desc.offset = 0;
+    desc.width = key_width;
+    desc.radix_width = 0;
+    desc.type = key_type;
+    desc.order = order;
+    desc.key_fn = key_fn;
+    return sort_by_key_impl(begin, end, &desc);
+}
+
+/*
+ * 间接排序
+ *
+ * 先收集每个元素的地址和下标，对(地址, 下标)对做稳定归并排序，比较时解引用地址，
+ * 排序过程中不移动元素；再沿排列的环移动元素，每个元素只移动一次。
+ * 非连续范围通过收集到的地址随机访问元素。
+ */
+
+/**
+ * @brief 间接排序的(地址, 下标)对
+ */
+typedef struct argsort_entry_t {
+    const void* element;        /**< 元素地址 */
+    size_t index;               /**< 元素原来的下标 */
+} argsort_entry_t;
+
+/**
+ * @brief 收集范围中元素的位置
+ * 
+ * 连续范围只返回首地址，其他范围返回每个元素的地址数组。
+ * 
+ * @param begin 起始迭代器
+ * @param end 结束迭代器
+ * @param data 输出参数，连续范围的首地址
+ * @param slots 输出参数，非连续范围的元素地址数组，需要调用者释放，连续范围为NULL
+ * @param count 输出参数，元素数量
+ * @return error_code_t 错误码
+ */
+static error_code_t argsort_collect(iterator_t* begin, iterator_t* end, char** data, char*** slots,
+                                    size_t* count)
+{
+    void* span = NULL;
+    *data = NULL;
+    *slots = NULL;
+    
+    if (vector_iterator_span(begin, end, &span, count)) {
+        *data = (char*)span;
+        return CSTL_OK;
+    }
+    
+    *count = range_distance(begin, end);
+    char** addresses = (char**)malloc((*count > 0 ? *count : 1) * sizeof(char*));
+    if (addresses == NULL) {
+        return CSTL_ERROR_OUT_OF_MEMORY;
+    }
+    
+    iterator_t* iter = iterator_clone(begin);
+    if (iter == NULL) {
+        free(addresses);
+        return CSTL_ERROR_OUT_OF_MEMORY;
+    }
+    for (size_t i = 0; i < *count; i++) {
+        void* element = NULL;
+        iterator_get(iter, &element);
+        addresses[i] = (char*)element;
+        iterator_next(iter);
+    }
+    iterator_destroy(iter);
+    
+    *slots = addresses;
+    return CSTL_OK;
+}
+
+/**
+ * @brief 取第i个元素的地址
+ * 
+ * @param data 连续范围的首地址
+ * @param slots 非连续范围的元素地址数组
+ * @param element_size 元素大小
+ * @param i 下标
+ * @return char* 元素地址
+ */
+static inline char* argsort_slot(char* data, char** slots, size_t element_size, size_t i)
+{
+    return slots != NULL ? slots[i] : data + i * element_size;
+}
+
+/**
+ * @brief 对(地址, 下标)对做稳定的归并排序
+ * 
+ * @param entries (地址, 下标)对
+ * @param temp 至少能容纳count / 2个对的临时缓冲区
+ * @param count 对的数量
+ * @param compare 比较函数指针
+ */
+static void argsort_merge_sort(argsort_entry_t* entries, argsort_entry_t* temp, size_t count,
+                               compare_fn_t compare)
+{
+    if (count <= ALGO_SORT_KEY_INSERTION) {
+        for (size_t i = 1; i < count; i++) {
+            argsort_entry_t current = entries[i];
+            size_t j = i;
+            while (j > 0 && compare(current.element, entries[j - 1].element) < 0) {
+                entries[j] = entries[j - 1];
+                j--;
+            }
+            entries[j] = current;
+        }
+        return;
+    }
+    
+    size_t half = count / 2;
+    argsort_merge_sort(entries, temp, half, compare);
+    argsort_merge_sort(entries + half, temp, count - half, compare);
+    if (compare(entries[half].element, entries[half - 1].element) >= 0) {
+        return;
+    }
+    
+    memcpy(temp, entries, half * sizeof(argsort_entry_t));
+    size_t i = 0;
+    size_t j = half;
+    size_t k = 0;
+    while (i < half && j < count) {
+        if (compare(entries[j].element, temp[i].element) < 0) {
+            entries[k++] = entries[j++];
+        } else {
+            entries[k++] = temp[i++];
+        }
+    }
+    while (i < half) {
+        entries[k++] = temp[i++];
+    }
+}
+
+/**
+ * @brief 求出使元素有序的下标排列
+ * 
+ * @param data 连续范围的首地址
+ * @param slots 非连续范围的元素地址数组
+ * @param count 元素数量
+ * @param element_size 元素大小
+ * @param compare 比较函数指针
+ * @param indices 输出参数，至少能容纳count个下标
+ * @return error_code_t 错误码
+ */
+static error_code_t argsort_impl(char* data, char** slots, size_t count, size_t element_size,
+                                 compare_fn_t compare, size_t* indices)
+{
+    argsort_entry_t* entries = (argsort_entry_t*)malloc((count > 0 ? count : 1) * sizeof(argsort_entry_t));
+    argsort_entry_t* temp = (argsort_entry_t*)malloc((count / 2 + 1) * sizeof(argsort_entry_t));
+    if (entries == NULL || temp == NULL) {
+        free(entries);
+        free(temp);
+        return CSTL_ERROR_OUT_OF_MEMORY;
+    }
+    
+    for (size_t i = 0; i < count; i++) {
+        entries[i].element = argsort_slot(data, slots, element_size, i);
+        entries[i].index = i;
+    }
+    argsort_merge_sort(entries, temp, count, compare);
+    for (size_t i = 0; i < count; i++) {
+        indices[i] = entries[i].index;
+    }
+    
+    free(entries);
+    free(temp);
+    return CSTL_OK;
+}
+
+/**
+ * @brief 沿排列的环原地重排元素
+ * 
+ * 重排后位置i上是原来位置indices[i]上的元素。
+ * 
+ * @param data 连续范围的首地址
+ * @param slots 非连续范围的元素地址数组
+ * @param count 元素数量
+ * @param element_size 元素大小
+ * @param indices 下标排列
+ * @param visited 清零的位图，至少count位
+ * @param temp 一个元素大小的临时缓冲区
+ */
+static void permute_impl(char* data, char** slots, size_t count, size_t element_size,
+                         const size_t* indices, unsigned char* visited, char* temp)
+{
+    for (size_t start = 0; start < count; start++) {
+        if (visited[start >> 3] & (1u << (start & 7))) {
+            continue;
+        }
+        if (indices[start] == start) {
+            visited[start >> 3] |= (unsigned char)(1u << (start & 7));
+            continue;
+        }
+        
+        memcpy(temp, argsort_slot(data, slots, element_size, start), element_size);
+        size_t j = start;
+        for (;;) {
+            size_t k = indices[j];
+            visited[j >> 3] |= (unsigned char)(1u << (j & 7));
+            if (k == start) {
+                break;
+            }
+            memcpy(argsort_slot(data, slots, element_size, j), argsort_slot(data, slots, element_size, k),
+                   element_size);
+            j = k;
+        }
+        memcpy(argsort_slot(data, slots, element_size, j), temp, element_size);
+    }
+}
+
+/**
+ * @brief 间接排序并按环重排元素，供algo_sort在大元素上使用
+ * 
+ * @param begin 起始迭代器
+ * @param end 结束迭代器
+ * @param compare 比较函数指针
+ * @return error_code_t 错误码
+ */
+static error_code_t indirect_sort_impl(iterator_t* begin, iterator_t* end, compare_fn_t compare)
+{
+    size_t element_size = begin->element_size;
+    char* data = NULL;
+    char** slots = NULL;
+    size_t count = 0;
+    
+    error_code_t err = argsort_collect(begin, end, &data, &slots, &count);
+    if (err != CSTL_OK) {
+        return err;
+    }
+    if (count < 2) {
+        free(slots);
+        return CSTL_OK;
+    }
+    
+    size_t* indices = (size_t*)malloc(count * sizeof(size_t));
+    unsigned char* visited = (unsigned char*)calloc((count + 7) / 8, 1);
+    char* temp = (char*)malloc(element_size);
+    if (indices == NULL || visited == NULL || temp == NULL) {
+        err = CSTL_ERROR_OUT_OF_MEMORY;
+    } else {
+        err = argsort_impl(data, slots, count, element_size, compare, indices);
+        if (err == CSTL_OK) {
+            permute_impl(data, slots, count, element_size, indices, visited, temp);
+        }
+    }
+    
+    free(indices);
+    free(visited);
+    free(temp);
+    free(slots);
+    return err;
+}
+
+/**
+ * @brief 间接排序，求出使范围有序的下标排列
+ * 
+ * @param begin 起始迭代器
+ * @param end 结束迭代器
+ * @param compare 比较函数指针
+ * @param indices 输出参数，元素大小为sizeof(size_t)的向量
+ * @return error_code_t 错误码
+ */
+error_code_t algo_argsort(iterator_t* begin, iterator_t* end, compare_fn_t compare, vector_t* indices)
+{
+    if (begin == NULL || end == NULL || compare == NULL || indices == NULL) {
+        return CSTL_ERROR_NULL_POINTER;
+    }
+    if (indices->element_size != sizeof(size_t)) {
+        return CSTL_ERROR_INVALID_ARGUMENT;
+    }
+    
+    char* data = NULL;
+    char** slots = NULL;
+    size_t count = 0;
+    error_code_t err = argsort_collect(begin, end, &data, &slots, &count);
+    if (err != CSTL_OK) {
+        return err;
+    }
+    
+    err = vector_resize(indices, count);
+    if (err == CSTL_OK) {
+        err = argsort_impl(data, slots, count, begin->element_size, compare, (size_t*)indices->data);
+    }
+    
+    free(slots);
+    return err;
+}
+
+/**
+ * @brief 按下标排列原地重排范围
+ * 
+ * @param begin 起始迭代器
+ * @param end 结束迭代器
+ * @param indices 元素大小为sizeof(size_t)的下标向量
+ * @return error_code_t 错误码
+ */
+error_code_t algo_permute(iterator_t* begin, iterator_t* end, const vector_t* indices)
+{
+    if (begin == NULL || end == NULL || indices == NULL) {
+        return CSTL_ERROR_NULL_POINTER;
+    }
+    if (indices->element_size != sizeof(size_t)) {
+        return CSTL_ERROR_INVALID_ARGUMENT;
+    }
+    
+    size_t element_size = begin->element_size;
+    char* data = NULL;
+    char** slots = NULL;
+    size_t count = 0;
+    error_code_t err = argsort_collect(begin, end, &data, &slots, &count);
+    if (err != CSTL_OK) {
+        return err;
+    }
+    if (indices->size != count) {
+        free(slots);
+        return CSTL_ERROR_INVALID_ARGUMENT;
+    }
+    
+    const size_t* order = (const size_t*)indices->data;
+    unsigned char* visited = (unsigned char*)calloc((count + 7) / 8 + 1, 1);
+    char* temp = (char*)malloc(element_size > 0 ? element_size : 1);
+    if (visited == NULL || temp == NULL) {
+        err = CSTL_ERROR_OUT_OF_MEMORY;
+    } else {
+        /* 先检查是否为排列，避免重复的下标覆盖元素 */
+        for (size_t i = 0; i < count && err == CSTL_OK; i++) {
+            size_t k = order[i];
+            if (k >= count || (visited[k >> 3] & (1u << (k & 7)))) {
+                err = CSTL_ERROR_INVALID_ARGUMENT;
+            } else {
+                visited[k >> 3] |= (unsigned char)(1u << (k & 7));
+            }
+        }
+        if (err == CSTL_OK) {
+            memset(visited, 0, (count + 7) / 8 + 1);
+            permute_impl(data, slots, count, element_size, order, visited, temp);
+        }
+    }
+    
+    free(visited);
+    free(temp);
+    free(slots);
+    return err;
+}
@@ -0,0 +1,1320 @@
+/**
+ * @file alist.c
+ * @brief CSTL库的数组链表容器实现
+ *
+ * 该文件实现了CSTL库的数组链表容器。每个槽位依次存放32位前驱下标、32位后继下标和元素，
+ * 元素部分按8字节向上取整。被移除的槽位用前驱下标ALIST_SLOT_FREE标记，
+ * 并通过后继下标串成空闲链表，插入时优先复用；空闲链表为空时使用数组末尾从未用过的槽位，
+ * 数组用满后通过分配器的reallocate成倍增长。
+ */
+
+#include "cstl/alist.h"
+#include <stdlib.h>
+#include <string.h>
+
+/**
+ * @brief 空闲槽位的前驱下标，用于识别已经被移除的槽位
+ */
+#define ALIST_SLOT_FREE ((uint32_t)0xFFFFFFFEu)
+
+/**
+ * @brief 最大槽位数量，ALIST_SLOT_FREE和ALIST_NIL不能作为槽位下标
+ */
+#define ALIST_MAX_SLOTS ((size_t)0xFFFFFFFEu)
+
+/**
+ * @brief 第一次分配时的槽位数量
+ */
+#define ALIST_MIN_CAPACITY 16
+
+/**
+ * @brief 排序时的有序段槽位数量，与list_sort相同
+ */
+#define ALIST_SORT_BINS 64
+
+/**
+ * @brief 槽位头部，存放前后链接
+ */
+typedef struct alist_link_t {
+    uint32_t prev;  /**< 前驱槽位下标 */
+    uint32_t next;  /**< 后继槽位下标 */
+} alist_link_t;
+
+/**
+ * @brief 数组链表迭代器结构体
+ */
+typedef struct alist_iterator_t {
+    iterator_t base;         /**< 基础迭代器 */
+    uint32_t position;       /**< 当前槽位下标 */
+} alist_iterator_t;
+
+/**
+ * @brief 获取槽位头部
+ *
+ * @param list 数组链表容器指针
+ * @param position 槽位下标
+ * @return alist_link_t* 槽位头部指针
+ */
+static alist_link_t* alist_link(const alist_t* list, uint32_t position)
+{
+    return (alist_link_t*)(list->slots + (size_t)position * list->slot_size);
+}
+
+/**
+ * @brief 获取槽位中的元素
+ *
+ * @param list 数组链表容器指针
+ * @param position 槽位下标
+ * @return void* 元素指针
+ */
+static void* alist_data(const alist_t* list, uint32_t position)
+{
+    return list->slots + (size_t)position * list->slot_size + sizeof(alist_link_t);
+}
+
+/**
+ * @brief 检查槽位下标是否指向链表中的元素
+ *
+ * @param list 数组链表容器指针
+ * @param position 槽位下标
+ * @return int 如果有效返回非零，否则返回零
+ */
+static int alist_position_valid(const alist_t* list, uint32_t position)
+{
+    return position < list->used && alist_link(list, position)->prev != ALIST_SLOT_FREE;
+}
+
+/**
+ * @brief 数组链表迭代器next函数实现
+ *
+ * @param iterator 迭代器指针
+ * @return error_code_t 错误码
+ */
+static error_code_t alist_iterator_next(iterator_t* iterator)
+{
+    if (iterator == NULL) {
+        return CSTL_ERROR_NULL_POINTER;
+    }
+
+    alist_iterator_t* alist_iter = (alist_iterator_t*)iterator;
+    const alist_t* list = (const alist_t*)iterator->container;
+
+    if (alist_iter->position == ALIST_NIL) {
+        return CSTL_ERROR_ITERATOR_END;
+    }
+
+    alist_iter->position = alist_link(list, alist_iter->position)->next;
+    iterator->current = alist_iter->position != ALIST_NIL ? alist_data(list, alist_iter->position) : NULL;
+
+    return CSTL_OK;
+}
+
+/**
+ * @brief 数组链表迭代器prev函数实现
+ *
+ * 结束迭代器后退到尾元素，与向量迭代器的行为一致，可以用于需要双向迭代的算法。
+ *
+ * @param iterator 迭代器指针
+ * @return error_code_t 错误码
+ */
+static error_code_t alist_iterator_prev(iterator_t* iterator)
+{
+    if (iterator == NULL) {
+        return CSTL_ERROR_NULL_POINTER;
+    }
+
+    alist_iterator_t* alist_iter = (alist_iterator_t*)iterator;
+    const alist_t* list = (const alist_t*)iterator->container;
+
+    uint32_t prev = alist_iter->position != ALIST_NIL ? alist_link(list, alist_iter->position)->prev : list->tail;
+    if (prev == ALIST_NIL) {
+        return CSTL_ERROR_ITERATOR_END;
+    }
+
+    alist_iter->position = prev;
+    iterator->current = alist_data(list, prev);
+
+    return CSTL_OK;
+}
+
+/**
+ * @brief 数组链表迭代器get函数实现
+ *
+ * @param iterator 迭代器指针
+ * @param data 输出参数，存储当前元素指针
+ * @return error_code_t 错误码
+ */
+static error_code_t alist_iterator_get(iterator_t* iterator, void** data)
+{
+    if (iterator == NULL || data == NULL) {
+        return CSTL_ERROR_NULL_POINTER;
+    }
+
+    alist_iterator_t* alist_iter = (alist_iterator_t*)iterator;
+
+    if (alist_iter->position == ALIST_NIL) {
+        return CSTL_ERROR_ITERATOR_END;
+    }
+
+    *data = iterator->current;
+    return CSTL_OK;
+}
+
+/**
+ * @brief 数组链表迭代器valid函数实现
+ *
+ * @param iterator 迭代器指针
+ * @return int 如果有效返回非零，否则返回零
+ */
+static int alist_iterator_valid(iterator_t* iterator)
+{
+    if (iterator == NULL) {
+        return 0;
+    }
+
+    alist_iterator_t* alist_iter = (alist_iterator_t*)iterator;
+    return alist_iter->position != ALIST_NIL;
+}
+
+/**
+ * @brief 数组链表迭代器destroy函数实现
+ *
+ * @param iterator 迭代器指针
+ */
+static void alist_iterator_destroy(iterator_t* iterator)
+{
+    /* 不需要特殊处理，迭代器将在iterator_destroy中释放 */
+    (void)iterator;
+}
+
+/**
+ * @brief 数组链表迭代器clone函数实现
+ *
+ * @param iterator 迭代器指针
+ * @return iterator_t* 克隆的迭代器指针，失败返回NULL
+ */
+static iterator_t* alist_iterator_clone(iterator_t* iterator)
+{
+    if (iterator == NULL) {
+        return NULL;
+    }
+
+    alist_iterator_t* alist_iter = (alist_iterator_t*)iterator;
+    alist_iterator_t* new_alist_iter = (alist_iterator_t*)malloc(sizeof(alist_iterator_t));
+    if (new_alist_iter == NULL) {
+        return NULL;
+    }
+
+    /* 复制基础迭代器和当前槽位 */
+    new_alist_iter->base = alist_iter->base;
+    new_alist_iter->position = alist_iter->position;
+
+    return (iterator_t*)new_alist_iter;
+}
+
+/**
+ * @brief 锁定数组链表容器（如果启用线程安全）
+ *
+ * @param list 数组链表容器指针
+ */
+static void alist_lock(alist_t* list)
+{
+    if (list != NULL && list->thread_safe) {
+        mutex_lock(&list->lock);
+    }
+}
+
+/**
+ * @brief 解锁数组链表容器（如果启用线程安全）
+ *
+ * @param list 数组链表容器指针
+ */
+static void alist_unlock(alist_t* list)
+{
+    if (list != NULL && list->thread_safe) {
+        mutex_unlock(&list->lock);
+    }
+}
+
+/**
+ * @brief 确保槽位数组至少有min_capacity个槽位
+ *
+ * 容量不足时成倍增长，增长后所有元素的地址都会改变，槽位下标不变。
+ *
+ * @param list 数组链表容器指针
+ * @param min_capacity 所需的槽位数量
+ * @return error_code_t 错误码
+ */
+static error_code_t alist_grow(alist_t* list, size_t min_capacity)
+{
+    if (min_capacity <= list->capacity) {
+        return CSTL_OK;
+    }
+
+    if (min_capacity > ALIST_MAX_SLOTS) {
+        return CSTL_ERROR_CONTAINER_FULL;
+    }
+
+    size_t new_capacity = list->capacity < ALIST_MIN_CAPACITY ? ALIST_MIN_CAPACITY : list->capacity * 2;
+    if (new_capacity < min_capacity) {
+        new_capacity = min_capacity;
+    }
+    if (new_capacity > ALIST_MAX_SLOTS) {
+        new_capacity = ALIST_MAX_SLOTS;
+    }
+    if (new_capacity > SIZE_MAX / list->slot_size) {
+        return CSTL_ERROR_OUT_OF_MEMORY;
+    }
+
+    unsigned char* new_slots = (unsigned char*)list->allocator->reallocate(list->allocator, list->slots,
+                                                                           new_capacity * list->slot_size);
+    if (new_slots == NULL) {
+        return CSTL_ERROR_OUT_OF_MEMORY;
+    }
+
+    list->slots = new_slots;
+    list->capacity = new_capacity;
+
+    return CSTL_OK;
+}
+
+/**
+ * @brief 分配一个槽位，优先复用空闲链表中的槽位
+ *
+ * @param list 数组链表容器指针
+ * @param position 输出参数，存储分配到的槽位下标
+ * @return error_code_t 错误码
+ */
+static error_code_t alist_alloc_slot(alist_t* list, uint32_t* position)
+{
+    if (list->free_head != ALIST_NIL) {
+        *position = list->free_head;
+        list->free_head = alist_link(list, *position)->next;
+        return CSTL_OK;
+    }
+
+    error_code_t result = alist_grow(list, list->used + 1);
+    if (result != CSTL_OK) {
+        return result;
+    }
+
+    *position = (uint32_t)list->used++;
+    return CSTL_OK;
+}
+
+/**
+ * @brief 把槽位链接到position之前，position为ALIST_NIL时链接到末尾
+ *
+ * @param list 数组链表容器指针
+ * @param position 链表中的槽位下标
+ * @param slot 要链接的槽位下标
+ */
+static void alist_link_before(alist_t* list, uint32_t position, uint32_t slot)
+{
+    alist_link_t* link = alist_link(list, slot);
+
+    link->next = position;
+    link->prev = position != ALIST_NIL ? alist_link(list, position)->prev : list->tail;
+
+    if (link->prev != ALIST_NIL) {
+        alist_link(list, link->prev)->next = slot;
+    } else {
+        list->head = slot;
+    }
+
+    if (position != ALIST_NIL) {
+        alist_link(list, position)->prev = slot;
+    } else {
+        list->tail = slot;
+    }
+
+    list->size++;
+}
+
+/**
+ * @brief 复制元素到新槽位，并把它链接到position之前
+ *
+ * element可以指向本链表中的元素，数组增长后按原来的偏移重新定位。
+ *
+ * @param list 数组链表容器指针
+ * @param position 链表中的槽位下标，为ALIST_NIL时链接到末尾
+ * @param element 要插入的元素指针
+ * @return error_code_t 错误码
+ */
+static error_code_t alist_insert_slot(alist_t* list, uint32_t position, const void* element)
+{
+    uintptr_t address = (uintptr_t)element;
+    uintptr_t begin = (uintptr_t)list->slots;
+    int inside = list->slots != NULL && address >= begin && address < begin + list->used * list->slot_size;
+
+    uint32_t slot;
+    error_code_t result = alist_alloc_slot(list, &slot);
+    if (result != CSTL_OK) {
+        return result;
+    }
+
+    if (inside) {
+        element = list->slots + (address - begin);
+    }
+    memcpy(alist_data(list, slot), element, list->element_size);
+    alist_link_before(list, position, slot);
+
+    return CSTL_OK;
+}
+
+/**
+ * @brief 断开槽位的链接，析构元素，并把槽位放回空闲链表
+ *
+ * @param list 数组链表容器指针
+ * @param slot 链表中的槽位下标
+ */
+static void alist_erase_slot(alist_t* list, uint32_t slot)
+{
+    alist_link_t* link = alist_link(list, slot);
+
+    if (link->prev != ALIST_NIL) {
+        alist_link(list, link->prev)->next = link->next;
+    } else {
+        list->head = link->next;
+    }
+
+    if (link->next != ALIST_NIL) {
+        alist_link(list, link->next)->prev = link->prev;
+    } else {
+        list->tail = link->prev;
+    }
+
+    list->size--;
+
+    if (list->destructor != NULL) {
+        list->destructor(alist_data(list, slot));
+    }
+
+    link->prev = ALIST_SLOT_FREE;
+    link->next = list->free_head;
+    list->free_head = slot;
+}
+
+/**
+ * @brief 获取指定索引的槽位下标，从较近的一端出发
+ *
+ * @param list 数组链表容器指针
+ * @param index 元素索引，必须小于元素数量
+ * @return uint32_t 槽位下标
+ */
+static uint32_t alist_locate(const alist_t* list, size_t index)
+{
+    uint32_t position;
+
+    if (index < list->size / 2) {
+        position = list->head;
+        for (size_t i = 0; i < index; i++) {
+            position = alist_link(list, position)->next;
+        }
+    } else {
+        position = list->tail;
+        for (size_t i = list->size - 1; i > index; i--) {
+            position = alist_link(list, position)->prev;
+        }
+    }
+
+    return position;
+}
+
+/**
+ * @brief 创建数组链表容器
+ *
+ * @param element_size 元素大小
+ * @param allocator 分配器指针，如果为NULL则使用默认分配器
+ * @param destructor 析构函数指针，移除元素时对元素调用，为NULL时不调用
+ * @return alist_t* 数组链表容器指针，失败返回NULL
+ */
+alist_t* alist_create(size_t element_size, allocator_t* allocator, destructor_fn_t destructor)
+{
+    alist_t* list = (alist_t*)malloc(sizeof(alist_t));
+    if (list == NULL) {
+        return NULL;
+    }
+
+    error_code_t result = alist_init(list, element_size, allocator);
+    if (result != CSTL_OK) {
+        free(list);
+        return NULL;
+    }
+
+    list->destructor = destructor;
+
+    return list;
+}
+
+/**
+ * @brief 销毁数组链表容器
+ *
+ * @param list 数组链表容器指针
+ */
+void alist_destroy(alist_t* list)
+{
+    if (list == NULL) {
+        return;
+    }
+
+    alist_clear(list);
+
+    if (list->slots != NULL) {
+        list->allocator->deallocate(list->allocator, list->slots);
+    }
+
+    /* 销毁互斥锁 */
+    if (list->thread_safe) {
+        mutex_destroy(&list->lock);
+    }
+
+    free(list);
+}
+
+/**
+ * @brief 初始化数组链表容器
+ *
+ * @param list 数组链表容器指针
+ * @param element_size 元素大小
+ * @param allocator 分配器指针，如果为NULL则使用默认分配器
+ * @return error_code_t 错误码
+ */
+error_code_t alist_init(alist_t* list, size_t element_size, allocator_t* allocator)
+{
+    if (list == NULL) {
+        return CSTL_ERROR_NULL_POINTER;
+    }
+
+    if (element_size == 0 || element_size > SIZE_MAX / 2) {
+        return CSTL_ERROR_INVALID_ARGUMENT;
+    }
+
+    /* 设置分配器 */
+    if (allocator == NULL) {
+        allocator = default_allocator();
+    }
+
+    list->slots = NULL;
+    list->slot_size = sizeof(alist_link_t) + ((element_size + 7) & ~(size_t)7);
+    list->capacity = 0;
+    list->used = 0;
+    list->size = 0;
+    list->head = ALIST_NIL;
+    list->tail = ALIST_NIL;
+    list->free_head = ALIST_NIL;
+    list->element_size = element_size;
+    list->allocator = allocator;
+    list->thread_safe = 0;
+    list->destructor = NULL;
+
+    return CSTL_OK;
+}
+
+/**
+ * @brief 清空数组链表容器，保留已分配的槽位数组
+ *
+ * @param list 数组链表容器指针
+ */
+void alist_clear(alist_t* list)
+{
+    if (list == NULL) {
+        return;
+    }
+
+    alist_lock(list);
+
+    if (list->destructor != NULL) {
+        for (uint32_t position = list->head; position != ALIST_NIL; position = alist_link(list, position)->next) {
+            list->destructor(alist_data(list, position));
+        }
+    }
+
+    list->used = 0;
+    list->size = 0;
+    list->head = ALIST_NIL;
+    list->tail = ALIST_NIL;
+    list->free_head = ALIST_NIL;
+
+    alist_unlock(list);
+}
+
+/**
+ * @brief 预留槽位，之后元素数量不超过capacity时插入不会移动元素
+ *
+ * @param list 数组链表容器指针
+ * @param capacity 槽位数量
+ * @return error_code_t 错误码
+ */
+error_code_t alist_reserve(alist_t* list, size_t capacity)
+{
+    if (list == NULL) {
+        return CSTL_ERROR_NULL_POINTER;
+    }
+
+    alist_lock(list);
+    error_code_t result = alist_grow(list, capacity);
+    alist_unlock(list);
+
+    return result;
+}
+
+/**
+ * @brief 按链表顺序重新排列槽位，并释放多余的容量
+ *
+ * 大量随机插入和删除之后，相邻元素可能分散在数组各处，整理后遍历重新变为顺序访问。
+ * 完成后第i个元素位于槽位i，之前的所有槽位下标失效。
+ *
+ * @param list 数组链表容器指针
+ * @return error_code_t 错误码
+ */
+error_code_t alist_compact(alist_t* list)
+{
+    if (list == NULL) {
+        return CSTL_ERROR_NULL_POINTER;
+    }
+
+    alist_lock(list);
+
+    unsigned char* new_slots = NULL;
+    if (list->size > 0) {
+        new_slots = (unsigned char*)list->allocator->allocate(list->allocator, list->size * list->slot_size);
+        if (new_slots == NULL) {
+            alist_unlock(list);
+            return CSTL_ERROR_OUT_OF_MEMORY;
+        }
+    }
+
+    /* 按链表顺序复制元素，第i个元素的前驱是i-1，后继是i+1 */
+    uint32_t index = 0;
+    for (uint32_t position = list->head; position != ALIST_NIL; position = alist_link(list, position)->next) {
+        alist_link_t* link = (alist_link_t*)(new_slots + (size_t)index * list->slot_size);
+        link->prev = index > 0 ? index - 1 : ALIST_NIL;
+        link->next = (size_t)index + 1 < list->size ? index + 1 : ALIST_NIL;
+        memcpy(link + 1, alist_data(list, position), list->element_size);
+        index++;
+    }
+
+    if (list->slots != NULL) {
+        list->allocator->deallocate(list->allocator, list->slots);
+    }
+
+    list->slots = new_slots;
+    list->capacity = list->size;
+    list->used = list->size;
+    list->head = list->size > 0 ? 0 : ALIST_NIL;
+    list->tail = list->size > 0 ? (uint32_t)(list->size - 1) : ALIST_NIL;
+    list->free_head = ALIST_NIL;
+
+    alist_unlock(list);
+    return CSTL_OK;
+}
+
+/**
+ * @brief 获取数组链表容器大小
+ *
+ * @param list 数组链表容器指针
+ * @return size_t 元素数量
+ */
+size_t alist_size(const alist_t* list)
+{
+    if (list == NULL) {
+        return 0;
+    }
+
+    return list->size;
+}
+
+/**
+ * @brief 检查数组链表容器是否为空
+ *
+ * @param list 数组链表容器指针
+ * @return int 如果为空返回非零，否则返回零
+ */
+int alist_empty(const alist_t* list)
+{
+    if (list == NULL) {
+        return 1;
+    }
+
+    return list->size == 0;
+}
+
+/**
+ * @brief 在数组链表容器前端添加元素
+ *
+ * @param list 数组链表容器指针
+ * @param element 要添加的元素指针
+ * @return error_code_t 错误码
+ */
+error_code_t alist_push_front(alist_t* list, const void* element)
+{
+    if (list == NULL || element == NULL) {
+        return CSTL_ERROR_NULL_POINTER;
+    }
+
+    alist_lock(list);
+    error_code_t result = alist_insert_slot(list, list->head, element);
+    alist_unlock(list);
+
+    return result;
+}
+
+/**
+ * @brief 在数组链表容器后端添加元素
+ *
+ * @param list 数组链表容器指针
+ * @param element 要添加的元素指针
+ * @return error_code_t 错误码
+ */
+error_code_t alist_push_back(alist_t* list, const void* element)
+{
+    if (list == NULL || element == NULL) {
+        return CSTL_ERROR_NULL_POINTER;
+    }
+
+    alist_lock(list);
+    error_code_t result = alist_insert_slot(list, ALIST_NIL, element);
+    alist_unlock(list);
+
+    return result;
+}
+
+/**
+ * @brief 移除数组链表容器前端元素
+ *
+ * @param list 数组链表容器指针
+ * @return error_code_t 错误码
+ */
+error_code_t alist_pop_front(alist_t* list)
+{
+    if (list == NULL) {
+        return CSTL_ERROR_NULL_POINTER;
+    }
+
+    alist_lock(list);
+
+    if (list->head == ALIST_NIL) {
+        alist_unlock(list);
+        return CSTL_ERROR_CONTAINER_EMPTY;
+    }
+
+    alist_erase_slot(list, list->head);
+
+    alist_unlock(list);
+    return CSTL_OK;
+}
+
+/**
+ * @brief 移除数组链表容器后端元素
+ *
+ * @param list 数组链表容器指针
+ * @return error_code_t 错误码
+ */
+error_code_t alist_pop_back(alist_t* list)
+{
+    if (list == NULL) {
+        return CSTL_ERROR_NULL_POINTER;
+    }
+
+    alist_lock(list);
+
+    if (list->tail == ALIST_NIL) {
+        alist_unlock(list);
+        return CSTL_ERROR_CONTAINER_EMPTY;
+    }
+
+    alist_erase_slot(list, list->tail);
+
+    alist_unlock(list);
+    return CSTL_OK;
+}
+
+/**
+ * @brief 获取数组链表容器前端元素
+ *
+ * @param list 数组链表容器指针
+ * @param element 输出参数，存储元素指针
+ * @return error_code_t 错误码
+ */
+error_code_t alist_front(const alist_t* list, void** element)
+{
+    if (list == NULL || element == NULL) {
+        return CSTL_ERROR_NULL_POINTER;
+    }
+
+    if (list->head == ALIST_NIL) {
+        return CSTL_ERROR_CONTAINER_EMPTY;
+    }
+
+    *element = alist_data(list, list->head);
+    return CSTL_OK;
+}
+
+/**
+ * @brief 获取数组链表容器后端元素
+ *
+ * @param list 数组链表容器指针
+ * @param element 输出参数，存储元素指针
+ * @return error_code_t 错误码
+ */
+error_code_t alist_back(const alist_t* list, void** element)
+{
+    if (list == NULL || element == NULL) {
+        return CSTL_ERROR_NULL_POINTER;
+    }
+
+    if (list->tail == ALIST_NIL) {
+        return CSTL_ERROR_CONTAINER_EMPTY;
+    }
+
+    *element = alist_data(list, list->tail);
+    return CSTL_OK;
+}
+
+/**
+ * @brief 在指定位置前插入元素
+ *
+ * @param list 数组链表容器指针
+ * @param position 插入位置的槽位下标，为ALIST_NIL时插入到后端
+ * @param element 要插入的元素指针
+ * @return error_code_t 错误码
+ */
+error_code_t alist_insert_before(alist_t* list, uint32_t position, const void* element)
+{
+    if (list == NULL || element == NULL) {
+        return CSTL_ERROR_NULL_POINTER;
+    }
+
+    alist_lock(list);
+
+    if (position != ALIST_NIL && !alist_position_valid(list, position)) {
+        alist_unlock(list);
+        return CSTL_ERROR_INVALID_INDEX;
+    }
+
+    error_code_t result = alist_insert_slot(list, position, element);
+
+    alist_unlock(list);
+    return result;
+}
+
+/**
+ * @brief 在指定位置后插入元素
+ *
+ * @param list 数组链表容器指针
+ * @param position 插入位置的槽位下标，为ALIST_NIL时插入到前端
+ * @param element 要插入的元素指针
+ * @return error_code_t 错误码
+ */
+error_code_t alist_insert_after(alist_t* list, uint32_t position, const void* element)
+{
+    if (list == NULL || element == NULL) {
+        return CSTL_ERROR_NULL_POINTER;
+    }
+
+    alist_lock(list);
+
+    if (position != ALIST_NIL && !alist_position_valid(list, position)) {
+        alist_unlock(list);
+        return CSTL_ERROR_INVALID_INDEX;
+    }
+
+    uint32_t next = position != ALIST_NIL ? alist_link(list, position)->next : list->head;
+    error_code_t result = alist_insert_slot(list, next, element);
+
+    alist_unlock(list);
+    return result;
+}
+
+/**
+ * @brief 移除指定位置元素，O(1)
+ *
+ * @param list 数组链表容器指针
+ * @param position 要移除的槽位下标
+ * @return error_code_t 错误码，position不是链表中的元素时返回CSTL_ERROR_INVALID_INDEX
+ */
+error_code_t alist_erase(alist_t* list, uint32_t position)
+{
+    if (list == NULL) {
+        return CSTL_ERROR_NULL_POINTER;
+    }
+
+    alist_lock(list);
+
+    if (!alist_position_valid(list, position)) {
+        alist_unlock(list);
+        return CSTL_ERROR_INVALID_INDEX;
+    }
+
+    alist_erase_slot(list, position);
+
+    alist_unlock(list);
+    return CSTL_OK;
+}
+
+/**
+ * @brief 移除指定元素
+ *
+ * @param list 数组链表容器指针
+ * @param element 要移除的元素指针
+ * @param comparator 比较函数指针
+ * @return error_code_t 错误码
+ */
+error_code_t alist_remove(alist_t* list, const void* element, comparator_fn_t comparator)
+{
+    if (list == NULL || element == NULL || comparator == NULL) {
+        return CSTL_ERROR_NULL_POINTER;
+    }
+
+    alist_lock(list);
+
+    uint32_t position = list->head;
+    while (position != ALIST_NIL) {
+        uint32_t next = alist_link(list, position)->next;
+        if (comparator(alist_data(list, position), element) == 0) {
+            alist_erase_slot(list, position);
+        }
+        position = next;
+    }
+
+    alist_unlock(list);
+    return CSTL_OK;
+}
+
+/**
+ * @brief 移除所有满足谓词的元素
+ *
+ * @param list 数组链表容器指针
+ * @param predicate 谓词函数指针，返回非零的元素被移除
+ * @return error_code_t 错误码
+ */
+error_code_t alist_remove_if(alist_t* list, predicate_fn_t predicate)
+{
+    if (list == NULL || predicate == NULL) {
+        return CSTL_ERROR_NULL_POINTER;
+    }
+
+    alist_lock(list);
+
+    uint32_t position = list->head;
+    while (position != ALIST_NIL) {
+        uint32_t next = alist_link(list, position)->next;
+        if (predicate(alist_data(list, position))) {
+            alist_erase_slot(list, position);
+        }
+        position = next;
+    }
+
+    alist_unlock(list);
+    return CSTL_OK;
+}
+
+/**
+ * @brief 查找指定元素
+ *
+ * @param list 数组链表容器指针
+ * @param element 要查找的元素指针
+ * @param comparator 比较函数指针
+ * @return uint32_t 找到的槽位下标，未找到返回ALIST_NIL
+ */
+uint32_t alist_find(const alist_t* list, const void* element, comparator_fn_t comparator)
+{
+    if (list == NULL || element == NULL || comparator == NULL) {
+        return ALIST_NIL;
+    }
+
+    /* 在调用比较函数之前读出后继下标，下一个槽位的加载可以与比较重叠 */
+    const unsigned char* slots = list->slots;
+    size_t slot_size = list->slot_size;
+    uint32_t position = list->head;
+
+    while (position != ALIST_NIL) {
+        const alist_link_t* link = (const alist_link_t*)(slots + (size_t)position * slot_size);
+        uint32_t next = link->next;
+        if (comparator(link + 1, element) == 0) {
+            return position;
+        }
+        position = next;
+    }
+
+    return ALIST_NIL;
+}
+
+/**
+ * @brief 获取槽位中的元素
+ *
+ * @param list 数组链表容器指针
+ * @param position 槽位下标
+ * @return void* 元素指针，position不是链表中的元素时返回NULL
+ */
+void* alist_get(const alist_t* list, uint32_t position)
+{
+    if (list == NULL || !alist_position_valid(list, position)) {
+        return NULL;
+    }
+
+    return alist_data(list, position);
+}
+
+/**
+ * @brief 获取头槽位下标
+ *
+ * @param list 数组链表容器指针
+ * @return uint32_t 头槽位下标，链表为空时返回ALIST_NIL
+ */
+uint32_t alist_head(const alist_t* list)
+{
+    return list != NULL ? list->head : ALIST_NIL;
+}
+
+/**
+ * @brief 获取尾槽位下标
+ *
+ * @param list 数组链表容器指针
+ * @return uint32_t 尾槽位下标，链表为空时返回ALIST_NIL
+ */
+uint32_t alist_tail(const alist_t* list)
+{
+    return list != NULL ? list->tail : ALIST_NIL;
+}
+
+/**
+ * @brief 获取下一个元素的槽位下标
+ *
+ * @param list 数组链表容器指针
+ * @param position 链表中的槽位下标
+ * @return uint32_t 下一个槽位下标，position是尾元素时返回ALIST_NIL
+ */
+uint32_t alist_next(const alist_t* list, uint32_t position)
+{
+    if (list == NULL || !alist_position_valid(list, position)) {
+        return ALIST_NIL;
+    }
+
+    return alist_link(list, position)->next;
+}
+
+/**
+ * @brief 获取上一个元素的槽位下标
+ *
+ * @param list 数组链表容器指针
+ * @param position 链表中的槽位下标
+ * @return uint32_t 上一个槽位下标，position是头元素时返回ALIST_NIL
+ */
+uint32_t alist_prev(const alist_t* list, uint32_t position)
+{
+    if (list == NULL || !alist_position_valid(list, position)) {
+        return ALIST_NIL;
+    }
+
+    return alist_link(list, position)->prev;
+}
+
+/**
+ * @brief 获取指定索引的元素，从较近的一端出发，O(n)
+ *
+ * @param list 数组链表容器指针
+ * @param index 元素索引
+ * @param element 输出参数，存储元素指针
+ * @return error_code_t 错误码
+ */
+error_code_t alist_at(const alist_t* list, size_t index, void** element)
+{
+    if (list == NULL || element == NULL) {
+        return CSTL_ERROR_NULL_POINTER;
+    }
+
+    if (index >= list->size) {
+        return CSTL_ERROR_INVALID_INDEX;
+    }
+
+    *element = alist_data(list, alist_locate(list, index));
+    return CSTL_OK;
+}
+
+/**
+ * @brief 设置指定索引的元素，从较近的一端出发，O(n)
+ *
+ * @param list 数组链表容器指针
+ * @param index 元素索引
+ * @param element 要设置的元素指针
+ * @return error_code_t 错误码
+ */
+error_code_t alist_set(alist_t* list, size_t index, const void* element)
+{
+    if (list == NULL || element == NULL) {
+        return CSTL_ERROR_NULL_POINTER;
+    }
+
+    alist_lock(list);
+
+    if (index >= list->size) {
+        alist_unlock(list);
+        return CSTL_ERROR_INVALID_INDEX;
+    }
+
+    void* slot = alist_data(list, alist_locate(list, index));
+    /* 先释放旧元素，element指向该元素本身时保持不变 */
+    if (slot != element) {
+        if (list->destructor != NULL) {
+            list->destructor(slot);
+        }
+        memmove(slot, element, list->element_size);
+    }
+
+    alist_unlock(list);
+    return CSTL_OK;
+}
+
+/**
+ * @brief 反转数组链表容器
+ *
+ * @param list 数组链表容器指针
+ * @return error_code_t 错误码
+ */
+error_code_t alist_reverse(alist_t* list)
+{
+    if (list == NULL) {
+        return CSTL_ERROR_NULL_POINTER;
+    }
+
+    alist_lock(list);
+
+    uint32_t position = list->head;
+    list->head = list->tail;
+    list->tail = position;
+
+    /* 交换每个槽位的前后下标 */
+    while (position != ALIST_NIL) {
+        alist_link_t* link = alist_link(list, position);
+        uint32_t temp = link->prev;
+        link->prev = link->next;
+        link->next = temp;
+        position = link->prev;
+    }
+
+    alist_unlock(list);
+    return CSTL_OK;
+}
+
+/**
+ * @brief 合并两个以ALIST_NIL结尾的有序单链，只维护后继下标
+ *
+ * 相等时取a中的槽位，a中的槽位在原链表中位于b之前，因此合并是稳定的。
+ *
+ * @param list 数组链表容器指针
+ * @param a 第一个有序段
+ * @param b 第二个有序段
+ * @param comparator 比较函数指针
+ * @return uint32_t 合并后的有序段
+ */
+static uint32_t alist_sort_merge_runs(const alist_t* list, uint32_t a, uint32_t b, comparator_fn_t comparator)
+{
+    uint32_t head = ALIST_NIL;
+    uint32_t tail = ALIST_NIL;
+
+    while (a != ALIST_NIL && b != ALIST_NIL) {
+        uint32_t taken;
+        if (comparator(alist_data(list, a), alist_data(list, b)) <= 0) {
+            taken = a;
+            a = alist_link(list, a)->next;
+        } else {
+            taken = b;
+            b = alist_link(list, b)->next;
+        }
+
+        if (tail != ALIST_NIL) {
+            alist_link(list, tail)->next = taken;
+        } else {
+            head = taken;
+        }
+        tail = taken;
+    }
+
+    uint32_t rest = a != ALIST_NIL ? a : b;
+    if (tail != ALIST_NIL) {
+        alist_link(list, tail)->next = rest;
+    } else {
+        head = rest;
+    }
+
+    return head;
+}
+
+/**
+ * @brief 排序数组链表容器
+ *
+ * 稳定排序，与list_sort相同的非递归自底向上归并，只修改槽位下标，不移动元素。
+ *
+ * @param list 数组链表容器指针
+ * @param comparator 比较函数指针
+ * @return error_code_t 错误码
+ */
+error_code_t alist_sort(alist_t* list, comparator_fn_t comparator)
+{
+    if (list == NULL || comparator == NULL) {
+        return CSTL_ERROR_NULL_POINTER;
+    }
+
+    alist_lock(list);
+
+    if (list->size < 2) {
+        alist_unlock(list);
+        return CSTL_OK;
+    }
+
+    /* 与槽位中等长的有序段逐级合并，槽位中的有序段来自更早的元素 */
+    uint32_t bins[ALIST_SORT_BINS];
+    size_t fill = 0;
+    uint32_t position = list->head;
+
+    while (position != ALIST_NIL) {
+        uint32_t carry = position;
+        position = alist_link(list, position)->next;
+        alist_link(list, carry)->next = ALIST_NIL;
+
+        size_t i = 0;
+        while (i < fill && bins[i] != ALIST_NIL) {
+            carry = alist_sort_merge_runs(list, bins[i], carry, comparator);
+            bins[i] = ALIST_NIL;
+            i++;
+        }
+        bins[i] = carry;
+        if (i == fill) {
+            fill++;
+        }
+    }
+
+    uint32_t result = ALIST_NIL;
+    for (size_t i = 0; i < fill; i++) {
+        if (bins[i] != ALIST_NIL) {
+            result = result != ALIST_NIL ? alist_sort_merge_runs(list, bins[i], result, comparator) : bins[i];
+        }
+    }
+
+    /* 恢复前驱下标和尾槽位 */
+    uint32_t prev = ALIST_NIL;
+    for (position = result; position != ALIST_NIL; position = alist_link(list, position)->next) {
+        alist_link(list, position)->prev = prev;
+        prev = position;
+    }
+    list->head = result;
+    list->tail = prev;
+
+    alist_unlock(list);
+    return CSTL_OK;
+}
+
+/**
+ * @brief 启用线程安全
+ *
+ * @param list 数组链表容器指针
+ * @return error_code_t 错误码
+ */
+error_code_t alist_enable_thread_safety(alist_t* list)
+{
+    if (list == NULL) {
+        return CSTL_ERROR_NULL_POINTER;
+    }
+
+    if (!list->thread_safe) {
+        error_code_t result = mutex_init(&list->lock);
+        if (result != CSTL_OK) {
+            return result;
+        }
+        list->thread_safe = 1;
+    }
+
+    return CSTL_OK;
+}
+
+/**
+ * @brief 禁用线程安全
+ *
+ * @param list 数组链表容器指针
+ * @return error_code_t 错误码
+ */
+error_code_t alist_disable_thread_safety(alist_t* list)
+{
+    if (list == NULL) {
+        return CSTL_ERROR_NULL_POINTER;
+    }
+
+    alist_lock(list);
+
+    if (list->thread_safe) {
+        list->thread_safe = 0;
+        mutex_unlock(&list->lock);
+        mutex_destroy(&list->lock);
+    }
+
+    return CSTL_OK;
+}
+
+/**
+ * @brief 创建数组链表容器迭代器
+ *
+ * @param list 数组链表容器指针
+ * @param direction 迭代方向
+ * @return iterator_t* 迭代器指针，失败返回NULL
+ */
+iterator_t* alist_iterator_create(alist_t* list, iter_direction_t direction)
+{
+    if (list == NULL) {
+        return NULL;
+    }
+
+    alist_iterator_t* alist_iter = (alist_iterator_t*)malloc(sizeof(alist_iterator_t));
+    if (alist_iter == NULL) {
+        return NULL;
+    }
+
+    alist_iter->base.container = list;
+    alist_iter->base.direction = direction;
+    alist_iter->base.element_size = list->element_size;
+    alist_iter->base.next = alist_iterator_next;
+    alist_iter->base.prev = alist_iterator_prev;
+    alist_iter->base.get = alist_iterator_get;
+    alist_iter->base.valid = alist_iterator_valid;
+    alist_iter->base.destroy = alist_iterator_destroy;
+    alist_iter->base.clone = alist_iterator_clone;
+
+    /* 设置初始位置 */
+    alist_iter->position = direction == ITER_DIR_FORWARD ? list->head : list->tail;
+    alist_iter->base.current = alist_iter->position != ALIST_NIL ? alist_data(list, alist_iter->position) : NULL;
+
+    return (iterator_t*)alist_iter;
+}
+
+/**
+ * @brief 获取数组链表容器起始迭代器
+ *
+ * @param list 数组链表容器指针
+ * @return iterator_t* 起始迭代器指针，失败返回NULL
+ */
+iterator_t* alist_begin(alist_t* list)
+{
+    return alist_iterator_create(list, ITER_DIR_FORWARD);
+}
+
+/**
+ * @brief 获取数组链表容器结束迭代器
+ *
+ * 结束迭代器执行prev后指向尾元素。
+ *
+ * @param list 数组链表容器指针
+ * @return iterator_t* 结束迭代器指针，失败返回NULL
+ */
+iterator_t* alist_end(alist_t* list)
+{
+    iterator_t* iterator = alist_iterator_create(list, ITER_DIR_FORWARD);
+    if (iterator == NULL) {
+        return NULL;
+    }
+
+    ((alist_iterator_t*)iterator)->position = ALIST_NIL;
+    iterator->current = NULL;
+
+    return iterator;
+}
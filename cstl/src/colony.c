@@ -0,0 +1,1113 @@
+/**
+ * @file colony.c
+ * @brief CSTL库的colony容器实现
+ *
+ * 该文件实现了CSTL库的colony容器。每个块由一次分配得到，依次存放块结构体、
+ * capacity个槽位和capacity个16位跳跃字段。
+ *
+ * 跳跃字段的约定：有元素的槽位为0；长度为L的空洞段[s, s + L - 1]在首尾两个槽位上都记录L，
+ * 段内部的值不使用。向前迭代遇到空洞时一定位于段首，向后迭代时一定位于段尾，
+ * 都可以一步跳过整段。删除时与左右相邻的空洞段合并，插入时复用某一段的段首槽位，
+ * 都只需要修改段首段尾。空洞段的段首槽位中存放空闲链表的前后链接。
+ */
+
+#include "cstl/colony.h"
+#include <stdlib.h>
+#include <string.h>
+
+/**
+ * @brief 空洞段的空闲链表链接，存放在段首槽位中
+ */
+typedef struct colony_free_link_t {
+    uint16_t prev; /**< 前一个空洞段的段首槽位 */
+    uint16_t next; /**< 后一个空洞段的段首槽位 */
+} colony_free_link_t;
+
+/**
+ * @brief colony迭代器结构体
+ */
+typedef struct colony_iterator_t {
+    iterator_t base;        /**< 基础迭代器 */
+    colony_block_t* block;  /**< 当前块，NULL表示结束位置 */
+    size_t slot;            /**< 当前槽位 */
+} colony_iterator_t;
+
+/**
+ * @brief 获取块内指定槽位的地址
+ *
+ * @param colony colony容器指针
+ * @param block 块指针
+ * @param slot 槽位
+ * @return unsigned char* 槽位地址
+ */
+static unsigned char* colony_slot(const colony_t* colony, const colony_block_t* block, size_t slot)
+{
+    return block->elements + slot * colony->slot_size;
+}
+
+/**
+ * @brief 获取空洞段段首槽位中的空闲链表链接
+ *
+ * @param colony colony容器指针
+ * @param block 块指针
+ * @param slot 段首槽位
+ * @return colony_free_link_t* 链接指针
+ */
+static colony_free_link_t* colony_free_link(const colony_t* colony, const colony_block_t* block, size_t slot)
+{
+    return (colony_free_link_t*)colony_slot(colony, block, slot);
+}
+
+/**
+ * @brief 获取块内第一个元素的槽位，块中至少有一个元素
+ *
+ * @param block 块指针
+ * @return size_t 槽位
+ */
+static size_t colony_first_slot(const colony_block_t* block)
+{
+    return block->skip[0];
+}
+
+/**
+ * @brief 设置迭代器的位置
+ *
+ * @param colony colony容器指针
+ * @param colony_iter colony迭代器指针
+ * @param block 块指针，NULL表示结束位置
+ * @param slot 槽位
+ */
+static void colony_iterator_seek(const colony_t* colony, colony_iterator_t* colony_iter,
+                                 colony_block_t* block, size_t slot)
+{
+    colony_iter->block = block;
+    colony_iter->slot = slot;
+    colony_iter->base.current = block != NULL ? colony_slot(colony, block, slot) : NULL;
+}
+
+/**
+ * @brief colony迭代器next函数实现
+ *
+ * @param iterator 迭代器指针
+ * @return error_code_t 错误码
+ */
+static error_code_t colony_iterator_next(iterator_t* iterator)
+{
+    if (iterator == NULL) {
+        return CSTL_ERROR_NULL_POINTER;
+    }
+
+    colony_iterator_t* colony_iter = (colony_iterator_t*)iterator;
+    const colony_t* colony = (const colony_t*)iterator->container;
+    colony_block_t* block = colony_iter->block;
+
+    if (block == NULL) {
+        return CSTL_ERROR_ITERATOR_END;
+    }
+
+    size_t slot = colony_iter->slot + 1;
+    if (slot < block->used) {
+        /* 最后一个使用过的槽位总是有元素，跳过空洞段后仍在块内 */
+        size_t skip = block->skip[slot];
+        colony_iter->slot = slot + skip;
+        iterator->current = (unsigned char*)iterator->current + (skip + 1) * colony->slot_size;
+        return CSTL_OK;
+    }
+
+    block = block->next;
+    colony_iterator_seek(colony, colony_iter, block, block != NULL ? colony_first_slot(block) : 0);
+    return CSTL_OK;
+}
+
+/**
+ * @brief colony迭代器prev函数实现
+ *
+ * 结束迭代器后退到最后一个元素。
+ *
+ * @param iterator 迭代器指针
+ * @return error_code_t 错误码
+ */
+static error_code_t colony_iterator_prev(iterator_t* iterator)
+{
+    if (iterator == NULL) {
+        return CSTL_ERROR_NULL_POINTER;
+    }
+
+    colony_iterator_t* colony_iter = (colony_iterator_t*)iterator;
+    const colony_t* colony = (const colony_t*)iterator->container;
+    colony_block_t* block = colony_iter->block;
+
+    if (block != NULL && colony_iter->slot > 0) {
+        size_t slot = colony_iter->slot - 1;
+        size_t skip = block->skip[slot];
+        if (skip <= slot) {
+            colony_iterator_seek(colony, colony_iter, block, slot - skip);
+            return CSTL_OK;
+        }
+    }
+
+    block = block != NULL ? block->prev : colony->tail;
+    if (block == NULL) {
+        return CSTL_ERROR_ITERATOR_END;
+    }
+
+    colony_iterator_seek(colony, colony_iter, block, block->used - 1);
+    return CSTL_OK;
+}
+
+/**
+ * @brief colony迭代器get函数实现
+ *
+ * @param iterator 迭代器指针
+ * @param data 输出参数，存储当前元素指针
+ * @return error_code_t 错误码
+ */
+static error_code_t colony_iterator_get(iterator_t* iterator, void** data)
+{
+    if (iterator == NULL || data == NULL) {
+        return CSTL_ERROR_NULL_POINTER;
+    }
+
+    colony_iterator_t* colony_iter = (colony_iterator_t*)iterator;
+
+    if (colony_iter->block == NULL) {
+        return CSTL_ERROR_ITERATOR_END;
+    }
+
+    *data = iterator->current;
+    return CSTL_OK;
+}
+
+/**
+ * @brief colony迭代器valid函数实现
+ *
+ * @param iterator 迭代器指针
+ * @return int 如果有效返回非零，否则返回零
+ */
+static int colony_iterator_valid(iterator_t* iterator)
+{
+    if (iterator == NULL) {
+        return 0;
+    }
+
+    colony_iterator_t* colony_iter = (colony_iterator_t*)iterator;
+    return colony_iter->block != NULL;
+}
+
+/**
+ * @brief colony迭代器destroy函数实现
+ *
+ * @param iterator 迭代器指针
+ */
+static void colony_iterator_destroy(iterator_t* iterator)
+{
+    /* 不需要特殊处理，迭代器将在iterator_destroy中释放 */
+    (void)iterator;
+}
+
+/**
+ * @brief colony迭代器clone函数实现
+ *
+ * @param iterator 迭代器指针
+ * @return iterator_t* 克隆的迭代器指针，失败返回NULL
+ */
+static iterator_t* colony_iterator_clone(iterator_t* iterator)
+{
+    if (iterator == NULL) {
+        return NULL;
+    }
+
+    colony_iterator_t* colony_iter = (colony_iterator_t*)iterator;
+    colony_iterator_t* new_colony_iter = (colony_iterator_t*)malloc(sizeof(colony_iterator_t));
+    if (new_colony_iter == NULL) {
+        return NULL;
+    }
+
+    /* 复制基础迭代器和当前位置 */
+    new_colony_iter->base = colony_iter->base;
+    new_colony_iter->block = colony_iter->block;
+    new_colony_iter->slot = colony_iter->slot;
+
+    return (iterator_t*)new_colony_iter;
+}
+
+/**
+ * @brief 锁定colony容器（如果启用线程安全）
+ *
+ * @param colony colony容器指针
+ */
+static void colony_lock(colony_t* colony)
+{
+    if (colony != NULL && colony->thread_safe) {
+        mutex_lock(&colony->lock);
+    }
+}
+
+/**
+ * @brief 解锁colony容器（如果启用线程安全）
+ *
+ * @param colony colony容器指针
+ */
+static void colony_unlock(colony_t* colony)
+{
+    if (colony != NULL && colony->thread_safe) {
+        mutex_unlock(&colony->lock);
+    }
+}
+
+/**
+ * @brief 在块表中查找槽位数组地址不大于address的最后一个块的位置
+ *
+ * @param colony colony容器指针
+ * @param address 地址
+ * @return size_t 块表中的位置加1，为0表示所有块的地址都大于address
+ */
+static size_t colony_table_upper(const colony_t* colony, const unsigned char* address)
+{
+    size_t low = 0;
+    size_t high = colony->block_count;
+
+    while (low < high) {
+        size_t mid = low + (high - low) / 2;
+        if (colony->blocks[mid]->elements <= address) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+
+    return low;
+}
+
+/**
+ * @brief 由元素指针找到所在的块和槽位
+ *
+ * @param colony colony容器指针
+ * @param element 元素指针
+ * @param slot 输出参数，存储槽位
+ * @return colony_block_t* 块指针，element不是容器中的元素时返回NULL
+ */
+static colony_block_t* colony_find_block(const colony_t* colony, const void* element, size_t* slot)
+{
+    const unsigned char* address = (const unsigned char*)element;
+    size_t position = colony_table_upper(colony, address);
+    if (position == 0) {
+        return NULL;
+    }
+
+    colony_block_t* block = colony->blocks[position - 1];
+    size_t offset = (size_t)(address - block->elements);
+    if (offset % colony->slot_size != 0) {
+        return NULL;
+    }
+
+    size_t index = offset / colony->slot_size;
+    if (index >= block->used || block->skip[index] != 0) {
+        return NULL;
+    }
+
+    *slot = index;
+    return block;
+}
+
+/**
+ * @brief 把块加入块表
+ *
+ * @param colony colony容器指针
+ * @param block 块指针
+ * @return error_code_t 错误码
+ */
+static error_code_t colony_table_add(colony_t* colony, colony_block_t* block)
+{
+    if (colony->block_count == colony->block_table_capacity) {
+        size_t new_capacity = colony->block_table_capacity > 0 ? colony->block_table_capacity * 2 : 8;
+        colony_block_t** blocks = (colony_block_t**)colony->allocator->reallocate(
+            colony->allocator, colony->blocks, new_capacity * sizeof(colony_block_t*));
+        if (blocks == NULL) {
+            return CSTL_ERROR_OUT_OF_MEMORY;
+        }
+        colony->blocks = blocks;
+        colony->block_table_capacity = new_capacity;
+    }
+
+    size_t position = colony_table_upper(colony, block->elements);
+    memmove(&colony->blocks[position + 1], &colony->blocks[position],
+            (colony->block_count - position) * sizeof(colony_block_t*));
+    colony->blocks[position] = block;
+    colony->block_count++;
+
+    return CSTL_OK;
+}
+
+/**
+ * @brief 把块从块表中移除
+ *
+ * @param colony colony容器指针
+ * @param block 块指针
+ */
+static void colony_table_remove(colony_t* colony, colony_block_t* block)
+{
+    size_t position = colony_table_upper(colony, block->elements) - 1;
+    memmove(&colony->blocks[position], &colony->blocks[position + 1],
+            (colony->block_count - position - 1) * sizeof(colony_block_t*));
+    colony->block_count--;
+}
+
+/**
+ * @brief 把块加入有空洞的块链表
+ *
+ * @param colony colony容器指针
+ * @param block 块指针
+ */
+static void colony_erased_push(colony_t* colony, colony_block_t* block)
+{
+    block->prev_erased = NULL;
+    block->next_erased = colony->erased_head;
+    if (colony->erased_head != NULL) {
+        colony->erased_head->prev_erased = block;
+    }
+    colony->erased_head = block;
+}
+
+/**
+ * @brief 把块从有空洞的块链表中移除
+ *
+ * @param colony colony容器指针
+ * @param block 块指针
+ */
+static void colony_erased_unlink(colony_t* colony, colony_block_t* block)
+{
+    if (block->prev_erased != NULL) {
+        block->prev_erased->next_erased = block->next_erased;
+    } else {
+        colony->erased_head = block->next_erased;
+    }
+    if (block->next_erased != NULL) {
+        block->next_erased->prev_erased = block->prev_erased;
+    }
+    block->prev_erased = NULL;
+    block->next_erased = NULL;
+}
+
+/**
+ * @brief 把段首为slot的空洞段加入块的空闲链表，块原来没有空洞时加入有空洞的块链表
+ *
+ * @param colony colony容器指针
+ * @param block 块指针
+ * @param slot 段首槽位
+ */
+static void colony_run_link(colony_t* colony, colony_block_t* block, size_t slot)
+{
+    colony_free_link_t* link = colony_free_link(colony, block, slot);
+    link->prev = COLONY_NO_SLOT;
+    link->next = block->free_head;
+
+    if (block->free_head != COLONY_NO_SLOT) {
+        colony_free_link(colony, block, block->free_head)->prev = (uint16_t)slot;
+    } else {
+        colony_erased_push(colony, block);
+    }
+    block->free_head = (uint16_t)slot;
+}
+
+/**
+ * @brief 把段首为slot的空洞段从块的空闲链表中移除，块不再有空洞时移出有空洞的块链表
+ *
+ * @param colony colony容器指针
+ * @param block 块指针
+ * @param slot 段首槽位
+ */
+static void colony_run_unlink(colony_t* colony, colony_block_t* block, size_t slot)
+{
+    colony_free_link_t* link = colony_free_link(colony, block, slot);
+
+    if (link->prev != COLONY_NO_SLOT) {
+        colony_free_link(colony, block, link->prev)->next = link->next;
+    } else {
+        block->free_head = link->next;
+    }
+    if (link->next != COLONY_NO_SLOT) {
+        colony_free_link(colony, block, link->next)->prev = link->prev;
+    }
+
+    if (block->free_head == COLONY_NO_SLOT) {
+        colony_erased_unlink(colony, block);
+    }
+}
+
+/**
+ * @brief 取得一个空块并链接到遍历顺序的末尾，优先使用备用块
+ *
+ * @param colony colony容器指针
+ * @return colony_block_t* 块指针，失败返回NULL
+ */
+static colony_block_t* colony_new_block(colony_t* colony)
+{
+    colony_block_t* block = colony->spare;
+
+    if (block != NULL) {
+        colony->spare = NULL;
+    } else {
+        size_t capacity = colony->capacity;
+        if (capacity < colony->min_block_capacity) {
+            capacity = colony->min_block_capacity;
+        }
+        if (capacity > colony->max_block_capacity) {
+            capacity = colony->max_block_capacity;
+        }
+
+        /* 块结构体之后按8字节对齐依次存放槽位和跳跃字段 */
+        size_t header = (sizeof(colony_block_t) + 7) & ~(size_t)7;
+        size_t bytes = header + capacity * colony->slot_size + capacity * sizeof(uint16_t);
+        block = (colony_block_t*)colony->allocator->allocate(colony->allocator, bytes);
+        if (block == NULL) {
+            return NULL;
+        }
+
+        block->elements = (unsigned char*)block + header;
+        block->skip = (uint16_t*)(block->elements + capacity * colony->slot_size);
+        block->capacity = capacity;
+
+        if (colony_table_add(colony, block) != CSTL_OK) {
+            colony->allocator->deallocate(colony->allocator, block);
+            return NULL;
+        }
+        colony->capacity += capacity;
+    }
+
+    block->used = 0;
+    block->size = 0;
+    block->free_head = COLONY_NO_SLOT;
+    block->prev_erased = NULL;
+    block->next_erased = NULL;
+
+    block->next = NULL;
+    block->prev = colony->tail;
+    if (colony->tail != NULL) {
+        colony->tail->next = block;
+    } else {
+        colony->head = block;
+    }
+    colony->tail = block;
+
+    return block;
+}
+
+/**
+ * @brief 释放块，不析构其中的元素
+ *
+ * @param colony colony容器指针
+ * @param block 块指针
+ */
+static void colony_free_block(colony_t* colony, colony_block_t* block)
+{
+    colony_table_remove(colony, block);
+    colony->capacity -= block->capacity;
+    colony->allocator->deallocate(colony->allocator, block);
+}
+
+/**
+ * @brief 把已经没有元素的块从遍历顺序中断开，作为备用块保留或释放
+ *
+ * @param colony colony容器指针
+ * @param block 块指针
+ */
+static void colony_retire_block(colony_t* colony, colony_block_t* block)
+{
+    if (block->free_head != COLONY_NO_SLOT) {
+        colony_erased_unlink(colony, block);
+        block->free_head = COLONY_NO_SLOT;
+    }
+    /* 备用块仍在查找表中，清空used使指向它的旧指针不再被当作元素 */
+    block->used = 0;
+
+    if (block->prev != NULL) {
+        block->prev->next = block->next;
+    } else {
+        colony->head = block->next;
+    }
+    if (block->next != NULL) {
+        block->next->prev = block->prev;
+    } else {
+        colony->tail = block->prev;
+    }
+
+    /* 保留容量较大的块作为备用块 */
+    if (colony->spare == NULL) {
+        colony->spare = block;
+    } else if (colony->spare->capacity < block->capacity) {
+        colony_free_block(colony, colony->spare);
+        colony->spare = block;
+    } else {
+        colony_free_block(colony, block);
+    }
+}
+
+/**
+ * @brief 删除块内指定槽位的元素（调用者持有锁）
+ *
+ * @param colony colony容器指针
+ * @param block 块指针
+ * @param slot 槽位，必须有元素
+ */
+static void colony_erase_slot(colony_t* colony, colony_block_t* block, size_t slot)
+{
+    if (colony->destructor != NULL) {
+        colony->destructor(colony_slot(colony, block, slot));
+    }
+
+    colony->size--;
+    block->size--;
+
+    if (block->size == 0) {
+        colony_retire_block(colony, block);
+        return;
+    }
+
+    uint16_t* skip = block->skip;
+    size_t left = slot > 0 ? skip[slot - 1] : 0;
+
+    if (slot == block->used - 1) {
+        /* 删除最后一个使用过的槽位时收缩used，并去掉紧邻的空洞段，保持最后一个槽位有元素 */
+        block->used = slot;
+        if (left > 0) {
+            colony_run_unlink(colony, block, slot - left);
+            block->used -= left;
+        }
+        return;
+    }
+
+    size_t right = skip[slot + 1];
+
+    if (left > 0 && right > 0) {
+        /* 左右两段合并，保留左段的链接；段内槽位也要非0，才不会被当作元素 */
+        colony_run_unlink(colony, block, slot + 1);
+        size_t length = left + 1 + right;
+        skip[slot - left] = (uint16_t)length;
+        skip[slot + right] = (uint16_t)length;
+        skip[slot] = 1;
+    } else if (left > 0) {
+        skip[slot - left] = (uint16_t)(left + 1);
+        skip[slot] = (uint16_t)(left + 1);
+    } else if (right > 0) {
+        /* 段首左移到slot */
+        colony_run_unlink(colony, block, slot + 1);
+        skip[slot] = (uint16_t)(right + 1);
+        skip[slot + right] = (uint16_t)(right + 1);
+        colony_run_link(colony, block, slot);
+    } else {
+        skip[slot] = 1;
+        colony_run_link(colony, block, slot);
+    }
+}
+
+/**
+ * @brief 创建colony容器
+ *
+ * @param element_size 元素大小
+ * @param allocator 分配器指针，如果为NULL则使用默认分配器
+ * @param destructor 析构函数指针，删除元素时对元素调用，为NULL时不调用
+ * @return colony_t* colony容器指针，失败返回NULL
+ */
+colony_t* colony_create(size_t element_size, allocator_t* allocator, destructor_fn_t destructor)
+{
+    colony_t* colony = (colony_t*)malloc(sizeof(colony_t));
+    if (colony == NULL) {
+        return NULL;
+    }
+
+    error_code_t result = colony_init(colony, element_size, allocator);
+    if (result != CSTL_OK) {
+        free(colony);
+        return NULL;
+    }
+
+    colony->destructor = destructor;
+
+    return colony;
+}
+
+/**
+ * @brief 销毁colony容器
+ *
+ * @param colony colony容器指针
+ */
+void colony_destroy(colony_t* colony)
+{
+    if (colony == NULL) {
+        return;
+    }
+
+    colony_clear(colony);
+
+    /* 销毁互斥锁 */
+    if (colony->thread_safe) {
+        mutex_destroy(&colony->lock);
+    }
+
+    free(colony);
+}
+
+/**
+ * @brief 初始化colony容器
+ *
+ * @param colony colony容器指针
+ * @param element_size 元素大小
+ * @param allocator 分配器指针，如果为NULL则使用默认分配器
+ * @return error_code_t 错误码
+ */
+error_code_t colony_init(colony_t* colony, size_t element_size, allocator_t* allocator)
+{
+    if (colony == NULL) {
+        return CSTL_ERROR_NULL_POINTER;
+    }
+
+    if (element_size == 0 || element_size > (SIZE_MAX - 7) / COLONY_BLOCK_CAPACITY_LIMIT) {
+        return CSTL_ERROR_INVALID_ARGUMENT;
+    }
+
+    /* 设置分配器 */
+    if (allocator == NULL) {
+        allocator = default_allocator();
+    }
+
+    /* 槽位至少能放下空闲链表链接 */
+    size_t slot_size = element_size < sizeof(colony_free_link_t) ? sizeof(colony_free_link_t) : element_size;
+
+    colony->head = NULL;
+    colony->tail = NULL;
+    colony->erased_head = NULL;
+    colony->spare = NULL;
+    colony->blocks = NULL;
+    colony->block_count = 0;
+    colony->block_table_capacity = 0;
+    colony->size = 0;
+    colony->capacity = 0;
+    colony->element_size = element_size;
+    colony->slot_size = (slot_size + 7) & ~(size_t)7;
+    colony->min_block_capacity = COLONY_DEFAULT_MIN_BLOCK_CAPACITY;
+    colony->max_block_capacity = COLONY_DEFAULT_MAX_BLOCK_CAPACITY;
+    colony->allocator = allocator;
+    colony->thread_safe = 0;
+    colony->destructor = NULL;
+
+    return CSTL_OK;
+}
+
+/**
+ * @brief 设置块容量的范围
+ *
+ * @param colony colony容器指针
+ * @param min_capacity 块的最小容量，不小于2
+ * @param max_capacity 块的最大容量，不小于min_capacity，不大于COLONY_BLOCK_CAPACITY_LIMIT
+ * @return error_code_t 错误码
+ */
+error_code_t colony_set_block_capacity(colony_t* colony, size_t min_capacity, size_t max_capacity)
+{
+    if (colony == NULL) {
+        return CSTL_ERROR_NULL_POINTER;
+    }
+
+    if (min_capacity < 2 || min_capacity > max_capacity || max_capacity > COLONY_BLOCK_CAPACITY_LIMIT) {
+        return CSTL_ERROR_INVALID_ARGUMENT;
+    }
+
+    colony_lock(colony);
+    colony->min_block_capacity = min_capacity;
+    colony->max_block_capacity = max_capacity;
+    colony_unlock(colony);
+
+    return CSTL_OK;
+}
+
+/**
+ * @brief 清空colony容器，释放所有块
+ *
+ * @param colony colony容器指针
+ */
+void colony_clear(colony_t* colony)
+{
+    if (colony == NULL) {
+        return;
+    }
+
+    colony_lock(colony);
+
+    for (colony_block_t* block = colony->head; block != NULL; block = block->next) {
+        if (colony->destructor == NULL) {
+            break;
+        }
+        for (size_t slot = colony_first_slot(block); slot < block->used; slot++) {
+            slot += block->skip[slot];
+            colony->destructor(colony_slot(colony, block, slot));
+        }
+    }
+
+    for (size_t i = 0; i < colony->block_count; i++) {
+        colony->allocator->deallocate(colony->allocator, colony->blocks[i]);
+    }
+    if (colony->blocks != NULL) {
+        colony->allocator->deallocate(colony->allocator, colony->blocks);
+    }
+
+    colony->head = NULL;
+    colony->tail = NULL;
+    colony->erased_head = NULL;
+    colony->spare = NULL;
+    colony->blocks = NULL;
+    colony->block_count = 0;
+    colony->block_table_capacity = 0;
+    colony->size = 0;
+    colony->capacity = 0;
+
+    colony_unlock(colony);
+}
+
+/**
+ * @brief 获取colony容器大小
+ *
+ * @param colony colony容器指针
+ * @return size_t 元素数量
+ */
+size_t colony_size(const colony_t* colony)
+{
+    if (colony == NULL) {
+        return 0;
+    }
+
+    return colony->size;
+}
+
+/**
+ * @brief 检查colony容器是否为空
+ *
+ * @param colony colony容器指针
+ * @return int 如果为空返回非零，否则返回零
+ */
+int colony_empty(const colony_t* colony)
+{
+    if (colony == NULL) {
+        return 1;
+    }
+
+    return colony->size == 0;
+}
+
+/**
+ * @brief 获取colony容器的槽位总数
+ *
+ * @param colony colony容器指针
+ * @return size_t 槽位总数
+ */
+size_t colony_capacity(const colony_t* colony)
+{
+    if (colony == NULL) {
+        return 0;
+    }
+
+    return colony->capacity;
+}
+
+/**
+ * @brief 插入元素
+ *
+ * @param colony colony容器指针
+ * @param element 要插入的元素指针
+ * @param inserted 输出参数，存储新元素的指针，可以为NULL
+ * @return error_code_t 错误码
+ */
+error_code_t colony_insert(colony_t* colony, const void* element, void** inserted)
+{
+    if (colony == NULL || element == NULL) {
+        return CSTL_ERROR_NULL_POINTER;
+    }
+
+    colony_lock(colony);
+
+    colony_block_t* block = colony->erased_head;
+    size_t slot;
+
+    if (block != NULL) {
+        /* 复用第一个空洞段的段首，剩余部分成为新的一段 */
+        slot = block->free_head;
+        size_t length = block->skip[slot];
+        colony_run_unlink(colony, block, slot);
+        block->skip[slot] = 0;
+        if (length > 1) {
+            block->skip[slot + 1] = (uint16_t)(length - 1);
+            block->skip[slot + length - 1] = (uint16_t)(length - 1);
+            colony_run_link(colony, block, slot + 1);
+        }
+    } else {
+        block = colony->tail;
+        if (block == NULL || block->used == block->capacity) {
+            block = colony_new_block(colony);
+            if (block == NULL) {
+                colony_unlock(colony);
+                return CSTL_ERROR_OUT_OF_MEMORY;
+            }
+        }
+        slot = block->used++;
+        block->skip[slot] = 0;
+    }
+
+    unsigned char* target = colony_slot(colony, block, slot);
+    memcpy(target, element, colony->element_size);
+    block->size++;
+    colony->size++;
+
+    colony_unlock(colony);
+
+    if (inserted != NULL) {
+        *inserted = target;
+    }
+    return CSTL_OK;
+}
+
+/**
+ * @brief 删除元素
+ *
+ * @param colony colony容器指针
+ * @param element 元素指针
+ * @return error_code_t 错误码，element不是容器中的元素时返回CSTL_ERROR_INVALID_ARGUMENT
+ */
+error_code_t colony_erase(colony_t* colony, void* element)
+{
+    if (colony == NULL || element == NULL) {
+        return CSTL_ERROR_NULL_POINTER;
+    }
+
+    colony_lock(colony);
+
+    size_t slot;
+    colony_block_t* block = colony_find_block(colony, element, &slot);
+    if (block == NULL) {
+        colony_unlock(colony);
+        return CSTL_ERROR_INVALID_ARGUMENT;
+    }
+
+    colony_erase_slot(colony, block, slot);
+
+    colony_unlock(colony);
+    return CSTL_OK;
+}
+
+/**
+ * @brief 删除迭代器指向的元素，并把迭代器移到下一个元素
+ *
+ * @param colony colony容器指针
+ * @param iterator colony迭代器指针
+ * @return error_code_t 错误码
+ */
+error_code_t colony_erase_at(colony_t* colony, iterator_t* iterator)
+{
+    if (colony == NULL || iterator == NULL) {
+        return CSTL_ERROR_NULL_POINTER;
+    }
+
+    if (iterator->container != colony || iterator->next != colony_iterator_next) {
+        return CSTL_ERROR_INVALID_ARGUMENT;
+    }
+
+    colony_lock(colony);
+
+    colony_iterator_t* colony_iter = (colony_iterator_t*)iterator;
+    colony_block_t* block = colony_iter->block;
+    size_t slot = colony_iter->slot;
+    if (block == NULL) {
+        colony_unlock(colony);
+        return CSTL_ERROR_ITERATOR_END;
+    }
+
+    /* 先前进再删除：下一个元素的位置不受删除影响，块被释放时迭代器已经在下一个块中 */
+    colony_iterator_next(iterator);
+    colony_erase_slot(colony, block, slot);
+
+    colony_unlock(colony);
+    return CSTL_OK;
+}
+
+/**
+ * @brief 删除所有满足谓词的元素
+ *
+ * @param colony colony容器指针
+ * @param predicate 谓词函数指针，返回非零的元素被删除
+ * @return size_t 删除的元素数量
+ */
+size_t colony_remove_if(colony_t* colony, predicate_fn_t predicate)
+{
+    if (colony == NULL || predicate == NULL) {
+        return 0;
+    }
+
+    colony_lock(colony);
+
+    size_t removed = 0;
+    colony_block_t* block = colony->head;
+
+    while (block != NULL) {
+        colony_block_t* next = block->next;
+        size_t slot = colony_first_slot(block);
+
+        /* 删除可能收缩used或释放块，先取得下一个位置 */
+        while (block != NULL && slot < block->used) {
+            size_t following = slot + 1;
+            if (following < block->used) {
+                following += block->skip[following];
+            }
+
+            if (predicate(colony_slot(colony, block, slot))) {
+                int last = block->size == 1;
+                colony_erase_slot(colony, block, slot);
+                removed++;
+                if (last) {
+                    break;
+                }
+            }
+            slot = following;
+        }
+
+        block = next;
+    }
+
+    colony_unlock(colony);
+    return removed;
+}
+
+/**
+ * @brief 检查指针是否指向容器中的元素
+ *
+ * @param colony colony容器指针
+ * @param element 元素指针
+ * @return int 如果是容器中的元素返回非零，否则返回零
+ */
+int colony_contains(const colony_t* colony, const void* element)
+{
+    if (colony == NULL || element == NULL) {
+        return 0;
+    }
+
+    colony_t* mutable_colony = (colony_t*)colony;
+    colony_lock(mutable_colony);
+
+    size_t slot;
+    int found = colony_find_block(colony, element, &slot) != NULL;
+
+    colony_unlock(mutable_colony);
+    return found;
+}
+
+/**
+ * @brief 启用线程安全
+ *
+ * @param colony colony容器指针
+ * @return error_code_t 错误码
+ */
+error_code_t colony_enable_thread_safety(colony_t* colony)
+{
+    if (colony == NULL) {
+        return CSTL_ERROR_NULL_POINTER;
+    }
+
+    if (!colony->thread_safe) {
+        error_code_t result = mutex_init(&colony->lock);
+        if (result != CSTL_OK) {
+            return result;
+        }
+        colony->thread_safe = 1;
+    }
+
+    return CSTL_OK;
+}
+
+/**
+ * @brief 禁用线程安全
+ *
+ * @param colony colony容器指针
+ * @return error_code_t 错误码
+ */
+error_code_t colony_disable_thread_safety(colony_t* colony)
+{
+    if (colony == NULL) {
+        return CSTL_ERROR_NULL_POINTER;
+    }
+
+    colony_lock(colony);
+
+    if (colony->thread_safe) {
+        colony->thread_safe = 0;
+        mutex_unlock(&colony->lock);
+        mutex_destroy(&colony->lock);
+    }
+
+    return CSTL_OK;
+}
+
+/**
+ * @brief 创建colony容器迭代器
+ *
+ * @param colony colony容器指针
+ * @param direction 迭代方向
+ * @return iterator_t* 迭代器指针，失败返回NULL
+ */
+iterator_t* colony_iterator_create(colony_t* colony, iter_direction_t direction)
+{
+    if (colony == NULL) {
+        return NULL;
+    }
+
+    colony_iterator_t* colony_iter = (colony_iterator_t*)malloc(sizeof(colony_iterator_t));
+    if (colony_iter == NULL) {
+        return NULL;
+    }
+
+    colony_iter->base.container = colony;
+    colony_iter->base.direction = direction;
+    colony_iter->base.element_size = colony->element_size;
+    colony_iter->base.next = colony_iterator_next;
+    colony_iter->base.prev = colony_iterator_prev;
+    colony_iter->base.get = colony_iterator_get;
+    colony_iter->base.valid = colony_iterator_valid;
+    colony_iter->base.destroy = colony_iterator_destroy;
+    colony_iter->base.clone = colony_iterator_clone;
+
+    /* 设置初始位置 */
+    if (direction == ITER_DIR_FORWARD) {
+        colony_block_t* head = colony->head;
+        colony_iterator_seek(colony, colony_iter, head, head != NULL ? colony_first_slot(head) : 0);
+    } else {
+        colony_block_t* tail = colony->tail;
+        colony_iterator_seek(colony, colony_iter, tail, tail != NULL ? tail->used - 1 : 0);
+    }
+
+    return (iterator_t*)colony_iter;
+}
+
+/**
+ * @brief 获取colony容器起始迭代器
+ *
+ * @param colony colony容器指针
+ * @return iterator_t* 起始迭代器指针，失败返回NULL
+ */
+iterator_t* colony_begin(colony_t* colony)
+{
+    return colony_iterator_create(colony, ITER_DIR_FORWARD);
+}
+
+/**
+ * @brief 获取colony容器结束迭代器
+ *
+ * @param colony colony容器指针
+ * @return iterator_t* 结束迭代器指针，失败返回NULL
+ */
+iterator_t* colony_end(colony_t* colony)
+{
+    iterator_t* iterator = colony_iterator_create(colony, ITER_DIR_FORWARD);
+    if (iterator == NULL) {
+        return NULL;
+    }
+
+    colony_iterator_seek(colony, (colony_iterator_t*)iterator, NULL, 0);
+
+    return iterator;
+}
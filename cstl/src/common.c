@@ -124,6 +124,7 @@ static const char* g_error_strings[] = {
     "\xe5\x85\x83\xe7\xb4\xa0\xe6\x9c\xaa\xe6\x89\xbe\xe5\x88\xb0",                  /* CSTL_ERROR_NOT_FOUND */
     "\xe5\x85\x83\xe7\xb4\xa0\xe5\xb7\xb2\xe5\xad\x98\xe5\x9c\xa8",                  /* CSTL_ERROR_ALREADY_EXISTS */
     "\xe6\x97\xa0\xe6\x95\x88\xe5\x8f\x82\xe6\x95\xb0",                    /* CSTL_ERROR_INVALID_ARGUMENT */
+    "\xe6\x96\x87\xe4\xbb\xb6\xe8\xaf\xbb\xe5\x86\x99\xe5\xa4\xb1\xe8\xb4\xa5",                    /* CSTL_ERROR_IO */
     "\xe6\x9c\xaa\xe7\x9f\xa5\xe9\x94\x99\xe8\xaf\xaf"                     /* CSTL_ERROR_UNKNOWN */
 };
 
@@ -0,0 +1,753 @@
+/**
+ * @file external_sort.c
+ * @brief CSTL库的外部排序实现
+ *
+ * 有序段保存在同一个临时文件中，用(偏移, 记录数)描述。
+ * 内存中的分块排序和文件上的多路归并共用同一个败者树归并过程，
+ * 读者可以是内存中的一段记录，也可以是文件中的一个有序段。
+ * 临时文件关闭stdio缓冲，所有读写都直接使用预算内的大块缓冲区。
+ */
+
+#if !defined(_WIN32) && !defined(_WIN64)
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE
+#endif
+#define _FILE_OFFSET_BITS 64
+#endif
+
+#include "cstl/external_sort.h"
+#include "cstl/thread_pool.h"
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#if !defined(_WIN32) && !defined(_WIN64)
+#include <sys/types.h>
+#endif
+
+/**
+ * @brief 默认内存预算
+ */
+#define EXTERNAL_SORT_DEFAULT_BUDGET (64u * 1024 * 1024)
+
+/**
+ * @brief 默认的每路最小缓冲区
+ */
+#define EXTERNAL_SORT_DEFAULT_MIN_BUFFER (1024u * 1024)
+
+/**
+ * @brief 形成有序段时写缓冲区占内存预算的比例（1/N）
+ */
+#define EXTERNAL_SORT_WRITE_SHARE 16
+
+/**
+ * @brief 并行排序时每个分块的最少记录数
+ */
+#define EXTERNAL_SORT_MIN_CHUNK 16384
+
+/**
+ * @brief 临时文件路径的最大长度
+ */
+#define EXTERNAL_SORT_PATH_MAX 1024
+
+/**
+ * @brief 有序段
+ */
+typedef struct {
+    uint64_t offset;        /**< 在临时文件中的字节偏移 */
+    uint64_t count;         /**< 记录数量 */
+} ext_run_t;
+
+/**
+ * @brief 临时文件
+ */
+typedef struct {
+    FILE* file;                             /**< 文件指针 */
+    char path[EXTERNAL_SORT_PATH_MAX];      /**< 文件路径，tmpfile()创建时为空串 */
+    uint64_t size;                          /**< 已写入的字节数 */
+} ext_temp_t;
+
+/**
+ * @brief 归并的一路输入
+ */
+typedef struct {
+    FILE* file;             /**< 所在文件，内存中的记录为NULL */
+    uint64_t offset;        /**< 下一次读取的文件偏移 */
+    uint64_t remaining;     /**< 文件中尚未读入缓冲区的记录数量 */
+    char* buffer;           /**< 读缓冲区 */
+    size_t capacity;        /**< 读缓冲区可容纳的记录数量 */
+    char* head;             /**< 当前记录，取完为NULL */
+    char* end;              /**< 缓冲区中有效记录的末尾 */
+} ext_reader_t;
+
+/**
+ * @brief 带缓冲的顺序写出
+ */
+typedef struct {
+    FILE* file;             /**< 目标文件 */
+    char* buffer;           /**< 写缓冲区 */
+    size_t capacity;        /**< 写缓冲区字节数 */
+    size_t used;            /**< 已缓冲的字节数 */
+    uint64_t written;       /**< 已写出的字节数（含缓冲区） */
+    int failed;             /**< 是否写入失败 */
+} ext_writer_t;
+
+/**
+ * @brief 定位到文件的指定偏移
+ *
+ * @param file 文件指针
+ * @param offset 字节偏移
+ * @return int 成功返回0
+ */
+static int ext_seek(FILE* file, uint64_t offset)
+{
+#if defined(_WIN32) || defined(_WIN64)
+    return _fseeki64(file, (__int64)offset, SEEK_SET);
+#else
+    return fseeko(file, (off_t)offset, SEEK_SET);
+#endif
+}
+
+/**
+ * @brief 创建临时文件
+ *
+ * @param temp 临时文件
+ * @param temp_dir 临时文件目录，为NULL时使用tmpfile()
+ * @return error_code_t 错误码
+ */
+static error_code_t ext_temp_open(ext_temp_t* temp, const char* temp_dir)
+{
+    static unsigned int sequence = 0;
+
+    memset(temp, 0, sizeof(*temp));
+    if (temp_dir == NULL) {
+        temp->file = tmpfile();
+    } else {
+        unsigned long stamp = (unsigned long)time(NULL) ^ (unsigned long)(uintptr_t)temp;
+        for (int attempt = 0; attempt < 16 && temp->file == NULL; attempt++) {
+            snprintf(temp->path, sizeof(temp->path), "%s/cstl_sort_%lx_%u.tmp",
+                     temp_dir, stamp, sequence++);
+            /* 只创建不存在的文件，避免覆盖 */
+            FILE* probe = fopen(temp->path, "rb");
+            if (probe != NULL) {
+                fclose(probe);
+                continue;
+            }
+            temp->file = fopen(temp->path, "w+b");
+        }
+    }
+
+    if (temp->file == NULL) {
+        temp->path[0] = '\0';
+        return CSTL_ERROR_IO;
+    }
+    setvbuf(temp->file, NULL, _IONBF, 0);
+    return CSTL_OK;
+}
+
+/**
+ * @brief 关闭并删除临时文件
+ *
+ * @param temp 临时文件
+ */
+static void ext_temp_close(ext_temp_t* temp)
+{
+    if (temp->file != NULL) {
+        fclose(temp->file);
+        temp->file = NULL;
+    }
+    if (temp->path[0] != '\0') {
+        remove(temp->path);
+        temp->path[0] = '\0';
+    }
+}
+
+/**
+ * @brief 把写缓冲区写出到文件
+ *
+ * @param writer 写出器
+ */
+static void ext_writer_flush(ext_writer_t* writer)
+{
+    if (writer->used > 0 && !writer->failed) {
+        if (fwrite(writer->buffer, 1, writer->used, writer->file) != writer->used) {
+            writer->failed = 1;
+        }
+    }
+    writer->used = 0;
+}
+
+/**
+ * @brief 写出一条记录
+ *
+ * @param writer 写出器
+ * @param record 记录指针
+ * @param record_size 记录字节数
+ */
+static inline void ext_writer_put(ext_writer_t* writer, const char* record, size_t record_size)
+{
+    if (writer->capacity - writer->used < record_size) {
+        ext_writer_flush(writer);
+    }
+    memcpy(writer->buffer + writer->used, record, record_size);
+    writer->used += record_size;
+    writer->written += record_size;
+}
+
+/**
+ * @brief 读入下一块记录
+ *
+ * @param reader 读者
+ * @param record_size 记录字节数
+ * @return int 成功返回1，读取失败返回0
+ */
+static int ext_reader_refill(ext_reader_t* reader, size_t record_size)
+{
+    reader->head = NULL;
+    if (reader->file == NULL || reader->remaining == 0) {
+        return 1;
+    }
+
+    size_t n = reader->remaining < reader->capacity ? (size_t)reader->remaining : reader->capacity;
+    if (ext_seek(reader->file, reader->offset) != 0 ||
+        fread(reader->buffer, record_size, n, reader->file) != n) {
+        return 0;
+    }
+
+    reader->offset += (uint64_t)n * record_size;
+    reader->remaining -= n;
+    reader->head = reader->buffer;
+    reader->end = reader->buffer + n * record_size;
+    return 1;
+}
+
+/**
+ * @brief 败者树中读者a是否应排在读者b之前，取完的读者排在最后
+ *
+ * @param readers 读者数组
+ * @param a 读者编号
+ * @param b 读者编号
+ * @param compare 比较函数指针
+ * @return int 排在之前返回1，否则返回0
+ */
+static inline int ext_before(const ext_reader_t* readers, size_t a, size_t b, comparator_fn_t compare)
+{
+    if (readers[a].head == NULL) {
+        return 0;
+    }
+    if (readers[b].head == NULL) {
+        return 1;
+    }
+    int c = compare(readers[a].head, readers[b].head);
+    return c < 0 || (c == 0 && a < b);
+}
+
+/**
+ * @brief 用败者树把多路读者归并到写出器
+ *
+ * @param readers 读者数组，head已指向各自的第一条记录
+ * @param k 读者数量
+ * @param writer 写出器
+ * @param record_size 记录字节数
+ * @param compare 比较函数指针
+ * @return error_code_t 错误码
+ */
+static error_code_t ext_merge(ext_reader_t* readers, size_t k, ext_writer_t* writer,
+                              size_t record_size, comparator_fn_t compare)
+{
+    size_t* tree = (size_t*)malloc(k * sizeof(size_t));
+    size_t* winners = (size_t*)malloc(2 * k * sizeof(size_t));
+    if (tree == NULL || winners == NULL) {
+        free(tree);
+        free(winners);
+        return CSTL_ERROR_OUT_OF_MEMORY;
+    }
+
+    /* 叶子k + i对应读者i，自底向上建树，tree[0]为胜者，tree[1..k)为败者 */
+    for (size_t i = 0; i < k; i++) {
+        winners[k + i] = i;
+    }
+    for (size_t node = k - 1; node >= 1; node--) {
+        size_t left = winners[2 * node];
+        size_t right = winners[2 * node + 1];
+        if (ext_before(readers, left, right, compare)) {
+            winners[node] = left;
+            tree[node] = right;
+        } else {
+            winners[node] = right;
+            tree[node] = left;
+        }
+    }
+    tree[0] = winners[k > 1 ? 1 : k];
+    free(winners);
+
+    error_code_t err = CSTL_OK;
+    while (readers[tree[0]].head != NULL) {
+        size_t winner = tree[0];
+        ext_reader_t* reader = &readers[winner];
+
+        ext_writer_put(writer, reader->head, record_size);
+        reader->head += record_size;
+        if (reader->head == reader->end && !ext_reader_refill(reader, record_size)) {
+            err = CSTL_ERROR_IO;
+            break;
+        }
+
+        for (size_t node = (winner + k) / 2; node >= 1; node /= 2) {
+            if (ext_before(readers, tree[node], winner, compare)) {
+                size_t loser = winner;
+                winner = tree[node];
+                tree[node] = loser;
+            }
+        }
+        tree[0] = winner;
+    }
+
+    free(tree);
+    return err;
+}
+
+/**
+ * @brief 从输入流读满缓冲区
+ *
+ * @param input 输入流
+ * @param buffer 缓冲区
+ * @param size 缓冲区字节数
+ * @param filled 输出参数，存储读入的字节数
+ * @return error_code_t 错误码
+ */
+static error_code_t ext_read_block(FILE* input, char* buffer, size_t size, size_t* filled)
+{
+    *filled = 0;
+    while (*filled < size) {
+        size_t n = fread(buffer + *filled, 1, size - *filled, input);
+        if (n == 0) {
+            break;
+        }
+        *filled += n;
+    }
+    return ferror(input) ? CSTL_ERROR_IO : CSTL_OK;
+}
+
+/**
+ * @brief 并行排序的上下文
+ */
+typedef struct {
+    char* data;                 /**< 记录首地址 */
+    size_t count;               /**< 记录数量 */
+    size_t chunk;               /**< 每个分块的记录数量 */
+    size_t record_size;         /**< 记录字节数 */
+    comparator_fn_t compare;    /**< 比较函数指针 */
+} ext_sort_context_t;
+
+/**
+ * @brief 排序若干个分块
+ *
+ * @param context 并行排序上下文
+ * @param begin 起始分块编号
+ * @param end 结束分块编号
+ */
+static void ext_sort_chunks(void* context, size_t begin, size_t end)
+{
+    ext_sort_context_t* ctx = (ext_sort_context_t*)context;
+    for (size_t c = begin; c < end; c++) {
+        size_t first = c * ctx->chunk;
+        size_t count = ctx->count - first < ctx->chunk ? ctx->count - first : ctx->chunk;
+        qsort(ctx->data + first * ctx->record_size, count, ctx->record_size, ctx->compare);
+    }
+}
+
+/**
+ * @brief 排序内存中的一批记录，并归并写出为一个有序段
+ *
+ * 并行时把记录分成与线程数相当的分块分别排序，再归并各分块写出。
+ *
+ * @param data 记录首地址
+ * @param count 记录数量
+ * @param record_size 记录字节数
+ * @param compare 比较函数指针
+ * @param parallel 是否并行排序
+ * @param writer 写出器
+ * @return error_code_t 错误码
+ */
+static error_code_t ext_sort_block(char* data, size_t count, size_t record_size, comparator_fn_t compare,
+                                   int parallel, ext_writer_t* writer)
+{
+    size_t chunks = 1;
+    if (parallel) {
+        chunks = thread_pool_size(thread_pool_default()) + 1;
+        if (chunks > count / EXTERNAL_SORT_MIN_CHUNK) {
+            chunks = count / EXTERNAL_SORT_MIN_CHUNK;
+        }
+        if (chunks == 0) {
+            chunks = 1;
+        }
+    }
+
+    ext_sort_context_t ctx;
+    ctx.data = data;
+    ctx.count = count;
+    ctx.chunk = (count + chunks - 1) / chunks;
+    ctx.record_size = record_size;
+    ctx.compare = compare;
+
+    if (chunks == 1) {
+        qsort(data, count, record_size, compare);
+        for (size_t i = 0; i < count; i++) {
+            ext_writer_put(writer, data + i * record_size, record_size);
+        }
+        return CSTL_OK;
+    }
+
+    error_code_t err = thread_pool_parallel_for(NULL, chunks, 1, ext_sort_chunks, &ctx);
+    if (err != CSTL_OK) {
+        return err;
+    }
+
+    ext_reader_t* readers = (ext_reader_t*)calloc(chunks, sizeof(ext_reader_t));
+    if (readers == NULL) {
+        return CSTL_ERROR_OUT_OF_MEMORY;
+    }
+    for (size_t c = 0; c < chunks; c++) {
+        size_t first = c * ctx.chunk;
+        size_t n = count - first < ctx.chunk ? count - first : ctx.chunk;
+        readers[c].head = n > 0 ? data + first * record_size : NULL;
+        readers[c].end = data + (first + n) * record_size;
+    }
+
+    err = ext_merge(readers, chunks, writer, record_size, compare);
+    free(readers);
+    return err;
+}
+
+/**
+ * @brief 把一组有序段归并写出
+ *
+ * 内存预算平均分给各路读者和写出器。
+ *
+ * @param source 有序段所在的文件
+ * @param runs 有序段数组
+ * @param k 有序段数量
+ * @param output 输出文件
+ * @param memory 预算内的缓冲区
+ * @param memory_size 缓冲区字节数
+ * @param record_size 记录字节数
+ * @param compare 比较函数指针
+ * @param written 输出参数，存储写出的字节数
+ * @return error_code_t 错误码
+ */
+static error_code_t ext_merge_runs(FILE* source, const ext_run_t* runs, size_t k, FILE* output,
+                                   char* memory, size_t memory_size, size_t record_size,
+                                   comparator_fn_t compare, uint64_t* written)
+{
+    size_t share = memory_size / (k + 1) / record_size;
+    ext_reader_t* readers = (ext_reader_t*)calloc(k, sizeof(ext_reader_t));
+    if (readers == NULL) {
+        return CSTL_ERROR_OUT_OF_MEMORY;
+    }
+
+    error_code_t err = CSTL_OK;
+    for (size_t i = 0; i < k && err == CSTL_OK; i++) {
+        readers[i].file = source;
+        readers[i].offset = runs[i].offset;
+        readers[i].remaining = runs[i].count;
+        readers[i].buffer = memory + i * share * record_size;
+        readers[i].capacity = share;
+        if (!ext_reader_refill(&readers[i], record_size)) {
+            err = CSTL_ERROR_IO;
+        }
+    }
+
+    ext_writer_t writer;
+    memset(&writer, 0, sizeof(writer));
+    writer.file = output;
+    writer.buffer = memory + k * share * record_size;
+    writer.capacity = memory_size - k * share * record_size;
+
+    if (err == CSTL_OK) {
+        err = ext_merge(readers, k, &writer, record_size, compare);
+    }
+    ext_writer_flush(&writer);
+    if (err == CSTL_OK && writer.failed) {
+        err = CSTL_ERROR_IO;
+    }
+
+    *written = writer.written;
+    free(readers);
+    return err;
+}
+
+/**
+ * @brief 外部排序的实现
+ *
+ * @param input 输入流
+ * @param output 输出流，为NULL时在输入读完后打开output_path
+ * @param output_path 输出文件路径
+ * @param record_size 记录字节数
+ * @param compare 比较函数指针
+ * @param config 配置
+ * @param stats 输出参数，存储统计信息，可以为NULL
+ * @return error_code_t 错误码
+ */
+static error_code_t external_sort_impl(FILE* input, FILE* output, const char* output_path,
+                                       size_t record_size, comparator_fn_t compare,
+                                       const external_sort_config_t* config, external_sort_stats_t* stats)
+{
+    external_sort_config_t defaults;
+    if (config == NULL) {
+        external_sort_config_init(&defaults);
+        config = &defaults;
+    }
+
+    size_t budget = config->memory_budget / record_size * record_size;
+    size_t min_buffer = config->min_buffer_size < record_size ? record_size : config->min_buffer_size;
+    /* 两路归并时两个读者和写出器各至少需要一条记录 */
+    if (budget / record_size < 3) {
+        return CSTL_ERROR_INVALID_ARGUMENT;
+    }
+
+    /* 形成有序段时，写缓冲区占预算的一小部分，其余用来装记录 */
+    size_t write_size = budget / EXTERNAL_SORT_WRITE_SHARE / record_size * record_size;
+    if (write_size < record_size) {
+        write_size = record_size;
+    }
+    size_t block_size = budget - write_size;
+
+    char* memory = (char*)malloc(budget);
+    if (memory == NULL) {
+        return CSTL_ERROR_OUT_OF_MEMORY;
+    }
+
+    external_sort_stats_t local;
+    memset(&local, 0, sizeof(local));
+
+    ext_temp_t temp;
+    memset(&temp, 0, sizeof(temp));
+    ext_run_t* runs = NULL;
+    size_t run_capacity = 0;
+    int owns_output = 0;
+    error_code_t err = CSTL_OK;
+
+    ext_writer_t writer;
+    memset(&writer, 0, sizeof(writer));
+    writer.buffer = memory + block_size;
+    writer.capacity = write_size;
+
+    /* 第一阶段：形成有序段 */
+    for (;;) {
+        size_t filled = 0;
+        err = ext_read_block(input, memory, block_size, &filled);
+        if (err != CSTL_OK) {
+            break;
+        }
+        if (filled % record_size != 0) {
+            err = CSTL_ERROR_INVALID_ARGUMENT;
+            break;
+        }
+        size_t count = filled / record_size;
+        if (count == 0) {
+            break;
+        }
+        local.records += count;
+
+        /* 全部记录一次装入内存时直接排序写出，不使用临时文件 */
+        if (local.runs == 0 && filled < block_size) {
+            if (output == NULL) {
+                output = fopen(output_path, "wb");
+                owns_output = 1;
+                if (output == NULL) {
+                    err = CSTL_ERROR_IO;
+                    break;
+                }
+            }
+            writer.file = output;
+            err = ext_sort_block(memory, count, record_size, compare, config->parallel, &writer);
+            ext_writer_flush(&writer);
+            if (err == CSTL_OK && writer.failed) {
+                err = CSTL_ERROR_IO;
+            }
+            local.runs = 1;
+            break;
+        }
+
+        if (temp.file == NULL) {
+            err = ext_temp_open(&temp, config->temp_dir);
+            if (err != CSTL_OK) {
+                break;
+            }
+            writer.file = temp.file;
+        }
+        if (local.runs == run_capacity) {
+            size_t new_capacity = run_capacity == 0 ? 16 : run_capacity * 2;
+            ext_run_t* new_runs = (ext_run_t*)realloc(runs, new_capacity * sizeof(ext_run_t));
+            if (new_runs == NULL) {
+                err = CSTL_ERROR_OUT_OF_MEMORY;
+                break;
+            }
+            runs = new_runs;
+            run_capacity = new_capacity;
+        }
+
+        runs[local.runs].offset = writer.written;
+        runs[local.runs].count = count;
+        local.runs++;
+        err = ext_sort_block(memory, count, record_size, compare, config->parallel, &writer);
+        ext_writer_flush(&writer);
+        if (err == CSTL_OK && writer.failed) {
+            err = CSTL_ERROR_IO;
+        }
+        if (err != CSTL_OK) {
+            break;
+        }
+    }
+
+    /* 第二阶段：路数超过上限时先做中间归并，最后一趟写到输出 */
+    size_t fan_in = budget / min_buffer;
+    fan_in = fan_in > 1 ? fan_in - 1 : 1;
+    if (fan_in < 2) {
+        fan_in = 2;
+    }
+    size_t run_count = temp.file != NULL ? local.runs : 0;
+
+    while (err == CSTL_OK && run_count > fan_in) {
+        ext_temp_t next;
+        err = ext_temp_open(&next, config->temp_dir);
+        if (err != CSTL_OK) {
+            break;
+        }
+
+        size_t merged = 0;
+        uint64_t offset = 0;
+        for (size_t first = 0; first < run_count && err == CSTL_OK; first += fan_in) {
+            size_t k = run_count - first < fan_in ? run_count - first : fan_in;
+            uint64_t written = 0;
+            uint64_t records = 0;
+            for (size_t i = 0; i < k; i++) {
+                records += runs[first + i].count;
+            }
+            err = ext_merge_runs(temp.file, runs + first, k, next.file, memory, budget,
+                                 record_size, compare, &written);
+            runs[merged].offset = offset;
+            runs[merged].count = records;
+            merged++;
+            offset += written;
+        }
+
+        ext_temp_close(&temp);
+        temp = next;
+        run_count = merged;
+        local.merge_passes++;
+    }
+
+    if (err == CSTL_OK && run_count > 0) {
+        if (output == NULL) {
+            output = fopen(output_path, "wb");
+            owns_output = 1;
+        }
+        if (output == NULL) {
+            err = CSTL_ERROR_IO;
+        } else {
+            uint64_t written = 0;
+            err = ext_merge_runs(temp.file, runs, run_count, output, memory, budget,
+                                 record_size, compare, &written);
+            local.merge_passes++;
+        }
+    }
+
+    if (err == CSTL_OK && owns_output == 0 && output == NULL && output_path != NULL) {
+        /* 输入为空时也生成空的输出文件 */
+        output = fopen(output_path, "wb");
+        owns_output = 1;
+        if (output == NULL) {
+            err = CSTL_ERROR_IO;
+        }
+    }
+    if (owns_output && output != NULL && fclose(output) != 0 && err == CSTL_OK) {
+        err = CSTL_ERROR_IO;
+    } else if (!owns_output && output != NULL && fflush(output) != 0 && err == CSTL_OK) {
+        err = CSTL_ERROR_IO;
+    }
+
+    ext_temp_close(&temp);
+    free(runs);
+    free(memory);
+
+    if (stats != NULL) {
+        *stats = local;
+    }
+    return err;
+}
+
+/**
+ * @brief 用默认值初始化外部排序配置
+ *
+ * @param config 配置
+ */
+void external_sort_config_init(external_sort_config_t* config)
+{
+    if (config == NULL) {
+        return;
+    }
+
+    config->memory_budget = EXTERNAL_SORT_DEFAULT_BUDGET;
+    config->min_buffer_size = EXTERNAL_SORT_DEFAULT_MIN_BUFFER;
+    config->temp_dir = NULL;
+    config->parallel = 1;
+}
+
+/**
+ * @brief 对流中的定长记录排序并写入输出流
+ *
+ * @param input 输入流
+ * @param output 输出流
+ * @param record_size 记录字节数
+ * @param compare 记录比较函数
+ * @param config 配置，为NULL时使用默认配置
+ * @param stats 输出参数，存储统计信息，可以为NULL
+ * @return error_code_t 错误码
+ */
+error_code_t external_sort_stream(FILE* input, FILE* output, size_t record_size, comparator_fn_t compare,
+                                  const external_sort_config_t* config, external_sort_stats_t* stats)
+{
+    if (input == NULL || output == NULL || compare == NULL) {
+        return CSTL_ERROR_NULL_POINTER;
+    }
+    if (record_size == 0) {
+        return CSTL_ERROR_INVALID_ARGUMENT;
+    }
+
+    return external_sort_impl(input, output, NULL, record_size, compare, config, stats);
+}
+
+/**
+ * @brief 对文件中的定长记录排序并写入输出文件
+ *
+ * @param input_path 输入文件路径
+ * @param output_path 输出文件路径
+ * @param record_size 记录字节数
+ * @param compare 记录比较函数
+ * @param config 配置，为NULL时使用默认配置
+ * @param stats 输出参数，存储统计信息，可以为NULL
+ * @return error_code_t 错误码
+ */
+error_code_t external_sort_file(const char* input_path, const char* output_path, size_t record_size,
+                                comparator_fn_t compare, const external_sort_config_t* config,
+                                external_sort_stats_t* stats)
+{
+    if (input_path == NULL || output_path == NULL || compare == NULL) {
+        return CSTL_ERROR_NULL_POINTER;
+    }
+    if (record_size == 0) {
+        return CSTL_ERROR_INVALID_ARGUMENT;
+    }
+
+    FILE* input = fopen(input_path, "rb");
+    if (input == NULL) {
+        return CSTL_ERROR_IO;
+    }
+    setvbuf(input, NULL, _IONBF, 0);
+
+    error_code_t err = external_sort_impl(input, NULL, output_path, record_size, compare, config, stats);
+    fclose(input);
+    return err;
+}
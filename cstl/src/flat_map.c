@@ -0,0 +1,1309 @@
+/**
+ * @file flat_map.c
+ * @brief CSTL库的有序扁平映射和有序扁平集合实现
+ *
+ * 该文件实现了CSTL库的有序扁平映射和有序扁平集合。keys中的元素按键有序，
+ * 分离布局中values与keys一一对应；交错布局中keys的每个元素是一个键值对，值在value_offset处。
+ * 有序扁平集合是没有值的有序扁平映射。
+ */
+
+#include "cstl/flat_map.h"
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+/**
+ * @brief 逐个插入排序的小段长度，成批排序时先把每段插入排序，再两两归并
+ */
+#define FLAT_MAP_SORT_RUN 16
+
+/**
+ * @brief 成批插入时标记批内已经存在的键
+ */
+#define FLAT_MAP_SKIP SIZE_MAX
+
+/**
+ * @brief 整数键不超过这个数量时顺序比较全部键，不做二分查找
+ */
+#define FLAT_MAP_LINEAR_LIMIT 8
+
+/**
+ * @brief 计算一种大小的元素的对齐，取大小中最低的二进制位，最多为8
+ *
+ * @param size 元素大小
+ * @return size_t 对齐
+ */
+static size_t flat_map_alignment(size_t size)
+{
+    size_t alignment = size & (~size + 1);
+    return alignment > 8 ? 8 : alignment;
+}
+
+/**
+ * @brief 生成按无符号整数比较键的比较函数和查找函数
+ *
+ * 比较函数用于排序和成批插入。查找函数是flat_map_locate的整数版本：
+ * 不超过FLAT_MAP_LINEAR_LIMIT个键时数出小于目标的键的个数，各次比较互不依赖；
+ * 更多时二分查找，循环中直接比较整数，编译为条件传送，不调用比较函数。
+ */
+#define FLAT_MAP_INTEGER_KEY(bits)                                                   \
+static int flat_map_compare_u##bits(const void* a, const void* b)                    \
+{                                                                                    \
+    uint##bits##_t x;                                                                \
+    uint##bits##_t y;                                                                \
+    memcpy(&x, a, sizeof(x));                                                        \
+    memcpy(&y, b, sizeof(y));                                                        \
+    return (x > y) - (x < y);                                                        \
+}                                                                                    \
+                                                                                     \
+static int flat_map_locate_u##bits(const unsigned char* data, size_t stride,         \
+                                   size_t length, const void* key, size_t* index)    \
+{                                                                                    \
+    uint##bits##_t target;                                                           \
+    uint##bits##_t probe;                                                            \
+    size_t size = length;                                                            \
+    size_t base = 0;                                                                 \
+    memcpy(&target, key, sizeof(target));                                            \
+    if (size <= FLAT_MAP_LINEAR_LIMIT) {                                             \
+        for (size_t i = 0; i < size; i++) {                                          \
+            memcpy(&probe, data + i * stride, sizeof(probe));                        \
+            base += probe < target;                                                  \
+        }                                                                            \
+    } else {                                                                         \
+        while (length > 1) {                                                         \
+            size_t half = length / 2;                                                \
+            memcpy(&probe, data + (base + half) * stride, sizeof(probe));            \
+            base = probe < target ? base + half : base;                              \
+            length -= half;                                                          \
+        }                                                                            \
+        memcpy(&probe, data + base * stride, sizeof(probe));                         \
+        base += probe < target;                                                      \
+    }                                                                                \
+    *index = base;                                                                   \
+    if (base >= size) {                                                              \
+        return 0;                                                                    \
+    }                                                                                \
+    memcpy(&probe, data + base * stride, sizeof(probe));                             \
+    return probe == target;                                                          \
+}
+
+FLAT_MAP_INTEGER_KEY(8)
+FLAT_MAP_INTEGER_KEY(16)
+FLAT_MAP_INTEGER_KEY(32)
+FLAT_MAP_INTEGER_KEY(64)
+
+#undef FLAT_MAP_INTEGER_KEY
+
+/**
+ * @brief 获取第index个键
+ *
+ * @param map 有序扁平映射指针
+ * @param index 位置
+ * @return unsigned char* 键指针
+ */
+static unsigned char* flat_map_key(const flat_map_t* map, size_t index)
+{
+    return (unsigned char*)map->keys->data + index * map->keys->element_size;
+}
+
+/**
+ * @brief 获取第index个值
+ *
+ * @param map 有序扁平映射指针
+ * @param index 位置
+ * @return unsigned char* 值指针
+ */
+static unsigned char* flat_map_value(const flat_map_t* map, size_t index)
+{
+    if (map->values != NULL) {
+        return (unsigned char*)map->values->data + index * map->value_size;
+    }
+    return flat_map_key(map, index) + map->value_offset;
+}
+
+/**
+ * @brief 锁定有序扁平映射（如果启用线程安全）
+ *
+ * @param map 有序扁平映射指针
+ */
+static void flat_map_lock(flat_map_t* map)
+{
+    if (map != NULL && map->thread_safe) {
+        mutex_lock(&map->lock);
+    }
+}
+
+/**
+ * @brief 解锁有序扁平映射（如果启用线程安全）
+ *
+ * @param map 有序扁平映射指针
+ */
+static void flat_map_unlock(flat_map_t* map)
+{
+    if (map != NULL && map->thread_safe) {
+        mutex_unlock(&map->lock);
+    }
+}
+
+/**
+ * @brief 查找第一个不小于key的键的位置
+ *
+ * 每一步都把范围缩小一半，循环中只有一次比较和一次条件赋值，没有难以预测的分支。
+ *
+ * @param map 有序扁平映射指针
+ * @param key 键指针
+ * @return size_t 位置
+ */
+static size_t flat_map_search(const flat_map_t* map, const void* key)
+{
+    size_t length = map->keys->size;
+    if (length == 0) {
+        return 0;
+    }
+
+    const unsigned char* data = (const unsigned char*)map->keys->data;
+    size_t stride = map->keys->element_size;
+    comparator_fn_t compare = map->compare;
+    size_t base = 0;
+
+    while (length > 1) {
+        size_t half = length / 2;
+        base = compare(data + (base + half) * stride, key) < 0 ? base + half : base;
+        length -= half;
+    }
+
+    return base + (compare(data + base * stride, key) < 0);
+}
+
+/**
+ * @brief 查找键的位置
+ *
+ * @param map 有序扁平映射指针
+ * @param key 键指针
+ * @param index 输出参数，存储第一个不小于key的键的位置
+ * @return int 如果键存在返回非零，否则返回零
+ */
+static int flat_map_locate(const flat_map_t* map, const void* key, size_t* index)
+{
+    /* 整数键直接比较整数，不调用比较函数 */
+    if (map->integer_keys) {
+        const unsigned char* data = (const unsigned char*)map->keys->data;
+        size_t stride = map->keys->element_size;
+        size_t length = map->keys->size;
+
+        switch (map->key_size) {
+        case 1:
+            return flat_map_locate_u8(data, stride, length, key, index);
+        case 2:
+            return flat_map_locate_u16(data, stride, length, key, index);
+        case 4:
+            return flat_map_locate_u32(data, stride, length, key, index);
+        default:
+            return flat_map_locate_u64(data, stride, length, key, index);
+        }
+    }
+
+    *index = flat_map_search(map, key);
+    return *index < map->keys->size && map->compare(flat_map_key(map, *index), key) == 0;
+}
+
+/**
+ * @brief 对第index个键值对调用析构函数
+ *
+ * @param map 有序扁平映射指针
+ * @param index 位置
+ */
+static void flat_map_destroy_entry(flat_map_t* map, size_t index)
+{
+    if (map->key_destructor != NULL) {
+        map->key_destructor(flat_map_key(map, index));
+    }
+    if (map->value_destructor != NULL && map->value_size > 0) {
+        map->value_destructor(flat_map_value(map, index));
+    }
+}
+
+/**
+ * @brief 复制键值对到第index个位置
+ *
+ * @param map 有序扁平映射指针
+ * @param index 位置
+ * @param key 键指针
+ * @param value 值指针，集合中为NULL
+ */
+static void flat_map_store(flat_map_t* map, size_t index, const void* key, const void* value)
+{
+    memcpy(flat_map_key(map, index), key, map->key_size);
+    if (map->value_size > 0) {
+        memcpy(flat_map_value(map, index), value, map->value_size);
+    }
+}
+
+/**
+ * @brief 预留容量
+ *
+ * @param map 有序扁平映射指针
+ * @param capacity 键值对容量
+ * @return error_code_t 错误码
+ */
+static error_code_t flat_map_reserve_unlocked(flat_map_t* map, size_t capacity)
+{
+    error_code_t result = CSTL_OK;
+
+    if (map->keys->capacity < capacity) {
+        result = vector_reserve(map->keys, capacity);
+    }
+    if (result == CSTL_OK && map->values != NULL && map->values->capacity < capacity) {
+        result = vector_reserve(map->values, capacity);
+    }
+
+    return result;
+}
+
+/**
+ * @brief 在第index个位置插入键值对，之后的元素后移
+ *
+ * @param map 有序扁平映射指针
+ * @param index 位置
+ * @param key 键指针
+ * @param value 值指针，集合中为NULL
+ * @return error_code_t 错误码
+ */
+static error_code_t flat_map_insert_at(flat_map_t* map, size_t index, const void* key, const void* value)
+{
+    size_t size = map->keys->size;
+
+    /* 按向量的增长策略扩容 */
+    error_code_t result = flat_map_reserve_unlocked(map, size + 1);
+    if (result != CSTL_OK) {
+        return result;
+    }
+
+    if (index < size) {
+        memmove(flat_map_key(map, index + 1), flat_map_key(map, index),
+                (size - index) * map->keys->element_size);
+        if (map->values != NULL) {
+            memmove(flat_map_value(map, index + 1), flat_map_value(map, index),
+                    (size - index) * map->value_size);
+        }
+    }
+
+    map->keys->size++;
+    if (map->values != NULL) {
+        map->values->size++;
+    }
+    flat_map_store(map, index, key, value);
+
+    return CSTL_OK;
+}
+
+/**
+ * @brief 删除第index个键值对，之后的元素前移
+ *
+ * @param map 有序扁平映射指针
+ * @param index 位置
+ */
+static void flat_map_erase_at(flat_map_t* map, size_t index)
+{
+    size_t size = map->keys->size;
+
+    flat_map_destroy_entry(map, index);
+
+    if (index + 1 < size) {
+        memmove(flat_map_key(map, index), flat_map_key(map, index + 1),
+                (size - index - 1) * map->keys->element_size);
+        if (map->values != NULL) {
+            memmove(flat_map_value(map, index), flat_map_value(map, index + 1),
+                    (size - index - 1) * map->value_size);
+        }
+    }
+
+    map->keys->size--;
+    if (map->values != NULL) {
+        map->values->size--;
+    }
+}
+
+/**
+ * @brief 清空有序扁平映射，不加锁
+ *
+ * @param map 有序扁平映射指针
+ */
+static void flat_map_clear_unlocked(flat_map_t* map)
+{
+    if (map->key_destructor != NULL || map->value_destructor != NULL) {
+        for (size_t i = 0; i < map->keys->size; i++) {
+            flat_map_destroy_entry(map, i);
+        }
+    }
+
+    /* 保留容量，之后的插入不需要重新分配 */
+    map->keys->size = 0;
+    if (map->values != NULL) {
+        map->values->size = 0;
+    }
+}
+
+/**
+ * @brief 对输入的键按位置稳定排序
+ *
+ * 先把每FLAT_MAP_SORT_RUN个位置插入排序，再自底向上两两归并，只移动位置不移动键。
+ * 稳定排序使相同的键中第一次出现的排在最前面，去重时保留它。
+ *
+ * @param keys 键数组
+ * @param key_size 键大小
+ * @param count 键数量
+ * @param compare 比较函数指针
+ * @param order 输出参数，存储排序后的位置，大小为count
+ * @param buffer 临时数组，大小为count
+ */
+static void flat_map_sort_order(const unsigned char* keys, size_t key_size, size_t count,
+                                comparator_fn_t compare, size_t* order, size_t* buffer)
+{
+    size_t i;
+
+    for (i = 0; i < count; i++) {
+        order[i] = i;
+    }
+
+    /* 输入已经有序时不需要排序 */
+    for (i = 1; i < count; i++) {
+        if (compare(keys + (i - 1) * key_size, keys + i * key_size) > 0) {
+            break;
+        }
+    }
+    if (i >= count) {
+        return;
+    }
+
+    for (size_t start = 0; start < count; start += FLAT_MAP_SORT_RUN) {
+        size_t end = start + FLAT_MAP_SORT_RUN < count ? start + FLAT_MAP_SORT_RUN : count;
+        for (i = start + 1; i < end; i++) {
+            size_t current = order[i];
+            size_t j = i;
+            while (j > start && compare(keys + order[j - 1] * key_size, keys + current * key_size) > 0) {
+                order[j] = order[j - 1];
+                j--;
+            }
+            order[j] = current;
+        }
+    }
+
+    size_t* source = order;
+    size_t* dest = buffer;
+    for (size_t width = FLAT_MAP_SORT_RUN; width < count; width *= 2) {
+        for (size_t start = 0; start < count; start += 2 * width) {
+            size_t middle = start + width < count ? start + width : count;
+            size_t end = start + 2 * width < count ? start + 2 * width : count;
+            size_t left = start;
+            size_t right = middle;
+            size_t out = start;
+
+            /* 左段的最后一个不大于右段的第一个时两段已经有序 */
+            if (middle < end && compare(keys + source[middle - 1] * key_size, keys + source[middle] * key_size) <= 0) {
+                memcpy(dest + start, source + start, (end - start) * sizeof(size_t));
+                continue;
+            }
+
+            while (left < middle && right < end) {
+                if (compare(keys + source[right] * key_size, keys + source[left] * key_size) < 0) {
+                    dest[out++] = source[right++];
+                } else {
+                    dest[out++] = source[left++];
+                }
+            }
+            memcpy(dest + out, source + left, (middle - left) * sizeof(size_t));
+            out += middle - left;
+            memcpy(dest + out, source + right, (end - right) * sizeof(size_t));
+        }
+
+        size_t* swap = source;
+        source = dest;
+        dest = swap;
+    }
+
+    if (source != order) {
+        memcpy(order, source, count * sizeof(size_t));
+    }
+}
+
+/**
+ * @brief 对输入的键排序并去重
+ *
+ * @param map 有序扁平映射指针
+ * @param keys 键数组
+ * @param count 键数量
+ * @param order 输出参数，存储去重后按键排序的位置，大小为count
+ * @param buffer 临时数组，大小为count
+ * @return size_t 去重后的数量
+ */
+static size_t flat_map_sort_unique(const flat_map_t* map, const unsigned char* keys, size_t count,
+                                   size_t* order, size_t* buffer)
+{
+    size_t key_size = map->key_size;
+    size_t unique = 1;
+
+    flat_map_sort_order(keys, key_size, count, map->compare, order, buffer);
+
+    for (size_t i = 1; i < count; i++) {
+        if (map->compare(keys + order[unique - 1] * key_size, keys + order[i] * key_size) != 0) {
+            order[unique++] = order[i];
+        }
+    }
+
+    return unique;
+}
+
+/**
+ * @brief 检查键的大小和比较函数
+ *
+ * @param key_size 键大小
+ * @param compare 比较函数指针
+ * @return int 有效返回非零，否则返回零
+ */
+static int flat_map_valid_key(size_t key_size, comparator_fn_t compare)
+{
+    if (compare == NULL) {
+        return key_size == 1 || key_size == 2 || key_size == 4 || key_size == 8;
+    }
+    return key_size > 0;
+}
+
+/**
+ * @brief 初始化有序扁平映射
+ *
+ * @param map 有序扁平映射指针
+ * @param key_size 键大小
+ * @param value_size 值大小，集合为0
+ * @param compare 比较函数指针，为NULL时按无符号整数比较
+ * @param layout 存储布局
+ * @param allocator 分配器指针
+ * @param key_destructor 键的析构函数指针
+ * @param value_destructor 值的析构函数指针
+ * @return error_code_t 错误码
+ */
+static error_code_t flat_map_init(flat_map_t* map, size_t key_size, size_t value_size, comparator_fn_t compare,
+                                  flat_map_layout_t layout, allocator_t* allocator,
+                                  destructor_fn_t key_destructor, destructor_fn_t value_destructor)
+{
+    size_t stride = key_size;
+
+    map->value_offset = 0;
+    if (layout == FLAT_MAP_INTERLEAVED && value_size > 0) {
+        /* 值按自身大小对齐，键值对的大小是两者对齐的倍数，保证数组中每个键和值都对齐 */
+        size_t key_alignment = flat_map_alignment(key_size);
+        size_t value_alignment = flat_map_alignment(value_size);
+        size_t alignment = key_alignment > value_alignment ? key_alignment : value_alignment;
+
+        map->value_offset = (key_size + value_alignment - 1) / value_alignment * value_alignment;
+        stride = (map->value_offset + value_size + alignment - 1) / alignment * alignment;
+    }
+
+    /* 键和值的析构由映射自己调用，向量不设置析构函数 */
+    map->keys = vector_create(stride, 0, allocator, NULL);
+    map->values = NULL;
+    if (layout == FLAT_MAP_SEPARATE && value_size > 0) {
+        map->values = vector_create(value_size, 0, allocator, NULL);
+    }
+    if (map->keys == NULL || (layout == FLAT_MAP_SEPARATE && value_size > 0 && map->values == NULL)) {
+        vector_destroy(map->keys);
+        vector_destroy(map->values);
+        return CSTL_ERROR_OUT_OF_MEMORY;
+    }
+
+    map->key_size = key_size;
+    map->value_size = value_size;
+    map->compare = compare;
+    map->integer_keys = compare == NULL;
+    if (compare == NULL) {
+        static const comparator_fn_t integer_compares[] = {
+            NULL, flat_map_compare_u8, flat_map_compare_u16, NULL, flat_map_compare_u32,
+            NULL, NULL, NULL, flat_map_compare_u64
+        };
+        map->compare = integer_compares[key_size];
+    }
+    map->layout = layout;
+    map->thread_safe = 0;
+    map->key_destructor = key_destructor;
+    map->value_destructor = value_destructor;
+
+    return CSTL_OK;
+}
+
+/**
+ * @brief 释放有序扁平映射持有的资源
+ *
+ * @param map 有序扁平映射指针
+ */
+static void flat_map_release(flat_map_t* map)
+{
+    flat_map_clear_unlocked(map);
+
+    vector_destroy(map->keys);
+    vector_destroy(map->values);
+
+    /* 销毁互斥锁 */
+    if (map->thread_safe) {
+        mutex_destroy(&map->lock);
+    }
+}
+
+/**
+ * @brief 创建有序扁平映射
+ *
+ * @param key_size 键大小
+ * @param value_size 值大小
+ * @param compare 键的比较函数指针
+ * @param layout 存储布局
+ * @param allocator 分配器指针，如果为NULL则使用默认分配器
+ * @param key_destructor 键的析构函数指针，为NULL时不调用
+ * @param value_destructor 值的析构函数指针，为NULL时不调用
+ * @return flat_map_t* 有序扁平映射指针，失败返回NULL
+ */
+flat_map_t* flat_map_create(size_t key_size, size_t value_size, comparator_fn_t compare,
+                            flat_map_layout_t layout, allocator_t* allocator,
+                            destructor_fn_t key_destructor, destructor_fn_t value_destructor)
+{
+    if (!flat_map_valid_key(key_size, compare) || value_size == 0 ||
+        (layout != FLAT_MAP_SEPARATE && layout != FLAT_MAP_INTERLEAVED)) {
+        return NULL;
+    }
+
+    flat_map_t* map = (flat_map_t*)malloc(sizeof(flat_map_t));
+    if (map == NULL) {
+        return NULL;
+    }
+
+    if (flat_map_init(map, key_size, value_size, compare, layout, allocator,
+                      key_destructor, value_destructor) != CSTL_OK) {
+        free(map);
+        return NULL;
+    }
+
+    return map;
+}
+
+/**
+ * @brief 销毁有序扁平映射
+ *
+ * @param map 有序扁平映射指针
+ */
+void flat_map_destroy(flat_map_t* map)
+{
+    if (map == NULL) {
+        return;
+    }
+
+    flat_map_release(map);
+    free(map);
+}
+
+/**
+ * @brief 清空有序扁平映射
+ *
+ * @param map 有序扁平映射指针
+ */
+void flat_map_clear(flat_map_t* map)
+{
+    if (map == NULL) {
+        return;
+    }
+
+    flat_map_lock(map);
+    flat_map_clear_unlocked(map);
+    flat_map_unlock(map);
+}
+
+/**
+ * @brief 获取有序扁平映射大小
+ *
+ * @param map 有序扁平映射指针
+ * @return size_t 键值对数量
+ */
+size_t flat_map_size(const flat_map_t* map)
+{
+    if (map == NULL) {
+        return 0;
+    }
+
+    return map->keys->size;
+}
+
+/**
+ * @brief 检查有序扁平映射是否为空
+ *
+ * @param map 有序扁平映射指针
+ * @return int 如果为空返回非零，否则返回零
+ */
+int flat_map_empty(const flat_map_t* map)
+{
+    if (map == NULL) {
+        return 1;
+    }
+
+    return map->keys->size == 0;
+}
+
+/**
+ * @brief 预留容量
+ *
+ * @param map 有序扁平映射指针
+ * @param capacity 键值对容量
+ * @return error_code_t 错误码
+ */
+error_code_t flat_map_reserve(flat_map_t* map, size_t capacity)
+{
+    if (map == NULL) {
+        return CSTL_ERROR_NULL_POINTER;
+    }
+
+    flat_map_lock(map);
+    error_code_t result = flat_map_reserve_unlocked(map, capacity);
+    flat_map_unlock(map);
+
+    return result;
+}
+
+/**
+ * @brief 插入键值对
+ *
+ * @param map 有序扁平映射指针
+ * @param key 键指针
+ * @param value 值指针
+ * @return error_code_t 错误码，键已经存在时返回CSTL_ERROR_ALREADY_EXISTS
+ */
+error_code_t flat_map_insert(flat_map_t* map, const void* key, const void* value)
+{
+    if (map == NULL || key == NULL || (value == NULL && map->value_size > 0)) {
+        return CSTL_ERROR_NULL_POINTER;
+    }
+
+    flat_map_lock(map);
+
+    size_t index;
+    error_code_t result = CSTL_ERROR_ALREADY_EXISTS;
+    if (!flat_map_locate(map, key, &index)) {
+        result = flat_map_insert_at(map, index, key, value);
+    }
+
+    flat_map_unlock(map);
+    return result;
+}
+
+/**
+ * @brief 插入键值对，键已经存在时替换它的值
+ *
+ * @param map 有序扁平映射指针
+ * @param key 键指针
+ * @param value 值指针
+ * @return error_code_t 错误码
+ */
+error_code_t flat_map_insert_or_assign(flat_map_t* map, const void* key, const void* value)
+{
+    if (map == NULL || key == NULL || value == NULL) {
+        return CSTL_ERROR_NULL_POINTER;
+    }
+
+    flat_map_lock(map);
+
+    size_t index;
+    error_code_t result = CSTL_OK;
+    if (flat_map_locate(map, key, &index)) {
+        unsigned char* old_value = flat_map_value(map, index);
+        if (map->value_destructor != NULL) {
+            map->value_destructor(old_value);
+        }
+        memcpy(old_value, value, map->value_size);
+    } else {
+        result = flat_map_insert_at(map, index, key, value);
+    }
+
+    flat_map_unlock(map);
+    return result;
+}
+
+/**
+ * @brief 删除键对应的键值对
+ *
+ * @param map 有序扁平映射指针
+ * @param key 键指针
+ * @return error_code_t 错误码，键不存在时返回CSTL_ERROR_NOT_FOUND
+ */
+error_code_t flat_map_erase(flat_map_t* map, const void* key)
+{
+    if (map == NULL || key == NULL) {
+        return CSTL_ERROR_NULL_POINTER;
+    }
+
+    flat_map_lock(map);
+
+    size_t index;
+    error_code_t result = CSTL_ERROR_NOT_FOUND;
+    if (flat_map_locate(map, key, &index)) {
+        flat_map_erase_at(map, index);
+        result = CSTL_OK;
+    }
+
+    flat_map_unlock(map);
+    return result;
+}
+
+/**
+ * @brief 查找键对应的值
+ *
+ * @param map 有序扁平映射指针
+ * @param key 键指针
+ * @param value 输出参数，存储值指针
+ * @return error_code_t 错误码，键不存在时返回CSTL_ERROR_NOT_FOUND
+ */
+error_code_t flat_map_find(const flat_map_t* map, const void* key, void** value)
+{
+    if (map == NULL || key == NULL || value == NULL) {
+        return CSTL_ERROR_NULL_POINTER;
+    }
+
+    flat_map_t* mutable_map = (flat_map_t*)map;
+    flat_map_lock(mutable_map);
+
+    size_t index;
+    error_code_t result = CSTL_ERROR_NOT_FOUND;
+    if (flat_map_locate(map, key, &index)) {
+        *value = flat_map_value(map, index);
+        result = CSTL_OK;
+    }
+
+    flat_map_unlock(mutable_map);
+    return result;
+}
+
+/**
+ * @brief 检查键是否存在
+ *
+ * @param map 有序扁平映射指针
+ * @param key 键指针
+ * @return int 如果键存在返回非零，否则返回零
+ */
+int flat_map_contains(const flat_map_t* map, const void* key)
+{
+    if (map == NULL || key == NULL) {
+        return 0;
+    }
+
+    flat_map_t* mutable_map = (flat_map_t*)map;
+    flat_map_lock(mutable_map);
+
+    size_t index;
+    int found = flat_map_locate(map, key, &index);
+
+    flat_map_unlock(mutable_map);
+    return found;
+}
+
+/**
+ * @brief 查找第一个不小于key的键的位置
+ *
+ * @param map 有序扁平映射指针
+ * @param key 键指针
+ * @param index 输出参数，存储位置
+ * @return error_code_t 错误码
+ */
+error_code_t flat_map_lower_bound(const flat_map_t* map, const void* key, size_t* index)
+{
+    if (map == NULL || key == NULL || index == NULL) {
+        return CSTL_ERROR_NULL_POINTER;
+    }
+
+    flat_map_t* mutable_map = (flat_map_t*)map;
+    flat_map_lock(mutable_map);
+    flat_map_locate(map, key, index);
+    flat_map_unlock(mutable_map);
+
+    return CSTL_OK;
+}
+
+/**
+ * @brief 获取按键排序后第index个键
+ *
+ * @param map 有序扁平映射指针
+ * @param index 位置
+ * @return void* 键指针，index越界时返回NULL
+ */
+void* flat_map_key_at(const flat_map_t* map, size_t index)
+{
+    if (map == NULL || index >= map->keys->size) {
+        return NULL;
+    }
+
+    return flat_map_key(map, index);
+}
+
+/**
+ * @brief 获取按键排序后第index个值
+ *
+ * @param map 有序扁平映射指针
+ * @param index 位置
+ * @return void* 值指针，index越界时返回NULL
+ */
+void* flat_map_value_at(const flat_map_t* map, size_t index)
+{
+    if (map == NULL || map->value_size == 0 || index >= map->keys->size) {
+        return NULL;
+    }
+
+    return flat_map_value(map, index);
+}
+
+/**
+ * @brief 用无序的键值对数组重建有序扁平映射
+ *
+ * @param map 有序扁平映射指针
+ * @param keys 键数组
+ * @param values 值数组
+ * @param count 键值对数量
+ * @return error_code_t 错误码
+ */
+error_code_t flat_map_build(flat_map_t* map, const void* keys, const void* values, size_t count)
+{
+    if (map == NULL || (count > 0 && (keys == NULL || (values == NULL && map->value_size > 0)))) {
+        return CSTL_ERROR_NULL_POINTER;
+    }
+
+    flat_map_lock(map);
+
+    if (count == 0) {
+        flat_map_clear_unlocked(map);
+        flat_map_unlock(map);
+        return CSTL_OK;
+    }
+
+    /* 先分配所有需要的内存，失败时原有内容不变 */
+    size_t* order = (size_t*)malloc(count * sizeof(size_t));
+    size_t* buffer = (size_t*)malloc(count * sizeof(size_t));
+    error_code_t result = CSTL_ERROR_OUT_OF_MEMORY;
+    if (order != NULL && buffer != NULL) {
+        result = flat_map_reserve_unlocked(map, count);
+    }
+    if (result != CSTL_OK) {
+        free(order);
+        free(buffer);
+        flat_map_unlock(map);
+        return result;
+    }
+
+    const unsigned char* key_bytes = (const unsigned char*)keys;
+    const unsigned char* value_bytes = (const unsigned char*)values;
+    size_t unique = flat_map_sort_unique(map, key_bytes, count, order, buffer);
+
+    flat_map_clear_unlocked(map);
+    for (size_t i = 0; i < unique; i++) {
+        flat_map_store(map, i, key_bytes + order[i] * map->key_size,
+                       value_bytes != NULL ? value_bytes + order[i] * map->value_size : NULL);
+    }
+    map->keys->size = unique;
+    if (map->values != NULL) {
+        map->values->size = unique;
+    }
+
+    free(order);
+    free(buffer);
+
+    flat_map_unlock(map);
+    return CSTL_OK;
+}
+
+/**
+ * @brief 成批插入无序的键值对
+ *
+ * @param map 有序扁平映射指针
+ * @param keys 键数组
+ * @param values 值数组
+ * @param count 键值对数量
+ * @param inserted 输出参数，存储实际插入的数量，可以为NULL
+ * @return error_code_t 错误码
+ */
+error_code_t flat_map_insert_batch(flat_map_t* map, const void* keys, const void* values,
+                                   size_t count, size_t* inserted)
+{
+    if (map == NULL || (count > 0 && (keys == NULL || (values == NULL && map->value_size > 0)))) {
+        return CSTL_ERROR_NULL_POINTER;
+    }
+
+    if (inserted != NULL) {
+        *inserted = 0;
+    }
+    if (count == 0) {
+        return CSTL_OK;
+    }
+
+    flat_map_lock(map);
+
+    size_t* order = (size_t*)malloc(count * sizeof(size_t));
+    size_t* positions = (size_t*)malloc(count * sizeof(size_t));
+    if (order == NULL || positions == NULL) {
+        free(order);
+        free(positions);
+        flat_map_unlock(map);
+        return CSTL_ERROR_OUT_OF_MEMORY;
+    }
+
+    const unsigned char* key_bytes = (const unsigned char*)keys;
+    const unsigned char* value_bytes = (const unsigned char*)values;
+    size_t unique = flat_map_sort_unique(map, key_bytes, count, order, positions);
+
+    /* 批内的键有序，每个键只需在上一个键的插入位置之后查找 */
+    size_t size = map->keys->size;
+    size_t stride = map->keys->element_size;
+    size_t added = 0;
+    size_t low = 0;
+    for (size_t i = 0; i < unique; i++) {
+        const unsigned char* key = key_bytes + order[i] * map->key_size;
+        size_t length = size - low;
+        size_t base = low;
+
+        while (length > 0) {
+            size_t half = length / 2;
+            if (map->compare(flat_map_key(map, base + half), key) < 0) {
+                base += half + 1;
+                length -= half + 1;
+            } else {
+                length = half;
+            }
+        }
+
+        low = base;
+        if (base < size && map->compare(flat_map_key(map, base), key) == 0) {
+            positions[i] = FLAT_MAP_SKIP;
+        } else {
+            positions[i] = base;
+            added++;
+        }
+    }
+
+    error_code_t result = flat_map_reserve_unlocked(map, size + added);
+    if (result != CSTL_OK || added == 0) {
+        free(order);
+        free(positions);
+        flat_map_unlock(map);
+        return result;
+    }
+
+    /* 从后向前合并：每个新键之后的一段已有元素整体后移到最终位置，再放入新键 */
+    size_t high = size;
+    size_t write = size + added;
+    for (size_t i = unique; i-- > 0;) {
+        size_t position = positions[i];
+        if (position == FLAT_MAP_SKIP) {
+            continue;
+        }
+
+        size_t block = high - position;
+        write -= block;
+        if (block > 0 && write != position) {
+            memmove(flat_map_key(map, write), flat_map_key(map, position), block * stride);
+            if (map->values != NULL) {
+                memmove(flat_map_value(map, write), flat_map_value(map, position), block * map->value_size);
+            }
+        }
+        high = position;
+
+        write--;
+        flat_map_store(map, write, key_bytes + order[i] * map->key_size,
+                       value_bytes != NULL ? value_bytes + order[i] * map->value_size : NULL);
+    }
+
+    map->keys->size = size + added;
+    if (map->values != NULL) {
+        map->values->size = size + added;
+    }
+    if (inserted != NULL) {
+        *inserted = added;
+    }
+
+    free(order);
+    free(positions);
+
+    flat_map_unlock(map);
+    return CSTL_OK;
+}
+
+/**
+ * @brief 启用线程安全
+ *
+ * @param map 有序扁平映射指针
+ * @return error_code_t 错误码
+ */
+error_code_t flat_map_enable_thread_safety(flat_map_t* map)
+{
+    if (map == NULL) {
+        return CSTL_ERROR_NULL_POINTER;
+    }
+
+    if (!map->thread_safe) {
+        error_code_t result = mutex_init(&map->lock);
+        if (result != CSTL_OK) {
+            return result;
+        }
+        map->thread_safe = 1;
+    }
+
+    return CSTL_OK;
+}
+
+/**
+ * @brief 禁用线程安全
+ *
+ * @param map 有序扁平映射指针
+ * @return error_code_t 错误码
+ */
+error_code_t flat_map_disable_thread_safety(flat_map_t* map)
+{
+    if (map == NULL) {
+        return CSTL_ERROR_NULL_POINTER;
+    }
+
+    flat_map_lock(map);
+
+    if (map->thread_safe) {
+        map->thread_safe = 0;
+        mutex_unlock(&map->lock);
+        mutex_destroy(&map->lock);
+    }
+
+    return CSTL_OK;
+}
+
+/**
+ * @brief 创建有序扁平集合
+ *
+ * @param key_size 键大小
+ * @param compare 键的比较函数指针
+ * @param allocator 分配器指针，如果为NULL则使用默认分配器
+ * @param destructor 键的析构函数指针，为NULL时不调用
+ * @return flat_set_t* 有序扁平集合指针，失败返回NULL
+ */
+flat_set_t* flat_set_create(size_t key_size, comparator_fn_t compare, allocator_t* allocator,
+                            destructor_fn_t destructor)
+{
+    if (!flat_map_valid_key(key_size, compare)) {
+        return NULL;
+    }
+
+    flat_set_t* set = (flat_set_t*)malloc(sizeof(flat_set_t));
+    if (set == NULL) {
+        return NULL;
+    }
+
+    if (flat_map_init(&set->map, key_size, 0, compare, FLAT_MAP_SEPARATE, allocator,
+                      destructor, NULL) != CSTL_OK) {
+        free(set);
+        return NULL;
+    }
+
+    return set;
+}
+
+/**
+ * @brief 销毁有序扁平集合
+ *
+ * @param set 有序扁平集合指针
+ */
+void flat_set_destroy(flat_set_t* set)
+{
+    if (set == NULL) {
+        return;
+    }
+
+    flat_map_release(&set->map);
+    free(set);
+}
+
+/**
+ * @brief 清空有序扁平集合
+ *
+ * @param set 有序扁平集合指针
+ */
+void flat_set_clear(flat_set_t* set)
+{
+    if (set == NULL) {
+        return;
+    }
+
+    flat_map_clear(&set->map);
+}
+
+/**
+ * @brief 获取有序扁平集合大小
+ *
+ * @param set 有序扁平集合指针
+ * @return size_t 键数量
+ */
+size_t flat_set_size(const flat_set_t* set)
+{
+    return set != NULL ? flat_map_size(&set->map) : 0;
+}
+
+/**
+ * @brief 检查有序扁平集合是否为空
+ *
+ * @param set 有序扁平集合指针
+ * @return int 如果为空返回非零，否则返回零
+ */
+int flat_set_empty(const flat_set_t* set)
+{
+    return set != NULL ? flat_map_empty(&set->map) : 1;
+}
+
+/**
+ * @brief 预留容量
+ *
+ * @param set 有序扁平集合指针
+ * @param capacity 键容量
+ * @return error_code_t 错误码
+ */
+error_code_t flat_set_reserve(flat_set_t* set, size_t capacity)
+{
+    return set != NULL ? flat_map_reserve(&set->map, capacity) : CSTL_ERROR_NULL_POINTER;
+}
+
+/**
+ * @brief 插入键
+ *
+ * @param set 有序扁平集合指针
+ * @param key 键指针
+ * @return error_code_t 错误码，键已经存在时返回CSTL_ERROR_ALREADY_EXISTS
+ */
+error_code_t flat_set_insert(flat_set_t* set, const void* key)
+{
+    return set != NULL ? flat_map_insert(&set->map, key, NULL) : CSTL_ERROR_NULL_POINTER;
+}
+
+/**
+ * @brief 删除键
+ *
+ * @param set 有序扁平集合指针
+ * @param key 键指针
+ * @return error_code_t 错误码，键不存在时返回CSTL_ERROR_NOT_FOUND
+ */
+error_code_t flat_set_erase(flat_set_t* set, const void* key)
+{
+    return set != NULL ? flat_map_erase(&set->map, key) : CSTL_ERROR_NULL_POINTER;
+}
+
+/**
+ * @brief 检查键是否存在
+ *
+ * @param set 有序扁平集合指针
+ * @param key 键指针
+ * @return int 如果键存在返回非零，否则返回零
+ */
+int flat_set_contains(const flat_set_t* set, const void* key)
+{
+    return set != NULL ? flat_map_contains(&set->map, key) : 0;
+}
+
+/**
+ * @brief 查找第一个不小于key的键的位置
+ *
+ * @param set 有序扁平集合指针
+ * @param key 键指针
+ * @param index 输出参数，存储位置
+ * @return error_code_t 错误码
+ */
+error_code_t flat_set_lower_bound(const flat_set_t* set, const void* key, size_t* index)
+{
+    return set != NULL ? flat_map_lower_bound(&set->map, key, index) : CSTL_ERROR_NULL_POINTER;
+}
+
+/**
+ * @brief 获取第index小的键
+ *
+ * @param set 有序扁平集合指针
+ * @param index 位置
+ * @return void* 键指针，index越界时返回NULL
+ */
+void* flat_set_at(const flat_set_t* set, size_t index)
+{
+    return set != NULL ? flat_map_key_at(&set->map, index) : NULL;
+}
+
+/**
+ * @brief 获取有序的键数组
+ *
+ * @param set 有序扁平集合指针
+ * @return void* 键数组，集合为空时可能为NULL
+ */
+void* flat_set_data(const flat_set_t* set)
+{
+    return set != NULL ? set->map.keys->data : NULL;
+}
+
+/**
+ * @brief 用无序的键数组重建有序扁平集合
+ *
+ * @param set 有序扁平集合指针
+ * @param keys 键数组
+ * @param count 键数量
+ * @return error_code_t 错误码
+ */
+error_code_t flat_set_build(flat_set_t* set, const void* keys, size_t count)
+{
+    return set != NULL ? flat_map_build(&set->map, keys, NULL, count) : CSTL_ERROR_NULL_POINTER;
+}
+
+/**
+ * @brief 成批插入无序的键
+ *
+ * @param set 有序扁平集合指针
+ * @param keys 键数组
+ * @param count 键数量
+ * @param inserted 输出参数，存储实际插入的数量，可以为NULL
+ * @return error_code_t 错误码
+ */
+error_code_t flat_set_insert_batch(flat_set_t* set, const void* keys, size_t count, size_t* inserted)
+{
+    return set != NULL ? flat_map_insert_batch(&set->map, keys, NULL, count, inserted) : CSTL_ERROR_NULL_POINTER;
+}
+
+/**
+ * @brief 启用线程安全
+ *
+ * @param set 有序扁平集合指针
+ * @return error_code_t 错误码
+ */
+error_code_t flat_set_enable_thread_safety(flat_set_t* set)
+{
+    return set != NULL ? flat_map_enable_thread_safety(&set->map) : CSTL_ERROR_NULL_POINTER;
+}
+
+/**
+ * @brief 禁用线程安全
+ *
+ * @param set 有序扁平集合指针
+ * @return error_code_t 错误码
+ */
+error_code_t flat_set_disable_thread_safety(flat_set_t* set)
+{
+    return set != NULL ? flat_map_disable_thread_safety(&set->map) : CSTL_ERROR_NULL_POINTER;
+}
+
+/**
+ * @brief 获取有序扁平集合起始迭代器
+ *
+ * @param set 有序扁平集合指针
+ * @return iterator_t* 起始迭代器指针，失败返回NULL
+ */
+iterator_t* flat_set_begin(flat_set_t* set)
+{
+    return set != NULL ? vector_begin(set->map.keys) : NULL;
+}
+
+/**
+ * @brief 获取有序扁平集合结束迭代器
+ *
+ * @param set 有序扁平集合指针
+ * @return iterator_t* 结束迭代器指针，失败返回NULL
+ */
+iterator_t* flat_set_end(flat_set_t* set)
+{
+    return set != NULL ? vector_end(set->map.keys) : NULL;
+}
@@ -0,0 +1,1056 @@
+/**
+ * @file ilist.c
+ * @brief CSTL库的侵入式双向链表容器实现
+ *
+ * 该文件实现了CSTL库的侵入式双向链表容器。所有操作只修改对象中钩子的指针，
+ * 除了ilist_create分配链表结构体和迭代器本身以外不分配内存。
+ */
+
+#include "cstl/ilist.h"
+#include <stdlib.h>
+#include <string.h>
+
+/**
+ * @brief 排序时的有序段槽位数量，与list_sort相同
+ */
+#define ILIST_SORT_BINS 64
+
+/**
+ * @brief 侵入式双向链表迭代器结构体
+ */
+typedef struct ilist_iterator_t {
+    iterator_t base;         /**< 基础迭代器 */
+    ilist_hook_t* hook;      /**< 当前钩子 */
+} ilist_iterator_t;
+
+/**
+ * @brief 由对象指针得到钩子指针
+ *
+ * @param list 侵入式双向链表容器指针
+ * @param object 对象指针
+ * @return ilist_hook_t* 钩子指针
+ */
+static ilist_hook_t* ilist_hook_of(const ilist_t* list, const void* object)
+{
+    return (ilist_hook_t*)((char*)object + list->hook_offset);
+}
+
+/**
+ * @brief 由钩子指针得到对象指针
+ *
+ * @param list 侵入式双向链表容器指针
+ * @param hook 钩子指针，可以为NULL
+ * @return void* 对象指针，hook为NULL时返回NULL
+ */
+static void* ilist_object_of(const ilist_t* list, const ilist_hook_t* hook)
+{
+    return hook != NULL ? (char*)hook - list->hook_offset : NULL;
+}
+
+/**
+ * @brief 侵入式双向链表迭代器next函数实现
+ *
+ * @param iterator 迭代器指针
+ * @return error_code_t 错误码
+ */
+static error_code_t ilist_iterator_next(iterator_t* iterator)
+{
+    if (iterator == NULL) {
+        return CSTL_ERROR_NULL_POINTER;
+    }
+
+    ilist_iterator_t* ilist_iter = (ilist_iterator_t*)iterator;
+
+    if (ilist_iter->hook == NULL) {
+        return CSTL_ERROR_ITERATOR_END;
+    }
+
+    ilist_iter->hook = ilist_iter->hook->next;
+    iterator->current = ilist_object_of((const ilist_t*)iterator->container, ilist_iter->hook);
+
+    return CSTL_OK;
+}
+
+/**
+ * @brief 侵入式双向链表迭代器prev函数实现
+ *
+ * 结束迭代器后退到尾对象，与向量迭代器的行为一致，可以用于需要双向迭代的算法。
+ *
+ * @param iterator 迭代器指针
+ * @return error_code_t 错误码
+ */
+static error_code_t ilist_iterator_prev(iterator_t* iterator)
+{
+    if (iterator == NULL) {
+        return CSTL_ERROR_NULL_POINTER;
+    }
+
+    ilist_iterator_t* ilist_iter = (ilist_iterator_t*)iterator;
+    const ilist_t* list = (const ilist_t*)iterator->container;
+
+    ilist_hook_t* prev = ilist_iter->hook != NULL ? ilist_iter->hook->prev : list->tail;
+    if (prev == NULL) {
+        return CSTL_ERROR_ITERATOR_END;
+    }
+
+    ilist_iter->hook = prev;
+    iterator->current = ilist_object_of(list, prev);
+
+    return CSTL_OK;
+}
+
+/**
+ * @brief 侵入式双向链表迭代器get函数实现
+ *
+ * @param iterator 迭代器指针
+ * @param data 输出参数，存储当前对象指针
+ * @return error_code_t 错误码
+ */
+static error_code_t ilist_iterator_get(iterator_t* iterator, void** data)
+{
+    if (iterator == NULL || data == NULL) {
+        return CSTL_ERROR_NULL_POINTER;
+    }
+
+    ilist_iterator_t* ilist_iter = (ilist_iterator_t*)iterator;
+
+    if (ilist_iter->hook == NULL) {
+        return CSTL_ERROR_ITERATOR_END;
+    }
+
+    *data = iterator->current;
+    return CSTL_OK;
+}
+
+/**
+ * @brief 侵入式双向链表迭代器valid函数实现
+ *
+ * @param iterator 迭代器指针
+ * @return int 如果有效返回非零，否则返回零
+ */
+static int ilist_iterator_valid(iterator_t* iterator)
+{
+    if (iterator == NULL) {
+        return 0;
+    }
+
+    ilist_iterator_t* ilist_iter = (ilist_iterator_t*)iterator;
+    return ilist_iter->hook != NULL;
+}
+
+/**
+ * @brief 侵入式双向链表迭代器destroy函数实现
+ *
+ * @param iterator 迭代器指针
+ */
+static void ilist_iterator_destroy(iterator_t* iterator)
+{
+    /* 不需要特殊处理，迭代器将在iterator_destroy中释放 */
+    (void)iterator;
+}
+
+/**
+ * @brief 侵入式双向链表迭代器clone函数实现
+ *
+ * @param iterator 迭代器指针
+ * @return iterator_t* 克隆的迭代器指针，失败返回NULL
+ */
+static iterator_t* ilist_iterator_clone(iterator_t* iterator)
+{
+    if (iterator == NULL) {
+        return NULL;
+    }
+
+    ilist_iterator_t* ilist_iter = (ilist_iterator_t*)iterator;
+    ilist_iterator_t* new_ilist_iter = (ilist_iterator_t*)malloc(sizeof(ilist_iterator_t));
+    if (new_ilist_iter == NULL) {
+        return NULL;
+    }
+
+    /* 复制基础迭代器和当前钩子 */
+    new_ilist_iter->base = ilist_iter->base;
+    new_ilist_iter->hook = ilist_iter->hook;
+
+    return (iterator_t*)new_ilist_iter;
+}
+
+/**
+ * @brief 锁定侵入式双向链表容器（如果启用线程安全）
+ *
+ * @param list 侵入式双向链表容器指针
+ */
+static void ilist_lock(ilist_t* list)
+{
+    if (list != NULL && list->thread_safe) {
+        mutex_lock(&list->lock);
+    }
+}
+
+/**
+ * @brief 解锁侵入式双向链表容器（如果启用线程安全）
+ *
+ * @param list 侵入式双向链表容器指针
+ */
+static void ilist_unlock(ilist_t* list)
+{
+    if (list != NULL && list->thread_safe) {
+        mutex_unlock(&list->lock);
+    }
+}
+
+/**
+ * @brief 锁定两个链表，同一个链表只锁定一次
+ *
+ * @param dst 目标链表
+ * @param src 源链表
+ */
+static void ilist_lock_pair(ilist_t* dst, ilist_t* src)
+{
+    /* 按地址顺序加锁，两个线程反向转移时不会互相等待 */
+    if (src != dst && (uintptr_t)src < (uintptr_t)dst) {
+        ilist_lock(src);
+        ilist_lock(dst);
+    } else {
+        ilist_lock(dst);
+        if (src != dst) {
+            ilist_lock(src);
+        }
+    }
+}
+
+/**
+ * @brief 解锁ilist_lock_pair锁定的两个链表
+ *
+ * @param dst 目标链表
+ * @param src 源链表
+ */
+static void ilist_unlock_pair(ilist_t* dst, ilist_t* src)
+{
+    if (src != dst && (uintptr_t)src < (uintptr_t)dst) {
+        ilist_unlock(dst);
+        ilist_unlock(src);
+    } else {
+        if (src != dst) {
+            ilist_unlock(src);
+        }
+        ilist_unlock(dst);
+    }
+}
+
+/**
+ * @brief 把钩子链接到position之前，position为NULL时链接到末尾
+ *
+ * @param list 侵入式双向链表容器指针
+ * @param position 链表中的钩子指针
+ * @param hook 要链接的钩子指针
+ */
+static void ilist_link_before(ilist_t* list, ilist_hook_t* position, ilist_hook_t* hook)
+{
+    hook->next = position;
+    hook->prev = position != NULL ? position->prev : list->tail;
+
+    if (hook->prev != NULL) {
+        hook->prev->next = hook;
+    } else {
+        list->head = hook;
+    }
+
+    if (position != NULL) {
+        position->prev = hook;
+    } else {
+        list->tail = hook;
+    }
+
+    list->size++;
+}
+
+/**
+ * @brief 断开钩子的链接，并把它的指针置为NULL
+ *
+ * @param list 侵入式双向链表容器指针
+ * @param hook 链表中的钩子指针
+ */
+static void ilist_unlink(ilist_t* list, ilist_hook_t* hook)
+{
+    if (hook->prev != NULL) {
+        hook->prev->next = hook->next;
+    } else {
+        list->head = hook->next;
+    }
+
+    if (hook->next != NULL) {
+        hook->next->prev = hook->prev;
+    } else {
+        list->tail = hook->prev;
+    }
+
+    hook->prev = NULL;
+    hook->next = NULL;
+    list->size--;
+}
+
+/**
+ * @brief 创建侵入式双向链表容器
+ *
+ * 只分配链表结构体本身，之后的所有操作都不再分配内存。
+ *
+ * @param hook_offset 钩子在对象中的偏移
+ * @param element_size 对象大小
+ * @param destructor 释放函数指针，ilist_clear等移除对象时调用，为NULL时不释放对象
+ * @return ilist_t* 侵入式双向链表容器指针，失败返回NULL
+ */
+ilist_t* ilist_create(size_t hook_offset, size_t element_size, destructor_fn_t destructor)
+{
+    ilist_t* list = (ilist_t*)malloc(sizeof(ilist_t));
+    if (list == NULL) {
+        return NULL;
+    }
+
+    error_code_t result = ilist_init(list, hook_offset, element_size);
+    if (result != CSTL_OK) {
+        free(list);
+        return NULL;
+    }
+
+    list->destructor = destructor;
+
+    return list;
+}
+
+/**
+ * @brief 销毁侵入式双向链表容器，先执行ilist_clear
+ *
+ * @param list 侵入式双向链表容器指针
+ */
+void ilist_destroy(ilist_t* list)
+{
+    if (list == NULL) {
+        return;
+    }
+
+    ilist_clear(list);
+
+    /* 销毁互斥锁 */
+    if (list->thread_safe) {
+        mutex_destroy(&list->lock);
+    }
+
+    free(list);
+}
+
+/**
+ * @brief 初始化侵入式双向链表容器，用于嵌入在其他结构体中或放在栈上的链表
+ *
+ * @param list 侵入式双向链表容器指针
+ * @param hook_offset 钩子在对象中的偏移
+ * @param element_size 对象大小
+ * @return error_code_t 错误码
+ */
+error_code_t ilist_init(ilist_t* list, size_t hook_offset, size_t element_size)
+{
+    if (list == NULL) {
+        return CSTL_ERROR_NULL_POINTER;
+    }
+
+    /* 钩子必须完整地位于对象内 */
+    if (element_size < sizeof(ilist_hook_t) || hook_offset > element_size - sizeof(ilist_hook_t)) {
+        return CSTL_ERROR_INVALID_ARGUMENT;
+    }
+
+    list->head = NULL;
+    list->tail = NULL;
+    list->size = 0;
+    list->hook_offset = hook_offset;
+    list->element_size = element_size;
+    list->thread_safe = 0;
+    list->destructor = NULL;
+
+    return CSTL_OK;
+}
+
+/**
+ * @brief 清空侵入式双向链表容器
+ *
+ * 断开所有对象的链接，设置了释放函数时对每个对象调用它。
+ *
+ * @param list 侵入式双向链表容器指针
+ */
+void ilist_clear(ilist_t* list)
+{
+    if (list == NULL) {
+        return;
+    }
+
+    ilist_lock(list);
+
+    /* 先取得下一个钩子，释放函数可能会释放钩子所在的对象 */
+    ilist_hook_t* hook = list->head;
+    while (hook != NULL) {
+        ilist_hook_t* next = hook->next;
+        hook->prev = NULL;
+        hook->next = NULL;
+        if (list->destructor != NULL) {
+            list->destructor(ilist_object_of(list, hook));
+        }
+        hook = next;
+    }
+
+    list->head = NULL;
+    list->tail = NULL;
+    list->size = 0;
+
+    ilist_unlock(list);
+}
+
+/**
+ * @brief 获取侵入式双向链表容器大小
+ *
+ * @param list 侵入式双向链表容器指针
+ * @return size_t 对象数量
+ */
+size_t ilist_size(const ilist_t* list)
+{
+    if (list == NULL) {
+        return 0;
+    }
+
+    return list->size;
+}
+
+/**
+ * @brief 检查侵入式双向链表容器是否为空
+ *
+ * @param list 侵入式双向链表容器指针
+ * @return int 如果为空返回非零，否则返回零
+ */
+int ilist_empty(const ilist_t* list)
+{
+    if (list == NULL) {
+        return 1;
+    }
+
+    return list->size == 0;
+}
+
+/**
+ * @brief 把对象链接到前端
+ *
+ * @param list 侵入式双向链表容器指针
+ * @param object 对象指针，其钩子不能位于任何链表中
+ * @return error_code_t 错误码
+ */
+error_code_t ilist_push_front(ilist_t* list, void* object)
+{
+    if (list == NULL || object == NULL) {
+        return CSTL_ERROR_NULL_POINTER;
+    }
+
+    ilist_lock(list);
+    ilist_link_before(list, list->head, ilist_hook_of(list, object));
+    ilist_unlock(list);
+
+    return CSTL_OK;
+}
+
+/**
+ * @brief 把对象链接到后端
+ *
+ * @param list 侵入式双向链表容器指针
+ * @param object 对象指针，其钩子不能位于任何链表中
+ * @return error_code_t 错误码
+ */
+error_code_t ilist_push_back(ilist_t* list, void* object)
+{
+    if (list == NULL || object == NULL) {
+        return CSTL_ERROR_NULL_POINTER;
+    }
+
+    ilist_lock(list);
+    ilist_link_before(list, NULL, ilist_hook_of(list, object));
+    ilist_unlock(list);
+
+    return CSTL_OK;
+}
+
+/**
+ * @brief 断开前端对象的链接
+ *
+ * @param list 侵入式双向链表容器指针
+ * @param object 输出参数，存储被断开的对象指针，可以为NULL
+ * @return error_code_t 错误码
+ */
+error_code_t ilist_pop_front(ilist_t* list, void** object)
+{
+    if (list == NULL) {
+        return CSTL_ERROR_NULL_POINTER;
+    }
+
+    ilist_lock(list);
+
+    ilist_hook_t* hook = list->head;
+    if (hook == NULL) {
+        ilist_unlock(list);
+        return CSTL_ERROR_CONTAINER_EMPTY;
+    }
+
+    ilist_unlink(list, hook);
+    if (object != NULL) {
+        *object = ilist_object_of(list, hook);
+    }
+
+    ilist_unlock(list);
+    return CSTL_OK;
+}
+
+/**
+ * @brief 断开后端对象的链接
+ *
+ * @param list 侵入式双向链表容器指针
+ * @param object 输出参数，存储被断开的对象指针，可以为NULL
+ * @return error_code_t 错误码
+ */
+error_code_t ilist_pop_back(ilist_t* list, void** object)
+{
+    if (list == NULL) {
+        return CSTL_ERROR_NULL_POINTER;
+    }
+
+    ilist_lock(list);
+
+    ilist_hook_t* hook = list->tail;
+    if (hook == NULL) {
+        ilist_unlock(list);
+        return CSTL_ERROR_CONTAINER_EMPTY;
+    }
+
+    ilist_unlink(list, hook);
+    if (object != NULL) {
+        *object = ilist_object_of(list, hook);
+    }
+
+    ilist_unlock(list);
+    return CSTL_OK;
+}
+
+/**
+ * @brief 获取前端对象
+ *
+ * @param list 侵入式双向链表容器指针
+ * @param object 输出参数，存储对象指针
+ * @return error_code_t 错误码
+ */
+error_code_t ilist_front(const ilist_t* list, void** object)
+{
+    if (list == NULL || object == NULL) {
+        return CSTL_ERROR_NULL_POINTER;
+    }
+
+    if (list->head == NULL) {
+        return CSTL_ERROR_CONTAINER_EMPTY;
+    }
+
+    *object = ilist_object_of(list, list->head);
+    return CSTL_OK;
+}
+
+/**
+ * @brief 获取后端对象
+ *
+ * @param list 侵入式双向链表容器指针
+ * @param object 输出参数，存储对象指针
+ * @return error_code_t 错误码
+ */
+error_code_t ilist_back(const ilist_t* list, void** object)
+{
+    if (list == NULL || object == NULL) {
+        return CSTL_ERROR_NULL_POINTER;
+    }
+
+    if (list->tail == NULL) {
+        return CSTL_ERROR_CONTAINER_EMPTY;
+    }
+
+    *object = ilist_object_of(list, list->tail);
+    return CSTL_OK;
+}
+
+/**
+ * @brief 在指定对象前链接对象
+ *
+ * @param list 侵入式双向链表容器指针
+ * @param position 链表中的对象指针，为NULL时链接到后端
+ * @param object 要链接的对象指针
+ * @return error_code_t 错误码
+ */
+error_code_t ilist_insert_before(ilist_t* list, void* position, void* object)
+{
+    if (list == NULL || object == NULL) {
+        return CSTL_ERROR_NULL_POINTER;
+    }
+
+    ilist_lock(list);
+    ilist_link_before(list, position != NULL ? ilist_hook_of(list, position) : NULL,
+                      ilist_hook_of(list, object));
+    ilist_unlock(list);
+
+    return CSTL_OK;
+}
+
+/**
+ * @brief 在指定对象后链接对象
+ *
+ * @param list 侵入式双向链表容器指针
+ * @param position 链表中的对象指针，为NULL时链接到前端
+ * @param object 要链接的对象指针
+ * @return error_code_t 错误码
+ */
+error_code_t ilist_insert_after(ilist_t* list, void* position, void* object)
+{
+    if (list == NULL || object == NULL) {
+        return CSTL_ERROR_NULL_POINTER;
+    }
+
+    ilist_lock(list);
+    ilist_link_before(list, position != NULL ? ilist_hook_of(list, position)->next : list->head,
+                      ilist_hook_of(list, object));
+    ilist_unlock(list);
+
+    return CSTL_OK;
+}
+
+/**
+ * @brief 断开指定对象的链接，O(1)，不调用释放函数
+ *
+ * @param list 侵入式双向链表容器指针
+ * @param object 链表中的对象指针
+ * @return error_code_t 错误码
+ */
+error_code_t ilist_erase(ilist_t* list, void* object)
+{
+    if (list == NULL || object == NULL) {
+        return CSTL_ERROR_NULL_POINTER;
+    }
+
+    ilist_lock(list);
+    ilist_unlink(list, ilist_hook_of(list, object));
+    ilist_unlock(list);
+
+    return CSTL_OK;
+}
+
+/**
+ * @brief 移除所有满足谓词的对象，设置了释放函数时对移除的对象调用它
+ *
+ * @param list 侵入式双向链表容器指针
+ * @param predicate 谓词函数指针，返回非零的对象被移除
+ * @return error_code_t 错误码
+ */
+error_code_t ilist_remove_if(ilist_t* list, predicate_fn_t predicate)
+{
+    if (list == NULL || predicate == NULL) {
+        return CSTL_ERROR_NULL_POINTER;
+    }
+
+    ilist_lock(list);
+
+    ilist_hook_t* hook = list->head;
+    while (hook != NULL) {
+        ilist_hook_t* next = hook->next;
+        void* object = ilist_object_of(list, hook);
+
+        if (predicate(object)) {
+            ilist_unlink(list, hook);
+            if (list->destructor != NULL) {
+                list->destructor(object);
+            }
+        }
+
+        hook = next;
+    }
+
+    ilist_unlock(list);
+    return CSTL_OK;
+}
+
+/**
+ * @brief 查找指定元素
+ *
+ * @param list 侵入式双向链表容器指针
+ * @param element 要查找的元素指针
+ * @param comparator 比较函数指针
+ * @return void* 找到的对象指针，未找到返回NULL
+ */
+void* ilist_find(const ilist_t* list, const void* element, comparator_fn_t comparator)
+{
+    if (list == NULL || element == NULL || comparator == NULL) {
+        return NULL;
+    }
+
+    for (ilist_hook_t* hook = list->head; hook != NULL; hook = hook->next) {
+        void* object = ilist_object_of(list, hook);
+        if (comparator(object, element) == 0) {
+            return object;
+        }
+    }
+
+    return NULL;
+}
+
+/**
+ * @brief 获取链表中下一个对象
+ *
+ * @param list 侵入式双向链表容器指针
+ * @param object 链表中的对象指针
+ * @return void* 下一个对象指针，object是尾对象时返回NULL
+ */
+void* ilist_next(const ilist_t* list, const void* object)
+{
+    if (list == NULL || object == NULL) {
+        return NULL;
+    }
+
+    return ilist_object_of(list, ilist_hook_of(list, object)->next);
+}
+
+/**
+ * @brief 获取链表中上一个对象
+ *
+ * @param list 侵入式双向链表容器指针
+ * @param object 链表中的对象指针
+ * @return void* 上一个对象指针，object是头对象时返回NULL
+ */
+void* ilist_prev(const ilist_t* list, const void* object)
+{
+    if (list == NULL || object == NULL) {
+        return NULL;
+    }
+
+    return ilist_object_of(list, ilist_hook_of(list, object)->prev);
+}
+
+/**
+ * @brief 反转侵入式双向链表容器
+ *
+ * @param list 侵入式双向链表容器指针
+ * @return error_code_t 错误码
+ */
+error_code_t ilist_reverse(ilist_t* list)
+{
+    if (list == NULL) {
+        return CSTL_ERROR_NULL_POINTER;
+    }
+
+    ilist_lock(list);
+
+    ilist_hook_t* hook = list->head;
+    list->head = list->tail;
+    list->tail = hook;
+
+    /* 交换每个钩子的前后指针 */
+    while (hook != NULL) {
+        ilist_hook_t* temp = hook->prev;
+        hook->prev = hook->next;
+        hook->next = temp;
+        hook = hook->prev;
+    }
+
+    ilist_unlock(list);
+    return CSTL_OK;
+}
+
+/**
+ * @brief 把src的所有对象移动到dst中position之前，O(1)
+ *
+ * 两个链表的钩子偏移必须相同，否则返回CSTL_ERROR_INVALID_ARGUMENT。
+ *
+ * @param dst 目标链表
+ * @param position dst中的对象指针，为NULL时移动到末尾
+ * @param src 源链表，不能与dst相同，完成后为空
+ * @return error_code_t 错误码
+ */
+error_code_t ilist_splice(ilist_t* dst, void* position, ilist_t* src)
+{
+    if (dst == NULL || src == NULL) {
+        return CSTL_ERROR_NULL_POINTER;
+    }
+
+    if (dst == src || dst->hook_offset != src->hook_offset) {
+        return CSTL_ERROR_INVALID_ARGUMENT;
+    }
+
+    ilist_lock_pair(dst, src);
+
+    if (src->head != NULL) {
+        ilist_hook_t* next = position != NULL ? ilist_hook_of(dst, position) : NULL;
+        ilist_hook_t* prev = next != NULL ? next->prev : dst->tail;
+
+        src->head->prev = prev;
+        src->tail->next = next;
+        if (prev != NULL) {
+            prev->next = src->head;
+        } else {
+            dst->head = src->head;
+        }
+        if (next != NULL) {
+            next->prev = src->tail;
+        } else {
+            dst->tail = src->tail;
+        }
+        dst->size += src->size;
+
+        src->head = NULL;
+        src->tail = NULL;
+        src->size = 0;
+    }
+
+    ilist_unlock_pair(dst, src);
+    return CSTL_OK;
+}
+
+/**
+ * @brief 把src中的一个对象移动到dst中position之前，O(1)
+ *
+ * dst和src可以是同一个链表，用于在链表内移动对象（如把最近访问的会话移到前端）。
+ *
+ * @param dst 目标链表
+ * @param position dst中的对象指针，为NULL时移动到末尾
+ * @param src 源链表
+ * @param object 要移动的src中的对象指针
+ * @return error_code_t 错误码
+ */
+error_code_t ilist_splice_node(ilist_t* dst, void* position, ilist_t* src, void* object)
+{
+    if (dst == NULL || src == NULL || object == NULL) {
+        return CSTL_ERROR_NULL_POINTER;
+    }
+
+    if (dst->hook_offset != src->hook_offset) {
+        return CSTL_ERROR_INVALID_ARGUMENT;
+    }
+
+    /* 移动到自身之前或原位置，链表不变 */
+    if (position == object) {
+        return CSTL_OK;
+    }
+
+    ilist_lock_pair(dst, src);
+
+    ilist_hook_t* hook = ilist_hook_of(src, object);
+    ilist_hook_t* next = position != NULL ? ilist_hook_of(dst, position) : NULL;
+    if (dst != src || hook->next != next) {
+        ilist_unlink(src, hook);
+        ilist_link_before(dst, next, hook);
+    }
+
+    ilist_unlock_pair(dst, src);
+    return CSTL_OK;
+}
+
+/**
+ * @brief 合并两个以NULL结尾的有序单链，只维护next指针
+ *
+ * 相等时取a中的钩子，a中的钩子在原链表中位于b之前，因此合并是稳定的。
+ *
+ * @param list 侵入式双向链表容器指针
+ * @param a 第一个有序段
+ * @param b 第二个有序段
+ * @param comparator 比较函数指针
+ * @return ilist_hook_t* 合并后的有序段
+ */
+static ilist_hook_t* ilist_sort_merge_runs(const ilist_t* list, ilist_hook_t* a, ilist_hook_t* b,
+                                           comparator_fn_t comparator)
+{
+    ilist_hook_t head;
+    ilist_hook_t* tail = &head;
+
+    while (a != NULL && b != NULL) {
+        if (comparator(ilist_object_of(list, a), ilist_object_of(list, b)) <= 0) {
+            tail->next = a;
+            a = a->next;
+        } else {
+            tail->next = b;
+            b = b->next;
+        }
+        tail = tail->next;
+    }
+    tail->next = a != NULL ? a : b;
+
+    return head.next;
+}
+
+/**
+ * @brief 排序侵入式双向链表容器
+ *
+ * 稳定排序，与list_sort相同的非递归自底向上归并，只修改钩子指针，不分配内存。
+ *
+ * @param list 侵入式双向链表容器指针
+ * @param comparator 比较函数指针，参数为对象指针
+ * @return error_code_t 错误码
+ */
+error_code_t ilist_sort(ilist_t* list, comparator_fn_t comparator)
+{
+    if (list == NULL || comparator == NULL) {
+        return CSTL_ERROR_NULL_POINTER;
+    }
+
+    ilist_lock(list);
+
+    if (list->size < 2) {
+        ilist_unlock(list);
+        return CSTL_OK;
+    }
+
+    /* 与槽位中等长的有序段逐级合并，槽位中的有序段来自更早的钩子 */
+    ilist_hook_t* bins[ILIST_SORT_BINS] = {0};
+    size_t fill = 0;
+    ilist_hook_t* hook = list->head;
+
+    while (hook != NULL) {
+        ilist_hook_t* carry = hook;
+        hook = hook->next;
+        carry->next = NULL;
+
+        size_t i = 0;
+        while (i < fill && bins[i] != NULL) {
+            carry = ilist_sort_merge_runs(list, bins[i], carry, comparator);
+            bins[i] = NULL;
+            i++;
+        }
+        bins[i] = carry;
+        if (i == fill) {
+            fill++;
+        }
+    }
+
+    ilist_hook_t* result = NULL;
+    for (size_t i = 0; i < fill; i++) {
+        if (bins[i] != NULL) {
+            result = result != NULL ? ilist_sort_merge_runs(list, bins[i], result, comparator) : bins[i];
+        }
+    }
+
+    /* 恢复prev指针和尾钩子 */
+    ilist_hook_t* prev = NULL;
+    for (hook = result; hook != NULL; hook = hook->next) {
+        hook->prev = prev;
+        prev = hook;
+    }
+    list->head = result;
+    list->tail = prev;
+
+    ilist_unlock(list);
+    return CSTL_OK;
+}
+
+/**
+ * @brief 启用线程安全
+ *
+ * @param list 侵入式双向链表容器指针
+ * @return error_code_t 错误码
+ */
+error_code_t ilist_enable_thread_safety(ilist_t* list)
+{
+    if (list == NULL) {
+        return CSTL_ERROR_NULL_POINTER;
+    }
+
+    if (!list->thread_safe) {
+        error_code_t result = mutex_init(&list->lock);
+        if (result != CSTL_OK) {
+            return result;
+        }
+        list->thread_safe = 1;
+    }
+
+    return CSTL_OK;
+}
+
+/**
+ * @brief 禁用线程安全
+ *
+ * @param list 侵入式双向链表容器指针
+ * @return error_code_t 错误码
+ */
+error_code_t ilist_disable_thread_safety(ilist_t* list)
+{
+    if (list == NULL) {
+        return CSTL_ERROR_NULL_POINTER;
+    }
+
+    ilist_lock(list);
+
+    if (list->thread_safe) {
+        list->thread_safe = 0;
+        mutex_unlock(&list->lock);
+        mutex_destroy(&list->lock);
+    }
+
+    return CSTL_OK;
+}
+
+/**
+ * @brief 创建侵入式双向链表容器迭代器
+ *
+ * @param list 侵入式双向链表容器指针
+ * @param direction 迭代方向
+ * @return iterator_t* 迭代器指针，失败返回NULL
+ */
+iterator_t* ilist_iterator_create(ilist_t* list, iter_direction_t direction)
+{
+    if (list == NULL) {
+        return NULL;
+    }
+
+    ilist_iterator_t* ilist_iter = (ilist_iterator_t*)malloc(sizeof(ilist_iterator_t));
+    if (ilist_iter == NULL) {
+        return NULL;
+    }
+
+    ilist_iter->base.container = list;
+    ilist_iter->base.direction = direction;
+    ilist_iter->base.element_size = list->element_size;
+    ilist_iter->base.next = ilist_iterator_next;
+    ilist_iter->base.prev = ilist_iterator_prev;
+    ilist_iter->base.get = ilist_iterator_get;
+    ilist_iter->base.valid = ilist_iterator_valid;
+    ilist_iter->base.destroy = ilist_iterator_destroy;
+    ilist_iter->base.clone = ilist_iterator_clone;
+
+    /* 设置初始位置 */
+    ilist_iter->hook = direction == ITER_DIR_FORWARD ? list->head : list->tail;
+    ilist_iter->base.current = ilist_object_of(list, ilist_iter->hook);
+
+    return (iterator_t*)ilist_iter;
+}
+
+/**
+ * @brief 获取侵入式双向链表容器起始迭代器
+ *
+ * @param list 侵入式双向链表容器指针
+ * @return iterator_t* 起始迭代器指针，失败返回NULL
+ */
+iterator_t* ilist_begin(ilist_t* list)
+{
+    return ilist_iterator_create(list, ITER_DIR_FORWARD);
+}
+
+/**
+ * @brief 获取侵入式双向链表容器结束迭代器
+ *
+ * 结束迭代器执行prev后指向尾对象。
+ *
+ * @param list 侵入式双向链表容器指针
+ * @return iterator_t* 结束迭代器指针，失败返回NULL
+ */
+iterator_t* ilist_end(ilist_t* list)
+{
+    iterator_t* iterator = ilist_iterator_create(list, ITER_DIR_FORWARD);
+    if (iterator == NULL) {
+        return NULL;
+    }
+
+    ((ilist_iterator_t*)iterator)->hook = NULL;
+    iterator->current = NULL;
+
+    return iterator;
+}
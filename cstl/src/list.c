@@ -7,6 +7,7 @@
  */
 
 #include "cstl/list.h"
+#include "cstl/thread_pool.h"
 #include <stdlib.h>
 #include <string.h>
 #include <assert.h>
@@ -117,6 +118,31 @@ static void list_iterator_destroy(iterator_t* iterator)
     (void)iterator;
 }
 
+/**
+ * @brief 双向链表迭代器clone函数实现
+ * 
+ * @param iterator 迭代器指针
+ * @return iterator_t* 克隆的迭代器指针，失败返回NULL
+ */
+static iterator_t* list_iterator_clone(iterator_t* iterator)
+{
+    if (iterator == NULL) {
+        return NULL;
+    }
+    
+    list_iterator_t* list_iter = (list_iterator_t*)iterator;
+    list_iterator_t* new_list_iter = (list_iterator_t*)malloc(sizeof(list_iterator_t));
+    if (new_list_iter == NULL) {
+        return NULL;
+    }
+    
+    /* 复制基础迭代器和当前节点 */
+    new_list_iter->base = list_iter->base;
+    new_list_iter->node = list_iter->node;
+    
+    return (iterator_t*)new_list_iter;
+}
+
 /**
  * @brief 锁定双向链表容器（如果启用线程安全）
  * 
@@ -141,6 +167,112 @@ static void list_unlock(list_t* list)
     }
 }
 
+/**
+ * @brief 节点的索引可能改变时使游标和跳跃索引失效
+ * 
+ * @param list 双向链表容器指针
+ */
+static void list_positions_changed(list_t* list)
+{
+    list->cursor_node = NULL;
+    list->index_count = 0;
+}
+
+/**
+ * @brief 重建跳跃索引，内存不足时保持为空
+ * 
+ * @param list 双向链表容器指针，已启用跳跃索引
+ */
+static void list_skip_index_build(list_t* list)
+{
+    size_t count = (list->size + list->index_stride - 1) / list->index_stride;
+    
+    if (count > list->index_capacity) {
+        list_node_t** nodes = (list_node_t**)malloc(count * sizeof(list_node_t*));
+        if (nodes == NULL) {
+            return;
+        }
+        free(list->index_nodes);
+        list->index_nodes = nodes;
+        list->index_capacity = count;
+    }
+    
+    size_t n = 0;
+    size_t position = 0;
+    for (list_node_t* node = list->head; node != NULL; node = node->next) {
+        if (position == n * list->index_stride) {
+            list->index_nodes[n++] = node;
+        }
+        position++;
+    }
+    list->index_count = n;
+}
+
+/**
+ * @brief 定位指定索引的节点并更新游标
+ * 
+ * 从头节点、尾节点、游标和跳跃索引中离目标最近的位置出发，沿next或prev走到目标。
+ * 
+ * @param list 双向链表容器指针
+ * @param index 元素索引，必须小于链表大小
+ * @return list_node_t* 节点指针
+ */
+static list_node_t* list_locate(list_t* list, size_t index)
+{
+    list_node_t* node = list->head;
+    size_t position = 0;
+    size_t distance = index;
+    
+    if (list->size - 1 - index < distance) {
+        node = list->tail;
+        position = list->size - 1;
+        distance = list->size - 1 - index;
+    }
+    
+    if (list->cursor_node != NULL) {
+        size_t cursor = list->cursor_index;
+        size_t gap = index > cursor ? index - cursor : cursor - index;
+        if (gap < distance) {
+            node = list->cursor_node;
+            position = cursor;
+            distance = gap;
+        }
+    }
+    
+    /* 只有需要走过一个步长以上时才使用（必要时重建）跳跃索引 */
+    size_t stride = list->index_stride;
+    if (stride > 0 && distance > stride) {
+        if (list->index_count == 0) {
+            list_skip_index_build(list);
+        }
+        if (list->index_count > 0) {
+            size_t slot = (index + stride / 2) / stride;
+            if (slot >= list->index_count) {
+                slot = list->index_count - 1;
+            }
+            size_t checkpoint = slot * stride;
+            size_t gap = index > checkpoint ? index - checkpoint : checkpoint - index;
+            if (gap < distance) {
+                node = list->index_nodes[slot];
+                position = checkpoint;
+            }
+        }
+    }
+    
+    while (position < index) {
+        node = node->next;
+        position++;
+    }
+    while (position > index) {
+        node = node->prev;
+        position--;
+    }
+    
+    list->cursor_node = node;
+    list->cursor_index = index;
+    return node;
+}
+
 /**
  * @brief 创建双向链表节点
  * 
@@ -260,6 +392,7 @@ void list_destroy(list_t* list)
     }
     
     list_clear(list);
+    free(list->index_nodes);
     
     /* 销毁互斥锁 */
     if (list->thread_safe) {
@@ -296,6 +429,12 @@ error_code_t list_init(list_t* list, size_t element_size, allocator_t* allocator
     list->allocator = allocator;
     list->node_pool = NULL;
     list->thread_safe = 0;
+    list->cursor_node = NULL;
+    list->cursor_index = 0;
+    list->index_nodes = NULL;
+    list->index_count = 0;
+    list->index_capacity = 0;
+    list->index_stride = 0;
     
     return CSTL_OK;
 }
@@ -324,6 +463,7 @@ void list_clear(list_t* list)
     list->head = NULL;
     list->tail = NULL;
     list->size = 0;
+    list_positions_changed(list);
     
     list_unlock(list);
 }
@@ -391,6 +531,12 @@ error_code_t list_push_front(list_t* list, const void* element)
     
     list->size++;
     
+    /* 原有节点的索引都加一，游标仍然可用 */
+    if (list->cursor_node != NULL) {
+        list->cursor_index++;
+    }
+    list->index_count = 0;
+    
     list_unlock(list);
     return CSTL_OK;
 }
@@ -461,6 +607,14 @@ error_code_t list_pop_front(list_t* list)
         list->tail = NULL;
     }
     
+    /* 其余节点的索引都减一 */
+    if (list->cursor_node == node) {
+        list->cursor_node = NULL;
+    } else if (list->cursor_node != NULL) {
+        list->cursor_index--;
+    }
+    list->index_count = 0;
+    
     list_destroy_node(list, node);
     list->size--;
     
@@ -500,6 +654,14 @@ error_code_t list_pop_back(list_t* list)
     list_destroy_node(list, node);
     list->size--;
     
+    /* 其余节点的索引不变，只需去掉指向尾节点的游标和索引项 */
+    if (list->cursor_node == node) {
+        list->cursor_node = NULL;
+    }
+    while (list->index_count > 0 && (list->index_count - 1) * list->index_stride >= list->size) {
+        list->index_count--;
+    }
+    
     list_unlock(list);
     return CSTL_OK;
 }
@@ -605,6 +767,7 @@ error_code_t list_insert_before(list_t* list, list_node_t* position, const void*
     }
     
     list->size++;
+    list_positions_changed(list);
     
     list_unlock(list);
     return CSTL_OK;
@@ -656,6 +819,7 @@ error_code_t list_insert_after(list_t* list, list_node_t* position, const void*
     }
     
     list->size++;
+    list_positions_changed(list);
     
     list_unlock(list);
     return CSTL_OK;
@@ -693,6 +857,7 @@ error_code_t list_erase(list_t* list, list_node_t* position)
     /* 销毁节点 */
     list_destroy_node(list, position);
     list->size--;
+    list_positions_changed(list);
     
     list_unlock(list);
     return CSTL_OK;
@@ -735,6 +900,7 @@ error_code_t list_remove(list_t* list, const void* element, comparator_fn_t comp
             list->size--;
             
             node = next;
+            list_positions_changed(list);
         } else {
             node = node->next;
         }
@@ -744,6 +910,50 @@ error_code_t list_remove(list_t* list, const void* element, comparator_fn_t comp
     return CSTL_OK;
 }
 
+/**
+ * @brief 移除所有满足谓词的元素
+ * 
+ * @param list 双向链表容器指针
+ * @param predicate 谓词函数指针，返回非零的元素被移除
+ * @return error_code_t 错误码
+ */
+error_code_t list_remove_if(list_t* list, predicate_fn_t predicate)
+{
+    if (list == NULL || predicate == NULL) {
+        return CSTL_ERROR_NULL_POINTER;
+    }
+    
+    list_lock(list);
+    
+    list_node_t* node = list->head;
+    while (node != NULL) {
+        list_node_t* next = node->next;
+        
+        if (predicate(node->data)) {
+            if (node->prev != NULL) {
+                node->prev->next = next;
+            } else {
+                list->head = next;
+            }
+            
+            if (next != NULL) {
+                next->prev = node->prev;
+            } else {
+                list->tail = node->prev;
+            }
+            
+            list_destroy_node(list, node);
+            list->size--;
+            list_positions_changed(list);
+        }
+        
+        node = next;
+    }
+    
+    list_unlock(list);
+    return CSTL_OK;
+}
+
 /**
  * @brief 查找指定元素
  * 
@@ -797,6 +1007,7 @@ error_code_t list_reverse(list_t* list)
         node->next = temp;
         node = node->prev;
     }
+    list_positions_changed(list);
     
     list_unlock(list);
     return CSTL_OK;
@@ -838,10 +1049,11 @@ error_code_t list_merge(list_t* list1, list_t* list2)
     
     list1->size += list2->size;
     
-    /* 清空第二个链表 */
+    /* 清空第二个链表，第一个链表原有节点的索引不变 */
     list2->head = NULL;
     list2->tail = NULL;
     list2->size = 0;
+    list_positions_changed(list2);
     
     list_unlock(list2);
     list_unlock(list1);
@@ -849,68 +1061,570 @@ error_code_t list_merge(list_t* list1, list_t* list2)
 }
 
 /**
- * @brief 归并排序辅助函数
+ * @brief 检查两个链表之间能否直接转移节点
  * 
- * @param list 双向链表容器指针
- * @param comparator 比较函数指针
- * @return list_node_t* 排序后的链表头节点
+ * 节点由所在链表的分配器或对象池释放，因此两者必须相同。
+ * 
+ * @param dst 目标链表
+ * @param src 源链表
+ * @return int 可以转移返回1
+ */
+static int list_nodes_compatible(const list_t* dst, const list_t* src)
+{
+    return dst->element_size == src->element_size && dst->allocator == src->allocator &&
+           dst->node_pool == src->node_pool;
+}
+
+/**
+ * @brief 锁定转移节点涉及的两个链表
+ * 
+ * @param dst 目标链表
+ * @param src 源链表，可以与dst相同
+ */
+static void list_lock_pair(list_t* dst, list_t* src)
+{
+    /* 按地址顺序加锁，两个线程反向转移时不会互相等待 */
+    if (src != dst && (uintptr_t)src < (uintptr_t)dst) {
+        list_lock(src);
+        list_lock(dst);
+    } else {
+        list_lock(dst);
+        if (src != dst) {
+            list_lock(src);
+        }
+    }
+}
+
+/**
+ * @brief 解锁转移节点涉及的两个链表
+ * 
+ * @param dst 目标链表
+ * @param src 源链表，可以与dst相同
  */
-static list_node_t* list_merge_sort_helper(list_node_t* head, comparator_fn_t comparator)
+static void list_unlock_pair(list_t* dst, list_t* src)
 {
-    if (head == NULL || head->next == NULL) {
-        return head;
+    if (src != dst && (uintptr_t)src < (uintptr_t)dst) {
+        list_unlock(dst);
+        list_unlock(src);
+    } else {
+        if (src != dst) {
+            list_unlock(src);
+        }
+        list_unlock(dst);
+    }
+}
+
+/**
+ * @brief 把[first, last]从链表中摘下，不修改节点数量
+ * 
+ * @param list 链表
+ * @param first 第一个节点
+ * @param last 最后一个节点（包含）
+ */
+static void list_unlink_nodes(list_t* list, list_node_t* first, list_node_t* last)
+{
+    if (first->prev != NULL) {
+        first->prev->next = last->next;
+    } else {
+        list->head = last->next;
     }
+    if (last->next != NULL) {
+        last->next->prev = first->prev;
+    } else {
+        list->tail = first->prev;
+    }
+    list_positions_changed(list);
+}
+
+/**
+ * @brief 把已摘下的[first, last]链接到position之前，不修改节点数量
+ * 
+ * @param list 链表
+ * @param position 插入位置，为NULL时链接到末尾
+ * @param first 第一个节点
+ * @param last 最后一个节点（包含）
+ */
+static void list_link_nodes(list_t* list, list_node_t* position, list_node_t* first, list_node_t* last)
+{
+    list_node_t* prev = position != NULL ? position->prev : list->tail;
     
-    /* 使用快慢指针找到中间节点 */
-    list_node_t* slow = head;
-    list_node_t* fast = head->next;
+    first->prev = prev;
+    last->next = position;
+    if (prev != NULL) {
+        prev->next = first;
+    } else {
+        list->head = first;
+    }
+    if (position != NULL) {
+        position->prev = last;
+    } else {
+        list->tail = last;
+    }
+    list_positions_changed(list);
+}
+
+/**
+ * @brief 把src的所有节点移动到dst中position之前，O(1)
+ * 
+ * @param dst 目标链表
+ * @param position dst中的节点，为NULL时移动到末尾
+ * @param src 源链表，不能与dst相同，完成后为空
+ * @return error_code_t 错误码
+ */
+error_code_t list_splice(list_t* dst, list_node_t* position, list_t* src)
+{
+    if (dst == NULL || src == NULL) {
+        return CSTL_ERROR_NULL_POINTER;
+    }
+    if (dst == src || !list_nodes_compatible(dst, src)) {
+        return CSTL_ERROR_INVALID_ARGUMENT;
+    }
     
-    while (fast != NULL && fast->next != NULL) {
-        slow = slow->next;
-        fast = fast->next->next;
+    list_lock_pair(dst, src);
+    
+    if (src->head != NULL) {
+        list_link_nodes(dst, position, src->head, src->tail);
+        dst->size += src->size;
+        src->head = NULL;
+        src->tail = NULL;
+        src->size = 0;
+        list_positions_changed(src);
     }
     
-    /* 分割链表 */
-    list_node_t* mid = slow;
-    list_node_t* left = head;
-    list_node_t* right = mid->next;
-    mid->next = NULL;
-    right->prev = NULL;
+    list_unlock_pair(dst, src);
+    return CSTL_OK;
+}
+
+/**
+ * @brief 把src中的一个节点移动到dst中position之前，O(1)
+ * 
+ * @param dst 目标链表
+ * @param position dst中的节点，为NULL时移动到末尾
+ * @param src 源链表
+ * @param node 要移动的src中的节点
+ * @return error_code_t 错误码
+ */
+error_code_t list_splice_node(list_t* dst, list_node_t* position, list_t* src, list_node_t* node)
+{
+    if (dst == NULL || src == NULL || node == NULL) {
+        return CSTL_ERROR_NULL_POINTER;
+    }
+    if (!list_nodes_compatible(dst, src)) {
+        return CSTL_ERROR_INVALID_ARGUMENT;
+    }
+    
+    list_lock_pair(dst, src);
+    
+    /* 同一链表中移动到自身之前或之后的位置时顺序不变 */
+    if (src != dst || (position != node && position != node->next)) {
+        list_unlink_nodes(src, node, node);
+        list_link_nodes(dst, position, node, node);
+        if (src != dst) {
+            src->size--;
+            dst->size++;
+        }
+    }
+    
+    list_unlock_pair(dst, src);
+    return CSTL_OK;
+}
+
+/**
+ * @brief 把src中[first, last)范围内的节点移动到dst中position之前
+ * 
+ * @param dst 目标链表
+ * @param position dst中的节点，为NULL时移动到末尾
+ * @param src 源链表
+ * @param first 范围的第一个节点，为NULL或等于last时范围为空
+ * @param last 范围之后的第一个节点，为NULL时范围延伸到src末尾
+ * @param count 范围内的节点数量，或LIST_COUNT_UNKNOWN
+ * @return error_code_t 错误码
+ */
+error_code_t list_splice_range(list_t* dst, list_node_t* position, list_t* src,
+                               list_node_t* first, list_node_t* last, size_t count)
+{
+    if (dst == NULL || src == NULL) {
+        return CSTL_ERROR_NULL_POINTER;
+    }
+    if (!list_nodes_compatible(dst, src)) {
+        return CSTL_ERROR_INVALID_ARGUMENT;
+    }
+    if (first == NULL || first == last || (src == dst && (position == first || position == last))) {
+        return CSTL_OK;
+    }
+    
+    list_lock_pair(dst, src);
+    
+    list_node_t* range_last = last != NULL ? last->prev : src->tail;
+    if (src != dst && count == LIST_COUNT_UNKNOWN) {
+        count = 1;
+        for (list_node_t* node = first; node != range_last; node = node->next) {
+            count++;
+        }
+    }
+    
+    list_unlink_nodes(src, first, range_last);
+    list_link_nodes(dst, position, first, range_last);
+    if (src != dst) {
+        src->size -= count;
+        dst->size += count;
+    }
+    
+    list_unlock_pair(dst, src);
+    return CSTL_OK;
+}
+
+/**
+ * @brief 把有序的src合并到有序的dst中，O(n + m)次比较，不分配内存
+ * 
+ * @param dst 目标链表，按comparator有序
+ * @param src 源链表，按comparator有序，不能与dst相同
+ * @param comparator 比较函数指针
+ * @return error_code_t 错误码
+ */
+error_code_t list_merge_sorted(list_t* dst, list_t* src, comparator_fn_t comparator)
+{
+    if (dst == NULL || src == NULL || comparator == NULL) {
+        return CSTL_ERROR_NULL_POINTER;
+    }
+    if (dst == src || !list_nodes_compatible(dst, src)) {
+        return CSTL_ERROR_INVALID_ARGUMENT;
+    }
+    
+    list_lock_pair(dst, src);
+    
+    list_node_t* a = dst->head;
+    list_node_t* b = src->head;
+    if (b != NULL) {
+        list_node_t head;
+        list_node_t* tail = &head;
+        
+        while (a != NULL && b != NULL) {
+            if (comparator(a->data, b->data) <= 0) {
+                tail->next = a;
+                a->prev = tail;
+                a = a->next;
+            } else {
+                tail->next = b;
+                b->prev = tail;
+                b = b->next;
+            }
+            tail = tail->next;
+        }
+        
+        /* 剩余部分原本就链接好了，只需接上并确定尾节点 */
+        if (a != NULL) {
+            tail->next = a;
+            a->prev = tail;
+        } else {
+            tail->next = b;
+            b->prev = tail;
+            dst->tail = src->tail;
+        }
+        
+        dst->head = head.next;
+        dst->head->prev = NULL;
+        dst->size += src->size;
+        src->head = NULL;
+        src->tail = NULL;
+        src->size = 0;
+        list_positions_changed(dst);
+        list_positions_changed(src);
+    }
     
-    /* 递归排序 */
-    left = list_merge_sort_helper(left, comparator);
-    right = list_merge_sort_helper(right, comparator);
+    list_unlock_pair(dst, src);
+    return CSTL_OK;
+}
+
+/**
+ * @brief 自底向上归并时暂存有序段的槽位数量，第i个槽位保存2^i个节点的有序段
+ */
+#define LIST_SORT_BINS 64
+
+/**
+ * @brief 数组排序时先用插入排序得到的有序段长度
+ */
+#define LIST_SORT_RUN 16
+
+/**
+ * @brief 数组排序的元素数量达到该值时并行执行
+ */
+#define LIST_SORT_PARALLEL_MIN 65536
+
+/**
+ * @brief 合并两个以NULL结尾的有序单链，只维护next指针
+ * 
+ * 相等时取a中的节点，a中的节点在原链表中位于b之前，因此合并是稳定的。
+ * 
+ * @param a 第一个有序段
+ * @param b 第二个有序段
+ * @param comparator 比较函数指针
+ * @return list_node_t* 合并后的有序段
+ */
+static list_node_t* list_sort_merge_runs(list_node_t* a, list_node_t* b, comparator_fn_t comparator)
+{
+    list_node_t head;
+    list_node_t* tail = &head;
     
-    /* 合并排序后的链表 */
-    list_node_t dummy = {0};
-    list_node_t* tail = &dummy;
+    while (a != NULL && b != NULL) {
+        if (comparator(a->data, b->data) <= 0) {
+            tail->next = a;
+            a = a->next;
+        } else {
+            tail->next = b;
+            b = b->next;
+        }
+        tail = tail->next;
+    }
+    tail->next = a != NULL ? a : b;
     
-    while (left != NULL && right != NULL) {
-        if (comparator(left->data, right->data) <= 0) {
-            tail->next = left;
-            left->prev = tail;
-            left = left->next;
+    return head.next;
+}
+
+/**
+ * @brief 最后一次合并，同时恢复prev指针并更新链表的头尾节点
+ * 
+ * 合并和恢复prev在同一趟遍历中完成，排序结束后不需要再遍历链表寻找尾节点。
+ * 
+ * @param list 双向链表容器指针
+ * @param a 第一个有序段
+ * @param b 第二个有序段，可以为NULL
+ * @param comparator 比较函数指针
+ */
+static void list_sort_merge_final(list_t* list, list_node_t* a, list_node_t* b, comparator_fn_t comparator)
+{
+    list_node_t head;
+    list_node_t* tail = &head;
+    
+    while (a != NULL && b != NULL) {
+        if (comparator(a->data, b->data) <= 0) {
+            tail->next = a;
+            a->prev = tail;
+            a = a->next;
         } else {
-            tail->next = right;
-            right->prev = tail;
-            right = right->next;
+            tail->next = b;
+            b->prev = tail;
+            b = b->next;
         }
         tail = tail->next;
     }
     
-    /* 连接剩余节点 */
-    if (left != NULL) {
-        tail->next = left;
-        left->prev = tail;
-    } else {
-        tail->next = right;
-        right->prev = tail;
+    /* 剩余节点已经有序，只需补上prev指针 */
+    tail->next = a != NULL ? a : b;
+    while (tail->next != NULL) {
+        tail->next->prev = tail;
+        tail = tail->next;
     }
     
-    list_node_t* result = dummy.next;
-    result->prev = NULL;
+    list->head = head.next;
+    list->head->prev = NULL;
+    list->tail = tail;
+}
+
+/**
+ * @brief 非递归的自底向上归并排序
+ * 
+ * 每次取下一个节点作为长度为1的有序段，与槽位中等长的有序段逐级合并（类似二进制加法进位），
+ * 最后从短到长合并所有槽位。只沿next指针顺序访问节点，没有递归也不需要寻找中点。
+ * 
+ * @param list 双向链表容器指针，至少有两个节点
+ * @param comparator 比较函数指针
+ */
+static void list_sort_merge_impl(list_t* list, comparator_fn_t comparator)
+{
+    list_node_t* bins[LIST_SORT_BINS] = {0};
+    size_t fill = 0;
+    list_node_t* node = list->head;
+    
+    while (node != NULL) {
+        list_node_t* carry = node;
+        node = node->next;
+        carry->next = NULL;
+        
+        /* 槽位中的有序段来自更早的节点，作为合并的第一个参数以保持稳定 */
+        size_t i = 0;
+        while (i < fill && bins[i] != NULL) {
+            carry = list_sort_merge_runs(bins[i], carry, comparator);
+            bins[i] = NULL;
+            i++;
+        }
+        bins[i] = carry;
+        if (i == fill) {
+            fill++;
+        }
+    }
     
-    return result;
+    /* 最长的有序段在最高的槽位，留给最后一次合并 */
+    list_node_t* result = NULL;
+    for (size_t i = 0; i + 1 < fill; i++) {
+        if (bins[i] != NULL) {
+            result = result != NULL ? list_sort_merge_runs(bins[i], result, comparator) : bins[i];
+        }
+    }
+    list_sort_merge_final(list, bins[fill - 1], result, comparator);
+}
+
+/**
+ * @brief 数组排序的元素，缓存数据指针，比较时不需要访问节点
+ */
+typedef struct list_sort_entry_t {
+    void* data;                 /**< 元素数据指针 */
+    list_node_t* node;          /**< 所属节点 */
+} list_sort_entry_t;
+
+/**
+ * @brief 数组排序的并行任务上下文
+ */
+typedef struct list_sort_context_t {
+    list_sort_entry_t* source;  /**< 本趟的输入数组 */
+    list_sort_entry_t* dest;    /**< 本趟的输出数组 */
+    size_t count;               /**< 元素数量 */
+    size_t width;               /**< 本趟合并的有序段长度 */
+    comparator_fn_t comparator; /**< 比较函数指针 */
+} list_sort_context_t;
+
+/**
+ * @brief 对[begin, end)范围内长度为LIST_SORT_RUN的各段做插入排序
+ * 
+ * @param context 数组排序上下文
+ * @param begin 起始段编号
+ * @param end 结束段编号
+ */
+static void list_sort_runs_chunk(void* context, size_t begin, size_t end)
+{
+    list_sort_context_t* ctx = (list_sort_context_t*)context;
+    list_sort_entry_t* entries = ctx->source;
+    
+    for (size_t run = begin; run < end; run++) {
+        size_t first = run * LIST_SORT_RUN;
+        size_t last = first + LIST_SORT_RUN < ctx->count ? first + LIST_SORT_RUN : ctx->count;
+        for (size_t i = first + 1; i < last; i++) {
+            list_sort_entry_t key = entries[i];
+            size_t j = i;
+            while (j > first && ctx->comparator(entries[j - 1].data, key.data) > 0) {
+                entries[j] = entries[j - 1];
+                j--;
+            }
+            entries[j] = key;
+        }
+    }
+}
+
+/**
+ * @brief 合并[begin, end)范围内的各对有序段，每对由两个长度为width的相邻段组成
+ * 
+ * @param context 数组排序上下文
+ * @param begin 起始段对编号
+ * @param end 结束段对编号
+ */
+static void list_sort_merge_chunk(void* context, size_t begin, size_t end)
+{
+    list_sort_context_t* ctx = (list_sort_context_t*)context;
+    const list_sort_entry_t* src = ctx->source;
+    list_sort_entry_t* dst = ctx->dest;
+    size_t count = ctx->count;
+    
+    for (size_t pair = begin; pair < end; pair++) {
+        size_t left = pair * 2 * ctx->width;
+        size_t mid = left + ctx->width < count ? left + ctx->width : count;
+        size_t right = mid + ctx->width < count ? mid + ctx->width : count;
+        size_t i = left;
+        size_t j = mid;
+        size_t k = left;
+        
+        while (i < mid && j < right) {
+            if (ctx->comparator(src[i].data, src[j].data) <= 0) {
+                dst[k++] = src[i++];
+            } else {
+                dst[k++] = src[j++];
+            }
+        }
+        while (i < mid) {
+            dst[k++] = src[i++];
+        }
+        while (j < right) {
+            dst[k++] = src[j++];
+        }
+    }
+}
+
+/**
+ * @brief 执行一趟分块任务，元素足够多时在默认线程池上并行
+ * 
+ * @param ctx 数组排序上下文
+ * @param tasks 任务数量
+ * @param fn 分块任务函数
+ */
+static void list_sort_run_pass(list_sort_context_t* ctx, size_t tasks, thread_range_fn_t fn)
+{
+    if (ctx->count >= LIST_SORT_PARALLEL_MIN && tasks > 1) {
+        size_t workers = thread_pool_size(thread_pool_default()) + 1;
+        size_t grain = tasks / (workers * 4);
+        if (thread_pool_parallel_for(NULL, tasks, grain > 0 ? grain : 1, fn, ctx) == CSTL_OK) {
+            return;
+        }
+    }
+    fn(ctx, 0, tasks);
+}
+
+/**
+ * @brief 收集节点到数组中排序，再一次性重新链接
+ * 
+ * 先对长度为LIST_SORT_RUN的段做插入排序，再在两个数组之间来回做自底向上的合并，
+ * 每一趟内各对有序段互不相关，可以并行。
+ * 
+ * @param list 双向链表容器指针，至少有两个节点
+ * @param comparator 比较函数指针
+ * @return error_code_t 错误码，内存不足时返回CSTL_ERROR_OUT_OF_MEMORY且链表不变
+ */
+static error_code_t list_sort_array_impl(list_t* list, comparator_fn_t comparator)
+{
+    size_t count = list->size;
+    list_sort_entry_t* entries = (list_sort_entry_t*)malloc(count * sizeof(list_sort_entry_t));
+    list_sort_entry_t* temp = (list_sort_entry_t*)malloc(count * sizeof(list_sort_entry_t));
+    if (entries == NULL || temp == NULL) {
+        free(entries);
+        free(temp);
+        return CSTL_ERROR_OUT_OF_MEMORY;
+    }
+    
+    size_t n = 0;
+    for (list_node_t* node = list->head; node != NULL; node = node->next) {
+        entries[n].data = node->data;
+        entries[n].node = node;
+        n++;
+    }
+    
+    list_sort_context_t ctx;
+    ctx.source = entries;
+    ctx.dest = temp;
+    ctx.count = n;
+    ctx.width = LIST_SORT_RUN;
+    ctx.comparator = comparator;
+    list_sort_run_pass(&ctx, (n + LIST_SORT_RUN - 1) / LIST_SORT_RUN, list_sort_runs_chunk);
+    
+    while (ctx.width < n) {
+        size_t pairs = (n + 2 * ctx.width - 1) / (2 * ctx.width);
+        list_sort_run_pass(&ctx, pairs, list_sort_merge_chunk);
+        list_sort_entry_t* swap = ctx.source;
+        ctx.source = ctx.dest;
+        ctx.dest = swap;
+        ctx.width *= 2;
+    }
+    
+    /* 按排序结果重新链接 */
+    const list_sort_entry_t* sorted = ctx.source;
+    for (size_t i = 0; i < n; i++) {
+        list_node_t* node = sorted[i].node;
+        node->prev = i > 0 ? sorted[i - 1].node : NULL;
+        node->next = i + 1 < n ? sorted[i + 1].node : NULL;
+    }
+    list->head = sorted[0].node;
+    list->tail = sorted[n - 1].node;
+    
+    free(entries);
+    free(temp);
+    return CSTL_OK;
 }
 
 /**
@@ -921,22 +1635,34 @@ static list_node_t* list_merge_sort_helper(list_node_t* head, comparator_fn_t co
  * @return error_code_t 错误码
  */
 error_code_t list_sort(list_t* list, comparator_fn_t comparator)
+{
+    return list_sort_ex(list, comparator, LIST_SORT_MERGE);
+}
+
+/**
+ * @brief 按指定方式排序双向链表容器
+ * 
+ * @param list 双向链表容器指针
+ * @param comparator 比较函数指针
+ * @param mode 排序方式
+ * @return error_code_t 错误码
+ */
+error_code_t list_sort_ex(list_t* list, comparator_fn_t comparator, list_sort_mode_t mode)
 {
     if (list == NULL || comparator == NULL) {
         return CSTL_ERROR_NULL_POINTER;
     }
+    if (mode != LIST_SORT_MERGE && mode != LIST_SORT_ARRAY) {
+        return CSTL_ERROR_INVALID_ARGUMENT;
+    }
     
     list_lock(list);
     
-    if (list->head != NULL) {
-        list->head = list_merge_sort_helper(list->head, comparator);
-        
-        /* 更新尾节点 */
-        list_node_t* node = list->head;
-        while (node->next != NULL) {
-            node = node->next;
+    if (list->head != NULL && list->head->next != NULL) {
+        if (mode != LIST_SORT_ARRAY || list_sort_array_impl(list, comparator) != CSTL_OK) {
+            list_sort_merge_impl(list, comparator);
         }
-        list->tail = node;
+        list_positions_changed(list);
     }
     
     list_unlock(list);
@@ -1063,6 +1789,7 @@ iterator_t* list_iterator_create(list_t* list, iter_direction_t direction)
     list_iter->base.get = list_iterator_get;
     list_iter->base.valid = list_iterator_valid;
     list_iter->base.destroy = list_iterator_destroy;
+    list_iter->base.clone = list_iterator_clone;
     
     /* 设置初始位置 */
     if (direction == ITER_DIR_FORWARD) {
@@ -1124,6 +1851,11 @@ iterator_t* list_end(list_t* list)
 /**
  * @brief 获取双向链表容器指定位置的元素
  *
+ * 从头节点、尾节点、游标（上一次按索引访问的节点）和跳跃索引中离目标最近的位置出发，
+ * 顺序或就近的索引访问为O(1)。
+ * 虽然参数是const，每次调用都会写入链表中共享的游标和跳跃索引，并不是只读操作：
+ * 多个线程同时调用list_at（即使都只读取、没有线程修改链表）也必须先调用list_enable_thread_safety。
+ *
  * @param list 双向链表容器指针
  * @param index 元素索引
  * @param element 输出参数，存储元素指针
@@ -1135,24 +1867,27 @@ error_code_t list_at(const list_t* list, size_t index, void** element)
         return CSTL_ERROR_NULL_POINTER;
     }
     
+    /* 游标和跳跃索引是缓存，不改变链表的内容 */
+    list_t* mutable_list = (list_t*)list;
+    list_lock(mutable_list);
+    
     /* 检查索引是否有效 */
     if (index >= list->size) {
+        list_unlock(mutable_list);
         return CSTL_ERROR_INVALID_INDEX;
     }
     
-    /* 遍历到指定位置 */
-    list_node_t* node = list->head;
-    for (size_t i = 0; i < index; i++) {
-        node = node->next;
-    }
+    *element = list_locate(mutable_list, index)->data;
     
-    *element = node->data;
+    list_unlock(mutable_list);
     return CSTL_OK;
 }
 
 /**
  * @brief 设置双向链表容器指定位置的元素
  *
+ * 与list_at相同地定位节点。
+ *
  * @param list 双向链表容器指针
  * @param index 元素索引
  * @param element 要设置的元素指针
@@ -1172,11 +1907,7 @@ error_code_t list_set(list_t* list, size_t index, const void* element)
         return CSTL_ERROR_INVALID_INDEX;
     }
     
-    /* 遍历到指定位置 */
-    list_node_t* node = list->head;
-    for (size_t i = 0; i < index; i++) {
-        node = node->next;
-    }
+    list_node_t* node = list_locate(list, index);
     
     /* 调用析构函数释放旧元素内存 */
     if (list->destructor != NULL) {
@@ -1189,3 +1920,104 @@ error_code_t list_set(list_t* list, size_t index, const void* element)
     list_unlock(list);
     return CSTL_OK;
 }
+
+/**
+ * @brief 启用跳跃索引
+ * 
+ * 跳跃索引每stride个节点记录一个节点指针，按索引随机访问最多沿链表走stride / 2步，
+ * 额外内存为每stride个节点一个指针。索引在第一次需要时建立；插入、删除等改变节点位置的
+ * 操作使它失效（push_back和pop_back除外），下次随机访问时重建，代价为O(n)。
+ * 
+ * @param list 双向链表容器指针
+ * @param stride 步长，为0时使用LIST_SKIP_INDEX_STRIDE
+ * @return error_code_t 错误码
+ */
+error_code_t list_enable_skip_index(list_t* list, size_t stride)
+{
+    if (list == NULL) {
+        return CSTL_ERROR_NULL_POINTER;
+    }
+    
+    list_lock(list);
+    list->index_stride = stride > 0 ? stride : LIST_SKIP_INDEX_STRIDE;
+    list->index_count = 0;
+    list_unlock(list);
+    
+    return CSTL_OK;
+}
+
+/**
+ * @brief 禁用跳跃索引并释放其内存
+ * 
+ * @param list 双向链表容器指针
+ * @return error_code_t 错误码
+ */
+error_code_t list_disable_skip_index(list_t* list)
+{
+    if (list == NULL) {
+        return CSTL_ERROR_NULL_POINTER;
+    }
+    
+    list_lock(list);
+    free(list->index_nodes);
+    list->index_nodes = NULL;
+    list->index_count = 0;
+    list->index_capacity = 0;
+    list->index_stride = 0;
+    list_unlock(list);
+    
+    return CSTL_OK;
+}
+
+/**
+ * @brief 通过链表迭代器获取其后第offset个元素
+ * 
+ * 迭代器指向头节点或游标节点时按索引定位（使用游标和跳跃索引），否则从迭代器所在节点向后走。
+ *
+ * @param iterator 迭代器指针
+ * @param offset 相对迭代器的偏移
+ * @param element 输出参数，存储元素指针
+ * @return int 如果iterator是链表迭代器且目标元素存在返回非零，否则返回零
+ */
+int list_iterator_at(const iterator_t* iterator, size_t offset, void** element)
+{
+    if (iterator == NULL || element == NULL || iterator->next != list_iterator_next) {
+        return 0;
+    }
+    
+    list_t* list = (list_t*)iterator->container;
+    list_node_t* node = ((const list_iterator_t*)iterator)->node;
+    if (node == NULL) {
+        return 0;
+    }
+    
+    list_lock(list);
+    
+    /* 确定迭代器所在节点的索引 */
+    size_t base = LIST_COUNT_UNKNOWN;
+    if (node == list->head) {
+        base = 0;
+    } else if (node == list->cursor_node) {
+        base = list->cursor_index;
+    }
+    
+    if (base != LIST_COUNT_UNKNOWN) {
+        if (offset >= list->size - base) {
+            list_unlock(list);
+            return 0;
+        }
+        node = list_locate(list, base + offset);
+    } else {
+        for (size_t i = 0; i < offset && node != NULL; i++) {
+            node = node->next;
+        }
+    }
+    
+    list_unlock(list);
+    
+    if (node == NULL) {
+        return 0;
+    }
+    *element = node->data;
+    return 1;
+}
@@ -0,0 +1,344 @@
+/**
+ * @file random.c
+ * @brief CSTL库的伪随机数生成器实现
+ *
+ * 该文件实现了xoshiro256**生成器（Blackman与Vigna），
+ * 播种使用SplitMix64，区间随机数使用Lemire的无偏乘法方法。
+ */
+
+#include "cstl/random.h"
+#include <string.h>
+#include <time.h>
+
+#if defined(_MSC_VER) && defined(_M_X64)
+#include <intrin.h>
+#endif
+
+/**
+ * @brief 线程局部生成器
+ */
+static CSTL_THREAD_LOCAL rng_t tls_rng;
+
+/**
+ * @brief 线程局部生成器是否已播种
+ */
+static CSTL_THREAD_LOCAL int tls_rng_seeded = 0;
+
+/**
+ * @brief 64位循环左移
+ */
+static inline uint64_t rng_rotl(uint64_t x, int k)
+{
+    return (x << k) | (x >> (64 - k));
+}
+
+/**
+ * @brief SplitMix64，用于把种子扩展为状态
+ *
+ * @param state 输入输出参数，SplitMix64的状态
+ * @return uint64_t 下一个输出
+ */
+static uint64_t splitmix64(uint64_t* state)
+{
+    uint64_t z = (*state += 0x9E3779B97F4A7C15ULL);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+/**
+ * @brief 64位乘法的高64位
+ *
+ * @param a 乘数
+ * @param b 乘数
+ * @param low 输出参数，存储低64位
+ * @return uint64_t 高64位
+ */
+static inline uint64_t rng_mul_high(uint64_t a, uint64_t b, uint64_t* low)
+{
+#if defined(__SIZEOF_INT128__)
+    unsigned __int128 product = (unsigned __int128)a * b;
+    *low = (uint64_t)product;
+    return (uint64_t)(product >> 64);
+#elif defined(_MSC_VER) && defined(_M_X64)
+    uint64_t high;
+    *low = _umul128(a, b, &high);
+    return high;
+#else
+    uint64_t a_lo = (uint32_t)a, a_hi = a >> 32;
+    uint64_t b_lo = (uint32_t)b, b_hi = b >> 32;
+    uint64_t lo_lo = a_lo * b_lo;
+    uint64_t hi_lo = a_hi * b_lo;
+    uint64_t lo_hi = a_lo * b_hi;
+    uint64_t cross = (lo_lo >> 32) + (uint32_t)hi_lo + lo_hi;
+    *low = (cross << 32) | (uint32_t)lo_lo;
+    return a_hi * b_hi + (hi_lo >> 32) + (cross >> 32);
+#endif
+}
+
+/**
+ * @brief 用64位种子初始化生成器
+ *
+ * @param rng 生成器状态
+ * @param seed 种子
+ */
+void rng_seed(rng_t* rng, uint64_t seed)
+{
+    if (rng == NULL) {
+        return;
+    }
+
+    uint64_t state = seed;
+    for (int i = 0; i < 4; i++) {
+        rng->s[i] = splitmix64(&state);
+    }
+}
+
+/**
+ * @brief 获取当前线程的生成器
+ *
+ * @return rng_t* 线程局部的生成器状态
+ */
+rng_t* rng_thread_local(void)
+{
+    if (!tls_rng_seeded) {
+        uint64_t seed = (uint64_t)time(NULL);
+        seed ^= (uint64_t)(uintptr_t)&tls_rng * 0x9E3779B97F4A7C15ULL;
+        seed ^= (uint64_t)clock() << 20;
+        rng_seed(&tls_rng, seed);
+        tls_rng_seeded = 1;
+    }
+    return &tls_rng;
+}
+
+/**
+ * @brief 生成一个64位随机数
+ *
+ * @param rng 生成器状态
+ * @return uint64_t 随机数
+ */
+uint64_t rng_next(rng_t* rng)
+{
+    uint64_t* s = rng->s;
+    uint64_t result = rng_rotl(s[1] * 5, 7) * 9;
+    uint64_t t = s[1] << 17;
+
+    s[2] ^= s[0];
+    s[3] ^= s[1];
+    s[1] ^= s[2];
+    s[0] ^= s[3];
+    s[2] ^= t;
+    s[3] = rng_rotl(s[3], 45);
+
+    return result;
+}
+
+/**
+ * @brief 生成一个32位随机数
+ *
+ * @param rng 生成器状态
+ * @return uint32_t 随机数
+ */
+uint32_t rng_next_u32(rng_t* rng)
+{
+    return (uint32_t)(rng_next(rng) >> 32);
+}
+
+/**
+ * @brief 生成[0, bound)内均匀分布的随机数
+ *
+ * 上界不超过2^32时只用一次32位乘法，否则使用64x64位乘法。
+ *
+ * @param rng 生成器状态
+ * @param bound 上界（不含）
+ * @return uint64_t 随机数
+ */
+uint64_t rng_bounded(rng_t* rng, uint64_t bound)
+{
+    if (bound == 0) {
+        return 0;
+    }
+
+    if (bound <= 0xFFFFFFFFULL) {
+        uint32_t range = (uint32_t)bound;
+        uint64_t product = (uint64_t)rng_next_u32(rng) * range;
+        uint32_t low = (uint32_t)product;
+        if (low < range) {
+            uint32_t threshold = (uint32_t)(-range) % range;
+            while (low < threshold) {
+                product = (uint64_t)rng_next_u32(rng) * range;
+                low = (uint32_t)product;
+            }
+        }
+        return product >> 32;
+    }
+
+    uint64_t low = 0;
+    uint64_t high = rng_mul_high(rng_next(rng), bound, &low);
+    if (low < bound) {
+        uint64_t threshold = (0 - bound) % bound;
+        while (low < threshold) {
+            high = rng_mul_high(rng_next(rng), bound, &low);
+        }
+    }
+    return high;
+}
+
+/**
+ * @brief 生成[0, 1)内均匀分布的双精度浮点数
+ *
+ * @param rng 生成器状态
+ * @return double 随机数
+ */
+double rng_next_double(rng_t* rng)
+{
+    return (double)(rng_next(rng) >> 11) * (1.0 / 9007199254740992.0);
+}
+
+/**
+ * @brief 按跳跃多项式推进状态
+ *
+ * @param rng 生成器状态
+ * @param polynomial 4个64位的跳跃多项式系数
+ */
+static void rng_apply_jump(rng_t* rng, const uint64_t polynomial[4])
+{
+    uint64_t s0 = 0, s1 = 0, s2 = 0, s3 = 0;
+
+    for (int i = 0; i < 4; i++) {
+        for (int b = 0; b < 64; b++) {
+            if (polynomial[i] & ((uint64_t)1 << b)) {
+                s0 ^= rng->s[0];
+                s1 ^= rng->s[1];
+                s2 ^= rng->s[2];
+                s3 ^= rng->s[3];
+            }
+            rng_next(rng);
+        }
+    }
+
+    rng->s[0] = s0;
+    rng->s[1] = s1;
+    rng->s[2] = s2;
+    rng->s[3] = s3;
+}
+
+/**
+ * @brief 向前跳过2^128个随机数
+ *
+ * @param rng 生成器状态
+ */
+void rng_jump(rng_t* rng)
+{
+    static const uint64_t jump[4] = {
+        0x180EC6D33CFD0ABAULL, 0xD5A61266F0C9392CULL, 0xA9582618E03FC9AAULL, 0x39ABDC4529B1661CULL
+    };
+
+    if (rng != NULL) {
+        rng_apply_jump(rng, jump);
+    }
+}
+
+/**
+ * @brief 向前跳过2^192个随机数
+ *
+ * @param rng 生成器状态
+ */
+void rng_long_jump(rng_t* rng)
+{
+    static const uint64_t long_jump[4] = {
+        0x76E15D3EFEFDCBBFULL, 0xC5004E441C522FB3ULL, 0x77710069854EE241ULL, 0x39109BB02ACBE635ULL
+    };
+
+    if (rng != NULL) {
+        rng_apply_jump(rng, long_jump);
+    }
+}
+
+/**
+ * @brief 拆分出一个独立的随机流
+ *
+ * @param rng 生成器状态
+ * @param child 输出参数，存储拆分出的生成器状态
+ */
+void rng_split(rng_t* rng, rng_t* child)
+{
+    if (rng == NULL || child == NULL) {
+        return;
+    }
+
+    *child = *rng;
+    rng_long_jump(rng);
+}
+
+/**
+ * @brief 用随机字节填充缓冲区
+ *
+ * @param rng 生成器状态
+ * @param buffer 缓冲区
+ * @param size 字节数
+ * @return error_code_t 错误码
+ */
+error_code_t rng_fill(rng_t* rng, void* buffer, size_t size)
+{
+    if (rng == NULL || (buffer == NULL && size > 0)) {
+        return CSTL_ERROR_NULL_POINTER;
+    }
+
+    unsigned char* p = (unsigned char*)buffer;
+    while (size >= sizeof(uint64_t)) {
+        uint64_t value = rng_next(rng);
+        memcpy(p, &value, sizeof(value));
+        p += sizeof(value);
+        size -= sizeof(value);
+    }
+    if (size > 0) {
+        uint64_t value = rng_next(rng);
+        memcpy(p, &value, size);
+    }
+
+    return CSTL_OK;
+}
+
+/**
+ * @brief 批量生成[0, bound)内均匀分布的随机数
+ *
+ * @param rng 生成器状态
+ * @param values 输出数组
+ * @param count 元素数量
+ * @param bound 上界（不含）
+ * @return error_code_t 错误码
+ */
+error_code_t rng_fill_bounded(rng_t* rng, uint64_t* values, size_t count, uint64_t bound)
+{
+    if (rng == NULL || (values == NULL && count > 0)) {
+        return CSTL_ERROR_NULL_POINTER;
+    }
+
+    for (size_t i = 0; i < count; i++) {
+        values[i] = rng_bounded(rng, bound);
+    }
+
+    return CSTL_OK;
+}
+
+/**
+ * @brief 批量生成[0, 1)内均匀分布的双精度浮点数
+ *
+ * @param rng 生成器状态
+ * @param values 输出数组
+ * @param count 元素数量
+ * @return error_code_t 错误码
+ */
+error_code_t rng_fill_double(rng_t* rng, double* values, size_t count)
+{
+    if (rng == NULL || (values == NULL && count > 0)) {
+        return CSTL_ERROR_NULL_POINTER;
+    }
+
+    for (size_t i = 0; i < count; i++) {
+        values[i] = rng_next_double(rng);
+    }
+
+    return CSTL_OK;
+}
@@ -0,0 +1,592 @@
+/**
+ * @file range.c
+ * @brief CSTL库的惰性范围管道实现
+ *
+ * 执行时源范围的每个元素按顺序推过所有适配器，最后交给终结操作，
+ * 中间结果只存在于适配器的输出缓冲区中。截取满额或拉链的第二个范围结束时
+ * 返回停止标志，源范围随即停止遍历；之后把各分块适配器中不满的块依次推出。
+ */
+
+#include "cstl/range.h"
+#include <string.h>
+
+/**
+ * @brief 暂存区中每个输出元素的对齐字节数
+ */
+#define RANGE_SCRATCH_ALIGN 16
+
+/**
+ * @brief 终结操作类型
+ */
+typedef enum {
+    RANGE_SINK_COLLECT,
+    RANGE_SINK_REDUCE,
+    RANGE_SINK_FOR_EACH,
+    RANGE_SINK_COUNT
+} range_sink_type_t;
+
+/**
+ * @brief 终结操作
+ */
+typedef struct range_sink_t {
+    range_sink_type_t type;     /**< 终结操作类型 */
+    vector_t* vector;           /**< 收集的目标向量 */
+    binary_op_fn_t reduce;      /**< 归约操作 */
+    void* result;               /**< 归约累加值 */
+    unary_op_fn_t op;           /**< 逐个处理的操作 */
+    size_t count;               /**< 已输出的元素数量 */
+    error_code_t error;         /**< 终结操作遇到的错误 */
+} range_sink_t;
+
+/**
+ * @brief 适配器在一次执行中的状态
+ */
+typedef struct range_cursor_t {
+    size_t remaining;           /**< 截取/跳过还剩的数量 */
+    size_t filled;              /**< 当前块中的元素数量 */
+    range_chunk_t chunk;        /**< 分块适配器输出的块 */
+    char* data;                 /**< 拉链第二个范围连续存储时的当前元素 */
+    size_t left;                /**< 拉链第二个范围连续存储时的剩余元素数量 */
+    iterator_t* iterator;       /**< 拉链第二个范围不连续时克隆的迭代器 */
+} range_cursor_t;
+
+/**
+ * @brief 一次执行
+ */
+typedef struct range_run_t {
+    const range_t* range;       /**< 管道 */
+    range_sink_t* sink;         /**< 终结操作 */
+    range_cursor_t cursors[RANGE_MAX_STAGES]; /**< 各适配器的状态 */
+} range_run_t;
+
+/**
+ * @brief 追加一个适配器
+ *
+ * @param range 管道
+ * @param type 适配器类型
+ * @return range_stage_t* 新适配器，管道已出错或适配器已满时返回NULL
+ */
+static range_stage_t* range_add_stage(range_t* range, range_stage_type_t type)
+{
+    if (range->error != CSTL_OK) {
+        return NULL;
+    }
+    if (range->stage_count == RANGE_MAX_STAGES) {
+        range->error = CSTL_ERROR_CONTAINER_FULL;
+        return NULL;
+    }
+
+    range_stage_t* stage = &range->stages[range->stage_count++];
+    memset(stage, 0, sizeof(*stage));
+    stage->type = type;
+    stage->input_size = range->element_size;
+    stage->output_size = range->element_size;
+    return stage;
+}
+
+/**
+ * @brief 从暂存区分配一个输出元素
+ *
+ * @param range 管道
+ * @param size 字节数
+ * @return void* 缓冲区，暂存区不足时返回NULL并记录错误
+ */
+static void* range_scratch_alloc(range_t* range, size_t size)
+{
+    size_t offset = (range->scratch_used + RANGE_SCRATCH_ALIGN - 1) & ~(size_t)(RANGE_SCRATCH_ALIGN - 1);
+    if (size == 0 || size > RANGE_SCRATCH_SIZE || offset > RANGE_SCRATCH_SIZE - size) {
+        range->error = CSTL_ERROR_CONTAINER_FULL;
+        return NULL;
+    }
+    range->scratch_used = offset + size;
+    return range->scratch.bytes + offset;
+}
+
+/**
+ * @brief 用源范围初始化管道
+ *
+ * @param range 管道
+ * @param begin 源范围起始迭代器
+ * @param end 源范围结束迭代器
+ * @return error_code_t 错误码
+ */
+error_code_t range_init(range_t* range, iterator_t* begin, iterator_t* end)
+{
+    if (range == NULL) {
+        return CSTL_ERROR_NULL_POINTER;
+    }
+
+    range->begin = begin;
+    range->end = end;
+    range->element_size = begin != NULL ? begin->element_size : 0;
+    range->stage_count = 0;
+    range->scratch_used = 0;
+    range->error = (begin == NULL || end == NULL) ? CSTL_ERROR_NULL_POINTER : CSTL_OK;
+    return range->error;
+}
+
+/**
+ * @brief 追加过滤适配器
+ *
+ * @param range 管道
+ * @param predicate 条件函数
+ * @return error_code_t 错误码
+ */
+error_code_t range_filter(range_t* range, predicate_fn_t predicate)
+{
+    if (range == NULL) {
+        return CSTL_ERROR_NULL_POINTER;
+    }
+    if (predicate == NULL && range->error == CSTL_OK) {
+        range->error = CSTL_ERROR_NULL_POINTER;
+    }
+
+    range_stage_t* stage = range_add_stage(range, RANGE_STAGE_FILTER);
+    if (stage == NULL) {
+        return range->error;
+    }
+    stage->predicate = predicate;
+    return CSTL_OK;
+}
+
+/**
+ * @brief 追加映射适配器
+ *
+ * @param range 管道
+ * @param map 映射函数
+ * @param output_size 输出元素字节数
+ * @return error_code_t 错误码
+ */
+error_code_t range_map(range_t* range, range_map_fn_t map, size_t output_size)
+{
+    if (range == NULL) {
+        return CSTL_ERROR_NULL_POINTER;
+    }
+    if (map == NULL && range->error == CSTL_OK) {
+        range->error = CSTL_ERROR_NULL_POINTER;
+    }
+
+    range_stage_t* stage = range_add_stage(range, RANGE_STAGE_MAP);
+    if (stage == NULL) {
+        return range->error;
+    }
+    stage->buffer = range_scratch_alloc(range, output_size);
+    if (stage->buffer == NULL) {
+        return range->error;
+    }
+    stage->map = map;
+    stage->output_size = output_size;
+    range->element_size = output_size;
+    return CSTL_OK;
+}
+
+/**
+ * @brief 追加截取适配器
+ *
+ * @param range 管道
+ * @param count 保留的元素数量
+ * @return error_code_t 错误码
+ */
+error_code_t range_take(range_t* range, size_t count)
+{
+    if (range == NULL) {
+        return CSTL_ERROR_NULL_POINTER;
+    }
+
+    range_stage_t* stage = range_add_stage(range, RANGE_STAGE_TAKE);
+    if (stage == NULL) {
+        return range->error;
+    }
+    stage->count = count;
+    return CSTL_OK;
+}
+
+/**
+ * @brief 追加跳过适配器
+ *
+ * @param range 管道
+ * @param count 丢弃的元素数量
+ * @return error_code_t 错误码
+ */
+error_code_t range_drop(range_t* range, size_t count)
+{
+    if (range == NULL) {
+        return CSTL_ERROR_NULL_POINTER;
+    }
+
+    range_stage_t* stage = range_add_stage(range, RANGE_STAGE_DROP);
+    if (stage == NULL) {
+        return range->error;
+    }
+    stage->count = count;
+    return CSTL_OK;
+}
+
+/**
+ * @brief 追加拉链适配器
+ *
+ * @param range 管道
+ * @param begin 第二个范围起始迭代器
+ * @param end 第二个范围结束迭代器
+ * @param zip 合并函数
+ * @param output_size 输出元素字节数
+ * @return error_code_t 错误码
+ */
+error_code_t range_zip(range_t* range, iterator_t* begin, iterator_t* end, range_zip_fn_t zip,
+                       size_t output_size)
+{
+    if (range == NULL) {
+        return CSTL_ERROR_NULL_POINTER;
+    }
+    if ((begin == NULL || end == NULL || zip == NULL) && range->error == CSTL_OK) {
+        range->error = CSTL_ERROR_NULL_POINTER;
+    }
+
+    range_stage_t* stage = range_add_stage(range, RANGE_STAGE_ZIP);
+    if (stage == NULL) {
+        return range->error;
+    }
+    stage->buffer = range_scratch_alloc(range, output_size);
+    if (stage->buffer == NULL) {
+        return range->error;
+    }
+    stage->zip = zip;
+    stage->begin = begin;
+    stage->end = end;
+    stage->output_size = output_size;
+    range->element_size = output_size;
+    return CSTL_OK;
+}
+
+/**
+ * @brief 追加分块适配器
+ *
+ * @param range 管道
+ * @param size 块大小
+ * @param buffer 缓冲区
+ * @return error_code_t 错误码
+ */
+error_code_t range_chunk(range_t* range, size_t size, void* buffer)
+{
+    if (range == NULL) {
+        return CSTL_ERROR_NULL_POINTER;
+    }
+    if (range->error == CSTL_OK) {
+        if (buffer == NULL) {
+            range->error = CSTL_ERROR_NULL_POINTER;
+        } else if (size == 0) {
+            range->error = CSTL_ERROR_INVALID_ARGUMENT;
+        }
+    }
+
+    range_stage_t* stage = range_add_stage(range, RANGE_STAGE_CHUNK);
+    if (stage == NULL) {
+        return range->error;
+    }
+    stage->count = size;
+    stage->buffer = buffer;
+    stage->output_size = sizeof(range_chunk_t);
+    range->element_size = sizeof(range_chunk_t);
+    return CSTL_OK;
+}
+
+/**
+ * @brief 把一个元素交给终结操作
+ *
+ * @param sink 终结操作
+ * @param element 元素指针
+ * @return int 非零表示继续，零表示停止
+ */
+static inline int range_sink_put(range_sink_t* sink, void* element)
+{
+    switch (sink->type) {
+    case RANGE_SINK_COLLECT:
+        sink->error = vector_push_back(sink->vector, element);
+        if (sink->error != CSTL_OK) {
+            return 0;
+        }
+        break;
+    case RANGE_SINK_REDUCE:
+        sink->reduce(sink->result, element);
+        break;
+    case RANGE_SINK_FOR_EACH:
+        sink->op(element);
+        break;
+    case RANGE_SINK_COUNT:
+        break;
+    }
+    sink->count++;
+    return 1;
+}
+
+/**
+ * @brief 取拉链第二个范围的下一个元素
+ *
+ * @param stage 拉链适配器
+ * @param cursor 适配器状态
+ * @return void* 元素指针，第二个范围已结束时返回NULL
+ */
+static inline void* range_zip_next(const range_stage_t* stage, range_cursor_t* cursor)
+{
+    if (cursor->iterator == NULL) {
+        if (cursor->left == 0) {
+            return NULL;
+        }
+        void* element = cursor->data;
+        cursor->data += stage->end->element_size;
+        cursor->left--;
+        return element;
+    }
+
+    if (!iterator_valid(cursor->iterator) || iterator_equal(cursor->iterator, stage->end)) {
+        return NULL;
+    }
+    void* element = NULL;
+    iterator_get(cursor->iterator, &element);
+    iterator_next(cursor->iterator);
+    return element;
+}
+
+/**
+ * @brief 把元素从第stage个适配器开始推过管道
+ *
+ * @param run 执行状态
+ * @param stage 起始适配器下标
+ * @param element 元素指针
+ * @return int 非零表示继续，零表示源范围应停止
+ */
+static int range_push(range_run_t* run, size_t stage, void* element)
+{
+    const range_t* range = run->range;
+    int more = 1;
+
+    for (; stage < range->stage_count; stage++) {
+        const range_stage_t* s = &range->stages[stage];
+        range_cursor_t* cursor = &run->cursors[stage];
+
+        switch (s->type) {
+        case RANGE_STAGE_FILTER:
+            if (!s->predicate(element)) {
+                return more;
+            }
+            break;
+        case RANGE_STAGE_MAP:
+            s->map(element, s->buffer);
+            element = s->buffer;
+            break;
+        case RANGE_STAGE_TAKE:
+            if (cursor->remaining == 0) {
+                return 0;
+            }
+            if (--cursor->remaining == 0) {
+                more = 0;
+            }
+            break;
+        case RANGE_STAGE_DROP:
+            if (cursor->remaining > 0) {
+                cursor->remaining--;
+                return more;
+            }
+            break;
+        case RANGE_STAGE_ZIP: {
+            void* other = range_zip_next(s, cursor);
+            if (other == NULL) {
+                return 0;
+            }
+            s->zip(element, other, s->buffer);
+            element = s->buffer;
+            break;
+        }
+        case RANGE_STAGE_CHUNK:
+            memcpy((char*)s->buffer + cursor->filled * s->input_size, element, s->input_size);
+            if (++cursor->filled < s->count) {
+                return more;
+            }
+            cursor->chunk.data = s->buffer;
+            cursor->chunk.count = cursor->filled;
+            cursor->filled = 0;
+            element = &cursor->chunk;
+            break;
+        }
+    }
+
+    return range_sink_put(run->sink, element) && more;
+}
+
+/**
+ * @brief 执行管道
+ *
+ * @param range 管道
+ * @param sink 终结操作
+ * @return error_code_t 错误码
+ */
+static error_code_t range_run(const range_t* range, range_sink_t* sink)
+{
+    if (range->error != CSTL_OK) {
+        return range->error;
+    }
+
+    range_run_t run;
+    run.range = range;
+    run.sink = sink;
+    sink->count = 0;
+    sink->error = CSTL_OK;
+
+    /* 重置各适配器的状态，不连续的拉链范围克隆一次迭代器 */
+    error_code_t error = CSTL_OK;
+    size_t prepared = 0;
+    for (; prepared < range->stage_count; prepared++) {
+        const range_stage_t* s = &range->stages[prepared];
+        range_cursor_t* cursor = &run.cursors[prepared];
+        memset(cursor, 0, sizeof(*cursor));
+        cursor->remaining = s->count;
+        if (s->type == RANGE_STAGE_ZIP) {
+            void* data = NULL;
+            if (vector_iterator_span(s->begin, s->end, &data, &cursor->left)) {
+                cursor->data = (char*)data;
+            } else {
+                cursor->iterator = iterator_clone(s->begin);
+                if (cursor->iterator == NULL) {
+                    error = CSTL_ERROR_OUT_OF_MEMORY;
+                    break;
+                }
+            }
+        }
+    }
+
+    if (error == CSTL_OK) {
+        void* data = NULL;
+        size_t count = 0;
+        if (vector_iterator_span(range->begin, range->end, &data, &count)) {
+            char* element = (char*)data;
+            size_t size = range->begin->element_size;
+            for (size_t i = 0; i < count; i++, element += size) {
+                if (!range_push(&run, 0, element)) {
+                    break;
+                }
+            }
+        } else {
+            iterator_t* iter = iterator_clone(range->begin);
+            if (iter == NULL) {
+                error = CSTL_ERROR_OUT_OF_MEMORY;
+            } else {
+                while (iterator_valid(iter) && !iterator_equal(iter, range->end)) {
+                    void* element = NULL;
+                    iterator_get(iter, &element);
+                    if (!range_push(&run, 0, element)) {
+                        break;
+                    }
+                    iterator_next(iter);
+                }
+                iterator_destroy(iter);
+            }
+        }
+    }
+
+    /* 推出不满的块，前面的块推出后可能填入后面的块，所以按顺序处理 */
+    if (error == CSTL_OK) {
+        for (size_t i = 0; i < range->stage_count && sink->error == CSTL_OK; i++) {
+            range_cursor_t* cursor = &run.cursors[i];
+            if (range->stages[i].type == RANGE_STAGE_CHUNK && cursor->filled > 0) {
+                cursor->chunk.data = range->stages[i].buffer;
+                cursor->chunk.count = cursor->filled;
+                cursor->filled = 0;
+                range_push(&run, i + 1, &cursor->chunk);
+            }
+        }
+    }
+
+    for (size_t i = 0; i < prepared; i++) {
+        if (run.cursors[i].iterator != NULL) {
+            iterator_destroy(run.cursors[i].iterator);
+        }
+    }
+
+    return error != CSTL_OK ? error : sink->error;
+}
+
+/**
+ * @brief 执行管道，把输出元素追加到向量末尾
+ *
+ * @param range 管道
+ * @param dest 目标向量
+ * @return error_code_t 错误码
+ */
+error_code_t range_collect(range_t* range, vector_t* dest)
+{
+    if (range == NULL || dest == NULL) {
+        return CSTL_ERROR_NULL_POINTER;
+    }
+    if (range->error == CSTL_OK && dest->element_size != range->element_size) {
+        return CSTL_ERROR_INVALID_ARGUMENT;
+    }
+
+    range_sink_t sink;
+    memset(&sink, 0, sizeof(sink));
+    sink.type = RANGE_SINK_COLLECT;
+    sink.vector = dest;
+    return range_run(range, &sink);
+}
+
+/**
+ * @brief 执行管道并归约
+ *
+ * @param range 管道
+ * @param op 二元操作
+ * @param result 输入输出参数，初始值和归约结果
+ * @return error_code_t 错误码
+ */
+error_code_t range_reduce(range_t* range, binary_op_fn_t op, void* result)
+{
+    if (range == NULL || op == NULL || result == NULL) {
+        return CSTL_ERROR_NULL_POINTER;
+    }
+
+    range_sink_t sink;
+    memset(&sink, 0, sizeof(sink));
+    sink.type = RANGE_SINK_REDUCE;
+    sink.reduce = op;
+    sink.result = result;
+    return range_run(range, &sink);
+}
+
+/**
+ * @brief 执行管道，对每个输出元素执行操作
+ *
+ * @param range 管道
+ * @param op 一元操作
+ * @return error_code_t 错误码
+ */
+error_code_t range_for_each(range_t* range, unary_op_fn_t op)
+{
+    if (range == NULL || op == NULL) {
+        return CSTL_ERROR_NULL_POINTER;
+    }
+
+    range_sink_t sink;
+    memset(&sink, 0, sizeof(sink));
+    sink.type = RANGE_SINK_FOR_EACH;
+    sink.op = op;
+    return range_run(range, &sink);
+}
+
+/**
+ * @brief 执行管道，统计输出元素的数量
+ *
+ * @param range 管道
+ * @param count 输出参数，存储元素数量
+ * @return error_code_t 错误码
+ */
+error_code_t range_count(range_t* range, size_t* count)
+{
+    if (range == NULL || count == NULL) {
+        return CSTL_ERROR_NULL_POINTER;
+    }
+
+    range_sink_t sink;
+    memset(&sink, 0, sizeof(sink));
+    sink.type = RANGE_SINK_COUNT;
+    error_code_t error = range_run(range, &sink);
+    *count = sink.count;
+    return error;
+}
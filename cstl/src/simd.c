@@ -0,0 +1,2585 @@
+/**
+ * @file simd.c
+ * @brief CSTL库的SIMD内核实现
+ *
+ * 该文件实现了CSTL库的SIMD内核，包括CPUID特性检测、
+ * 按位查找、计数、比较与相邻查找的AVX2/SSE2/标量实现，
+ * 子序列搜索的首尾元素过滤（AVX2/SSE2）与Horspool实现，
+ * 最小/最大值、求和、平方和、均方根和点积的AVX2/标量实现，
+ * 以及小数组的AVX2双调排序网络。
+ *
+ * AVX2内核通过函数级target属性编译，不需要为整个库开启-mavx2，
+ * 只有在运行时检测到CPU和操作系统都支持时才会被调用。
+ */
+
+#include "cstl/simd.h"
+#include <string.h>
+#include <math.h>
+
+/* 平台检测 */
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define SIMD_X86 1
+#include <emmintrin.h>
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#else
+#include <cpuid.h>
+#endif
+#else
+#define SIMD_X86 0
+#endif
+
+/* 函数级目标指令集属性 */
+#if SIMD_X86 && (defined(__GNUC__) || defined(__clang__))
+#define SIMD_TARGET_SSE2 __attribute__((target("sse2")))
+#define SIMD_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define SIMD_TARGET_SSE2
+#define SIMD_TARGET_AVX2
+#endif
+
+/**
+ * @brief 字节计数器饱和前最多累加的轮数
+ */
+#define SIMD_COUNT_FLUSH 255
+
+/**
+ * @brief 已检测到的CPU特性，检测前为0
+ */
+static volatile unsigned int g_cpu_features = 0;
+
+/**
+ * @brief 是否已完成特性检测
+ */
+static volatile int g_cpu_detected = 0;
+
+/**
+ * @brief 允许使用的特性掩码
+ */
+static volatile unsigned int g_feature_mask = ~0u;
+
+/**
+ * @brief 计算最低位1的位置
+ *
+ * @param mask 非零掩码
+ * @return unsigned int 最低位1的下标
+ */
+static inline unsigned int simd_ctz(unsigned int mask)
+{
+#if defined(_MSC_VER)
+    unsigned long index;
+    _BitScanForward(&index, mask);
+    return (unsigned int)index;
+#else
+    return (unsigned int)__builtin_ctz(mask);
+#endif
+}
+
+/**
+ * @brief 计算最高位1的位置
+ *
+ * @param mask 非零掩码
+ * @return unsigned int 最高位1的下标
+ */
+static inline unsigned int simd_clz_index(unsigned int mask)
+{
+#if defined(_MSC_VER)
+    unsigned long index;
+    _BitScanReverse(&index, mask);
+    return (unsigned int)index;
+#else
+    return 31u - (unsigned int)__builtin_clz(mask);
+#endif
+}
+
+/**
+ * @brief 按元素宽度读取一个元素
+ *
+ * @param p 元素地址
+ * @param width 元素字节数（1/2/4/8）
+ * @return uint64_t 元素的位模式
+ */
+static inline uint64_t simd_load_lane(const void* p, size_t width)
+{
+    switch (width) {
+    case 1: { uint8_t v; memcpy(&v, p, 1); return v; }
+    case 2: { uint16_t v; memcpy(&v, p, 2); return v; }
+    case 4: { uint32_t v; memcpy(&v, p, 4); return v; }
+    default: { uint64_t v; memcpy(&v, p, 8); return v; }
+    }
+}
+
+/**
+ * @brief 判断元素宽度是否有SIMD实现
+ *
+ * @param width 元素字节数
+ * @return int 支持返回非零
+ */
+static inline int simd_width_supported(size_t width)
+{
+    return width == 1 || width == 2 || width == 4 || width == 8;
+}
+
+/*
+ * 标量实现
+ */
+
+/**
+ * @brief 标量查找
+ */
+static size_t scalar_find(const unsigned char* p, size_t count, size_t width, const void* value)
+{
+    if (width == 1) {
+        const unsigned char* hit = (const unsigned char*)memchr(p, *(const unsigned char*)value, count);
+        return hit != NULL ? (size_t)(hit - p) : count;
+    }
+
+    if (simd_width_supported(width)) {
+        uint64_t needle = simd_load_lane(value, width);
+        for (size_t i = 0; i < count; i++) {
+            if (simd_load_lane(p + i * width, width) == needle) {
+                return i;
+            }
+        }
+        return count;
+    }
+
+    for (size_t i = 0; i < count; i++) {
+        if (memcmp(p + i * width, value, width) == 0) {
+            return i;
+        }
+    }
+    return count;
+}
+
+/**
+ * @brief 标量计数
+ */
+static size_t scalar_count(const unsigned char* p, size_t count, size_t width, const void* value)
+{
+    size_t result = 0;
+
+    if (simd_width_supported(width)) {
+        uint64_t needle = simd_load_lane(value, width);
+        for (size_t i = 0; i < count; i++) {
+            result += simd_load_lane(p + i * width, width) == needle;
+        }
+        return result;
+    }
+
+    for (size_t i = 0; i < count; i++) {
+        result += memcmp(p + i * width, value, width) == 0;
+    }
+    return result;
+}
+
+/**
+ * @brief 标量比较，返回第一个不相等元素的下标
+ */
+static size_t scalar_mismatch(const unsigned char* a, const unsigned char* b, size_t count, size_t width)
+{
+    for (size_t i = 0; i < count; i++) {
+        if (memcmp(a + i * width, b + i * width, width) != 0) {
+            return i;
+        }
+    }
+    return count;
+}
+
+/**
+ * @brief 标量相邻查找
+ */
+static size_t scalar_adjacent_find(const unsigned char* p, size_t count, size_t width)
+{
+    for (size_t i = 0; i + 1 < count; i++) {
+        if (memcmp(p + i * width, p + (i + 1) * width, width) == 0) {
+            return i;
+        }
+    }
+    return count;
+}
+
+#if SIMD_X86
+
+/*
+ * CPU特性检测
+ */
+
+/**
+ * @brief 检测CPU和操作系统支持的SIMD特性
+ *
+ * @return unsigned int simd_feature_t标志的按位或
+ */
+static unsigned int simd_detect_features(void)
+{
+    unsigned int features = 0;
+    unsigned int eax = 0, ebx = 0, ecx = 0, edx = 0;
+    unsigned int max_leaf = 0;
+
+#if defined(_MSC_VER)
+    int regs[4];
+    __cpuid(regs, 0);
+    max_leaf = (unsigned int)regs[0];
+    __cpuid(regs, 1);
+    ecx = (unsigned int)regs[2];
+    edx = (unsigned int)regs[3];
+#else
+    max_leaf = __get_cpuid_max(0, NULL);
+    if (max_leaf < 1 || !__get_cpuid(1, &eax, &ebx, &ecx, &edx)) {
+        return 0;
+    }
+#endif
+
+    if (edx & (1u << 26)) {
+        features |= SIMD_FEATURE_SSE2;
+    }
+
+    /* AVX2除CPU支持外，还要求操作系统通过XSAVE保存XMM/YMM状态 */
+    int osxsave = (ecx & (1u << 27)) != 0;
+    int avx = (ecx & (1u << 28)) != 0;
+    if (osxsave && avx && max_leaf >= 7) {
+#if defined(_MSC_VER)
+        unsigned long long xcr0 = _xgetbv(0);
+        __cpuidex(regs, 7, 0);
+        ebx = (unsigned int)regs[1];
+#else
+        unsigned int xcr0_lo = 0, xcr0_hi = 0;
+        __asm__ volatile("xgetbv" : "=a"(xcr0_lo), "=d"(xcr0_hi) : "c"(0));
+        unsigned long long xcr0 = ((unsigned long long)xcr0_hi << 32) | xcr0_lo;
+        __cpuid_count(7, 0, eax, ebx, ecx, edx);
+#endif
+        if ((xcr0 & 6) == 6 && (ebx & (1u << 5))) {
+            features |= SIMD_FEATURE_AVX2;
+        }
+    }
+
+    (void)eax;
+    return features;
+}
+
+/*
+ * SSE2实现
+ */
+
+/**
+ * @brief 将元素值广播到128位向量
+ */
+SIMD_TARGET_SSE2
+static inline __m128i sse2_splat(uint64_t value, size_t width)
+{
+    switch (width) {
+    case 1: return _mm_set1_epi8((char)value);
+    case 2: return _mm_set1_epi16((short)value);
+    case 4: return _mm_set1_epi32((int)value);
+    default: return _mm_set1_epi64x((long long)value);
+    }
+}
+
+/**
+ * @brief 按元素宽度比较相等，相等的元素所有字节置为0xFF
+ *
+ * SSE2没有64位相等比较，用两个32位比较结果相与实现。
+ */
+SIMD_TARGET_SSE2
+static inline __m128i sse2_cmpeq(__m128i a, __m128i b, size_t width)
+{
+    switch (width) {
+    case 1: return _mm_cmpeq_epi8(a, b);
+    case 2: return _mm_cmpeq_epi16(a, b);
+    case 4: return _mm_cmpeq_epi32(a, b);
+    default: {
+        __m128i eq = _mm_cmpeq_epi32(a, b);
+        return _mm_and_si128(eq, _mm_shuffle_epi32(eq, _MM_SHUFFLE(2, 3, 0, 1)));
+    }
+    }
+}
+
+/**
+ * @brief SSE2查找，每轮处理64字节
+ */
+SIMD_TARGET_SSE2
+static size_t sse2_find(const unsigned char* p, size_t count, size_t width, const void* value)
+{
+    size_t bytes = count * width;
+    size_t i = 0;
+    __m128i needle = sse2_splat(simd_load_lane(value, width), width);
+
+    for (; i + 64 <= bytes; i += 64) {
+        __m128i e0 = sse2_cmpeq(_mm_loadu_si128((const __m128i*)(p + i)), needle, width);
+        __m128i e1 = sse2_cmpeq(_mm_loadu_si128((const __m128i*)(p + i + 16)), needle, width);
+        __m128i e2 = sse2_cmpeq(_mm_loadu_si128((const __m128i*)(p + i + 32)), needle, width);
+        __m128i e3 = sse2_cmpeq(_mm_loadu_si128((const __m128i*)(p + i + 48)), needle, width);
+        __m128i any = _mm_or_si128(_mm_or_si128(e0, e1), _mm_or_si128(e2, e3));
+        if (_mm_movemask_epi8(any) != 0) {
+            /* 命中后再逐个向量定位 */
+            unsigned int mask = (unsigned int)_mm_movemask_epi8(e0)
+                              | ((unsigned int)_mm_movemask_epi8(e1) << 16);
+            if (mask != 0) {
+                return (i + simd_ctz(mask)) / width;
+            }
+            mask = (unsigned int)_mm_movemask_epi8(e2) | ((unsigned int)_mm_movemask_epi8(e3) << 16);
+            return (i + 32 + simd_ctz(mask)) / width;
+        }
+    }
+
+    for (; i + 16 <= bytes; i += 16) {
+        unsigned int mask = (unsigned int)_mm_movemask_epi8(
+            sse2_cmpeq(_mm_loadu_si128((const __m128i*)(p + i)), needle, width));
+        if (mask != 0) {
+            return (i + simd_ctz(mask)) / width;
+        }
+    }
+
+    return i / width + scalar_find(p + i, count - i / width, width, value);
+}
+
+/**
+ * @brief 将字节计数器横向求和
+ */
+SIMD_TARGET_SSE2
+static inline size_t sse2_sum_bytes(__m128i counters)
+{
+    __m128i sums = _mm_sad_epu8(counters, _mm_setzero_si128());
+    return (size_t)_mm_cvtsi128_si32(sums) + (size_t)_mm_cvtsi128_si32(_mm_srli_si128(sums, 8));
+}
+
+/**
+ * @brief SSE2计数
+ *
+ * 相等元素的每个字节比较结果为0xFF（即-1），用字节减法累加，
+ * 每255轮用SAD横向求和一次防止溢出，最后除以元素宽度。
+ */
+SIMD_TARGET_SSE2
+static size_t sse2_count(const unsigned char* p, size_t count, size_t width, const void* value)
+{
+    size_t bytes = count * width;
+    size_t i = 0;
+    size_t matched_bytes = 0;
+    __m128i needle = sse2_splat(simd_load_lane(value, width), width);
+
+    while (i + 16 <= bytes) {
+        __m128i counters = _mm_setzero_si128();
+        for (int round = 0; round < SIMD_COUNT_FLUSH && i + 16 <= bytes; round++, i += 16) {
+            __m128i eq = sse2_cmpeq(_mm_loadu_si128((const __m128i*)(p + i)), needle, width);
+            counters = _mm_sub_epi8(counters, eq);
+        }
+        matched_bytes += sse2_sum_bytes(counters);
+    }
+
+    return matched_bytes / width + scalar_count(p + i, count - i / width, width, value);
+}
+
+/**
+ * @brief SSE2比较
+ */
+SIMD_TARGET_SSE2
+static size_t sse2_mismatch(const unsigned char* a, const unsigned char* b, size_t count, size_t width)
+{
+    size_t bytes = count * width;
+    size_t i = 0;
+
+    for (; i + 16 <= bytes; i += 16) {
+        __m128i eq = _mm_cmpeq_epi8(_mm_loadu_si128((const __m128i*)(a + i)),
+                                    _mm_loadu_si128((const __m128i*)(b + i)));
+        unsigned int mask = (unsigned int)_mm_movemask_epi8(eq) ^ 0xFFFFu;
+        if (mask != 0) {
+            return (i + simd_ctz(mask)) / width;
+        }
+    }
+
+    /* 剩余字节可能从元素中间开始，退回到所在元素的起点 */
+    size_t first = i / width;
+    return first + scalar_mismatch(a + first * width, b + first * width, count - first, width);
+}
+
+/**
+ * @brief SSE2相邻查找
+ */
+SIMD_TARGET_SSE2
+static size_t sse2_adjacent_find(const unsigned char* p, size_t count, size_t width)
+{
+    size_t bytes = count * width;
+    size_t i = 0;
+
+    for (; i + width + 16 <= bytes; i += 16) {
+        __m128i eq = sse2_cmpeq(_mm_loadu_si128((const __m128i*)(p + i)),
+                                _mm_loadu_si128((const __m128i*)(p + i + width)), width);
+        unsigned int mask = (unsigned int)_mm_movemask_epi8(eq);
+        if (mask != 0) {
+            return (i + simd_ctz(mask)) / width;
+        }
+    }
+
+    size_t first = i / width;
+    size_t found = scalar_adjacent_find(p + i, count - first, width);
+    return found == count - first ? count : first + found;
+}
+
+/*
+ * AVX2实现
+ */
+
+/**
+ * @brief 将元素值广播到256位向量
+ */
+SIMD_TARGET_AVX2
+static inline __m256i avx2_splat(uint64_t value, size_t width)
+{
+    switch (width) {
+    case 1: return _mm256_set1_epi8((char)value);
+    case 2: return _mm256_set1_epi16((short)value);
+    case 4: return _mm256_set1_epi32((int)value);
+    default: return _mm256_set1_epi64x((long long)value);
+    }
+}
+
+/**
+ * @brief 按元素宽度比较相等
+ */
+SIMD_TARGET_AVX2
+static inline __m256i avx2_cmpeq(__m256i a, __m256i b, size_t width)
+{
+    switch (width) {
+    case 1: return _mm256_cmpeq_epi8(a, b);
+    case 2: return _mm256_cmpeq_epi16(a, b);
+    case 4: return _mm256_cmpeq_epi32(a, b);
+    default: return _mm256_cmpeq_epi64(a, b);
+    }
+}
+
+/**
+ * @brief AVX2查找，每轮处理64字节
+ */
+SIMD_TARGET_AVX2
+static size_t avx2_find(const unsigned char* p, size_t count, size_t width, const void* value)
+{
+    size_t bytes = count * width;
+    size_t i = 0;
+    __m256i needle = avx2_splat(simd_load_lane(value, width), width);
+
+    for (; i + 64 <= bytes; i += 64) {
+        __m256i e0 = avx2_cmpeq(_mm256_loadu_si256((const __m256i*)(p + i)), needle, width);
+        __m256i e1 = avx2_cmpeq(_mm256_loadu_si256((const __m256i*)(p + i + 32)), needle, width);
+        if (!_mm256_testz_si256(_mm256_or_si256(e0, e1), _mm256_or_si256(e0, e1))) {
+            unsigned int mask = (unsigned int)_mm256_movemask_epi8(e0);
+            if (mask != 0) {
+                return (i + simd_ctz(mask)) / width;
+            }
+            mask = (unsigned int)_mm256_movemask_epi8(e1);
+            return (i + 32 + simd_ctz(mask)) / width;
+        }
+    }
+
+    for (; i + 32 <= bytes; i += 32) {
+        unsigned int mask = (unsigned int)_mm256_movemask_epi8(
+            avx2_cmpeq(_mm256_loadu_si256((const __m256i*)(p + i)), needle, width));
+        if (mask != 0) {
+            return (i + simd_ctz(mask)) / width;
+        }
+    }
+
+    return i / width + scalar_find(p + i, count - i / width, width, value);
+}
+
+/**
+ * @brief AVX2计数
+ */
+SIMD_TARGET_AVX2
+static size_t avx2_count(const unsigned char* p, size_t count, size_t width, const void* value)
+{
+    size_t bytes = count * width;
+    size_t i = 0;
+    size_t matched_bytes = 0;
+    __m256i needle = avx2_splat(simd_load_lane(value, width), width);
+
+    while (i + 32 <= bytes) {
+        __m256i counters = _mm256_setzero_si256();
+        for (int round = 0; round < SIMD_COUNT_FLUSH && i + 32 <= bytes; round++, i += 32) {
+            __m256i eq = avx2_cmpeq(_mm256_loadu_si256((const __m256i*)(p + i)), needle, width);
+            counters = _mm256_sub_epi8(counters, eq);
+        }
+        __m256i sums = _mm256_sad_epu8(counters, _mm256_setzero_si256());
+        __m128i half = _mm_add_epi64(_mm256_castsi256_si128(sums), _mm256_extracti128_si256(sums, 1));
+        matched_bytes += (size_t)_mm_cvtsi128_si32(half) + (size_t)_mm_cvtsi128_si32(_mm_srli_si128(half, 8));
+    }
+
+    return matched_bytes / width + scalar_count(p + i, count - i / width, width, value);
+}
+
+/**
+ * @brief AVX2比较
+ */
+SIMD_TARGET_AVX2
+static size_t avx2_mismatch(const unsigned char* a, const unsigned char* b, size_t count, size_t width)
+{
+    size_t bytes = count * width;
+    size_t i = 0;
+
+    for (; i + 32 <= bytes; i += 32) {
+        __m256i eq = _mm256_cmpeq_epi8(_mm256_loadu_si256((const __m256i*)(a + i)),
+                                       _mm256_loadu_si256((const __m256i*)(b + i)));
+        unsigned int mask = ~(unsigned int)_mm256_movemask_epi8(eq);
+        if (mask != 0) {
+            return (i + simd_ctz(mask)) / width;
+        }
+    }
+
+    size_t first = i / width;
+    return first + scalar_mismatch(a + first * width, b + first * width, count - first, width);
+}
+
+/**
+ * @brief AVX2相邻查找
+ */
+SIMD_TARGET_AVX2
+static size_t avx2_adjacent_find(const unsigned char* p, size_t count, size_t width)
+{
+    size_t bytes = count * width;
+    size_t i = 0;
+
+    for (; i + width + 32 <= bytes; i += 32) {
+        __m256i eq = avx2_cmpeq(_mm256_loadu_si256((const __m256i*)(p + i)),
+                                _mm256_loadu_si256((const __m256i*)(p + i + width)), width);
+        unsigned int mask = (unsigned int)_mm256_movemask_epi8(eq);
+        if (mask != 0) {
+            return (i + simd_ctz(mask)) / width;
+        }
+    }
+
+    size_t first = i / width;
+    size_t found = scalar_adjacent_find(p + i, count - first, width);
+    return found == count - first ? count : first + found;
+}
+
+#endif /* SIMD_X86 */
+
+/**
+ * @brief 获取当前CPU支持的SIMD特性
+ *
+ * @return unsigned int simd_feature_t标志的按位或
+ */
+unsigned int simd_cpu_features(void)
+{
+    if (!g_cpu_detected) {
+#if SIMD_X86
+        g_cpu_features = simd_detect_features();
+#else
+        g_cpu_features = 0;
+#endif
+        g_cpu_detected = 1;
+    }
+    return g_cpu_features;
+}
+
+/**
+ * @brief 获取内核实际使用的SIMD特性
+ *
+ * @return unsigned int CPU支持的特性与特性掩码的交集
+ */
+unsigned int simd_active_features(void)
+{
+    return simd_cpu_features() & g_feature_mask;
+}
+
+/**
+ * @brief 设置允许使用的SIMD特性掩码
+ *
+ * @param mask simd_feature_t标志的按位或
+ */
+void simd_set_feature_mask(unsigned int mask)
+{
+    g_feature_mask = mask;
+}
+
+/**
+ * @brief 按位查找第一个等于给定值的元素
+ *
+ * @param data 数据首地址
+ * @param count 元素数量
+ * @param width 元素字节数
+ * @param value 要查找的值指针
+ * @return size_t 第一个相等元素的下标，未找到返回count
+ */
+size_t simd_find(const void* data, size_t count, size_t width, const void* value)
+{
+    if (data == NULL || value == NULL || count == 0 || width == 0) {
+        return count;
+    }
+
+#if SIMD_X86
+    if (simd_width_supported(width)) {
+        unsigned int features = simd_active_features();
+        if (features & SIMD_FEATURE_AVX2) {
+            return avx2_find((const unsigned char*)data, count, width, value);
+        }
+        if (features & SIMD_FEATURE_SSE2) {
+            return sse2_find((const unsigned char*)data, count, width, value);
+        }
+    }
+#endif
+
+    return scalar_find((const unsigned char*)data, count, width, value);
+}
+
+/**
+ * @brief 按位统计等于给定值的元素数量
+ *
+ * @param data 数据首地址
+ * @param count 元素数量
+ * @param width 元素字节数
+ * @param value 要统计的值指针
+ * @return size_t 相等元素的数量
+ */
+size_t simd_count(const void* data, size_t count, size_t width, const void* value)
+{
+    if (data == NULL || value == NULL || count == 0 || width == 0) {
+        return 0;
+    }
+
+#if SIMD_X86
+    if (simd_width_supported(width)) {
+        unsigned int features = simd_active_features();
+        if (features & SIMD_FEATURE_AVX2) {
+            return avx2_count((const unsigned char*)data, count, width, value);
+        }
+        if (features & SIMD_FEATURE_SSE2) {
+            return sse2_count((const unsigned char*)data, count, width, value);
+        }
+    }
+#endif
+
+    return scalar_count((const unsigned char*)data, count, width, value);
+}
+
+/**
+ * @brief 按位查找两个数组中第一个不相等的元素
+ *
+ * @param a 第一个数组首地址
+ * @param b 第二个数组首地址
+ * @param count 元素数量
+ * @param width 元素字节数
+ * @return size_t 第一个不相等元素的下标，全部相等返回count
+ */
+size_t simd_mismatch(const void* a, const void* b, size_t count, size_t width)
+{
+    if (a == NULL || b == NULL || count == 0 || width == 0 || a == b) {
+        return count;
+    }
+
+#if SIMD_X86
+    unsigned int features = simd_active_features();
+    if (features & SIMD_FEATURE_AVX2) {
+        return avx2_mismatch((const unsigned char*)a, (const unsigned char*)b, count, width);
+    }
+    if (features & SIMD_FEATURE_SSE2) {
+        return sse2_mismatch((const unsigned char*)a, (const unsigned char*)b, count, width);
+    }
+#endif
+
+    return scalar_mismatch((const unsigned char*)a, (const unsigned char*)b, count, width);
+}
+
+/**
+ * @brief 按位查找第一对相邻的相等元素
+ *
+ * @param data 数据首地址
+ * @param count 元素数量
+ * @param width 元素字节数
+ * @return size_t 满足data[i] == data[i + 1]的最小下标i，未找到返回count
+ */
+size_t simd_adjacent_find(const void* data, size_t count, size_t width)
+{
+    if (data == NULL || count < 2 || width == 0) {
+        return count;
+    }
+
+#if SIMD_X86
+    if (simd_width_supported(width)) {
+        unsigned int features = simd_active_features();
+        if (features & SIMD_FEATURE_AVX2) {
+            return avx2_adjacent_find((const unsigned char*)data, count, width);
+        }
+        if (features & SIMD_FEATURE_SSE2) {
+            return sse2_adjacent_find((const unsigned char*)data, count, width);
+        }
+    }
+#endif
+
+    return scalar_adjacent_find((const unsigned char*)data, count, width);
+}
+
+/*
+ * 子序列搜索
+ *
+ * 短模式使用首尾元素过滤：把模式的第一个和最后一个元素广播到向量，
+ * 同时比较每个候选起点的首元素和尾元素，只有两者都相等的位置才用memcmp
+ * 校验中间部分，随机数据上几乎不会触发校验。
+ * 长模式使用Boyer-Moore-Horspool，按窗口末元素的散列查表跳跃，
+ * 每次最多跳过整个模式长度。反向搜索是两者的镜像。
+ */
+
+/**
+ * @brief 使用首尾元素过滤的最大模式字节数，更长的模式使用Horspool
+ */
+#define SIMD_SEARCH_FILTER_MAX 256
+
+/**
+ * @brief Horspool跳转表的散列，取元素首尾字节
+ *
+ * @param p 元素地址
+ * @param width 元素字节数
+ * @return unsigned char 散列值
+ */
+static inline unsigned char search_hash(const unsigned char* p, size_t width)
+{
+    return width == 1 ? p[0] : (unsigned char)(p[0] ^ p[width - 1]);
+}
+
+/**
+ * @brief 标量正向Horspool搜索
+ *
+ * 跳转表以散列值为下标，同一散列值取最小的跳转距离，因此不会错过匹配。
+ */
+static size_t scalar_search(const unsigned char* p, size_t count,
+                            const unsigned char* needle, size_t m, size_t width)
+{
+    size_t shift[256];
+    size_t last = (m - 1) * width;
+
+    for (size_t i = 0; i < 256; i++) {
+        shift[i] = m;
+    }
+    for (size_t j = 0; j + 1 < m; j++) {
+        shift[search_hash(needle + j * width, width)] = m - 1 - j;
+    }
+
+    size_t pos = 0;
+    while (pos + m <= count) {
+        const unsigned char* window = p + pos * width;
+        if (memcmp(window + last, needle + last, width) == 0 && memcmp(window, needle, last) == 0) {
+            return pos;
+        }
+        pos += shift[search_hash(window + last, width)];
+    }
+
+    return count;
+}
+
+/**
+ * @brief 标量反向Horspool搜索，按窗口首元素的散列向前跳跃
+ */
+static size_t scalar_search_last(const unsigned char* p, size_t count,
+                                 const unsigned char* needle, size_t m, size_t width)
+{
+    size_t shift[256];
+
+    for (size_t i = 0; i < 256; i++) {
+        shift[i] = m;
+    }
+    for (size_t j = m - 1; j > 0; j--) {
+        shift[search_hash(needle + j * width, width)] = j;
+    }
+
+    size_t pos = count - m;
+    for (;;) {
+        const unsigned char* window = p + pos * width;
+        if (memcmp(window, needle, width) == 0 && memcmp(window + width, needle + width, (m - 1) * width) == 0) {
+            return pos;
+        }
+        size_t step = shift[search_hash(window, width)];
+        if (step > pos) {
+            return count;
+        }
+        pos -= step;
+    }
+}
+
+#if SIMD_X86
+
+/**
+ * @brief 只保留每个元素最低字节的掩码位
+ *
+ * @param width 元素字节数（1/2/4/8）
+ * @return unsigned int 32位掩码
+ */
+static inline unsigned int search_lane_mask(size_t width)
+{
+    switch (width) {
+    case 1: return 0xFFFFFFFFu;
+    case 2: return 0x55555555u;
+    case 4: return 0x11111111u;
+    default: return 0x01010101u;
+    }
+}
+
+/**
+ * @brief 校验候选起点的中间部分
+ *
+ * @param window 候选起点
+ * @param needle 模式
+ * @param last 模式末元素的字节偏移
+ * @param width 元素字节数
+ * @return int 匹配返回非零
+ */
+static inline int search_verify(const unsigned char* window, const unsigned char* needle, size_t last, size_t width)
+{
+    return last <= width || memcmp(window + width, needle + width, last - width) == 0;
+}
+
+/**
+ * @brief SSE2首尾元素过滤正向搜索，每轮检查16字节的候选起点
+ */
+SIMD_TARGET_SSE2
+static size_t sse2_search(const unsigned char* p, size_t count,
+                          const unsigned char* needle, size_t m, size_t width)
+{
+    size_t last = (m - 1) * width;
+    size_t top = (count - m + 1) * width;
+    unsigned int lanes = search_lane_mask(width) & 0xFFFFu;
+    __m128i first = sse2_splat(simd_load_lane(needle, width), width);
+    __m128i tail = sse2_splat(simd_load_lane(needle + last, width), width);
+    size_t i = 0;
+
+    for (; i + 16 <= top; i += 16) {
+        __m128i e0 = sse2_cmpeq(_mm_loadu_si128((const __m128i*)(p + i)), first, width);
+        __m128i e1 = sse2_cmpeq(_mm_loadu_si128((const __m128i*)(p + i + last)), tail, width);
+        unsigned int mask = (unsigned int)_mm_movemask_epi8(_mm_and_si128(e0, e1)) & lanes;
+        while (mask != 0) {
+            size_t offset = i + simd_ctz(mask);
+            if (search_verify(p + offset, needle, last, width)) {
+                return offset / width;
+            }
+            mask &= mask - 1;
+        }
+    }
+
+    for (; i < top; i += width) {
+        if (memcmp(p + i, needle, width) == 0 && memcmp(p + i + last, needle + last, width) == 0 &&
+            search_verify(p + i, needle, last, width)) {
+            return i / width;
+        }
+    }
+
+    return count;
+}
+
+/**
+ * @brief SSE2首尾元素过滤反向搜索
+ */
+SIMD_TARGET_SSE2
+static size_t sse2_search_last(const unsigned char* p, size_t count,
+                               const unsigned char* needle, size_t m, size_t width)
+{
+    size_t last = (m - 1) * width;
+    size_t top = (count - m + 1) * width;
+    unsigned int lanes = search_lane_mask(width) & 0xFFFFu;
+    __m128i first = sse2_splat(simd_load_lane(needle, width), width);
+    __m128i tail = sse2_splat(simd_load_lane(needle + last, width), width);
+    size_t i = top;
+
+    for (; i >= 16; i -= 16) {
+        size_t base = i - 16;
+        __m128i e0 = sse2_cmpeq(_mm_loadu_si128((const __m128i*)(p + base)), first, width);
+        __m128i e1 = sse2_cmpeq(_mm_loadu_si128((const __m128i*)(p + base + last)), tail, width);
+        unsigned int mask = (unsigned int)_mm_movemask_epi8(_mm_and_si128(e0, e1)) & lanes;
+        while (mask != 0) {
+            unsigned int bit = simd_clz_index(mask);
+            if (search_verify(p + base + bit, needle, last, width)) {
+                return (base + bit) / width;
+            }
+            mask &= ~(1u << bit);
+        }
+    }
+
+    while (i > 0) {
+        i -= width;
+        if (memcmp(p + i, needle, width) == 0 && memcmp(p + i + last, needle + last, width) == 0 &&
+            search_verify(p + i, needle, last, width)) {
+            return i / width;
+        }
+    }
+
+    return count;
+}
+
+/**
+ * @brief AVX2首尾元素过滤正向搜索，每轮检查32字节的候选起点
+ */
+SIMD_TARGET_AVX2
+static size_t avx2_search(const unsigned char* p, size_t count,
+                          const unsigned char* needle, size_t m, size_t width)
+{
+    size_t last = (m - 1) * width;
+    size_t top = (count - m + 1) * width;
+    unsigned int lanes = search_lane_mask(width);
+    __m256i first = avx2_splat(simd_load_lane(needle, width), width);
+    __m256i tail = avx2_splat(simd_load_lane(needle + last, width), width);
+    size_t i = 0;
+
+    for (; i + 32 <= top; i += 32) {
+        __m256i e0 = avx2_cmpeq(_mm256_loadu_si256((const __m256i*)(p + i)), first, width);
+        __m256i e1 = avx2_cmpeq(_mm256_loadu_si256((const __m256i*)(p + i + last)), tail, width);
+        unsigned int mask = (unsigned int)_mm256_movemask_epi8(_mm256_and_si256(e0, e1)) & lanes;
+        while (mask != 0) {
+            size_t offset = i + simd_ctz(mask);
+            if (search_verify(p + offset, needle, last, width)) {
+                return offset / width;
+            }
+            mask &= mask - 1;
+        }
+    }
+
+    /* 剩余起点不足一轮时交给SSE2处理 */
+    if (i >= top) {
+        return count;
+    }
+    size_t found = sse2_search(p + i, count - i / width, needle, m, width);
+    return found == count - i / width ? count : i / width + found;
+}
+
+/**
+ * @brief AVX2首尾元素过滤反向搜索
+ */
+SIMD_TARGET_AVX2
+static size_t avx2_search_last(const unsigned char* p, size_t count,
+                               const unsigned char* needle, size_t m, size_t width)
+{
+    size_t last = (m - 1) * width;
+    size_t top = (count - m + 1) * width;
+    unsigned int lanes = search_lane_mask(width);
+    __m256i first = avx2_splat(simd_load_lane(needle, width), width);
+    __m256i tail = avx2_splat(simd_load_lane(needle + last, width), width);
+    size_t i = top;
+
+    for (; i >= 32; i -= 32) {
+        size_t base = i - 32;
+        __m256i e0 = avx2_cmpeq(_mm256_loadu_si256((const __m256i*)(p + base)), first, width);
+        __m256i e1 = avx2_cmpeq(_mm256_loadu_si256((const __m256i*)(p + base + last)), tail, width);
+        unsigned int mask = (unsigned int)_mm256_movemask_epi8(_mm256_and_si256(e0, e1)) & lanes;
+        while (mask != 0) {
+            unsigned int bit = simd_clz_index(mask);
+            if (search_verify(p + base + bit, needle, last, width)) {
+                return (base + bit) / width;
+            }
+            mask &= ~(1u << bit);
+        }
+    }
+
+    /* 剩余的起点都在前i字节内，作为一个更短的数组交给SSE2处理 */
+    if (i == 0) {
+        return count;
+    }
+    size_t head = i / width + m - 1;
+    size_t found = sse2_search_last(p, head, needle, m, width);
+    return found == head ? count : found;
+}
+
+#endif /* SIMD_X86 */
+
+/**
+ * @brief 按位查找子序列第一次出现的位置
+ *
+ * @param data 数据首地址
+ * @param count 元素数量
+ * @param needle 子序列首地址
+ * @param needle_count 子序列元素数量
+ * @param width 元素字节数
+ * @return size_t 第一次出现的起始下标，未找到返回count
+ */
+size_t simd_search(const void* data, size_t count, const void* needle, size_t needle_count, size_t width)
+{
+    if (data == NULL || needle == NULL || width == 0 || needle_count == 0 || needle_count > count) {
+        return count;
+    }
+    if (needle_count == 1) {
+        return simd_find(data, count, width, needle);
+    }
+
+#if SIMD_X86
+    if (simd_width_supported(width) && needle_count * width <= SIMD_SEARCH_FILTER_MAX) {
+        unsigned int features = simd_active_features();
+        if (features & SIMD_FEATURE_AVX2) {
+            return avx2_search((const unsigned char*)data, count, (const unsigned char*)needle, needle_count, width);
+        }
+        if (features & SIMD_FEATURE_SSE2) {
+            return sse2_search((const unsigned char*)data, count, (const unsigned char*)needle, needle_count, width);
+        }
+    }
+#endif
+
+    return scalar_search((const unsigned char*)data, count, (const unsigned char*)needle, needle_count, width);
+}
+
+/**
+ * @brief 按位查找子序列最后一次出现的位置
+ *
+ * @param data 数据首地址
+ * @param count 元素数量
+ * @param needle 子序列首地址
+ * @param needle_count 子序列元素数量
+ * @param width 元素字节数
+ * @return size_t 最后一次出现的起始下标，未找到返回count
+ */
+size_t simd_search_last(const void* data, size_t count, const void* needle, size_t needle_count, size_t width)
+{
+    if (data == NULL || needle == NULL || width == 0 || needle_count == 0 || needle_count > count) {
+        return count;
+    }
+
+#if SIMD_X86
+    if (simd_width_supported(width) && needle_count * width <= SIMD_SEARCH_FILTER_MAX) {
+        unsigned int features = simd_active_features();
+        if (features & SIMD_FEATURE_AVX2) {
+            return avx2_search_last((const unsigned char*)data, count, (const unsigned char*)needle,
+                                    needle_count, width);
+        }
+        if (features & SIMD_FEATURE_SSE2) {
+            return sse2_search_last((const unsigned char*)data, count, (const unsigned char*)needle,
+                                    needle_count, width);
+        }
+    }
+#endif
+
+    return scalar_search_last((const unsigned char*)data, count, (const unsigned char*)needle, needle_count, width);
+}
+
+/*
+ * 数值内核
+ *
+ * 整数求和在64位整数中精确累加；浮点求和在double中使用Kahan补偿，
+ * float输入先转换为double。最小/最大值先用SIMD求出极值，
+ * 再扫描一次定位第一次出现的位置，浮点数中的NaN会被跳过。
+ */
+
+/**
+ * @brief Neumaier补偿求和状态
+ */
+typedef struct {
+    double sum;     /**< 部分和 */
+    double comp;    /**< 累计的舍入误差 */
+} kahan_t;
+
+/**
+ * @brief 向补偿求和状态中加入一个值
+ *
+ * @param k 补偿求和状态
+ * @param x 加数
+ */
+static inline void kahan_add(kahan_t* k, double x)
+{
+    double t = k->sum + x;
+    if (fabs(k->sum) >= fabs(x)) {
+        k->comp += (k->sum - t) + x;
+    } else {
+        k->comp += (x - t) + k->sum;
+    }
+    k->sum = t;
+}
+
+/**
+ * @brief 生成标量最小/最大值下标查找函数
+ *
+ * 使用严格小于/大于比较，返回第一次出现的位置；
+ * 对浮点数，当前极值为NaN时会被后续非NaN元素替换。
+ */
+#define SCALAR_MINMAX(suffix, type)                                                  \
+static void scalar_minmax_##suffix(const type* p, size_t count,                     \
+                                   size_t* min_index, size_t* max_index)            \
+{                                                                                    \
+    size_t lo = 0;                                                                   \
+    size_t hi = 0;                                                                   \
+    for (size_t i = 1; i < count; i++) {                                             \
+        type x = p[i];                                                               \
+        if (x < p[lo] || (p[lo] != p[lo] && x == x)) {                               \
+            lo = i;                                                                  \
+        }                                                                            \
+        if (x > p[hi] || (p[hi] != p[hi] && x == x)) {                               \
+            hi = i;                                                                  \
+        }                                                                            \
+    }                                                                                \
+    if (min_index != NULL) {                                                         \
+        *min_index = lo;                                                             \
+    }                                                                                \
+    if (max_index != NULL) {                                                         \
+        *max_index = hi;                                                             \
+    }                                                                                \
+}
+
+SCALAR_MINMAX(i16, int16_t)
+SCALAR_MINMAX(i32, int32_t)
+SCALAR_MINMAX(f32, float)
+SCALAR_MINMAX(f64, double)
+
+#undef SCALAR_MINMAX
+
+#if SIMD_X86
+
+/**
+ * @brief 将AVX2的int16最小/最大值向量横向归约
+ */
+SIMD_TARGET_AVX2
+static void avx2_reduce_i16(__m256i vmin, __m256i vmax, int16_t* lo, int16_t* hi)
+{
+    int16_t mins[16];
+    int16_t maxs[16];
+    _mm256_storeu_si256((__m256i*)mins, vmin);
+    _mm256_storeu_si256((__m256i*)maxs, vmax);
+    for (int k = 0; k < 16; k++) {
+        if (mins[k] < *lo) {
+            *lo = mins[k];
+        }
+        if (maxs[k] > *hi) {
+            *hi = maxs[k];
+        }
+    }
+}
+
+/**
+ * @brief AVX2 int16最小/最大值下标
+ */
+SIMD_TARGET_AVX2
+static void avx2_minmax_i16(const int16_t* p, size_t count, size_t* min_index, size_t* max_index)
+{
+    __m256i vmin = _mm256_set1_epi16(INT16_MAX);
+    __m256i vmax = _mm256_set1_epi16(INT16_MIN);
+    size_t i = 0;
+
+    for (; i + 16 <= count; i += 16) {
+        __m256i x = _mm256_loadu_si256((const __m256i*)(p + i));
+        vmin = _mm256_min_epi16(vmin, x);
+        vmax = _mm256_max_epi16(vmax, x);
+    }
+
+    int16_t lo = INT16_MAX;
+    int16_t hi = INT16_MIN;
+    avx2_reduce_i16(vmin, vmax, &lo, &hi);
+    for (; i < count; i++) {
+        lo = p[i] < lo ? p[i] : lo;
+        hi = p[i] > hi ? p[i] : hi;
+    }
+
+    if (min_index != NULL) {
+        *min_index = avx2_find((const unsigned char*)p, count, sizeof(int16_t), &lo);
+    }
+    if (max_index != NULL) {
+        *max_index = avx2_find((const unsigned char*)p, count, sizeof(int16_t), &hi);
+    }
+}
+
+/**
+ * @brief AVX2 int32最小/最大值下标
+ */
+SIMD_TARGET_AVX2
+static void avx2_minmax_i32(const int32_t* p, size_t count, size_t* min_index, size_t* max_index)
+{
+    __m256i vmin = _mm256_set1_epi32(INT32_MAX);
+    __m256i vmax = _mm256_set1_epi32(INT32_MIN);
+    size_t i = 0;
+
+    for (; i + 8 <= count; i += 8) {
+        __m256i x = _mm256_loadu_si256((const __m256i*)(p + i));
+        vmin = _mm256_min_epi32(vmin, x);
+        vmax = _mm256_max_epi32(vmax, x);
+    }
+
+    int32_t mins[8];
+    int32_t maxs[8];
+    int32_t lo = INT32_MAX;
+    int32_t hi = INT32_MIN;
+    _mm256_storeu_si256((__m256i*)mins, vmin);
+    _mm256_storeu_si256((__m256i*)maxs, vmax);
+    for (int k = 0; k < 8; k++) {
+        lo = mins[k] < lo ? mins[k] : lo;
+        hi = maxs[k] > hi ? maxs[k] : hi;
+    }
+    for (; i < count; i++) {
+        lo = p[i] < lo ? p[i] : lo;
+        hi = p[i] > hi ? p[i] : hi;
+    }
+
+    if (min_index != NULL) {
+        *min_index = avx2_find((const unsigned char*)p, count, sizeof(int32_t), &lo);
+    }
+    if (max_index != NULL) {
+        *max_index = avx2_find((const unsigned char*)p, count, sizeof(int32_t), &hi);
+    }
+}
+
+/**
+ * @brief AVX2 float按值查找（-0.0与+0.0相等）
+ */
+SIMD_TARGET_AVX2
+static size_t avx2_find_value_f32(const float* p, size_t count, float value)
+{
+    __m256 needle = _mm256_set1_ps(value);
+    size_t i = 0;
+
+    for (; i + 8 <= count; i += 8) {
+        int mask = _mm256_movemask_ps(_mm256_cmp_ps(_mm256_loadu_ps(p + i), needle, _CMP_EQ_OQ));
+        if (mask != 0) {
+            return i + simd_ctz((unsigned int)mask);
+        }
+    }
+    for (; i < count; i++) {
+        if (p[i] == value) {
+            return i;
+        }
+    }
+    return count;
+}
+
+/**
+ * @brief AVX2 double按值查找（-0.0与+0.0相等）
+ */
+SIMD_TARGET_AVX2
+static size_t avx2_find_value_f64(const double* p, size_t count, double value)
+{
+    __m256d needle = _mm256_set1_pd(value);
+    size_t i = 0;
+
+    for (; i + 4 <= count; i += 4) {
+        int mask = _mm256_movemask_pd(_mm256_cmp_pd(_mm256_loadu_pd(p + i), needle, _CMP_EQ_OQ));
+        if (mask != 0) {
+            return i + simd_ctz((unsigned int)mask);
+        }
+    }
+    for (; i < count; i++) {
+        if (p[i] == value) {
+            return i;
+        }
+    }
+    return count;
+}
+
+/**
+ * @brief AVX2 float最小/最大值下标
+ *
+ * minps/maxps在任一操作数为NaN时返回第二个操作数，
+ * 把累加向量放在第二个位置即可跳过NaN。
+ */
+SIMD_TARGET_AVX2
+static void avx2_minmax_f32(const float* p, size_t count, size_t* min_index, size_t* max_index)
+{
+    __m256 vmin = _mm256_set1_ps(HUGE_VALF);
+    __m256 vmax = _mm256_set1_ps(-HUGE_VALF);
+    size_t i = 0;
+
+    for (; i + 8 <= count; i += 8) {
+        __m256 x = _mm256_loadu_ps(p + i);
+        vmin = _mm256_min_ps(x, vmin);
+        vmax = _mm256_max_ps(x, vmax);
+    }
+
+    float mins[8];
+    float maxs[8];
+    float lo = HUGE_VALF;
+    float hi = -HUGE_VALF;
+    _mm256_storeu_ps(mins, vmin);
+    _mm256_storeu_ps(maxs, vmax);
+    for (int k = 0; k < 8; k++) {
+        lo = mins[k] < lo ? mins[k] : lo;
+        hi = maxs[k] > hi ? maxs[k] : hi;
+    }
+    for (; i < count; i++) {
+        lo = p[i] < lo ? p[i] : lo;
+        hi = p[i] > hi ? p[i] : hi;
+    }
+
+    /* 全部为NaN时与标量实现一致，返回第一个元素 */
+    if (min_index != NULL) {
+        size_t index = avx2_find_value_f32(p, count, lo);
+        *min_index = index < count ? index : 0;
+    }
+    if (max_index != NULL) {
+        size_t index = avx2_find_value_f32(p, count, hi);
+        *max_index = index < count ? index : 0;
+    }
+}
+
+/**
+ * @brief AVX2 double最小/最大值下标
+ */
+SIMD_TARGET_AVX2
+static void avx2_minmax_f64(const double* p, size_t count, size_t* min_index, size_t* max_index)
+{
+    __m256d vmin = _mm256_set1_pd(HUGE_VAL);
+    __m256d vmax = _mm256_set1_pd(-HUGE_VAL);
+    size_t i = 0;
+
+    for (; i + 4 <= count; i += 4) {
+        __m256d x = _mm256_loadu_pd(p + i);
+        vmin = _mm256_min_pd(x, vmin);
+        vmax = _mm256_max_pd(x, vmax);
+    }
+
+    double mins[4];
+    double maxs[4];
+    double lo = HUGE_VAL;
+    double hi = -HUGE_VAL;
+    _mm256_storeu_pd(mins, vmin);
+    _mm256_storeu_pd(maxs, vmax);
+    for (int k = 0; k < 4; k++) {
+        lo = mins[k] < lo ? mins[k] : lo;
+        hi = maxs[k] > hi ? maxs[k] : hi;
+    }
+    for (; i < count; i++) {
+        lo = p[i] < lo ? p[i] : lo;
+        hi = p[i] > hi ? p[i] : hi;
+    }
+
+    if (min_index != NULL) {
+        size_t index = avx2_find_value_f64(p, count, lo);
+        *min_index = index < count ? index : 0;
+    }
+    if (max_index != NULL) {
+        size_t index = avx2_find_value_f64(p, count, hi);
+        *max_index = index < count ? index : 0;
+    }
+}
+
+/**
+ * @brief 将4个int64通道横向求和
+ */
+SIMD_TARGET_AVX2
+static inline int64_t avx2_hsum_i64(__m256i v)
+{
+    int64_t lanes[4];
+    _mm256_storeu_si256((__m256i*)lanes, v);
+    return (int64_t)((uint64_t)lanes[0] + (uint64_t)lanes[1] + (uint64_t)lanes[2] + (uint64_t)lanes[3]);
+}
+
+/**
+ * @brief 将4个double通道横向求和
+ */
+SIMD_TARGET_AVX2
+static inline double avx2_hsum_f64(__m256d v)
+{
+    double lanes[4];
+    _mm256_storeu_pd(lanes, v);
+    return (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]);
+}
+
+/**
+ * @brief 将int32向量符号扩展为两个int64向量后累加
+ */
+SIMD_TARGET_AVX2
+static inline __m256i avx2_add_widen_i32(__m256i acc, __m256i v)
+{
+    acc = _mm256_add_epi64(acc, _mm256_cvtepi32_epi64(_mm256_castsi256_si128(v)));
+    return _mm256_add_epi64(acc, _mm256_cvtepi32_epi64(_mm256_extracti128_si256(v, 1)));
+}
+
+/**
+ * @brief AVX2 int16求和
+ *
+ * pmaddwd与全1相乘得到相邻两元素之和，在int32中累加一批后再扩展到int64。
+ */
+SIMD_TARGET_AVX2
+static int64_t avx2_sum_i16(const int16_t* p, size_t count)
+{
+    const __m256i ones = _mm256_set1_epi16(1);
+    __m256i total = _mm256_setzero_si256();
+    size_t i = 0;
+
+    while (i + 16 <= count) {
+        __m256i acc = _mm256_setzero_si256();
+        for (int round = 0; round < 16384 && i + 16 <= count; round++, i += 16) {
+            acc = _mm256_add_epi32(acc, _mm256_madd_epi16(_mm256_loadu_si256((const __m256i*)(p + i)), ones));
+        }
+        total = avx2_add_widen_i32(total, acc);
+    }
+
+    int64_t sum = avx2_hsum_i64(total);
+    for (; i < count; i++) {
+        sum += p[i];
+    }
+    return sum;
+}
+
+/**
+ * @brief AVX2 int32求和
+ */
+SIMD_TARGET_AVX2
+static int64_t avx2_sum_i32(const int32_t* p, size_t count)
+{
+    __m256i total = _mm256_setzero_si256();
+    size_t i = 0;
+
+    for (; i + 8 <= count; i += 8) {
+        total = avx2_add_widen_i32(total, _mm256_loadu_si256((const __m256i*)(p + i)));
+    }
+
+    uint64_t sum = (uint64_t)avx2_hsum_i64(total);
+    for (; i < count; i++) {
+        sum += (uint64_t)(int64_t)p[i];
+    }
+    return (int64_t)sum;
+}
+
+/**
+ * @brief 向量Kahan求和的一步
+ */
+#define AVX2_KAHAN_STEP(sum, comp, x)                   \
+    do {                                                \
+        __m256d y_ = _mm256_sub_pd((x), (comp));        \
+        __m256d t_ = _mm256_add_pd((sum), y_);          \
+        (comp) = _mm256_sub_pd(_mm256_sub_pd(t_, (sum)), y_); \
+        (sum) = t_;                                     \
+    } while (0)
+
+/**
+ * @brief 合并向量Kahan累加器
+ */
+SIMD_TARGET_AVX2
+static void avx2_kahan_merge(kahan_t* k, __m256d sum, __m256d comp)
+{
+    double sums[4];
+    double comps[4];
+    _mm256_storeu_pd(sums, sum);
+    _mm256_storeu_pd(comps, comp);
+    for (int lane = 0; lane < 4; lane++) {
+        kahan_add(k, sums[lane]);
+        kahan_add(k, -comps[lane]);
+    }
+}
+
+/**
+ * @brief AVX2 float补偿求和，每个元素先转换为double
+ */
+SIMD_TARGET_AVX2
+static double avx2_sum_f32(const float* p, size_t count)
+{
+    __m256d s0 = _mm256_setzero_pd(), c0 = _mm256_setzero_pd();
+    __m256d s1 = _mm256_setzero_pd(), c1 = _mm256_setzero_pd();
+    size_t i = 0;
+
+    for (; i + 8 <= count; i += 8) {
+        __m256d x0 = _mm256_cvtps_pd(_mm_loadu_ps(p + i));
+        __m256d x1 = _mm256_cvtps_pd(_mm_loadu_ps(p + i + 4));
+        AVX2_KAHAN_STEP(s0, c0, x0);
+        AVX2_KAHAN_STEP(s1, c1, x1);
+    }
+
+    kahan_t k = {0.0, 0.0};
+    avx2_kahan_merge(&k, s0, c0);
+    avx2_kahan_merge(&k, s1, c1);
+    for (; i < count; i++) {
+        kahan_add(&k, p[i]);
+    }
+    return k.sum + k.comp;
+}
+
+/**
+ * @brief AVX2 double补偿求和
+ */
+SIMD_TARGET_AVX2
+static double avx2_sum_f64(const double* p, size_t count)
+{
+    __m256d s0 = _mm256_setzero_pd(), c0 = _mm256_setzero_pd();
+    __m256d s1 = _mm256_setzero_pd(), c1 = _mm256_setzero_pd();
+    size_t i = 0;
+
+    for (; i + 8 <= count; i += 8) {
+        AVX2_KAHAN_STEP(s0, c0, _mm256_loadu_pd(p + i));
+        AVX2_KAHAN_STEP(s1, c1, _mm256_loadu_pd(p + i + 4));
+    }
+
+    kahan_t k = {0.0, 0.0};
+    avx2_kahan_merge(&k, s0, c0);
+    avx2_kahan_merge(&k, s1, c1);
+    for (; i < count; i++) {
+        kahan_add(&k, p[i]);
+    }
+    return k.sum + k.comp;
+}
+
+#undef AVX2_KAHAN_STEP
+
+/**
+ * @brief AVX2 int16平方和
+ *
+ * pmaddwd(x, x)的结果最大为2^31，按无符号数零扩展后累加。
+ */
+SIMD_TARGET_AVX2
+static double avx2_sum_squares_i16(const int16_t* p, size_t count)
+{
+    __m256i total = _mm256_setzero_si256();
+    size_t i = 0;
+
+    for (; i + 16 <= count; i += 16) {
+        __m256i x = _mm256_loadu_si256((const __m256i*)(p + i));
+        __m256i squares = _mm256_madd_epi16(x, x);
+        total = _mm256_add_epi64(total, _mm256_cvtepu32_epi64(_mm256_castsi256_si128(squares)));
+        total = _mm256_add_epi64(total, _mm256_cvtepu32_epi64(_mm256_extracti128_si256(squares, 1)));
+    }
+
+    uint64_t sum = (uint64_t)avx2_hsum_i64(total);
+    for (; i < count; i++) {
+        sum += (uint64_t)((int32_t)p[i] * p[i]);
+    }
+    return (double)sum;
+}
+
+/**
+ * @brief AVX2 int32平方和
+ */
+SIMD_TARGET_AVX2
+static double avx2_sum_squares_i32(const int32_t* p, size_t count)
+{
+    __m256d s0 = _mm256_setzero_pd();
+    __m256d s1 = _mm256_setzero_pd();
+    size_t i = 0;
+
+    for (; i + 8 <= count; i += 8) {
+        __m256d x0 = _mm256_cvtepi32_pd(_mm_loadu_si128((const __m128i*)(p + i)));
+        __m256d x1 = _mm256_cvtepi32_pd(_mm_loadu_si128((const __m128i*)(p + i + 4)));
+        s0 = _mm256_add_pd(s0, _mm256_mul_pd(x0, x0));
+        s1 = _mm256_add_pd(s1, _mm256_mul_pd(x1, x1));
+    }
+
+    double sum = avx2_hsum_f64(_mm256_add_pd(s0, s1));
+    for (; i < count; i++) {
+        sum += (double)p[i] * p[i];
+    }
+    return sum;
+}
+
+/**
+ * @brief AVX2 float平方和，在double中累加
+ */
+SIMD_TARGET_AVX2
+static double avx2_sum_squares_f32(const float* p, size_t count)
+{
+    __m256d s0 = _mm256_setzero_pd();
+    __m256d s1 = _mm256_setzero_pd();
+    size_t i = 0;
+
+    for (; i + 8 <= count; i += 8) {
+        __m256d x0 = _mm256_cvtps_pd(_mm_loadu_ps(p + i));
+        __m256d x1 = _mm256_cvtps_pd(_mm_loadu_ps(p + i + 4));
+        s0 = _mm256_add_pd(s0, _mm256_mul_pd(x0, x0));
+        s1 = _mm256_add_pd(s1, _mm256_mul_pd(x1, x1));
+    }
+
+    double sum = avx2_hsum_f64(_mm256_add_pd(s0, s1));
+    for (; i < count; i++) {
+        sum += (double)p[i] * p[i];
+    }
+    return sum;
+}
+
+/**
+ * @brief AVX2 double平方和
+ */
+SIMD_TARGET_AVX2
+static double avx2_sum_squares_f64(const double* p, size_t count)
+{
+    __m256d s0 = _mm256_setzero_pd();
+    __m256d s1 = _mm256_setzero_pd();
+    size_t i = 0;
+
+    for (; i + 8 <= count; i += 8) {
+        __m256d x0 = _mm256_loadu_pd(p + i);
+        __m256d x1 = _mm256_loadu_pd(p + i + 4);
+        s0 = _mm256_add_pd(s0, _mm256_mul_pd(x0, x0));
+        s1 = _mm256_add_pd(s1, _mm256_mul_pd(x1, x1));
+    }
+
+    double sum = avx2_hsum_f64(_mm256_add_pd(s0, s1));
+    for (; i < count; i++) {
+        sum += p[i] * p[i];
+    }
+    return sum;
+}
+
+/**
+ * @brief AVX2 int16点积
+ *
+ * pmaddwd只有在两对乘积都是(-32768)*(-32768)时结果2^31会溢出为INT32_MIN，
+ * 扩展到int64后把这个值修正回+2^31。
+ */
+SIMD_TARGET_AVX2
+static int64_t avx2_dot_i16(const int16_t* a, const int16_t* b, size_t count)
+{
+    const __m256i overflow = _mm256_set1_epi64x(INT32_MIN);
+    const __m256i fix = _mm256_set1_epi64x((long long)1 << 32);
+    __m256i total = _mm256_setzero_si256();
+    size_t i = 0;
+
+    for (; i + 16 <= count; i += 16) {
+        __m256i products = _mm256_madd_epi16(_mm256_loadu_si256((const __m256i*)(a + i)),
+                                             _mm256_loadu_si256((const __m256i*)(b + i)));
+        __m256i lo = _mm256_cvtepi32_epi64(_mm256_castsi256_si128(products));
+        __m256i hi = _mm256_cvtepi32_epi64(_mm256_extracti128_si256(products, 1));
+        lo = _mm256_add_epi64(lo, _mm256_and_si256(_mm256_cmpeq_epi64(lo, overflow), fix));
+        hi = _mm256_add_epi64(hi, _mm256_and_si256(_mm256_cmpeq_epi64(hi, overflow), fix));
+        total = _mm256_add_epi64(total, _mm256_add_epi64(lo, hi));
+    }
+
+    int64_t sum = avx2_hsum_i64(total);
+    for (; i < count; i++) {
+        sum += (int32_t)a[i] * b[i];
+    }
+    return sum;
+}
+
+/**
+ * @brief AVX2 int32点积，pmuldq分别计算偶数和奇数通道的64位乘积
+ */
+SIMD_TARGET_AVX2
+static int64_t avx2_dot_i32(const int32_t* a, const int32_t* b, size_t count)
+{
+    __m256i total = _mm256_setzero_si256();
+    size_t i = 0;
+
+    for (; i + 8 <= count; i += 8) {
+        __m256i x = _mm256_loadu_si256((const __m256i*)(a + i));
+        __m256i y = _mm256_loadu_si256((const __m256i*)(b + i));
+        __m256i even = _mm256_mul_epi32(x, y);
+        __m256i odd = _mm256_mul_epi32(_mm256_srli_epi64(x, 32), _mm256_srli_epi64(y, 32));
+        total = _mm256_add_epi64(total, _mm256_add_epi64(even, odd));
+    }
+
+    uint64_t sum = (uint64_t)avx2_hsum_i64(total);
+    for (; i < count; i++) {
+        sum += (uint64_t)((int64_t)a[i] * b[i]);
+    }
+    return (int64_t)sum;
+}
+
+/**
+ * @brief AVX2 float点积，在double中累加
+ */
+SIMD_TARGET_AVX2
+static double avx2_dot_f32(const float* a, const float* b, size_t count)
+{
+    __m256d s0 = _mm256_setzero_pd();
+    __m256d s1 = _mm256_setzero_pd();
+    size_t i = 0;
+
+    for (; i + 8 <= count; i += 8) {
+        __m256d x0 = _mm256_cvtps_pd(_mm_loadu_ps(a + i));
+        __m256d x1 = _mm256_cvtps_pd(_mm_loadu_ps(a + i + 4));
+        __m256d y0 = _mm256_cvtps_pd(_mm_loadu_ps(b + i));
+        __m256d y1 = _mm256_cvtps_pd(_mm_loadu_ps(b + i + 4));
+        s0 = _mm256_add_pd(s0, _mm256_mul_pd(x0, y0));
+        s1 = _mm256_add_pd(s1, _mm256_mul_pd(x1, y1));
+    }
+
+    double sum = avx2_hsum_f64(_mm256_add_pd(s0, s1));
+    for (; i < count; i++) {
+        sum += (double)a[i] * b[i];
+    }
+    return sum;
+}
+
+/**
+ * @brief AVX2 double点积
+ */
+SIMD_TARGET_AVX2
+static double avx2_dot_f64(const double* a, const double* b, size_t count)
+{
+    __m256d s0 = _mm256_setzero_pd();
+    __m256d s1 = _mm256_setzero_pd();
+    size_t i = 0;
+
+    for (; i + 8 <= count; i += 8) {
+        s0 = _mm256_add_pd(s0, _mm256_mul_pd(_mm256_loadu_pd(a + i), _mm256_loadu_pd(b + i)));
+        s1 = _mm256_add_pd(s1, _mm256_mul_pd(_mm256_loadu_pd(a + i + 4), _mm256_loadu_pd(b + i + 4)));
+    }
+
+    double sum = avx2_hsum_f64(_mm256_add_pd(s0, s1));
+    for (; i < count; i++) {
+        sum += a[i] * b[i];
+    }
+    return sum;
+}
+
+#endif /* SIMD_X86 */
+
+/**
+ * @brief 当前是否可以使用AVX2数值内核
+ */
+static inline int simd_use_avx2(void)
+{
+#if SIMD_X86
+    return (simd_active_features() & SIMD_FEATURE_AVX2) != 0;
+#else
+    return 0;
+#endif
+}
+
+/**
+ * @brief 数值内核的公共分派宏
+ *
+ * 有AVX2时调用avx2_前缀的实现，否则执行给出的标量语句。
+ */
+#if SIMD_X86
+#define SIMD_DISPATCH_AVX2(call) \
+    do {                         \
+        if (simd_use_avx2()) {   \
+            return avx2_##call;  \
+        }                        \
+    } while (0)
+#else
+#define SIMD_DISPATCH_AVX2(call) do { } while (0)
+#endif
+
+/**
+ * @brief 查找int16数组中最小值和最大值第一次出现的下标
+ *
+ * @param data 数据首地址
+ * @param count 元素数量
+ * @param min_index 输出参数，最小值下标，可以为NULL
+ * @param max_index 输出参数，最大值下标，可以为NULL
+ * @return error_code_t 错误码，count为0时返回CSTL_ERROR_CONTAINER_EMPTY
+ */
+error_code_t simd_minmax_index_i16(const int16_t* data, size_t count, size_t* min_index, size_t* max_index)
+{
+    if (data == NULL) {
+        return CSTL_ERROR_NULL_POINTER;
+    }
+    if (count == 0) {
+        return CSTL_ERROR_CONTAINER_EMPTY;
+    }
+#if SIMD_X86
+    if (simd_use_avx2()) {
+        avx2_minmax_i16(data, count, min_index, max_index);
+        return CSTL_OK;
+    }
+#endif
+    scalar_minmax_i16(data, count, min_index, max_index);
+    return CSTL_OK;
+}
+
+/**
+ * @brief 查找int32数组中最小值和最大值第一次出现的下标
+ *
+ * @param data 数据首地址
+ * @param count 元素数量
+ * @param min_index 输出参数，最小值下标，可以为NULL
+ * @param max_index 输出参数，最大值下标，可以为NULL
+ * @return error_code_t 错误码，count为0时返回CSTL_ERROR_CONTAINER_EMPTY
+ */
+error_code_t simd_minmax_index_i32(const int32_t* data, size_t count, size_t* min_index, size_t* max_index)
+{
+    if (data == NULL) {
+        return CSTL_ERROR_NULL_POINTER;
+    }
+    if (count == 0) {
+        return CSTL_ERROR_CONTAINER_EMPTY;
+    }
+#if SIMD_X86
+    if (simd_use_avx2()) {
+        avx2_minmax_i32(data, count, min_index, max_index);
+        return CSTL_OK;
+    }
+#endif
+    scalar_minmax_i32(data, count, min_index, max_index);
+    return CSTL_OK;
+}
+
+/**
+ * @brief 查找float数组中最小值和最大值第一次出现的下标，跳过NaN
+ *
+ * @param data 数据首地址
+ * @param count 元素数量
+ * @param min_index 输出参数，最小值下标，可以为NULL
+ * @param max_index 输出参数，最大值下标，可以为NULL
+ * @return error_code_t 错误码，count为0时返回CSTL_ERROR_CONTAINER_EMPTY
+ */
+error_code_t simd_minmax_index_f32(const float* data, size_t count, size_t* min_index, size_t* max_index)
+{
+    if (data == NULL) {
+        return CSTL_ERROR_NULL_POINTER;
+    }
+    if (count == 0) {
+        return CSTL_ERROR_CONTAINER_EMPTY;
+    }
+#if SIMD_X86
+    if (simd_use_avx2()) {
+        avx2_minmax_f32(data, count, min_index, max_index);
+        return CSTL_OK;
+    }
+#endif
+    scalar_minmax_f32(data, count, min_index, max_index);
+    return CSTL_OK;
+}
+
+/**
+ * @brief 查找double数组中最小值和最大值第一次出现的下标，跳过NaN
+ *
+ * @param data 数据首地址
+ * @param count 元素数量
+ * @param min_index 输出参数，最小值下标，可以为NULL
+ * @param max_index 输出参数，最大值下标，可以为NULL
+ * @return error_code_t 错误码，count为0时返回CSTL_ERROR_CONTAINER_EMPTY
+ */
+error_code_t simd_minmax_index_f64(const double* data, size_t count, size_t* min_index, size_t* max_index)
+{
+    if (data == NULL) {
+        return CSTL_ERROR_NULL_POINTER;
+    }
+    if (count == 0) {
+        return CSTL_ERROR_CONTAINER_EMPTY;
+    }
+#if SIMD_X86
+    if (simd_use_avx2()) {
+        avx2_minmax_f64(data, count, min_index, max_index);
+        return CSTL_OK;
+    }
+#endif
+    scalar_minmax_f64(data, count, min_index, max_index);
+    return CSTL_OK;
+}
+
+/**
+ * @brief int16数组求和
+ *
+ * @param data 数据首地址
+ * @param count 元素数量
+ * @return int64_t 精确的和
+ */
+int64_t simd_sum_i16(const int16_t* data, size_t count)
+{
+    if (data == NULL) {
+        return 0;
+    }
+    SIMD_DISPATCH_AVX2(sum_i16(data, count));
+
+    int64_t sum = 0;
+    for (size_t i = 0; i < count; i++) {
+        sum += data[i];
+    }
+    return sum;
+}
+
+/**
+ * @brief int32数组求和
+ *
+ * @param data 数据首地址
+ * @param count 元素数量
+ * @return int64_t 和，超出int64范围时按补码回绕
+ */
+int64_t simd_sum_i32(const int32_t* data, size_t count)
+{
+    if (data == NULL) {
+        return 0;
+    }
+    SIMD_DISPATCH_AVX2(sum_i32(data, count));
+
+    uint64_t sum = 0;
+    for (size_t i = 0; i < count; i++) {
+        sum += (uint64_t)(int64_t)data[i];
+    }
+    return (int64_t)sum;
+}
+
+/**
+ * @brief float数组的Kahan补偿求和
+ *
+ * @param data 数据首地址
+ * @param count 元素数量
+ * @return double 和
+ */
+double simd_sum_f32(const float* data, size_t count)
+{
+    if (data == NULL) {
+        return 0.0;
+    }
+    SIMD_DISPATCH_AVX2(sum_f32(data, count));
+
+    kahan_t k = {0.0, 0.0};
+    for (size_t i = 0; i < count; i++) {
+        kahan_add(&k, data[i]);
+    }
+    return k.sum + k.comp;
+}
+
+/**
+ * @brief double数组的Kahan补偿求和
+ *
+ * @param data 数据首地址
+ * @param count 元素数量
+ * @return double 和
+ */
+double simd_sum_f64(const double* data, size_t count)
+{
+    if (data == NULL) {
+        return 0.0;
+    }
+    SIMD_DISPATCH_AVX2(sum_f64(data, count));
+
+    kahan_t k = {0.0, 0.0};
+    for (size_t i = 0; i < count; i++) {
+        kahan_add(&k, data[i]);
+    }
+    return k.sum + k.comp;
+}
+
+/**
+ * @brief int16数组的平方和
+ *
+ * @param data 数据首地址
+ * @param count 元素数量
+ * @return double 平方和
+ */
+double simd_sum_squares_i16(const int16_t* data, size_t count)
+{
+    if (data == NULL) {
+        return 0.0;
+    }
+    SIMD_DISPATCH_AVX2(sum_squares_i16(data, count));
+
+    uint64_t sum = 0;
+    for (size_t i = 0; i < count; i++) {
+        sum += (uint64_t)((int32_t)data[i] * data[i]);
+    }
+    return (double)sum;
+}
+
+/**
+ * @brief int32数组的平方和
+ *
+ * @param data 数据首地址
+ * @param count 元素数量
+ * @return double 平方和
+ */
+double simd_sum_squares_i32(const int32_t* data, size_t count)
+{
+    if (data == NULL) {
+        return 0.0;
+    }
+    SIMD_DISPATCH_AVX2(sum_squares_i32(data, count));
+
+    double sum = 0.0;
+    for (size_t i = 0; i < count; i++) {
+        sum += (double)data[i] * data[i];
+    }
+    return sum;
+}
+
+/**
+ * @brief float数组的平方和
+ *
+ * @param data 数据首地址
+ * @param count 元素数量
+ * @return double 平方和
+ */
+double simd_sum_squares_f32(const float* data, size_t count)
+{
+    if (data == NULL) {
+        return 0.0;
+    }
+    SIMD_DISPATCH_AVX2(sum_squares_f32(data, count));
+
+    double sum = 0.0;
+    for (size_t i = 0; i < count; i++) {
+        sum += (double)data[i] * data[i];
+    }
+    return sum;
+}
+
+/**
+ * @brief double数组的平方和
+ *
+ * @param data 数据首地址
+ * @param count 元素数量
+ * @return double 平方和
+ */
+double simd_sum_squares_f64(const double* data, size_t count)
+{
+    if (data == NULL) {
+        return 0.0;
+    }
+    SIMD_DISPATCH_AVX2(sum_squares_f64(data, count));
+
+    double sum = 0.0;
+    for (size_t i = 0; i < count; i++) {
+        sum += data[i] * data[i];
+    }
+    return sum;
+}
+
+/**
+ * @brief int16数组的均方根
+ *
+ * @param data 数据首地址
+ * @param count 元素数量
+ * @return double 均方根，count为0时返回0
+ */
+double simd_rms_i16(const int16_t* data, size_t count)
+{
+    return count > 0 ? sqrt(simd_sum_squares_i16(data, count) / (double)count) : 0.0;
+}
+
+/**
+ * @brief int32数组的均方根
+ *
+ * @param data 数据首地址
+ * @param count 元素数量
+ * @return double 均方根，count为0时返回0
+ */
+double simd_rms_i32(const int32_t* data, size_t count)
+{
+    return count > 0 ? sqrt(simd_sum_squares_i32(data, count) / (double)count) : 0.0;
+}
+
+/**
+ * @brief float数组的均方根
+ *
+ * @param data 数据首地址
+ * @param count 元素数量
+ * @return double 均方根，count为0时返回0
+ */
+double simd_rms_f32(const float* data, size_t count)
+{
+    return count > 0 ? sqrt(simd_sum_squares_f32(data, count) / (double)count) : 0.0;
+}
+
+/**
+ * @brief double数组的均方根
+ *
+ * @param data 数据首地址
+ * @param count 元素数量
+ * @return double 均方根，count为0时返回0
+ */
+double simd_rms_f64(const double* data, size_t count)
+{
+    return count > 0 ? sqrt(simd_sum_squares_f64(data, count) / (double)count) : 0.0;
+}
+
+/**
+ * @brief int16数组点积
+ *
+ * @param a 第一个数组首地址
+ * @param b 第二个数组首地址
+ * @param count 元素数量
+ * @return int64_t 精确的点积
+ */
+int64_t simd_dot_i16(const int16_t* a, const int16_t* b, size_t count)
+{
+    if (a == NULL || b == NULL) {
+        return 0;
+    }
+    SIMD_DISPATCH_AVX2(dot_i16(a, b, count));
+
+    int64_t sum = 0;
+    for (size_t i = 0; i < count; i++) {
+        sum += (int32_t)a[i] * b[i];
+    }
+    return sum;
+}
+
+/**
+ * @brief int32数组点积
+ *
+ * @param a 第一个数组首地址
+ * @param b 第二个数组首地址
+ * @param count 元素数量
+ * @return int64_t 点积，超出int64范围时按补码回绕
+ */
+int64_t simd_dot_i32(const int32_t* a, const int32_t* b, size_t count)
+{
+    if (a == NULL || b == NULL) {
+        return 0;
+    }
+    SIMD_DISPATCH_AVX2(dot_i32(a, b, count));
+
+    uint64_t sum = 0;
+    for (size_t i = 0; i < count; i++) {
+        sum += (uint64_t)((int64_t)a[i] * b[i]);
+    }
+    return (int64_t)sum;
+}
+
+/**
+ * @brief float数组点积，在double中累加
+ *
+ * @param a 第一个数组首地址
+ * @param b 第二个数组首地址
+ * @param count 元素数量
+ * @return double 点积
+ */
+double simd_dot_f32(const float* a, const float* b, size_t count)
+{
+    if (a == NULL || b == NULL) {
+        return 0.0;
+    }
+    SIMD_DISPATCH_AVX2(dot_f32(a, b, count));
+
+    double sum = 0.0;
+    for (size_t i = 0; i < count; i++) {
+        sum += (double)a[i] * b[i];
+    }
+    return sum;
+}
+
+/**
+ * @brief double数组点积
+ *
+ * @param a 第一个数组首地址
+ * @param b 第二个数组首地址
+ * @param count 元素数量
+ * @return double 点积
+ */
+double simd_dot_f64(const double* a, const double* b, size_t count)
+{
+    if (a == NULL || b == NULL) {
+        return 0.0;
+    }
+    SIMD_DISPATCH_AVX2(dot_f64(a, b, count));
+
+    double sum = 0.0;
+    for (size_t i = 0; i < count; i++) {
+        sum += a[i] * b[i];
+    }
+    return sum;
+}
+
+
+/*
+ * 小数组排序网络
+ *
+ * 元素复制到补齐为2的幂的缓冲区中（空位填最大值），执行双调排序网络：
+ * 第k轮把长度为k的段排成交替升降的双调序列，第j步比较相距j的元素。
+ * 比较交换的方向只取决于下标，因此没有依赖数据的分支。
+ * AVX2实现中相距至少一个寄存器宽度的比较直接对两个寄存器取min/max，
+ * 寄存器内的比较先置换出配对元素，再按下标掩码选择min或max。
+ * 元素少于SIMD_SORT_NETWORK_MIN或没有AVX2时使用插入排序。
+ */
+
+/**
+ * @brief 不小于count的最小2的幂，至少为minimum
+ *
+ * @param count 元素数量
+ * @param minimum 最小值，必须是2的幂
+ * @return size_t 补齐后的长度
+ */
+static inline size_t simd_sort_padded(size_t count, size_t minimum)
+{
+    size_t n = minimum;
+    while (n < count) {
+        n <<= 1;
+    }
+    return n;
+}
+
+/**
+ * @brief int16插入排序，用于元素很少或没有AVX2的情况
+ *
+ * @param x 数据
+ * @param count 元素数量
+ */
+static void scalar_insertion_i16(int16_t* x, size_t count)
+{
+    for (size_t i = 1; i < count; i++) {
+        int16_t key = x[i];
+        size_t j = i;
+        while (j > 0 && x[j - 1] > key) {
+            x[j] = x[j - 1];
+            j--;
+        }
+        x[j] = key;
+    }
+}
+
+/**
+ * @brief int32插入排序，用于元素很少或没有AVX2的情况
+ *
+ * @param x 数据
+ * @param count 元素数量
+ */
+static void scalar_insertion_i32(int32_t* x, size_t count)
+{
+    for (size_t i = 1; i < count; i++) {
+        int32_t key = x[i];
+        size_t j = i;
+        while (j > 0 && x[j - 1] > key) {
+            x[j] = x[j - 1];
+            j--;
+        }
+        x[j] = key;
+    }
+}
+
+/**
+ * @brief int64插入排序，用于元素很少或没有AVX2的情况
+ *
+ * @param x 数据
+ * @param count 元素数量
+ */
+static void scalar_insertion_i64(int64_t* x, size_t count)
+{
+    for (size_t i = 1; i < count; i++) {
+        int64_t key = x[i];
+        size_t j = i;
+        while (j > 0 && x[j - 1] > key) {
+            x[j] = x[j - 1];
+            j--;
+        }
+        x[j] = key;
+    }
+}
+
+#if SIMD_X86
+/**
+ * @brief AVX2 int32双调排序网络
+ *
+ * @param x 数据，长度为n
+ * @param n 8、16或32
+ */
+SIMD_TARGET_AVX2
+static void avx2_bitonic_i32(int32_t* x, size_t n)
+{
+    __m256i v[SIMD_SORT_SMALL_MAX / 8];
+    size_t regs = n / 8;
+    const __m256i lane = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+
+    for (size_t r = 0; r < regs; r++) {
+        v[r] = _mm256_loadu_si256((const __m256i*)(x + r * 8));
+    }
+
+    for (size_t k = 2; k <= n; k <<= 1) {
+        for (size_t j = k >> 1; j > 0; j >>= 1) {
+            if (j >= 8) {
+                size_t rj = j / 8;
+                for (size_t r = 0; r < regs; r++) {
+                    if (r & rj) {
+                        continue;
+                    }
+                    size_t p = r | rj;
+                    __m256i lo = _mm256_min_epi32(v[r], v[p]);
+                    __m256i hi = _mm256_max_epi32(v[r], v[p]);
+                    int descending = ((r * 8) & k) != 0;
+                    v[r] = descending ? hi : lo;
+                    v[p] = descending ? lo : hi;
+                }
+                continue;
+            }
+
+            const __m256i vj = _mm256_set1_epi32((int)j);
+            const __m256i vk = _mm256_set1_epi32((int)k);
+            const __m256i perm = _mm256_xor_si256(lane, vj);
+            for (size_t r = 0; r < regs; r++) {
+                __m256i partner = _mm256_permutevar8x32_epi32(v[r], perm);
+                __m256i lo = _mm256_min_epi32(v[r], partner);
+                __m256i hi = _mm256_max_epi32(v[r], partner);
+                __m256i index = _mm256_add_epi32(lane, _mm256_set1_epi32((int)(r * 8)));
+                __m256i upper = _mm256_cmpeq_epi32(_mm256_and_si256(index, vj), vj);
+                __m256i descending = _mm256_cmpeq_epi32(_mm256_and_si256(index, vk), vk);
+                v[r] = _mm256_blendv_epi8(lo, hi, _mm256_xor_si256(upper, descending));
+            }
+        }
+    }
+
+    for (size_t r = 0; r < regs; r++) {
+        _mm256_storeu_si256((__m256i*)(x + r * 8), v[r]);
+    }
+}
+
+/**
+ * @brief AVX2 int64双调排序网络
+ *
+ * @param x 数据，长度为n
+ * @param n 4、8、16或32
+ */
+SIMD_TARGET_AVX2
+static void avx2_bitonic_i64(int64_t* x, size_t n)
+{
+    __m256i v[SIMD_SORT_SMALL_MAX / 4];
+    size_t regs = n / 4;
+    const __m256i lane = _mm256_setr_epi64x(0, 1, 2, 3);
+
+    for (size_t r = 0; r < regs; r++) {
+        v[r] = _mm256_loadu_si256((const __m256i*)(x + r * 4));
+    }
+
+    for (size_t k = 2; k <= n; k <<= 1) {
+        for (size_t j = k >> 1; j > 0; j >>= 1) {
+            if (j >= 4) {
+                size_t rj = j / 4;
+                for (size_t r = 0; r < regs; r++) {
+                    if (r & rj) {
+                        continue;
+                    }
+                    size_t p = r | rj;
+                    __m256i gt = _mm256_cmpgt_epi64(v[r], v[p]);
+                    __m256i lo = _mm256_blendv_epi8(v[r], v[p], gt);
+                    __m256i hi = _mm256_blendv_epi8(v[p], v[r], gt);
+                    int descending = ((r * 4) & k) != 0;
+                    v[r] = descending ? hi : lo;
+                    v[p] = descending ? lo : hi;
+                }
+                continue;
+            }
+
+            const __m256i vj = _mm256_set1_epi64x((long long)j);
+            const __m256i vk = _mm256_set1_epi64x((long long)k);
+            for (size_t r = 0; r < regs; r++) {
+                __m256i partner = j == 1 ? _mm256_permute4x64_epi64(v[r], 0xB1)
+                                         : _mm256_permute4x64_epi64(v[r], 0x4E);
+                __m256i gt = _mm256_cmpgt_epi64(v[r], partner);
+                __m256i lo = _mm256_blendv_epi8(v[r], partner, gt);
+                __m256i hi = _mm256_blendv_epi8(partner, v[r], gt);
+                __m256i index = _mm256_add_epi64(lane, _mm256_set1_epi64x((long long)(r * 4)));
+                __m256i upper = _mm256_cmpeq_epi64(_mm256_and_si256(index, vj), vj);
+                __m256i descending = _mm256_cmpeq_epi64(_mm256_and_si256(index, vk), vk);
+                v[r] = _mm256_blendv_epi8(lo, hi, _mm256_xor_si256(upper, descending));
+            }
+        }
+    }
+
+    for (size_t r = 0; r < regs; r++) {
+        _mm256_storeu_si256((__m256i*)(x + r * 4), v[r]);
+    }
+}
+#endif
+
+/**
+ * @brief 是否对count个元素使用排序网络
+ *
+ * @param count 元素数量
+ * @return int 使用返回1
+ */
+static inline int simd_sort_use_network(size_t count)
+{
+#if SIMD_X86
+    return count >= SIMD_SORT_NETWORK_MIN && simd_use_avx2();
+#else
+    (void)count;
+    return 0;
+#endif
+}
+
+#if SIMD_X86
+/**
+ * @brief 用排序网络原地排序int32
+ *
+ * 元素数量恰好是2的幂时直接在原数组上排序，否则复制到补齐的缓冲区中。
+ * 缓冲区用逐元素循环复制：长度有上限的memcpy会被内联为rep movs，小数组上开销很大。
+ *
+ * @param data 数据，不少于SIMD_SORT_NETWORK_MIN个元素
+ * @param count 元素数量
+ */
+static void simd_sort_network_i32(int32_t* data, size_t count)
+{
+    size_t n = simd_sort_padded(count, 8);
+    if (n == count) {
+        avx2_bitonic_i32(data, n);
+        return;
+    }
+
+    int32_t buffer[SIMD_SORT_SMALL_MAX];
+    for (size_t i = 0; i < count; i++) {
+        buffer[i] = data[i];
+    }
+    for (size_t i = count; i < n; i++) {
+        buffer[i] = INT32_MAX;
+    }
+    avx2_bitonic_i32(buffer, n);
+    for (size_t i = 0; i < count; i++) {
+        data[i] = buffer[i];
+    }
+}
+
+/**
+ * @brief 用排序网络原地排序int64
+ *
+ * @param data 数据，不少于SIMD_SORT_NETWORK_MIN个元素
+ * @param count 元素数量
+ */
+static void simd_sort_network_i64(int64_t* data, size_t count)
+{
+    size_t n = simd_sort_padded(count, 4);
+    if (n == count) {
+        avx2_bitonic_i64(data, n);
+        return;
+    }
+
+    int64_t buffer[SIMD_SORT_SMALL_MAX];
+    for (size_t i = 0; i < count; i++) {
+        buffer[i] = data[i];
+    }
+    for (size_t i = count; i < n; i++) {
+        buffer[i] = INT64_MAX;
+    }
+    avx2_bitonic_i64(buffer, n);
+    for (size_t i = 0; i < count; i++) {
+        data[i] = buffer[i];
+    }
+}
+#endif
+
+/**
+ * @brief 原地排序int32，有AVX2且元素足够多时使用排序网络
+ *
+ * @param data 数据
+ * @param count 元素数量
+ */
+static void simd_sort_dispatch_i32(int32_t* data, size_t count)
+{
+#if SIMD_X86
+    if (simd_sort_use_network(count)) {
+        simd_sort_network_i32(data, count);
+        return;
+    }
+#endif
+    scalar_insertion_i32(data, count);
+}
+
+/**
+ * @brief 原地排序int64，有AVX2且元素足够多时使用排序网络
+ *
+ * @param data 数据
+ * @param count 元素数量
+ */
+static void simd_sort_dispatch_i64(int64_t* data, size_t count)
+{
+#if SIMD_X86
+    if (simd_sort_use_network(count)) {
+        simd_sort_network_i64(data, count);
+        return;
+    }
+#endif
+    scalar_insertion_i64(data, count);
+}
+
+/**
+ * @brief 检查小数组排序的参数
+ *
+ * @param data 数据首地址
+ * @param count 元素数量
+ * @return error_code_t 错误码
+ */
+static inline error_code_t simd_sort_small_check(const void* data, size_t count)
+{
+    if (data == NULL) {
+        return CSTL_ERROR_NULL_POINTER;
+    }
+    if (count > SIMD_SORT_SMALL_MAX) {
+        return CSTL_ERROR_INVALID_ARGUMENT;
+    }
+    return CSTL_OK;
+}
+
+/**
+ * @brief 对int16小数组排序
+ *
+ * @param data 数据首地址
+ * @param count 元素数量
+ * @return error_code_t 错误码
+ */
+error_code_t simd_sort_small_i16(int16_t* data, size_t count)
+{
+    error_code_t err = simd_sort_small_check(data, count);
+    if (err != CSTL_OK || count < 2) {
+        return err;
+    }
+    if (!simd_sort_use_network(count)) {
+        scalar_insertion_i16(data, count);
+        return CSTL_OK;
+    }
+
+    int32_t buffer[SIMD_SORT_SMALL_MAX];
+    for (size_t i = 0; i < count; i++) {
+        buffer[i] = data[i];
+    }
+    simd_sort_dispatch_i32(buffer, count);
+    for (size_t i = 0; i < count; i++) {
+        data[i] = (int16_t)buffer[i];
+    }
+    return CSTL_OK;
+}
+
+/**
+ * @brief 对int32小数组排序
+ *
+ * @param data 数据首地址
+ * @param count 元素数量
+ * @return error_code_t 错误码
+ */
+error_code_t simd_sort_small_i32(int32_t* data, size_t count)
+{
+    error_code_t err = simd_sort_small_check(data, count);
+    if (err != CSTL_OK || count < 2) {
+        return err;
+    }
+    simd_sort_dispatch_i32(data, count);
+    return CSTL_OK;
+}
+
+/**
+ * @brief 对int64小数组排序
+ *
+ * @param data 数据首地址
+ * @param count 元素数量
+ * @return error_code_t 错误码
+ */
+error_code_t simd_sort_small_i64(int64_t* data, size_t count)
+{
+    error_code_t err = simd_sort_small_check(data, count);
+    if (err != CSTL_OK || count < 2) {
+        return err;
+    }
+    simd_sort_dispatch_i64(data, count);
+    return CSTL_OK;
+}
+
+/**
+ * @brief 对float小数组排序
+ *
+ * 位模式原地变换为按有符号整数比较即为全序的形式：负数翻转除符号位外的所有位。
+ * 该变换是自逆的，排序后再做一次即可还原。
+ *
+ * @param data 数据首地址
+ * @param count 元素数量
+ * @return error_code_t 错误码
+ */
+error_code_t simd_sort_small_f32(float* data, size_t count)
+{
+    error_code_t err = simd_sort_small_check(data, count);
+    if (err != CSTL_OK || count < 2) {
+        return err;
+    }
+
+    int32_t* bits = (int32_t*)(void*)data;
+    for (size_t i = 0; i < count; i++) {
+        bits[i] ^= (int32_t)((uint32_t)(bits[i] >> 31) >> 1);
+    }
+    simd_sort_dispatch_i32(bits, count);
+    for (size_t i = 0; i < count; i++) {
+        bits[i] ^= (int32_t)((uint32_t)(bits[i] >> 31) >> 1);
+    }
+    return CSTL_OK;
+}
+
+/**
+ * @brief 对double小数组排序
+ *
+ * 变换方式与simd_sort_small_f32相同。
+ *
+ * @param data 数据首地址
+ * @param count 元素数量
+ * @return error_code_t 错误码
+ */
+error_code_t simd_sort_small_f64(double* data, size_t count)
+{
+    error_code_t err = simd_sort_small_check(data, count);
+    if (err != CSTL_OK || count < 2) {
+        return err;
+    }
+
+    int64_t* bits = (int64_t*)(void*)data;
+    for (size_t i = 0; i < count; i++) {
+        bits[i] ^= (int64_t)((uint64_t)(bits[i] >> 63) >> 1);
+    }
+    simd_sort_dispatch_i64(bits, count);
+    for (size_t i = 0; i < count; i++) {
+        bits[i] ^= (int64_t)((uint64_t)(bits[i] >> 63) >> 1);
+    }
+    return CSTL_OK;
+}
+
+#undef SIMD_DISPATCH_AVX2
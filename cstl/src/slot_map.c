@@ -0,0 +1,557 @@
+/**
+ * @file slot_map.c
+ * @brief CSTL库的槽位映射容器实现
+ *
+ * 该文件实现了CSTL库的槽位映射容器。values和dense_slots一一对应，紧凑存放元素和元素所在的槽位；
+ * slots按槽位下标记录元素在紧凑数组中的位置和槽位的代数。
+ */
+
+#include "cstl/slot_map.h"
+#include <stdlib.h>
+#include <string.h>
+
+/**
+ * @brief 获取槽位数组
+ *
+ * @param map 槽位映射容器指针
+ * @return slot_map_slot_t* 槽位数组
+ */
+static slot_map_slot_t* slot_map_slots(const slot_map_t* map)
+{
+    return (slot_map_slot_t*)map->slots->data;
+}
+
+/**
+ * @brief 获取元素对应的槽位下标数组
+ *
+ * @param map 槽位映射容器指针
+ * @return uint32_t* 槽位下标数组
+ */
+static uint32_t* slot_map_dense_slots(const slot_map_t* map)
+{
+    return (uint32_t*)map->dense_slots->data;
+}
+
+/**
+ * @brief 获取紧凑数组中指定位置的元素
+ *
+ * @param map 槽位映射容器指针
+ * @param index 元素位置
+ * @return unsigned char* 元素指针
+ */
+static unsigned char* slot_map_value(const slot_map_t* map, size_t index)
+{
+    return (unsigned char*)map->values->data + index * map->element_size;
+}
+
+/**
+ * @brief 由槽位下标和代数组成句柄
+ *
+ * @param slot 槽位下标
+ * @param generation 槽位的代数
+ * @return slot_handle_t 句柄
+ */
+static slot_handle_t slot_map_make_handle(uint32_t slot, uint32_t generation)
+{
+    return ((slot_handle_t)generation << 32) | slot;
+}
+
+/**
+ * @brief 锁定槽位映射容器（如果启用线程安全）
+ *
+ * @param map 槽位映射容器指针
+ */
+static void slot_map_lock(slot_map_t* map)
+{
+    if (map != NULL && map->thread_safe) {
+        mutex_lock(&map->lock);
+    }
+}
+
+/**
+ * @brief 解锁槽位映射容器（如果启用线程安全）
+ *
+ * @param map 槽位映射容器指针
+ */
+static void slot_map_unlock(slot_map_t* map)
+{
+    if (map != NULL && map->thread_safe) {
+        mutex_unlock(&map->lock);
+    }
+}
+
+/**
+ * @brief 查找句柄对应的槽位
+ *
+ * @param map 槽位映射容器指针
+ * @param handle 元素句柄
+ * @return slot_map_slot_t* 槽位指针，句柄失效时返回NULL
+ */
+static slot_map_slot_t* slot_map_resolve(const slot_map_t* map, slot_handle_t handle)
+{
+    uint32_t index = (uint32_t)handle;
+    uint32_t generation = (uint32_t)(handle >> 32);
+
+    if (generation == 0 || index >= map->slots->size) {
+        return NULL;
+    }
+
+    slot_map_slot_t* slot = &slot_map_slots(map)[index];
+    return slot->generation == generation ? slot : NULL;
+}
+
+/**
+ * @brief 释放槽位：代数加1，放到空闲链表末尾；代数用尽时不再复用该槽位
+ *
+ * @param map 槽位映射容器指针
+ * @param index 槽位下标
+ */
+static void slot_map_release_slot(slot_map_t* map, uint32_t index)
+{
+    slot_map_slot_t* slots = slot_map_slots(map);
+
+    slots[index].generation++;
+    if (slots[index].generation == 0) {
+        return;
+    }
+
+    slots[index].index = SLOT_MAP_NIL;
+    if (map->free_tail != SLOT_MAP_NIL) {
+        slots[map->free_tail].index = index;
+    } else {
+        map->free_head = index;
+    }
+    map->free_tail = index;
+}
+
+/**
+ * @brief 创建槽位映射容器
+ *
+ * @param element_size 元素大小
+ * @param allocator 分配器指针，如果为NULL则使用默认分配器
+ * @param destructor 析构函数指针，删除元素时对元素调用，为NULL时不调用
+ * @return slot_map_t* 槽位映射容器指针，失败返回NULL
+ */
+slot_map_t* slot_map_create(size_t element_size, allocator_t* allocator, destructor_fn_t destructor)
+{
+    if (element_size == 0) {
+        return NULL;
+    }
+
+    slot_map_t* map = (slot_map_t*)malloc(sizeof(slot_map_t));
+    if (map == NULL) {
+        return NULL;
+    }
+
+    /* 元素的析构由槽位映射自己调用，向量不设置析构函数 */
+    map->values = vector_create(element_size, 0, allocator, NULL);
+    map->dense_slots = vector_create(sizeof(uint32_t), 0, allocator, NULL);
+    map->slots = vector_create(sizeof(slot_map_slot_t), 0, allocator, NULL);
+    if (map->values == NULL || map->dense_slots == NULL || map->slots == NULL) {
+        vector_destroy(map->values);
+        vector_destroy(map->dense_slots);
+        vector_destroy(map->slots);
+        free(map);
+        return NULL;
+    }
+
+    map->free_head = SLOT_MAP_NIL;
+    map->free_tail = SLOT_MAP_NIL;
+    map->element_size = element_size;
+    map->thread_safe = 0;
+    map->destructor = destructor;
+
+    return map;
+}
+
+/**
+ * @brief 销毁槽位映射容器
+ *
+ * @param map 槽位映射容器指针
+ */
+void slot_map_destroy(slot_map_t* map)
+{
+    if (map == NULL) {
+        return;
+    }
+
+    slot_map_clear(map);
+
+    vector_destroy(map->values);
+    vector_destroy(map->dense_slots);
+    vector_destroy(map->slots);
+
+    /* 销毁互斥锁 */
+    if (map->thread_safe) {
+        mutex_destroy(&map->lock);
+    }
+
+    free(map);
+}
+
+/**
+ * @brief 清空槽位映射容器
+ *
+ * @param map 槽位映射容器指针
+ */
+void slot_map_clear(slot_map_t* map)
+{
+    if (map == NULL) {
+        return;
+    }
+
+    slot_map_lock(map);
+
+    const uint32_t* dense_slots = slot_map_dense_slots(map);
+    size_t size = map->values->size;
+
+    for (size_t i = 0; i < size; i++) {
+        if (map->destructor != NULL) {
+            map->destructor(slot_map_value(map, i));
+        }
+        slot_map_release_slot(map, dense_slots[i]);
+    }
+
+    /* 保留容量，之后的插入不需要重新分配 */
+    map->values->size = 0;
+    map->dense_slots->size = 0;
+
+    slot_map_unlock(map);
+}
+
+/**
+ * @brief 获取槽位映射容器大小
+ *
+ * @param map 槽位映射容器指针
+ * @return size_t 元素数量
+ */
+size_t slot_map_size(const slot_map_t* map)
+{
+    if (map == NULL) {
+        return 0;
+    }
+
+    return map->values->size;
+}
+
+/**
+ * @brief 检查槽位映射容器是否为空
+ *
+ * @param map 槽位映射容器指针
+ * @return int 如果为空返回非零，否则返回零
+ */
+int slot_map_empty(const slot_map_t* map)
+{
+    if (map == NULL) {
+        return 1;
+    }
+
+    return map->values->size == 0;
+}
+
+/**
+ * @brief 预留容量
+ *
+ * @param map 槽位映射容器指针
+ * @param capacity 元素容量
+ * @return error_code_t 错误码
+ */
+error_code_t slot_map_reserve(slot_map_t* map, size_t capacity)
+{
+    if (map == NULL) {
+        return CSTL_ERROR_NULL_POINTER;
+    }
+
+    if (capacity >= SLOT_MAP_NIL) {
+        return CSTL_ERROR_INVALID_ARGUMENT;
+    }
+
+    slot_map_lock(map);
+
+    error_code_t result = CSTL_OK;
+    if (map->values->capacity < capacity) {
+        result = vector_reserve(map->values, capacity);
+    }
+    if (result == CSTL_OK && map->dense_slots->capacity < capacity) {
+        result = vector_reserve(map->dense_slots, capacity);
+    }
+    if (result == CSTL_OK && map->slots->capacity < capacity) {
+        result = vector_reserve(map->slots, capacity);
+    }
+
+    slot_map_unlock(map);
+    return result;
+}
+
+/**
+ * @brief 插入元素
+ *
+ * @param map 槽位映射容器指针
+ * @param element 要插入的元素指针
+ * @param handle 输出参数，存储新元素的句柄
+ * @return error_code_t 错误码，槽位数量超过32位时返回CSTL_ERROR_CONTAINER_FULL
+ */
+error_code_t slot_map_insert(slot_map_t* map, const void* element, slot_handle_t* handle)
+{
+    if (map == NULL || element == NULL || handle == NULL) {
+        return CSTL_ERROR_NULL_POINTER;
+    }
+
+    slot_map_lock(map);
+
+    /* 先扩充紧凑数组，失败时不需要回退槽位 */
+    error_code_t result = vector_push_back(map->values, element);
+    if (result != CSTL_OK) {
+        slot_map_unlock(map);
+        return result;
+    }
+
+    uint32_t index = map->free_head;
+    int new_slot = index == SLOT_MAP_NIL;
+    if (new_slot) {
+        slot_map_slot_t slot;
+        slot.index = SLOT_MAP_NIL;
+        slot.generation = 1;
+        index = (uint32_t)map->slots->size;
+        result = map->slots->size < SLOT_MAP_NIL ? vector_push_back(map->slots, &slot) : CSTL_ERROR_CONTAINER_FULL;
+        if (result != CSTL_OK) {
+            map->values->size--;
+            slot_map_unlock(map);
+            return result;
+        }
+    }
+
+    result = vector_push_back(map->dense_slots, &index);
+    if (result != CSTL_OK) {
+        if (new_slot) {
+            map->slots->size--;
+        }
+        map->values->size--;
+        slot_map_unlock(map);
+        return result;
+    }
+
+    slot_map_slot_t* slot = &slot_map_slots(map)[index];
+    if (!new_slot) {
+        map->free_head = slot->index;
+        if (map->free_head == SLOT_MAP_NIL) {
+            map->free_tail = SLOT_MAP_NIL;
+        }
+    }
+    slot->index = (uint32_t)(map->values->size - 1);
+    *handle = slot_map_make_handle(index, slot->generation);
+
+    slot_map_unlock(map);
+    return CSTL_OK;
+}
+
+/**
+ * @brief 删除句柄对应的元素
+ *
+ * @param map 槽位映射容器指针
+ * @param handle 元素句柄
+ * @return error_code_t 错误码，句柄已经失效时返回CSTL_ERROR_NOT_FOUND
+ */
+error_code_t slot_map_erase(slot_map_t* map, slot_handle_t handle)
+{
+    if (map == NULL) {
+        return CSTL_ERROR_NULL_POINTER;
+    }
+
+    slot_map_lock(map);
+
+    slot_map_slot_t* slot = slot_map_resolve(map, handle);
+    if (slot == NULL) {
+        slot_map_unlock(map);
+        return CSTL_ERROR_NOT_FOUND;
+    }
+
+    uint32_t* dense_slots = slot_map_dense_slots(map);
+    size_t position = slot->index;
+    size_t last = map->values->size - 1;
+
+    if (map->destructor != NULL) {
+        map->destructor(slot_map_value(map, position));
+    }
+
+    /* 最后一个元素移到空出的位置 */
+    if (position != last) {
+        memcpy(slot_map_value(map, position), slot_map_value(map, last), map->element_size);
+        dense_slots[position] = dense_slots[last];
+        slot_map_slots(map)[dense_slots[position]].index = (uint32_t)position;
+    }
+    map->values->size--;
+    map->dense_slots->size--;
+
+    slot_map_release_slot(map, (uint32_t)handle);
+
+    slot_map_unlock(map);
+    return CSTL_OK;
+}
+
+/**
+ * @brief 获取句柄对应的元素
+ *
+ * @param map 槽位映射容器指针
+ * @param handle 元素句柄
+ * @param element 输出参数，存储元素指针
+ * @return error_code_t 错误码，句柄已经失效时返回CSTL_ERROR_NOT_FOUND
+ */
+error_code_t slot_map_get(const slot_map_t* map, slot_handle_t handle, void** element)
+{
+    if (map == NULL || element == NULL) {
+        return CSTL_ERROR_NULL_POINTER;
+    }
+
+    slot_map_t* mutable_map = (slot_map_t*)map;
+    slot_map_lock(mutable_map);
+
+    const slot_map_slot_t* slot = slot_map_resolve(map, handle);
+    if (slot == NULL) {
+        slot_map_unlock(mutable_map);
+        return CSTL_ERROR_NOT_FOUND;
+    }
+
+    *element = slot_map_value(map, slot->index);
+
+    slot_map_unlock(mutable_map);
+    return CSTL_OK;
+}
+
+/**
+ * @brief 检查句柄是否有效
+ *
+ * @param map 槽位映射容器指针
+ * @param handle 元素句柄
+ * @return int 如果句柄对应的元素存在返回非零，否则返回零
+ */
+int slot_map_contains(const slot_map_t* map, slot_handle_t handle)
+{
+    if (map == NULL) {
+        return 0;
+    }
+
+    slot_map_t* mutable_map = (slot_map_t*)map;
+    slot_map_lock(mutable_map);
+    int found = slot_map_resolve(map, handle) != NULL;
+    slot_map_unlock(mutable_map);
+
+    return found;
+}
+
+/**
+ * @brief 获取紧凑存放的元素数组
+ *
+ * @param map 槽位映射容器指针
+ * @return void* 元素数组，容器为空时可能为NULL
+ */
+void* slot_map_data(const slot_map_t* map)
+{
+    if (map == NULL) {
+        return NULL;
+    }
+
+    return map->values->data;
+}
+
+/**
+ * @brief 获取紧凑数组中第index个元素的句柄
+ *
+ * @param map 槽位映射容器指针
+ * @param index 元素在紧凑数组中的位置
+ * @return slot_handle_t 元素句柄，index越界时返回SLOT_MAP_NULL_HANDLE
+ */
+slot_handle_t slot_map_handle_at(const slot_map_t* map, size_t index)
+{
+    if (map == NULL) {
+        return SLOT_MAP_NULL_HANDLE;
+    }
+
+    slot_map_t* mutable_map = (slot_map_t*)map;
+    slot_map_lock(mutable_map);
+
+    slot_handle_t handle = SLOT_MAP_NULL_HANDLE;
+    if (index < map->values->size) {
+        uint32_t slot = slot_map_dense_slots(map)[index];
+        handle = slot_map_make_handle(slot, slot_map_slots(map)[slot].generation);
+    }
+
+    slot_map_unlock(mutable_map);
+    return handle;
+}
+
+/**
+ * @brief 启用线程安全
+ *
+ * @param map 槽位映射容器指针
+ * @return error_code_t 错误码
+ */
+error_code_t slot_map_enable_thread_safety(slot_map_t* map)
+{
+    if (map == NULL) {
+        return CSTL_ERROR_NULL_POINTER;
+    }
+
+    if (!map->thread_safe) {
+        error_code_t result = mutex_init(&map->lock);
+        if (result != CSTL_OK) {
+            return result;
+        }
+        map->thread_safe = 1;
+    }
+
+    return CSTL_OK;
+}
+
+/**
+ * @brief 禁用线程安全
+ *
+ * @param map 槽位映射容器指针
+ * @return error_code_t 错误码
+ */
+error_code_t slot_map_disable_thread_safety(slot_map_t* map)
+{
+    if (map == NULL) {
+        return CSTL_ERROR_NULL_POINTER;
+    }
+
+    slot_map_lock(map);
+
+    if (map->thread_safe) {
+        map->thread_safe = 0;
+        mutex_unlock(&map->lock);
+        mutex_destroy(&map->lock);
+    }
+
+    return CSTL_OK;
+}
+
+/**
+ * @brief 获取槽位映射容器起始迭代器
+ *
+ * @param map 槽位映射容器指针
+ * @return iterator_t* 起始迭代器指针，失败返回NULL
+ */
+iterator_t* slot_map_begin(slot_map_t* map)
+{
+    if (map == NULL) {
+        return NULL;
+    }
+
+    return vector_begin(map->values);
+}
+
+/**
+ * @brief 获取槽位映射容器结束迭代器
+ *
+ * @param map 槽位映射容器指针
+ * @return iterator_t* 结束迭代器指针，失败返回NULL
+ */
+iterator_t* slot_map_end(slot_map_t* map)
+{
+    if (map == NULL) {
+        return NULL;
+    }
+
+    return vector_end(map->values);
+}
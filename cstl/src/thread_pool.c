@@ -0,0 +1,1150 @@
+/**
+ * @file thread_pool.c
+ * @brief CSTL库的线程池实现
+ *
+ * 该文件实现了CSTL库的工作窃取线程池，包括Chase-Lev双端队列、
+ * 注入队列、工作线程的休眠与唤醒、fork/join任务组、分块并行循环
+ * 和默认线程池。
+ */
+
+#if !defined(_WIN32) && !defined(_WIN64) && !defined(_GNU_SOURCE)
+#define _GNU_SOURCE
+#endif
+
+#include "cstl/thread_pool.h"
+#include <stdlib.h>
+#include <string.h>
+
+/* 线程支持 */
+#if defined(_WIN32) || defined(_WIN64)
+#include <windows.h>
+#else
+#include <pthread.h>
+#include <sched.h>
+#include <unistd.h>
+#endif
+
+/**
+ * @brief 双端队列的初始容量（必须是2的幂）
+ */
+#define WS_DEQUE_INITIAL_CAPACITY 256
+
+/**
+ * @brief 工作线程进入休眠前的空转轮数
+ */
+#define WORKER_SPIN_ROUNDS 64
+
+/**
+ * @brief 线程句柄和条件变量类型定义
+ */
+#if defined(_WIN32) || defined(_WIN64)
+typedef HANDLE thread_handle_t;
+typedef CONDITION_VARIABLE cond_t;
+#else
+typedef pthread_t thread_handle_t;
+typedef pthread_cond_t cond_t;
+#endif
+
+/**
+ * @brief 线程池任务结构体
+ */
+typedef struct thread_pool_task_t {
+    thread_task_fn_t fn;                /**< 任务函数 */
+    void* arg;                          /**< 任务参数 */
+    thread_task_group_t* group;         /**< 所属任务组，可以为NULL */
+    struct thread_pool_task_t* next;    /**< 注入队列中的下一个任务 */
+} thread_pool_task_t;
+
+/**
+ * @brief Chase-Lev双端队列的环形数组
+ *
+ * 扩容后旧数组可能仍被窃取线程读取，因此通过previous串起来，
+ * 在线程池销毁时统一释放。
+ */
+typedef struct ws_array_t {
+    int64_t capacity;                   /**< 容量，2的幂 */
+    struct ws_array_t* previous;        /**< 扩容前的旧数组 */
+    thread_pool_task_t* volatile slots[1]; /**< 任务槽位 */
+} ws_array_t;
+
+/**
+ * @brief Chase-Lev工作窃取双端队列
+ *
+ * 所有者在bottom端压入和弹出，其他线程在top端窃取；
+ * top和bottom放在不同缓存行上避免伪共享。
+ */
+typedef struct ws_deque_t {
+    volatile int64_t top;                                   /**< 窃取端 */
+    char pad1[CSTL_CACHE_LINE_SIZE - sizeof(int64_t)];
+    volatile int64_t bottom;                                /**< 所有者端 */
+    ws_array_t* volatile array;                             /**< 当前环形数组 */
+    char pad2[CSTL_CACHE_LINE_SIZE - sizeof(int64_t) - sizeof(void*)];
+} ws_deque_t;
+
+/**
+ * @brief 工作线程结构体
+ */
+typedef struct thread_worker_t {
+    ws_deque_t deque;                   /**< 本线程的任务队列 */
+    thread_pool_t* pool;                /**< 所属线程池 */
+    size_t index;                       /**< 工作线程编号 */
+    unsigned int seed;                  /**< 选择窃取目标的随机数状态 */
+    thread_handle_t thread;             /**< 线程句柄 */
+} thread_worker_t;
+
+/**
+ * @brief 线程池结构体
+ */
+struct thread_pool_t {
+    thread_worker_t* workers;           /**< 工作线程数组 */
+    size_t num_workers;                 /**< 工作线程数组大小 */
+    size_t num_started;                 /**< 成功启动的工作线程数量 */
+    int pin_threads;                    /**< 是否绑定CPU */
+    thread_pool_task_t* head;           /**< 注入队列头 */
+    thread_pool_task_t* tail;           /**< 注入队列尾 */
+    volatile size_t injected;           /**< 注入队列中的任务数量（原子访问） */
+    volatile size_t sleepers;           /**< 正在休眠的工作线程数量（原子访问） */
+    volatile int shutdown;              /**< 是否正在关闭 */
+    mutex_t lock;                       /**< 保护注入队列和休眠状态的互斥锁 */
+    cond_t task_available;              /**< 有新任务或关闭时通知 */
+};
+
+/**
+ * @brief 分块并行任务结构体
+ */
+typedef struct parallel_job_t {
+    thread_range_fn_t fn;               /**< 区间任务函数 */
+    void* context;                      /**< 用户上下文 */
+    size_t count;                       /**< 元素总数 */
+    size_t grain_size;                  /**< 分块大小 */
+    size_t num_chunks;                  /**< 分块数量 */
+    volatile size_t next_chunk;         /**< 下一个待领取的分块（原子访问） */
+} parallel_job_t;
+
+/**
+ * @brief 当前线程对应的工作线程，非工作线程为NULL
+ */
+static CSTL_THREAD_LOCAL thread_worker_t* tls_worker = NULL;
+
+/**
+ * @brief 默认线程池实例
+ */
+static thread_pool_t* volatile g_default_pool = NULL;
+
+/*
+ * 原子操作
+ *
+ * GCC/Clang使用__atomic内建函数；MSVC在x86/x64上volatile读写分别具有
+ * acquire/release语义，其余操作使用Interlocked系列函数。
+ */
+
+/**
+ * @brief 以acquire语义读取64位整数
+ */
+static inline int64_t atomic_load_i64(const volatile int64_t* target)
+{
+#if defined(_MSC_VER)
+    return *target;
+#else
+    return __atomic_load_n(target, __ATOMIC_ACQUIRE);
+#endif
+}
+
+/**
+ * @brief 以release语义写入64位整数
+ */
+static inline void atomic_store_i64(volatile int64_t* target, int64_t value)
+{
+#if defined(_MSC_VER)
+    *target = value;
+#else
+    __atomic_store_n(target, value, __ATOMIC_RELEASE);
+#endif
+}
+
+/**
+ * @brief 64位整数的比较并交换（顺序一致）
+ *
+ * @return int 交换成功返回非零
+ */
+static inline int atomic_cas_i64(volatile int64_t* target, int64_t expected, int64_t desired)
+{
+#if defined(_MSC_VER)
+    return InterlockedCompareExchange64((volatile LONG64*)target, desired, expected) == expected;
+#else
+    return __atomic_compare_exchange_n(target, &expected, desired, 0,
+                                       __ATOMIC_SEQ_CST, __ATOMIC_RELAXED);
+#endif
+}
+
+/**
+ * @brief 以acquire语义读取指针
+ */
+static inline void* atomic_load_ptr(void* const volatile* target)
+{
+#if defined(_MSC_VER)
+    return *target;
+#else
+    return __atomic_load_n(target, __ATOMIC_ACQUIRE);
+#endif
+}
+
+/**
+ * @brief 以release语义写入指针
+ */
+static inline void atomic_store_ptr(void* volatile* target, void* value)
+{
+#if defined(_MSC_VER)
+    *target = value;
+#else
+    __atomic_store_n(target, value, __ATOMIC_RELEASE);
+#endif
+}
+
+/**
+ * @brief 以acquire语义读取size_t
+ */
+static inline size_t atomic_load_size(const volatile size_t* target)
+{
+#if defined(_MSC_VER)
+    return *target;
+#else
+    return __atomic_load_n(target, __ATOMIC_ACQUIRE);
+#endif
+}
+
+/**
+ * @brief size_t原子加法（顺序一致）
+ *
+ * @return size_t 增加前的值
+ */
+static inline size_t atomic_fetch_add_size(volatile size_t* target, size_t value)
+{
+#if defined(_MSC_VER) && defined(_WIN64)
+    return (size_t)InterlockedExchangeAdd64((volatile LONG64*)target, (LONG64)value);
+#elif defined(_MSC_VER)
+    return (size_t)InterlockedExchangeAdd((volatile LONG*)target, (LONG)value);
+#else
+    return __atomic_fetch_add(target, value, __ATOMIC_SEQ_CST);
+#endif
+}
+
+/**
+ * @brief 顺序一致的内存屏障
+ */
+static inline void atomic_fence(void)
+{
+#if defined(_MSC_VER)
+    MemoryBarrier();
+#else
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+#endif
+}
+
+/**
+ * @brief 让出CPU
+ */
+static void thread_yield(void)
+{
+#if defined(_WIN32) || defined(_WIN64)
+    SwitchToThread();
+#else
+    sched_yield();
+#endif
+}
+
+/**
+ * @brief 初始化条件变量
+ *
+ * @param cond 条件变量指针
+ */
+static void cond_init(cond_t* cond)
+{
+#if defined(_WIN32) || defined(_WIN64)
+    InitializeConditionVariable(cond);
+#else
+    pthread_cond_init(cond, NULL);
+#endif
+}
+
+/**
+ * @brief 销毁条件变量
+ *
+ * @param cond 条件变量指针
+ */
+static void cond_destroy(cond_t* cond)
+{
+#if defined(_WIN32) || defined(_WIN64)
+    (void)cond;
+#else
+    pthread_cond_destroy(cond);
+#endif
+}
+
+/**
+ * @brief 等待条件变量，调用前必须持有mutex
+ *
+ * @param cond 条件变量指针
+ * @param mutex 互斥锁指针
+ */
+static void cond_wait(cond_t* cond, mutex_t* mutex)
+{
+#if defined(_WIN32) || defined(_WIN64)
+    SleepConditionVariableCS(cond, mutex, INFINITE);
+#else
+    pthread_cond_wait(cond, mutex);
+#endif
+}
+
+/**
+ * @brief 唤醒一个等待线程
+ *
+ * @param cond 条件变量指针
+ */
+static void cond_signal(cond_t* cond)
+{
+#if defined(_WIN32) || defined(_WIN64)
+    WakeConditionVariable(cond);
+#else
+    pthread_cond_signal(cond);
+#endif
+}
+
+/**
+ * @brief 唤醒所有等待线程
+ *
+ * @param cond 条件变量指针
+ */
+static void cond_broadcast(cond_t* cond)
+{
+#if defined(_WIN32) || defined(_WIN64)
+    WakeAllConditionVariable(cond);
+#else
+    pthread_cond_broadcast(cond);
+#endif
+}
+
+/**
+ * @brief 分配环形数组
+ *
+ * @param capacity 容量，2的幂
+ * @return ws_array_t* 数组指针，失败返回NULL
+ */
+static ws_array_t* ws_array_create(int64_t capacity)
+{
+    ws_array_t* array = (ws_array_t*)malloc(sizeof(ws_array_t) +
+                                            (size_t)(capacity - 1) * sizeof(thread_pool_task_t*));
+    if (array == NULL) {
+        return NULL;
+    }
+
+    array->capacity = capacity;
+    array->previous = NULL;
+    return array;
+}
+
+/**
+ * @brief 初始化双端队列
+ *
+ * @param deque 双端队列指针
+ * @return error_code_t 错误码
+ */
+static error_code_t ws_deque_init(ws_deque_t* deque)
+{
+    deque->top = 0;
+    deque->bottom = 0;
+    deque->array = ws_array_create(WS_DEQUE_INITIAL_CAPACITY);
+    return deque->array != NULL ? CSTL_OK : CSTL_ERROR_OUT_OF_MEMORY;
+}
+
+/**
+ * @brief 释放双端队列及其所有历史数组
+ *
+ * @param deque 双端队列指针
+ */
+static void ws_deque_destroy(ws_deque_t* deque)
+{
+    ws_array_t* array = deque->array;
+    while (array != NULL) {
+        ws_array_t* previous = array->previous;
+        free(array);
+        array = previous;
+    }
+    deque->array = NULL;
+}
+
+/**
+ * @brief 所有者在底部压入任务
+ *
+ * @param deque 双端队列指针
+ * @param task 任务指针
+ * @return error_code_t 错误码
+ */
+static error_code_t ws_deque_push(ws_deque_t* deque, thread_pool_task_t* task)
+{
+    int64_t bottom = deque->bottom;
+    int64_t top = atomic_load_i64(&deque->top);
+    ws_array_t* array = deque->array;
+
+    if (bottom - top >= array->capacity) {
+        /* 扩容为两倍，旧数组保留到销毁时释放 */
+        ws_array_t* grown = ws_array_create(array->capacity * 2);
+        if (grown == NULL) {
+            return CSTL_ERROR_OUT_OF_MEMORY;
+        }
+        for (int64_t i = top; i < bottom; i++) {
+            grown->slots[i & (grown->capacity - 1)] = array->slots[i & (array->capacity - 1)];
+        }
+        grown->previous = array;
+        atomic_store_ptr((void* volatile*)&deque->array, grown);
+        array = grown;
+    }
+
+    atomic_store_ptr((void* volatile*)&array->slots[bottom & (array->capacity - 1)], task);
+    atomic_store_i64(&deque->bottom, bottom + 1);
+    return CSTL_OK;
+}
+
+/**
+ * @brief 所有者从底部弹出任务
+ *
+ * @param deque 双端队列指针
+ * @return thread_pool_task_t* 任务指针，队列为空时返回NULL
+ */
+static thread_pool_task_t* ws_deque_pop(ws_deque_t* deque)
+{
+    int64_t bottom = deque->bottom - 1;
+    ws_array_t* array = deque->array;
+    atomic_store_i64(&deque->bottom, bottom);
+    atomic_fence();
+    int64_t top = atomic_load_i64(&deque->top);
+
+    if (top > bottom) {
+        atomic_store_i64(&deque->bottom, bottom + 1);
+        return NULL;
+    }
+
+    thread_pool_task_t* task = (thread_pool_task_t*)atomic_load_ptr(
+        (void* const volatile*)&array->slots[bottom & (array->capacity - 1)]);
+
+    if (top == bottom) {
+        /* 只剩最后一个任务，与窃取线程竞争 */
+        if (!atomic_cas_i64(&deque->top, top, top + 1)) {
+            task = NULL;
+        }
+        atomic_store_i64(&deque->bottom, bottom + 1);
+    }
+
+    return task;
+}
+
+/**
+ * @brief 其他线程从顶部窃取任务
+ *
+ * @param deque 双端队列指针
+ * @return thread_pool_task_t* 任务指针，队列为空或竞争失败时返回NULL
+ */
+static thread_pool_task_t* ws_deque_steal(ws_deque_t* deque)
+{
+    int64_t top = atomic_load_i64(&deque->top);
+    atomic_fence();
+    int64_t bottom = atomic_load_i64(&deque->bottom);
+
+    if (top >= bottom) {
+        return NULL;
+    }
+
+    ws_array_t* array = (ws_array_t*)atomic_load_ptr((void* const volatile*)&deque->array);
+    thread_pool_task_t* task = (thread_pool_task_t*)atomic_load_ptr(
+        (void* const volatile*)&array->slots[top & (array->capacity - 1)]);
+
+    if (!atomic_cas_i64(&deque->top, top, top + 1)) {
+        return NULL;
+    }
+
+    return task;
+}
+
+/**
+ * @brief 检查双端队列是否可能有任务
+ *
+ * @param deque 双端队列指针
+ * @return int 可能有任务返回非零
+ */
+static int ws_deque_has_tasks(ws_deque_t* deque)
+{
+    return atomic_load_i64(&deque->bottom) > atomic_load_i64(&deque->top);
+}
+
+/**
+ * @brief 从注入队列取出一个任务
+ *
+ * @param pool 线程池指针
+ * @return thread_pool_task_t* 任务指针，队列为空时返回NULL
+ */
+static thread_pool_task_t* thread_pool_pop_injected(thread_pool_t* pool)
+{
+    if (atomic_load_size(&pool->injected) == 0) {
+        return NULL;
+    }
+
+    mutex_lock(&pool->lock);
+    thread_pool_task_t* task = pool->head;
+    if (task != NULL) {
+        pool->head = task->next;
+        if (pool->head == NULL) {
+            pool->tail = NULL;
+        }
+        atomic_fetch_add_size(&pool->injected, (size_t)-1);
+    }
+    mutex_unlock(&pool->lock);
+
+    return task;
+}
+
+/**
+ * @brief 检查线程池中是否还有待执行的任务
+ *
+ * @param pool 线程池指针
+ * @return int 有任务返回非零
+ */
+static int thread_pool_has_tasks(thread_pool_t* pool)
+{
+    if (atomic_load_size(&pool->injected) > 0) {
+        return 1;
+    }
+    for (size_t i = 0; i < pool->num_workers; i++) {
+        if (ws_deque_has_tasks(&pool->workers[i].deque)) {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+/**
+ * @brief 查找一个可执行的任务
+ *
+ * 依次尝试本线程队列、注入队列，最后从随机起点开始窃取其他工作线程的任务。
+ *
+ * @param pool 线程池指针
+ * @param self 当前工作线程，非工作线程为NULL
+ * @return thread_pool_task_t* 任务指针，没有任务时返回NULL
+ */
+static thread_pool_task_t* thread_pool_find_task(thread_pool_t* pool, thread_worker_t* self)
+{
+    thread_pool_task_t* task = NULL;
+
+    if (self != NULL) {
+        task = ws_deque_pop(&self->deque);
+        if (task != NULL) {
+            return task;
+        }
+    }
+
+    task = thread_pool_pop_injected(pool);
+    if (task != NULL) {
+        return task;
+    }
+
+    size_t start = 0;
+    if (self != NULL) {
+        self->seed = self->seed * 1103515245u + 12345u;
+        start = (self->seed >> 16) % pool->num_workers;
+    }
+
+    for (size_t i = 0; i < pool->num_workers; i++) {
+        thread_worker_t* victim = &pool->workers[(start + i) % pool->num_workers];
+        if (victim == self) {
+            continue;
+        }
+        task = ws_deque_steal(&victim->deque);
+        if (task != NULL) {
+            return task;
+        }
+    }
+
+    return NULL;
+}
+
+/**
+ * @brief 执行任务并通知所属任务组
+ *
+ * @param task 任务指针
+ */
+static void thread_pool_execute(thread_pool_task_t* task)
+{
+    thread_task_group_t* group = task->group;
+
+    task->fn(task->arg);
+    free(task);
+
+    if (group != NULL) {
+        atomic_fetch_add_size(&group->pending, (size_t)-1);
+    }
+}
+
+/**
+ * @brief 在有休眠的工作线程时唤醒其中一个
+ *
+ * 与休眠路径中"先登记休眠再检查任务"的顺序配合，屏障保证不会丢失唤醒。
+ *
+ * @param pool 线程池指针
+ */
+static void thread_pool_notify(thread_pool_t* pool)
+{
+    atomic_fence();
+    if (atomic_load_size(&pool->sleepers) > 0) {
+        mutex_lock(&pool->lock);
+        cond_signal(&pool->task_available);
+        mutex_unlock(&pool->lock);
+    }
+}
+
+/**
+ * @brief 将当前线程绑定到指定CPU
+ *
+ * @param index 工作线程编号
+ */
+static void thread_pin_to_cpu(size_t index)
+{
+    size_t cpu = index % thread_hardware_concurrency();
+#if defined(_WIN32) || defined(_WIN64)
+    if (cpu < sizeof(DWORD_PTR) * 8) {
+        SetThreadAffinityMask(GetCurrentThread(), (DWORD_PTR)1 << cpu);
+    }
+#elif defined(__linux__)
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+    pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+#else
+    (void)cpu;
+#endif
+}
+
+/**
+ * @brief 工作线程主循环
+ *
+ * @param self 工作线程指针
+ */
+static void thread_pool_worker_loop(thread_worker_t* self)
+{
+    thread_pool_t* pool = self->pool;
+    tls_worker = self;
+
+    if (pool->pin_threads) {
+        thread_pin_to_cpu(self->index);
+    }
+
+    while (1) {
+        thread_pool_task_t* task = NULL;
+
+        for (int spin = 0; spin < WORKER_SPIN_ROUNDS && task == NULL; spin++) {
+            task = thread_pool_find_task(pool, self);
+            if (task == NULL) {
+                thread_yield();
+            }
+        }
+
+        if (task != NULL) {
+            thread_pool_execute(task);
+            continue;
+        }
+
+        /* 先登记为休眠再重新检查，避免与提交者之间丢失唤醒 */
+        mutex_lock(&pool->lock);
+        atomic_fetch_add_size(&pool->sleepers, 1);
+        atomic_fence();
+
+        if (thread_pool_has_tasks(pool)) {
+            atomic_fetch_add_size(&pool->sleepers, (size_t)-1);
+            mutex_unlock(&pool->lock);
+            continue;
+        }
+
+        /* 关闭时只有在所有任务都执行完后才退出 */
+        if (pool->shutdown) {
+            atomic_fetch_add_size(&pool->sleepers, (size_t)-1);
+            mutex_unlock(&pool->lock);
+            break;
+        }
+
+        cond_wait(&pool->task_available, &pool->lock);
+        atomic_fetch_add_size(&pool->sleepers, (size_t)-1);
+        mutex_unlock(&pool->lock);
+    }
+
+    tls_worker = NULL;
+}
+
+#if defined(_WIN32) || defined(_WIN64)
+/**
+ * @brief 工作线程入口
+ *
+ * @param arg 工作线程指针
+ * @return DWORD 线程退出码
+ */
+static DWORD WINAPI thread_pool_worker(LPVOID arg)
+{
+    thread_pool_worker_loop((thread_worker_t*)arg);
+    return 0;
+}
+#else
+/**
+ * @brief 工作线程入口
+ *
+ * @param arg 工作线程指针
+ * @return void* 线程退出值
+ */
+static void* thread_pool_worker(void* arg)
+{
+    thread_pool_worker_loop((thread_worker_t*)arg);
+    return NULL;
+}
+#endif
+
+/**
+ * @brief 获取硬件线程数量
+ *
+ * @return size_t 在线的逻辑CPU数量，无法获取时返回1
+ */
+size_t thread_hardware_concurrency(void)
+{
+#if defined(_WIN32) || defined(_WIN64)
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    return info.dwNumberOfProcessors > 0 ? (size_t)info.dwNumberOfProcessors : 1;
+#else
+    long count = sysconf(_SC_NPROCESSORS_ONLN);
+    return count > 0 ? (size_t)count : 1;
+#endif
+}
+
+/**
+ * @brief 创建线程池
+ *
+ * @param num_threads 工作线程数量，为0时使用硬件线程数量
+ * @return thread_pool_t* 线程池指针，失败返回NULL
+ */
+thread_pool_t* thread_pool_create(size_t num_threads)
+{
+    thread_pool_options_t options;
+    memset(&options, 0, sizeof(options));
+    options.num_threads = num_threads;
+    return thread_pool_create_ex(&options);
+}
+
+/**
+ * @brief 按选项创建线程池
+ *
+ * @param options 创建选项，为NULL时使用默认选项
+ * @return thread_pool_t* 线程池指针，失败返回NULL
+ */
+thread_pool_t* thread_pool_create_ex(const thread_pool_options_t* options)
+{
+    size_t num_threads = options != NULL ? options->num_threads : 0;
+    if (num_threads == 0) {
+        num_threads = thread_hardware_concurrency();
+    }
+
+    thread_pool_t* pool = (thread_pool_t*)malloc(sizeof(thread_pool_t));
+    if (pool == NULL) {
+        return NULL;
+    }
+
+    pool->workers = (thread_worker_t*)calloc(num_threads, sizeof(thread_worker_t));
+    if (pool->workers == NULL) {
+        free(pool);
+        return NULL;
+    }
+
+    pool->num_workers = num_threads;
+    pool->num_started = 0;
+    pool->pin_threads = options != NULL ? options->pin_threads : 0;
+    pool->head = NULL;
+    pool->tail = NULL;
+    pool->injected = 0;
+    pool->sleepers = 0;
+    pool->shutdown = 0;
+    mutex_init(&pool->lock);
+    cond_init(&pool->task_available);
+
+    /* 所有队列就绪后再启动线程，窃取时可以安全访问任意工作线程 */
+    for (size_t i = 0; i < num_threads; i++) {
+        thread_worker_t* worker = &pool->workers[i];
+        worker->pool = pool;
+        worker->index = i;
+        worker->seed = (unsigned int)(i * 2654435761u + 1);
+        if (ws_deque_init(&worker->deque) != CSTL_OK) {
+            thread_pool_destroy(pool);
+            return NULL;
+        }
+    }
+
+    for (size_t i = 0; i < num_threads; i++) {
+        thread_worker_t* worker = &pool->workers[i];
+#if defined(_WIN32) || defined(_WIN64)
+        worker->thread = CreateThread(NULL, 0, thread_pool_worker, worker, 0, NULL);
+        if (worker->thread == NULL) {
+            break;
+        }
+#else
+        if (pthread_create(&worker->thread, NULL, thread_pool_worker, worker) != 0) {
+            break;
+        }
+#endif
+        pool->num_started++;
+    }
+
+    if (pool->num_started == 0) {
+        thread_pool_destroy(pool);
+        return NULL;
+    }
+
+    return pool;
+}
+
+/**
+ * @brief 销毁线程池
+ *
+ * @param pool 线程池指针
+ */
+void thread_pool_destroy(thread_pool_t* pool)
+{
+    if (pool == NULL) {
+        return;
+    }
+
+    mutex_lock(&pool->lock);
+    pool->shutdown = 1;
+    cond_broadcast(&pool->task_available);
+    mutex_unlock(&pool->lock);
+
+    for (size_t i = 0; i < pool->num_started; i++) {
+#if defined(_WIN32) || defined(_WIN64)
+        WaitForSingleObject(pool->workers[i].thread, INFINITE);
+        CloseHandle(pool->workers[i].thread);
+#else
+        pthread_join(pool->workers[i].thread, NULL);
+#endif
+    }
+
+    for (size_t i = 0; i < pool->num_workers; i++) {
+        ws_deque_destroy(&pool->workers[i].deque);
+    }
+
+    cond_destroy(&pool->task_available);
+    mutex_destroy(&pool->lock);
+    free(pool->workers);
+    free(pool);
+}
+
+/**
+ * @brief 获取线程池的工作线程数量
+ *
+ * @param pool 线程池指针
+ * @return size_t 工作线程数量
+ */
+size_t thread_pool_size(const thread_pool_t* pool)
+{
+    return pool != NULL ? pool->num_started : 0;
+}
+
+/**
+ * @brief 获取当前线程在线程池中的工作线程编号
+ *
+ * @param pool 线程池指针
+ * @return size_t 工作线程编号，不是该线程池的工作线程时返回(size_t)-1
+ */
+size_t thread_pool_worker_index(const thread_pool_t* pool)
+{
+    thread_worker_t* self = tls_worker;
+    if (pool == NULL || self == NULL || self->pool != pool) {
+        return (size_t)-1;
+    }
+    return self->index;
+}
+
+/**
+ * @brief 将任务放入线程池
+ *
+ * @param pool 线程池指针
+ * @param task 任务指针
+ * @return error_code_t 错误码
+ */
+static error_code_t thread_pool_enqueue(thread_pool_t* pool, thread_pool_task_t* task)
+{
+    thread_worker_t* self = tls_worker;
+
+    if (self != NULL && self->pool == pool) {
+        error_code_t err = ws_deque_push(&self->deque, task);
+        if (err != CSTL_OK) {
+            return err;
+        }
+        thread_pool_notify(pool);
+        return CSTL_OK;
+    }
+
+    mutex_lock(&pool->lock);
+    if (pool->shutdown) {
+        mutex_unlock(&pool->lock);
+        return CSTL_ERROR_INVALID_ARGUMENT;
+    }
+
+    task->next = NULL;
+    if (pool->tail != NULL) {
+        pool->tail->next = task;
+    } else {
+        pool->head = task;
+    }
+    pool->tail = task;
+    atomic_fetch_add_size(&pool->injected, 1);
+    cond_signal(&pool->task_available);
+    mutex_unlock(&pool->lock);
+
+    return CSTL_OK;
+}
+
+/**
+ * @brief 向线程池提交任务
+ *
+ * @param pool 线程池指针
+ * @param task 任务函数指针
+ * @param arg 任务参数
+ * @return error_code_t 错误码
+ */
+error_code_t thread_pool_submit(thread_pool_t* pool, thread_task_fn_t task, void* arg)
+{
+    if (pool == NULL || task == NULL) {
+        return CSTL_ERROR_NULL_POINTER;
+    }
+
+    thread_pool_task_t* node = (thread_pool_task_t*)malloc(sizeof(thread_pool_task_t));
+    if (node == NULL) {
+        return CSTL_ERROR_OUT_OF_MEMORY;
+    }
+
+    node->fn = task;
+    node->arg = arg;
+    node->group = NULL;
+    node->next = NULL;
+
+    error_code_t err = thread_pool_enqueue(pool, node);
+    if (err != CSTL_OK) {
+        free(node);
+    }
+    return err;
+}
+
+/**
+ * @brief 初始化任务组
+ *
+ * @param group 任务组指针
+ * @param pool 线程池指针，为NULL时使用默认线程池
+ * @return error_code_t 错误码
+ */
+error_code_t thread_task_group_init(thread_task_group_t* group, thread_pool_t* pool)
+{
+    if (group == NULL) {
+        return CSTL_ERROR_NULL_POINTER;
+    }
+
+    group->pool = pool != NULL ? pool : thread_pool_default();
+    group->pending = 0;
+    return CSTL_OK;
+}
+
+/**
+ * @brief 在任务组中派生一个任务
+ *
+ * @param group 任务组指针
+ * @param task 任务函数指针
+ * @param arg 任务参数
+ * @return error_code_t 错误码
+ */
+error_code_t thread_task_group_run(thread_task_group_t* group, thread_task_fn_t task, void* arg)
+{
+    if (group == NULL || task == NULL) {
+        return CSTL_ERROR_NULL_POINTER;
+    }
+
+    thread_pool_task_t* node = NULL;
+    if (group->pool != NULL) {
+        node = (thread_pool_task_t*)malloc(sizeof(thread_pool_task_t));
+    }
+
+    if (node != NULL) {
+        node->fn = task;
+        node->arg = arg;
+        node->group = group;
+        node->next = NULL;
+
+        atomic_fetch_add_size(&group->pending, 1);
+        if (thread_pool_enqueue(group->pool, node) == CSTL_OK) {
+            return CSTL_OK;
+        }
+        atomic_fetch_add_size(&group->pending, (size_t)-1);
+        free(node);
+    }
+
+    /* 无法入队时同步执行 */
+    task(arg);
+    return CSTL_OK;
+}
+
+/**
+ * @brief 等待任务组中所有任务完成
+ *
+ * @param group 任务组指针
+ * @return error_code_t 错误码
+ */
+error_code_t thread_task_group_wait(thread_task_group_t* group)
+{
+    if (group == NULL) {
+        return CSTL_ERROR_NULL_POINTER;
+    }
+
+    thread_pool_t* pool = group->pool;
+    thread_worker_t* self = tls_worker;
+    if (self != NULL && self->pool != pool) {
+        self = NULL;
+    }
+
+    while (atomic_load_size(&group->pending) > 0) {
+        thread_pool_task_t* task = pool != NULL ? thread_pool_find_task(pool, self) : NULL;
+        if (task != NULL) {
+            thread_pool_execute(task);
+        } else {
+            thread_yield();
+        }
+    }
+
+    return CSTL_OK;
+}
+
+/**
+ * @brief 循环领取并执行分块，直到没有剩余分块
+ *
+ * @param job 分块并行任务指针
+ */
+static void parallel_job_run(parallel_job_t* job)
+{
+    while (1) {
+        size_t chunk = atomic_fetch_add_size(&job->next_chunk, 1);
+        if (chunk >= job->num_chunks) {
+            break;
+        }
+
+        size_t begin = chunk * job->grain_size;
+        size_t end = begin + job->grain_size;
+        if (end > job->count) {
+            end = job->count;
+        }
+
+        job->fn(job->context, begin, end);
+    }
+}
+
+/**
+ * @brief 辅助任务入口
+ *
+ * @param arg 分块并行任务指针
+ */
+static void parallel_job_helper(void* arg)
+{
+    parallel_job_run((parallel_job_t*)arg);
+}
+
+/**
+ * @brief 将[0, count)按grain_size分块并行执行
+ *
+ * @param pool 线程池指针，为NULL时使用默认线程池
+ * @param count 元素总数
+ * @param grain_size 每个分块的元素数量
+ * @param range_fn 区间任务函数指针
+ * @param context 传给range_fn的用户上下文
+ * @return error_code_t 错误码
+ */
+error_code_t thread_pool_parallel_for(thread_pool_t* pool, size_t count, size_t grain_size,
+                                      thread_range_fn_t range_fn, void* context)
+{
+    if (range_fn == NULL) {
+        return CSTL_ERROR_NULL_POINTER;
+    }
+    if (grain_size == 0) {
+        return CSTL_ERROR_INVALID_ARGUMENT;
+    }
+    if (count == 0) {
+        return CSTL_OK;
+    }
+
+    if (pool == NULL) {
+        pool = thread_pool_default();
+    }
+
+    parallel_job_t job;
+    job.fn = range_fn;
+    job.context = context;
+    job.count = count;
+    job.grain_size = grain_size;
+    job.num_chunks = (count + grain_size - 1) / grain_size;
+    job.next_chunk = 0;
+
+    /* 只有一个分块或没有可用线程池时直接在当前线程执行 */
+    if (job.num_chunks == 1 || pool == NULL) {
+        parallel_job_run(&job);
+        return CSTL_OK;
+    }
+
+    size_t helpers = job.num_chunks - 1;
+    if (helpers > pool->num_started) {
+        helpers = pool->num_started;
+    }
+
+    /* 辅助任务与调用线程共同领取分块，join时调用线程帮助执行剩余任务 */
+    thread_task_group_t group;
+    thread_task_group_init(&group, pool);
+    for (size_t i = 0; i < helpers; i++) {
+        thread_task_group_run(&group, parallel_job_helper, &job);
+    }
+
+    parallel_job_run(&job);
+    return thread_task_group_wait(&group);
+}
+
+/**
+ * @brief 获取进程内共享的默认线程池
+ *
+ * @return thread_pool_t* 默认线程池指针，创建失败返回NULL
+ */
+thread_pool_t* thread_pool_default(void)
+{
+    thread_pool_t* pool = (thread_pool_t*)atomic_load_ptr((void* const volatile*)&g_default_pool);
+    if (pool != NULL) {
+        return pool;
+    }
+
+    thread_pool_t* created = thread_pool_create(0);
+    if (created == NULL) {
+        return NULL;
+    }
+
+    /* 多个线程同时初始化时只保留第一个成功发布的实例 */
+#if defined(_MSC_VER)
+    pool = (thread_pool_t*)InterlockedCompareExchangePointer(
+        (PVOID volatile*)&g_default_pool, created, NULL);
+    if (pool == NULL) {
+        return created;
+    }
+#else
+    thread_pool_t* expected = NULL;
+    if (__atomic_compare_exchange_n(&g_default_pool, &expected, created, 0,
+                                    __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE)) {
+        return created;
+    }
+    pool = expected;
+#endif
+
+    thread_pool_destroy(created);
+    return pool;
+}
@@ -0,0 +1,1167 @@
+/**
+ * @file ulist.c
+ * @brief CSTL库的展开链表容器实现
+ *
+ * 该文件实现了CSTL库的展开链表容器。每个节点由一次分配得到，
+ * 节点结构体之后紧跟node_capacity个元素的存储空间，元素在节点内从0开始连续存放。
+ */
+
+#include "cstl/ulist.h"
+#include <stdlib.h>
+#include <string.h>
+
+/**
+ * @brief 展开链表迭代器结构体
+ */
+typedef struct ulist_iterator_t {
+    iterator_t base;         /**< 基础迭代器 */
+    ulist_node_t* node;      /**< 当前节点 */
+    size_t slot;             /**< 当前元素在节点内的位置 */
+} ulist_iterator_t;
+
+/**
+ * @brief 获取节点内指定位置的元素
+ *
+ * @param list 展开链表容器指针
+ * @param node 节点指针
+ * @param slot 节点内的位置
+ * @return unsigned char* 元素指针
+ */
+static unsigned char* ulist_slot(const ulist_t* list, const ulist_node_t* node, size_t slot)
+{
+    return (unsigned char*)(node + 1) + slot * list->element_size;
+}
+
+/**
+ * @brief 展开链表迭代器next函数实现
+ *
+ * @param iterator 迭代器指针
+ * @return error_code_t 错误码
+ */
+static error_code_t ulist_iterator_next(iterator_t* iterator)
+{
+    if (iterator == NULL) {
+        return CSTL_ERROR_NULL_POINTER;
+    }
+
+    ulist_iterator_t* ulist_iter = (ulist_iterator_t*)iterator;
+    const ulist_t* list = (const ulist_t*)iterator->container;
+
+    if (ulist_iter->node == NULL) {
+        return CSTL_ERROR_ITERATOR_END;
+    }
+
+    ulist_iter->slot++;
+    if (ulist_iter->slot < ulist_iter->node->count) {
+        iterator->current = (unsigned char*)iterator->current + list->element_size;
+        return CSTL_OK;
+    }
+
+    ulist_iter->node = ulist_iter->node->next;
+    ulist_iter->slot = 0;
+    iterator->current = ulist_iter->node != NULL ? ulist_slot(list, ulist_iter->node, 0) : NULL;
+
+    return CSTL_OK;
+}
+
+/**
+ * @brief 展开链表迭代器prev函数实现
+ *
+ * 结束迭代器后退到尾元素，与向量迭代器的行为一致，可以用于需要双向迭代的算法。
+ *
+ * @param iterator 迭代器指针
+ * @return error_code_t 错误码
+ */
+static error_code_t ulist_iterator_prev(iterator_t* iterator)
+{
+    if (iterator == NULL) {
+        return CSTL_ERROR_NULL_POINTER;
+    }
+
+    ulist_iterator_t* ulist_iter = (ulist_iterator_t*)iterator;
+    const ulist_t* list = (const ulist_t*)iterator->container;
+
+    if (ulist_iter->node != NULL && ulist_iter->slot > 0) {
+        ulist_iter->slot--;
+        iterator->current = (unsigned char*)iterator->current - list->element_size;
+        return CSTL_OK;
+    }
+
+    ulist_node_t* prev = ulist_iter->node != NULL ? ulist_iter->node->prev : list->tail;
+    if (prev == NULL) {
+        return CSTL_ERROR_ITERATOR_END;
+    }
+
+    ulist_iter->node = prev;
+    ulist_iter->slot = prev->count - 1;
+    iterator->current = ulist_slot(list, prev, ulist_iter->slot);
+
+    return CSTL_OK;
+}
+
+/**
+ * @brief 展开链表迭代器get函数实现
+ *
+ * @param iterator 迭代器指针
+ * @param data 输出参数，存储当前元素指针
+ * @return error_code_t 错误码
+ */
+static error_code_t ulist_iterator_get(iterator_t* iterator, void** data)
+{
+    if (iterator == NULL || data == NULL) {
+        return CSTL_ERROR_NULL_POINTER;
+    }
+
+    ulist_iterator_t* ulist_iter = (ulist_iterator_t*)iterator;
+
+    if (ulist_iter->node == NULL) {
+        return CSTL_ERROR_ITERATOR_END;
+    }
+
+    *data = iterator->current;
+    return CSTL_OK;
+}
+
+/**
+ * @brief 展开链表迭代器valid函数实现
+ *
+ * @param iterator 迭代器指针
+ * @return int 如果有效返回非零，否则返回零
+ */
+static int ulist_iterator_valid(iterator_t* iterator)
+{
+    if (iterator == NULL) {
+        return 0;
+    }
+
+    ulist_iterator_t* ulist_iter = (ulist_iterator_t*)iterator;
+    return ulist_iter->node != NULL;
+}
+
+/**
+ * @brief 展开链表迭代器destroy函数实现
+ *
+ * @param iterator 迭代器指针
+ */
+static void ulist_iterator_destroy(iterator_t* iterator)
+{
+    /* 不需要特殊处理，迭代器将在iterator_destroy中释放 */
+    (void)iterator;
+}
+
+/**
+ * @brief 展开链表迭代器clone函数实现
+ *
+ * @param iterator 迭代器指针
+ * @return iterator_t* 克隆的迭代器指针，失败返回NULL
+ */
+static iterator_t* ulist_iterator_clone(iterator_t* iterator)
+{
+    if (iterator == NULL) {
+        return NULL;
+    }
+
+    ulist_iterator_t* ulist_iter = (ulist_iterator_t*)iterator;
+    ulist_iterator_t* new_ulist_iter = (ulist_iterator_t*)malloc(sizeof(ulist_iterator_t));
+    if (new_ulist_iter == NULL) {
+        return NULL;
+    }
+
+    /* 复制基础迭代器和当前位置 */
+    new_ulist_iter->base = ulist_iter->base;
+    new_ulist_iter->node = ulist_iter->node;
+    new_ulist_iter->slot = ulist_iter->slot;
+
+    return (iterator_t*)new_ulist_iter;
+}
+
+/**
+ * @brief 锁定展开链表容器（如果启用线程安全）
+ *
+ * @param list 展开链表容器指针
+ */
+static void ulist_lock(ulist_t* list)
+{
+    if (list != NULL && list->thread_safe) {
+        mutex_lock(&list->lock);
+    }
+}
+
+/**
+ * @brief 解锁展开链表容器（如果启用线程安全）
+ *
+ * @param list 展开链表容器指针
+ */
+static void ulist_unlock(ulist_t* list)
+{
+    if (list != NULL && list->thread_safe) {
+        mutex_unlock(&list->lock);
+    }
+}
+
+/**
+ * @brief 分配一个空节点，并把它链接到after之后，after为NULL时链接到最前面
+ *
+ * @param list 展开链表容器指针
+ * @param after 链表中的节点指针，可以为NULL
+ * @return ulist_node_t* 新节点指针，失败返回NULL
+ */
+static ulist_node_t* ulist_new_node(ulist_t* list, ulist_node_t* after)
+{
+    size_t bytes = sizeof(ulist_node_t) + list->node_capacity * list->element_size;
+    ulist_node_t* node = (ulist_node_t*)list->allocator->allocate(list->allocator, bytes);
+    if (node == NULL) {
+        return NULL;
+    }
+
+    node->count = 0;
+    node->prev = after;
+    node->next = after != NULL ? after->next : list->head;
+
+    if (node->next != NULL) {
+        node->next->prev = node;
+    } else {
+        list->tail = node;
+    }
+
+    if (after != NULL) {
+        after->next = node;
+    } else {
+        list->head = node;
+    }
+
+    list->node_count++;
+    return node;
+}
+
+/**
+ * @brief 断开并释放节点，不析构其中的元素
+ *
+ * @param list 展开链表容器指针
+ * @param node 链表中的节点指针
+ */
+static void ulist_free_node(ulist_t* list, ulist_node_t* node)
+{
+    if (node->prev != NULL) {
+        node->prev->next = node->next;
+    } else {
+        list->head = node->next;
+    }
+
+    if (node->next != NULL) {
+        node->next->prev = node->prev;
+    } else {
+        list->tail = node->prev;
+    }
+
+    if (list->cursor_node == node) {
+        list->cursor_node = NULL;
+    }
+
+    list->node_count--;
+    list->allocator->deallocate(list->allocator, node);
+}
+
+/**
+ * @brief 对节点内[first, last)范围的元素调用析构函数
+ *
+ * @param list 展开链表容器指针
+ * @param node 节点指针
+ * @param first 起始位置
+ * @param last 结束位置
+ */
+static void ulist_destroy_slots(ulist_t* list, ulist_node_t* node, size_t first, size_t last)
+{
+    if (list->destructor == NULL) {
+        return;
+    }
+
+    for (size_t slot = first; slot < last; slot++) {
+        list->destructor(ulist_slot(list, node, slot));
+    }
+}
+
+/**
+ * @brief 定位指定索引所在的节点，并把游标移到该节点
+ *
+ * 从头节点、尾节点和游标中按元素距离最近的一处出发，逐节点跳过。
+ *
+ * @param list 展开链表容器指针
+ * @param index 元素索引，必须小于元素数量
+ * @param base 输出参数，存储节点第一个元素的索引
+ * @return ulist_node_t* 节点指针
+ */
+static ulist_node_t* ulist_locate(ulist_t* list, size_t index, size_t* base)
+{
+    ulist_node_t* node = list->head;
+    size_t node_base = 0;
+    size_t distance = index;
+
+    size_t tail_base = list->size - list->tail->count;
+    if (list->size - index < distance) {
+        node = list->tail;
+        node_base = tail_base;
+        distance = list->size - index;
+    }
+
+    if (list->cursor_node != NULL) {
+        size_t cursor_distance = index >= list->cursor_index ? index - list->cursor_index
+                                                             : list->cursor_index - index;
+        if (cursor_distance < distance) {
+            node = list->cursor_node;
+            node_base = list->cursor_index;
+        }
+    }
+
+    while (index >= node_base + node->count) {
+        node_base += node->count;
+        node = node->next;
+    }
+    while (index < node_base) {
+        node = node->prev;
+        node_base -= node->count;
+    }
+
+    list->cursor_node = node;
+    list->cursor_index = node_base;
+
+    *base = node_base;
+    return node;
+}
+
+/**
+ * @brief 在指定索引处插入元素（调用者持有锁）
+ *
+ * @param list 展开链表容器指针
+ * @param index 插入位置，不大于元素数量
+ * @param element 要插入的元素指针
+ * @return error_code_t 错误码
+ */
+static error_code_t ulist_insert_at(ulist_t* list, size_t index, const void* element)
+{
+    ulist_node_t* node;
+    size_t base;
+    size_t slot;
+
+    if (index == list->size) {
+        /* 追加到末尾：尾节点满时新建节点而不分裂，顺序追加得到的节点都是满的 */
+        node = list->tail;
+        if (node == NULL || node->count == list->node_capacity) {
+            node = ulist_new_node(list, list->tail);
+            if (node == NULL) {
+                return CSTL_ERROR_OUT_OF_MEMORY;
+            }
+        }
+        base = list->size - node->count;
+        slot = node->count;
+    } else {
+        node = ulist_locate(list, index, &base);
+        slot = index - base;
+
+        if (node->count == list->node_capacity) {
+            if (slot == 0 && node->prev != NULL && node->prev->count < list->node_capacity) {
+                /* 插入到节点开头时，前一个节点有空位就放在它的末尾 */
+                node = node->prev;
+                base -= node->count;
+                slot = node->count;
+            } else if (slot == 0 && node->prev == NULL) {
+                /* 在最前面插入时新建头节点而不分裂 */
+                node = ulist_new_node(list, NULL);
+                if (node == NULL) {
+                    return CSTL_ERROR_OUT_OF_MEMORY;
+                }
+            } else {
+                /* 节点已满，把后一半元素移到新节点 */
+                ulist_node_t* split = ulist_new_node(list, node);
+                if (split == NULL) {
+                    return CSTL_ERROR_OUT_OF_MEMORY;
+                }
+                size_t half = list->node_capacity / 2;
+                split->count = node->count - half;
+                memcpy(ulist_slot(list, split, 0), ulist_slot(list, node, half), split->count * list->element_size);
+                node->count = half;
+
+                if (slot > half) {
+                    node = split;
+                    base += half;
+                    slot -= half;
+                }
+            }
+        }
+    }
+
+    memmove(ulist_slot(list, node, slot + 1), ulist_slot(list, node, slot),
+            (node->count - slot) * list->element_size);
+    memcpy(ulist_slot(list, node, slot), element, list->element_size);
+    node->count++;
+    list->size++;
+
+    list->cursor_node = node;
+    list->cursor_index = base;
+
+    return CSTL_OK;
+}
+
+/**
+ * @brief 删除元素后检查节点的填充率，过低时与相邻节点合并或从相邻节点借元素
+ *
+ * @param list 展开链表容器指针
+ * @param node 刚删除过元素的节点，元素数量不为0
+ * @param base 节点第一个元素的索引
+ */
+static void ulist_rebalance(ulist_t* list, ulist_node_t* node, size_t base)
+{
+    size_t capacity = list->node_capacity;
+    size_t element_size = list->element_size;
+    ulist_node_t* next = node->next;
+    ulist_node_t* prev = node->prev;
+
+    list->cursor_node = node;
+    list->cursor_index = base;
+
+    if (node->count >= capacity / 4) {
+        return;
+    }
+
+    if (next != NULL) {
+        if (node->count + next->count <= capacity) {
+            /* 合并后一个节点 */
+            memcpy(ulist_slot(list, node, node->count), ulist_slot(list, next, 0), next->count * element_size);
+            node->count += next->count;
+            ulist_free_node(list, next);
+        } else {
+            /* 从后一个节点的开头借元素，使两个节点大致相等 */
+            size_t moved = (next->count - node->count) / 2;
+            memcpy(ulist_slot(list, node, node->count), ulist_slot(list, next, 0), moved * element_size);
+            memmove(ulist_slot(list, next, 0), ulist_slot(list, next, moved), (next->count - moved) * element_size);
+            node->count += moved;
+            next->count -= moved;
+        }
+    } else if (prev != NULL) {
+        if (prev->count + node->count <= capacity) {
+            /* 并入前一个节点 */
+            memcpy(ulist_slot(list, prev, prev->count), ulist_slot(list, node, 0), node->count * element_size);
+            list->cursor_node = prev;
+            list->cursor_index = base - prev->count;
+            prev->count += node->count;
+            ulist_free_node(list, node);
+        } else {
+            /* 从前一个节点的末尾借元素 */
+            size_t moved = (prev->count - node->count) / 2;
+            memmove(ulist_slot(list, node, moved), ulist_slot(list, node, 0), node->count * element_size);
+            memcpy(ulist_slot(list, node, 0), ulist_slot(list, prev, prev->count - moved), moved * element_size);
+            prev->count -= moved;
+            node->count += moved;
+            list->cursor_index = base - moved;
+        }
+    }
+}
+
+/**
+ * @brief 移除指定索引的元素（调用者持有锁）
+ *
+ * @param list 展开链表容器指针
+ * @param index 元素索引，必须小于元素数量
+ */
+static void ulist_erase_at(ulist_t* list, size_t index)
+{
+    size_t base;
+    ulist_node_t* node = ulist_locate(list, index, &base);
+    size_t slot = index - base;
+
+    ulist_destroy_slots(list, node, slot, slot + 1);
+    memmove(ulist_slot(list, node, slot), ulist_slot(list, node, slot + 1),
+            (node->count - slot - 1) * list->element_size);
+    node->count--;
+    list->size--;
+
+    if (node->count == 0) {
+        ulist_node_t* next = node->next;
+        ulist_free_node(list, node);
+        list->cursor_node = next;
+        list->cursor_index = base;
+    } else {
+        ulist_rebalance(list, node, base);
+    }
+}
+
+/**
+ * @brief 创建展开链表容器
+ *
+ * @param element_size 元素大小
+ * @param node_capacity 每个节点的元素容量，为0时按ULIST_DEFAULT_NODE_BYTES计算
+ * @param allocator 分配器指针，如果为NULL则使用默认分配器
+ * @param destructor 析构函数指针，移除元素时对元素调用，为NULL时不调用
+ * @return ulist_t* 展开链表容器指针，失败返回NULL
+ */
+ulist_t* ulist_create(size_t element_size, size_t node_capacity, allocator_t* allocator, destructor_fn_t destructor)
+{
+    ulist_t* list = (ulist_t*)malloc(sizeof(ulist_t));
+    if (list == NULL) {
+        return NULL;
+    }
+
+    error_code_t result = ulist_init(list, element_size, node_capacity, allocator);
+    if (result != CSTL_OK) {
+        free(list);
+        return NULL;
+    }
+
+    list->destructor = destructor;
+
+    return list;
+}
+
+/**
+ * @brief 销毁展开链表容器
+ *
+ * @param list 展开链表容器指针
+ */
+void ulist_destroy(ulist_t* list)
+{
+    if (list == NULL) {
+        return;
+    }
+
+    ulist_clear(list);
+
+    /* 销毁互斥锁 */
+    if (list->thread_safe) {
+        mutex_destroy(&list->lock);
+    }
+
+    free(list);
+}
+
+/**
+ * @brief 初始化展开链表容器
+ *
+ * @param list 展开链表容器指针
+ * @param element_size 元素大小
+ * @param node_capacity 每个节点的元素容量，为0时按ULIST_DEFAULT_NODE_BYTES计算，
+ *                      否则不能小于ULIST_MIN_NODE_CAPACITY
+ * @param allocator 分配器指针，如果为NULL则使用默认分配器
+ * @return error_code_t 错误码
+ */
+error_code_t ulist_init(ulist_t* list, size_t element_size, size_t node_capacity, allocator_t* allocator)
+{
+    if (list == NULL) {
+        return CSTL_ERROR_NULL_POINTER;
+    }
+
+    if (element_size == 0) {
+        return CSTL_ERROR_INVALID_ARGUMENT;
+    }
+
+    if (node_capacity == 0) {
+        node_capacity = ULIST_DEFAULT_NODE_BYTES / element_size;
+        if (node_capacity < ULIST_MIN_NODE_CAPACITY) {
+            node_capacity = ULIST_MIN_NODE_CAPACITY;
+        }
+    }
+
+    if (node_capacity < ULIST_MIN_NODE_CAPACITY ||
+        node_capacity > (SIZE_MAX - sizeof(ulist_node_t)) / element_size) {
+        return CSTL_ERROR_INVALID_ARGUMENT;
+    }
+
+    /* 设置分配器 */
+    if (allocator == NULL) {
+        allocator = default_allocator();
+    }
+
+    list->head = NULL;
+    list->tail = NULL;
+    list->size = 0;
+    list->node_count = 0;
+    list->element_size = element_size;
+    list->node_capacity = node_capacity;
+    list->cursor_node = NULL;
+    list->cursor_index = 0;
+    list->allocator = allocator;
+    list->thread_safe = 0;
+    list->destructor = NULL;
+
+    return CSTL_OK;
+}
+
+/**
+ * @brief 清空展开链表容器，释放所有节点
+ *
+ * @param list 展开链表容器指针
+ */
+void ulist_clear(ulist_t* list)
+{
+    if (list == NULL) {
+        return;
+    }
+
+    ulist_lock(list);
+
+    ulist_node_t* node = list->head;
+    while (node != NULL) {
+        ulist_node_t* next = node->next;
+        ulist_destroy_slots(list, node, 0, node->count);
+        list->allocator->deallocate(list->allocator, node);
+        node = next;
+    }
+
+    list->head = NULL;
+    list->tail = NULL;
+    list->size = 0;
+    list->node_count = 0;
+    list->cursor_node = NULL;
+    list->cursor_index = 0;
+
+    ulist_unlock(list);
+}
+
+/**
+ * @brief 获取展开链表容器大小
+ *
+ * @param list 展开链表容器指针
+ * @return size_t 元素数量
+ */
+size_t ulist_size(const ulist_t* list)
+{
+    if (list == NULL) {
+        return 0;
+    }
+
+    return list->size;
+}
+
+/**
+ * @brief 检查展开链表容器是否为空
+ *
+ * @param list 展开链表容器指针
+ * @return int 如果为空返回非零，否则返回零
+ */
+int ulist_empty(const ulist_t* list)
+{
+    if (list == NULL) {
+        return 1;
+    }
+
+    return list->size == 0;
+}
+
+/**
+ * @brief 在展开链表容器前端添加元素
+ *
+ * @param list 展开链表容器指针
+ * @param element 要添加的元素指针
+ * @return error_code_t 错误码
+ */
+error_code_t ulist_push_front(ulist_t* list, const void* element)
+{
+    if (list == NULL || element == NULL) {
+        return CSTL_ERROR_NULL_POINTER;
+    }
+
+    ulist_lock(list);
+    error_code_t result = ulist_insert_at(list, 0, element);
+    ulist_unlock(list);
+
+    return result;
+}
+
+/**
+ * @brief 在展开链表容器后端添加元素
+ *
+ * @param list 展开链表容器指针
+ * @param element 要添加的元素指针
+ * @return error_code_t 错误码
+ */
+error_code_t ulist_push_back(ulist_t* list, const void* element)
+{
+    if (list == NULL || element == NULL) {
+        return CSTL_ERROR_NULL_POINTER;
+    }
+
+    ulist_lock(list);
+    error_code_t result = ulist_insert_at(list, list->size, element);
+    ulist_unlock(list);
+
+    return result;
+}
+
+/**
+ * @brief 在展开链表容器后端批量追加元素
+ *
+ * 先填满尾节点，剩余元素整块复制到新建的满节点中。
+ *
+ * @param list 展开链表容器指针
+ * @param elements 连续存放的元素数组
+ * @param count 元素数量
+ * @return error_code_t 错误码，失败时已经追加的元素保留在链表中
+ */
+error_code_t ulist_append(ulist_t* list, const void* elements, size_t count)
+{
+    if (list == NULL || (elements == NULL && count > 0)) {
+        return CSTL_ERROR_NULL_POINTER;
+    }
+
+    ulist_lock(list);
+
+    const unsigned char* source = (const unsigned char*)elements;
+    while (count > 0) {
+        ulist_node_t* node = list->tail;
+        if (node == NULL || node->count == list->node_capacity) {
+            node = ulist_new_node(list, list->tail);
+            if (node == NULL) {
+                ulist_unlock(list);
+                return CSTL_ERROR_OUT_OF_MEMORY;
+            }
+        }
+
+        size_t chunk = list->node_capacity - node->count;
+        if (chunk > count) {
+            chunk = count;
+        }
+
+        memcpy(ulist_slot(list, node, node->count), source, chunk * list->element_size);
+        node->count += chunk;
+        list->size += chunk;
+        source += chunk * list->element_size;
+        count -= chunk;
+    }
+
+    ulist_unlock(list);
+    return CSTL_OK;
+}
+
+/**
+ * @brief 移除展开链表容器前端元素
+ *
+ * @param list 展开链表容器指针
+ * @return error_code_t 错误码
+ */
+error_code_t ulist_pop_front(ulist_t* list)
+{
+    if (list == NULL) {
+        return CSTL_ERROR_NULL_POINTER;
+    }
+
+    ulist_lock(list);
+
+    if (list->size == 0) {
+        ulist_unlock(list);
+        return CSTL_ERROR_CONTAINER_EMPTY;
+    }
+
+    ulist_erase_at(list, 0);
+
+    ulist_unlock(list);
+    return CSTL_OK;
+}
+
+/**
+ * @brief 移除展开链表容器后端元素
+ *
+ * @param list 展开链表容器指针
+ * @return error_code_t 错误码
+ */
+error_code_t ulist_pop_back(ulist_t* list)
+{
+    if (list == NULL) {
+        return CSTL_ERROR_NULL_POINTER;
+    }
+
+    ulist_lock(list);
+
+    if (list->size == 0) {
+        ulist_unlock(list);
+        return CSTL_ERROR_CONTAINER_EMPTY;
+    }
+
+    ulist_erase_at(list, list->size - 1);
+
+    ulist_unlock(list);
+    return CSTL_OK;
+}
+
+/**
+ * @brief 获取展开链表容器前端元素
+ *
+ * @param list 展开链表容器指针
+ * @param element 输出参数，存储元素指针
+ * @return error_code_t 错误码
+ */
+error_code_t ulist_front(const ulist_t* list, void** element)
+{
+    if (list == NULL || element == NULL) {
+        return CSTL_ERROR_NULL_POINTER;
+    }
+
+    if (list->head == NULL) {
+        return CSTL_ERROR_CONTAINER_EMPTY;
+    }
+
+    *element = ulist_slot(list, list->head, 0);
+    return CSTL_OK;
+}
+
+/**
+ * @brief 获取展开链表容器后端元素
+ *
+ * @param list 展开链表容器指针
+ * @param element 输出参数，存储元素指针
+ * @return error_code_t 错误码
+ */
+error_code_t ulist_back(const ulist_t* list, void** element)
+{
+    if (list == NULL || element == NULL) {
+        return CSTL_ERROR_NULL_POINTER;
+    }
+
+    if (list->tail == NULL) {
+        return CSTL_ERROR_CONTAINER_EMPTY;
+    }
+
+    *element = ulist_slot(list, list->tail, list->tail->count - 1);
+    return CSTL_OK;
+}
+
+/**
+ * @brief 在指定索引处插入元素
+ *
+ * @param list 展开链表容器指针
+ * @param index 插入位置，等于元素数量时追加到末尾
+ * @param element 要插入的元素指针
+ * @return error_code_t 错误码
+ */
+error_code_t ulist_insert(ulist_t* list, size_t index, const void* element)
+{
+    if (list == NULL || element == NULL) {
+        return CSTL_ERROR_NULL_POINTER;
+    }
+
+    ulist_lock(list);
+
+    if (index > list->size) {
+        ulist_unlock(list);
+        return CSTL_ERROR_INVALID_INDEX;
+    }
+
+    error_code_t result = ulist_insert_at(list, index, element);
+
+    ulist_unlock(list);
+    return result;
+}
+
+/**
+ * @brief 移除指定索引的元素
+ *
+ * @param list 展开链表容器指针
+ * @param index 元素索引
+ * @return error_code_t 错误码
+ */
+error_code_t ulist_erase(ulist_t* list, size_t index)
+{
+    if (list == NULL) {
+        return CSTL_ERROR_NULL_POINTER;
+    }
+
+    ulist_lock(list);
+
+    if (index >= list->size) {
+        ulist_unlock(list);
+        return CSTL_ERROR_INVALID_INDEX;
+    }
+
+    ulist_erase_at(list, index);
+
+    ulist_unlock(list);
+    return CSTL_OK;
+}
+
+/**
+ * @brief 移除所有满足谓词的元素
+ *
+ * 单次遍历，把保留的元素依次紧凑到前面的节点中，并释放多余的节点。
+ *
+ * @param list 展开链表容器指针
+ * @param predicate 谓词函数指针，返回非零的元素被移除
+ * @return error_code_t 错误码
+ */
+error_code_t ulist_remove_if(ulist_t* list, predicate_fn_t predicate)
+{
+    if (list == NULL || predicate == NULL) {
+        return CSTL_ERROR_NULL_POINTER;
+    }
+
+    ulist_lock(list);
+
+    /* 写位置始终不超过读位置，写满一个节点时读位置已经离开了该节点 */
+    ulist_node_t* write_node = list->head;
+    size_t write_slot = 0;
+    size_t kept = 0;
+
+    for (ulist_node_t* node = list->head; node != NULL; node = node->next) {
+        for (size_t slot = 0; slot < node->count; slot++) {
+            unsigned char* element = ulist_slot(list, node, slot);
+            if (predicate(element)) {
+                ulist_destroy_slots(list, node, slot, slot + 1);
+                continue;
+            }
+
+            if (write_slot == list->node_capacity) {
+                write_node->count = write_slot;
+                write_node = write_node->next;
+                write_slot = 0;
+            }
+            if (write_node != node || write_slot != slot) {
+                memcpy(ulist_slot(list, write_node, write_slot), element, list->element_size);
+            }
+            write_slot++;
+            kept++;
+        }
+    }
+
+    /* 释放写位置之后的节点 */
+    if (write_node != NULL) {
+        while (write_node->next != NULL) {
+            ulist_free_node(list, write_node->next);
+        }
+        write_node->count = write_slot;
+        if (write_slot == 0) {
+            ulist_free_node(list, write_node);
+        }
+    }
+
+    list->size = kept;
+    list->cursor_node = NULL;
+    list->cursor_index = 0;
+
+    ulist_unlock(list);
+    return CSTL_OK;
+}
+
+/**
+ * @brief 获取指定索引的元素
+ *
+ * @param list 展开链表容器指针
+ * @param index 元素索引
+ * @param element 输出参数，存储元素指针
+ * @return error_code_t 错误码
+ */
+error_code_t ulist_at(const ulist_t* list, size_t index, void** element)
+{
+    if (list == NULL || element == NULL) {
+        return CSTL_ERROR_NULL_POINTER;
+    }
+
+    /* 定位会移动游标 */
+    ulist_t* mutable_list = (ulist_t*)list;
+    ulist_lock(mutable_list);
+
+    if (index >= list->size) {
+        ulist_unlock(mutable_list);
+        return CSTL_ERROR_INVALID_INDEX;
+    }
+
+    size_t base;
+    ulist_node_t* node = ulist_locate(mutable_list, index, &base);
+    *element = ulist_slot(list, node, index - base);
+
+    ulist_unlock(mutable_list);
+    return CSTL_OK;
+}
+
+/**
+ * @brief 设置指定索引的元素
+ *
+ * @param list 展开链表容器指针
+ * @param index 元素索引
+ * @param element 要设置的元素指针
+ * @return error_code_t 错误码
+ */
+error_code_t ulist_set(ulist_t* list, size_t index, const void* element)
+{
+    if (list == NULL || element == NULL) {
+        return CSTL_ERROR_NULL_POINTER;
+    }
+
+    ulist_lock(list);
+
+    if (index >= list->size) {
+        ulist_unlock(list);
+        return CSTL_ERROR_INVALID_INDEX;
+    }
+
+    size_t base;
+    ulist_node_t* node = ulist_locate(list, index, &base);
+    void* slot = ulist_slot(list, node, index - base);
+    /* 先释放旧元素，element指向该元素本身时保持不变 */
+    if (slot != element) {
+        if (list->destructor != NULL) {
+            list->destructor(slot);
+        }
+        memmove(slot, element, list->element_size);
+    }
+
+    ulist_unlock(list);
+    return CSTL_OK;
+}
+
+/**
+ * @brief 启用线程安全
+ *
+ * @param list 展开链表容器指针
+ * @return error_code_t 错误码
+ */
+error_code_t ulist_enable_thread_safety(ulist_t* list)
+{
+    if (list == NULL) {
+        return CSTL_ERROR_NULL_POINTER;
+    }
+
+    if (!list->thread_safe) {
+        error_code_t result = mutex_init(&list->lock);
+        if (result != CSTL_OK) {
+            return result;
+        }
+        list->thread_safe = 1;
+    }
+
+    return CSTL_OK;
+}
+
+/**
+ * @brief 禁用线程安全
+ *
+ * @param list 展开链表容器指针
+ * @return error_code_t 错误码
+ */
+error_code_t ulist_disable_thread_safety(ulist_t* list)
+{
+    if (list == NULL) {
+        return CSTL_ERROR_NULL_POINTER;
+    }
+
+    ulist_lock(list);
+
+    if (list->thread_safe) {
+        list->thread_safe = 0;
+        mutex_unlock(&list->lock);
+        mutex_destroy(&list->lock);
+    }
+
+    return CSTL_OK;
+}
+
+/**
+ * @brief 创建展开链表容器迭代器
+ *
+ * @param list 展开链表容器指针
+ * @param direction 迭代方向
+ * @return iterator_t* 迭代器指针，失败返回NULL
+ */
+iterator_t* ulist_iterator_create(ulist_t* list, iter_direction_t direction)
+{
+    if (list == NULL) {
+        return NULL;
+    }
+
+    ulist_iterator_t* ulist_iter = (ulist_iterator_t*)malloc(sizeof(ulist_iterator_t));
+    if (ulist_iter == NULL) {
+        return NULL;
+    }
+
+    ulist_iter->base.container = list;
+    ulist_iter->base.direction = direction;
+    ulist_iter->base.element_size = list->element_size;
+    ulist_iter->base.next = ulist_iterator_next;
+    ulist_iter->base.prev = ulist_iterator_prev;
+    ulist_iter->base.get = ulist_iterator_get;
+    ulist_iter->base.valid = ulist_iterator_valid;
+    ulist_iter->base.destroy = ulist_iterator_destroy;
+    ulist_iter->base.clone = ulist_iterator_clone;
+
+    /* 设置初始位置 */
+    if (direction == ITER_DIR_FORWARD) {
+        ulist_iter->node = list->head;
+        ulist_iter->slot = 0;
+    } else {
+        ulist_iter->node = list->tail;
+        ulist_iter->slot = list->tail != NULL ? list->tail->count - 1 : 0;
+    }
+    ulist_iter->base.current = ulist_iter->node != NULL ? ulist_slot(list, ulist_iter->node, ulist_iter->slot) : NULL;
+
+    return (iterator_t*)ulist_iter;
+}
+
+/**
+ * @brief 获取展开链表容器起始迭代器
+ *
+ * @param list 展开链表容器指针
+ * @return iterator_t* 起始迭代器指针，失败返回NULL
+ */
+iterator_t* ulist_begin(ulist_t* list)
+{
+    return ulist_iterator_create(list, ITER_DIR_FORWARD);
+}
+
+/**
+ * @brief 获取展开链表容器结束迭代器
+ *
+ * 结束迭代器执行prev后指向尾元素。
+ *
+ * @param list 展开链表容器指针
+ * @return iterator_t* 结束迭代器指针，失败返回NULL
+ */
+iterator_t* ulist_end(ulist_t* list)
+{
+    iterator_t* iterator = ulist_iterator_create(list, ITER_DIR_FORWARD);
+    if (iterator == NULL) {
+        return NULL;
+    }
+
+    ((ulist_iterator_t*)iterator)->node = NULL;
+    ((ulist_iterator_t*)iterator)->slot = 0;
+    iterator->current = NULL;
+
+    return iterator;
+}
+
+/**
+ * @brief 通过展开链表迭代器获取其后第offset个元素
+ *
+ * 逐节点跳过，O(offset / node_capacity)。
+ *
+ * @param iterator 迭代器指针
+ * @param offset 相对迭代器的偏移
+ * @param element 输出参数，存储元素指针
+ * @return int 如果iterator是展开链表迭代器且目标元素存在返回非零，否则返回零
+ */
+int ulist_iterator_at(const iterator_t* iterator, size_t offset, void** element)
+{
+    if (iterator == NULL || element == NULL || iterator->next != ulist_iterator_next) {
+        return 0;
+    }
+
+    ulist_t* list = (ulist_t*)iterator->container;
+    const ulist_iterator_t* ulist_iter = (const ulist_iterator_t*)iterator;
+    ulist_node_t* node = ulist_iter->node;
+    if (node == NULL) {
+        return 0;
+    }
+
+    ulist_lock(list);
+
+    size_t slot = ulist_iter->slot;
+    while (node != NULL && offset >= node->count - slot) {
+        offset -= node->count - slot;
+        node = node->next;
+        slot = 0;
+    }
+
+    ulist_unlock(list);
+
+    if (node == NULL) {
+        return 0;
+    }
+    *element = ulist_slot(list, node, slot + offset);
+    return 1;
+}
@@ -211,7 +211,11 @@ static error_code_t vector_ensure_capacity(vector_t* vector, size_t min_capacity
     }else{
         new_capacity += 64*1024;
     }
-
+    
+    /* 一次增长不够时直接扩到所需容量 */
+    if (new_capacity < min_capacity) {
+        new_capacity = min_capacity;
+    }
     
     /* 重新分配内存 */
     void* new_data;
@@ -664,6 +668,126 @@ error_code_t vector_erase(vector_t* vector, size_t index)
     return CSTL_OK;
 }
 
+/**
+ * @brief 原地移除匹配的元素
+ * 
+ * 读指针始终不落后于写指针，因此谓词看到的总是未被覆盖的原始元素。
+ * 连续保留的元素攒成一段后只调用一次memmove，
+ * 保留和移除交替出现时每段很短，但总移动量仍然不超过n个元素。
+ * 
+ * @param vector 向量容器指针
+ * @param predicate 谓词函数指针，为NULL时与value比较
+ * @param value 要移除的值指针
+ * @param compare 比较函数指针，为NULL时按位比较
+ * @param deferred 移除时暂不析构的元素索引，没有时为SIZE_MAX
+ * @return int deferred处的元素被移除时返回非零
+ */
+static int vector_compact(vector_t* vector, predicate_fn_t predicate, const void* value, comparator_fn_t compare,
+                          size_t deferred)
+{
+    char* data = (char*)vector->data;
+    size_t element_size = vector->element_size;
+    size_t size = vector->size;
+    size_t write = 0;
+    size_t run_start = 0;
+    int deferred_removed = 0;
+    
+    for (size_t read = 0; read < size; read++) {
+        char* element = data + read * element_size;
+        int remove = predicate != NULL ? predicate(element)
+                   : compare != NULL ? compare(element, value) == 0
+                   : memcmp(element, value, element_size) == 0;
+        if (!remove) {
+            continue;
+        }
+        
+        /* 把此前保留的一段移动到写位置 */
+        if (read > run_start) {
+            if (write != run_start) {
+                memmove(data + write * element_size, data + run_start * element_size,
+                        (read - run_start) * element_size);
+            }
+            write += read - run_start;
+        }
+        run_start = read + 1;
+        
+        /* value的副本与deferred处的元素共享资源，遍历结束前不能析构 */
+        if (read == deferred) {
+            deferred_removed = 1;
+        } else if (vector->destructor != NULL) {
+            vector->destructor(element);
+        }
+    }
+    
+    if (size > run_start && write != run_start) {
+        memmove(data + write * element_size, data + run_start * element_size,
+                (size - run_start) * element_size);
+    }
+    vector->size = write + (size - run_start);
+    return deferred_removed;
+}
+
+/**
+ * @brief 移除所有满足谓词的元素
+ * 
+ * @param vector 向量容器指针
+ * @param predicate 谓词函数指针，返回非零的元素被移除
+ * @return error_code_t 错误码
+ */
+error_code_t vector_remove_if(vector_t* vector, predicate_fn_t predicate)
+{
+    if (vector == NULL || predicate == NULL) {
+        return CSTL_ERROR_NULL_POINTER;
+    }
+    
+    vector_lock(vector);
+    vector_compact(vector, predicate, NULL, NULL, SIZE_MAX);
+    vector_unlock(vector);
+    return CSTL_OK;
+}
+
+/**
+ * @brief 移除所有等于给定值的元素
+ * 
+ * @param vector 向量容器指针
+ * @param value 要移除的值指针
+ * @param compare 比较函数指针，为NULL时按位比较
+ * @return error_code_t 错误码
+ */
+error_code_t vector_remove(vector_t* vector, const void* value, comparator_fn_t compare)
+{
+    if (vector == NULL || value == NULL) {
+        return CSTL_ERROR_NULL_POINTER;
+    }
+    
+    vector_lock(vector);
+    
+    /* value指向向量内部时，压缩过程中会被覆盖，先复制一份；
+     * 该元素移除时推迟到遍历结束后再通过副本析构，比较函数始终能访问它拥有的资源 */
+    void* copy = NULL;
+    size_t deferred = SIZE_MAX;
+    const char* data = (const char*)vector->data;
+    if (data != NULL && (const char*)value >= data &&
+        (const char*)value < data + vector->size * vector->element_size) {
+        copy = malloc(vector->element_size);
+        if (copy == NULL) {
+            vector_unlock(vector);
+            return CSTL_ERROR_OUT_OF_MEMORY;
+        }
+        memcpy(copy, value, vector->element_size);
+        deferred = (size_t)((const char*)value - data) / vector->element_size;
+        value = copy;
+    }
+    
+    if (vector_compact(vector, NULL, value, compare, deferred) && vector->destructor != NULL) {
+        vector->destructor(copy);
+    }
+    vector_unlock(vector);
+    
+    free(copy);
+    return CSTL_OK;
+}
+
 /**
  * @brief 获取指定位置元素
  * 
@@ -959,3 +1083,42 @@ iterator_t* vector_end(vector_t* vector)
     
     return iterator;
 }
+
+/**
+ * @brief 获取两个向量迭代器之间的连续内存区间
+ *
+ * @param begin 起始迭代器
+ * @param end 结束迭代器，为NULL时表示到向量末尾
+ * @param data 输出参数，存储区间首元素指针
+ * @param count 输出参数，存储区间元素数量
+ * @return int 如果begin和end是同一向量的迭代器返回非零，否则返回零
+ */
+int vector_iterator_span(const iterator_t* begin, const iterator_t* end, void** data, size_t* count)
+{
+    if (begin == NULL || data == NULL || count == NULL) {
+        return 0;
+    }
+    
+    /* 通过next函数指针识别向量迭代器 */
+    if (begin->next != vector_iterator_next) {
+        return 0;
+    }
+    if (end != NULL && (end->next != vector_iterator_next || end->container != begin->container)) {
+        return 0;
+    }
+    
+    vector_t* vector = (vector_t*)begin->container;
+    size_t first = ((const vector_iterator_t*)begin)->index;
+    size_t last = end != NULL ? ((const vector_iterator_t*)end)->index : vector->size;
+    
+    if (last > vector->size) {
+        last = vector->size;
+    }
+    if (first > last) {
+        return 0;
+    }
+    
+    *data = (char*)vector->data + first * vector->element_size;
+    *count = last - first;
+    return 1;
+}